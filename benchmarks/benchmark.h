@@ -0,0 +1,121 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <simd.h>
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * Helper classes and functions for the micro benchmarks of the
+   * hyperbolic kernels.
+   */
+  namespace Benchmark
+  {
+    /**
+     * Number of repetitions of every benchmark. We report the fastest
+     * run.
+     */
+    constexpr unsigned int n_repetitions = 5;
+
+    /**
+     * Run the function object @p payload n_repetitions times and return
+     * the fastest wall time in seconds.
+     */
+    template <typename F>
+    double best_of(const F &payload)
+    {
+      double result = std::numeric_limits<double>::max();
+      for (unsigned int r = 0; r < n_repetitions; ++r) {
+        const auto start = std::chrono::steady_clock::now();
+        payload();
+        const auto stop = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> duration = stop - start;
+        result = std::min(result, duration.count());
+      }
+      return result;
+    }
+
+
+    /**
+     * Prevent the compiler from optimizing away the computation of
+     * @p value.
+     */
+    template <typename T>
+    void do_not_optimize(const T &value)
+    {
+      asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+
+    /**
+     * Print a single line of benchmark output: the wall time per
+     * operation (for example, per edge of the stencil) and, if
+     * @p n_bytes is nonzero, the effective memory bandwidth.
+     */
+    inline void print_result(const std::string &name,
+                             const double time,
+                             const std::size_t n_operations,
+                             const std::size_t n_bytes = 0)
+    {
+      std::cout << std::left << std::setw(48) << name << std::right
+                << std::fixed << std::setprecision(3) << std::setw(10)
+                << time * 1.e9 / double(n_operations) << " ns/op";
+      if (n_bytes != 0)
+        std::cout << std::setw(10) << double(n_bytes) / time * 1.e-9
+                  << " GB/s";
+      std::cout << std::endl;
+    }
+
+
+    /**
+     * A serial SparsityPatternSIMD with a periodic band stencil of
+     * uniform row length @p stencil_size (including the diagonal). All
+     * rows are part of the vectorized index range.
+     */
+    template <int simd_length>
+    struct Stencil {
+      Stencil(const unsigned int n_rows, const unsigned int stencil_size)
+          : n_rows(n_rows / simd_length * simd_length)
+      {
+        dealii::IndexSet locally_owned(this->n_rows);
+        locally_owned.add_range(0, this->n_rows);
+        partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+            locally_owned, locally_owned, MPI_COMM_SELF);
+
+        dealii::DynamicSparsityPattern dsp(this->n_rows, this->n_rows);
+        for (unsigned int i = 0; i < this->n_rows; ++i)
+          for (unsigned int k = 0; k < stencil_size; ++k) {
+            const auto j = i + this->n_rows + k - stencil_size / 2;
+            dsp.add(i, j % this->n_rows);
+          }
+
+        sparsity.reinit(this->n_rows, dsp, partitioner);
+      }
+
+      const unsigned int n_rows;
+      std::shared_ptr<dealii::Utilities::MPI::Partitioner> partitioner;
+      SparsityPatternSIMD<simd_length> sparsity;
+    };
+  } // namespace Benchmark
+} // namespace ryujin
@@ -0,0 +1,109 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#include "benchmark.h"
+
+#include <deal.II/base/mpi.h>
+
+using namespace ryujin;
+using namespace dealii;
+
+/*
+ * Benchmark SparseMatrixSIMD::get_tensor() by summing up all entries of
+ * a dim-valued matrix row by row.
+ */
+template <typename T, int dim, typename Number, int simd_length>
+void benchmark_get_tensor(
+    const Benchmark::Stencil<simd_length> &stencil,
+    const SparseMatrixSIMD<Number, dim, simd_length> &matrix,
+    const std::string &name)
+{
+  const auto &sparsity = stencil.sparsity;
+  constexpr unsigned int stride_size = get_stride_size<T>;
+
+  const auto time = Benchmark::best_of([&]() {
+    Tensor<1, dim, T> sum;
+    for (unsigned int i = 0; i < stencil.n_rows; i += stride_size) {
+      const unsigned int row_length = sparsity.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx)
+        sum += matrix.template get_tensor<T>(i, col_idx);
+    }
+    Benchmark::do_not_optimize(sum);
+  });
+
+  const std::size_t n_entries = sparsity.n_nonzero_elements();
+  Benchmark::print_result(
+      name, time, n_entries, n_entries * dim * sizeof(Number));
+}
+
+
+/*
+ * Benchmark ryujin::pow() and ryujin::fast_pow() on an array of bases.
+ */
+template <typename T>
+void benchmark_pow(const std::string &suffix)
+{
+  constexpr unsigned int n = 1 << 16;
+  constexpr unsigned int stride_size = get_stride_size<T>;
+
+  std::vector<double> bases(n);
+  for (unsigned int k = 0; k < n; ++k)
+    bases[k] = 0.5 + double(k) / double(n);
+  const double exponent = 1. / 1.4;
+
+  const auto run = [&](const auto &function) {
+    return Benchmark::best_of([&]() {
+      T sum(0.);
+      for (unsigned int k = 0; k < n; k += stride_size)
+        sum += function(load_value<T>(bases, k));
+      Benchmark::do_not_optimize(sum);
+    });
+  };
+
+  const auto time_pow =
+      run([&](const T &x) { return ryujin::pow(x, exponent); });
+  Benchmark::print_result("ryujin::pow" + suffix, time_pow, n);
+
+  const auto time_fast_pow =
+      run([&](const T &x) { return ryujin::fast_pow(x, exponent); });
+  Benchmark::print_result("ryujin::fast_pow" + suffix, time_fast_pow, n);
+}
+
+
+int main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  using VA = VectorizedArray<double>;
+  constexpr int simd_length = VA::size();
+  constexpr int dim = 3;
+
+  const unsigned int n_rows = argc > 1 ? std::stoi(argv[1]) : 1 << 18;
+  const Benchmark::Stencil<simd_length> stencil(n_rows, 27);
+
+  std::cout << "Common kernels (" << stencil.n_rows
+            << " rows, SIMD width " << simd_length << ")" << std::endl;
+
+  SparseMatrixSIMD<double, dim, simd_length> matrix(stencil.sparsity);
+  for (unsigned int i = 0; i < stencil.n_rows; ++i)
+    for (unsigned int col_idx = 0;
+         col_idx < stencil.sparsity.row_length(i);
+         ++col_idx) {
+      Tensor<1, dim, double> entry;
+      for (unsigned int d = 0; d < dim; ++d)
+        entry[d] = double(i % 7) + 0.1 * col_idx + 0.01 * d;
+      matrix.write_tensor(entry, i, col_idx);
+    }
+
+  benchmark_get_tensor<double>(
+      stencil, matrix, "SparseMatrixSIMD::get_tensor");
+  benchmark_get_tensor<VA>(
+      stencil, matrix, "SparseMatrixSIMD::get_tensor<VA>");
+
+  benchmark_pow<double>("");
+  benchmark_pow<VA>("<VA>");
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#include <description.h>
+#include <limiter.template.h>
+#include <riemann_solver.template.h>
+
+#include "hyperbolic_kernels.h"
+
+int main(int argc, char *argv[])
+{
+  using Description = ryujin::EulerAEOS::Description;
+  return ryujin::Benchmark::run_hyperbolic_kernels<Description>(argc, argv);
+}
@@ -0,0 +1,344 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "benchmark.h"
+
+#include <multicomponent_vector.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parameter_acceptor.h>
+
+#include <cmath>
+#include <sstream>
+
+namespace ryujin
+{
+  namespace Benchmark
+  {
+    /**
+     * Micro benchmarks for the equation specific kernels of a
+     * @a Description: RiemannSolver::compute(), Indicator::accumulate(),
+     * Limiter::accumulate() and Limiter::limit(). All kernels are called
+     * with the same loop structure as in HyperbolicModule::step() on a
+     * serial, periodic band stencil. Every kernel is timed with scalar
+     * and VectorizedArray arguments.
+     *
+     * The template parameter @a equilibrated_states selects the limiter
+     * interface of the shallow water equations (see
+     * HyperbolicModule::step()).
+     */
+    template <typename Description, int dim, bool equilibrated_states>
+    class HyperbolicKernels
+    {
+    public:
+      using Number = double;
+      using VA = dealii::VectorizedArray<Number>;
+      static constexpr int simd_length = VA::size();
+
+      using HyperbolicSystem = typename Description::HyperbolicSystem;
+      using View = typename HyperbolicSystem::template View<dim, Number>;
+      static constexpr unsigned int problem_dimension = View::problem_dimension;
+      using vector_type = typename View::vector_type;
+      using precomputed_vector_type = typename View::precomputed_vector_type;
+      using precomputed_initial_vector_type =
+          typename View::precomputed_initial_vector_type;
+
+      HyperbolicKernels(const HyperbolicSystem &hyperbolic_system,
+                        const unsigned int n_rows,
+                        const unsigned int stencil_size)
+          : hyperbolic_system_(hyperbolic_system)
+          , stencil_(n_rows, stencil_size)
+      {
+        const auto &partitioner = stencil_.partitioner;
+        const auto &sparsity = stencil_.sparsity;
+
+        U_.reinit_with_scalar_partitioner(partitioner);
+        precomputed_.reinit_with_scalar_partitioner(partitioner);
+        precomputed_initial_.reinit_with_scalar_partitioner(partitioner);
+
+        /* A smooth, admissible state: */
+        const auto view = hyperbolic_system_.template view<dim, Number>();
+        for (unsigned int i = 0; i < stencil_.n_rows; ++i) {
+          typename View::primitive_state_type primitive_state;
+          for (unsigned int k = 0; k < problem_dimension; ++k)
+            primitive_state[k] = 1. + 0.1 * std::sin(0.01 * i + k);
+          U_.write_tensor(view.from_primitive_state(primitive_state), i);
+        }
+
+        const auto view_simd = hyperbolic_system_.template view<dim, VA>();
+        for (unsigned int cycle = 0; cycle < View::n_precomputation_cycles;
+             ++cycle)
+          view_simd.precomputation_loop(
+              cycle,
+              [](const unsigned int) {},
+              precomputed_,
+              sparsity,
+              U_,
+              0,
+              stencil_.n_rows);
+
+        cij_matrix_.reinit(sparsity);
+        betaij_matrix_.reinit(sparsity);
+        for (unsigned int i = 0; i < stencil_.n_rows; ++i) {
+          const unsigned int row_length = sparsity.row_length(i);
+          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+            dealii::Tensor<1, dim, Number> c_ij;
+            for (unsigned int d = 0; d < dim; ++d)
+              c_ij[d] = (col_idx % 2 == 0 ? 0.1 : -0.1) * (d + col_idx);
+            cij_matrix_.write_tensor(c_ij, i, col_idx);
+            betaij_matrix_.write_entry(1. / row_length, i, col_idx);
+          }
+        }
+      }
+
+      /**
+       * Run all benchmarks.
+       */
+      void run()
+      {
+        std::cout << "Hyperbolic kernels (" << stencil_.n_rows << " rows, "
+                  << dim << "D, SIMD width " << simd_length << ")"
+                  << std::endl;
+
+        riemann_solver<Number>("RiemannSolver::compute");
+        riemann_solver<VA>("RiemannSolver::compute<VA>");
+        indicator<Number>("Indicator::accumulate");
+        indicator<VA>("Indicator::accumulate<VA>");
+        limiter_bounds<Number>("Limiter::accumulate");
+        limiter_bounds<VA>("Limiter::accumulate<VA>");
+        limiter_limit<Number>("Limiter::limit");
+        limiter_limit<VA>("Limiter::limit<VA>");
+      }
+
+    private:
+      /**
+       * Number of edges (off-diagonal entries) of the stencil and the
+       * number of bytes of state and matrix data loaded per edge.
+       */
+      std::size_t n_edges() const
+      {
+        return stencil_.sparsity.n_nonzero_elements() - stencil_.n_rows;
+      }
+
+      static constexpr std::size_t bytes_per_edge =
+          (problem_dimension + dim) * sizeof(Number);
+
+      template <typename T>
+      void riemann_solver(const std::string &name) const
+      {
+        using RiemannSolver =
+            typename Description::template RiemannSolver<dim, T>;
+        RiemannSolver riemann_solver(hyperbolic_system_, precomputed_);
+
+        const auto &sparsity = stencil_.sparsity;
+        constexpr unsigned int stride_size = get_stride_size<T>;
+
+        const auto time = best_of([&]() {
+          T sum(0.);
+          for (unsigned int i = 0; i < stencil_.n_rows; i += stride_size) {
+            const auto U_i = U_.template get_tensor<T>(i);
+            const unsigned int row_length = sparsity.row_length(i);
+            const unsigned int *js = sparsity.columns(i) + stride_size;
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              const auto U_j = U_.template get_tensor<T>(js);
+              const auto c_ij = cij_matrix_.template get_tensor<T>(i, col_idx);
+              const auto norm = c_ij.norm();
+              const auto n_ij = c_ij / norm;
+              sum += norm * riemann_solver.compute(U_i, U_j, i, js, n_ij);
+            }
+          }
+          do_not_optimize(sum);
+        });
+
+        print_result(name, time, n_edges(), n_edges() * bytes_per_edge);
+      }
+
+      template <typename T>
+      void indicator(const std::string &name) const
+      {
+        using Indicator = typename Description::template Indicator<dim, T>;
+        Indicator indicator(hyperbolic_system_, precomputed_, 1.);
+
+        const auto &sparsity = stencil_.sparsity;
+        constexpr unsigned int stride_size = get_stride_size<T>;
+
+        const auto time = best_of([&]() {
+          T sum(0.);
+          for (unsigned int i = 0; i < stencil_.n_rows; i += stride_size) {
+            const auto U_i = U_.template get_tensor<T>(i);
+            indicator.reset(i, U_i);
+            const unsigned int row_length = sparsity.row_length(i);
+            const unsigned int *js = sparsity.columns(i) + stride_size;
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              const auto U_j = U_.template get_tensor<T>(js);
+              const auto c_ij = cij_matrix_.template get_tensor<T>(i, col_idx);
+              indicator.accumulate(js, U_j, c_ij);
+            }
+            sum += indicator.alpha(T(1.e-3));
+          }
+          do_not_optimize(sum);
+        });
+
+        print_result(name, time, n_edges(), n_edges() * bytes_per_edge);
+      }
+
+      /**
+       * Accumulate the limiter bounds of row @p i with the same loop
+       * structure as Step 4 of HyperbolicModule::step().
+       */
+      template <typename T, typename Limiter>
+      auto accumulate_bounds(Limiter &limiter, const unsigned int i) const
+      {
+        using state_type =
+            typename HyperbolicSystem::template View<dim, T>::state_type;
+
+        const auto view = hyperbolic_system_.template view<dim, T>();
+        const auto &sparsity = stencil_.sparsity;
+        constexpr unsigned int stride_size = get_stride_size<T>;
+        const unsigned int row_length = sparsity.row_length(i);
+
+        const auto U_i = U_.template get_tensor<T>(i);
+        const auto flux_i = view.flux_contribution(
+            precomputed_, precomputed_initial_, i, U_i);
+        limiter.reset(i, U_i, flux_i);
+
+        [[maybe_unused]] state_type affine_shift;
+
+        const unsigned int *js = sparsity.columns(i);
+        if constexpr (equilibrated_states) {
+          for (unsigned int col_idx = 0; col_idx < row_length;
+               ++col_idx, js += stride_size) {
+            const auto U_j = U_.template get_tensor<T>(js);
+            const auto flux_j = view.flux_contribution(
+                precomputed_, precomputed_initial_, js, U_j);
+            const auto c_ij = cij_matrix_.template get_tensor<T>(i, col_idx);
+            affine_shift += view.affine_shift(flux_i, flux_j, c_ij, T(1.));
+          }
+          affine_shift *= T(1.e-3);
+        }
+
+        js = sparsity.columns(i);
+        for (unsigned int col_idx = 0; col_idx < row_length;
+             ++col_idx, js += stride_size) {
+          const auto U_j = U_.template get_tensor<T>(js);
+          const auto flux_j = view.flux_contribution(
+              precomputed_, precomputed_initial_, js, U_j);
+          const auto c_ij = cij_matrix_.template get_tensor<T>(i, col_idx);
+          const auto beta_ij =
+              betaij_matrix_.template get_entry<T>(i, col_idx);
+
+          if constexpr (equilibrated_states) {
+            const auto &[U_star_ij, U_star_ji] =
+                view.equilibrated_states(flux_i, flux_j);
+            limiter.accumulate(
+                U_j, U_star_ij, U_star_ji, c_ij, beta_ij, affine_shift);
+          } else {
+            limiter.accumulate(js, U_j, flux_j, c_ij, beta_ij);
+          }
+        }
+
+        return limiter.bounds(T(1.e-3));
+      }
+
+      template <typename T>
+      void limiter_bounds(const std::string &name) const
+      {
+        using Limiter = typename Description::template Limiter<dim, T>;
+        Limiter limiter(hyperbolic_system_, precomputed_, 1., 1.e-10, 2);
+
+        constexpr unsigned int stride_size = get_stride_size<T>;
+
+        const auto time = best_of([&]() {
+          T sum(0.);
+          for (unsigned int i = 0; i < stencil_.n_rows; i += stride_size)
+            sum += accumulate_bounds<T>(limiter, i)[0];
+          do_not_optimize(sum);
+        });
+
+        print_result(name, time, n_edges(), n_edges() * bytes_per_edge);
+      }
+
+      template <typename T>
+      void limiter_limit(const std::string &name) const
+      {
+        using Limiter = typename Description::template Limiter<dim, T>;
+        Limiter limiter(hyperbolic_system_, precomputed_, 1., 1.e-10, 2);
+
+        const auto &sparsity = stencil_.sparsity;
+        constexpr unsigned int stride_size = get_stride_size<T>;
+
+        std::vector<typename Limiter::Bounds> bounds;
+        for (unsigned int i = 0; i < stencil_.n_rows; i += stride_size)
+          bounds.push_back(accumulate_bounds<T>(limiter, i));
+
+        const auto time = best_of([&]() {
+          T sum(0.);
+          for (unsigned int i = 0; i < stencil_.n_rows; i += stride_size) {
+            const auto U_i = U_.template get_tensor<T>(i);
+            const auto &bounds_i = bounds[i / stride_size];
+            const unsigned int row_length = sparsity.row_length(i);
+            const unsigned int *js = sparsity.columns(i) + stride_size;
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              const auto U_j = U_.template get_tensor<T>(js);
+              const auto P_ij = T(0.1) * (U_j - U_i);
+              const auto &[l_ij, success] = limiter.limit(bounds_i, U_i, P_ij);
+              sum += l_ij;
+            }
+          }
+          do_not_optimize(sum);
+        });
+
+        print_result(name,
+                     time,
+                     n_edges(),
+                     n_edges() * problem_dimension * sizeof(Number));
+      }
+
+      const HyperbolicSystem &hyperbolic_system_;
+      const Stencil<simd_length> stencil_;
+
+      vector_type U_;
+      precomputed_vector_type precomputed_;
+      precomputed_initial_vector_type precomputed_initial_;
+
+      SparseMatrixSIMD<Number, dim> cij_matrix_;
+      SparseMatrixSIMD<Number> betaij_matrix_;
+    };
+
+
+    /**
+     * Set up the hyperbolic system of @a Description with the given
+     * @p parameters and run all benchmarks of HyperbolicKernels. The
+     * first command line argument (optional) is the number of rows.
+     */
+    template <typename Description, bool equilibrated_states = false>
+    int run_hyperbolic_kernels(int argc,
+                               char *argv[],
+                               const std::string &parameters = "")
+    {
+      dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(
+          argc, argv, 1);
+
+      constexpr int dim = 2;
+
+      typename Description::HyperbolicSystem hyperbolic_system;
+      std::stringstream parameter_stream(parameters);
+      dealii::ParameterAcceptor::initialize(parameter_stream);
+
+      const unsigned int n_rows = argc > 1 ? std::stoi(argv[1]) : 1 << 18;
+
+      HyperbolicKernels<Description, dim, equilibrated_states> benchmark(
+          hyperbolic_system, n_rows, 9);
+      benchmark.run();
+
+      return 0;
+    }
+  } // namespace Benchmark
+} // namespace ryujin
@@ -0,0 +1,145 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <deal.II/base/point.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/types.h>
+
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A flat, struct-of-arrays representation of the boundary map of
+   * OfflineData.
+   *
+   * All boundary descriptions are stored contiguously and sorted by
+   * (local) degree of freedom index. In addition, the table stores an
+   * offset index with one entry per locally owned row so that the range
+   * of boundary descriptions of a given row, and the test whether a row
+   * is a boundary degree of freedom, are O(1) operations. Loops over all
+   * boundary descriptions can simply iterate over the index range
+   * [0, size()) and thus be parallelized.
+   *
+   * @ingroup Mesh
+   */
+  template <int dim, typename Number>
+  class BoundaryTable
+  {
+  public:
+    /**
+     * Populate the table from a (multi)map with keys in local numbering
+     * of degrees of freedom and values of the form (normal, normal mass,
+     * boundary mass, boundary id, position). All keys must be less than
+     * @p n_rows.
+     */
+    template <typename MAP>
+    void reinit(const MAP &boundary_map, const unsigned int n_rows)
+    {
+      const auto n_entries = boundary_map.size();
+
+      index.clear();
+      normal.clear();
+      normal_mass.clear();
+      boundary_mass.clear();
+      id.clear();
+      position.clear();
+
+      index.reserve(n_entries);
+      normal.reserve(n_entries);
+      normal_mass.reserve(n_entries);
+      boundary_mass.reserve(n_entries);
+      id.reserve(n_entries);
+      position.reserve(n_entries);
+
+      offsets_.assign(n_rows + 1, 0);
+
+      /* The map is sorted by index: */
+      for (const auto &[i, description] : boundary_map) {
+        const auto &[n, n_mass, b_mass, b_id, p] = description;
+        Assert(i < n_rows, dealii::ExcInternalError());
+
+        index.push_back(i);
+        normal.push_back(n);
+        normal_mass.push_back(n_mass);
+        boundary_mass.push_back(b_mass);
+        id.push_back(b_id);
+        position.push_back(p);
+        offsets_[i + 1]++;
+      }
+
+      for (unsigned int i = 0; i < n_rows; ++i)
+        offsets_[i + 1] += offsets_[i];
+    }
+
+    /**
+     * Return the total number of stored boundary descriptions.
+     */
+    unsigned int size() const
+    {
+      return index.size();
+    }
+
+    /**
+     * Return true if the row @p i has at least one boundary description.
+     * Returns false for all indices that are not locally owned.
+     */
+    bool is_boundary(const unsigned int i) const
+    {
+      return i + 1 < offsets_.size() && offsets_[i] != offsets_[i + 1];
+    }
+
+    /**
+     * Return the index of the first boundary description of row @p i.
+     */
+    unsigned int begin(const unsigned int i) const
+    {
+      return offsets_[i];
+    }
+
+    /**
+     * Return the index one past the last boundary description of row @p
+     * i.
+     */
+    unsigned int end(const unsigned int i) const
+    {
+      return offsets_[i + 1];
+    }
+
+    /**
+     * Return the memory consumption in bytes.
+     */
+    std::size_t memory_consumption() const
+    {
+      return index.capacity() * sizeof(unsigned int) +
+             normal.capacity() * sizeof(dealii::Tensor<1, dim, Number>) +
+             (normal_mass.capacity() + boundary_mass.capacity()) *
+                 sizeof(Number) +
+             id.capacity() * sizeof(dealii::types::boundary_id) +
+             position.capacity() * sizeof(dealii::Point<dim>) +
+             offsets_.capacity() * sizeof(unsigned int);
+    }
+
+    /**
+     * @name Boundary descriptions (struct of arrays)
+     */
+    //@{
+
+    std::vector<unsigned int> index;
+    std::vector<dealii::Tensor<1, dim, Number>> normal;
+    std::vector<Number> normal_mass;
+    std::vector<Number> boundary_mass;
+    std::vector<dealii::types::boundary_id> id;
+    std::vector<dealii::Point<dim>> position;
+
+    //@}
+
+  private:
+    std::vector<unsigned int> offsets_;
+  };
+
+} // namespace ryujin
@@ -0,0 +1,73 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <array>
+
+namespace ryujin
+{
+  /**
+   * The Butcher tableau of the explicit five stage, fourth-order
+   * Runge-Kutta method ERK(5,4;1) used by TimeSteppingScheme::erk_54,
+   * \f{align*}
+   * \begin{array}{c|ccccc}
+   *   0   & 0 \\
+   *   0.2 & a_{21} & 0 \\
+   *   0.4 & a_{31} & a_{32} & 0 \\
+   *   0.6 & a_{41} & a_{42} & a_{43} & 0 \\
+   *   0.8 & a_{51} & a_{52} & a_{53} & a_{54} & 0 \\
+   *   \hline
+   *       & b_1    & b_2    & b_3    & b_4    & b_5
+   * \end{array}
+   * \f}
+   * The nodes c_i are equidistant, which allows to write every stage as
+   * a forward Euler step of the previous stage with step size tau =
+   * 0.2 dt plus a linear combination of all earlier stage updates, see
+   * TimeIntegrator::step_erk_54(). The coefficients satisfy all order
+   * conditions up to order four to machine precision.
+   *
+   * @ingroup TimeLoop
+   */
+  struct ERK54Tableau {
+    /**
+     * Number of stages.
+     */
+    static constexpr unsigned int n_stages = 5;
+
+    /**
+     * Distance between two consecutive (equidistant) nodes c_i.
+     */
+    static constexpr double c = 0.2;
+
+    /**
+     * The (strictly lower triangular) matrix a_ij.
+     */
+    static constexpr std::array<std::array<double, n_stages>, n_stages> a{{
+        {{0., 0., 0., 0., 0.}},
+        {{+0.2, 0., 0., 0., 0.}},
+        {{+0.26075582269554909, +0.13924417730445096, 0., 0., 0.}},
+        {{-0.25856517872570289,
+          +0.91136274166280729,
+          -0.05279756293710430,
+          0.,
+          0.}},
+        {{+0.21623276431503774,
+          +0.51534223099602405,
+          -0.81662794199265554,
+          +0.88505294668159373,
+          0.}},
+    }};
+
+    /**
+     * The weights b_j.
+     */
+    static constexpr std::array<double, n_stages> b{{-0.10511678454691901,
+                                                     +0.87880047152100838,
+                                                     -0.58903404061484477,
+                                                     +0.46213380485434047,
+                                                     +0.35321654878641495}};
+  };
+} // namespace ryujin
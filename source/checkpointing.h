@@ -7,17 +7,27 @@
 
 #include "multicomponent_vector.h"
 #include "offline_data.h"
+#include "openmp.h"
 
 #include <deal.II/base/utilities.h>
 #include <deal.II/distributed/solution_transfer.h>
+#include <deal.II/distributed/tria.h>
 
+#include <boost/archive/archive_exception.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/core/demangle.hpp>
+#include <boost/serialization/vector.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 #include <string>
+#include <type_traits>
 
 namespace ryujin
 {
@@ -28,6 +38,817 @@ namespace ryujin
         std::is_same<typename Discretization<dim>::Triangulation,
                      dealii::parallel::distributed::Triangulation<dim>>::value;
 
+    /**
+     * Return the MPI datatype corresponding to @p Number.
+     */
+    template <typename Number>
+    MPI_Datatype mpi_type()
+    {
+      if constexpr (std::is_same_v<Number, double>)
+        return MPI_DOUBLE;
+      else
+        return MPI_FLOAT;
+    }
+
+
+    /*
+     * Magic prefix of a block compressed delta, see encode_delta():
+     */
+    inline constexpr char block_magic[4] = {'R', 'Y', 'D', 'B'};
+
+
+    /**
+     * Encode the difference between the @p n entries of @p data and
+     * @p reference: The bit patterns of both are combined with an
+     * exclusive or and the bytes of the result are regrouped by
+     * significance before the buffer is compressed. Identical sign,
+     * exponent and leading mantissa bits of slowly changing values thus
+     * turn into long runs of zeros.
+     *
+     * The regrouped buffer is split into independent blocks of
+     * @p block_size bytes that are compressed concurrently by all threads
+     * of the OpenMP thread pool. The result holds a small header (a magic
+     * prefix, the number of blocks and the compressed size of every
+     * block) followed by all compressed blocks. Executes in serial, non
+     * thread-parallel context.
+     */
+    template <typename Number>
+    std::string encode_delta(const Number *data,
+                             const Number *reference,
+                             const std::size_t n,
+                             const std::size_t block_size = 1 << 20)
+    {
+      using word_type = std::conditional_t<sizeof(Number) == 8,
+                                           std::uint64_t,
+                                           std::uint32_t>;
+      constexpr unsigned int n_bytes = sizeof(Number);
+
+      std::string buffer(n * n_bytes, '\0');
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (std::size_t i = 0; i < n; ++i) {
+        word_type a, b;
+        std::memcpy(&a, data + i, n_bytes);
+        std::memcpy(&b, reference + i, n_bytes);
+        const word_type x = a ^ b;
+        for (unsigned int k = 0; k < n_bytes; ++k)
+          buffer[k * n + i] = static_cast<char>((x >> (8 * k)) & 0xff);
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+      Assert(block_size > 0, dealii::ExcInternalError());
+      const std::uint64_t n_blocks =
+          std::max<std::size_t>((buffer.size() + block_size - 1) / block_size,
+                                1);
+
+      std::vector<std::string> blocks(n_blocks);
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (std::uint64_t k = 0; k < n_blocks; ++k) {
+        const auto begin = std::min<std::size_t>(k * block_size, buffer.size());
+        const auto end = std::min(begin + block_size, buffer.size());
+        blocks[k] =
+            dealii::Utilities::compress(buffer.substr(begin, end - begin));
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+      std::string result(block_magic, sizeof(block_magic));
+      const auto append = [&result](const std::uint64_t value) {
+        result.append(reinterpret_cast<const char *>(&value), sizeof(value));
+      };
+      append(n_blocks);
+      for (const auto &block : blocks)
+        append(block.size());
+      for (const auto &block : blocks)
+        result += block;
+
+      return result;
+    }
+
+
+    /**
+     * Apply a @p delta created with encode_delta() to the @p n entries of
+     * @p data, which have to hold the reference values.
+     */
+    template <typename Number>
+    void
+    apply_delta(const std::string &delta, Number *data, const std::size_t n)
+    {
+      using word_type = std::conditional_t<sizeof(Number) == 8,
+                                           std::uint64_t,
+                                           std::uint32_t>;
+      constexpr unsigned int n_bytes = sizeof(Number);
+
+      std::string buffer;
+
+      if (delta.compare(0, sizeof(block_magic), block_magic,
+                        sizeof(block_magic)) != 0) {
+        /* A single compressed buffer written by an older version: */
+        buffer = dealii::Utilities::decompress(delta);
+
+      } else {
+        /* Parse the header and decompress all blocks concurrently: */
+        std::size_t position = sizeof(block_magic);
+        const auto read = [&delta, &position]() {
+          std::uint64_t value = 0;
+          AssertThrow(position + sizeof(value) <= delta.size(),
+                      dealii::ExcMessage("Corrupted differential checkpoint"));
+          std::memcpy(&value, delta.data() + position, sizeof(value));
+          position += sizeof(value);
+          return value;
+        };
+
+        const auto n_blocks = read();
+        AssertThrow(n_blocks <= delta.size() / sizeof(std::uint64_t),
+                    dealii::ExcMessage("Corrupted differential checkpoint"));
+        std::vector<std::size_t> offsets(n_blocks + 1);
+        offsets[0] = position + n_blocks * sizeof(std::uint64_t);
+        for (std::uint64_t k = 0; k < n_blocks; ++k)
+          offsets[k + 1] = offsets[k] + read();
+        AssertThrow(offsets[n_blocks] == delta.size(),
+                    dealii::ExcMessage("Corrupted differential checkpoint"));
+
+        std::vector<std::string> blocks(n_blocks);
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (std::uint64_t k = 0; k < n_blocks; ++k)
+          blocks[k] = dealii::Utilities::decompress(
+              delta.substr(offsets[k], offsets[k + 1] - offsets[k]));
+        RYUJIN_PARALLEL_REGION_END
+
+        for (const auto &block : blocks)
+          buffer += block;
+      }
+
+      AssertThrow(buffer.size() == n * n_bytes,
+                  dealii::ExcMessage("The size of the differential checkpoint "
+                                     "does not match the state vector."));
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (std::size_t i = 0; i < n; ++i) {
+        word_type x = 0;
+        for (unsigned int k = 0; k < n_bytes; ++k)
+          x |= word_type(static_cast<unsigned char>(buffer[k * n + i]))
+               << (8 * k);
+        word_type a;
+        std::memcpy(&a, data + i, n_bytes);
+        a ^= x;
+        std::memcpy(data + i, &a, n_bytes);
+      }
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+
+    /**
+     * Return the file suffix of the state chunk of the current rank.
+     */
+    inline std::string chunk_suffix(const MPI_Comm &mpi_communicator)
+    {
+      const auto this_process =
+          dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+      return ".state." + std::to_string(this_process);
+    }
+
+
+    /**
+     * Replace the checkpoint files with prefix @p name by the freshly
+     * written set of files with prefix @p new_name. The previous
+     * checkpoint is kept with an additional "~" suffix.
+     *
+     * All files of a checkpoint are written under @p new_name first, so
+     * an interrupted write never corrupts the last good checkpoint.
+     *
+     * A @p differential checkpoint only consists of the metadata and the
+     * delta file; the mesh and state files of the last full checkpoint
+     * remain in place.
+     *
+     * @ingroup Miscellaneous
+     */
+    inline void rotate_checkpoint(const std::string &new_name,
+                                  const std::string &name,
+                                  const MPI_Comm &mpi_communicator,
+                                  const bool differential = false)
+    {
+      int ierr = MPI_Barrier(mpi_communicator);
+      AssertThrowMPI(ierr);
+
+      if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
+        const std::vector<std::string> suffixes =
+            differential ? std::vector<std::string>{".metadata", ".delta"}
+                         : std::vector<std::string>{".mesh",
+                                                    ".mesh_fixed.data",
+                                                    ".mesh.info",
+                                                    ".metadata",
+                                                    ".state",
+                                                    ".delta",
+                                                    ".cells"};
+
+        for (const auto &suffix : suffixes)
+          if (std::filesystem::exists(name + suffix))
+            std::filesystem::rename(name + suffix, name + suffix + "~");
+
+        for (const auto &suffix : suffixes)
+          if (std::filesystem::exists(new_name + suffix))
+            std::filesystem::rename(new_name + suffix, name + suffix);
+      }
+
+      /* Every rank rotates its own state chunk (see CollectiveWriter): */
+      if (!differential) {
+        const auto suffix = chunk_suffix(mpi_communicator);
+        if (std::filesystem::exists(name + suffix))
+          std::filesystem::rename(name + suffix, name + suffix + "~");
+        if (std::filesystem::exists(new_name + suffix))
+          std::filesystem::rename(new_name + suffix, name + suffix);
+      }
+
+      ierr = MPI_Barrier(mpi_communicator);
+      AssertThrowMPI(ierr);
+    }
+
+
+    /**
+     * Return all locally owned active cells of @p dof_handler sorted in
+     * the order of the p4est forest, i.e., by p4est tree index and the
+     * (z-order) sequence of child indices. This order only depends on the
+     * refinement tree and not on the partitioning. Because p4est
+     * partitions the forest into contiguous ranges the locally owned cells
+     * form a contiguous range of the global order on every rank.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <int dim>
+    std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>
+    sorted_locally_owned_cells(const dealii::DoFHandler<dim> &dof_handler)
+    {
+      using iterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+      const auto &triangulation = dynamic_cast<
+          const dealii::parallel::distributed::Triangulation<dim> &>(
+          dof_handler.get_triangulation());
+      const auto &tree_permutation =
+          triangulation.get_coarse_cell_to_p4est_tree_permutation();
+
+      std::vector<std::pair<std::vector<unsigned int>, iterator>> cells;
+      for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+
+        /* Key: tree index followed by the child indices: */
+        std::vector<unsigned int> key;
+        typename dealii::Triangulation<dim>::cell_iterator it = cell;
+        while (it->level() > 0) {
+          const auto parent = it->parent();
+          for (unsigned int c = 0; c < parent->n_children(); ++c)
+            if (parent->child(c) == it)
+              key.push_back(c);
+          it = parent;
+        }
+        key.push_back(tree_permutation[it->index()]);
+        std::reverse(key.begin(), key.end());
+
+        cells.emplace_back(std::move(key), cell);
+      }
+
+      std::sort(cells.begin(), cells.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+      });
+
+      std::vector<iterator> result;
+      result.reserve(cells.size());
+      for (const auto &it : cells)
+        result.push_back(it.second);
+      return result;
+    }
+
+
+    /**
+     * Write the state @p U cell by cell in the partition independent
+     * order of sorted_locally_owned_cells() into the file @p filename with
+     * collective MPI IO. For every cell the values of all components at
+     * all degrees of freedom of the cell are stored. The file can thus be
+     * read back with read_cell_ordered_state() on any number of ranks.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <int dim, typename Number, int n_comp, int simd_length>
+    void write_cell_ordered_state(
+        const OfflineData<dim, Number> &offline_data,
+        const MultiComponentVector<Number, n_comp, simd_length> &U,
+        const std::string &filename,
+        const MPI_Comm &mpi_communicator)
+    {
+      const auto &dof_handler = offline_data.dof_handler();
+      const auto &scalar_partitioner = *offline_data.scalar_partitioner();
+      const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+      const unsigned int record_size = dofs_per_cell * n_comp;
+
+      const auto cells = sorted_locally_owned_cells(dof_handler);
+
+      std::vector<Number> buffer(cells.size() * record_size);
+      std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
+      for (unsigned int c = 0; c < cells.size(); ++c) {
+        cells[c]->get_dof_indices(dof_indices);
+        for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+          const auto i = scalar_partitioner.global_to_local(dof_indices[j]);
+          const auto U_i = U.get_tensor(i);
+          for (unsigned int k = 0; k < n_comp; ++k)
+            buffer[c * record_size + j * n_comp + k] = U_i[k];
+        }
+      }
+
+      unsigned long long local_size = buffer.size();
+      unsigned long long offset = 0;
+      int ierr = MPI_Exscan(&local_size,
+                            &offset,
+                            1,
+                            MPI_UNSIGNED_LONG_LONG,
+                            MPI_SUM,
+                            mpi_communicator);
+      AssertThrowMPI(ierr);
+      if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        offset = 0;
+
+      MPI_File file;
+      ierr = MPI_File_open(mpi_communicator,
+                           filename.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL,
+                           &file);
+      AssertThrowMPI(ierr);
+      ierr = MPI_File_set_size(file, 0);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_write_at_all(file,
+                                   offset * sizeof(Number),
+                                   buffer.data(),
+                                   buffer.size(),
+                                   mpi_type<Number>(),
+                                   MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_close(&file);
+      AssertThrowMPI(ierr);
+    }
+
+
+    /**
+     * Read a state written with write_cell_ordered_state() from the file
+     * @p filename into @p U (with an arbitrary partitioning of the same
+     * mesh) and update ghost values.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <int dim, typename Number, int n_comp, int simd_length>
+    void read_cell_ordered_state(
+        const OfflineData<dim, Number> &offline_data,
+        MultiComponentVector<Number, n_comp, simd_length> &U,
+        const std::string &filename,
+        const MPI_Comm &mpi_communicator)
+    {
+      const auto &dof_handler = offline_data.dof_handler();
+      const auto &scalar_partitioner = *offline_data.scalar_partitioner();
+      const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
+      const unsigned int record_size = dofs_per_cell * n_comp;
+
+      const auto cells = sorted_locally_owned_cells(dof_handler);
+
+      std::vector<Number> buffer(cells.size() * record_size);
+
+      unsigned long long local_size = buffer.size();
+      unsigned long long offset = 0;
+      int ierr = MPI_Exscan(&local_size,
+                            &offset,
+                            1,
+                            MPI_UNSIGNED_LONG_LONG,
+                            MPI_SUM,
+                            mpi_communicator);
+      AssertThrowMPI(ierr);
+      if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+        offset = 0;
+
+      MPI_File file;
+      ierr = MPI_File_open(mpi_communicator,
+                           filename.c_str(),
+                           MPI_MODE_RDONLY,
+                           MPI_INFO_NULL,
+                           &file);
+      AssertThrowMPI(ierr);
+
+      MPI_Offset file_size;
+      ierr = MPI_File_get_size(file, &file_size);
+      AssertThrowMPI(ierr);
+      const auto global_size =
+          dealii::Utilities::MPI::sum(local_size, mpi_communicator);
+      AssertThrow(static_cast<unsigned long long>(file_size) ==
+                      global_size * sizeof(Number),
+                  dealii::ExcMessage("The cell ordered checkpoint does not "
+                                     "match the mesh."));
+
+      ierr = MPI_File_read_at_all(file,
+                                  offset * sizeof(Number),
+                                  buffer.data(),
+                                  buffer.size(),
+                                  mpi_type<Number>(),
+                                  MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_close(&file);
+      AssertThrowMPI(ierr);
+
+      /* Scatter into the locally owned part of U: */
+
+      const unsigned int n_owned = offline_data.n_locally_owned();
+      std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
+      for (unsigned int c = 0; c < cells.size(); ++c) {
+        cells[c]->get_dof_indices(dof_indices);
+        for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+          const auto i = scalar_partitioner.global_to_local(dof_indices[j]);
+          if (i >= n_owned)
+            continue;
+          dealii::Tensor<1, n_comp, Number> U_i;
+          for (unsigned int k = 0; k < n_comp; ++k)
+            U_i[k] = buffer[c * record_size + j * n_comp + k];
+          U.write_tensor(U_i, i);
+        }
+      }
+
+      U.update_ghost_values();
+    }
+
+
+    /**
+     * A small helper class that writes the locally owned part of a state
+     * vector directly (i.e., without copying components into temporary
+     * scalar vectors) into a single file with collective MPI IO.
+     *
+     * If @p asynchronous is set the local data is copied into a staging
+     * buffer and written out via a nonblocking collective write
+     * (MPI_File_iwrite_at_all). The write is completed and the checkpoint
+     * files are rotated in finish(), which is called automatically at the
+     * beginning of every subsequent start().
+     *
+     * With a full checkpoint interval larger than one (see
+     * set_full_interval()) only every n-th checkpoint stores the state
+     * vector (and the mesh). All other checkpoints store a compressed
+     * difference against the state of the last full checkpoint in a
+     * ".delta" file. Note that the rotated "~" backup of a differential
+     * checkpoint refers to the current (not the backed up) full state.
+     *
+     * If a local path is set (see set_local_path()) full checkpoints are
+     * instead written by every rank into a file in the given (typically
+     * node-local) directory. Only this write is blocking; the file is then
+     * drained on a background thread into a per-rank chunk file
+     * new_name + ".state.<rank>" next to the other checkpoint files.
+     *
+     * @note The resulting checkpoint can only be resumed with the same
+     * number of MPI ranks.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <typename Number>
+    class CollectiveWriter
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      CollectiveWriter(const bool asynchronous = false)
+          : asynchronous_(asynchronous)
+          , full_interval_(1)
+          , n_since_full_(0)
+          , reference_valid_(false)
+          , differential_(false)
+          , pending_(false)
+          , request_pending_(false)
+      {
+      }
+
+      CollectiveWriter(const CollectiveWriter &) = delete;
+      CollectiveWriter &operator=(const CollectiveWriter &) = delete;
+
+      /**
+       * Destructor. Completes a pending write.
+       */
+      ~CollectiveWriter()
+      {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (pending_ && !finalized)
+          finish();
+      }
+
+      /**
+       * Set whether subsequent writes are asynchronous.
+       */
+      void set_asynchronous(const bool asynchronous)
+      {
+        asynchronous_ = asynchronous;
+      }
+
+      /**
+       * Set a (node-local) directory for staging full checkpoints. An
+       * empty path disables staging.
+       */
+      void set_local_path(const std::string &local_path)
+      {
+        local_path_ = local_path;
+      }
+
+      /**
+       * Set the interval of full checkpoints. The default of one stores
+       * the full state with every checkpoint.
+       */
+      void set_full_interval(const unsigned int full_interval)
+      {
+        AssertThrow(full_interval >= 1,
+                    dealii::ExcMessage("The full checkpoint interval must be "
+                                       "at least one."));
+        full_interval_ = full_interval;
+      }
+
+      /**
+       * Invalidate the reference state of the last full checkpoint. This
+       * function has to be called whenever the mesh or its partitioning
+       * changed. The next checkpoint is then a full checkpoint.
+       */
+      void invalidate_reference()
+      {
+        finish();
+        reference_valid_ = false;
+        reference_.clear();
+        reference_.shrink_to_fit();
+      }
+
+      /**
+       * Decide whether the next checkpoint of the @p n_local entries
+       * starting at @p data is a differential one and, if so, encode the
+       * difference against the last full checkpoint. Returns true for a
+       * differential checkpoint. The function is collective and must be
+       * called before start().
+       */
+      bool prepare(const Number *data,
+                   const std::size_t n_local,
+                   const MPI_Comm &mpi_communicator)
+      {
+        finish();
+
+        const bool local_valid =
+            reference_valid_ && reference_.size() == n_local;
+        differential_ =
+            dealii::Utilities::MPI::min(local_valid ? 1u : 0u,
+                                        mpi_communicator) == 1u &&
+            n_since_full_ + 1 < full_interval_;
+
+        if (differential_)
+          delta_ = encode_delta(data, reference_.data(), n_local);
+
+        return differential_;
+      }
+
+      /**
+       * Return the size (in bytes) of the delta encoded by the last call
+       * to prepare().
+       */
+      std::size_t delta_size() const
+      {
+        return differential_ ? delta_.size() : 0;
+      }
+
+      /**
+       * Write @p n_local entries starting at @p data into the file
+       * new_name + ".state". All ranks store their part contiguously in
+       * the order of their rank. Once the write has completed the
+       * checkpoint @p new_name is rotated into @p name.
+       *
+       * If the preceding call to prepare() returned true, only the
+       * encoded difference is written into the file new_name + ".delta".
+       */
+      void start(const std::string &new_name,
+                 const std::string &name,
+                 const Number *data,
+                 const std::size_t n_local,
+                 const MPI_Comm &mpi_communicator)
+      {
+        finish();
+
+        new_name_ = new_name;
+        name_ = name;
+        mpi_communicator_ = mpi_communicator;
+
+        if (differential_) {
+          start_differential();
+          return;
+        }
+
+        if (full_interval_ > 1) {
+          reference_.assign(data, data + n_local);
+          reference_valid_ = true;
+        }
+        n_since_full_ = 0;
+
+        if (!local_path_.empty()) {
+          start_staged(data, n_local);
+          return;
+        }
+
+        unsigned long long local_size = n_local;
+        unsigned long long offset = 0;
+        int ierr = MPI_Exscan(&local_size,
+                              &offset,
+                              1,
+                              MPI_UNSIGNED_LONG_LONG,
+                              MPI_SUM,
+                              mpi_communicator_);
+        AssertThrowMPI(ierr);
+        if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator_) == 0)
+          offset = 0;
+
+        const std::string filename = new_name_ + ".state";
+        ierr = MPI_File_open(mpi_communicator_,
+                             filename.c_str(),
+                             MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                             MPI_INFO_NULL,
+                             &file_);
+        AssertThrowMPI(ierr);
+        ierr = MPI_File_set_size(file_, 0);
+        AssertThrowMPI(ierr);
+
+        const MPI_Offset byte_offset = offset * sizeof(Number);
+
+        if (asynchronous_) {
+          buffer_.assign(data, data + n_local);
+          ierr = MPI_File_iwrite_at_all(file_,
+                                        byte_offset,
+                                        buffer_.data(),
+                                        n_local,
+                                        mpi_type<Number>(),
+                                        &request_);
+          AssertThrowMPI(ierr);
+          request_pending_ = true;
+          pending_ = true;
+
+        } else {
+          ierr = MPI_File_write_at_all(file_,
+                                       byte_offset,
+                                       data,
+                                       n_local,
+                                       mpi_type<Number>(),
+                                       MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          pending_ = true;
+          finish();
+        }
+      }
+
+      /**
+       * Complete a pending write and rotate the checkpoint files. The
+       * function returns immediately if no write is pending.
+       */
+      void finish()
+      {
+        if (!pending_)
+          return;
+
+        if (drain_status_.valid()) {
+          /* Rethrows an exception that might have occured in the drain: */
+          drain_status_.get();
+          pending_ = false;
+          rotate_checkpoint(new_name_, name_, mpi_communicator_);
+          return;
+        }
+
+        int ierr;
+        if (request_pending_) {
+          ierr = MPI_Wait(&request_, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          request_pending_ = false;
+        }
+
+        ierr = MPI_File_close(&file_);
+        AssertThrowMPI(ierr);
+
+        buffer_.clear();
+        buffer_.shrink_to_fit();
+        pending_ = false;
+
+        rotate_checkpoint(new_name_, name_, mpi_communicator_, differential_);
+
+        delta_.clear();
+        delta_.shrink_to_fit();
+        differential_ = false;
+      }
+
+    private:
+      /**
+       * Write the locally owned state into a file in the local path and
+       * drain it asynchronously into new_name + ".state.<rank>".
+       */
+      void start_staged(const Number *data, const std::size_t n_local)
+      {
+        const auto suffix = chunk_suffix(mpi_communicator_);
+        const auto local_name =
+            std::filesystem::path(local_path_) /
+            (std::filesystem::path(new_name_).filename().string() + suffix);
+
+        {
+          std::ofstream file(local_name, std::ios::binary | std::ios::trunc);
+          file.write(reinterpret_cast<const char *>(data),
+                     n_local * sizeof(Number));
+          AssertThrow(file.good(),
+                      dealii::ExcMessage("Could not write checkpoint chunk »" +
+                                         local_name.string() + "«"));
+        }
+
+        const auto target = new_name_ + suffix;
+        drain_status_ = std::async(std::launch::async, [local_name, target]() {
+          std::filesystem::copy_file(
+              local_name,
+              target,
+              std::filesystem::copy_options::overwrite_existing);
+          std::filesystem::remove(local_name);
+        });
+        pending_ = true;
+      }
+
+      /**
+       * Write the delta encoded in prepare() into new_name + ".delta".
+       */
+      void start_differential()
+      {
+        unsigned long long local_size = delta_.size();
+        unsigned long long offset = 0;
+        int ierr = MPI_Exscan(&local_size,
+                              &offset,
+                              1,
+                              MPI_UNSIGNED_LONG_LONG,
+                              MPI_SUM,
+                              mpi_communicator_);
+        AssertThrowMPI(ierr);
+        if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator_) == 0)
+          offset = 0;
+
+        const std::string filename = new_name_ + ".delta";
+        ierr = MPI_File_open(mpi_communicator_,
+                             filename.c_str(),
+                             MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                             MPI_INFO_NULL,
+                             &file_);
+        AssertThrowMPI(ierr);
+        ierr = MPI_File_set_size(file_, 0);
+        AssertThrowMPI(ierr);
+
+        /* delta_ is kept alive until finish(): */
+        if (asynchronous_) {
+          ierr = MPI_File_iwrite_at_all(file_,
+                                        offset,
+                                        delta_.data(),
+                                        delta_.size(),
+                                        MPI_BYTE,
+                                        &request_);
+          AssertThrowMPI(ierr);
+          request_pending_ = true;
+          pending_ = true;
+
+        } else {
+          ierr = MPI_File_write_at_all(file_,
+                                       offset,
+                                       delta_.data(),
+                                       delta_.size(),
+                                       MPI_BYTE,
+                                       MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+          pending_ = true;
+          finish();
+        }
+
+        n_since_full_++;
+      }
+
+      bool asynchronous_;
+
+      std::string local_path_;
+      std::future<void> drain_status_;
+
+      unsigned int full_interval_;
+      unsigned int n_since_full_;
+      bool reference_valid_;
+      std::vector<Number> reference_;
+      bool differential_;
+      std::string delta_;
+
+      bool pending_;
+      bool request_pending_;
+
+      std::string new_name_;
+      std::string name_;
+      MPI_Comm mpi_communicator_;
+
+      MPI_File file_;
+      MPI_Request request_;
+      std::vector<Number> buffer_;
+    };
+
     /**
      * Performs a resume operation. Given a @p base_name the function tries
      * to locate correponding checkpoint files and will read in the saved
@@ -43,6 +864,7 @@ namespace ryujin
         discretization.refinement() = 0; /* do not refine */
         discretization.prepare();
         discretization.triangulation().load(base_name + "-checkpoint.mesh");
+        discretization.update_mapping();
       } else {
         AssertThrow(false, dealii::ExcNotImplemented());
         __builtin_trap();
@@ -68,6 +890,223 @@ namespace ryujin
       if constexpr (have_distributed_triangulation<dim>) {
         const auto &dof_handler = offline_data.dof_handler();
 
+        std::string name = base_name + "-checkpoint";
+        const auto this_process =
+            dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+        const auto n_processes =
+            dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+        /*
+         * Checkpoints written with the CollectiveWriter store the state in
+         * a separate ".state" file (collective_state == 1), or in one
+         * ".state.<rank>" chunk per rank (collective_state == 2).
+         * Partition independent checkpoints store the state in a ".cells"
+         * file (collective_state == 3):
+         */
+
+        int collective_state = 0;
+        if (this_process == 0) {
+          if (std::filesystem::exists(name + ".state.0"))
+            collective_state = 2;
+          else if (std::filesystem::exists(name + ".state"))
+            collective_state = 1;
+          else if (std::filesystem::exists(name + ".cells"))
+            collective_state = 3;
+        }
+        int ierr =
+            MPI_Bcast(&collective_state, 1, MPI_INT, 0, mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        /* Read in and broadcast metadata: */
+
+        std::vector<unsigned long long> local_sizes;
+        std::vector<unsigned long long> delta_sizes;
+        std::vector<unsigned long long> fingerprints;
+        if (this_process == 0) {
+          std::string meta = name + ".metadata";
+
+          std::ifstream file(meta, std::ios::binary);
+          boost::archive::binary_iarchive ia(file);
+          ia >> t >> output_cycle;
+          if (collective_state == 1 || collective_state == 2) {
+            ia >> local_sizes;
+            /*
+             * Checkpoints of older versions do not store delta sizes and
+             * partition fingerprints:
+             */
+            try {
+              ia >> delta_sizes;
+            } catch (const boost::archive::archive_exception &) {
+              delta_sizes.clear();
+            }
+            try {
+              ia >> fingerprints;
+            } catch (const boost::archive::archive_exception &) {
+              fingerprints.clear();
+            }
+          }
+        }
+
+        if constexpr (std::is_same_v<Number, double>)
+          ierr = MPI_Bcast(&t, 1, MPI_DOUBLE, 0, mpi_communicator);
+        else
+          ierr = MPI_Bcast(&t, 1, MPI_FLOAT, 0, mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_Bcast(&output_cycle, 1, MPI_UNSIGNED, 0, mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        if (collective_state == 3) {
+          read_cell_ordered_state(
+              offline_data, U, name + ".cells", mpi_communicator);
+
+          ierr = MPI_Barrier(mpi_communicator);
+          AssertThrowMPI(ierr);
+          return;
+        }
+
+        if (collective_state) {
+          /* Verify that the partitioning matches: */
+
+          unsigned int n_saved_processes = local_sizes.size();
+          ierr = MPI_Bcast(
+              &n_saved_processes, 1, MPI_UNSIGNED, 0, mpi_communicator);
+          AssertThrowMPI(ierr);
+          AssertThrow(n_saved_processes == n_processes,
+                      dealii::ExcMessage(
+                          "The checkpoint was written with collective MPI IO "
+                          "on a different number of MPI ranks."));
+
+          local_sizes.resize(n_processes);
+          ierr = MPI_Bcast(local_sizes.data(),
+                           n_processes,
+                           MPI_UNSIGNED_LONG_LONG,
+                           0,
+                           mpi_communicator);
+          AssertThrowMPI(ierr);
+
+          /*
+           * The local sizes alone do not identify the numbering of the
+           * degrees of freedom. Thus, we also compare the partition
+           * fingerprint of every rank (if stored):
+           */
+
+          unsigned int n_fingerprints = fingerprints.size();
+          ierr = MPI_Bcast(
+              &n_fingerprints, 1, MPI_UNSIGNED, 0, mpi_communicator);
+          AssertThrowMPI(ierr);
+
+          if (n_fingerprints != 0) {
+            fingerprints.resize(n_processes);
+            ierr = MPI_Bcast(fingerprints.data(),
+                             n_processes,
+                             MPI_UNSIGNED_LONG_LONG,
+                             0,
+                             mpi_communicator);
+            AssertThrowMPI(ierr);
+          }
+
+          const unsigned long long local_size = U.locally_owned_size();
+          const bool local_match =
+              local_sizes[this_process] == local_size &&
+              (n_fingerprints == 0 || fingerprints[this_process] ==
+                                          offline_data.partition_fingerprint());
+          const bool match = dealii::Utilities::MPI::min(
+              local_match ? 1u : 0u, mpi_communicator);
+          AssertThrow(match,
+                      dealii::ExcMessage(
+                          "The checkpoint was written with collective MPI IO "
+                          "for a different partitioning or numbering of the "
+                          "mesh."));
+
+          unsigned long long offset = 0;
+          for (unsigned int p = 0; p < this_process; ++p)
+            offset += local_sizes[p];
+
+          /* Read the locally owned part of U directly: */
+
+          MPI_File file;
+          if (collective_state == 2) {
+            const auto chunk_name = name + chunk_suffix(mpi_communicator);
+            std::ifstream chunk(chunk_name, std::ios::binary);
+            chunk.read(reinterpret_cast<char *>(U.begin()),
+                       local_size * sizeof(Number));
+            AssertThrow(
+                chunk.good(),
+                dealii::ExcMessage("Could not read checkpoint chunk »" +
+                                   chunk_name + "«"));
+
+          } else {
+            const std::string filename = name + ".state";
+            ierr = MPI_File_open(mpi_communicator,
+                                 filename.c_str(),
+                                 MPI_MODE_RDONLY,
+                                 MPI_INFO_NULL,
+                                 &file);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_read_at_all(file,
+                                        offset * sizeof(Number),
+                                        U.begin(),
+                                        local_size,
+                                        mpi_type<Number>(),
+                                        MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_close(&file);
+            AssertThrowMPI(ierr);
+          }
+
+          /* Apply the difference of a differential checkpoint: */
+
+          unsigned int n_deltas = delta_sizes.size();
+          ierr = MPI_Bcast(&n_deltas, 1, MPI_UNSIGNED, 0, mpi_communicator);
+          AssertThrowMPI(ierr);
+
+          if (n_deltas != 0) {
+            delta_sizes.resize(n_processes);
+            ierr = MPI_Bcast(delta_sizes.data(),
+                             n_processes,
+                             MPI_UNSIGNED_LONG_LONG,
+                             0,
+                             mpi_communicator);
+            AssertThrowMPI(ierr);
+
+            unsigned long long delta_offset = 0;
+            for (unsigned int p = 0; p < this_process; ++p)
+              delta_offset += delta_sizes[p];
+
+            std::string delta(delta_sizes[this_process], '\0');
+
+            const std::string delta_filename = name + ".delta";
+            ierr = MPI_File_open(mpi_communicator,
+                                 delta_filename.c_str(),
+                                 MPI_MODE_RDONLY,
+                                 MPI_INFO_NULL,
+                                 &file);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_read_at_all(file,
+                                        delta_offset,
+                                        delta.data(),
+                                        delta.size(),
+                                        MPI_BYTE,
+                                        MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_close(&file);
+            AssertThrowMPI(ierr);
+
+            apply_delta(delta, U.begin(), local_size);
+          }
+
+          U.update_ghost_values();
+
+          ierr = MPI_Barrier(mpi_communicator);
+          AssertThrowMPI(ierr);
+          return;
+        }
+
         /* Create temporary scalar component vectors: */
 
         const auto &scalar_partitioner = offline_data.scalar_partitioner();
@@ -98,28 +1137,6 @@ namespace ryujin
         }
         U.update_ghost_values();
 
-        /* Read in and broadcast metadata: */
-
-        std::string name = base_name + "-checkpoint";
-
-        if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
-          std::string meta = name + ".metadata";
-
-          std::ifstream file(meta, std::ios::binary);
-          boost::archive::binary_iarchive ia(file);
-          ia >> t >> output_cycle;
-        }
-
-        int ierr;
-        if constexpr (std::is_same_v<Number, double>)
-          ierr = MPI_Bcast(&t, 1, MPI_DOUBLE, 0, mpi_communicator);
-        else
-          ierr = MPI_Bcast(&t, 1, MPI_FLOAT, 0, mpi_communicator);
-        AssertThrowMPI(ierr);
-
-        ierr = MPI_Bcast(&output_cycle, 1, MPI_UNSIGNED, 0, mpi_communicator);
-        AssertThrowMPI(ierr);
-
         ierr = MPI_Barrier(mpi_communicator);
         AssertThrowMPI(ierr);
 
@@ -135,6 +1152,15 @@ namespace ryujin
      * state @p U at time @p t and output cycle @p output_cycle the function
      * writes out the state to disk using boost::archive for serialization.
      *
+     * If @p collective_writer is a nullptr the state vector is attached to
+     * the mesh with a SolutionTransfer object. Otherwise, the locally owned
+     * part of @p U is written with collective MPI IO via the supplied
+     * CollectiveWriter (possibly asynchronously, and possibly as a
+     * differential checkpoint without mesh).
+     *
+     * All files are written under a temporary name first and rotated in
+     * place once the checkpoint is complete.
+     *
      * @todo Some day, we should refactor this into a class and do something
      * smarter...
      *
@@ -147,59 +1173,144 @@ namespace ryujin
                      const MultiComponentVector<Number, n_comp, simd_length> &U,
                      const Number t,
                      const unsigned int output_cycle,
-                     const MPI_Comm &mpi_communicator)
+                     const MPI_Comm &mpi_communicator,
+                     CollectiveWriter<Number> *collective_writer = nullptr)
     {
       if constexpr (have_distributed_triangulation<dim>) {
         const auto &triangulation =
             offline_data.discretization().triangulation();
         const auto &dof_handler = offline_data.dof_handler();
 
+        /*
+         * Complete (and rotate) a previous asynchronous checkpoint and
+         * decide whether this is a differential checkpoint:
+         */
+        bool differential = false;
+        if (collective_writer != nullptr)
+          differential = collective_writer->prepare(
+              U.begin(), U.locally_owned_size(), mpi_communicator);
+
+        std::string name = base_name + "-checkpoint";
+        std::string new_name = name + "-new";
+
+        const auto this_process =
+            dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+
         /* Copy state into scalar component vectors: */
 
         const auto &scalar_partitioner = offline_data.scalar_partitioner();
 
         using scalar_type = typename OfflineData<dim, Number>::scalar_type;
         std::array<scalar_type, n_comp> state_vector;
-        unsigned int d = 0;
-        for (auto &it : state_vector) {
-          it.reinit(scalar_partitioner);
-          U.extract_component(it, d++);
-        }
 
         /* Create SolutionTransfer object, attach state vector and write out: */
 
         dealii::parallel::distributed::SolutionTransfer<dim, scalar_type>
             solution_transfer(dof_handler);
 
-        std::vector<const scalar_type *> ptr_state;
-        std::transform(state_vector.begin(),
-                       state_vector.end(),
-                       std::back_inserter(ptr_state),
-                       [](auto &it) { return &it; });
-        solution_transfer.prepare_for_serialization(ptr_state);
-
-        std::string name = base_name + "-checkpoint";
+        if (collective_writer == nullptr) {
+          unsigned int d = 0;
+          for (auto &it : state_vector) {
+            it.reinit(scalar_partitioner);
+            U.extract_component(it, d++);
+          }
 
-        if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
-          for (const std::string suffix :
-               {".mesh", ".mesh_fixed.data", ".mesh.info", ".metadata"})
-            if (std::filesystem::exists(name + suffix))
-              std::filesystem::rename(name + suffix, name + suffix + "~");
+          std::vector<const scalar_type *> ptr_state;
+          std::transform(state_vector.begin(),
+                         state_vector.end(),
+                         std::back_inserter(ptr_state),
+                         [](auto &it) { return &it; });
+          solution_transfer.prepare_for_serialization(ptr_state);
         }
 
-        triangulation.save(name + ".mesh");
+        /* The mesh is only stored with full checkpoints: */
+        if (!differential)
+          triangulation.save(new_name + ".mesh");
 
         /* Metadata: */
 
+        std::vector<unsigned long long> local_sizes;
+        std::vector<unsigned long long> delta_sizes;
+        std::vector<unsigned long long> fingerprints;
+        if (collective_writer != nullptr) {
+          local_sizes = dealii::Utilities::MPI::gather(
+              mpi_communicator,
+              static_cast<unsigned long long>(U.locally_owned_size()),
+              0);
+          fingerprints = dealii::Utilities::MPI::gather(
+              mpi_communicator, offline_data.partition_fingerprint(), 0);
+          if (differential)
+            delta_sizes = dealii::Utilities::MPI::gather(
+                mpi_communicator,
+                static_cast<unsigned long long>(
+                    collective_writer->delta_size()),
+                0);
+        }
+
+        if (this_process == 0) {
+          std::string meta = new_name + ".metadata";
+          std::ofstream file(meta, std::ios::binary | std::ios::trunc);
+          boost::archive::binary_oarchive oa(file);
+          oa << t << output_cycle;
+          if (collective_writer != nullptr)
+            oa << local_sizes << delta_sizes << fingerprints;
+        }
+
+        if (collective_writer != nullptr) {
+          collective_writer->start(new_name,
+                                   name,
+                                   U.begin(),
+                                   U.locally_owned_size(),
+                                   mpi_communicator);
+        } else {
+          rotate_checkpoint(new_name, name, mpi_communicator);
+        }
+
+      } else {
+        AssertThrow(false, dealii::ExcNotImplemented());
+        __builtin_trap();
+      }
+    }
+
+
+    /**
+     * Writes out a partition independent checkpoint to disk. The function
+     * stores the mesh and writes the state @p U with
+     * write_cell_ordered_state(). The checkpoint can be resumed with
+     * load_mesh() and load_state_vector() on an arbitrary number of MPI
+     * ranks without deserializing data attached to the mesh.
+     *
+     * @ingroup Miscellaneous
+     */
+    template <int dim, typename Number, int n_comp, int simd_length>
+    void write_cell_ordered_checkpoint(
+        const OfflineData<dim, Number> &offline_data,
+        const std::string &base_name,
+        const MultiComponentVector<Number, n_comp, simd_length> &U,
+        const Number t,
+        const unsigned int output_cycle,
+        const MPI_Comm &mpi_communicator)
+    {
+      if constexpr (have_distributed_triangulation<dim>) {
+        const auto &triangulation =
+            offline_data.discretization().triangulation();
+
+        std::string name = base_name + "-checkpoint";
+        std::string new_name = name + "-new";
+
+        triangulation.save(new_name + ".mesh");
+
+        write_cell_ordered_state(
+            offline_data, U, new_name + ".cells", mpi_communicator);
+
         if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
-          std::string meta = name + ".metadata";
+          std::string meta = new_name + ".metadata";
           std::ofstream file(meta, std::ios::binary | std::ios::trunc);
           boost::archive::binary_oarchive oa(file);
           oa << t << output_cycle;
         }
 
-        const int ierr = MPI_Barrier(mpi_communicator);
-        AssertThrowMPI(ierr);
+        rotate_checkpoint(new_name, name, mpi_communicator);
 
       } else {
         AssertThrow(false, dealii::ExcNotImplemented());
@@ -0,0 +1,124 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/config.h>
+
+namespace ryujin
+{
+  /**
+   * A Kahan-compensated accumulator for (vectorized) numbers and
+   * tensors thereof.
+   *
+   * The class keeps a running compensation term that captures the
+   * rounding error of every addition. This is used for accumulating the
+   * many (small) flux contributions of a row into the (large) value of
+   * the new state U_i in single precision builds, see the
+   * COMPENSATED_ACCUMULATION compile-time option.
+   *
+   * @note The compensation relies on strict IEEE semantics of addition
+   * and subtraction and thus must not be compiled with -ffast-math.
+   *
+   * @ingroup SIMD
+   */
+  template <typename T>
+  class CompensatedSum
+  {
+  public:
+    /**
+     * Constructor. Initialize the sum with zero.
+     */
+    DEAL_II_ALWAYS_INLINE inline CompensatedSum()
+        : sum_()
+        , compensation_()
+    {
+    }
+
+    /**
+     * Constructor. Initialize the sum with @p value.
+     */
+    DEAL_II_ALWAYS_INLINE inline CompensatedSum(const T &value)
+        : sum_(value)
+        , compensation_()
+    {
+    }
+
+    /**
+     * Add @p value to the sum.
+     */
+    DEAL_II_ALWAYS_INLINE inline CompensatedSum &operator+=(const T &value)
+    {
+      const T y = value - compensation_;
+      const T t = sum_ + y;
+      compensation_ = (t - sum_) - y;
+      sum_ = t;
+      return *this;
+    }
+
+    /**
+     * Subtract @p value from the sum.
+     */
+    DEAL_II_ALWAYS_INLINE inline CompensatedSum &operator-=(const T &value)
+    {
+      return *this += -value;
+    }
+
+    /**
+     * Return the (compensated) value of the sum.
+     */
+    DEAL_II_ALWAYS_INLINE inline T value() const
+    {
+      return sum_ - compensation_;
+    }
+
+  private:
+    T sum_;
+    T compensation_;
+  };
+
+
+  /**
+   * The type used for accumulating the low-order and high-order updates
+   * of a row. This is a CompensatedSum if the COMPENSATED_ACCUMULATION
+   * compile-time option is set, and the type @p T itself otherwise.
+   *
+   * @ingroup SIMD
+   */
+  template <typename T>
+#ifdef COMPENSATED_ACCUMULATION
+  using accumulator_type = CompensatedSum<T>;
+#else
+  using accumulator_type = T;
+#endif
+
+
+  /**
+   * Return the accumulated value of @p accumulator. This is the identity
+   * for an ordinary (non compensated) accumulator.
+   *
+   * @ingroup SIMD
+   */
+  template <typename T>
+  DEAL_II_ALWAYS_INLINE inline const T &accumulated_value(const T &accumulator)
+  {
+    return accumulator;
+  }
+
+
+  /**
+   * Variant of above function for a CompensatedSum.
+   *
+   * @ingroup SIMD
+   */
+  template <typename T>
+  DEAL_II_ALWAYS_INLINE inline T
+  accumulated_value(const CompensatedSum<T> &accumulator)
+  {
+    return accumulator.value();
+  }
+} // namespace ryujin
@@ -7,6 +7,8 @@
 
 #include <deal.II/base/function.h>
 
+#include <string>
+
 /**
  * @name Various convenience functions and macros
  */
@@ -72,6 +74,23 @@ namespace ryujin
   }
 
 
+  /**
+   * A simple (64 bit FNV-1a) hash over all characters of @p string. In
+   * contrast to std::hash the result does not depend on the compiler
+   * and standard library, so that it can be used for file names and
+   * fingerprints stored on disk.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline unsigned long long fnv_hash(const std::string &string)
+  {
+    unsigned long long hash = 14695981039346656037ull;
+    for (const unsigned char c : string)
+      hash = (hash ^ c) * 1099511628211ull;
+    return hash;
+  }
+
+
   /**
    * Contract a given rank-2 tensor flux_ij and a rank-1 tensor c_ij:
    */
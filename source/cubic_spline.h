@@ -5,14 +5,26 @@
 
 #pragma once
 
-#ifdef DEAL_II_WITH_GSL
-#include <gsl/gsl_spline.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/vectorization.h>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
 
 namespace ryujin
 {
   /**
-   * A cubic spline class implemented as a thin wrapper around the GSL
-   * spline library functions.
+   * A natural cubic spline interpolating a given set of support points.
+   *
+   * The second derivatives of the spline in the support points are
+   * computed once in the constructor by solving a tridiagonal system
+   * (with vanishing second derivatives at the end points, i.e., the same
+   * spline as GSL's gsl_interp_cspline). The spline is then stored as one
+   * cubic polynomial per interval. Evaluation only performs a binary
+   * search for the interval and does not modify any state, so a single
+   * CubicSpline object can be evaluated concurrently from many threads.
    *
    * Usage:
    * @code
@@ -32,63 +44,128 @@ namespace ryujin
      * Constructor.
      *
      * @pre The supplied vectors @p x and @p y must have the same size and
-     * must contain at least two elements. The vector @p x must be sorted
+     * must contain at least two elements. The vector @p x must be strictly
+     * increasing.
      */
-    CubicSpline(const std::vector<double> &x,
-                const std::vector<double> &y) noexcept
+    CubicSpline(const std::vector<double> &x, const std::vector<double> &y)
         : x_(x)
-        , y_(y)
+        , coefficients_(x.size() - 1)
     {
-      AssertNothrow(x_.size() == y_.size(), dealii::ExcInternalError());
-      AssertNothrow(x_.size() >= 2, dealii::ExcInternalError());
-      AssertNothrow(std::is_sorted(x_.begin(), x_.end()),
-                    dealii::ExcInternalError());
+      AssertThrow(x.size() == y.size() && x.size() >= 2,
+                  dealii::ExcMessage("A cubic spline needs at least two "
+                                     "support points and values"));
+      AssertThrow(std::adjacent_find(x.begin(),
+                                     x.end(),
+                                     std::greater_equal<double>()) ==
+                      x.end(),
+                  dealii::ExcMessage("The support points of a cubic spline "
+                                     "must be strictly increasing"));
+
+      const std::size_t n = x.size() - 1;
 
-      spline = gsl_spline_alloc(gsl_interp_cspline, x_.size());
-      gsl_spline_init(spline, x_.data(), y_.data(), x_.size());
+      std::vector<double> h(n);
+      for (std::size_t i = 0; i < n; ++i)
+        h[i] = x[i + 1] - x[i];
 
-      accel = gsl_interp_accel_alloc();
+      /*
+       * Solve for the second derivatives m_1, ..., m_{n-1} with the
+       * Thomas algorithm, m_0 = m_n = 0:
+       */
+      std::vector<double> m(n + 1, 0.);
+      std::vector<double> c_prime(n + 1, 0.);
+      for (std::size_t i = 1; i < n; ++i) {
+        const double rhs = 6. * ((y[i + 1] - y[i]) / h[i] -
+                                 (y[i] - y[i - 1]) / h[i - 1]);
+        const double diagonal =
+            2. * (h[i - 1] + h[i]) - h[i - 1] * c_prime[i - 1];
+        c_prime[i] = h[i] / diagonal;
+        m[i] = (rhs - h[i - 1] * m[i - 1]) / diagonal;
+      }
+      for (std::size_t i = n - 1; i >= 1; --i)
+        m[i] -= c_prime[i] * m[i + 1];
+
+      /* Polynomial coefficients with respect to s = x - x_i: */
+      for (std::size_t i = 0; i < n; ++i)
+        coefficients_[i] = {
+            {y[i],
+             (y[i + 1] - y[i]) / h[i] - h[i] * (2. * m[i] + m[i + 1]) / 6.,
+             0.5 * m[i],
+             (m[i + 1] - m[i]) / (6. * h[i])}};
     }
 
     /**
-     * Copy constructor.
+     * Evaluate the cubic spline at a given point @p x.
+     *
+     * @pre The point @p x must lie within the interval described by the
+     * largest and smallest support point supplied to the constructor.
      */
-    CubicSpline(const CubicSpline &copy)
-        : CubicSpline(copy.x_, copy.y_)
+    inline double eval(const double x) const
     {
+      const auto i = interval(x);
+      const auto &[a, b, c, d] = coefficients_[i];
+      const double s = x - x_[i];
+      return a + s * (b + s * (c + s * d));
     }
 
     /**
-     * The copy assignment operator is deleted.
+     * Evaluate the cubic spline for a batch of points stored in a
+     * VectorizedArray. The interval lookup is done per lane, the
+     * polynomial evaluation is vectorized.
      */
-    CubicSpline &operator=(const CubicSpline &) = delete;
+    template <typename Number, std::size_t width>
+    inline dealii::VectorizedArray<Number, width>
+    eval(const dealii::VectorizedArray<Number, width> &x) const
+    {
+      using VA = dealii::VectorizedArray<Number, width>;
+      VA x_i, a, b, c, d;
+      for (unsigned int k = 0; k < VA::size(); ++k) {
+        const auto i = interval(x[k]);
+        x_i[k] = x_[i];
+        a[k] = coefficients_[i][0];
+        b[k] = coefficients_[i][1];
+        c[k] = coefficients_[i][2];
+        d[k] = coefficients_[i][3];
+      }
+      const VA s = x - x_i;
+      return a + s * (b + s * (c + s * d));
+    }
 
     /**
-     * Destructor.
+     * Evaluate the cubic spline at all points @p x and store the result
+     * in @p y.
      */
-    ~CubicSpline()
+    void eval(const std::vector<double> &x, std::vector<double> &y) const
     {
-      gsl_interp_accel_free(accel);
-      gsl_spline_free(spline);
+      using VA = dealii::VectorizedArray<double>;
+      constexpr auto width = VA::size();
+
+      y.resize(x.size());
+      std::size_t k = 0;
+      for (; k + width <= x.size(); k += width) {
+        VA x_k;
+        x_k.load(x.data() + k);
+        eval(x_k).store(y.data() + k);
+      }
+      for (; k < x.size(); ++k)
+        y[k] = eval(x[k]);
     }
 
+  private:
     /**
-     * Evaluate the cubic spline at a given point @p x.
-     *
-     * @pre The point @p x must lie within the interval described by the
-     * largest and smallest support point supplied to the constructor.
+     * Return the index of the interval [x_i, x_{i+1}] containing @p x.
+     * Points outside of the support interval are assigned to the first
+     * (or last) interval.
      */
-    inline double eval(double x) const
+    inline std::size_t interval(const double x) const
     {
-      return gsl_spline_eval(spline, x, accel);
+      Assert(x >= x_.front() - 1.e-12 * (x_.back() - x_.front()) &&
+                 x <= x_.back() + 1.e-12 * (x_.back() - x_.front()),
+             dealii::ExcMessage("Point outside of the spline interval"));
+      const auto it = std::upper_bound(x_.begin() + 1, x_.end() - 1, x);
+      return std::distance(x_.begin(), it) - 1;
     }
 
-  private:
-    const std::vector<double> x_;
-    const std::vector<double> y_;
-    gsl_spline *spline;
-    mutable gsl_interp_accel *accel;
+    std::vector<double> x_;
+    std::vector<std::array<double, 4>> coefficients_;
   };
 } // namespace ryujin
-
-#endif
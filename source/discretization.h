@@ -17,6 +17,7 @@
 #include <deal.II/distributed/tria.h>
 #include <deal.II/fe/fe.h>
 #include <deal.II/fe/mapping.h>
+#include <deal.II/fe/mapping_q_cache.h>
 
 #include <memory>
 #include <set>
@@ -187,9 +188,64 @@ namespace ryujin
     /**
      * Create the triangulation and set up the finite element, mapping and
      * quadrature objects.
+     *
+     * If the "mesh cache coarse triangulation" option is set, the coarse
+     * mesh created by the selected geometry (including all attached
+     * manifolds) is stored in a serial triangulation and reused by
+     * subsequent calls to prepare() until the parameters are parsed
+     * again.
      */
     void prepare();
 
+    /**
+     * Update the mapping after the triangulation has changed.
+     *
+     * If the "mapping cache support points" option is set, the support
+     * points of the mapping are computed once for all cells of the current
+     * mesh and stored in a MappingQCache. This function has to be called
+     * after every refinement (or coarsening) of the triangulation in this
+     * case. Otherwise, the function does nothing and the MappingQ object
+     * created in prepare() evaluates the manifolds on the fly.
+     */
+    void update_mapping();
+
+    /**
+     * Set the measured throughput (for example, in degrees of freedom per
+     * second) of the calling MPI rank. If "mesh repartitioning" is set
+     * then the weights of all cells owned by a rank are scaled by the
+     * ratio of the largest throughput over all ranks and the throughput
+     * of the rank. Subsequent repartitioning steps (i.e., every call to
+     * execute_coarsening_and_refinement()) thus assign proportionally more
+     * cells to faster ranks. Because the weights always refer to the
+     * current owner of a cell the resulting partition converges over a
+     * few repartitioning steps.
+     *
+     * This function has to be called on all ranks.
+     */
+    void rank_speed(const double speed);
+
+    /**
+     * Set an additional (measured or estimated) cost for every locally
+     * owned active cell relative to the cost of an interior cell. The
+     * vector @p cost is indexed by the active cell index and is used by
+     * the next repartitioning step if "mesh repartitioning" is set. The
+     * values refer to the current mesh and have to be reset with an
+     * empty vector after the mesh has changed.
+     */
+    void cell_cost(std::vector<double> &&cost);
+
+    /**
+     * Create a distributed graph communicator from the current partition
+     * of the triangulation with MPI rank reordering enabled. Two ranks
+     * are connected if one owns ghost cells of the other, and the edge is
+     * weighted by the number of such ghost cells. The MPI library is thus
+     * free to place neighboring subdomains onto the same node. The caller
+     * takes ownership of the returned communicator.
+     *
+     * This function has to be called on all ranks.
+     */
+    MPI_Comm create_reordered_communicator() const;
+
     /**
      * @name Discretization compile time options
      */
@@ -220,6 +276,16 @@ namespace ryujin
      */
     ACCESSOR(refinement)
 
+    /**
+     * Return a read-only const reference to the mesh distortion.
+     */
+    ACCESSOR_READ_ONLY(mesh_distortion)
+
+    /**
+     * Return whether the mesh is repartitioned with cell weights.
+     */
+    ACCESSOR_READ_ONLY(repartitioning)
+
     /**
      * Return a mutable reference to the triangulation.
      */
@@ -264,6 +330,11 @@ namespace ryujin
     unsigned int refinement_;
 
     bool repartitioning_;
+    double repartitioning_boundary_weight_;
+    double repartitioning_hanging_node_weight_;
+
+    bool cache_coarse_triangulation_;
+    bool cache_mapping_support_points_;
 
     //@}
     /**
@@ -273,6 +344,14 @@ namespace ryujin
 
     std::set<std::unique_ptr<Geometry<dim>>> geometry_list_;
 
+    std::unique_ptr<dealii::Triangulation<dim>> coarse_triangulation_;
+
+    dealii::MappingQCache<dim> *mapping_cache_;
+
+    double relative_rank_cost_;
+
+    std::vector<double> cell_cost_;
+
     //@}
   };
 } /* namespace ryujin */
@@ -9,12 +9,18 @@
 
 #include "discretization.h"
 #include "geometry_library.h"
+#include "scope.h"
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <map>
 #include <random>
 
 namespace ryujin
@@ -26,6 +32,8 @@ namespace ryujin
                                       const std::string &subsection)
       : ParameterAcceptor(subsection)
       , mpi_communicator_(mpi_communicator)
+      , mapping_cache_(nullptr)
+      , relative_rank_cost_(1.)
   {
     const auto smoothing =
         dealii::Triangulation<dim>::limit_level_difference_at_vertices;
@@ -68,6 +76,43 @@ namespace ryujin
                   repartitioning_,
                   "try to equalize workload by repartitioning the mesh");
 
+    /*
+     * See the comment in prepare() for the choice of the default value:
+     */
+    constexpr auto speedup = dealii::VectorizedArray<NUMBER>::size() / 2u;
+    repartitioning_boundary_weight_ = speedup == 0u ? 0. : speedup - 1.;
+    add_parameter("mesh repartitioning boundary weight",
+                  repartitioning_boundary_weight_,
+                  "Additional cost of a cell at the boundary relative to the "
+                  "cost of an interior cell used for repartitioning the mesh");
+
+    repartitioning_hanging_node_weight_ = 0.;
+    add_parameter(
+        "mesh repartitioning hanging node weight",
+        repartitioning_hanging_node_weight_,
+        "Additional cost of a cell with a hanging node (i.e., a cell with "
+        "a coarser or a refined neighbor) relative to the cost of an "
+        "interior cell used for repartitioning the mesh");
+
+    cache_coarse_triangulation_ = false;
+    add_parameter(
+        "mesh cache coarse triangulation",
+        cache_coarse_triangulation_,
+        "Store the unrefined coarse mesh created by the geometry and reuse "
+        "it for subsequent mesh creations (for example for every level of "
+        "a benchmark run) instead of recreating it");
+
+    cache_mapping_support_points_ = false;
+    add_parameter("mapping cache support points",
+                  cache_mapping_support_points_,
+                  "Compute the support points of the (higher order) mapping "
+                  "once after every mesh change and store them instead of "
+                  "evaluating the manifolds on every access to the mapping");
+
+    /* Parameters of the geometries might have changed: */
+    ParameterAcceptor::parse_parameters_call_back.connect(
+        [this]() { coarse_triangulation_.reset(); });
+
     Geometries::populate_geometry_list<dim>(geometry_list_, subsection);
   }
 
@@ -82,7 +127,12 @@ namespace ryujin
     auto &triangulation = *triangulation_;
     triangulation.clear();
 
-    {
+    if (cache_coarse_triangulation_ && coarse_triangulation_) {
+      SetupScope scope("mesh - create coarse triangulation");
+      triangulation.copy_triangulation(*coarse_triangulation_);
+
+    } else {
+      SetupScope scope("mesh - create coarse triangulation");
       bool initialized = false;
       for (auto &it : geometry_list_)
         if (it->name() == geometry_) {
@@ -95,6 +145,16 @@ namespace ryujin
           initialized,
           ExcMessage("Could not find a geometry description with name \"" +
                      geometry_ + "\""));
+
+      /*
+       * Keep a serial copy of the coarse mesh. Geometries that already
+       * refine the mesh cannot be cached because a distributed
+       * triangulation can only be created from an unrefined mesh:
+       */
+      if (cache_coarse_triangulation_ && triangulation.n_global_levels() == 1) {
+        coarse_triangulation_ = std::make_unique<dealii::Triangulation<dim>>();
+        coarse_triangulation_->copy_triangulation(triangulation);
+      }
     }
 
     if constexpr (have_distributed_triangulation<dim>) {
@@ -118,8 +178,17 @@ namespace ryujin
          * (additional symmetrization of d_ij, boundary fixup) so it should be
          * safe to assume that the cost incurred is at least
          * VectorizedArray::size() / 2.
+         *
+         * After (adaptive) refinement, cells with hanging nodes create
+         * degrees of freedom with non-standard connectivity which are not
+         * SIMD parallelized either. Their cost can be accounted for with
+         * the hanging node weight. The weights are also used by p4est for
+         * rebalancing during every subsequent refinement.
+         *
+         * Finally, an additional measured cost can be supplied for every
+         * cell with cell_cost(), and the cost of all cells is scaled by
+         * the relative cost of the owning rank, see rank_speed().
          */
-        constexpr auto speedup = dealii::VectorizedArray<NUMBER>::size() / 2u;
         constexpr unsigned int weight = 1000u;
 
 #if DEAL_II_VERSION_GTE(9, 5, 0)
@@ -127,27 +196,151 @@ namespace ryujin
 #else
         triangulation.signals.cell_weight.connect(
 #endif
-            [](const auto &cell, const auto /*status*/) -> unsigned int {
+            [this](const auto &cell, const auto /*status*/) -> unsigned int {
+              double cost = 0.;
+
               if (cell->at_boundary())
-                return weight * (speedup == 0u ? 0u : speedup - 1u);
-              else
-                return 0u;
+                cost += repartitioning_boundary_weight_;
+
+              if (repartitioning_hanging_node_weight_ != 0.)
+                for (const auto f : cell->face_indices()) {
+                  if (cell->at_boundary(f))
+                    continue;
+                  if (cell->neighbor_is_coarser(f) ||
+                      cell->neighbor(f)->has_children()) {
+                    cost += repartitioning_hanging_node_weight_;
+                    break;
+                  }
+                }
+
+              if (cell->is_active() &&
+                  cell->active_cell_index() < cell_cost_.size())
+                cost += cell_cost_[cell->active_cell_index()];
+
+              const double total =
+                  weight * (1. + std::max(cost, 0.)) * relative_rank_cost_;
+              return static_cast<unsigned int>(std::round(total - weight));
             });
 
+        SetupScope scope("mesh - repartition");
         triangulation.repartition();
       }
     }
 
-    triangulation.refine_global(refinement_);
+    {
+      SetupScope scope("mesh - refine global");
+      triangulation.refine_global(refinement_);
+    }
 
     if (std::abs(mesh_distortion_) > 1.0e-10)
       GridTools::distort_random(
           mesh_distortion_, triangulation, std::random_device()());
 
-    mapping_ = std::make_unique<MappingQ<dim>>(order_mapping);
+    if (cache_mapping_support_points_) {
+      auto mapping_cache = std::make_unique<MappingQCache<dim>>(order_mapping);
+      mapping_cache_ = mapping_cache.get();
+      mapping_ = std::move(mapping_cache);
+    } else {
+      mapping_cache_ = nullptr;
+      mapping_ = std::make_unique<MappingQ<dim>>(order_mapping);
+    }
+    update_mapping();
+
     finite_element_ = std::make_unique<FE_Q<dim>>(order_finite_element);
     quadrature_ = std::make_unique<QGauss<dim>>(order_quadrature);
     quadrature_1d_ = std::make_unique<QGauss<1>>(order_quadrature);
   }
 
+
+  template <int dim>
+  void Discretization<dim>::rank_speed(const double speed)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "Discretization<dim>::rank_speed()" << std::endl;
+#endif
+
+    AssertThrow(speed > 0. && std::isfinite(speed),
+                ExcMessage("The rank speed must be positive"));
+
+    const double max_speed = Utilities::MPI::max(speed, mpi_communicator_);
+    relative_rank_cost_ = max_speed / speed;
+  }
+
+
+  template <int dim>
+  void Discretization<dim>::cell_cost(std::vector<double> &&cost)
+  {
+    cell_cost_ = std::move(cost);
+  }
+
+
+  template <int dim>
+  MPI_Comm Discretization<dim>::create_reordered_communicator() const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "Discretization<dim>::create_reordered_communicator()"
+              << std::endl;
+#endif
+
+    /* Count the ghost cells we receive from every neighboring rank: */
+    std::map<unsigned int, int> sources;
+    for (const auto &cell : triangulation_->active_cell_iterators())
+      if (cell->is_ghost())
+        sources[cell->subdomain_id()]++;
+
+    /*
+     * Communicate the counts to the owners so that both sides of every
+     * edge agree on its weight:
+     */
+    const auto destinations =
+        Utilities::MPI::some_to_some(mpi_communicator_, sources);
+
+    std::vector<int> source_ranks, source_weights;
+    for (const auto &[rank, weight] : sources) {
+      source_ranks.push_back(rank);
+      source_weights.push_back(weight);
+    }
+
+    std::vector<int> destination_ranks, destination_weights;
+    for (const auto &[rank, weight] : destinations) {
+      destination_ranks.push_back(rank);
+      destination_weights.push_back(weight);
+    }
+
+    MPI_Comm graph_communicator;
+    const int ierr = MPI_Dist_graph_create_adjacent(mpi_communicator_,
+                                                    source_ranks.size(),
+                                                    source_ranks.data(),
+                                                    source_weights.data(),
+                                                    destination_ranks.size(),
+                                                    destination_ranks.data(),
+                                                    destination_weights.data(),
+                                                    MPI_INFO_NULL,
+                                                    /*reorder*/ 1,
+                                                    &graph_communicator);
+    AssertThrowMPI(ierr);
+
+    return graph_communicator;
+  }
+
+
+  template <int dim>
+  void Discretization<dim>::update_mapping()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "Discretization<dim>::update_mapping()" << std::endl;
+#endif
+
+    if (mapping_cache_ == nullptr)
+      return;
+
+    SetupScope scope("mesh - mapping cache");
+    /*
+     * Evaluate the support points of all (non-artificial) cells with the
+     * usual MappingQ (and thus, the manifolds attached to the mesh) once
+     * and store them:
+     */
+    mapping_cache_->initialize(MappingQ<dim>(order_mapping), *triangulation_);
+  }
+
 } /* namespace ryujin */
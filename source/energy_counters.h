@@ -0,0 +1,357 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef WITH_NVML
+#include <nvml.h>
+#endif
+
+namespace ryujin
+{
+  /**
+   * A minimal energy counter backend. The following (node level) energy
+   * counters are supported:
+   *
+   *  - Intel and AMD RAPL counters exposed by the Linux powercap
+   *    interface in /sys/class/powercap: all packages and, if available,
+   *    the DRAM domains of all packages. Note that the energy_uj files
+   *    are only readable by root on most recent kernels unless the
+   *    system administrator relaxed the permissions.
+   *  - The total energy consumption of all GPUs reported by NVML (only
+   *    if configured with WITH_NVML).
+   *
+   * Because all counters measure the whole node only one rank per node
+   * (the rank 0 of the node local communicator obtained with
+   * MPI_Comm_split_type) reads the counters, all other ranks report zero
+   * energy. The energy of the whole computation is thus obtained by
+   * summing over all ranks.
+   *
+   * Energy is accumulated per section of a Scope object while the
+   * counters are active, see set_active(). Usage:
+   *
+   * @code
+   * energy_counters.reinit(enabled, mpi_communicator);
+   * EnergyCounters::set_active(&energy_counters);
+   * {
+   *   Scope scope(computing_timer, "time step");
+   *   // work
+   * }
+   * const double energy = energy_counters.read();
+   * @endcode
+   *
+   * Counter overflows are handled as long as the counters are read at
+   * least once per wraparound interval (typically minutes). All functions
+   * are no-ops if the counters are disabled or not available. Not thread
+   * safe.
+   *
+   * @ingroup Miscellaneous
+   */
+  class EnergyCounters
+  {
+  public:
+    EnergyCounters() = default;
+
+    EnergyCounters(const EnergyCounters &) = delete;
+    EnergyCounters &operator=(const EnergyCounters &) = delete;
+
+    /**
+     * Destructor. Closes all counters.
+     */
+    ~EnergyCounters()
+    {
+      if (active() == this)
+        set_active(nullptr);
+      close();
+    }
+
+    /**
+     * (Re)open all energy counters if @p enabled is true, or close them
+     * otherwise. Recorded data is cleared. This function has to be called
+     * on all ranks of @p mpi_communicator.
+     */
+    void reinit(const bool enabled, const MPI_Comm &mpi_communicator)
+    {
+      close();
+      clear();
+      enabled_ = enabled;
+      if (!enabled_)
+        return;
+
+      MPI_Comm node_communicator;
+      int ierr = MPI_Comm_split_type(mpi_communicator,
+                                     MPI_COMM_TYPE_SHARED,
+                                     /*key*/ 0,
+                                     MPI_INFO_NULL,
+                                     &node_communicator);
+      AssertThrowMPI(ierr);
+      const auto node_rank =
+          dealii::Utilities::MPI::this_mpi_process(node_communicator);
+      ierr = MPI_Comm_free(&node_communicator);
+      AssertThrowMPI(ierr);
+
+      if (node_rank != 0)
+        return;
+
+      open_rapl();
+#ifdef WITH_NVML
+      open_nvml();
+#endif
+
+      /* Initialize the last values of all counters: */
+      read();
+      energy_ = 0.;
+    }
+
+    /**
+     * Return whether the counters are enabled.
+     */
+    bool enabled() const
+    {
+      return enabled_;
+    }
+
+    /**
+     * Clear all recorded data.
+     */
+    void clear()
+    {
+      sections_.clear();
+    }
+
+    /**
+     * Return the energy (in Joules) consumed by the node since the call
+     * to reinit(). Returns zero on all but one rank per node.
+     */
+    double read()
+    {
+#ifdef __linux__
+      for (auto &domain : domains_) {
+        char buffer[32] = {};
+        if (::pread(domain.fd, buffer, sizeof(buffer) - 1, 0) <= 0)
+          continue;
+        const double value = std::strtod(buffer, nullptr);
+        double delta = value - domain.last;
+        if (delta < 0.)
+          delta += domain.range;
+        domain.last = value;
+        energy_ += 1.e-6 * delta;
+      }
+#endif
+#ifdef WITH_NVML
+      for (auto &gpu : gpus_) {
+        unsigned long long value = 0;
+        if (nvmlDeviceGetTotalEnergyConsumption(gpu.device, &value) !=
+            NVML_SUCCESS)
+          continue;
+        energy_ += 1.e-3 * (double(value) - gpu.last);
+        gpu.last = double(value);
+      }
+#endif
+      return energy_;
+    }
+
+    /**
+     * Add @p energy (in Joules) to the section @p name.
+     */
+    void accumulate(const std::string &name, const double energy)
+    {
+      sections_[name] += energy;
+    }
+
+    /**
+     * Print a table with the energy consumed in every section to
+     * @p output on rank 0. Energies are summed over all ranks. This
+     * function has to be called on all ranks.
+     */
+    void print_statistics(std::ostream &output,
+                          const MPI_Comm &mpi_communicator) const
+    {
+      if (!enabled_)
+        return;
+
+      std::vector<double> values;
+      for (const auto &it : sections_)
+        values.push_back(it.second);
+      values.push_back(n_counters());
+      values = dealii::Utilities::MPI::sum(values, mpi_communicator);
+
+      const auto rank = dealii::Utilities::MPI::this_mpi_process(
+          mpi_communicator);
+      if (rank != 0)
+        return;
+
+      std::ostringstream stream;
+      stream << "\nEnergy statistics (" << values.back()
+             << " counters on all nodes):\n";
+      if (values.back() == 0.)
+        stream << "  [unavailable: no readable RAPL or NVML counters]\n";
+
+      unsigned int k = 0;
+      for (const auto &it : sections_)
+        stream << "  " << std::left << std::setw(50) << it.first << std::right
+               << std::scientific << std::setprecision(4) << std::setw(12)
+               << values[k++] << " J\n";
+
+      output << stream.str() << std::flush;
+    }
+
+    /**
+     * Return the counters that all Scope objects record their energy
+     * consumption in, or a nullptr if none are active.
+     */
+    static EnergyCounters *active()
+    {
+      return active_;
+    }
+
+    /**
+     * Select the counters that all Scope objects record their energy
+     * consumption in. Disabled counters are ignored.
+     */
+    static void set_active(EnergyCounters *counters)
+    {
+      active_ = (counters != nullptr && counters->enabled()) ? counters
+                                                               : nullptr;
+    }
+
+  private:
+    /**
+     * Return the number of counters opened on this rank.
+     */
+    double n_counters() const
+    {
+#ifdef WITH_NVML
+      return domains_.size() + gpus_.size();
+#else
+      return domains_.size();
+#endif
+    }
+
+    /**
+     * Open all package and DRAM RAPL domains of the powercap interface.
+     */
+    void open_rapl()
+    {
+#ifdef __linux__
+      namespace fs = std::filesystem;
+      std::error_code error;
+      const fs::path root("/sys/class/powercap");
+      if (!fs::is_directory(root, error))
+        return;
+
+      for (const auto &entry : fs::directory_iterator(root, error)) {
+        const auto zone = entry.path().filename().string();
+        /* Top level zones "intel-rapl:<n>" and subzones "...:<n>:<m>": */
+        if (zone.rfind("intel-rapl:", 0) != 0)
+          continue;
+        const bool subzone = std::count(zone.begin(), zone.end(), ':') > 1;
+
+        std::string name;
+        std::ifstream(entry.path() / "name") >> name;
+        if (subzone && name != "dram")
+          continue;
+
+        double range = 0.;
+        std::ifstream(entry.path() / "max_energy_range_uj") >> range;
+
+        const int fd = ::open((entry.path() / "energy_uj").c_str(), O_RDONLY);
+        if (fd < 0)
+          continue;
+        domains_.push_back({fd, range, 0.});
+      }
+#endif
+    }
+
+#ifdef WITH_NVML
+    /**
+     * Open all GPUs visible to NVML.
+     */
+    void open_nvml()
+    {
+      if (nvmlInit_v2() != NVML_SUCCESS)
+        return;
+      nvml_initialized_ = true;
+
+      unsigned int n_devices = 0;
+      if (nvmlDeviceGetCount_v2(&n_devices) != NVML_SUCCESS)
+        return;
+
+      for (unsigned int i = 0; i < n_devices; ++i) {
+        nvmlDevice_t device;
+        unsigned long long value = 0;
+        if (nvmlDeviceGetHandleByIndex_v2(i, &device) != NVML_SUCCESS ||
+            nvmlDeviceGetTotalEnergyConsumption(device, &value) !=
+                NVML_SUCCESS)
+          continue;
+        gpus_.push_back({device, double(value)});
+      }
+    }
+#endif
+
+    /**
+     * Close all counters.
+     */
+    void close()
+    {
+#ifdef __linux__
+      for (const auto &domain : domains_)
+        ::close(domain.fd);
+#endif
+      domains_.clear();
+#ifdef WITH_NVML
+      gpus_.clear();
+      if (nvml_initialized_)
+        nvmlShutdown();
+      nvml_initialized_ = false;
+#endif
+    }
+
+    bool enabled_ = false;
+    double energy_ = 0.;
+
+    /* A RAPL domain: file descriptor, wraparound range and last value: */
+    struct Domain {
+      int fd;
+      double range;
+      double last;
+    };
+    std::vector<Domain> domains_;
+
+#ifdef WITH_NVML
+    struct GPU {
+      nvmlDevice_t device;
+      double last;
+    };
+    std::vector<GPU> gpus_;
+    bool nvml_initialized_ = false;
+#endif
+
+    std::map<std::string, double> sections_;
+
+    static inline EnergyCounters *active_ = nullptr;
+  };
+} // namespace ryujin
@@ -8,15 +8,29 @@
 #include "patterns_conversion.h"
 #include "time_loop.h"
 
+#include <compile_time_options.h>
+
+#ifdef WITH_EQUATION_EULER
 #include "euler/description.h"
+#endif
+#ifdef WITH_EQUATION_EULER_AEOS
 #include "euler_aeos/description.h"
+#endif
+#ifdef WITH_EQUATION_NAVIER_STOKES
 #include "navier_stokes/description.h"
+#endif
+#ifdef WITH_EQUATION_SCALAR_CONSERVATION
 #include "scalar_conservation/description.h"
+#endif
+#ifdef WITH_EQUATION_SHALLOW_WATER
 #include "shallow_water/description.h"
+#endif
 
 #include <deal.II/base/mpi.h>
 
 #include <filesystem>
+#include <string>
+#include <type_traits>
 
 namespace ryujin
 {
@@ -54,6 +68,39 @@ namespace ryujin
      */
     shallow_water,
   };
+
+
+  /**
+   * An enum class that controls in which mode the TimeLoop is run.
+   */
+  enum class RunMode {
+    /**
+     * Run the high-level time loop, see TimeLoop::run().
+     */
+    simulation,
+
+    /**
+     * Run a benchmark (--benchmark), see TimeLoop::run_benchmark().
+     */
+    benchmark,
+
+    /**
+     * Tune runtime parameters (--autotune), see TimeLoop::run_autotune().
+     */
+    autotune,
+
+    /**
+     * Replay time steps on a checkpointed state (--replay), see
+     * TimeLoop::run_replay().
+     */
+    replay,
+
+    /**
+     * Experimental: Run the Parareal algorithm (--parareal), see
+     * TimeLoop::run_parareal().
+     */
+    parareal,
+  };
 } // namespace ryujin
 
 #ifndef DOXYGEN
@@ -83,9 +130,36 @@ namespace ryujin
 
       equation_ = Equation::euler;
       add_parameter("equation", equation_, "The PDE system");
+
+      precision_ = number_name<NUMBER>();
+      add_parameter("precision",
+                    precision_,
+                    "The floating point type used for the computation, "
+                    "either \"double\" or \"float\". Both types are only "
+                    "available if ryujin was configured with "
+                    "RUNTIME_PRECISION");
+
+      parareal_time_slices_ = 1;
+      add_parameter("parareal time slices",
+                    parareal_time_slices_,
+                    "Parareal mode (--parareal): number of time slices. The "
+                    "MPI ranks are split into as many groups of equal size, "
+                    "every group computes one time slice");
+
+      reorder_ranks_ = false;
+      add_parameter("reorder ranks",
+                    reorder_ranks_,
+                    "If set to true, the mesh is created once to determine "
+                    "the neighborhood graph of the partition, and the "
+                    "simulation is then run on a distributed graph "
+                    "communicator that allows the MPI library to reorder "
+                    "ranks such that neighboring subdomains share a node. "
+                    "Not supported in parareal mode");
     }
 
-    void run(const std::string &parameter_file, const MPI_Comm &mpi_comm)
+    void run(const std::string &parameter_file,
+             const MPI_Comm &mpi_comm,
+             const RunMode mode = RunMode::simulation)
     {
       ParameterAcceptor::prm.parse_input(parameter_file,
                                          "",
@@ -98,98 +172,236 @@ namespace ryujin
                              "anymore. Goodbye.\nThe dimension parameter needs "
                              "to be either 1, 2, or 3."));
 
+      AssertThrow(!reorder_ranks_ || mode != RunMode::parareal,
+                  dealii::ExcMessage("Rank reordering is not supported in "
+                                     "parareal mode."));
+
+      if (mode != RunMode::parareal) {
+        run_precision(parameter_file, mpi_comm, MPI_COMM_SELF, mode);
+        return;
+      }
+
+      /*
+       * Split the MPI ranks into groups of consecutive ranks. Every group
+       * (slice communicator) computes one time slice, and ranks with the
+       * same position in their group share a time communicator:
+       */
+
+      const unsigned int n_ranks =
+          dealii::Utilities::MPI::n_mpi_processes(mpi_comm);
+      const unsigned int rank =
+          dealii::Utilities::MPI::this_mpi_process(mpi_comm);
+
+      AssertThrow(parareal_time_slices_ > 0 &&
+                      n_ranks % parareal_time_slices_ == 0,
+                  dealii::ExcMessage("The number of MPI ranks must be a "
+                                     "multiple of the number of parareal "
+                                     "time slices."));
+      const unsigned int group_size = n_ranks / parareal_time_slices_;
+
+      MPI_Comm slice_comm;
+      MPI_Comm time_comm;
+      int ierr = MPI_Comm_split(mpi_comm, rank / group_size, rank, &slice_comm);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_split(mpi_comm, rank % group_size, rank, &time_comm);
+      AssertThrowMPI(ierr);
+
+      run_precision(parameter_file, slice_comm, time_comm, mode);
+
+      ierr = MPI_Comm_free(&time_comm);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_free(&slice_comm);
+      AssertThrowMPI(ierr);
+    }
+
+  private:
+    /**
+     * Run the TimeLoop with the selected floating point type.
+     */
+    void run_precision(const std::string &parameter_file,
+                       const MPI_Comm &mpi_comm,
+                       const MPI_Comm &time_comm,
+                       const RunMode mode)
+    {
+      if (precision_ == number_name<NUMBER>()) {
+        run_time_loops<NUMBER>(parameter_file, mpi_comm, time_comm, mode);
+        return;
+      }
+#ifdef RUNTIME_PRECISION
+      if (precision_ == number_name<SECONDARY_NUMBER>()) {
+        run_time_loops<SECONDARY_NUMBER>(
+            parameter_file, mpi_comm, time_comm, mode);
+        return;
+      }
+#endif
+      AssertThrow(false,
+                  dealii::ExcMessage(
+                      "The selected precision »" + precision_ +
+                      "« has not been compiled into this executable. "
+                      "Reconfigure ryujin with a suitable NUMBER and "
+                      "RUNTIME_PRECISION option."));
+    }
+
+    /**
+     * Return the name of the floating point type @p Number.
+     */
+    template <typename Number>
+    static std::string number_name()
+    {
+      return std::is_same_v<Number, float> ? "float" : "double";
+    }
+
+    /**
+     * Run the TimeLoop for the given description, dimension and floating
+     * point type. If "reorder ranks" is set, a first TimeLoop object is
+     * only used to create the mesh and to derive a graph communicator
+     * with reordered MPI ranks from the partition. The actual run then
+     * uses that communicator for all communication.
+     */
+    template <typename Description, int dim, typename Number>
+    void run_time_loop(const std::string &parameter_file,
+                       const MPI_Comm &mpi_comm,
+                       const MPI_Comm &time_comm,
+                       const RunMode mode)
+    {
+      MPI_Comm reordered_comm = MPI_COMM_NULL;
+      if (reorder_ranks_) {
+        TimeLoop<Description, dim, Number> time_loop(mpi_comm);
+        ParameterAcceptor::initialize(parameter_file);
+        reordered_comm = time_loop.create_reordered_communicator();
+      }
+
+      {
+        const MPI_Comm &comm = reorder_ranks_ ? reordered_comm : mpi_comm;
+        TimeLoop<Description, dim, Number> time_loop(comm);
+        ParameterAcceptor::initialize(parameter_file);
+
+        switch (mode) {
+        case RunMode::simulation:
+          time_loop.run();
+          break;
+        case RunMode::benchmark:
+          time_loop.run_benchmark();
+          break;
+        case RunMode::autotune:
+          time_loop.run_autotune();
+          break;
+        case RunMode::replay:
+          time_loop.run_replay();
+          break;
+        case RunMode::parareal:
+          time_loop.run_parareal(time_comm);
+          break;
+        }
+      }
+
+      if (reordered_comm != MPI_COMM_NULL) {
+        const int ierr = MPI_Comm_free(&reordered_comm);
+        AssertThrowMPI(ierr);
+      }
+    }
+
+    /**
+     * Run the TimeLoop for the selected equation and dimension with
+     * floating point type @p Number.
+     */
+    template <typename Number>
+    void run_time_loops(const std::string &parameter_file,
+                        const MPI_Comm &mpi_comm,
+                        const MPI_Comm &time_comm,
+                        const RunMode mode)
+    {
       switch (equation_) {
+#ifdef WITH_EQUATION_EULER
       case Equation::euler:
         if (dimension_ == 1) {
-          TimeLoop<Euler::Description, 1, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<Euler::Description, 1, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 2) {
-          TimeLoop<Euler::Description, 2, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<Euler::Description, 2, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 3) {
-          TimeLoop<Euler::Description, 3, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<Euler::Description, 3, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else
           __builtin_unreachable();
         break;
+#endif
+#ifdef WITH_EQUATION_EULER_AEOS
       case Equation::euler_aeos:
         if (dimension_ == 1) {
-          TimeLoop<EulerAEOS::Description, 1, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<EulerAEOS::Description, 1, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 2) {
-          TimeLoop<EulerAEOS::Description, 2, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<EulerAEOS::Description, 2, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 3) {
-          TimeLoop<EulerAEOS::Description, 3, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<EulerAEOS::Description, 3, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else
           __builtin_unreachable();
         break;
+#endif
+#ifdef WITH_EQUATION_NAVIER_STOKES
       case Equation::navier_stokes:
         if (dimension_ == 1) {
-          TimeLoop<NavierStokes::Description, 1, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<NavierStokes::Description, 1, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 2) {
-          TimeLoop<NavierStokes::Description, 2, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<NavierStokes::Description, 2, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 3) {
-          TimeLoop<NavierStokes::Description, 3, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<NavierStokes::Description, 3, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else
           __builtin_unreachable();
         break;
+#endif
+#ifdef WITH_EQUATION_SCALAR_CONSERVATION
       case Equation::scalar_conservation:
         if (dimension_ == 1) {
-          TimeLoop<ScalarConservation::Description, 1, NUMBER> time_loop(
-              mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ScalarConservation::Description, 1, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 2) {
-          TimeLoop<ScalarConservation::Description, 2, NUMBER> time_loop(
-              mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ScalarConservation::Description, 2, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 3) {
-          TimeLoop<ScalarConservation::Description, 3, NUMBER> time_loop(
-              mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ScalarConservation::Description, 3, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else
           __builtin_unreachable();
         break;
+#endif
+#ifdef WITH_EQUATION_SHALLOW_WATER
       case Equation::shallow_water:
         if (dimension_ == 1) {
-          TimeLoop<ShallowWater::Description, 1, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ShallowWater::Description, 1, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 2) {
-          TimeLoop<ShallowWater::Description, 2, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ShallowWater::Description, 2, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else if (dimension_ == 3) {
-          TimeLoop<ShallowWater::Description, 3, NUMBER> time_loop(mpi_comm);
-          ParameterAcceptor::initialize(parameter_file);
-          time_loop.run();
+          run_time_loop<ShallowWater::Description, 3, Number>(
+              parameter_file, mpi_comm, time_comm, mode);
         } else
           __builtin_unreachable();
         break;
+#endif
       default:
+        AssertThrow(false,
+                    dealii::ExcMessage(
+                        "The selected equation has not been compiled into "
+                        "this executable. Reconfigure ryujin with a suitable "
+                        "EQUATIONS option."));
         __builtin_trap();
       }
     }
 
-  private:
     int dimension_;
     Equation equation_;
+    std::string precision_;
+    unsigned int parareal_time_slices_;
+    bool reorder_ranks_;
   };
 
 
@@ -241,40 +453,63 @@ namespace ryujin
   void create_parameter_templates(const std::string &parameter_file,
                                   const MPI_Comm &mpi_communicator)
   {
+#ifdef WITH_EQUATION_EULER
     internal::create_prm_files<1, Euler::Description>(
         "euler", mpi_communicator, false);
     internal::create_prm_files<2, Euler::Description>(
         "euler", mpi_communicator, true);
     internal::create_prm_files<3, Euler::Description>(
         "euler", mpi_communicator, false);
-    std::filesystem::copy("default_parameters-euler-2d.prm", parameter_file);
+#endif
 
+#ifdef WITH_EQUATION_EULER_AEOS
     internal::create_prm_files<1, EulerAEOS::Description>(
         "euler aeos", mpi_communicator, false);
     internal::create_prm_files<2, EulerAEOS::Description>(
         "euler aeos", mpi_communicator, true);
     internal::create_prm_files<3, EulerAEOS::Description>(
         "euler aeos", mpi_communicator, false);
+#endif
 
+#ifdef WITH_EQUATION_NAVIER_STOKES
     internal::create_prm_files<1, NavierStokes::Description>(
         "navier stokes", mpi_communicator, false);
     internal::create_prm_files<2, NavierStokes::Description>(
         "navier stokes", mpi_communicator, true);
     internal::create_prm_files<3, NavierStokes::Description>(
         "navier stokes", mpi_communicator, false);
+#endif
 
+#ifdef WITH_EQUATION_SCALAR_CONSERVATION
     internal::create_prm_files<1, ScalarConservation::Description>(
         "scalar conservation", mpi_communicator, false);
     internal::create_prm_files<2, ScalarConservation::Description>(
         "scalar conservation", mpi_communicator, true);
     internal::create_prm_files<3, ScalarConservation::Description>(
         "scalar conservation", mpi_communicator, false);
+#endif
 
+#ifdef WITH_EQUATION_SHALLOW_WATER
     internal::create_prm_files<1, ShallowWater::Description>(
         "shallow water", mpi_communicator, false);
     internal::create_prm_files<2, ShallowWater::Description>(
         "shallow water", mpi_communicator, true);
     internal::create_prm_files<3, ShallowWater::Description>(
         "shallow water", mpi_communicator, false);
+#endif
+
+    /* Use the first available 2D parameter file as template: */
+    for (const auto name : {"euler",
+                            "euler_aeos",
+                            "navier_stokes",
+                            "scalar_conservation",
+                            "shallow_water"}) {
+      const auto file_name =
+          std::string("default_parameters-") + name + "-2d.prm";
+      if (std::filesystem::exists(file_name)) {
+        std::filesystem::copy(file_name, parameter_file);
+        break;
+      }
+    }
   }
 } // namespace ryujin
@@ -18,6 +18,44 @@
 
 #include <array>
 
+namespace ryujin
+{
+  namespace Euler
+  {
+    /**
+     * The estimate of the maximal wave speed computed by the
+     * RiemannSolver. All choices are guaranteed upper bounds.
+     *
+     * @ingroup EulerEquations
+     */
+    enum class WaveSpeedEstimate {
+      /**
+       * Use the minimum of the two-rarefaction and the failsafe
+       * approximation of p_star and refine it with the sign of
+       * phi(p_max), see @cite GuermondPopov2016b. This is the sharpest
+       * estimate.
+       */
+      guermond_popov,
+
+      /**
+       * Only use the failsafe approximation of p_star, see
+       * @cite ClaytonGuermondPopov-2022, (5.11). This avoids both pow()
+       * calls of the two-rarefaction approximation and the evaluation of
+       * phi(p_max) at the expense of a (slightly) larger estimate, and
+       * thus a smaller time-step size.
+       */
+      failsafe,
+    };
+  } // namespace Euler
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::Euler::WaveSpeedEstimate,
+             LIST({ryujin::Euler::WaveSpeedEstimate::guermond_popov,
+                   "guermond popov"},
+                  {ryujin::Euler::WaveSpeedEstimate::failsafe, "failsafe"}, ));
+#endif
+
 namespace ryujin
 {
   namespace Euler
@@ -57,6 +95,8 @@ namespace ryujin
       double vacuum_state_relaxation_small_;
       double vacuum_state_relaxation_large_;
 
+      WaveSpeedEstimate wave_speed_estimate_;
+
       double gamma_inverse_;
       double gamma_minus_one_inverse_;
       double gamma_minus_one_over_gamma_plus_one_;
@@ -134,6 +174,12 @@ namespace ryujin
           return hyperbolic_system_.vacuum_state_relaxation_large_;
         }
 
+        DEAL_II_ALWAYS_INLINE inline WaveSpeedEstimate
+        wave_speed_estimate() const
+        {
+          return hyperbolic_system_.wave_speed_estimate_;
+        }
+
         //@}
         /**
          * @name Access to cached inverses
@@ -287,9 +333,34 @@ namespace ryujin
             std::array<std::string, n_precomputed_initial_values>{};
 
         /**
-         * The number of precomputed values.
+         * The number of precomputed (time-independent) edge values.
          */
+        static constexpr unsigned int n_precomputed_edge_values = 0;
+
+        /**
+         * The number of precomputed values. If the compile-time option
+         * PRECOMPUTE_RIEMANN_DATA is set we additionally store the
+         * pressure and the speed of sound for the approximate Riemann
+         * solver.
+         */
+#ifdef PRECOMPUTE_RIEMANN_DATA
+        static constexpr unsigned int n_precomputed_values = 4;
+#else
         static constexpr unsigned int n_precomputed_values = 2;
+#endif
+
+        /**
+         * Set to true if the approximate Riemann solver computes the
+         * maximal wave speed from precomputed values (pressure and speed
+         * of sound with PRECOMPUTE_RIEMANN_DATA). Such values must not be
+         * exchanged with reduced precision because rounding could
+         * underestimate the wave speed.
+         */
+#ifdef PRECOMPUTE_RIEMANN_DATA
+        static constexpr bool wave_speed_uses_precomputed_values = true;
+#else
+        static constexpr bool wave_speed_uses_precomputed_values = false;
+#endif
 
         /**
          * Array type used for precomputed values.
@@ -305,8 +376,14 @@ namespace ryujin
         /**
          * An array holding all component names of the precomputed values.
          */
+#ifdef PRECOMPUTE_RIEMANN_DATA
+        static inline const auto precomputed_names =
+            std::array<std::string, n_precomputed_values>{
+                "s", "eta_h", "p", "a"};
+#else
         static inline const auto precomputed_names =
             std::array<std::string, n_precomputed_values>{"s", "eta_h"};
+#endif
 
         /**
          * The number of precomputation cycles.
@@ -555,6 +632,13 @@ namespace ryujin
         high_order_flux(const flux_contribution_type &flux_i,
                         const flux_contribution_type &flux_j) const = delete;
 
+        /**
+         * The low-order update is formed with the states U_i and U_j
+         * directly, and the limiter bounds are not shifted (see
+         * ShallowWater::HyperbolicSystem::View::have_equilibrated_states):
+         */
+        static constexpr bool have_equilibrated_states = false;
+
         //@}
         /**
          * @name Computing stencil source terms
@@ -692,6 +776,13 @@ namespace ryujin
                     vacuum_state_relaxation_large_,
                     "Problem specific vacuum relaxation parameter");
 
+      wave_speed_estimate_ = WaveSpeedEstimate::guermond_popov;
+      add_parameter("wave speed estimate",
+                    wave_speed_estimate_,
+                    "The upper bound of the maximal wave speed used in the "
+                    "Riemann solver: \"guermond popov\" (sharpest), or "
+                    "\"failsafe\" (cheaper, but leads to smaller time steps)");
+
       /*
        * Precompute a number of derived gamma coefficients that contain
        * divisions:
@@ -737,8 +828,15 @@ namespace ryujin
         dispatch_check(i);
 
         const auto U_i = U.template get_tensor<Number>(i);
+#ifdef PRECOMPUTE_RIEMANN_DATA
+        const auto p_i = pressure(U_i);
+        const auto a_i = std::sqrt(gamma() * p_i / density(U_i));
+        const precomputed_state_type prec_i{
+            specific_entropy(U_i), harten_entropy(U_i), p_i, a_i};
+#else
         const precomputed_state_type prec_i{specific_entropy(U_i),
                                             harten_entropy(U_i)};
+#endif
         precomputed_values.template write_tensor<Number>(prec_i, i);
       }
     }
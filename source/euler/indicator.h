@@ -190,9 +190,10 @@ namespace ryujin
     {
       /* entropy viscosity commutator: */
 
-      const auto &[new_s_i, new_eta_i] =
+      const auto prec_i =
           precomputed_values
               .template get_tensor<Number, precomputed_state_type>(i);
+      const auto &new_eta_i = prec_i[1];
 
       const auto rho_i = hyperbolic_system.density(U_i);
       rho_i_inverse = Number(1.) / rho_i;
@@ -215,9 +216,10 @@ namespace ryujin
     {
       /* entropy viscosity commutator: */
 
-      const auto &[s_j, eta_j] =
+      const auto prec_j =
           precomputed_values
               .template get_tensor<Number, precomputed_state_type>(js);
+      const auto &eta_j = prec_j[1];
 
       const auto rho_j = hyperbolic_system.density(U_j);
       const auto rho_j_inverse = Number(1.) / rho_j;
@@ -71,6 +71,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         return (point[0] < 1.e-12 && std::abs(point[1]) <= jet_width_
@@ -60,6 +60,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         return (point[0] > 0. ? state_right_ : state_left_);
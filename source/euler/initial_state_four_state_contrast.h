@@ -92,6 +92,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         if constexpr (dim == 1) {
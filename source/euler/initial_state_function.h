@@ -6,6 +6,7 @@
 #pragma once
 
 #include <initial_state_library.h>
+#include <openmp.h>
 
 #include <deal.II/base/function_parser.h>
 
@@ -87,6 +88,18 @@ namespace ryujin
         this->parse_parameters_call_back.connect(set_up_muparser);
       }
 
+      bool time_dependent() const final
+      {
+        if (use_primitive_state_functions_)
+          return expression_depends_on_time(density_expression_) ||
+                 expression_depends_on_time(velocity_expression_) ||
+                 expression_depends_on_time(pressure_expression_);
+        else
+          return expression_depends_on_time(density_expression_) ||
+                 expression_depends_on_time(momentum_expression_) ||
+                 expression_depends_on_time(energy_expression_);
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number t) final
       {
         if (use_primitive_state_functions_) {
@@ -115,6 +128,43 @@ namespace ryujin
         }
       }
 
+      /*
+       * Set the time once and evaluate all points in parallel. This is
+       * safe because dealii::FunctionParser uses a thread-local parser:
+       */
+      void compute_list(const std::vector<dealii::Point<dim>> &points,
+                        Number t,
+                        std::vector<state_type> &states) final
+      {
+        density_function_->set_time(t);
+        velocity_function_->set_time(t);
+        pressure_function_->set_time(t);
+        momentum_function_->set_time(t);
+        energy_function_->set_time(t);
+
+        states.resize(points.size());
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (unsigned int k = 0; k < points.size(); ++k) {
+          const auto &point = points[k];
+          if (use_primitive_state_functions_) {
+            dealii::Tensor<1, 3, Number> primitive;
+            primitive[0] = density_function_->value(point);
+            primitive[1] = velocity_function_->value(point);
+            primitive[2] = pressure_function_->value(point);
+            states[k] = hyperbolic_system_.from_initial_state(primitive);
+          } else {
+            dealii::Tensor<1, 3, Number> state;
+            state[0] = density_function_->value(point);
+            state[1] = momentum_function_->value(point);
+            state[2] = energy_function_->value(point);
+            states[k] = hyperbolic_system_.expand_state(state);
+          }
+        }
+        RYUJIN_PARALLEL_REGION_END
+      }
+
     private:
       const HyperbolicSystemView hyperbolic_system_;
 
@@ -69,6 +69,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       auto compute(const dealii::Point<dim> &point, Number /*t*/)
           -> state_type final
       {
@@ -85,6 +85,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         return point[0] >= left_length_ + middle_length_ ? state_right_
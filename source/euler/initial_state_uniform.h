@@ -48,6 +48,11 @@ namespace ryujin
         convert_states();
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> & /*point*/,
                          Number /*t*/) final
       {
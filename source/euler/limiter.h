@@ -118,6 +118,17 @@ namespace ryujin
        */
       using Bounds = std::array<Number, n_bounds>;
 
+      /**
+       * The rounding direction of every entry of the bounds array that is
+       * used when bounds are stored in single precision (see the
+       * compile-time option MIXED_PRECISION_BOUNDS): lower bounds are
+       * rounded toward negative infinity (-1), upper bounds toward
+       * positive infinity (+1). This ensures that the stored bounds never
+       * exclude a state that is admissible with respect to the original
+       * bounds.
+       */
+      static constexpr std::array<int, n_bounds> bounds_rounding{{-1, 1, -1}};
+
       /**
        * Constructor taking a HyperbolicSystem instance as argument
        */
@@ -271,9 +282,10 @@ namespace ryujin
       rho_min = std::min(rho_min, rho_ij_bar);
       rho_max = std::max(rho_max, rho_ij_bar);
 
-      const auto &[s_j, eta_j] =
+      const auto prec_j =
           precomputed_values
               .template get_tensor<Number, precomputed_state_type>(js);
+      const auto &s_j = prec_j[0];
       s_min = std::min(s_min, s_j);
 
       /* Relaxation: */
@@ -65,6 +65,12 @@ namespace ryujin
       static constexpr unsigned int n_precomputed_values =
           HyperbolicSystemView::n_precomputed_values;
 
+      /**
+       * @copydoc HyperbolicSystem::View::precomputed_state_type
+       */
+      using precomputed_state_type =
+          typename HyperbolicSystemView::precomputed_state_type;
+
       /**
        * @copydoc HyperbolicSystem::View::ScalarNumber
        */
@@ -258,12 +264,38 @@ namespace ryujin
     DEAL_II_ALWAYS_INLINE inline Number RiemannSolver<dim, Number>::compute(
         const state_type &U_i,
         const state_type &U_j,
-        const unsigned int /*i*/,
-        const unsigned int * /*js*/,
+        const unsigned int i,
+        const unsigned int *js,
         const dealii::Tensor<1, dim, Number> &n_ij) const
     {
+#ifdef PRECOMPUTE_RIEMANN_DATA
+      /*
+       * Pressure and speed of sound are invariant under the projection
+       * onto n_ij (the kinetic energy of the perpendicular momentum is
+       * subtracted from the total energy), so we can simply use the
+       * values stored in the precomputation cycle:
+       */
+
+      const auto prec_i =
+          precomputed_values
+              .template get_tensor<Number, precomputed_state_type>(i);
+      const auto prec_j =
+          precomputed_values
+              .template get_tensor<Number, precomputed_state_type>(js);
+
+      const auto rho_i = hyperbolic_system.density(U_i);
+      const auto rho_j = hyperbolic_system.density(U_j);
+      const auto u_i = n_ij * hyperbolic_system.momentum(U_i) / rho_i;
+      const auto u_j = n_ij * hyperbolic_system.momentum(U_j) / rho_j;
+
+      const primitive_type riemann_data_i{{rho_i, u_i, prec_i[2], prec_i[3]}};
+      const primitive_type riemann_data_j{{rho_j, u_j, prec_j[2], prec_j[3]}};
+#else
+      (void)i;
+      (void)js;
       const auto riemann_data_i = riemann_data_from_state(U_i, n_ij);
       const auto riemann_data_j = riemann_data_from_state(U_j, n_ij);
+#endif
 
       return compute(riemann_data_i, riemann_data_j);
     }
@@ -338,6 +338,12 @@ namespace ryujin
       const auto &[rho_i, u_i, p_i, a_i] = riemann_data_i;
       const auto &[rho_j, u_j, p_j, a_j] = riemann_data_j;
 
+      if (hyperbolic_system.wave_speed_estimate() ==
+          WaveSpeedEstimate::failsafe) {
+        const Number p_2 = p_star_failsafe(riemann_data_i, riemann_data_j);
+        return compute_lambda(riemann_data_i, riemann_data_j, p_2);
+      }
+
 #ifdef DEBUG_RIEMANN_SOLVER
       std::cout << "rho_left: " << rho_i << std::endl;
       std::cout << "u_left: " << u_i << std::endl;
@@ -132,6 +132,36 @@ namespace ryujin
         return std::sqrt(first_term + second_term + third_term);
       }
 
+      /**
+       * Batched variant of the pressure() function above evaluating the
+       * formula directly without a virtual function call per entry.
+       */
+      void pressure(const dealii::ArrayView<double> &p,
+                    const dealii::ArrayView<double> &rho,
+                    const dealii::ArrayView<double> &e) const final
+      {
+        Assert(p.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < p.size(); ++k)
+          p[k] = JonesWilkinsLee::pressure(rho[k], e[k]);
+      }
+
+      /**
+       * Batched variant of the speed_of_sound() function above evaluating
+       * the formula directly without a virtual function call per entry.
+       */
+      void speed_of_sound(const dealii::ArrayView<double> &c,
+                          const dealii::ArrayView<double> &rho,
+                          const dealii::ArrayView<double> &e) const final
+      {
+        Assert(c.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < c.size(); ++k)
+          c[k] = JonesWilkinsLee::speed_of_sound(rho[k], e[k]);
+      }
+
     private:
       double capA;
       double capB;
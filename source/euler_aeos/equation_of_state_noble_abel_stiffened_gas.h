@@ -7,6 +7,8 @@
 
 #include "equation_of_state.h"
 
+#include <simd.h>
+
 namespace ryujin
 {
   namespace EquationOfStateLibrary
@@ -63,8 +65,7 @@ namespace ryujin
        */
       double pressure(double rho, double e) const final
       {
-        return (gamma_ - 1.) * rho * (e - q_) / (1. - b_ * rho) -
-               gamma_ * pinf_;
+        return pressure_inline(rho, e);
       }
 
 
@@ -76,9 +77,7 @@ namespace ryujin
        */
       double specific_internal_energy(double rho, double p) const final
       {
-        const auto numerator = (p + gamma_ * pinf_) * (1. - b_ * rho);
-        const auto denominator = rho * (gamma_ - 1.);
-        return q_ + numerator / denominator;
+        return specific_internal_energy_inline(rho, p);
       }
 
       /**
@@ -89,7 +88,7 @@ namespace ryujin
        */
       double temperature(double rho, double e) const final
       {
-        return (e - q_ - pinf_ * (1. / rho - b_)) / cv_;
+        return temperature_inline(rho, e);
       }
 
       /**
@@ -101,12 +100,92 @@ namespace ryujin
        */
       double speed_of_sound(double rho, double e) const final
       {
-        const auto covolume = 1. - b_ * rho;
-        auto numerator = (rho * (e - q_) - pinf_ * covolume) / rho;
-        numerator *= gamma_ * (gamma_ - 1.);
+        return speed_of_sound_inline(rho, e);
+      }
+
+      /**
+       * Batched variant of the pressure() function above evaluating the
+       * formula directly without a virtual function call per entry.
+       */
+      void pressure(const dealii::ArrayView<double> &p,
+                    const dealii::ArrayView<double> &rho,
+                    const dealii::ArrayView<double> &e) const final
+      {
+        Assert(p.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < p.size(); ++k)
+          p[k] = NobleAbelStiffenedGas::pressure(rho[k], e[k]);
+      }
+
+      /**
+       * Batched variant of the speed_of_sound() function above evaluating
+       * the formula directly without a virtual function call per entry.
+       */
+      void speed_of_sound(const dealii::ArrayView<double> &c,
+                          const dealii::ArrayView<double> &rho,
+                          const dealii::ArrayView<double> &e) const final
+      {
+        Assert(c.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < c.size(); ++k)
+          c[k] = NobleAbelStiffenedGas::speed_of_sound(rho[k], e[k]);
+      }
+
+      /**
+       * @name Non-virtual, vectorized variants of above functions used
+       * by the compile-time fast path of the HyperbolicSystem::View.
+       */
+      //@{
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      pressure_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        return ScalarNumber(gamma_ - 1.) * rho * (e - ScalarNumber(q_)) /
+                   covolume -
+               Number(gamma_ * pinf_);
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      specific_internal_energy_inline(const Number &rho, const Number &p) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        const auto numerator = (p + ScalarNumber(gamma_ * pinf_)) * covolume;
+        const auto denominator = rho * ScalarNumber(gamma_ - 1.);
+        return ScalarNumber(q_) + numerator / denominator;
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      temperature_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto specific_volume = Number(1.) / rho - ScalarNumber(b_);
+        return (e - ScalarNumber(q_) - ScalarNumber(pinf_) * specific_volume) /
+               ScalarNumber(cv_);
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      speed_of_sound_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        auto numerator =
+            (rho * (e - ScalarNumber(q_)) - ScalarNumber(pinf_) * covolume) /
+            rho;
+        numerator *= ScalarNumber(gamma_ * (gamma_ - 1.));
         return std::sqrt(numerator) / covolume;
       }
 
+      //@}
+
     private:
       double gamma_;
       double R_;
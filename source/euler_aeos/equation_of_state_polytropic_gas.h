@@ -7,6 +7,8 @@
 
 #include "equation_of_state.h"
 
+#include <simd.h>
+
 namespace ryujin
 {
   namespace EquationOfStateLibrary
@@ -45,7 +47,7 @@ namespace ryujin
        */
       double pressure(double rho, double e) const final
       {
-        return (gamma_ - 1.) * rho * e;
+        return pressure_inline(rho, e);
       }
 
       /**
@@ -56,7 +58,7 @@ namespace ryujin
        */
       double specific_internal_energy(double rho, double p) const final
       {
-        return p / (rho * (gamma_ - 1.));
+        return specific_internal_energy_inline(rho, p);
       }
 
       /**
@@ -65,9 +67,9 @@ namespace ryujin
        *   T = e / c_v
        * \f}
        */
-      double temperature(double /*rho*/, double e) const final
+      double temperature(double rho, double e) const final
       {
-        return e / cv_;
+        return temperature_inline(rho, e);
       }
 
       /**
@@ -76,11 +78,81 @@ namespace ryujin
        *   c^2 = \gamma * (\gamma - 1) e
        * \f}
        */
-      double speed_of_sound(double /*rho*/, double e) const final
+      double speed_of_sound(double rho, double e) const final
+      {
+        return speed_of_sound_inline(rho, e);
+      }
+
+      /**
+       * Batched variant of the pressure() function above evaluating the
+       * formula directly without a virtual function call per entry.
+       */
+      void pressure(const dealii::ArrayView<double> &p,
+                    const dealii::ArrayView<double> &rho,
+                    const dealii::ArrayView<double> &e) const final
       {
-        return std::sqrt(gamma_ * (gamma_ - 1.) * e);
+        Assert(p.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < p.size(); ++k)
+          p[k] = PolytropicGas::pressure(rho[k], e[k]);
       }
 
+      /**
+       * Batched variant of the speed_of_sound() function above evaluating
+       * the formula directly without a virtual function call per entry.
+       */
+      void speed_of_sound(const dealii::ArrayView<double> &c,
+                          const dealii::ArrayView<double> &rho,
+                          const dealii::ArrayView<double> &e) const final
+      {
+        Assert(c.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < c.size(); ++k)
+          c[k] = PolytropicGas::speed_of_sound(rho[k], e[k]);
+      }
+
+      /**
+       * @name Non-virtual, vectorized variants of above functions used
+       * by the compile-time fast path of the HyperbolicSystem::View.
+       */
+      //@{
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      pressure_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        return ScalarNumber(gamma_ - 1.) * rho * e;
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      specific_internal_energy_inline(const Number &rho, const Number &p) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        return p / (rho * ScalarNumber(gamma_ - 1.));
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      temperature_inline(const Number & /*rho*/, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        return e / ScalarNumber(cv_);
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      speed_of_sound_inline(const Number & /*rho*/, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        return std::sqrt(ScalarNumber(gamma_ * (gamma_ - 1.)) * e);
+      }
+
+      //@}
+
     private:
       double gamma_;
       double R_;
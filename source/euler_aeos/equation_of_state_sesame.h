@@ -12,8 +12,14 @@
 #include <deal.II/base/array_view.h>
 #include <deal.II/base/config.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
 #include <deal.II/base/parameter_acceptor.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 #ifdef WITH_EOSPAC
 #include "eos_Interface.h"
 #endif
@@ -193,6 +199,98 @@ namespace ryujin
         }
       }
     };
+
+
+    /**
+     * A read-only table of doubles that is stored only once per node in
+     * an MPI-3 shared memory window. The table is filled by the first
+     * rank of every node and mapped by all other ranks of the node.
+     */
+    class SharedTable
+    {
+    public:
+      SharedTable() = default;
+
+      SharedTable(const SharedTable &) = delete;
+      SharedTable &operator=(const SharedTable &) = delete;
+
+      ~SharedTable()
+      {
+        clear();
+      }
+
+      /**
+       * Allocate a table with @p size entries and fill it on the first
+       * rank of every node by calling @p fill with a pointer to the
+       * storage. The function returns a pointer to the (node-local)
+       * table. This is a collective operation on @p mpi_communicator.
+       */
+      template <typename Callable>
+      const double *reinit(const MPI_Comm &mpi_communicator,
+                           const std::size_t size,
+                           const Callable &fill)
+      {
+        clear();
+
+        int ierr = MPI_Comm_split_type(mpi_communicator,
+                                       MPI_COMM_TYPE_SHARED,
+                                       0,
+                                       MPI_INFO_NULL,
+                                       &node_communicator_);
+        AssertThrowMPI(ierr);
+
+        int node_rank;
+        ierr = MPI_Comm_rank(node_communicator_, &node_rank);
+        AssertThrowMPI(ierr);
+
+        double *data = nullptr;
+        const MPI_Aint bytes = node_rank == 0 ? size * sizeof(double) : 0;
+        ierr = MPI_Win_allocate_shared(bytes,
+                                       sizeof(double),
+                                       MPI_INFO_NULL,
+                                       node_communicator_,
+                                       &data,
+                                       &window_);
+        AssertThrowMPI(ierr);
+
+        if (node_rank != 0) {
+          MPI_Aint remote_bytes;
+          int displacement_unit;
+          ierr = MPI_Win_shared_query(
+              window_, 0, &remote_bytes, &displacement_unit, &data);
+          AssertThrowMPI(ierr);
+        }
+
+        ierr = MPI_Win_fence(0, window_);
+        AssertThrowMPI(ierr);
+        if (node_rank == 0)
+          fill(data);
+        ierr = MPI_Win_fence(0, window_);
+        AssertThrowMPI(ierr);
+
+        return data;
+      }
+
+      /**
+       * Free the window and the node communicator. This is a collective
+       * operation on the node communicator.
+       */
+      void clear()
+      {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized && window_ != MPI_WIN_NULL)
+          MPI_Win_free(&window_);
+        if (!finalized && node_communicator_ != MPI_COMM_NULL)
+          MPI_Comm_free(&node_communicator_);
+        window_ = MPI_WIN_NULL;
+        node_communicator_ = MPI_COMM_NULL;
+      }
+
+    private:
+      MPI_Comm node_communicator_ = MPI_COMM_NULL;
+      MPI_Win window_ = MPI_WIN_NULL;
+    };
   } // namespace eospac
 #endif
 
@@ -222,6 +320,40 @@ namespace ryujin
 
         this->prefer_vector_interface_ = true;
 
+        tabulate_pressure_ = false;
+        this->add_parameter(
+            "tabulate pressure",
+            tabulate_pressure_,
+            "Resample the pressure p(rho, e) once at startup on a uniform "
+            "grid in (log rho, log e) and evaluate it with bilinear "
+            "interpolation. Queries outside of the table range are passed "
+            "on to eospac");
+
+        table_rho_range_ = {1.0e-3, 1.0e5};
+        this->add_parameter("table density range",
+                            table_rho_range_,
+                            "Table: density range [rho_min, rho_max]");
+
+        table_e_range_ = {1.0e3, 1.0e9};
+        this->add_parameter(
+            "table specific internal energy range",
+            table_e_range_,
+            "Table: specific internal energy range [e_min, e_max]");
+
+        table_size_ = {512, 512};
+        this->add_parameter(
+            "table size",
+            table_size_,
+            "Table: number of sampling points in rho and e direction");
+
+        share_table_ = false;
+        this->add_parameter(
+            "share table",
+            share_table_,
+            "Table: compute the pressure table only on one rank per node "
+            "and share it with all other ranks of the node through an "
+            "MPI-3 shared memory window");
+
         const auto set_up_database = [&]() {
           const std::vector<std::tuple<EOS_INTEGER, eospac::TableType>> tables{
               {material_id_, eospac::TableType::p_rho_e},
@@ -229,6 +361,14 @@ namespace ryujin
           };
 
           eospac_interface_ = std::make_unique<eospac::Interface>(tables);
+
+          if (tabulate_pressure_) {
+            set_up_pressure_table();
+          } else {
+            pressure_table_ = nullptr;
+            local_pressure_table_.clear();
+            shared_pressure_table_.clear();
+          }
         };
 
         this->parse_parameters_call_back.connect(set_up_database);
@@ -237,21 +377,11 @@ namespace ryujin
 
       double pressure(double rho, double e) const final
       {
-        EOS_INTEGER index = 0;
+        double p;
+        if (pressure_table_ != nullptr && table_lookup(p, rho, e))
+          return p;
 
-        double p, p_drho, p_de;
-        const double rho_scaled = rho / 1.0e3; // convert from Kg/m^3 to Mg/m^3
-        const double e_scaled = e / 1.0e6;     // convert from J/kg to MJ/kg
-
-        eospac_interface_->interpolate_values(
-            index,
-            dealii::ArrayView<double>(&p, 1),
-            dealii::ArrayView<double>(&p_drho, 1),
-            dealii::ArrayView<double>(&p_de, 1),
-            dealii::ArrayView<const double>(&rho_scaled, 1),
-            dealii::ArrayView<const double>(&e_scaled, 1));
-
-        return 1.0e9 * p; // convert from GPa to Pa
+        return pressure_eospac(rho, e);
       }
 
 
@@ -262,38 +392,44 @@ namespace ryujin
         Assert(p.size() == rho.size() && rho.size() == e.size(),
                dealii::ExcMessage("vectors have different size"));
 
-        EOS_INTEGER index = 0;
-
-        /* FIXME: this is not reentrant... */
-        thread_local static std::vector<double> p_drho;
-        thread_local static std::vector<double> p_de;
-        p_drho.resize(p.size());
-        p_de.resize(p.size());
+        if (pressure_table_ == nullptr) {
+          pressure_eospac(p, rho, e);
+          return;
+        }
 
-        // convert from Kg/m^3 to Mg/m^3
-        std::transform(std::begin(rho),
-                       std::end(rho),
-                       std::begin(rho),
-                       [](double rho) { return rho / 1.0e3; });
+        /*
+         * Evaluate the table and collect all queries outside of the table
+         * range for a single eospac call:
+         */
 
-        // convert from J/kg to MJ/kg
-        std::transform(std::begin(e), //
-                       std::end(e),
-                       std::begin(e),
-                       [](auto e) { return e / 1.0e6; });
+        /* FIXME: this is not reentrant... */
+        thread_local static std::vector<unsigned int> misses;
+        thread_local static std::vector<double> p_misses;
+        thread_local static std::vector<double> rho_misses;
+        thread_local static std::vector<double> e_misses;
+        misses.clear();
+
+        for (unsigned int k = 0; k < p.size(); ++k)
+          if (!table_lookup(p[k], rho[k], e[k]))
+            misses.push_back(k);
+
+        if (misses.empty())
+          return;
+
+        p_misses.resize(misses.size());
+        rho_misses.resize(misses.size());
+        e_misses.resize(misses.size());
+        for (unsigned int n = 0; n < misses.size(); ++n) {
+          rho_misses[n] = rho[misses[n]];
+          e_misses[n] = e[misses[n]];
+        }
 
-        eospac_interface_->interpolate_values(index,
-                                              p,
-                                              dealii::ArrayView<double>(p_drho),
-                                              dealii::ArrayView<double>(p_de),
-                                              rho,
-                                              e);
+        pressure_eospac(dealii::ArrayView<double>(p_misses),
+                        dealii::ArrayView<double>(rho_misses),
+                        dealii::ArrayView<double>(e_misses));
 
-        // convert from GPa to Pa
-        std::transform(std::begin(p), //
-                       std::end(p),
-                       std::begin(p),
-                       [](auto it) { return it * 1.0e9; });
+        for (unsigned int n = 0; n < misses.size(); ++n)
+          p[misses[n]] = p_misses[n];
       }
 
 
@@ -390,6 +526,171 @@ namespace ryujin
       EOS_INTEGER material_id_;
       std::unique_ptr<eospac::Interface> eospac_interface_;
 
+      bool tabulate_pressure_;
+      std::array<double, 2> table_rho_range_;
+      std::array<double, 2> table_e_range_;
+      std::array<unsigned int, 2> table_size_;
+      bool share_table_;
+
+      /*
+       * The pressure table (in Pa) stored row-wise, i.e., the value for
+       * the sampling point (rho_i, e_j) is stored at index i * n_e + j.
+       * The table either lives in local_pressure_table_ or in the node
+       * shared memory window shared_pressure_table_.
+       */
+      const double *pressure_table_ = nullptr;
+      std::vector<double> local_pressure_table_;
+      eospac::SharedTable shared_pressure_table_;
+      double log_rho_min_;
+      double log_e_min_;
+      double inverse_delta_log_rho_;
+      double inverse_delta_log_e_;
+
+      /**
+       * Resample the pressure p(rho, e) on a uniform grid in (log rho, log
+       * e) with a single (vectorized) eospac call.
+       */
+      void set_up_pressure_table()
+      {
+        const auto [n_rho, n_e] = table_size_;
+        AssertThrow(n_rho >= 2 && n_e >= 2,
+                    dealii::ExcMessage("The table needs at least two "
+                                       "sampling points in each direction"));
+        AssertThrow(0. < table_rho_range_[0] &&
+                        table_rho_range_[0] < table_rho_range_[1] &&
+                        0. < table_e_range_[0] &&
+                        table_e_range_[0] < table_e_range_[1],
+                    dealii::ExcMessage("Invalid table range"));
+
+        log_rho_min_ = std::log(table_rho_range_[0]);
+        log_e_min_ = std::log(table_e_range_[0]);
+        const double delta_log_rho =
+            (std::log(table_rho_range_[1]) - log_rho_min_) / (n_rho - 1);
+        const double delta_log_e =
+            (std::log(table_e_range_[1]) - log_e_min_) / (n_e - 1);
+        inverse_delta_log_rho_ = 1. / delta_log_rho;
+        inverse_delta_log_e_ = 1. / delta_log_e;
+
+        const auto fill = [&](double *table) {
+          std::vector<double> rho(n_rho * n_e);
+          std::vector<double> e(n_rho * n_e);
+          for (unsigned int i = 0; i < n_rho; ++i)
+            for (unsigned int j = 0; j < n_e; ++j) {
+              rho[i * n_e + j] = std::exp(log_rho_min_ + i * delta_log_rho);
+              e[i * n_e + j] = std::exp(log_e_min_ + j * delta_log_e);
+            }
+
+          pressure_eospac(dealii::ArrayView<double>(table, n_rho * n_e),
+                          dealii::ArrayView<double>(rho),
+                          dealii::ArrayView<double>(e));
+        };
+
+        if (share_table_) {
+          local_pressure_table_.clear();
+          pressure_table_ = shared_pressure_table_.reinit(
+              MPI_COMM_WORLD, std::size_t(n_rho) * n_e, fill);
+        } else {
+          shared_pressure_table_.clear();
+          local_pressure_table_.resize(n_rho * n_e);
+          fill(local_pressure_table_.data());
+          pressure_table_ = local_pressure_table_.data();
+        }
+      }
+
+      /**
+       * Bilinear interpolation of the pressure table in (log rho, log e).
+       * Returns false (and leaves @p p untouched) if the query point lies
+       * outside of the table range.
+       */
+      inline DEAL_II_ALWAYS_INLINE bool
+      table_lookup(double &p, const double rho, const double e) const
+      {
+        const auto [n_rho, n_e] = table_size_;
+
+        const double x =
+            (std::log(rho) - log_rho_min_) * inverse_delta_log_rho_;
+        const double y =
+            (std::log(e) - log_e_min_) * inverse_delta_log_e_;
+
+        /* Written such that NaN values fail the test: */
+        if (!(x >= 0. && x <= double(n_rho - 1) && y >= 0. &&
+              y <= double(n_e - 1)))
+          return false;
+
+        const unsigned int i =
+            std::min(static_cast<unsigned int>(x), n_rho - 2);
+        const unsigned int j =
+            std::min(static_cast<unsigned int>(y), n_e - 2);
+        const double w_x = x - i;
+        const double w_y = y - j;
+
+        const double *row = pressure_table_ + i * n_e + j;
+        p = (1. - w_x) * ((1. - w_y) * row[0] + w_y * row[1]) +
+            w_x * ((1. - w_y) * row[n_e] + w_y * row[n_e + 1]);
+        return true;
+      }
+
+      double pressure_eospac(double rho, double e) const
+      {
+        EOS_INTEGER index = 0;
+
+        double p, p_drho, p_de;
+        const double rho_scaled = rho / 1.0e3; // convert from Kg/m^3 to Mg/m^3
+        const double e_scaled = e / 1.0e6;     // convert from J/kg to MJ/kg
+
+        eospac_interface_->interpolate_values(
+            index,
+            dealii::ArrayView<double>(&p, 1),
+            dealii::ArrayView<double>(&p_drho, 1),
+            dealii::ArrayView<double>(&p_de, 1),
+            dealii::ArrayView<const double>(&rho_scaled, 1),
+            dealii::ArrayView<const double>(&e_scaled, 1));
+
+        return 1.0e9 * p; // convert from GPa to Pa
+      }
+
+
+      void pressure_eospac(const dealii::ArrayView<double> &p,
+                           const dealii::ArrayView<double> &rho,
+                           const dealii::ArrayView<double> &e) const
+      {
+        Assert(p.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        EOS_INTEGER index = 0;
+
+        /* FIXME: this is not reentrant... */
+        thread_local static std::vector<double> p_drho;
+        thread_local static std::vector<double> p_de;
+        p_drho.resize(p.size());
+        p_de.resize(p.size());
+
+        // convert from Kg/m^3 to Mg/m^3
+        std::transform(std::begin(rho),
+                       std::end(rho),
+                       std::begin(rho),
+                       [](double rho) { return rho / 1.0e3; });
+
+        // convert from J/kg to MJ/kg
+        std::transform(std::begin(e), //
+                       std::end(e),
+                       std::begin(e),
+                       [](auto e) { return e / 1.0e6; });
+
+        eospac_interface_->interpolate_values(index,
+                                              p,
+                                              dealii::ArrayView<double>(p_drho),
+                                              dealii::ArrayView<double>(p_de),
+                                              rho,
+                                              e);
+
+        // convert from GPa to Pa
+        std::transform(std::begin(p), //
+                       std::end(p),
+                       std::begin(p),
+                       [](auto it) { return it * 1.0e9; });
+      }
+
 #else /* WITHOUT_EOSPAC */
 
       /* We do not have eospac support */
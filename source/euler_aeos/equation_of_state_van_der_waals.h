@@ -7,6 +7,8 @@
 
 #include "equation_of_state.h"
 
+#include <simd.h>
+
 namespace ryujin
 {
   namespace EquationOfStateLibrary
@@ -56,10 +58,7 @@ namespace ryujin
        */
       double pressure(double rho, double e) const final
       {
-        const auto intermolecular = a_ * rho * rho;
-        const auto numerator = rho * e + intermolecular;
-        const auto covolume = 1. - b_ * rho;
-        return (gamma_ - 1.) * numerator / covolume - intermolecular;
+        return pressure_inline(rho, e);
       }
 
       /**
@@ -71,11 +70,7 @@ namespace ryujin
        */
       double specific_internal_energy(double rho, double p) const final
       {
-        const auto intermolecular = a_ * rho * rho;
-        const auto covolume = 1. - b_ * rho;
-        const auto numerator = (p + intermolecular) * covolume;
-        const auto denominator = rho * (gamma_ - 1.);
-        return numerator / denominator - a_ * rho;
+        return specific_internal_energy_inline(rho, p);
       }
 
       /**
@@ -86,7 +81,7 @@ namespace ryujin
        */
       double temperature(double rho, double e) const final
       {
-        return (e + a_ * rho) / cv_;
+        return temperature_inline(rho, e);
       }
 
       /**
@@ -98,11 +93,91 @@ namespace ryujin
        */
       double speed_of_sound(double rho, double e) const final
       {
-        const auto covolume = 1. - b_ * rho;
-        const auto numerator = gamma_ * (gamma_ - 1.) * (e + a_ * rho);
-        return std::sqrt(numerator / (covolume * covolume) - 2. * a_ * rho);
+        return speed_of_sound_inline(rho, e);
+      }
+
+      /**
+       * Batched variant of the pressure() function above evaluating the
+       * formula directly without a virtual function call per entry.
+       */
+      void pressure(const dealii::ArrayView<double> &p,
+                    const dealii::ArrayView<double> &rho,
+                    const dealii::ArrayView<double> &e) const final
+      {
+        Assert(p.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < p.size(); ++k)
+          p[k] = VanDerWaals::pressure(rho[k], e[k]);
       }
 
+      /**
+       * Batched variant of the speed_of_sound() function above evaluating
+       * the formula directly without a virtual function call per entry.
+       */
+      void speed_of_sound(const dealii::ArrayView<double> &c,
+                          const dealii::ArrayView<double> &rho,
+                          const dealii::ArrayView<double> &e) const final
+      {
+        Assert(c.size() == rho.size() && rho.size() == e.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < c.size(); ++k)
+          c[k] = VanDerWaals::speed_of_sound(rho[k], e[k]);
+      }
+
+      /**
+       * @name Non-virtual, vectorized variants of above functions used
+       * by the compile-time fast path of the HyperbolicSystem::View.
+       */
+      //@{
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      pressure_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto intermolecular = ScalarNumber(a_) * rho * rho;
+        const auto numerator = rho * e + intermolecular;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        return ScalarNumber(gamma_ - 1.) * numerator / covolume -
+               intermolecular;
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      specific_internal_energy_inline(const Number &rho, const Number &p) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto intermolecular = ScalarNumber(a_) * rho * rho;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        const auto numerator = (p + intermolecular) * covolume;
+        const auto denominator = rho * ScalarNumber(gamma_ - 1.);
+        return numerator / denominator - ScalarNumber(a_) * rho;
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      temperature_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        return (e + ScalarNumber(a_) * rho) / ScalarNumber(cv_);
+      }
+
+      template <typename Number>
+      DEAL_II_ALWAYS_INLINE inline Number
+      speed_of_sound_inline(const Number &rho, const Number &e) const
+      {
+        using ScalarNumber = typename get_value_type<Number>::type;
+        const auto covolume = Number(1.) - ScalarNumber(b_) * rho;
+        const auto numerator =
+            ScalarNumber(gamma_ * (gamma_ - 1.)) * (e + ScalarNumber(a_) * rho);
+        return std::sqrt(numerator / (covolume * covolume) -
+                         ScalarNumber(2. * a_) * rho);
+      }
+
+      //@}
+
     private:
       double gamma_;
       double b_;
@@ -6,6 +6,9 @@
 #pragma once
 
 #include "equation_of_state_library.h"
+#include "equation_of_state_noble_abel_stiffened_gas.h"
+#include "equation_of_state_polytropic_gas.h"
+#include "equation_of_state_van_der_waals.h"
 
 #include <compile_time_options.h>
 #include <convenience_macros.h>
@@ -15,6 +18,7 @@
 #include <patterns_conversion.h>
 #include <simd.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/tensor.h>
 
@@ -66,6 +70,19 @@ namespace ryujin
       using EquationOfState = EquationOfStateLibrary::EquationOfState;
       std::shared_ptr<EquationOfState> selected_equation_of_state_;
 
+      /*
+       * The built-in analytic equations of state for which the View
+       * bypasses the virtual interface and evaluates inlined (and
+       * vectorized) formulas directly.
+       */
+      enum class EquationOfStateFastPath {
+        none,
+        polytropic_gas,
+        noble_abel_stiffened_gas,
+        van_der_waals,
+      };
+      EquationOfStateFastPath equation_of_state_fast_path_;
+
     public:
       /**
        * A view of the HyperbolicSystem that makes methods available for a
@@ -149,6 +166,39 @@ namespace ryujin
          */
         //@{
 
+        /**
+         * If the selected equation of state is one of the built-in
+         * analytic equations of state call the function object @p f with
+         * a reference to the concrete (derived) class, store the result
+         * in @p result and return true. Otherwise, return false.
+         *
+         * For all other equations of state we have to go through the
+         * virtual function interface.
+         */
+        template <typename F>
+        DEAL_II_ALWAYS_INLINE inline bool eos_fast_path(Number &result,
+                                                        const F &f) const
+        {
+          using namespace EquationOfStateLibrary;
+          using FastPath = HyperbolicSystem::EquationOfStateFastPath;
+          const auto &eos = *hyperbolic_system_.selected_equation_of_state_;
+
+          switch (hyperbolic_system_.equation_of_state_fast_path_) {
+          case FastPath::polytropic_gas:
+            result = f(static_cast<const PolytropicGas &>(eos));
+            return true;
+          case FastPath::noble_abel_stiffened_gas:
+            result = f(static_cast<const NobleAbelStiffenedGas &>(eos));
+            return true;
+          case FastPath::van_der_waals:
+            result = f(static_cast<const VanDerWaals &>(eos));
+            return true;
+          case FastPath::none:
+            break;
+          }
+          return false;
+        }
+
         /**
          * For a given density \f$\rho\f$ and <i>specific</i> internal
          * energy \f$e\f$ return the pressure \f$p\f$.
@@ -156,14 +206,36 @@ namespace ryujin
         DEAL_II_ALWAYS_INLINE inline Number eos_pressure(const Number &rho,
                                                          const Number &e) const
         {
+          {
+            Number result;
+            if (eos_fast_path(result, [&](const auto &concrete_eos) {
+                  return concrete_eos.pressure_inline(rho, e);
+                }))
+              return result;
+          }
+
           const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
           if constexpr (std::is_same_v<ScalarNumber, Number>) {
             return ScalarNumber(eos->pressure(rho, e));
           } else {
+            /*
+             * Use the batched interface so that we pay for the virtual
+             * dispatch only once per SIMD batch:
+             */
+            std::array<double, Number::size()> p_batch, rho_batch, e_batch;
+            for (unsigned int k = 0; k < Number::size(); ++k) {
+              rho_batch[k] = rho[k];
+              e_batch[k] = e[k];
+            }
+            constexpr auto n = Number::size();
+            eos->pressure(dealii::ArrayView<double>(p_batch.data(), n),
+                          dealii::ArrayView<double>(rho_batch.data(), n),
+                          dealii::ArrayView<double>(e_batch.data(), n));
+
             Number p;
             for (unsigned int k = 0; k < Number::size(); ++k) {
-              p[k] = ScalarNumber(eos->pressure(rho[k], e[k]));
+              p[k] = ScalarNumber(p_batch[k]);
             }
             return p;
           }
@@ -176,6 +248,14 @@ namespace ryujin
         DEAL_II_ALWAYS_INLINE inline Number
         eos_specific_internal_energy(const Number &rho, const Number &p) const
         {
+          {
+            Number result;
+            if (eos_fast_path(result, [&](const auto &concrete_eos) {
+                  return concrete_eos.specific_internal_energy_inline(rho, p);
+                }))
+              return result;
+          }
+
           const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
           if constexpr (std::is_same_v<ScalarNumber, Number>) {
@@ -196,6 +276,14 @@ namespace ryujin
         DEAL_II_ALWAYS_INLINE inline Number
         eos_temperature(const Number &rho, const Number &e) const
         {
+          {
+            Number result;
+            if (eos_fast_path(result, [&](const auto &concrete_eos) {
+                  return concrete_eos.temperature_inline(rho, e);
+                }))
+              return result;
+          }
+
           const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
           if constexpr (std::is_same_v<ScalarNumber, Number>) {
@@ -216,14 +304,36 @@ namespace ryujin
         DEAL_II_ALWAYS_INLINE inline Number
         eos_speed_of_sound(const Number &rho, const Number &e) const
         {
+          {
+            Number result;
+            if (eos_fast_path(result, [&](const auto &concrete_eos) {
+                  return concrete_eos.speed_of_sound_inline(rho, e);
+                }))
+              return result;
+          }
+
           const auto &eos = hyperbolic_system_.selected_equation_of_state_;
 
           if constexpr (std::is_same_v<ScalarNumber, Number>) {
             return ScalarNumber(eos->speed_of_sound(rho, e));
           } else {
+            /*
+             * Use the batched interface so that we pay for the virtual
+             * dispatch only once per SIMD batch:
+             */
+            std::array<double, Number::size()> c_batch, rho_batch, e_batch;
+            for (unsigned int k = 0; k < Number::size(); ++k) {
+              rho_batch[k] = rho[k];
+              e_batch[k] = e[k];
+            }
+            constexpr auto n = Number::size();
+            eos->speed_of_sound(dealii::ArrayView<double>(c_batch.data(), n),
+                                dealii::ArrayView<double>(rho_batch.data(), n),
+                                dealii::ArrayView<double>(e_batch.data(), n));
+
             Number c;
             for (unsigned int k = 0; k < Number::size(); ++k) {
-              c[k] = ScalarNumber(eos->speed_of_sound(rho[k], e[k]));
+              c[k] = ScalarNumber(c_batch[k]);
             }
             return c;
           }
@@ -359,11 +469,24 @@ namespace ryujin
         static inline const auto precomputed_initial_names =
             std::array<std::string, n_precomputed_initial_values>{};
 
+        /**
+         * The number of precomputed (time-independent) edge values.
+         */
+        static constexpr unsigned int n_precomputed_edge_values = 0;
+
         /**
          * The number of precomputed values.
          */
         static constexpr unsigned int n_precomputed_values = 4;
 
+        /**
+         * Set to true if the approximate Riemann solver computes the
+         * maximal wave speed from precomputed values. Such values must
+         * not be exchanged with reduced precision because rounding
+         * could underestimate the wave speed.
+         */
+        static constexpr bool wave_speed_uses_precomputed_values = true;
+
         /**
          * Array type used for precomputed values.
          */
@@ -403,6 +526,22 @@ namespace ryujin
                                  unsigned int left,
                                  unsigned int right) const;
 
+        /**
+         * Variant of precomputation_loop() for the range [left, right) of
+         * ghost indices. Only the first (pointwise) precomputation cycle
+         * is supported: The pressure and surrogate gamma of cycle 0 only
+         * depend on U_i and can be computed redundantly for ghost indices.
+         * This makes the ghost exchange between cycle 0 and cycle 1
+         * unnecessary, see the "redundant ghost precomputation" option of
+         * HyperbolicModule.
+         */
+        void
+        precomputation_ghost_loop(unsigned int cycle,
+                                  precomputed_vector_type &precomputed_values,
+                                  const vector_type &U,
+                                  unsigned int left,
+                                  unsigned int right) const;
+
         //@}
         /**
          * @name Computing derived physical quantities
@@ -636,6 +775,13 @@ namespace ryujin
         high_order_flux(const flux_contribution_type &flux_i,
                         const flux_contribution_type &flux_j) const = delete;
 
+        /**
+         * The low-order update is formed with the states U_i and U_j
+         * directly, and the limiter bounds are not shifted (see
+         * ShallowWater::HyperbolicSystem::View::have_equilibrated_states):
+         */
+        static constexpr bool have_equilibrated_states = false;
+
         /**
          * @name Computing stencil source terms
          */
@@ -754,6 +900,8 @@ namespace ryujin
         const std::string &subsection /*= "HyperbolicSystem"*/)
         : ParameterAcceptor(subsection)
     {
+      equation_of_state_fast_path_ = EquationOfStateFastPath::none;
+
       equation_of_state_ = "polytropic gas";
       add_parameter(
           "equation of state",
@@ -801,6 +949,21 @@ namespace ryujin
           /* Populate EOS-specific quantities and functions */
           if (it->name() == equation_of_state_) {
             selected_equation_of_state_ = it;
+
+            using namespace EquationOfStateLibrary;
+            const auto pointer = it.get();
+            if (dynamic_cast<PolytropicGas *>(pointer) != nullptr)
+              equation_of_state_fast_path_ =
+                  EquationOfStateFastPath::polytropic_gas;
+            else if (dynamic_cast<NobleAbelStiffenedGas *>(pointer) != nullptr)
+              equation_of_state_fast_path_ =
+                  EquationOfStateFastPath::noble_abel_stiffened_gas;
+            else if (dynamic_cast<VanDerWaals *>(pointer) != nullptr)
+              equation_of_state_fast_path_ =
+                  EquationOfStateFastPath::van_der_waals;
+            else
+              equation_of_state_fast_path_ = EquationOfStateFastPath::none;
+
             problem_name =
                 "Compressible Euler equations (" + it->name() + " EOS)";
             initialized = true;
@@ -958,6 +1121,60 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    void HyperbolicSystem::View<dim, Number>::precomputation_ghost_loop(
+        unsigned int cycle [[maybe_unused]],
+        precomputed_vector_type &precomputed_values,
+        const vector_type &U,
+        unsigned int left,
+        unsigned int right) const
+    {
+      Assert(cycle == 0, dealii::ExcInternalError());
+
+      /* We are inside a thread parallel context */
+
+      const auto &eos = hyperbolic_system_.selected_equation_of_state_;
+
+      const auto write_precomputed = [&](const unsigned int i,
+                                         const Number &p_i) {
+        using PT = precomputed_state_type;
+        const auto U_i = U.template get_tensor<Number>(i);
+        const auto gamma_i = surrogate_gamma(U_i, p_i);
+        const PT prec_i{p_i, gamma_i, Number(0.), Number(0.)};
+        precomputed_values.template write_tensor<Number>(prec_i, i);
+      };
+
+      if (eos->prefer_vector_interface()) {
+        /* Make sure the call into eospac (and others) is single threaded. */
+        RYUJIN_OMP_SINGLE
+        {
+          const auto size = right - left;
+          std::vector<double> p(size);
+          std::vector<double> rho(size);
+          std::vector<double> e(size);
+          for (unsigned int i = 0; i < size; ++i) {
+            const auto U_i = U.template get_tensor<Number>(left + i);
+            rho[i] = density(U_i);
+            e[i] = internal_energy(U_i) / rho[i];
+          }
+
+          eos->pressure(p, rho, e);
+
+          for (unsigned int i = 0; i < size; ++i)
+            write_precomputed(left + i, Number(p[i]));
+        }
+      } else {
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; ++i) {
+          const auto U_i = U.template get_tensor<Number>(i);
+          const auto rho_i = density(U_i);
+          const auto e_i = internal_energy(U_i) / rho_i;
+          write_precomputed(i, eos_pressure(rho_i, e_i));
+        }
+      }
+    }
+
+
     template <int dim, typename Number>
     DEAL_II_ALWAYS_INLINE inline Number
     HyperbolicSystem::View<dim, Number>::density(const state_type &U)
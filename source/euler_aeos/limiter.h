@@ -120,6 +120,14 @@ namespace ryujin
        */
       using Bounds = std::array<Number, n_bounds>;
 
+      /**
+       * Rounding directions for storing the bounds in single precision,
+       * see Euler::Limiter::bounds_rounding. gamma_min is rounded down
+       * already in reset() so that s_min is consistent with it.
+       */
+      static constexpr std::array<int, n_bounds> bounds_rounding{
+          {-1, 1, -1, -1}};
+
       /**
        * Constructor taking a HyperbolicSystem instance as argument
        */
@@ -254,7 +262,15 @@ namespace ryujin
           precomputed_values
               .template get_tensor<Number, precomputed_state_type>(i);
 
+#ifdef MIXED_PRECISION_BOUNDS
+      /*
+       * The surrogate specific entropy bound s_min has to be computed
+       * with exactly the gamma_min that is stored in the bounds array:
+       */
+      gamma_min = round_to_float(gamma_min_i, bounds_rounding[3]);
+#else
       gamma_min = gamma_min_i;
+#endif
 
       /* Relaxation: */
 
@@ -169,10 +169,10 @@ namespace ryujin
           const auto rho_r_gamma = ryujin::pow(rho_r, gamma);
           const auto rho_e_r = hyperbolic_system.internal_energy(U_r);
           const auto covolume_r = Number(1.) - interpolation_b * rho_r;
+          const auto covolume_r_gm1 = ryujin::pow(covolume_r, -gm1);
 
-          auto psi_r =
-              relax_small * rho_r * rho_e_r -
-              s_min * rho_r * rho_r_gamma * ryujin::pow(covolume_r, -gm1);
+          auto psi_r = relax_small * rho_r * rho_e_r -
+                       s_min * rho_r * rho_r_gamma * covolume_r_gm1;
 
 #ifndef CHECK_BOUNDS
           /*
@@ -216,17 +216,17 @@ namespace ryujin
           const auto rho_l_gamma = ryujin::pow(rho_l, gamma);
           const auto rho_e_l = hyperbolic_system.internal_energy(U_l);
           const auto covolume_l = Number(1.) - interpolation_b * rho_l;
+          const auto covolume_l_gm1 = ryujin::pow(covolume_l, -gm1);
 
-          auto psi_l =
-              relax_small * rho_l * rho_e_l -
-              s_min * rho_l * rho_l_gamma * ryujin::pow(covolume_l, -gm1);
+          auto psi_l = relax_small * rho_l * rho_e_l -
+                       s_min * rho_l * rho_l_gamma * covolume_l_gm1;
 
           /*
            * Verify that the left state is within bounds. This property might
            * be violated for relative CFL numbers larger than 1.
            */
           const auto lower_bound = (ScalarNumber(1.) - relax) * s_min * rho_l *
-                                   rho_l_gamma * ryujin::pow(covolume_l, -gm1);
+                                   rho_l_gamma * covolume_l_gm1;
           if (n == 0 &&
               !(std::min(Number(0.), psi_l - lower_bound) == Number(0.))) {
 #ifdef DEBUG_OUTPUT
@@ -263,11 +263,15 @@ namespace ryujin
           const auto drho_e_r =
               hyperbolic_system.internal_energy_derivative(U_r) * P;
 
+          /*
+           * We have (rho / covolume)^gamma = rho^gamma covolume^(1 - gamma)
+           * / covolume. This saves two pow() calls per Newton step:
+           */
           const auto extra_term_l =
-              s_min * ryujin::pow(rho_l / covolume_l, gamma) *
+              s_min * rho_l_gamma * covolume_l_gm1 / covolume_l *
               (covolume_l + gamma - interpolation_b * rho_l);
           const auto extra_term_r =
-              s_min * ryujin::pow(rho_r / covolume_r, gamma) *
+              s_min * rho_r_gamma * covolume_r_gm1 / covolume_r *
               (covolume_r + gamma - interpolation_b * rho_r);
 
           const auto dpsi_l =
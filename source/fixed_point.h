@@ -0,0 +1,81 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <deal.II/base/config.h>
+
+#include <cstdint>
+
+namespace ryujin
+{
+  /**
+   * A 16 bit unsigned fixed-point number representing values in the unit
+   * interval [0, 1] with a resolution of 1/65535. Both end points are
+   * represented exactly.
+   *
+   * The class is intended as a compact storage type for limiter
+   * coefficients l_ij (see the compile-time option
+   * FIXED_POINT_LIMITER_COEFFICIENTS) and converts implicitly from and to
+   * floating point numbers. Conversion from a floating point number
+   * clamps to [0, 1] and rounds down, i.e., the stored value never
+   * exceeds the original value. This guarantees that a limiter
+   * coefficient is never increased by storing it, which preserves the
+   * invariant-domain property.
+   *
+   * @ingroup SIMD
+   */
+  class FixedPoint16
+  {
+  public:
+    /**
+     * Default constructor. Initializes to zero.
+     */
+    FixedPoint16() = default;
+
+    /**
+     * Convert from a floating point number (rounding down).
+     */
+    template <typename Number>
+    DEAL_II_ALWAYS_INLINE inline FixedPoint16(const Number value)
+    {
+      if (!(value > Number(0.))) {
+        /* Also catches NaN: */
+        value_ = 0;
+        return;
+      }
+
+      if (value >= Number(1.)) {
+        value_ = max;
+        return;
+      }
+
+      auto q = static_cast<std::uint16_t>(value * Number(max));
+      if (q > 0 && decode<Number>(q) > value)
+        q--;
+      value_ = q;
+    }
+
+    /**
+     * Convert to a floating point number.
+     */
+    template <typename Number>
+    DEAL_II_ALWAYS_INLINE inline operator Number() const
+    {
+      return decode<Number>(value_);
+    }
+
+  private:
+    static constexpr std::uint16_t max = 65535;
+
+    template <typename Number>
+    static DEAL_II_ALWAYS_INLINE inline Number decode(const std::uint16_t q)
+    {
+      return static_cast<Number>(q) * (Number(1.) / Number(max));
+    }
+
+    std::uint16_t value_ = 0;
+  };
+} // namespace ryujin
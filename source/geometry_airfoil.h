@@ -640,13 +640,13 @@ namespace ryujin
      * @todo Documentation
      */
     std::array<std::function<double(const double)>, 3>
-    create_psi(const std::vector<double> &x_upper [[maybe_unused]],
-               const std::vector<double> &y_upper [[maybe_unused]],
-               const std::vector<double> &x_lower [[maybe_unused]],
-               const std::vector<double> &y_lower [[maybe_unused]],
-               const double x_center [[maybe_unused]],
-               const double y_center [[maybe_unused]],
-               const double scaling [[maybe_unused]] = 1.)
+    create_psi(const std::vector<double> &x_upper,
+               const std::vector<double> &y_upper,
+               const std::vector<double> &x_lower,
+               const std::vector<double> &y_lower,
+               const double x_center,
+               const double y_center,
+               const double scaling = 1.)
     {
       Assert(x_upper.size() >= 2, dealii::ExcInternalError());
       Assert(x_upper.front() == 0. && x_upper.back() == 1.,
@@ -670,7 +670,6 @@ namespace ryujin
 
       Assert(0. < x_center && x_center < 1., dealii::ExcInternalError());
 
-#ifdef DEAL_II_WITH_GSL
       CubicSpline upper_airfoil(x_upper, y_upper);
       auto psi_upper =
           [upper_airfoil, x_center, y_center, scaling](const double x_hat) {
@@ -766,12 +765,6 @@ namespace ryujin
       };
 
       return {{psi_front, psi_upper, psi_lower}};
-#else
-      AssertThrow(
-          false,
-          dealii::ExcNotImplemented("Airfoil grid needs deal.II with GSL"));
-      return {};
-#endif
     }
 
 
@@ -8,6 +8,7 @@
 #include "geometry_airfoil.h"
 #include "geometry_annulus.h"
 #include "geometry_cylinder.h"
+#include "geometry_mesh_file.h"
 #include "geometry_rectangular_domain.h"
 #include "geometry_step.h"
 #include "geometry_wall.h"
@@ -41,6 +42,7 @@ namespace ryujin
       add(std::make_unique<RectangularDomain<dim>>(subsection));
       add(std::make_unique<Airfoil<dim>>(subsection));
       add(std::make_unique<Annulus<dim>>(subsection));
+      add(std::make_unique<MeshFile<dim>>(subsection));
     }
   } /* namespace Geometries */
 } /* namespace ryujin */
@@ -0,0 +1,253 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "geometry_common_includes.h"
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/grid/grid_in.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace ryujin
+{
+  namespace Geometries
+  {
+    /**
+     * A geometry that reads the coarse mesh from an external mesh file
+     * (for example a Gmsh "msh" file, or an ExodusII file if deal.II was
+     * configured with SEACAS) with the help of dealii::GridIn.
+     *
+     * In order to avoid that every MPI rank parses the (potentially
+     * large) mesh file concurrently only rank 0 reads the file. The
+     * coarse mesh description (vertices, cells and boundary faces) is
+     * then broadcast to all other ranks in a compact binary form from
+     * which every rank creates its distributed triangulation.
+     *
+     * The boundary ids stored in the mesh file are translated into
+     * ryujin's Boundary conditions with the help of the "boundary
+     * conditions" parameter. Boundary ids that are not listed are used
+     * as is.
+     *
+     * @ingroup Mesh
+     */
+    template <int dim>
+    class MeshFile : public Geometry<dim>
+    {
+    public:
+      MeshFile(const std::string subsection)
+          : Geometry<dim>("mesh file", subsection)
+      {
+        file_name_ = "mesh.msh";
+        this->add_parameter(
+            "file name", file_name_, "Name of the mesh file to read in");
+
+        file_format_ = "default";
+        this->add_parameter("file format",
+                            file_format_,
+                            "Format of the mesh file: \"default\" (guess the "
+                            "format from the file extension), or any format "
+                            "understood by dealii::GridIn, for example "
+                            "\"msh\", \"exodusii\", \"ucd\", or \"vtk\"");
+
+        this->add_parameter(
+            "boundary conditions",
+            boundary_conditions_,
+            "List of boundary ids used in the mesh file and the boundary "
+            "condition they are mapped to. Boundary ids that are not listed "
+            "are used as is. Format: '<file boundary id> : <boundary "
+            "condition> , [...]'");
+      }
+
+
+      void create_triangulation(
+          typename Geometry<dim>::Triangulation &triangulation) final
+      {
+        if constexpr (dim == 1) {
+          /* One dimensional meshes are small, simply read them everywhere: */
+          dealii::Triangulation<dim> tria1;
+          read_mesh(tria1);
+          triangulation.copy_triangulation(tria1);
+
+        } else {
+          const auto &mpi_communicator = triangulation.get_communicator();
+          const auto mpi_rank =
+              dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
+
+          constexpr auto vertices_per_cell =
+              dealii::GeometryInfo<dim>::vertices_per_cell;
+          constexpr auto vertices_per_face =
+              dealii::GeometryInfo<dim>::vertices_per_face;
+
+          /*
+           * Flat buffers holding the coarse mesh description: the
+           * coordinates of all vertices, for every cell its vertex
+           * indices, material id and manifold id, and for every boundary
+           * face its vertex indices, boundary id and manifold id:
+           */
+          std::vector<double> vertex_data;
+          std::vector<unsigned int> cell_data;
+          std::vector<unsigned int> face_data;
+
+          if (mpi_rank == 0) {
+            dealii::Triangulation<dim> tria1;
+            read_mesh(tria1);
+
+            const auto [vertices, cells, subcell_data] =
+                dealii::GridTools::get_coarse_mesh_description(tria1);
+            tria1.clear();
+
+            for (const auto &vertex : vertices)
+              for (unsigned int d = 0; d < dim; ++d)
+                vertex_data.push_back(vertex[d]);
+
+            for (const auto &cell : cells) {
+              std::copy(cell.vertices.begin(),
+                        cell.vertices.end(),
+                        std::back_inserter(cell_data));
+              cell_data.push_back(cell.material_id);
+              cell_data.push_back(cell.manifold_id);
+            }
+
+            for (const auto &face : boundary_faces(subcell_data)) {
+              std::copy(face.vertices.begin(),
+                        face.vertices.end(),
+                        std::back_inserter(face_data));
+              face_data.push_back(face.boundary_id);
+              face_data.push_back(face.manifold_id);
+            }
+          }
+
+          const auto broadcast = [&](auto &buffer, const MPI_Datatype type) {
+            auto size = dealii::Utilities::MPI::broadcast(
+                mpi_communicator, buffer.size(), 0);
+            AssertThrow(size <= std::numeric_limits<int>::max(),
+                        dealii::ExcMessage("Mesh file too large"));
+            buffer.resize(size);
+            const int ierr = MPI_Bcast(buffer.data(),
+                                       static_cast<int>(size),
+                                       type,
+                                       0,
+                                       mpi_communicator);
+            AssertThrowMPI(ierr);
+          };
+
+          broadcast(vertex_data, MPI_DOUBLE);
+          broadcast(cell_data, MPI_UNSIGNED);
+          broadcast(face_data, MPI_UNSIGNED);
+
+          /* Unpack the coarse mesh description on all ranks: */
+
+          std::vector<dealii::Point<dim>> vertices(vertex_data.size() / dim);
+          for (std::size_t i = 0; i < vertices.size(); ++i)
+            for (unsigned int d = 0; d < dim; ++d)
+              vertices[i][d] = vertex_data[i * dim + d];
+          vertex_data = std::vector<double>();
+
+          constexpr auto cell_stride = vertices_per_cell + 2;
+          std::vector<dealii::CellData<dim>> cells(cell_data.size() /
+                                                   cell_stride);
+          for (std::size_t i = 0; i < cells.size(); ++i) {
+            const auto it = cell_data.begin() + i * cell_stride;
+            cells[i].vertices.assign(it, it + vertices_per_cell);
+            cells[i].material_id = it[vertices_per_cell];
+            cells[i].manifold_id = it[vertices_per_cell + 1];
+          }
+          cell_data = std::vector<unsigned int>();
+
+          constexpr auto face_stride = vertices_per_face + 2;
+          dealii::SubCellData subcell_data;
+          auto &faces = boundary_faces(subcell_data);
+          faces.resize(face_data.size() / face_stride);
+          for (std::size_t i = 0; i < faces.size(); ++i) {
+            const auto it = face_data.begin() + i * face_stride;
+            faces[i].vertices.assign(it, it + vertices_per_face);
+            faces[i].boundary_id = it[vertices_per_face];
+            faces[i].manifold_id = it[vertices_per_face + 1];
+          }
+          face_data = std::vector<unsigned int>();
+
+          triangulation.create_triangulation(vertices, cells, subcell_data);
+        }
+      }
+
+    private:
+      /**
+       * Return the list of boundary faces stored in @p subcell_data.
+       */
+      static auto &boundary_faces(dealii::SubCellData &subcell_data)
+      {
+        if constexpr (dim == 2)
+          return subcell_data.boundary_lines;
+        else
+          return subcell_data.boundary_quads;
+      }
+
+      static const auto &
+      boundary_faces(const dealii::SubCellData &subcell_data)
+      {
+        if constexpr (dim == 2)
+          return subcell_data.boundary_lines;
+        else
+          return subcell_data.boundary_quads;
+      }
+
+      /**
+       * Read the mesh file into the serial triangulation @p tria1 and
+       * translate all boundary ids.
+       */
+      void read_mesh(dealii::Triangulation<dim> &tria1) const
+      {
+        dealii::GridIn<dim> grid_in;
+        grid_in.attach_triangulation(tria1);
+        if (file_format_ == "default")
+          grid_in.read(file_name_);
+        else
+          grid_in.read(file_name_,
+                       dealii::GridIn<dim>::parse_format(file_format_));
+
+        AssertThrow(tria1.all_reference_cells_are_hyper_cube(),
+                    dealii::ExcMessage("The mesh file »" + file_name_ +
+                                       "« must only contain quadrilaterals "
+                                       "or hexahedra"));
+
+        for (const auto &cell : tria1.active_cell_iterators()) {
+          for (const auto f : cell->face_indices()) {
+            const auto face = cell->face(f);
+            if (!face->at_boundary())
+              continue;
+
+            const auto id = face->boundary_id();
+            const auto it = std::find_if(
+                boundary_conditions_.begin(),
+                boundary_conditions_.end(),
+                [id](const auto &entry) { return std::get<0>(entry) == id; });
+            if (it != boundary_conditions_.end())
+              face->set_boundary_id(std::get<1>(*it));
+
+            AssertThrow(face->boundary_id() <= Boundary::dynamic,
+                        dealii::ExcMessage(
+                            "Boundary id " + std::to_string(id) +
+                            " of the mesh file is not a valid boundary "
+                            "condition. Specify a mapping with the "
+                            "\"boundary conditions\" parameter"));
+            AssertThrow(face->boundary_id() != Boundary::periodic,
+                        dealii::ExcMessage("Periodic boundary conditions "
+                                           "are not supported for meshes "
+                                           "read from a file"));
+          }
+        }
+      }
+
+      std::string file_name_;
+      std::string file_format_;
+
+      std::vector<std::tuple<dealii::types::boundary_id, Boundary>>
+          boundary_conditions_;
+    };
+  } /* namespace Geometries */
+} /* namespace ryujin */
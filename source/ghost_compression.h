@@ -0,0 +1,284 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "patterns_conversion.h"
+#include "simd.h"
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * The precision of the payload of a ghost exchange.
+   *
+   * @ingroup SIMD
+   */
+  enum class GhostCompression {
+    /**
+     * Send values in full precision.
+     */
+    none,
+
+    /**
+     * Send values in single precision.
+     */
+    single,
+
+    /**
+     * Send values in the bfloat16 format, i.e., a single precision
+     * number truncated to an 8 bit mantissa.
+     */
+    bfloat16,
+  };
+
+
+  namespace GhostCompressionImplementation
+  {
+    /**
+     * Return the number of 16 bit words needed for storing a value
+     * with the given @p compression.
+     */
+    inline unsigned int n_words(const GhostCompression compression)
+    {
+      return compression == GhostCompression::bfloat16 ? 1 : 2;
+    }
+
+
+    /**
+     * Encode the value @p number with the given @p compression and
+     * store it in @p words. The value is rounded in the given
+     * @p direction (see round_to_float()). The function returns the
+     * decoded (rounded) value.
+     */
+    template <typename Number>
+    inline Number encode(const Number number,
+                         const GhostCompression compression,
+                         const int direction,
+                         std::uint16_t *words)
+    {
+      static_assert(std::is_floating_point_v<Number>,
+                    "reduced precision ghost exchange requires a floating "
+                    "point number type");
+
+      float value = static_cast<float>(round_to_float(number, direction));
+      std::uint32_t bits;
+      std::memcpy(&bits, &value, sizeof(float));
+
+      if (compression == GhostCompression::bfloat16 && std::isfinite(value)) {
+        const std::uint32_t truncated = bits & 0xffff0000u;
+        if (direction == 0) {
+          /* round to nearest, ties to even: */
+          bits = (bits + 0x7fffu + ((bits >> 16) & 1u)) & 0xffff0000u;
+        } else if (truncated != bits) {
+          /* truncation rounds toward zero, fix up the other direction: */
+          const bool round_away = (direction > 0) == (value > 0.f);
+          bits = round_away ? truncated + 0x10000u : truncated;
+        }
+        words[0] = static_cast<std::uint16_t>(bits >> 16);
+        bits &= 0xffff0000u;
+
+      } else {
+        words[0] = static_cast<std::uint16_t>(bits >> 16);
+        words[1] = static_cast<std::uint16_t>(bits & 0xffffu);
+      }
+
+      std::memcpy(&value, &bits, sizeof(float));
+      return static_cast<Number>(value);
+    }
+
+
+    /**
+     * Decode a value stored by encode().
+     */
+    template <typename Number>
+    inline Number decode(const std::uint16_t *words,
+                         const GhostCompression compression)
+    {
+      std::uint32_t bits = std::uint32_t(words[0]) << 16;
+      if (compression != GhostCompression::bfloat16)
+        bits |= words[1];
+
+      float value;
+      std::memcpy(&value, &bits, sizeof(float));
+      return static_cast<Number>(value);
+    }
+  } // namespace GhostCompressionImplementation
+
+
+  /**
+   * A ghost exchange for distributed vectors (such as
+   * MultiComponentVector) that sends the payload with reduced
+   * precision.
+   *
+   * This is useful for quantities that are only consumed as bounds or
+   * blending factors, such as the indicator alpha_i or precomputed
+   * entropy values. The values are rounded in a given @p direction (see
+   * round_to_float()) so that a suitable choice leads to a conservative
+   * approximation. In addition, all exported locally owned values are
+   * replaced by their rounded counterparts. This way, the owner and all
+   * ranks that have the value as a ghost see identical values, which is
+   * necessary for conservation of the scheme.
+   *
+   * If the compression is set to GhostCompression::none the class simply
+   * forwards to Vector::update_ghost_values_start() and
+   * Vector::update_ghost_values_finish().
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  class CompressedGhostExchange
+  {
+  public:
+    using vector_type = dealii::LinearAlgebra::distributed::Vector<Number>;
+
+    /**
+     * Constructor.
+     */
+    CompressedGhostExchange(
+        const GhostCompression compression = GhostCompression::none,
+        const int direction = 0)
+        : compression_(compression)
+        , direction_(direction)
+    {
+    }
+
+    /**
+     * Set the @p compression and the rounding @p direction.
+     */
+    void reinit(const GhostCompression compression, const int direction)
+    {
+      compression_ = compression;
+      direction_ = direction;
+    }
+
+    /**
+     * Start the ghost exchange of @p vector on @p communication_channel.
+     */
+    void update_ghost_values_start(vector_type &vector,
+                                   const unsigned int communication_channel)
+    {
+      if (compression_ == GhostCompression::none) {
+        vector.update_ghost_values_start(communication_channel);
+        return;
+      }
+
+#ifdef DEAL_II_WITH_MPI
+      using namespace GhostCompressionImplementation;
+
+      AssertIndexRange(communication_channel, 200);
+      const unsigned int mpi_tag =
+          dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+          communication_channel;
+
+      const auto &partitioner = *vector.get_partitioner();
+      const auto mpi_communicator = partitioner.get_mpi_communicator();
+      const unsigned int n_owned = partitioner.locally_owned_size();
+      const unsigned int words = n_words(compression_);
+
+      receive_buffer_.resize(words * partitioner.n_ghost_indices());
+      send_buffer_.resize(words * partitioner.n_import_indices());
+      requests_.resize(partitioner.ghost_targets().size() +
+                       partitioner.import_targets().size());
+      auto request = requests_.begin();
+
+      /* Ghost ranges are contiguous in the order of ghost_targets(): */
+      std::size_t offset = 0;
+      for (const auto &[rank, count] : partitioner.ghost_targets()) {
+        const int ierr = MPI_Irecv(receive_buffer_.data() + words * offset,
+                                   words * count,
+                                   MPI_UINT16_T,
+                                   rank,
+                                   mpi_tag,
+                                   mpi_communicator,
+                                   &*request++);
+        AssertThrowMPI(ierr);
+        offset += count;
+      }
+
+      /* Encode export values and replace owned values by rounded ones: */
+      std::uint16_t *position = send_buffer_.data();
+      for (const auto &[first, last] : partitioner.import_indices())
+        for (unsigned int i = first; i < last; ++i, position += words) {
+          Assert(i < n_owned, dealii::ExcInternalError());
+          vector.local_element(i) = encode(
+              vector.local_element(i), compression_, direction_, position);
+        }
+
+      offset = 0;
+      for (const auto &[rank, count] : partitioner.import_targets()) {
+        const int ierr = MPI_Isend(send_buffer_.data() + words * offset,
+                                   words * count,
+                                   MPI_UINT16_T,
+                                   rank,
+                                   mpi_tag,
+                                   mpi_communicator,
+                                   &*request++);
+        AssertThrowMPI(ierr);
+        offset += count;
+      }
+#else
+      (void)vector;
+      (void)communication_channel;
+#endif
+    }
+
+    /**
+     * Finish the ghost exchange of @p vector.
+     */
+    void update_ghost_values_finish(vector_type &vector)
+    {
+      if (compression_ == GhostCompression::none) {
+        vector.update_ghost_values_finish();
+        return;
+      }
+
+#ifdef DEAL_II_WITH_MPI
+      using namespace GhostCompressionImplementation;
+
+      const int ierr = MPI_Waitall(
+          requests_.size(), requests_.data(), MPI_STATUSES_IGNORE);
+      AssertThrowMPI(ierr);
+
+      const auto &partitioner = *vector.get_partitioner();
+      const unsigned int n_owned = partitioner.locally_owned_size();
+      const unsigned int n_ghosts = partitioner.n_ghost_indices();
+      const unsigned int words = n_words(compression_);
+
+      for (unsigned int i = 0; i < n_ghosts; ++i)
+        vector.local_element(n_owned + i) =
+            decode<Number>(receive_buffer_.data() + words * i, compression_);
+
+      vector.set_ghost_state(true);
+#else
+      (void)vector;
+#endif
+    }
+
+  private:
+    GhostCompression compression_;
+    int direction_;
+
+    std::vector<std::uint16_t> send_buffer_;
+    std::vector<std::uint16_t> receive_buffer_;
+    std::vector<MPI_Request> requests_;
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::GhostCompression,
+             LIST({ryujin::GhostCompression::none, "none"},
+                  {ryujin::GhostCompression::single, "single"},
+                  {ryujin::GhostCompression::bfloat16, "bfloat16"}));
+#endif
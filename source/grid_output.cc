@@ -0,0 +1,16 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#include "grid_output.template.h"
+#include <instantiate.h>
+
+namespace ryujin
+{
+  /* instantiations */
+  template class GridOutput<Description, 1, NUMBER>;
+  template class GridOutput<Description, 2, NUMBER>;
+  template class GridOutput<Description, 3, NUMBER>;
+
+} /* namespace ryujin */
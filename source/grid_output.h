@@ -0,0 +1,144 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "offline_data.h"
+
+#include <deal.II/base/parameter_acceptor.h>
+#include <deal.II/base/point.h>
+
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+
+  /**
+   * The GridOutput class resamples the state onto a uniform Cartesian
+   * grid and writes the samples into a single compact binary file per
+   * output cycle (for example, as training data for surrogate models).
+   *
+   * The grid is given by its lower and upper corner and the number of
+   * points in every coordinate direction. In prepare(), i.e., after
+   * every mesh change, every rank locates all grid points that lie
+   * inside its locally owned cells and tabulates the interpolation
+   * weights (resolving hanging node constraints). A point on the
+   * interface between two subdomains is assigned to the rank with the
+   * smaller subdomain id. Writing out a cycle then only requires a
+   * weighted gather of the state followed by a collective MPI-IO write
+   * into the file "<name>-grid_<cycle>.npy" (or ".raw").
+   *
+   * The file contains an array of shape (n_z, n_y, n_x, n_components)
+   * in C order, i.e., the x coordinate varies fastest, holding the
+   * conserved (or primitive) state in the order given by the component
+   * names of the HyperbolicSystem. Grid points outside of the
+   * computational domain are set to NaN. The "npy" format prepends a
+   * header that makes the file loadable with numpy.load(), the "raw"
+   * format contains the bare array.
+   *
+   * @ingroup TimeLoop
+   */
+  template <typename Description, int dim, typename Number = double>
+  class GridOutput final : public dealii::ParameterAcceptor
+  {
+    /**
+     * @copydoc HyperbolicSystem
+     */
+    using HyperbolicSystem = typename Description::HyperbolicSystem;
+
+    /**
+     * @copydoc HyperbolicSystem::View
+     */
+    using HyperbolicSystemView =
+        typename Description::HyperbolicSystem::template View<dim, Number>;
+
+  public:
+    /**
+     * @copydoc HyperbolicSystem::problem_dimension
+     */
+    static constexpr unsigned int problem_dimension =
+        HyperbolicSystemView::problem_dimension;
+
+    /**
+     * @copydoc HyperbolicSystem::state_type
+     */
+    using state_type = typename HyperbolicSystemView::state_type;
+
+    /**
+     * Typedef for a MultiComponentVector storing the state U.
+     */
+    using vector_type = MultiComponentVector<Number, problem_dimension>;
+
+    /**
+     * Constructor.
+     */
+    GridOutput(const MPI_Comm &mpi_communicator,
+               const HyperbolicSystem &hyperbolic_system,
+               const OfflineData<dim, Number> &offline_data,
+               const std::string &subsection = "/GridOutput");
+
+    /**
+     * Locate all grid points and compute the interpolation weights. This
+     * function has to be called after every mesh change.
+     */
+    void prepare();
+
+    /**
+     * Given a state vector @p U, a file name prefix @p name, the current
+     * time @p t, and the current output cycle @p cycle, resample the
+     * state onto the grid and write it out. The state vector @p U must
+     * have updated ghost values.
+     *
+     * The function requires MPI communication and is not reentrant.
+     */
+    void write(const vector_type &U,
+               const std::string &name,
+               Number t,
+               unsigned int cycle) const;
+
+  private:
+    /**
+     * @name Run time options
+     */
+    //@{
+
+    dealii::Point<dim> lower_corner_;
+    dealii::Point<dim> upper_corner_;
+    std::vector<unsigned int> n_points_;
+
+    bool primitive_variables_;
+    bool single_precision_;
+    std::string format_;
+
+    //@}
+    /**
+     * @name Internal data
+     */
+    //@{
+
+    const MPI_Comm &mpi_communicator_;
+
+    dealii::SmartPointer<const HyperbolicSystem> hyperbolic_system_;
+    dealii::SmartPointer<const OfflineData<dim, Number>> offline_data_;
+
+    /*
+     * The (lexicographic) indices of all grid points written by this
+     * rank in increasing order, the first interpolation weight of every
+     * point and a final sentinel, and the (local) indices and weights of
+     * the interpolation stencils. Points without a stencil lie outside
+     * of the domain and are written out as NaN (on rank 0).
+     */
+    std::vector<std::size_t> point_indices_;
+    std::vector<unsigned int> offsets_;
+    std::vector<unsigned int> indices_;
+    std::vector<Number> weights_;
+
+    //@}
+  };
+
+} /* namespace ryujin */
@@ -0,0 +1,411 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "grid_output.h"
+#include "openmp.h"
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace ryujin
+{
+  using namespace dealii;
+
+
+  template <typename Description, int dim, typename Number>
+  GridOutput<Description, dim, Number>::GridOutput(
+      const MPI_Comm &mpi_communicator,
+      const HyperbolicSystem &hyperbolic_system,
+      const OfflineData<dim, Number> &offline_data,
+      const std::string &subsection /*= "GridOutput"*/)
+      : ParameterAcceptor(subsection)
+      , mpi_communicator_(mpi_communicator)
+      , hyperbolic_system_(&hyperbolic_system)
+      , offline_data_(&offline_data)
+  {
+    for (unsigned int d = 0; d < dim; ++d)
+      upper_corner_[d] = 1.;
+    add_parameter("lower corner",
+                  lower_corner_,
+                  "Lower corner of the bounding box of the uniform grid");
+    add_parameter("upper corner",
+                  upper_corner_,
+                  "Upper corner of the bounding box of the uniform grid");
+
+    n_points_.assign(dim, 64);
+    add_parameter("number of points",
+                  n_points_,
+                  "Number of grid points in every coordinate direction "
+                  "(including both end points)");
+
+    primitive_variables_ = false;
+    add_parameter("primitive variables",
+                  primitive_variables_,
+                  "Write out the primitive state instead of the conserved "
+                  "state");
+
+    single_precision_ = true;
+    add_parameter("single precision",
+                  single_precision_,
+                  "Write out all values in single precision");
+
+    format_ = "npy";
+    add_parameter("format",
+                  format_,
+                  "File format: \"npy\" (numpy array with header), or "
+                  "\"raw\" (the bare array)");
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void GridOutput<Description, dim, Number>::prepare()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "GridOutput<dim, Number>::prepare()" << std::endl;
+#endif
+
+    AssertThrow(n_points_.size() == dim,
+                ExcMessage("The parameter \"number of points\" must contain "
+                           "exactly one entry per coordinate direction"));
+    AssertThrow(format_ == "npy" || format_ == "raw",
+                ExcMessage("Unknown grid output format »" + format_ + "«"));
+
+    point_indices_.clear();
+    offsets_.assign(1, 0);
+    indices_.clear();
+    weights_.clear();
+
+    const auto &discretization = offline_data_->discretization();
+    const auto &triangulation = discretization.triangulation();
+    const auto &mapping = discretization.mapping();
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &finite_element = dof_handler.get_fe();
+    const auto &scalar_partitioner = offline_data_->scalar_partitioner();
+    const auto &affine_constraints = offline_data_->affine_constraints();
+
+    const unsigned int dofs_per_cell = finite_element.dofs_per_cell;
+    std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
+
+    std::size_t n_total = 1;
+    Tensor<1, dim> spacing;
+    for (unsigned int d = 0; d < dim; ++d) {
+      AssertThrow(n_points_[d] > 0,
+                  ExcMessage("The number of grid points must be positive"));
+      n_total *= n_points_[d];
+      spacing[d] = n_points_[d] > 1 ? (upper_corner_[d] - lower_corner_[d]) /
+                                          double(n_points_[d] - 1)
+                                    : 0.;
+    }
+
+    /*
+     * Locate all grid points inside locally owned and ghost cells by
+     * enumerating the grid points within the (slightly enlarged)
+     * bounding box of every cell. A point contained in several cells is
+     * assigned to the cell with the smallest subdomain id. Because all
+     * cells touching a locally owned cell are part of the ghost layer
+     * every rank takes the same decision for points on subdomain
+     * interfaces without communication:
+     */
+
+    using cell_type = typename Triangulation<dim>::active_cell_iterator;
+    std::map<std::size_t, std::tuple<cell_type, Point<dim>>> located;
+
+    for (const auto &cell : triangulation.active_cell_iterators()) {
+      if (!cell->is_locally_owned() && !cell->is_ghost())
+        continue;
+
+      const auto cell_box = cell->bounding_box();
+      std::array<unsigned int, 3> first = {{0, 0, 0}};
+      std::array<unsigned int, 3> last = {{0, 0, 0}};
+      bool empty = false;
+      for (unsigned int d = 0; d < dim; ++d) {
+        const double margin =
+            0.1 * (cell_box.upper_bound(d) - cell_box.lower_bound(d));
+        const double lower = cell_box.lower_bound(d) - margin;
+        const double upper = cell_box.upper_bound(d) + margin;
+        if (spacing[d] == 0.) {
+          empty |= (lower_corner_[d] < lower || lower_corner_[d] > upper);
+          continue;
+        }
+        const double a = (lower - lower_corner_[d]) / spacing[d];
+        const double b = (upper - lower_corner_[d]) / spacing[d];
+        const double n_max = n_points_[d] - 1;
+        if (b < 0. || a > n_max) {
+          empty = true;
+          continue;
+        }
+        first[d] = static_cast<unsigned int>(std::ceil(std::max(a, 0.)));
+        last[d] = static_cast<unsigned int>(std::floor(std::min(b, n_max)));
+        empty |= first[d] > last[d];
+      }
+      if (empty)
+        continue;
+
+      for (unsigned int k = first[2]; k <= last[2]; ++k)
+        for (unsigned int j = first[1]; j <= last[1]; ++j)
+          for (unsigned int i = first[0]; i <= last[0]; ++i) {
+            const std::array<unsigned int, 3> ijk = {{i, j, k}};
+            Point<dim> point;
+            std::size_t index = 0;
+            for (int d = dim - 1; d >= 0; --d) {
+              point[d] = lower_corner_[d] + ijk[d] * spacing[d];
+              index = index * n_points_[d] + ijk[d];
+            }
+
+            const auto it = located.find(index);
+            if (it != located.end() &&
+                std::get<0>(it->second)->subdomain_id() <=
+                    cell->subdomain_id())
+              continue;
+
+            Point<dim> unit_point;
+            try {
+              unit_point = mapping.transform_real_to_unit_cell(cell, point);
+            } catch (typename Mapping<dim>::ExcTransformationFailed &) {
+              continue;
+            }
+            if (!GeometryInfo<dim>::is_inside_unit_cell(unit_point, 1.e-10))
+              continue;
+
+            located[index] = {cell, unit_point};
+          }
+    }
+
+    for (auto it = located.begin(); it != located.end();)
+      if (std::get<0>(it->second)->is_locally_owned())
+        ++it;
+      else
+        it = located.erase(it);
+
+    /*
+     * Rank 0 additionally writes out all grid points that are not
+     * contained in any cell (with a NaN value):
+     */
+
+    const auto n_located =
+        Utilities::MPI::sum(located.size(), mpi_communicator_);
+    if (n_located < n_total) {
+      std::vector<unsigned char> local_mask(n_total, 0);
+      for (const auto &it : located)
+        local_mask[it.first] = 1;
+      std::vector<unsigned char> mask(n_total, 0);
+      const int ierr = MPI_Reduce(local_mask.data(),
+                                  mask.data(),
+                                  n_total,
+                                  MPI_UNSIGNED_CHAR,
+                                  MPI_MAX,
+                                  0,
+                                  mpi_communicator_);
+      AssertThrowMPI(ierr);
+      if (Utilities::MPI::this_mpi_process(mpi_communicator_) == 0)
+        for (std::size_t index = 0; index < n_total; ++index)
+          if (mask[index] == 0)
+            located[index] = {cell_type(), Point<dim>()};
+    }
+
+    /*
+     * Tabulate interpolation weights. Constrained degrees of freedom are
+     * replaced by the degrees of freedom they are constrained to so that
+     * sampling only requires a weighted gather of the state:
+     */
+
+    const auto add_entry = [&](const dealii::types::global_dof_index global,
+                               const Number weight) {
+      AssertThrow(scalar_partitioner->in_local_range(global) ||
+                      scalar_partitioner->is_ghost_entry(global),
+                  dealii::ExcMessage("Interpolation stencil of a grid point "
+                                     "is not locally relevant"));
+      indices_.push_back(scalar_partitioner->global_to_local(global));
+      weights_.push_back(weight);
+    };
+
+    for (const auto &[index, entry] : located) {
+      const auto &[cell, unit_point] = entry;
+      point_indices_.push_back(index);
+
+      if (cell.state() == IteratorState::valid) {
+        typename DoFHandler<dim>::active_cell_iterator dof_cell(
+            &triangulation, cell->level(), cell->index(), &dof_handler);
+        dof_cell->get_dof_indices(dof_indices);
+
+        for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+          const Number weight = finite_element.shape_value(j, unit_point);
+          if (std::abs(weight) < std::numeric_limits<Number>::epsilon())
+            continue;
+
+          const auto global = dof_indices[j];
+          if (affine_constraints.is_constrained(global)) {
+            for (const auto &[column, factor] :
+                 *affine_constraints.get_constraint_entries(global))
+              add_entry(column, weight * Number(factor));
+          } else {
+            add_entry(global, weight);
+          }
+        }
+      }
+
+      offsets_.push_back(indices_.size());
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void GridOutput<Description, dim, Number>::write(const vector_type &U,
+                                                   const std::string &name,
+                                                   Number /*t*/,
+                                                   unsigned int cycle) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "GridOutput<dim, Number>::write()" << std::endl;
+#endif
+
+    constexpr unsigned int n_components = problem_dimension;
+    const auto view = hyperbolic_system_->template view<dim, Number>();
+    const std::size_t n_local = point_indices_.size();
+
+    const auto write_out = [&](auto value_type) {
+      using T = decltype(value_type);
+
+      /* Interpolate the state with a weighted gather: */
+
+      std::vector<T> buffer(n_local * n_components);
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      RYUJIN_OMP_FOR
+      for (std::size_t k = 0; k < n_local; ++k) {
+        if (offsets_[k] == offsets_[k + 1]) {
+          for (unsigned int c = 0; c < n_components; ++c)
+            buffer[k * n_components + c] = std::numeric_limits<T>::quiet_NaN();
+          continue;
+        }
+
+        state_type U_k;
+        for (unsigned int l = offsets_[k]; l < offsets_[k + 1]; ++l)
+          U_k += weights_[l] * U.get_tensor(indices_[l]);
+        if (primitive_variables_)
+          U_k = view.to_primitive_state(U_k);
+
+        for (unsigned int c = 0; c < n_components; ++c)
+          buffer[k * n_components + c] = T(U_k[c]);
+      }
+
+      RYUJIN_PARALLEL_REGION_END
+
+      /*
+       * Assemble the numpy header (padded to a multiple of 64 bytes). The
+       * header is identical on all ranks:
+       */
+
+      std::string header;
+      if (format_ == "npy") {
+        std::ostringstream dictionary;
+        dictionary << "{'descr': '<f" << sizeof(T)
+                   << "', 'fortran_order': False, 'shape': (";
+        for (int d = dim - 1; d >= 0; --d)
+          dictionary << n_points_[d] << ", ";
+        dictionary << n_components << "), }";
+
+        header = dictionary.str();
+        const std::size_t length = 10 + header.size() + 1;
+        header.append((64 - length % 64) % 64, ' ');
+        header += '\n';
+
+        const auto header_length = static_cast<std::uint16_t>(header.size());
+        header = std::string("\x93NUMPY\x01\x00", 8) +
+                 char(header_length & 0xff) + char(header_length >> 8) +
+                 header;
+      }
+
+      /*
+       * Describe the locally written points as contiguous runs of
+       * points within the file and write out collectively:
+       */
+
+      const std::size_t point_bytes = n_components * sizeof(T);
+      std::vector<int> lengths;
+      std::vector<MPI_Aint> displacements;
+      for (std::size_t k = 0; k < n_local; ++k) {
+        if (k > 0 && point_indices_[k] == point_indices_[k - 1] + 1) {
+          ++lengths.back();
+          continue;
+        }
+        lengths.push_back(1);
+        displacements.push_back(point_indices_[k] * point_bytes);
+      }
+
+      MPI_Datatype point_type, file_type;
+      int ierr = MPI_Type_contiguous(point_bytes, MPI_BYTE, &point_type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_commit(&point_type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_create_hindexed(lengths.size(),
+                                      lengths.data(),
+                                      displacements.data(),
+                                      point_type,
+                                      &file_type);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Type_commit(&file_type);
+      AssertThrowMPI(ierr);
+
+      const std::string file_name =
+          name + "-grid_" + Utilities::to_string(cycle, 6) + "." + format_;
+
+      MPI_File file;
+      ierr = MPI_File_open(mpi_communicator_,
+                           file_name.c_str(),
+                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                           MPI_INFO_NULL,
+                           &file);
+      AssertThrowMPI(ierr);
+      ierr = MPI_File_set_size(file, 0);
+      AssertThrowMPI(ierr);
+
+      if (Utilities::MPI::this_mpi_process(mpi_communicator_) == 0 &&
+          !header.empty()) {
+        ierr = MPI_File_write_at(file,
+                                 0,
+                                 header.data(),
+                                 header.size(),
+                                 MPI_BYTE,
+                                 MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+      }
+
+      ierr = MPI_File_set_view(file,
+                               header.size(),
+                               point_type,
+                               file_type,
+                               "native",
+                               MPI_INFO_NULL);
+      AssertThrowMPI(ierr);
+      ierr = MPI_File_write_all(
+          file, buffer.data(), n_local, point_type, MPI_STATUS_IGNORE);
+      AssertThrowMPI(ierr);
+
+      ierr = MPI_File_close(&file);
+      AssertThrowMPI(ierr);
+
+      MPI_Type_free(&file_type);
+      MPI_Type_free(&point_type);
+    };
+
+    if (single_precision_)
+      write_out(float());
+    else
+      write_out(Number());
+  }
+
+} /* namespace ryujin */
@@ -0,0 +1,501 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "openmp.h"
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ryujin
+{
+  /**
+   * A minimal hardware performance counter backend based on the Linux
+   * perf_event interface. In contrast to likwid (see introspection.h)
+   * this does not require access to model specific registers: Only the
+   * user space part of the calling process is measured, which is allowed
+   * for unprivileged users with the default perf_event_paranoid setting
+   * of 2.
+   *
+   * For every OpenMP thread the following generic hardware events are
+   * counted: cycles, instructions, last level cache references and last
+   * level cache misses. In addition, a list of raw (model specific)
+   * floating point events with an associated number of floating point
+   * operations per event can be given, for example
+   *
+   * @code
+   * 0x01c7:1, 0x04c7:2, 0x10c7:4, 0x40c7:8
+   * @endcode
+   *
+   * for the FP_ARITH_INST_RETIRED (scalar, 128, 256 and 512 bit packed
+   * double) events of recent Intel CPUs. All events with a weight greater
+   * than one are considered to be vector instructions.
+   *
+   * The counters are free running. A Region reads the counters of all
+   * threads when it is created and accumulates the difference when it is
+   * stopped (or destroyed). Usage:
+   *
+   * @code
+   * {
+   *   const auto region = hardware_counters.region("[H] 2");
+   *   RYUJIN_PARALLEL_REGION_BEGIN
+   *   // thread parallel work
+   *   RYUJIN_PARALLEL_REGION_END
+   * }
+   * @endcode
+   *
+   * Threads that are not part of the OpenMP thread pool (such as TBB
+   * worker threads) are not measured. Counts are scaled to compensate
+   * for multiplexing. All functions are no-ops if the counters are
+   * disabled or not available. Not thread safe.
+   *
+   * @ingroup Miscellaneous
+   */
+  class HardwareCounters
+  {
+    using clock = std::chrono::steady_clock;
+
+    static constexpr unsigned int n_generic_events = 4;
+    static constexpr unsigned int max_fp_events = 8;
+    static constexpr unsigned int max_events = n_generic_events + max_fp_events;
+
+    using values_type = std::array<double, max_events>;
+
+    struct Data {
+      unsigned long long n_calls = 0;
+      double wall_time = 0.;
+      values_type values = {};
+    };
+
+  public:
+    /**
+     * A handle for a single execution of a measured region. The region
+     * is stopped on destruction.
+     */
+    class Region
+    {
+    public:
+      Region() = default;
+
+      Region(const Region &) = delete;
+      Region &operator=(const Region &) = delete;
+
+      Region(Region &&other) noexcept
+          : counters_(other.counters_)
+          , data_(std::exchange(other.data_, nullptr))
+          , start_(other.start_)
+          , start_time_(other.start_time_)
+      {
+      }
+
+      ~Region()
+      {
+        stop();
+      }
+
+      /**
+       * Accumulate the counts since the creation of the region. Executes
+       * in serial, non thread-parallel context.
+       */
+      void stop()
+      {
+        if (data_ == nullptr)
+          return;
+        const auto values = counters_->read();
+        for (unsigned int k = 0; k < max_events; ++k)
+          data_->values[k] += values[k] - start_[k];
+        data_->wall_time +=
+            std::chrono::duration<double>(clock::now() - start_time_)
+                .count();
+        data_->n_calls++;
+        data_ = nullptr;
+      }
+
+    private:
+      friend class HardwareCounters;
+
+      HardwareCounters *counters_ = nullptr;
+      Data *data_ = nullptr;
+      values_type start_ = {};
+      clock::time_point start_time_;
+    };
+
+    HardwareCounters() = default;
+
+    HardwareCounters(const HardwareCounters &) = delete;
+    HardwareCounters &operator=(const HardwareCounters &) = delete;
+
+    /**
+     * Destructor. Closes all counters.
+     */
+    ~HardwareCounters()
+    {
+      close();
+    }
+
+    /**
+     * (Re)open the counters for all threads of the OpenMP thread pool if
+     * @p enabled is true, or close them otherwise. The list
+     * @p fp_events contains raw floating point events of the form
+     * "<event code>:<floating point operations per event>". Recorded data
+     * is cleared. Executes in serial, non thread-parallel context.
+     */
+    void reinit(const bool enabled,
+                const std::vector<std::string> &fp_events = {})
+    {
+      close();
+      clear();
+      error_.clear();
+      enabled_ = enabled;
+      if (!enabled_)
+        return;
+
+      fp_events_.clear();
+      for (const auto &entry : fp_events) {
+        const auto colon = entry.find(':');
+        AssertThrow(colon != std::string::npos,
+                    dealii::ExcMessage("Invalid floating point event »" +
+                                       entry +
+                                       "«. Expected \"<code>:<weight>\"."));
+        fp_events_.emplace_back(std::stoull(entry.substr(0, colon), nullptr, 0),
+                                std::stod(entry.substr(colon + 1)));
+      }
+      AssertThrow(fp_events_.size() <= max_fp_events,
+                  dealii::ExcMessage("At most " +
+                                     std::to_string(max_fp_events) +
+                                     " floating point events are supported"));
+
+#ifdef __linux__
+#ifdef WITH_OPENMP
+      const unsigned int n_threads = omp_get_max_threads();
+#else
+      const unsigned int n_threads = 1;
+#endif
+      threads_.assign(n_threads, ThreadCounters());
+      std::vector<int> errors(n_threads, 0);
+
+      /* Counters measure the calling thread, so every thread opens its own: */
+      RYUJIN_PARALLEL_REGION_BEGIN
+#ifdef WITH_OPENMP
+      const unsigned int thread = omp_get_thread_num();
+#else
+      const unsigned int thread = 0;
+#endif
+      auto &counters = threads_[thread];
+
+      counters.generic = open_group(PERF_TYPE_HARDWARE,
+                                    {PERF_COUNT_HW_CPU_CYCLES,
+                                     PERF_COUNT_HW_INSTRUCTIONS,
+                                     PERF_COUNT_HW_CACHE_REFERENCES,
+                                     PERF_COUNT_HW_CACHE_MISSES},
+                                    counters.fds,
+                                    errors[thread]);
+
+      if (!fp_events_.empty()) {
+        std::vector<std::uint64_t> codes;
+        for (const auto &it : fp_events_)
+          codes.push_back(it.first);
+        counters.fp =
+            open_group(PERF_TYPE_RAW, codes, counters.fds, errors[thread]);
+      }
+      RYUJIN_PARALLEL_REGION_END
+
+      for (const auto error : errors)
+        if (error != 0) {
+          error_ = std::strerror(error);
+          close();
+          break;
+        }
+#else
+      error_ = "not supported on this platform";
+#endif
+    }
+
+    /**
+     * Return whether the counters are enabled and available.
+     */
+    bool enabled() const
+    {
+      return enabled_ && !threads_.empty();
+    }
+
+    /**
+     * Clear all recorded data.
+     */
+    void clear()
+    {
+      data_.clear();
+    }
+
+    /**
+     * Start a new execution of the region @p name. Executes in serial,
+     * non thread-parallel context.
+     */
+    Region region(const std::string &name)
+    {
+      Region region;
+      if (!enabled())
+        return region;
+
+      region.counters_ = this;
+      region.data_ = &data_[name];
+      region.start_time_ = clock::now();
+      region.start_ = read();
+      return region;
+    }
+
+    /**
+     * Start a new execution of the region "stage k" where k is the
+     * number of calls since the last call to reset_stages(). Executes in
+     * serial, non thread-parallel context.
+     */
+    Region stage()
+    {
+      if (!enabled())
+        return Region();
+
+      if (stage_names_.size() <= n_stages_)
+        stage_names_.push_back("stage " + std::to_string(n_stages_ + 1));
+      return region(stage_names_[n_stages_++]);
+    }
+
+    /**
+     * Restart the numbering of stage().
+     */
+    void reset_stages()
+    {
+      n_stages_ = 0;
+    }
+
+    /**
+     * Print a table with the hardware counter statistics of all regions
+     * to @p output on rank 0. Counts are summed over all threads and
+     * ranks:
+     *
+     *  - IPC: instructions per cycle,
+     *  - llc miss: fraction of last level cache references that missed,
+     *  - bandwidth: estimated memory read bandwidth (64 bytes per last
+     *    level cache miss, write-backs are not accounted for),
+     *  - GFLOP/s and vec: floating point performance and fraction of
+     *    floating point operations in vector instructions (only if
+     *    floating point events are configured).
+     *
+     * This function has to be called on all ranks.
+     */
+    void print_statistics(std::ostream &output,
+                          const MPI_Comm &mpi_communicator) const
+    {
+      if (!enabled_)
+        return;
+
+      const auto rank = dealii::Utilities::MPI::this_mpi_process(
+          mpi_communicator);
+
+      std::ostringstream stream;
+      stream << "\nHardware counter statistics:\n";
+
+      if (!error_.empty()) {
+        stream << "  [unavailable: " << error_ << "]\n";
+      }
+
+      for (const auto &[name, data] : data_) {
+        const auto values = dealii::Utilities::MPI::sum(
+            std::vector<double>(data.values.begin(), data.values.end()),
+            mpi_communicator);
+        const double wall_time =
+            dealii::Utilities::MPI::max(data.wall_time, mpi_communicator);
+
+        const auto ratio = [](const double a, const double b) {
+          return b > 0. ? a / b : 0.;
+        };
+
+        stream << "  " << std::left << std::setw(10) << name << std::right
+               << std::fixed << std::setprecision(2) << "[IPC: "
+               << std::setw(5) << ratio(values[1], values[0])
+               << "] [llc miss: " << std::setprecision(1) << std::setw(5)
+               << 100. * ratio(values[3], values[2]) << "%, "
+               << std::setw(7) << ratio(64. * values[3], wall_time) / 1.e9
+               << " GB/s]";
+
+        if (!fp_events_.empty()) {
+          double flops = 0.;
+          double vector_flops = 0.;
+          for (unsigned int k = 0; k < fp_events_.size(); ++k) {
+            const double weight = fp_events_[k].second;
+            flops += weight * values[n_generic_events + k];
+            if (weight > 1.)
+              vector_flops += weight * values[n_generic_events + k];
+          }
+          stream << " [" << std::setw(8) << ratio(flops, wall_time) / 1.e9
+                 << " GFLOP/s, vec: " << std::setw(5)
+                 << 100. * ratio(vector_flops, flops) << "%]";
+        }
+        stream << "\n";
+      }
+
+      if (rank == 0)
+        output << stream.str() << std::flush;
+    }
+
+    /**
+     * Return the number of floating point operations counted by this
+     * rank in every region. The map is empty if the counters are
+     * disabled or if no floating point events are configured.
+     */
+    std::map<std::string, double> floating_point_operations() const
+    {
+      std::map<std::string, double> result;
+      if (!enabled_ || fp_events_.empty())
+        return result;
+
+      for (const auto &[name, data] : data_) {
+        double flops = 0.;
+        for (unsigned int k = 0; k < fp_events_.size(); ++k)
+          flops += fp_events_[k].second * data.values[n_generic_events + k];
+        result[name] = flops;
+      }
+      return result;
+    }
+
+  private:
+#ifdef __linux__
+    /**
+     * Open a group of counters for the calling thread and return the
+     * file descriptor of the group leader. All file descriptors are
+     * appended to @p fds. On failure @p error is set to errno.
+     */
+    static int open_group(const std::uint32_t type,
+                          const std::vector<std::uint64_t> &codes,
+                          std::vector<int> &fds,
+                          int &error)
+    {
+      int leader = -1;
+      for (const auto code : codes) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = code;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP |
+                           PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        const int fd = syscall(SYS_perf_event_open,
+                               &attr,
+                               /* calling thread */ 0,
+                               /* any cpu */ -1,
+                               leader,
+                               0);
+        if (fd < 0) {
+          error = errno;
+          return leader;
+        }
+        fds.push_back(fd);
+        if (leader == -1)
+          leader = fd;
+      }
+      return leader;
+    }
+
+    /**
+     * Read a group of counters and add the (multiplexing-scaled) values
+     * to @p values starting at @p offset.
+     */
+    static void read_group(const int leader,
+                           values_type &values,
+                           const unsigned int offset)
+    {
+      if (leader < 0)
+        return;
+
+      std::array<std::uint64_t, 3 + max_events> buffer;
+      if (::read(leader, buffer.data(), sizeof(buffer)) <= 0)
+        return;
+
+      const auto n = std::min<std::uint64_t>(buffer[0], max_events - offset);
+      const double enabled = buffer[1];
+      const double running = buffer[2];
+      if (running == 0.)
+        return;
+      for (unsigned int k = 0; k < n; ++k)
+        values[offset + k] += double(buffer[3 + k]) * enabled / running;
+    }
+#endif
+
+    /**
+     * Read the counters of all threads.
+     */
+    values_type read() const
+    {
+      values_type values = {};
+#ifdef __linux__
+      for (const auto &counters : threads_) {
+        read_group(counters.generic, values, 0);
+        read_group(counters.fp, values, n_generic_events);
+      }
+#endif
+      return values;
+    }
+
+    /**
+     * Close all counters.
+     */
+    void close()
+    {
+#ifdef __linux__
+      for (const auto &counters : threads_)
+        for (const auto fd : counters.fds)
+          ::close(fd);
+#endif
+      threads_.clear();
+    }
+
+    bool enabled_ = false;
+    std::string error_;
+
+    std::vector<std::pair<std::uint64_t, double>> fp_events_;
+
+    /*
+     * The group leaders (generic and floating point events) and all file
+     * descriptors of a thread:
+     */
+    struct ThreadCounters {
+      int generic = -1;
+      int fp = -1;
+      std::vector<int> fds;
+    };
+
+    std::vector<ThreadCounters> threads_;
+
+    std::map<std::string, Data> data_;
+
+    std::vector<std::string> stage_names_;
+    unsigned int n_stages_ = 0;
+  };
+} // namespace ryujin
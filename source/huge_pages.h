@@ -0,0 +1,97 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/aligned_vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace ryujin
+{
+  namespace internal
+  {
+    inline bool &transparent_huge_pages()
+    {
+      static bool enabled = false;
+      return enabled;
+    }
+  } // namespace internal
+
+
+  /**
+   * Enable or disable the use of transparent huge pages for the large
+   * arrays of SparsityPatternSIMD, SparseMatrixSIMD, and
+   * MultiComponentVector, see advise_huge_pages(). The setting is
+   * process wide and is controlled by the TimeLoop parameter
+   * "transparent huge pages". It only affects subsequent allocations.
+   *
+   * @ingroup SIMD
+   */
+  inline void set_transparent_huge_pages(const bool enabled)
+  {
+    internal::transparent_huge_pages() = enabled;
+  }
+
+
+  /**
+   * If enabled by set_transparent_huge_pages(), advise the kernel to
+   * back the memory range [@p pointer, @p pointer + @p bytes) with
+   * transparent (2MB) huge pages (madvise with MADV_HUGEPAGE). Only the
+   * part of the range that is aligned to huge page boundaries is
+   * advised; small arrays are thus not affected. This reduces the
+   * number of dTLB misses for the indirect (gather) access of large
+   * arrays.
+   *
+   * The function should be called prior to the first touch of the
+   * memory so that huge pages are allocated directly in the page fault
+   * handler (which happens on the NUMA node of the touching thread).
+   * Already populated memory is only collapsed into huge pages
+   * asynchronously by the kernel. The function does nothing on systems
+   * other than Linux. Errors are ignored because the advice is merely a
+   * hint.
+   *
+   * @ingroup SIMD
+   */
+  inline void advise_huge_pages(const void *pointer, const std::size_t bytes)
+  {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (!internal::transparent_huge_pages() || bytes == 0)
+      return;
+
+    constexpr std::uintptr_t huge_page_size = 2 * 1024 * 1024;
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    const auto begin =
+        (address + huge_page_size - 1) / huge_page_size * huge_page_size;
+    const auto end = (address + bytes) / huge_page_size * huge_page_size;
+
+    if (begin < end)
+      madvise(reinterpret_cast<void *>(begin), end - begin, MADV_HUGEPAGE);
+#else
+    (void)pointer;
+    (void)bytes;
+#endif
+  }
+
+
+  /**
+   * Variant of above function for the storage of a
+   * dealii::AlignedVector.
+   *
+   * @ingroup SIMD
+   */
+  template <typename T>
+  inline void advise_huge_pages(const dealii::AlignedVector<T> &vector)
+  {
+    advise_huge_pages(vector.data(), vector.size() * sizeof(T));
+  }
+} // namespace ryujin
@@ -9,13 +9,15 @@
 #define INSTANTIATE(dim, stages)                                               \
   template NUMBER HyperbolicModule<Description, dim, NUMBER>::step<stages>(    \
       const vector_type &,                                                     \
-      std::array<std::reference_wrapper<const vector_type>, stages>,           \
+      std::array<std::reference_wrapper<const stage_vector_type>, stages>,     \
       std::array<std::reference_wrapper<const precomputed_vector_type>,        \
                  stages>,                                                      \
       const std::array<NUMBER, stages>,                                        \
       vector_type &,                                                           \
       precomputed_vector_type &,                                               \
-      NUMBER) const
+      NUMBER,                                                                  \
+      const vector_type *,                                                     \
+      const NUMBER) const
 
 namespace ryujin
 {
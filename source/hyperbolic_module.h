@@ -8,17 +8,28 @@
 #include <compile_time_options.h>
 
 #include "convenience_macros.h"
+#include "fixed_point.h"
+#include "ghost_compression.h"
+#include "hardware_counters.h"
 #include "initial_values.h"
 #include "offline_data.h"
 #include "simd.h"
 #include "sparse_matrix_simd.h"
+#include "step_profiler.h"
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/timer.h>
 #include <deal.II/lac/sparse_matrix.templates.h>
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
 
 namespace ryujin
 {
@@ -69,6 +80,25 @@ namespace ryujin
    *
    * This module is described in detail in @cite ryujin-2021-1, Alg. 1.
    *
+   * <h3>Communication</h3>
+   *
+   * Every call to step() exchanges the ghost values of the precomputed
+   * values, alpha_i, r_i, the ghost rows of l_ij (once per limiter
+   * pass), and finally the new state U in apply_boundary_conditions().
+   * All exchanges but the last one are overlapped with the computation
+   * on interior rows (see SynchronizationDispatch) and can be sent with
+   * reduced precision (see the "ghost compression" parameters).
+   *
+   * A communication-avoiding variant that redundantly computes a wider
+   * halo and exchanges only U would require (a) a second ghost layer in
+   * OfflineData, (b) SparsityPatternSIMD rows and all offline matrices
+   * for ghost degrees of freedom, and (c) the limiter bounds and the
+   * l_ij rows of the first ghost layer, whose stencil in turn consists
+   * of the second layer. Because all low-order quantities of a row
+   * depend on the wave speeds d_ij of the full stencil, the halo would
+   * have to grow by one layer per quantity that is currently exchanged,
+   * i.e., by four to five layers per stage. This is not implemented.
+   *
    * @ingroup HyperbolicModule
    */
   template <typename Description, int dim, typename Number = double>
@@ -107,11 +137,29 @@ namespace ryujin
      */
     using scalar_type = typename OfflineData<dim, Number>::scalar_type;
 
+    /**
+     * @copydoc OfflineData::symmetric_matrix_type
+     */
+    using symmetric_matrix_type =
+        typename OfflineData<dim, Number>::symmetric_matrix_type;
+
     /**
      * @copydoc HyperbolicSystem::View::vector_type
      */
     using vector_type = typename HyperbolicSystemView::vector_type;
 
+    /**
+     * Typedef for a MultiComponentVector storing the intermediate stages
+     * passed to step(). If the compile-time option MIXED_PRECISION_STAGES
+     * is set the stages are stored in single precision and converted to
+     * Number on the fly.
+     */
+#ifdef MIXED_PRECISION_STAGES
+    using stage_vector_type = MultiComponentVector<float, problem_dimension>;
+#else
+    using stage_vector_type = vector_type;
+#endif
+
     /**
      * @copydoc HyperbolicSystem::n_precomputed_values
      */
@@ -142,6 +190,12 @@ namespace ryujin
     using precomputed_initial_vector_type =
         typename HyperbolicSystemView::precomputed_initial_vector_type;
 
+    /**
+     * @copydoc HyperbolicSystem::n_precomputed_edge_values
+     */
+    static constexpr unsigned int n_precomputed_edge_values =
+        HyperbolicSystemView::n_precomputed_edge_values;
+
 
     /**
      * Constructor.
@@ -161,6 +215,55 @@ namespace ryujin
      */
     void prepare();
 
+    /**
+     * Append the memory consumption (in bytes) of the d_ij, l_ij and
+     * p_ij matrices and of all temporary vectors to @p statistics.
+     */
+    void collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const;
+
+    /**
+     * Print per-thread and per-rank load imbalance statistics of all
+     * thread parallel regions of the step() function to @p output. Does
+     * nothing unless the "profile load imbalance" option is set. This
+     * function has to be called on all ranks.
+     */
+    void print_load_imbalance_statistics(std::ostream &output) const;
+
+    /**
+     * Print hardware counter statistics of all steps and stages of the
+     * step() function to @p output. Does nothing unless the "hardware
+     * counters" option is set. This function has to be called on all
+     * ranks.
+     */
+    void print_hardware_counter_statistics(std::ostream &output) const;
+
+    /**
+     * Print statistics of the solver internals (a histogram of the
+     * limiter coefficients l_ij of the first limiter pass, the number of
+     * low-order bounds violations, restarts and warnings) accumulated by
+     * all calls to step() to @p output. Does nothing unless the "solver
+     * statistics" option is set. This function has to be called on all
+     * ranks.
+     */
+    void print_solver_statistics(std::ostream &output) const;
+
+    /**
+     * Append the (global) solver statistics described in
+     * print_solver_statistics() as (name, value) pairs to @p statistics.
+     * This function is used for the telemetry output of the TimeLoop and
+     * has to be called on all ranks.
+     */
+    void collect_solver_statistics(
+        std::vector<std::pair<std::string, double>> &statistics) const;
+
+    /**
+     * Write the trace of recorded thread parallel regions to the files
+     * "<base_name>-<rank>.json". Does nothing unless the "trace events"
+     * option is set.
+     */
+    void write_trace(const std::string &base_name) const;
+
     /**
      * @name Functons for performing explicit time steps
      */
@@ -217,7 +320,58 @@ namespace ryujin
      *   \sum_{j\in\Ii}\Big(-(\polf(\bUnis)+\polf(\bUnjs)) \cdot\bc_{ij}\Big).
      * \f}
      * where \f$\omega_s\f$ denotes the weigths for the given stages
-     * \f$\bU^{s,n}\f$.
+     * \f$\bU^{s,n}\f$. The stages are of type stage_vector_type, i.e.,
+     * they are stored in single precision if the compile-time option
+     * MIXED_PRECISION_STAGES is set.
+     *
+     * @note If the runtime parameter "fuse low order update" is set and a
+     * nonzero @p tau is supplied then the symmetrization of d_ij and the
+     * computation of the diagonal d_ii are deferred to the low-order
+     * update. In this case the d_ij matrix is only completed row-wise and
+     * not stored in symmetrized form.
+     *
+     * @note If the runtime parameter "wave speed reuse tolerance" is
+     * positive and a nonzero @p tau is supplied then the wave speed
+     * estimates d_ij of the last step with computed step size are reused
+     * for all edges whose states moved less than the given relative
+     * tolerance and are admissible. Reused estimates are inflated by the
+     * factor 1 + "wave speed reuse safety factor" * tolerance. This factor
+     * is a heuristic and not a proven upper bound of the maximal wave
+     * speed of the moved states. The guarantee is instead provided by the
+     * following check: The low-order update of such a step is always
+     * checked for admissibility (independently of CHECK_BOUNDS and the
+     * limiter). If this check or the limiter detects an invariant domain
+     * violation the step is repeated with recomputed wave speed estimates
+     * (and a recomputed indicator if "lagged indicator" is set).
+     * Statistics are only accumulated for the final attempt.
+     *
+     * @note If the runtime parameter "edge based wave speeds" is set, the
+     * wave speed estimates d_ij of the vectorized range are computed by
+     * traversing the batched upper triangular edge list of
+     * SparsityPatternSIMD. Every Riemann solve then contributes an edge
+     * i < j in every lane.
+     *
+     * @note If the runtime parameter "lagged indicator" is set, the
+     * indicator alpha_i is accumulated in the low-order update sweep and
+     * used in the next call to step(). Step 2 then only computes d_ij.
+     * The first step after prepare() computes alpha_i directly.
+     *
+     * @note For the shallow water equations and if the runtime parameter
+     * "skip dry strides" is set, all SIMD strides (or single rows in the
+     * non-vectorized range) for which the states of the complete stencil
+     * vanish in all stages are detected in Step 1. For such a dry stride
+     * the low-order update reduces to the identity and the expensive
+     * parts of Steps 2 - 7 are skipped. The edges of dry strides are not
+     * limited but get the limiter coefficient l_ij = 0.
+     *
+     * @note If a vector @p combination_U is supplied then the final
+     * high-order update writes the convex combination
+     * \f$\alpha\,U^{H}_i + (1-\alpha)\,U^{c}_i\f$ of the updated
+     * state and @p combination_U into @p new_U, where \f$\alpha\f$ is
+     * given by @p combination_weight. This fuses the stage combination of SSP
+     * Runge-Kutta schemes into the step and avoids an additional pass
+     * over the state vectors. If "limiter iterations" is set to zero the
+     * combination is applied to the low-order update instead.
      *
      * @note The routine does not automatically update ghost vectors of the
      * distributed vector @p new_U. It is best to simply call
@@ -227,13 +381,16 @@ namespace ryujin
     template <int stages>
     Number
     step(const vector_type &old_U,
-         std::array<std::reference_wrapper<const vector_type>, stages> stage_U,
+         std::array<std::reference_wrapper<const stage_vector_type>, stages>
+             stage_U,
          std::array<std::reference_wrapper<const precomputed_vector_type>,
                     stages> stage_precomputed,
          const std::array<Number, stages> stage_weights,
          vector_type &new_U,
          precomputed_vector_type &new_precomputed,
-         Number tau = Number(0.)) const;
+         Number tau = Number(0.),
+         const vector_type *combination_U = nullptr,
+         const Number combination_weight = Number(1.)) const;
 
     /**
      * This function postprocesses a given state @p U to conform with all
@@ -245,6 +402,11 @@ namespace ryujin
      * appropriate Riemann invariant is prescribed. See @cite ryujin-2021-3
      * for details.
      *
+     * The boundary degrees of freedom are processed in parallel. Dirichlet
+     * data is evaluated for all Dirichlet and dynamic boundary degrees of
+     * freedom at once (see InitialValues::initial_states()) and is only
+     * computed once if the initial state is time-independent.
+     *
      * @note The routine does update ghost vectors of the distributed
      * vector @p U
      */
@@ -303,6 +465,139 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(n_warnings)
 
+    /**
+     * The accumulated number of locally owned edges for which the first
+     * limiter pass of the step() function returned a limiter coefficient
+     * l_ij < 1.
+     */
+    ACCESSOR_READ_ONLY(n_limited_edges)
+
+    /**
+     * An analytic estimate of the accumulated memory traffic (in bytes)
+     * of the steps performed by step(). The map is indexed by the prefix
+     * "time step [H] N" of the corresponding computing timer and is only
+     * populated if the "traffic model" option is set.
+     */
+    ACCESSOR_READ_ONLY(data_traffic)
+
+    /**
+     * Reset the memory traffic estimate reported by data_traffic().
+     */
+    void reset_data_traffic() const
+    {
+      data_traffic_.clear();
+    }
+
+    /**
+     * The number of floating point operations of the steps performed by
+     * step() measured by this rank. The map uses the same keys as
+     * data_traffic() and is only populated if the "hardware counters"
+     * option is set and floating point events are configured.
+     */
+    std::map<std::string, double> floating_point_operations() const
+    {
+      std::map<std::string, double> result;
+      for (const auto &[name, flops] :
+           hardware_counters_.floating_point_operations())
+        if (name.rfind("[H] ", 0) == 0)
+          result["time step " + name] = flops;
+      return result;
+    }
+
+    /**
+     * Clear all data recorded by the hardware counters.
+     */
+    void reset_hardware_counters() const
+    {
+      hardware_counters_.clear();
+    }
+
+    /**
+     * The accumulated number of locally owned edges processed by the
+     * first limiter pass of the step() function.
+     */
+    ACCESSOR_READ_ONLY(n_edges)
+
+    /**
+     * The minimal ratio tau_max / tau over all invocations of step() with
+     * a prescribed time-step size tau since the last call to
+     * reset_tau_ratio(). Here, tau_max is the (global) CFL bound computed
+     * by the respective step() call. A value less than one indicates that
+     * a later stage of a Runge-Kutta scheme was performed with a
+     * time-step size exceeding its own CFL bound.
+     */
+    ACCESSOR_READ_ONLY(tau_ratio)
+
+    /**
+     * Reset the ratio reported by tau_ratio().
+     */
+    void reset_tau_ratio() const
+    {
+      tau_ratio_ = std::numeric_limits<Number>::max();
+    }
+
+    /**
+     * Set an upper bound for the time-step size of steps with a computed
+     * (i.e., not prescribed) time-step size. This is used for landing
+     * exactly on given points in time. Set to
+     * std::numeric_limits<Number>::max() to remove the bound.
+     */
+    void tau_limit(Number new_tau_limit) const
+    {
+      Assert(new_tau_limit > Number(0.), dealii::ExcInternalError());
+      tau_limit_ = new_tau_limit;
+    }
+
+    /**
+     * Invalidate the wave speeds kept for "wave speed reuse tolerance"
+     * and the indicator kept for "lagged indicator" so that the next
+     * step does not depend on the trajectory computed so far. This is
+     * used for switching between ensemble members, see TimeLoop.
+     */
+    void reset_history() const
+    {
+      reference_valid_ = false;
+      lagged_alpha_valid_ = false;
+    }
+
+    /**
+     * Return true if the module is configured to carry information over
+     * from one time step to the next, see reset_history().
+     */
+    bool keeps_history() const
+    {
+      return wave_speed_reuse_tolerance_ > Number(0.) || lagged_indicator_;
+    }
+
+    /**
+     * Restart the numbering of the per-stage hardware counter regions of
+     * step(), see the "hardware counters" option. This is called by the
+     * TimeIntegrator prior to every (repeated) time step.
+     */
+    void reset_hardware_counter_stages() const
+    {
+      hardware_counters_.reset_stages();
+    }
+
+    /**
+     * Group all locally owned and unconstrained degrees of freedom into
+     * local time-step levels. A degree of freedom with local admissible
+     * step size \f$\tau_i = \text{cfl}\,m_i/(2|d_{ii}|)\f$ belongs to
+     * level \f$k\f$ if \f$2^k\tau_{\min}\le\tau_i<2^{k+1}\tau_{\min}\f$,
+     * where \f$\tau_{\min}\f$ is the global minimum. All degrees of
+     * freedom above level @p n_levels - 1 are collected in the last
+     * level. Boundary degrees of freedom are only taken into account if
+     * "cfl with boundary dofs" is set. Degrees of freedom with a
+     * vanishing diagonal d_ii impose no step size restriction and are not
+     * counted.
+     *
+     * The function returns the global number of degrees of freedom per
+     * level and must be called on all ranks. It uses the diagonal d_ii
+     * stored by the last call to step() and is meant for estimating the
+     * potential of a multirate time-stepping scheme on graded meshes.
+     */
+    std::vector<double> local_time_step_levels(unsigned int n_levels) const;
+
     // FIXME: refactor to function
     mutable bool precompute_only_;
 
@@ -318,12 +613,52 @@ namespace ryujin
     Number indicator_evc_factor_;
 
     unsigned int limiter_iter_;
+    Number limiter_adaptive_threshold_;
     Number limiter_newton_tolerance_;
     unsigned int limiter_newton_max_iter_;
     Number limiter_relaxation_factor_;
 
     bool cfl_with_boundary_dofs_;
 
+    bool fuse_low_order_update_;
+
+    Number wave_speed_reuse_tolerance_;
+    Number wave_speed_reuse_safety_factor_;
+
+    bool edge_based_wave_speeds_;
+
+    bool lagged_indicator_;
+
+    bool lumped_high_order_;
+
+    unsigned int flux_cache_size_;
+
+    bool precompute_edge_values_;
+
+    bool redundant_ghost_precomputation_;
+
+    bool skip_dry_strides_;
+
+    unsigned int dynamic_scheduling_chunk_size_;
+    bool overlap_scalar_loop_;
+
+    bool profile_load_imbalance_;
+    unsigned int trace_events_;
+
+    bool hardware_counters_enabled_;
+    std::vector<std::string> hardware_counter_fp_events_;
+
+    bool shared_memory_ghost_exchange_;
+    bool transposed_ghost_exchange_lij_;
+
+    GhostCompression ghost_compression_lij_;
+    GhostCompression ghost_compression_alpha_;
+    GhostCompression ghost_compression_precomputed_;
+
+    bool traffic_model_;
+
+    bool solver_statistics_;
+
     //@}
 
     //@}
@@ -342,25 +677,150 @@ namespace ryujin
 
     mutable Number cfl_;
 
+    unsigned int chunk_size_;
+
     mutable unsigned int n_restarts_;
 
     mutable unsigned int n_warnings_;
 
+    mutable unsigned long long n_limited_edges_;
+
+    mutable unsigned long long n_edges_;
+
+    /*
+     * Solver statistics, see "solver statistics": the number of edges of
+     * the first limiter pass with l_ij = 0, 0 < l_ij < 1/2,
+     * 1/2 <= l_ij < 1, and l_ij = 1, and the number of (SIMD) rows for
+     * which the low-order update violated the limiter bounds:
+     */
+    mutable std::array<unsigned long long, 4> limiter_histogram_;
+    mutable unsigned long long n_bounds_violations_;
+
+    mutable Number tau_ratio_;
+    mutable Number tau_limit_;
+
+    mutable StepProfiler step_profiler_;
+
+    mutable HardwareCounters hardware_counters_;
+
+    /* Cached computing timers and names of all steps, see step(): */
+    struct StepTimer {
+      dealii::Timer *timer = nullptr;
+      std::string label;
+      std::string name;
+      std::string region_name;
+      std::string traffic_name;
+      std::string likwid_name;
+    };
+    mutable std::deque<StepTimer> step_timers_;
+
+    std::size_t n_owned_entries_;
+
+    mutable std::map<std::string, double> data_traffic_;
+
     precomputed_initial_vector_type precomputed_initial_;
 
+    /*
+     * Time-independent edge values computed from the precomputed initial
+     * values in prepare(). Only used if n_precomputed_edge_values > 0 and
+     * "precompute edge values" is set:
+     */
+    SparseMatrixSIMD<Number, std::max(1u, n_precomputed_edge_values)>
+        precomputed_edge_;
+
     mutable scalar_type alpha_;
+    mutable CompressedGhostExchange<Number> alpha_exchange_;
+    mutable CompressedGhostExchange<Number> precomputed_exchange_;
 
     static constexpr auto n_bounds =
         Description::template Limiter<dim, Number>::n_bounds;
-    mutable MultiComponentVector<Number, n_bounds> bounds_;
+
+    /*
+     * If the compile-time option MIXED_PRECISION_BOUNDS is set we store
+     * the limiter bounds in single precision. The bounds are rounded
+     * toward their admissible side (see Limiter::bounds_rounding) and are
+     * converted to Number on the fly.
+     */
+#ifdef MIXED_PRECISION_BOUNDS
+    using bounds_number_type = float;
+#else
+    using bounds_number_type = Number;
+#endif
+    mutable MultiComponentVector<bounds_number_type, n_bounds> bounds_;
 
     mutable vector_type r_;
 
-    mutable SparseMatrixSIMD<Number> dij_matrix_;
-    mutable SparseMatrixSIMD<Number> lij_matrix_;
-    mutable SparseMatrixSIMD<Number> lij_matrix_next_;
+    mutable symmetric_matrix_type dij_matrix_;
+    /*
+     * If the compile-time option FIXED_POINT_LIMITER_COEFFICIENTS is set
+     * we store the limiter coefficients l_ij as 16 bit fixed-point
+     * numbers (rounded down) and convert them to Number on the fly.
+     */
+#ifdef FIXED_POINT_LIMITER_COEFFICIENTS
+    using lij_number_type = FixedPoint16;
+#else
+    using lij_number_type = Number;
+#endif
+    mutable SparseMatrixSIMD<lij_number_type,
+                             1,
+                             dealii::VectorizedArray<Number>::size()>
+        lij_matrix_;
     mutable SparseMatrixSIMD<Number, problem_dimension> pij_matrix_;
 
+    /*
+     * Communication channels (offsets of the MPI tags) of all ghost
+     * exchanges. The channels below first_step_channel are reserved for
+     * exchanges with a fixed communication pattern that are set up once
+     * in prepare(): lij_persistent_channel for the persistent (or shared
+     * memory) ghost row exchange of the l_ij matrix, and channel 9 for
+     * future use. All other exchanges in step() obtain their channel from
+     * a counter starting at first_step_channel.
+     */
+    static constexpr unsigned int lij_persistent_channel = 8;
+    static constexpr unsigned int first_step_channel = 10;
+
+    mutable bool reference_valid_;
+    mutable vector_type reference_U_;
+    mutable symmetric_matrix_type reference_dij_matrix_;
+
+    /*
+     * The indicator alpha_i accumulated in Step 4 for the next stage,
+     * see "lagged indicator":
+     */
+    mutable scalar_type lagged_alpha_;
+    mutable bool lagged_alpha_valid_;
+
+    /*
+     * A mask with one entry per SIMD stride (followed by one entry per
+     * row of the non-vectorized range) that is set to one if the stencil
+     * of the stride is dry, see "skip dry strides":
+     */
+    mutable std::vector<std::uint8_t> dry_strides_;
+
+    /*
+     * The flux contributions f(U_i) of the old state and the states of
+     * previous stages, see "flux cache size". A flux tensor is stored
+     * flattened into problem_dimension * dim components. The cache is
+     * only available for hyperbolic systems whose flux contribution is
+     * the flux tensor itself:
+     */
+    static constexpr bool have_flux_cache = std::is_same_v<
+        typename HyperbolicSystemView::flux_contribution_type,
+        flux_type>;
+    using flux_cache_type =
+        MultiComponentVector<Number, problem_dimension * dim>;
+    mutable std::vector<flux_cache_type> flux_cache_;
+
+    /*
+     * Batched Dirichlet data, see apply_boundary_conditions(): For every
+     * entry of the boundary table the index into dirichlet_points_ and
+     * dirichlet_data_ (or numbers::invalid_unsigned_int):
+     */
+    std::vector<unsigned int> dirichlet_index_;
+    std::vector<dealii::Point<dim>> dirichlet_points_;
+    mutable std::vector<state_type> dirichlet_data_;
+    mutable bool dirichlet_data_valid_;
+
     //@}
   };
 
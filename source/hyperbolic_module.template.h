@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "compensated_sum.h"
 #include "hyperbolic_module.h"
 #include "introspection.h"
 #include "openmp.h"
@@ -13,15 +14,14 @@
 
 #include "sparse_matrix_simd.template.h"
 
+#include <deal.II/base/array_view.h>
+
+#include <array>
 #include <atomic>
+#include <iomanip>
 
 namespace ryujin
 {
-  namespace ShallowWater
-  {
-    struct Description;
-  }
-
   using namespace dealii;
 
   template <typename Description, int dim, typename Number>
@@ -43,6 +43,15 @@ namespace ryujin
       , cfl_(0.2)
       , n_restarts_(0)
       , n_warnings_(0)
+      , n_limited_edges_(0)
+      , n_edges_(0)
+      , limiter_histogram_{{0, 0, 0, 0}}
+      , n_bounds_violations_(0)
+      , tau_ratio_(std::numeric_limits<Number>::max())
+      , tau_limit_(std::numeric_limits<Number>::max())
+      , reference_valid_(false)
+      , lagged_alpha_valid_(false)
+      , dirichlet_data_valid_(false)
   {
     indicator_evc_factor_ = Number(1.);
     add_parameter("indicator evc factor",
@@ -53,6 +62,15 @@ namespace ryujin
     add_parameter(
         "limiter iterations", limiter_iter_, "Number of limiter iterations");
 
+    limiter_adaptive_threshold_ = Number(0.);
+    add_parameter("limiter adaptive threshold",
+                  limiter_adaptive_threshold_,
+                  "If set to a positive value, the second limiter iteration "
+                  "is skipped whenever the (global) fraction of edges with "
+                  "l_ij < 1 in the first limiter pass is below this "
+                  "threshold. A value of 0 always performs all limiter "
+                  "iterations");
+
     if constexpr (std::is_same<Number, double>::value)
       limiter_newton_tolerance_ = 1.e-10;
     else
@@ -78,6 +96,215 @@ namespace ryujin
                   cfl_with_boundary_dofs_,
                   "Use also the local wave-speed estimate d_ij of boundary "
                   "dofs when computing the maximal admissible step size");
+
+    fuse_low_order_update_ = false;
+    add_parameter(
+        "fuse low order update",
+        fuse_low_order_update_,
+        "Fuse the symmetrization of d_ij and the computation of d_ii into "
+        "the low-order update sweep. This avoids a full pass over the d_ij "
+        "matrix but is only possible for stages with a prescribed step "
+        "size tau");
+
+    wave_speed_reuse_tolerance_ = Number(0.);
+    add_parameter(
+        "wave speed reuse tolerance",
+        wave_speed_reuse_tolerance_,
+        "Relative tolerance for reusing the wave speed estimates d_ij of the "
+        "last step with computed step size in stages with prescribed step "
+        "size tau. An estimate is reused if the states U_i and U_j moved "
+        "less than the tolerance. Set to 0 to always recompute d_ij");
+
+    wave_speed_reuse_safety_factor_ = Number(2.);
+    add_parameter(
+        "wave speed reuse safety factor",
+        wave_speed_reuse_safety_factor_,
+        "A reused wave speed estimate d_ij is inflated by the factor 1 + "
+        "safety factor * wave speed reuse tolerance. This is a heuristic "
+        "margin for the moved states; steps that nevertheless violate the "
+        "invariant domain are repeated with recomputed estimates");
+
+    edge_based_wave_speeds_ = false;
+    add_parameter(
+        "edge based wave speeds",
+        edge_based_wave_speeds_,
+        "Compute the wave speed estimates d_ij of the vectorized range by "
+        "traversing batches of upper triangular edges i < j instead of "
+        "complete SIMD rows. This avoids Riemann solves for lanes below the "
+        "diagonal at the cost of gathering c_ij and U_j");
+
+    lagged_indicator_ = false;
+    add_parameter(
+        "lagged indicator",
+        lagged_indicator_,
+        "Accumulate the indicator alpha_i in the low-order update sweep "
+        "(Step 4) and use it with a lag of one stage instead of computing "
+        "it in a separate pass over the stencil in Step 2");
+
+    lumped_high_order_ = false;
+    add_parameter(
+        "lumped high order",
+        lumped_high_order_,
+        "Use the lumped mass matrix instead of the consistent mass matrix "
+        "for the high-order update. This skips the consistent mass matrix "
+        "correction of the antidiffusive fluxes p_ij and thus avoids "
+        "reading the mass matrix m_ij for every edge in Steps 4 and 5 at "
+        "the cost of a larger dispersive error of the high-order method");
+
+    flux_cache_size_ = 0;
+    add_parameter(
+        "flux cache size",
+        flux_cache_size_,
+        "Number of states (the old state, followed by the states of the "
+        "previous stages) whose flux contributions f(U_j) are computed once "
+        "per degree of freedom in Step 1 and loaded in the low-order and "
+        "high-order flux computations of Step 4, instead of being "
+        "recomputed for every edge. Every cached state costs "
+        "problem_dimension * dim numbers per degree of freedom. Set to 0 "
+        "to disable. Not available for the shallow water equations");
+
+    precompute_edge_values_ = false;
+    add_parameter(
+        "precompute edge values",
+        precompute_edge_values_,
+        "Hyperbolic systems with time-independent edge values (shallow "
+        "water) only: evaluate these values once for every edge in "
+        "prepare() and stream them per edge in Step 4 instead of gathering "
+        "the precomputed initial values of the neighbor. This costs "
+        "n_precomputed_edge_values numbers per matrix entry and only pays "
+        "off if the edge values require more than a simple copy");
+
+    redundant_ghost_precomputation_ = false;
+    add_parameter(
+        "redundant ghost precomputation",
+        redundant_ghost_precomputation_,
+        "Hyperbolic systems with more than one precomputation cycle "
+        "(euler_aeos) only: compute all but the last precomputation cycle "
+        "redundantly for ghost indices instead of exchanging their ghost "
+        "values. This removes one ghost exchange (and synchronization "
+        "point) per cycle at the cost of evaluating the equation of state "
+        "for the ghost layer");
+
+    skip_dry_strides_ = false;
+    add_parameter(
+        "skip dry strides",
+        skip_dry_strides_,
+        "Shallow water only: skip the expensive parts of the time step for "
+        "all SIMD strides whose stencil states vanish in all stages (dry "
+        "land). The edges of such strides are not limited");
+
+    dynamic_scheduling_chunk_size_ = 0;
+    add_parameter(
+        "dynamic scheduling chunk size",
+        dynamic_scheduling_chunk_size_,
+        "Approximate number of matrix entries per chunk of rows that is "
+        "handed out dynamically to worker threads in the row loops of a "
+        "time step. Set to 0 for a static distribution of rows");
+
+    overlap_scalar_loop_ = false;
+    add_parameter(
+        "overlap scalar loop",
+        overlap_scalar_loop_,
+        "Omit the thread synchronization barrier between the (short) "
+        "non-vectorized loop over the tail of the locally owned rows and "
+        "the vectorized loop in Steps 2, 4, 5, and 6. Threads that "
+        "finished their share of the tail immediately continue with the "
+        "vectorized rows. This is most effective in combination with a "
+        "dynamic scheduling chunk size");
+
+    profile_load_imbalance_ = false;
+    add_parameter("profile load imbalance",
+                  profile_load_imbalance_,
+                  "Record per-thread compute times, barrier waits and MPI "
+                  "synchronization waits of all thread parallel regions of "
+                  "a time step and report the resulting load imbalance "
+                  "across threads and ranks");
+
+    trace_events_ = 0;
+    add_parameter("trace events",
+                  trace_events_,
+                  "Record the last n executions of all thread parallel "
+                  "regions of a time step (per thread) in a ring buffer and "
+                  "write them in the Chrome trace format at the end of the "
+                  "run. Set to 0 to disable");
+
+    hardware_counters_enabled_ = false;
+    add_parameter(
+        "hardware counters",
+        hardware_counters_enabled_,
+        "Collect hardware performance counters (cycles, instructions, last "
+        "level cache references and misses) of all steps and stages of a "
+        "time step via the Linux perf_event interface and report IPC, "
+        "cache miss ratio and estimated memory bandwidth. Only user space "
+        "events of the OpenMP threads are counted, no MSR access is "
+        "required");
+
+    add_parameter(
+        "hardware counter fp events",
+        hardware_counter_fp_events_,
+        "List of raw floating point events \"<code>:<flops per event>\" "
+        "collected in addition if the hardware counters are enabled, used "
+        "for the GFLOP/s and the vectorization ratio. Example for Intel "
+        "FP_ARITH_INST_RETIRED (double precision): 0x01c7:1, 0x04c7:2, "
+        "0x10c7:4, 0x40c7:8");
+
+    shared_memory_ghost_exchange_ = false;
+    add_parameter(
+        "shared memory ghost exchange",
+        shared_memory_ghost_exchange_,
+        "Exchange the ghost rows of the l_ij matrix between ranks on the "
+        "same node through an MPI-3 shared memory window instead of MPI "
+        "messages. Only ranks on other nodes are served with messages");
+
+    transposed_ghost_exchange_lij_ = false;
+    add_parameter(
+        "ghost exchange l_ij transposed only",
+        transposed_ghost_exchange_lij_,
+        "Only send the transposed entries l_ji of the ghost rows of the "
+        "l_ij matrix that are consumed by the receiving rank and skip the "
+        "diagonal entries of the ghost rows");
+
+    ghost_compression_lij_ = GhostCompression::none;
+    add_parameter(
+        "ghost compression l_ij",
+        ghost_compression_lij_,
+        "Precision of the ghost row exchange of the limiter coefficients "
+        "l_ij: none, single, bfloat16. Values are rounded toward zero, i.e, "
+        "toward more limiting");
+
+    ghost_compression_alpha_ = GhostCompression::none;
+    add_parameter(
+        "ghost compression alpha",
+        ghost_compression_alpha_,
+        "Precision of the ghost exchange of the indicator alpha_i: none, "
+        "single, bfloat16. Values are rounded toward positive infinity, "
+        "i.e., toward more high-order viscosity");
+
+    ghost_compression_precomputed_ = GhostCompression::none;
+    add_parameter(
+        "ghost compression precomputed",
+        ghost_compression_precomputed_,
+        "Precision of the ghost exchange of precomputed values: none, "
+        "single, bfloat16. Values are rounded toward negative infinity. "
+        "Only use this if all precomputed values are consumed as lower "
+        "bounds or in the indicator. Rejected if the wave speed estimate "
+        "uses precomputed values");
+
+    traffic_model_ = false;
+    add_parameter("traffic model",
+                  traffic_model_,
+                  "Accumulate an analytic estimate of the memory traffic of "
+                  "every step of the time step and report the achieved "
+                  "bandwidth alongside the timer statistics");
+
+    solver_statistics_ = false;
+    add_parameter("solver statistics",
+                  solver_statistics_,
+                  "Collect statistics of the solver internals: a histogram "
+                  "of the limiter coefficients l_ij of the first limiter "
+                  "pass and the number of low-order bounds violations. The "
+                  "statistics are reported with the cycle statistics and in "
+                  "the telemetry stream");
   }
 
 
@@ -93,6 +320,13 @@ namespace ryujin
                 dealii::ExcMessage(
                     "The number of limiter iterations must be between [0,2]"));
 
+    step_timers_.clear();
+    step_profiler_.clear();
+    step_profiler_.enable(profile_load_imbalance_);
+    step_profiler_.enable_trace(trace_events_);
+    hardware_counters_.reinit(hardware_counters_enabled_,
+                              hardware_counter_fp_events_);
+
     /* Initialize vectors: */
 
     const auto &scalar_partitioner = offline_data_->scalar_partitioner();
@@ -100,6 +334,20 @@ namespace ryujin
     alpha_.reinit(scalar_partitioner);
     bounds_.reinit_with_scalar_partitioner(scalar_partitioner);
 
+    if constexpr (have_flux_cache) {
+      flux_cache_.resize(flux_cache_size_);
+      for (auto &it : flux_cache_)
+        it.reinit_with_scalar_partitioner(scalar_partitioner);
+    } else {
+      AssertThrow(flux_cache_size_ == 0,
+                  dealii::ExcMessage("The flux cache is not available for "
+                                     "the chosen hyperbolic system"));
+    }
+
+    AssertThrow(n_precomputed_edge_values > 0 || !precompute_edge_values_,
+                dealii::ExcMessage("The chosen hyperbolic system does not "
+                                   "provide precomputed edge values"));
+
     const auto &vector_partitioner = offline_data_->vector_partitioner();
     r_.reinit(vector_partitioner);
     using View = typename HyperbolicSystem::template View<dim, Number>;
@@ -109,16 +357,307 @@ namespace ryujin
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
     dij_matrix_.reinit(sparsity_simd);
     lij_matrix_.reinit(sparsity_simd);
-    lij_matrix_next_.reinit(sparsity_simd);
     pij_matrix_.reinit(sparsity_simd);
 
+    /*
+     * The ghost row exchange of the l_ij matrix happens in every stage
+     * with a fixed communication pattern. Set up persistent MPI requests
+     * (or the intra-node shared memory exchange) once on the reserved
+     * lij_persistent_channel that is not handed out by the channel
+     * counter in step(). Reduced precision ghost rows always use regular
+     * (non-persistent) requests:
+     */
+    lij_matrix_.set_transposed_ghost_exchange(transposed_ghost_exchange_lij_);
+    lij_matrix_.set_ghost_compression(ghost_compression_lij_, -1);
+    if (ghost_compression_lij_ == GhostCompression::none) {
+      if (shared_memory_ghost_exchange_)
+        lij_matrix_.initialize_shared_memory_ghost_rows(
+            lij_persistent_channel);
+      else
+        lij_matrix_.initialize_persistent_ghost_rows(lij_persistent_channel);
+    }
+
+    alpha_exchange_.reinit(ghost_compression_alpha_, 1);
+
+    /*
+     * Precomputed values are rounded toward negative infinity. This is
+     * not conservative for values that enter the wave speed estimate:
+     */
+    AssertThrow(ghost_compression_precomputed_ == GhostCompression::none ||
+                    !View::wave_speed_uses_precomputed_values,
+                dealii::ExcMessage(
+                    "The approximate Riemann solver of the chosen hyperbolic "
+                    "system uses precomputed values. \"ghost compression "
+                    "precomputed\" must be set to none."));
+    precomputed_exchange_.reinit(ghost_compression_precomputed_, -1);
+
+    /*
+     * Translate the chunk size given in matrix entries into a number of
+     * loop iterations (of SIMD width) by using the average row length:
+     */
+    chunk_size_ = 0;
+    if (dynamic_scheduling_chunk_size_ != 0) {
+      constexpr auto simd_length = VectorizedArray<Number>::size();
+      const auto average_row_length =
+          std::max<std::size_t>(1,
+                                sparsity_simd.n_nonzero_elements() /
+                                    std::max(1u, sparsity_simd.n_rows()));
+      chunk_size_ = std::max<std::size_t>(
+          1,
+          dynamic_scheduling_chunk_size_ / (simd_length * average_row_length));
+    }
+
+    if (skip_dry_strides_) {
+      constexpr auto simd_length = VectorizedArray<Number>::size();
+      const unsigned int n_internal = offline_data_->n_locally_internal();
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      dry_strides_.assign(n_internal / simd_length + n_owned - n_internal, 0);
+    }
+
+    /*
+     * Collect the positions of all boundary descriptions that need
+     * Dirichlet data for a batched evaluation in
+     * apply_boundary_conditions():
+     */
+    const auto &boundary_table = offline_data_->boundary_table();
+    dirichlet_index_.assign(boundary_table.size(),
+                            numbers::invalid_unsigned_int);
+    dirichlet_points_.clear();
+    for (unsigned int k = 0; k < boundary_table.size(); ++k) {
+      const auto id = boundary_table.id[k];
+      if (id == Boundary::dirichlet || id == Boundary::dynamic) {
+        dirichlet_index_[k] = dirichlet_points_.size();
+        dirichlet_points_.push_back(boundary_table.position[k]);
+      }
+    }
+    dirichlet_data_valid_ = false;
+
+    /* Time-independent Dirichlet data is computed once and for all: */
+    if (!dirichlet_points_.empty() && !initial_values_->time_dependent()) {
+      initial_values_->initial_states(
+          dirichlet_points_, Number(0.), dirichlet_data_);
+      dirichlet_data_valid_ = true;
+    }
+
+    /* The number of (padded) matrix entries of locally owned rows: */
+    n_owned_entries_ = 0;
+    for (unsigned int i = 0; i < offline_data_->n_locally_owned(); ++i)
+      n_owned_entries_ += sparsity_simd.row_length(i);
+
+    lagged_alpha_valid_ = false;
+    if (lagged_indicator_)
+      lagged_alpha_.reinit(scalar_partitioner);
+
+    reference_valid_ = false;
+    if (wave_speed_reuse_tolerance_ > Number(0.)) {
+      reference_U_.reinit(vector_partitioner);
+      reference_dij_matrix_.reinit(sparsity_simd);
+    }
+
     precomputed_initial_ =
         initial_values_->interpolate_precomputed_initial_values();
+
+    /*
+     * Compute all time-independent edge values of the locally owned rows
+     * once and for all:
+     */
+    if constexpr (n_precomputed_edge_values > 0) {
+      if (precompute_edge_values_) {
+        precomputed_edge_.reinit(sparsity_simd);
+
+        const unsigned int n_internal = offline_data_->n_locally_internal();
+        const unsigned int n_owned = offline_data_->n_locally_owned();
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+
+        auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+          using T = decltype(sentinel);
+          unsigned int stride_size = get_stride_size<T>;
+
+          const auto view = hyperbolic_system_->template view<dim, T>();
+          std::vector<unsigned int> column_buffer(
+              sparsity_simd.column_buffer_size());
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = left; i < right; i += stride_size) {
+            const unsigned int row_length = sparsity_simd.row_length(i);
+            const unsigned int *js =
+                sparsity_simd.columns(i, column_buffer.data());
+            for (unsigned int col_idx = 0; col_idx < row_length;
+                 ++col_idx, js += stride_size)
+              precomputed_edge_.write_tensor(
+                  view.precomputed_edge_values(precomputed_initial_, i, js),
+                  i,
+                  col_idx);
+          }
+        };
+
+        /* Parallel non-vectorized loop: */
+        loop(Number(), n_internal, n_owned);
+        /* Parallel vectorized SIMD loop: */
+        loop(VectorizedArray<Number>(), 0, n_internal);
+
+        RYUJIN_PARALLEL_REGION_END
+      }
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::collect_memory_statistics(
+      std::vector<std::pair<std::string, std::size_t>> &statistics) const
+  {
+    statistics.push_back({"HyperbolicModule: dij matrix",
+                          dij_matrix_.memory_consumption() +
+                              reference_dij_matrix_.memory_consumption()});
+    statistics.push_back(
+        {"HyperbolicModule: lij matrix", lij_matrix_.memory_consumption()});
+    statistics.push_back(
+        {"HyperbolicModule: pij matrix", pij_matrix_.memory_consumption()});
+    if (n_precomputed_edge_values > 0 && precompute_edge_values_)
+      statistics.push_back({"HyperbolicModule: precomputed edge values",
+                            precomputed_edge_.memory_consumption()});
+
+    statistics.push_back({"HyperbolicModule: vectors",
+                          precomputed_initial_.memory_consumption() +
+                              alpha_.memory_consumption() +
+                              lagged_alpha_.memory_consumption() +
+                              bounds_.memory_consumption() +
+                              r_.memory_consumption() +
+                              reference_U_.memory_consumption()});
+
+    if (!flux_cache_.empty()) {
+      std::size_t flux_cache = 0;
+      for (const auto &it : flux_cache_)
+        flux_cache += it.memory_consumption();
+      statistics.push_back({"HyperbolicModule: flux cache", flux_cache});
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::
+      print_load_imbalance_statistics(std::ostream &output) const
+  {
+    step_profiler_.print_statistics(output, mpi_communicator_);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::print_solver_statistics(
+      std::ostream &output) const
+  {
+    if (!solver_statistics_)
+      return;
+
+    std::vector<std::pair<std::string, double>> statistics;
+    collect_solver_statistics(statistics);
+
+    if (Utilities::MPI::this_mpi_process(mpi_communicator_) != 0)
+      return;
+
+    const auto value = [&](const unsigned int k) {
+      return statistics[k].second;
+    };
+    const double n_edges = value(0) + value(1) + value(2) + value(3);
+    const auto percent = [&](const unsigned int k) {
+      return n_edges > 0. ? 100. * value(k) / n_edges : 0.;
+    };
+
+    output << "\nSolver statistics (HYP):\n"
+           << std::fixed << std::setprecision(2)
+           << "  l_ij (first pass)  [0: " << std::setw(6) << percent(0)
+           << "%] [(0,.5): " << std::setw(6) << percent(1)
+           << "%] [[.5,1): " << std::setw(6) << percent(2)
+           << "%] [1: " << std::setw(6) << percent(3) << "%]\n"
+           << std::setprecision(0)
+           << "  low-order bounds violations: " << value(4)
+           << "  restarts: " << value(5) << "  warnings: " << value(6)
+           << "\n";
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::collect_solver_statistics(
+      std::vector<std::pair<std::string, double>> &statistics) const
+  {
+    if (!solver_statistics_)
+      return;
+
+    /* Reduce all counters with a single collective operation: */
+    const std::array<double, 7> local_values{
+        {double(limiter_histogram_[0]),
+         double(limiter_histogram_[1]),
+         double(limiter_histogram_[2]),
+         double(limiter_histogram_[3]),
+         double(n_bounds_violations_),
+         double(n_restarts_),
+         double(n_warnings_)}};
+    std::array<double, 7> values;
+    Utilities::MPI::sum(ArrayView<const double>(local_values),
+                        mpi_communicator_,
+                        ArrayView<double>(values));
+
+    statistics.push_back({"limiter_lij_zero", values[0]});
+    statistics.push_back({"limiter_lij_below_half", values[1]});
+    statistics.push_back({"limiter_lij_below_one", values[2]});
+    statistics.push_back({"limiter_lij_one", values[3]});
+    statistics.push_back({"low_order_bounds_violations", values[4]});
+    statistics.push_back({"hyperbolic_restarts_global", values[5]});
+    statistics.push_back({"hyperbolic_warnings_global", values[6]});
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::
+      print_hardware_counter_statistics(std::ostream &output) const
+  {
+    hardware_counters_.print_statistics(output, mpi_communicator_);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void HyperbolicModule<Description, dim, Number>::write_trace(
+      const std::string &base_name) const
+  {
+    step_profiler_.write_trace(base_name, mpi_communicator_);
   }
 
 
   namespace
   {
+    /**
+     * Internally used: flattens a flux tensor into a tensor with
+     * n_comp * dim components for storing it in the flux cache.
+     */
+    template <int n_comp, int dim, typename T>
+    DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_comp * dim, T>
+    pack_flux(const dealii::Tensor<1, n_comp, dealii::Tensor<1, dim, T>> &flux)
+    {
+      dealii::Tensor<1, n_comp * dim, T> result;
+      for (unsigned int k = 0; k < n_comp; ++k)
+        for (unsigned int d = 0; d < dim; ++d)
+          result[k * dim + d] = flux[k][d];
+      return result;
+    }
+
+
+    /**
+     * Internally used: the inverse operation of pack_flux().
+     */
+    template <int n_comp, int dim, typename T>
+    DEAL_II_ALWAYS_INLINE inline dealii::
+        Tensor<1, n_comp, dealii::Tensor<1, dim, T>>
+        unpack_flux(const dealii::Tensor<1, n_comp * dim, T> &packed)
+    {
+      dealii::Tensor<1, n_comp, dealii::Tensor<1, dim, T>> result;
+      for (unsigned int k = 0; k < n_comp; ++k)
+        for (unsigned int d = 0; d < dim; ++d)
+          result[k][d] = packed[k * dim + d];
+      return result;
+    }
+
+
     /**
      * Internally used: returns true if all indices are on the lower
      * triangular part of the matrix.
@@ -145,6 +684,244 @@ namespace ryujin
         return all_below_diagonal;
       }
     }
+
+
+    /**
+     * Internally used: returns true if all indices are on the upper
+     * triangular part of the matrix.
+     */
+    template <typename T>
+    bool all_above_diagonal(unsigned int i, const unsigned int *js)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        const auto j = *js;
+        return j > i;
+
+      } else {
+        /* Vectorized fast access. index must be divisible by simd_length */
+
+        constexpr auto simd_length = T::size();
+
+        bool all_above_diagonal = true;
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (js[k] <= i + k) {
+            all_above_diagonal = false;
+            break;
+          }
+        return all_above_diagonal;
+      }
+    }
+
+
+    /**
+     * Internally used: returns the symmetrized entry of the d_ij matrix,
+     * i.e., the entry @p d_ij computed in row i for all indices j > i
+     * and the transposed entry @p d_ji otherwise.
+     */
+    template <typename T>
+    T symmetrized_entry(const T &d_ij,
+                        const T &d_ji,
+                        unsigned int i,
+                        const unsigned int *js)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        const auto j = *js;
+        return j < i ? d_ji : d_ij;
+
+      } else {
+        /* Vectorized fast access. index must be divisible by simd_length */
+
+        constexpr auto simd_length = T::size();
+
+        T result = d_ij;
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (js[k] < i + k)
+            result[k] = d_ji[k];
+        return result;
+      }
+    }
+
+
+    /**
+     * Internally used: writes the entry @p d_ij into the matrix @p matrix
+     * for all indices j > i. This is used for a matrix with symmetric
+     * storage where the transposed entries for indices j < i are written
+     * by row j.
+     */
+    template <typename T, typename Matrix>
+    void write_upper_triangular_entry(Matrix &matrix,
+                                      const T &d_ij,
+                                      unsigned int i,
+                                      unsigned int col_idx,
+                                      const unsigned int *js)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        const auto j = *js;
+        if (j > i)
+          matrix.write_entry(d_ij, i, col_idx);
+
+      } else {
+        /* Vectorized fast access. index must be divisible by simd_length */
+
+        constexpr auto simd_length = T::size();
+
+        if (all_above_diagonal<T>(i, js)) {
+          matrix.write_entry(d_ij, i, col_idx);
+          return;
+        }
+
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (js[k] > i + k)
+            matrix.write_entry(d_ij[k], i + k, col_idx);
+      }
+    }
+
+
+    /**
+     * Internally used: gathers the tensor-valued entries of the SIMD
+     * stride starting at row @p i from the positions @p positions (one
+     * per lane) of the matrix @p matrix.
+     */
+    template <typename T, typename Matrix>
+    auto gather_tensor(const Matrix &matrix,
+                       unsigned int i,
+                       const unsigned int *positions)
+    {
+      using ScalarNumber = typename get_value_type<T>::type;
+      constexpr auto simd_length = T::size();
+
+      decltype(matrix.template get_tensor<T>(i, 0)) result;
+      for (unsigned int k = 0; k < simd_length; ++k) {
+        const auto entry =
+            matrix.template get_tensor<ScalarNumber>(i + k, positions[k]);
+        for (unsigned int d = 0; d < entry.dimension; ++d)
+          result[d][k] = entry[d];
+      }
+      return result;
+    }
+
+
+    /**
+     * Internally used: gathers the scalar entries of the SIMD stride
+     * starting at row @p i from the positions @p positions (one per lane)
+     * of the matrix @p matrix.
+     */
+    template <typename T, typename Matrix>
+    T gather_entry(const Matrix &matrix,
+                   unsigned int i,
+                   const unsigned int *positions)
+    {
+      using ScalarNumber = typename get_value_type<T>::type;
+      constexpr auto simd_length = T::size();
+
+      T result;
+      for (unsigned int k = 0; k < simd_length; ++k)
+        result[k] =
+            matrix.template get_entry<ScalarNumber>(i + k, positions[k]);
+      return result;
+    }
+
+
+    /**
+     * Internally used: scatters the entry @p d_ij of an edge batch of the
+     * SIMD stride starting at row @p i into the matrix @p matrix. Only
+     * upper triangular entries are written, this skips lanes that are
+     * padded with a lower triangular entry.
+     */
+    template <typename T, typename Matrix>
+    void scatter_upper_triangular_entry(Matrix &matrix,
+                                        const T &d_ij,
+                                        unsigned int i,
+                                        const unsigned int *positions,
+                                        const unsigned int *js)
+    {
+      constexpr auto simd_length = T::size();
+
+      for (unsigned int k = 0; k < simd_length; ++k)
+        if (js[k] > i + k)
+          matrix.write_entry(d_ij[k], i + k, positions[k]);
+    }
+
+
+    /**
+     * Internally used: returns true if the state @p U moved relative to
+     * the reference state @p U_ref by more than the relative @p tolerance
+     * (in any lane).
+     */
+    template <typename T, typename ST>
+    bool state_moved(const ST &U,
+                     const ST &U_ref,
+                     const typename get_value_type<T>::type tolerance)
+    {
+      const T delta = (U - U_ref).norm();
+      const T threshold = tolerance * U_ref.norm();
+
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        return delta > threshold;
+
+      } else {
+        /* Vectorized fast access. */
+
+        constexpr auto simd_length = T::size();
+
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (delta[k] > threshold[k])
+            return true;
+        return false;
+      }
+    }
+
+
+    /**
+     * Internally used: calls @p f with the length of the current row
+     * @p row_length. If the compile-time option FIXED_ROW_LENGTH_KERNELS
+     * is set and Q1 finite elements are used, the dominant row length of
+     * a structured mesh (3^dim) is passed as a std::integral_constant.
+     * This way the compiler can fully unroll the column loops of such
+     * rows. All other rows receive the row length as a runtime value.
+     */
+    template <int dim, typename F>
+    DEAL_II_ALWAYS_INLINE inline void
+    dispatch_row_length(const unsigned int row_length, const F &f)
+    {
+#ifdef FIXED_ROW_LENGTH_KERNELS
+      if constexpr (ORDER_FINITE_ELEMENT == 1) {
+        constexpr unsigned int n = (dim == 1 ? 3 : (dim == 2 ? 9 : 27));
+        if (row_length == n) {
+          f(std::integral_constant<unsigned int, n>());
+          return;
+        }
+      }
+#endif
+      f(row_length);
+    }
+
+
+    /**
+     * Internally used: returns true if @p value vanishes (in all lanes).
+     */
+    template <typename T>
+    bool all_zero(const T &value)
+    {
+      if constexpr (std::is_same_v<T, typename get_value_type<T>::type>) {
+        /* Non-vectorized sequential access. */
+        return value == T(0.);
+
+      } else {
+        /* Vectorized fast access. */
+
+        constexpr auto simd_length = T::size();
+
+        for (unsigned int k = 0; k < simd_length; ++k)
+          if (value[k] != 0.)
+            return false;
+        return true;
+      }
+    }
   } // namespace
 
 
@@ -152,13 +929,16 @@ namespace ryujin
   template <int stages>
   Number HyperbolicModule<Description, dim, Number>::step(
       const vector_type &old_U,
-      std::array<std::reference_wrapper<const vector_type>, stages> stage_U,
+      std::array<std::reference_wrapper<const stage_vector_type>, stages>
+          stage_U,
       std::array<std::reference_wrapper<const precomputed_vector_type>, stages>
           stage_precomputed,
       const std::array<Number, stages> stage_weights,
       vector_type &new_U,
       precomputed_vector_type &new_precomputed,
-      Number tau /*= 0.*/) const
+      Number tau /*= 0.*/,
+      const vector_type *combination_U /*= nullptr*/,
+      const Number combination_weight /*= 1.*/) const
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "HyperbolicModule<Description, dim, Number>::step()"
@@ -167,22 +947,29 @@ namespace ryujin
 
     CALLGRIND_START_INSTRUMENTATION;
 
+    const auto stage_counters = hardware_counters_.stage();
+
+    /* Record whether we use a time-step size of an earlier stage: */
+    const bool tau_prescribed = (tau != Number(0.));
+
     /*
-     * Workaround: A constexpr boolean storing the fact whether we
-     * instantiate the HyperbolicModule for the shallow water equations.
-     *
-     * Rationale: Currently, the shallow water equations is the only
-     * hyperbolic system for which we have to (a) form equilibrated states
-     * for the low-order update, and (b) apply an affine shift for
-     * computing limiter bounds. It's not so easy to come up with a
-     * meaningful abstraction layer for this (in particular because we only
-     * have one PDE). Thus, for the time being we simply special case a
-     * small amount of code in this routine.
-     *
-     * FIXME: Refactor into a proper abstraction layer / interface.
+     * We are about to overwrite the locally owned part of new_U. Mark its
+     * ghost values as outdated by resetting the ghost state of the
+     * vector. Otherwise, every vector space operation the TimeIntegrator
+     * uses for combining stages (sadd(), add(), equ()) would trigger an
+     * implicit (and redundant) ghost exchange; the only necessary
+     * exchange happens at the end of apply_boundary_conditions():
+     */
+    new_U.zero_out_ghost_values();
+
+    /*
+     * Some hyperbolic systems (such as the shallow water equations) form
+     * the low-order update with equilibrated states and shift the limiter
+     * bounds, see ShallowWater::HyperbolicSystem::View. This is selected
+     * at compile time by View::have_equilibrated_states:
      */
-    constexpr bool shallow_water =
-        std::is_same_v<Description, ShallowWater::Description>;
+    constexpr bool have_equilibrated_states =
+        HyperbolicSystem::template View<dim, Number>::have_equilibrated_states;
 
     using VA = VectorizedArray<Number>;
 
@@ -203,28 +990,149 @@ namespace ryujin
     const auto &mass_matrix = offline_data_->mass_matrix();
     const auto &betaij_matrix = offline_data_->betaij_matrix();
     const auto &cij_matrix = offline_data_->cij_matrix();
+    const auto &cij_norm_matrix = offline_data_->cij_norm_matrix();
+    const bool precomputed_norms = offline_data_->precompute_cij_norms();
 
-    const auto &boundary_map = offline_data_->boundary_map();
+    const auto &boundary_table = offline_data_->boundary_table();
     const auto &coupling_boundary_pairs =
         offline_data_->coupling_boundary_pairs();
 
     const Number measure_of_omega_inverse =
         Number(1.) / offline_data_->measure_of_omega();
 
-    /* A monotonically increasing "channel" variable for mpi_tags: */
-    unsigned int channel = 10;
+    /*
+     * A monotonically increasing "channel" variable for mpi_tags. It
+     * starts above all reserved channels, see lij_persistent_channel:
+     */
+    static_assert(first_step_channel > lij_persistent_channel + 1);
+    unsigned int channel = first_step_channel;
 
-    /* Lambda for creating the computing timer string: */
+    /*
+     * Lambda for looking up the computing timer of a step. The timer and
+     * all names are cached in step_timers_ so that no strings have to be
+     * constructed in subsequent calls:
+     */
     int step_no = 0;
-    const auto scoped_name = [&step_no](const auto &name,
-                                        const bool advance = true) {
+    const StepTimer *current_step = nullptr;
+    const auto step_timer = [&](const char *name,
+                                const bool advance = true) -> const auto & {
       advance || step_no--;
-      return "time step [H] " + std::to_string(++step_no) + " - " + name;
+      ++step_no;
+      const unsigned int index = 2 * step_no + (advance ? 0 : 1);
+      if (step_timers_.size() <= index)
+        step_timers_.resize(index + 1);
+
+      auto &entry = step_timers_[index];
+      if (entry.timer == nullptr || entry.label != name) {
+        const auto number = std::to_string(step_no);
+        entry.label = name;
+        entry.name = "time step [H] " + number + " - " + name;
+        entry.timer = &computing_timer_[entry.name];
+        entry.region_name = "[H] " + number;
+        entry.traffic_name = "time step [H] " + number;
+        entry.likwid_name = "time_step_" + number;
+      }
+
+      current_step = &entry;
+      return entry;
+    };
+
+    /*
+     * Lambda for creating a scoped computing timer and hardware counter
+     * region of a step:
+     */
+    struct StepScope {
+      Scope timer;
+      HardwareCounters::Region counters;
+    };
+    const auto scoped_timer = [&](const char *name) {
+      const auto &entry = step_timer(name);
+      return StepScope{Scope(*entry.timer, entry.name),
+                       hardware_counters_.region(entry.region_name)};
+    };
+
+    /* Lambda for creating a load imbalance profiler region: */
+    const auto profiler_region = [&]() {
+      return step_profiler_.region(current_step->region_name);
+    };
+
+    /*
+     * Lambda for accounting the estimated memory traffic of the current
+     * step. The model assumes that every matrix entry and every vector
+     * element touched in a step is transferred exactly once, i.e., that
+     * gathered states U_j, etc., are perfectly reused from cache:
+     */
+    const auto account_traffic = [&](const double bytes) {
+      if (traffic_model_)
+        data_traffic_[current_step->traffic_name] += bytes;
     };
 
+    const double rows = n_owned;
+    const double entries = n_owned_entries_;
+    constexpr double bytes_number = sizeof(Number);
+    constexpr double bytes_index = sizeof(unsigned int);
+#ifdef COMPRESSED_COLUMN_INDICES
+    /* Column indices decoded with SparsityPatternSIMD::columns(i, buffer): */
+    constexpr double bytes_column_index = sizeof(std::int16_t);
+#else
+    constexpr double bytes_column_index = bytes_index;
+#endif
+    constexpr double bytes_state = problem_dimension * bytes_number;
+    constexpr double bytes_precomputed = n_precomputed_values * bytes_number;
+    constexpr double bytes_bounds = n_bounds * sizeof(bounds_number_type);
+    constexpr double bytes_lij = sizeof(lij_number_type);
+
     /* A boolean signalling that a restart is necessary: */
     std::atomic<bool> restart_needed = false;
 
+    /* Select the schedule of all RYUJIN_OMP_FOR_RUNTIME row loops: */
+    set_runtime_schedule(chunk_size_);
+
+    /*
+     * The fused low-order update (see Step 3 and 4) requires a prescribed
+     * time-step size tau:
+     */
+    const bool fuse_low_order_update =
+        fuse_low_order_update_ && tau != Number(0.) && !precompute_only_;
+
+    /*
+     * Reuse the wave speed estimates of a reference step (see Step 2).
+     * Reference data is stored in every step with computed time-step
+     * size tau_max:
+     */
+    const bool reuse_wave_speeds = wave_speed_reuse_tolerance_ > Number(0.) &&
+                                   tau != Number(0.) && !precompute_only_ &&
+                                   reference_valid_;
+    const bool store_reference =
+        wave_speed_reuse_tolerance_ > Number(0.) && !reuse_wave_speeds;
+    const Number reuse_factor =
+        Number(1.) +
+        wave_speed_reuse_safety_factor_ * wave_speed_reuse_tolerance_;
+
+    /*
+     * Use the indicator accumulated in Step 4 of the last stage (see
+     * Step 2). The first stage after prepare() computes it directly:
+     */
+    const bool lagged_indicator = lagged_indicator_ && lagged_alpha_valid_;
+
+    /*
+     * Skip dry strides (see Step 1). The mask is computed together with
+     * the precomputed values and only used for hyperbolic systems with
+     * equilibrated states (i.e., the shallow water equations):
+     */
+    const bool skip_dry_strides = have_equilibrated_states &&
+                                  n_precomputation_cycles != 0 &&
+                                  skip_dry_strides_ && !precompute_only_;
+
+    const auto stride_index = [&](const unsigned int i) {
+      return i < n_internal ? i / simd_length
+                            : n_internal / simd_length + (i - n_internal);
+    };
+
+    const auto dry_stride = [&](const unsigned int i) {
+      return skip_dry_strides && dry_strides_[stride_index(i)] != 0;
+    };
+
     /*
      * -------------------------------------------------------------------------
      * Step 1: Precompute values
@@ -232,17 +1140,33 @@ namespace ryujin
      */
 
     if constexpr (n_precomputation_cycles != 0) {
-      Scope scope(computing_timer_, scoped_name("precompute values"));
+      const auto scope = scoped_timer("precompute values");
+
+      /* U_i, new precomputed values: */
+      account_traffic(n_precomputation_cycles * rows *
+                      (bytes_state + bytes_precomputed));
 
       for (unsigned int cycle = 0; cycle < n_precomputation_cycles; ++cycle) {
 
+        /*
+         * All but the last cycle can be computed redundantly for ghost
+         * indices instead of exchanging the ghost values, see "redundant
+         * ghost precomputation":
+         */
+        const bool redundant_ghosts = redundant_ghost_precomputation_ &&
+                                      cycle + 1 < n_precomputation_cycles;
+
         SynchronizationDispatch synchronization_dispatch([&]() {
-          new_precomputed.update_ghost_values_start(channel++);
-          new_precomputed.update_ghost_values_finish();
+          if (redundant_ghosts)
+            return;
+          precomputed_exchange_.update_ghost_values_start(new_precomputed,
+                                                          channel++);
+          precomputed_exchange_.update_ghost_values_finish(new_precomputed);
         });
 
+        const auto region = profiler_region();
         RYUJIN_PARALLEL_REGION_BEGIN
-        LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+        LIKWID_MARKER_START(current_step->likwid_name.c_str());
 
         auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
           using T = decltype(sentinel);
@@ -262,6 +1186,36 @@ namespace ryujin
               old_U,
               left,
               right);
+
+          /*
+           * Update the dry stride mask: A stride is dry if the states U_j
+           * of the complete stencil vanish for the old state and all
+           * stages. In this case the low-order update is the identity
+           * (all fluxes, equilibrated states and source terms vanish).
+           */
+          if (skip_dry_strides && cycle == 0) {
+            unsigned int stride_size = get_stride_size<T>;
+
+            const auto vanishes = [&](const auto &U, const unsigned int i) {
+              const unsigned int row_length = sparsity_simd.row_length(i);
+              const unsigned int *js = sparsity_simd.columns(i);
+              for (unsigned int col_idx = 0; col_idx < row_length;
+                   ++col_idx, js += stride_size) {
+                const auto U_j = U.template get_tensor<T>(js);
+                if (!all_zero<T>(U_j.norm_square()))
+                  return false;
+              }
+              return true;
+            };
+
+            RYUJIN_OMP_FOR
+            for (unsigned int i = left; i < right; i += stride_size) {
+              bool dry = vanishes(old_U, i);
+              for (int s = 0; s < stages && dry; ++s)
+                dry = vanishes(stage_U[s].get(), i);
+              dry_strides_[stride_index(i)] = dry;
+            }
+          }
         };
 
         /* Parallel non-vectorized loop: */
@@ -269,8 +1223,83 @@ namespace ryujin
         /* Parallel vectorized SIMD loop: */
         loop(VA(), 0, n_internal);
 
-        LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+        if constexpr (n_precomputation_cycles > 1) {
+          if (redundant_ghosts) {
+            const auto view = hyperbolic_system_->template view<dim, Number>();
+            view.precomputation_ghost_loop(cycle,
+                                           new_precomputed,
+                                           old_U,
+                                           n_owned,
+                                           offline_data_->n_locally_relevant());
+          }
+        }
+
+        LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+        region.thread_done();
         RYUJIN_PARALLEL_REGION_END
+        region.stop();
+        region.synchronize(synchronization_dispatch);
+      }
+    }
+
+    /*
+     * Precompute the flux contributions of the old state and the states
+     * of previous stages, see "flux cache size". We compute them for all
+     * locally relevant degrees of freedom: the states and precomputed
+     * values are available at ghost indices, so that no ghost exchange
+     * is necessary.
+     */
+
+    const unsigned int n_cached_fluxes =
+        precompute_only_
+            ? 0
+            : std::min<unsigned int>(flux_cache_.size(), stages + 1);
+
+    if constexpr (have_flux_cache) {
+      if (n_cached_fluxes != 0) {
+        const auto &entry = step_timer("precompute fluxes", false);
+        Scope scope(*entry.timer, entry.name);
+
+        const unsigned int n_relevant = offline_data_->n_locally_relevant();
+
+        /* U_i, precomputed values, cached fluxes (written): */
+        account_traffic(n_cached_fluxes * double(n_relevant) *
+                        ((dim + 1) * bytes_state + bytes_precomputed));
+
+        const auto region = profiler_region();
+        RYUJIN_PARALLEL_REGION_BEGIN
+
+        auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+          using T = decltype(sentinel);
+          unsigned int stride_size = get_stride_size<T>;
+
+          const auto view = hyperbolic_system_->template view<dim, T>();
+
+          for (unsigned int k = 0; k < n_cached_fluxes; ++k) {
+            const auto &U = k == 0 ? old_U : stage_U[k - 1].get();
+            const auto &precomputed =
+                k == 0 ? new_precomputed : stage_precomputed[k - 1].get();
+            auto &cache = flux_cache_[k];
+
+            RYUJIN_OMP_FOR_NOWAIT
+            for (unsigned int i = left; i < right; i += stride_size) {
+              const auto U_i = U.template get_tensor<T>(i);
+              const auto flux_i = view.flux_contribution(
+                  precomputed, precomputed_initial_, i, U_i);
+              cache.template write_tensor<T>(
+                  pack_flux<problem_dimension, dim>(flux_i), i);
+            }
+          }
+        };
+
+        /* Parallel non-vectorized loop (including ghost indices): */
+        loop(Number(), n_internal, n_relevant);
+        /* Parallel vectorized SIMD loop: */
+        loop(VA(), 0, n_internal);
+
+        region.thread_done();
+        RYUJIN_PARALLEL_REGION_END
+        region.stop();
       }
     }
 
@@ -291,25 +1320,52 @@ namespace ryujin
      *      r ......
      *      r ......
      *
-     *  and symmetrize in Step 2.
+     *  and symmetrize in Step 2. In case of symmetric storage of the d_ij
+     *  matrix (see SymmetricSparseMatrixSIMD) the lower triangular part
+     *  shares storage with the upper triangular part and we only write
+     *  entries with j > i.
      *
      *  MM: We could save a bit more computational resources by only
      *  computing entries for which *IN A GLOBAL* enumeration j > i. But
      *  the index translation, subsequent symmetrization, and exchange
      *  sounds a bit too expensive...
+     *
+     *  If wave speed estimates are reused, we take d_ij from the
+     *  reference step for all edges whose states U_i and U_j moved less
+     *  than the relative tolerance with respect to the reference states.
+     *
+     *  If the indicator is lagged we simply copy the values alpha_i that
+     *  have been accumulated in Step 4 of the last stage and skip all
+     *  indicator computations.
+     *
+     *  The ghost exchange of alpha_i is only needed in Step 4. We thus
+     *  keep it in flight during Step 3 and only wait for its completion
+     *  prior to the synchronization barrier.
      * -------------------------------------------------------------------------
      */
 
+    SynchronizationDispatch alpha_synchronization([&]() {
+      alpha_exchange_.update_ghost_values_start(alpha_, channel++);
+      alpha_exchange_.update_ghost_values_finish(alpha_);
+    });
+
+    StepProfiler::Region alpha_region;
+
     {
-      Scope scope(computing_timer_, scoped_name("compute d_ij, and alpha_i"));
+      const auto scope = scoped_timer("compute d_ij, and alpha_i");
 
-      SynchronizationDispatch synchronization_dispatch([&]() {
-        alpha_.update_ghost_values_start(channel++);
-        alpha_.update_ghost_values_finish();
-      });
+      if (store_reference)
+        reference_U_ = old_U;
+
+      /* Column indices, c_ij, d_ij (j > i), U_i, precomputed, m_i, alpha_i: */
+      account_traffic(entries * (bytes_column_index + dim * bytes_number +
+                                 0.5 * bytes_number) +
+                      rows * (bytes_state + bytes_precomputed +
+                              2. * bytes_number));
 
+      alpha_region = profiler_region();
       RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_START(current_step->likwid_name.c_str());
 
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
@@ -320,77 +1376,258 @@ namespace ryujin
             *hyperbolic_system_, new_precomputed);
         typename Description::template Indicator<dim, T> indicator(
             *hyperbolic_system_, new_precomputed, indicator_evc_factor_);
+        const auto view = hyperbolic_system_->template view<dim, T>();
         bool thread_ready = false;
+        std::vector<unsigned int> column_buffer(
+            sparsity_simd.column_buffer_size());
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        /*
+         * A reference estimate d_ij is only reused if both states moved
+         * less than the tolerance and are admissible. The reused
+         * estimate is inflated by reuse_factor. Every other edge is
+         * recomputed:
+         */
+        const auto reusable = [&](const auto &U, const auto &U_ref) {
+          return !state_moved<T>(U, U_ref, wave_speed_reuse_tolerance_) &&
+                 view.is_admissible(U);
+        };
 
-          /* Skip constrained degrees of freedom: */
+        /* Traverse batches of upper triangular edges (vectorized only): */
+        const bool edge_based =
+            edge_based_wave_speeds_ && !std::is_same_v<T, Number>;
+
+        /* Write the (upper triangular) entry d_ij into a matrix: */
+        const auto write_dij = [&](auto &matrix,
+                                   const T &d_ij,
+                                   const unsigned int i,
+                                   const unsigned int col_idx,
+                                   const unsigned int *js) {
+          if constexpr (symmetric_matrix_type::is_symmetric)
+            write_upper_triangular_entry<T>(matrix, d_ij, i, col_idx, js);
+          else
+            matrix.write_entry(d_ij, i, col_idx, true);
+        };
+
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
+
+        /* Constrained degrees of freedom are not in active_rows(): */
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
           const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
+          const unsigned int *columns_i =
+              sparsity_simd.columns(i, column_buffer.data());
 
-          synchronization_dispatch.check(
+          alpha_synchronization.check(
               thread_ready, i >= n_export_indices && i < n_internal);
 
           const auto U_i = old_U.template get_tensor<T>(i);
 
-          indicator.reset(i, U_i);
+          if (dry_stride(i)) {
+            /*
+             * All states of the stencil vanish. Thus, the indicator
+             * vanishes and the wave speed estimate (at rest) does not
+             * depend on the edge. We compute it only once per stride:
+             */
+            const unsigned int *js = columns_i + stride_size;
+            dealii::Tensor<1, dim, T> n_ij;
+            n_ij[0] = T(1.);
+            const auto lambda_max =
+                riemann_solver.compute(U_i, U_i, i, js, n_ij);
 
-          /* Skip diagonal. */
-          const unsigned int *js = sparsity_simd.columns(i) + stride_size;
-          for (unsigned int col_idx = 1; col_idx < row_length;
-               ++col_idx, js += stride_size) {
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+              if (all_below_diagonal<T>(i, js))
+                continue;
+
+              const auto norm =
+                  precomputed_norms
+                      ? cij_norm_matrix.template get_entry<T>(i, col_idx)
+                      : cij_matrix.template get_tensor<T>(i, col_idx).norm();
+              const auto d_ij = norm * lambda_max;
+              write_dij(dij_matrix_, d_ij, i, col_idx, js);
+              if (store_reference)
+                write_dij(reference_dij_matrix_, d_ij, i, col_idx, js);
+            }
 
-            const auto U_j = old_U.template get_tensor<T>(js);
+            store_value<T>(alpha_, T(0.), i);
+            continue;
+          }
 
-            const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+          const bool U_i_moved =
+              !reuse_wave_speeds ||
+              !reusable(U_i, reference_U_.template get_tensor<T>(i));
 
-            indicator.accumulate(js, U_j, c_ij);
+          if (!lagged_indicator)
+            indicator.reset(i, U_i);
 
-            /* Only iterate over the upper triangular portion of d_ij */
-            if (all_below_diagonal<T>(i, js))
-              continue;
+          /* Nothing left to do in the row loop for lagged, edge based: */
+          const unsigned int n_columns =
+              lagged_indicator && edge_based ? 1 : row_length;
 
-            const auto norm = c_ij.norm();
-            const auto n_ij = c_ij / norm;
-            const auto lambda_max =
-                riemann_solver.compute(U_i, U_j, i, js, n_ij);
-            const auto d_ij = norm * lambda_max;
+          dispatch_row_length<dim>(n_columns, [&](const auto n_cols) {
+            /* Skip diagonal. */
+            const unsigned int *js = columns_i + stride_size;
+            for (unsigned int col_idx = 1; col_idx < n_cols;
+                 ++col_idx, js += stride_size) {
 
-            dij_matrix_.write_entry(d_ij, i, col_idx, true);
+              if constexpr (PREFETCH_DISTANCE > 0) {
+                if (col_idx + PREFETCH_DISTANCE < n_cols) {
+                  old_U.template prefetch<T>(js +
+                                             PREFETCH_DISTANCE * stride_size);
+                  cij_matrix.template prefetch<T>(i,
+                                                  col_idx + PREFETCH_DISTANCE);
+                }
+              }
+
+              const auto U_j = old_U.template get_tensor<T>(js);
+
+              const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
+
+              if (!lagged_indicator)
+                indicator.accumulate(js, U_j, c_ij);
+
+              /* Only iterate over the upper triangular portion of d_ij */
+              if (edge_based || all_below_diagonal<T>(i, js))
+                continue;
+
+              if (!U_i_moved &&
+                  reusable(U_j, reference_U_.template get_tensor<T>(js))) {
+                const auto d_ij =
+                    T(reuse_factor) *
+                    reference_dij_matrix_.template get_entry<T>(i, col_idx);
+                write_dij(dij_matrix_, d_ij, i, col_idx, js);
+                continue;
+              }
+
+              const auto norm =
+                  precomputed_norms
+                      ? cij_norm_matrix.template get_entry<T>(i, col_idx)
+                      : c_ij.norm();
+              const auto n_ij = c_ij / norm;
+              const auto lambda_max =
+                  riemann_solver.compute(U_i, U_j, i, js, n_ij);
+              const auto d_ij = norm * lambda_max;
+
+              write_dij(dij_matrix_, d_ij, i, col_idx, js);
+              if (store_reference)
+                write_dij(reference_dij_matrix_, d_ij, i, col_idx, js);
+            }
+          });
+
+          if constexpr (!std::is_same_v<T, Number>) {
+            if (edge_based) {
+              /*
+               * Traverse the batches of upper triangular edges of the
+               * stride. Lane k of every batch holds an edge (i + k, j):
+               */
+              const unsigned int *positions = sparsity_simd.edge_positions(i);
+              const unsigned int n_batches = sparsity_simd.n_edge_batches(i);
+
+              for (unsigned int b = 0; b < n_batches;
+                   ++b, positions += stride_size) {
+
+                std::array<unsigned int, T::size()> js;
+                for (unsigned int k = 0; k < T::size(); ++k)
+                  js[k] = columns_i[positions[k] * stride_size + k];
+
+                const auto U_j = old_U.template get_tensor<T>(js.data());
+
+                if (!U_i_moved &&
+                    reusable(U_j,
+                             reference_U_.template get_tensor<T>(js.data()))) {
+                  const auto d_ij =
+                      T(reuse_factor) *
+                      gather_entry<T>(reference_dij_matrix_, i, positions);
+                  scatter_upper_triangular_entry<T>(
+                      dij_matrix_, d_ij, i, positions, js.data());
+                  continue;
+                }
+
+                const auto c_ij = gather_tensor<T>(cij_matrix, i, positions);
+                const auto norm =
+                    precomputed_norms
+                        ? gather_entry<T>(cij_norm_matrix, i, positions)
+                        : c_ij.norm();
+                const auto n_ij = c_ij / norm;
+                const auto lambda_max =
+                    riemann_solver.compute(U_i, U_j, i, js.data(), n_ij);
+                const auto d_ij = norm * lambda_max;
+
+                scatter_upper_triangular_entry<T>(
+                    dij_matrix_, d_ij, i, positions, js.data());
+                if (store_reference)
+                  scatter_upper_triangular_entry<T>(
+                      reference_dij_matrix_, d_ij, i, positions, js.data());
+              }
+            }
           }
 
-          const auto mass = load_value<T>(lumped_mass_matrix, i);
-          const auto hd_i = mass * measure_of_omega_inverse;
-          store_value<T>(alpha_, indicator.alpha(hd_i), i);
+          if (lagged_indicator) {
+            store_value<T>(alpha_, load_value<T>(lagged_alpha_, i), i);
+          } else {
+            const auto mass = load_value<T>(lumped_mass_matrix, i);
+            const auto hd_i = mass * measure_of_omega_inverse;
+            store_value<T>(alpha_, indicator.alpha(hd_i), i);
+          }
         }
       };
 
       /* Parallel non-vectorized loop: */
       loop(Number(), n_internal, n_owned);
+      if (!overlap_scalar_loop_) {
+        RYUJIN_OMP_BARRIER
+      }
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+      alpha_region.thread_done();
       RYUJIN_PARALLEL_REGION_END
+      alpha_region.stop();
+
+      /* Keep the exchange of alpha_i in flight during Step 3: */
+      alpha_synchronization.launch();
+
+      if (store_reference)
+        reference_valid_ = true;
     }
 
     /*
      * -------------------------------------------------------------------------
      * Step 3: Compute diagonal of d_ij, and maximal time-step size.
+     *
+     * In case of a fused low-order update we only complete d_ij at the
+     * boundary and defer the symmetrization of d_ij, the computation of
+     * the diagonal d_ii, and of tau_max to Step 4. The CFL step size
+     * tau_max is not needed for performing the low-order update with a
+     * prescribed tau, and symmetrizing the row i only depends on the
+     * upper triangular portion of rows j < i that has already been
+     * computed in Step 2. This avoids a complete sweep over the d_ij
+     * matrix.
      * -------------------------------------------------------------------------
      */
 
     std::atomic<Number> tau_max{std::numeric_limits<Number>::max()};
 
     {
-      Scope scope(computing_timer_,
-                  scoped_name("compute bdry d_ij, diag d_ii, and tau_max"));
+      const auto scope =
+          scoped_timer("compute bdry d_ij, diag d_ii, and tau_max");
+
+      /* Boundary pairs U_i, U_j, c_ji, d_ij: */
+      account_traffic(coupling_boundary_pairs.size() *
+                      (2. * bytes_state + (dim + 1) * bytes_number));
+      /* Symmetrization of d_ij, d_ii, m_i: */
+      if (!fuse_low_order_update)
+        account_traffic(entries * (bytes_index + bytes_number) +
+                        rows * bytes_number);
 
       /* Parallel region */
+      const auto region = profiler_region();
       RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_START(current_step->likwid_name.c_str());
 
       /* Complete d_ij at boundary: */
 
@@ -403,11 +1640,24 @@ namespace ryujin
       for (std::size_t k = 0; k < coupling_boundary_pairs.size(); ++k) {
         const auto &entry = coupling_boundary_pairs[k];
         const auto &[i, col_idx, j] = entry;
+
+        /*
+         * Only complete the upper triangular portion, the lower triangular
+         * portion is symmetrized (or shares storage) with it.
+         */
+        if (j < i)
+          continue;
+
         const auto U_i = old_U.get_tensor(i);
         const auto U_j = old_U.get_tensor(j);
-        const auto c_ji = cij_matrix.get_transposed_tensor(i, col_idx);
+        const auto c_ji =
+            cij_matrix.template get_transposed_tensor<Number>(i, col_idx);
         Assert(c_ji.norm() > 1.e-12, ExcInternalError());
-        const auto norm = c_ji.norm();
+        const auto norm =
+            precomputed_norms
+                ? cij_norm_matrix.template get_transposed_entry<Number>(
+                      i, col_idx)
+                : c_ji.norm();
         const auto n_ji = c_ji / norm;
         auto lambda_max = riemann_solver.compute(U_j, U_i, j, &i, n_ji);
 
@@ -418,46 +1668,49 @@ namespace ryujin
 
       /* Symmetrize d_ij: */
 
-      RYUJIN_OMP_FOR
-      for (unsigned int i = 0; i < n_owned; ++i) {
+      if (!fuse_low_order_update) {
+        RYUJIN_OMP_FOR_RUNTIME
+        for (unsigned int i = 0; i < n_owned; ++i) {
 
-        /* Skip constrained degrees of freedom: */
-        const unsigned int row_length = sparsity_simd.row_length(i);
-        if (row_length == 1)
-          continue;
+          /* Skip constrained degrees of freedom: */
+          const unsigned int row_length = sparsity_simd.row_length(i);
+          if (row_length == 1)
+            continue;
 
-        Number d_sum = Number(0.);
+          Number d_sum = Number(0.);
 
-        /* skip diagonal: */
-        const unsigned int *js = sparsity_simd.columns(i);
-        for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
-          const auto j =
-              *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+          /* skip diagonal: */
+          const unsigned int *js = sparsity_simd.columns(i);
+          for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
+            const auto j =
+                *(i < n_internal ? js + col_idx * simd_length : js + col_idx);
+
+            // fill lower triangular part of dij_matrix missing from step 1
+            if (!symmetric_matrix_type::is_symmetric && j < i) {
+              const auto d_ji =
+                  dij_matrix_.get_transposed_entry(i, col_idx);
+              dij_matrix_.write_entry(d_ji, i, col_idx);
+            }
 
-          // fill lower triangular part of dij_matrix missing from step 1
-          if (j < i) {
-            const auto d_ji = dij_matrix_.get_transposed_entry(i, col_idx);
-            dij_matrix_.write_entry(d_ji, i, col_idx);
+            d_sum -= dij_matrix_.get_entry(i, col_idx);
           }
 
-          d_sum -= dij_matrix_.get_entry(i, col_idx);
-        }
-
-        /*
-         * Make sure that we do not accidentally divide by zero. (Yes, this
-         * can happen for some (admittedly, rather esoteric) scalar
-         * conservation equations...).
-         */
-        d_sum =
-            std::min(d_sum, Number(-1.e6) * std::numeric_limits<Number>::min());
+          /*
+           * Make sure that we do not accidentally divide by zero. (Yes,
+           * this can happen for some (admittedly, rather esoteric) scalar
+           * conservation equations...).
+           */
+          d_sum = std::min(d_sum,
+                           Number(-1.e6) * std::numeric_limits<Number>::min());
 
-        /* write diagonal element */
-        dij_matrix_.write_entry(d_sum, i, 0);
+          /* write diagonal element */
+          dij_matrix_.write_entry(d_sum, i, 0);
 
-        const Number mass = lumped_mass_matrix.local_element(i);
-        const Number tau = cfl_ * mass / (Number(-2.) * d_sum);
-        if (boundary_map.count(i) == 0 || cfl_with_boundary_dofs_) {
-          local_tau_max = std::min(local_tau_max, tau);
+          const Number mass = lumped_mass_matrix.local_element(i);
+          const Number tau = cfl_ * mass / (Number(-2.) * d_sum);
+          if (!boundary_table.is_boundary(i) || cfl_with_boundary_dofs_) {
+            local_tau_max = std::min(local_tau_max, tau);
+          }
         }
       }
 
@@ -467,23 +1720,47 @@ namespace ryujin
              !tau_max.compare_exchange_weak(current_tau_max, local_tau_max))
         ;
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+      region.thread_done();
       RYUJIN_PARALLEL_REGION_END
+      region.stop();
     }
 
-    {
-      Scope scope(computing_timer_,
-                  scoped_name("synchronization barrier", false));
-
-      /* MPI Barrier: */
-      tau_max.store(Utilities::MPI::min(tau_max.load(), mpi_communicator_));
+    /*
+     * Complete the ghost exchange of alpha_i. This has to happen before
+     * any other MPI communication (such as the synchronization barrier)
+     * is issued from the main thread:
+     */
+    alpha_region.synchronize(alpha_synchronization);
 
+    const auto check_tau_max = [&]() {
       AssertThrow(
           !std::isnan(tau_max) && !std::isinf(tau_max) && tau_max > 0.,
           ExcMessage(
               "I'm sorry, Dave. I'm afraid I can't do that.\nWe crashed."));
+    };
+
+    /*
+     * If the time-step size is prescribed, tau_max is only needed for
+     * updating tau_ratio_ at the end of the step. In this case we defer
+     * the global reduction of tau_max and fuse it with the reduction of
+     * the restart flag at the end of the step. This saves one (blocking)
+     * global reduction per stage and removes the synchronization point
+     * between Step 3 and Step 4.
+     */
+
+    const auto &barrier = step_timer("synchronization barrier", false);
 
-      tau = (tau == Number(0.) ? tau_max.load() : tau);
+    if (!fuse_low_order_update) {
+      Scope scope(*barrier.timer, barrier.name);
+
+      if (!tau_prescribed) {
+        /* MPI Barrier: */
+        tau_max.store(Utilities::MPI::min(tau_max.load(), mpi_communicator_));
+        check_tau_max();
+      }
+
+      tau = (tau == Number(0.) ? std::min(tau_max.load(), tau_limit_) : tau);
 
 #ifdef DEBUG_OUTPUT
       std::cout << "        computed tau_max = " << tau_max << std::endl;
@@ -501,12 +1778,16 @@ namespace ryujin
     /*
      * -------------------------------------------------------------------------
      * Step 4: Low-order update, also compute limiter bounds, R_i
+     *
+     * If the indicator is lagged we also accumulate alpha_i for the next
+     * stage. The indicator only needs the states U_j and c_ij that are
+     * loaded anyway.
      * -------------------------------------------------------------------------
      */
 
     {
-      Scope scope(computing_timer_,
-                  scoped_name("l.-o. update, compute bounds, r_i, and p_ij"));
+      const auto scope =
+          scoped_timer("l.-o. update, compute bounds, r_i, and p_ij");
 
       SynchronizationDispatch synchronization_dispatch([&]() {
         r_.update_ghost_values_start(channel++);
@@ -516,9 +1797,37 @@ namespace ryujin
       const Number weight =
           -std::accumulate(stage_weights.begin(), stage_weights.end(), -1.);
 
+      /*
+       * Column indices, d_ij, c_ij, beta_ij, m_ij, p_ij (written), U and
+       * precomputed values of all stages, alpha_i, m_i, m_i^-1, new U_i,
+       * r_i, and bounds (written):
+       */
+      account_traffic(
+          entries * (bytes_column_index + (dim + 3) * bytes_number +
+                     bytes_state) +
+          rows * ((stages + 1) * (bytes_state + bytes_precomputed) +
+                  3. * bytes_number + 2. * bytes_state + bytes_bounds));
+      if (lumped_high_order_)
+        account_traffic(-entries * bytes_number);
+      /* Fused symmetrization of d_ij and d_ii (written): */
+      if (fuse_low_order_update)
+        account_traffic(entries * bytes_number + rows * bytes_number);
+      /* Cached fluxes of the old state and previous stages: */
+      account_traffic(rows * n_cached_fluxes * dim * bytes_state);
+      /* Precomputed edge values: */
+      if (precompute_edge_values_)
+        account_traffic(entries * n_precomputed_edge_values * bytes_number);
+      /* Fused convex combination without limiter passes: */
+      if (limiter_iter_ == 0 && combination_U != nullptr)
+        account_traffic(rows * bytes_state);
+
       /* Parallel region */
+      const auto region = profiler_region();
       RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_START(current_step->likwid_name.c_str());
+
+      /* Only used for the fused low-order update: */
+      Number local_tau_max = std::numeric_limits<Number>::max();
 
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
@@ -532,41 +1841,172 @@ namespace ryujin
         const auto view = hyperbolic_system_->template view<dim, T>();
 
         /* Stored thread locally: */
+        AlignedVector<T> dij_row;
         Limiter limiter(*hyperbolic_system_,
                         new_precomputed,
                         limiter_relaxation_factor_,
                         limiter_newton_tolerance_,
                         limiter_newton_max_iter_);
+        typename Description::template Indicator<dim, T> indicator(
+            *hyperbolic_system_, new_precomputed, indicator_evc_factor_);
         bool thread_ready = false;
+        std::vector<unsigned int> column_buffer(
+            sparsity_simd.column_buffer_size());
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        /*
+         * Return the flux contribution of the old state (k = 0), or of
+         * the state of stage k - 1, at index (or indices) i. The flux is
+         * loaded from the flux cache if available:
+         */
+        const auto get_flux = [&](const unsigned int k,
+                                  const auto &precomputed,
+                                  const auto i,
+                                  const auto &U_i) -> flux_contribution_type {
+          if constexpr (have_flux_cache) {
+            if (k < n_cached_fluxes)
+              return unpack_flux<problem_dimension, dim>(
+                  flux_cache_[k].template get_tensor<T>(i));
+          }
+          return view.flux_contribution(
+              precomputed, precomputed_initial_, i, U_i);
+        };
 
-          /* Skip constrained degrees of freedom: */
+        /*
+         * Return the flux contribution of the neighbor js in column
+         * col_idx of row i. The time-independent part is taken from the
+         * precomputed edge values if available:
+         */
+        const auto get_flux_j = [&](const unsigned int k,
+                                    const auto &precomputed,
+                                    [[maybe_unused]] const unsigned int i,
+                                    [[maybe_unused]] const unsigned int col_idx,
+                                    const unsigned int *js,
+                                    const auto &U_j) -> flux_contribution_type {
+          if constexpr (n_precomputed_edge_values > 0) {
+            if (precompute_edge_values_ &&
+                (!have_flux_cache || k >= n_cached_fluxes)) {
+              const auto pev =
+                  precomputed_edge_.template get_tensor<T>(i, col_idx);
+              return view.flux_contribution(precomputed, pev, js, U_j);
+            }
+          }
+          return get_flux(k, precomputed, js, U_j);
+        };
+
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
+
+        /* Constrained degrees of freedom are not in active_rows(): */
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
           const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
+          const unsigned int *columns_i =
+              sparsity_simd.columns(i, column_buffer.data());
 
           synchronization_dispatch.check(
               thread_ready, i >= n_export_indices && i < n_internal);
 
+          /*
+           * Without limiter passes the low-order update is final and we
+           * write the fused convex combination with combination_U (see
+           * Step 6, 7) already here:
+           */
+          const auto combine = [&](const auto &U_i_new) {
+            if (limiter_iter_ != 0 || combination_U == nullptr)
+              return U_i_new;
+            const auto U_i_c = combination_U->template get_tensor<T>(i);
+            return T(combination_weight) * U_i_new +
+                   T(Number(1.) - combination_weight) * U_i_c;
+          };
+
           const auto U_i = old_U.template get_tensor<T>(i);
-          auto U_i_new = U_i;
+
+          if (dry_stride(i)) {
+            /* The low-order update is the identity and r_i vanishes: */
+            new_U.template write_tensor<T>(combine(U_i), i);
+            r_.template write_tensor<T>(state_type(), i);
+            if (lagged_indicator_)
+              store_value<T>(lagged_alpha_, T(0.), i);
+            continue;
+          }
+
+          accumulator_type<state_type> U_i_new = U_i;
 
           const auto alpha_i = load_value<T>(alpha_, i);
           const auto m_i = load_value<T>(lumped_mass_matrix, i);
           const auto m_i_inv = load_value<T>(lumped_mass_matrix_inverse, i);
 
-          const auto flux_i = view.flux_contribution(
-              new_precomputed, precomputed_initial_, i, U_i);
+          if (fuse_low_order_update) {
+            /*
+             * Symmetrize the current row of d_ij and compute the diagonal
+             * d_ii. We store the result thread locally in dij_row for
+             * consumption in the low-order update below:
+             */
+
+            dij_row.resize_fast(row_length);
+            T d_sum = T(0.);
+
+            /* Skip diagonal. */
+            const unsigned int *js = columns_i + stride_size;
+            for (unsigned int col_idx = 1; col_idx < row_length;
+                 ++col_idx, js += stride_size) {
+
+              const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
+              if (symmetric_matrix_type::is_symmetric ||
+                  all_above_diagonal<T>(i, js)) {
+                dij_row[col_idx] = d_ij;
+              } else {
+                const auto d_ji =
+                    dij_matrix_.template get_transposed_entry<T>(i, col_idx);
+                dij_row[col_idx] = symmetrized_entry<T>(d_ij, d_ji, i, js);
+              }
+
+              d_sum -= dij_row[col_idx];
+            }
+
+            /* Make sure that we do not accidentally divide by zero: */
+            d_sum = std::min(
+                d_sum, T(Number(-1.e6) * std::numeric_limits<Number>::min()));
+
+            dij_row[0] = d_sum;
+
+            /*
+             * Also store the diagonal for consumers of d_ii after the
+             * step, such as local_time_step_levels(). The diagonal of row
+             * i is never read by other rows in this sweep:
+             */
+            dij_matrix_.template write_entry<T>(d_sum, i, 0);
+
+            const auto tau_i = cfl_ * m_i / (Number(-2.) * d_sum);
+            if constexpr (std::is_same_v<T, Number>) {
+              if (!boundary_table.is_boundary(i) || cfl_with_boundary_dofs_)
+                local_tau_max = std::min(local_tau_max, tau_i);
+            } else {
+              for (unsigned int k = 0; k < simd_length; ++k)
+                if (!boundary_table.is_boundary(i + k) ||
+                    cfl_with_boundary_dofs_)
+                  local_tau_max = std::min(local_tau_max, tau_i[k]);
+            }
+          }
+
+          /* Return the (symmetrized) entry d_ij of the current row: */
+          const auto get_dij = [&](const unsigned int col_idx) {
+            if (fuse_low_order_update)
+              return dij_row[col_idx];
+            else
+              return dij_matrix_.template get_entry<T>(i, col_idx);
+          };
+
+          const auto flux_i = get_flux(0, new_precomputed, i, U_i);
 
           std::array<flux_contribution_type, stages> flux_iHs;
           [[maybe_unused]] state_type S_iH;
 
           for (int s = 0; s < stages; ++s) {
             const auto temp = stage_U[s].get().template get_tensor<T>(i);
-            flux_iHs[s] = view.flux_contribution(
-                stage_precomputed[s].get(), precomputed_initial_, i, temp);
+            flux_iHs[s] = get_flux(s + 1, stage_precomputed[s].get(), i, temp);
 
             if constexpr (View::have_source_terms) {
               // FIXME: Chain through correct time
@@ -576,7 +2016,7 @@ namespace ryujin
             }
           }
 
-          state_type F_iH;
+          accumulator_type<state_type> F_iH;
           [[maybe_unused]] state_type S_i;
 
           if constexpr (View::have_source_terms) {
@@ -592,25 +2032,26 @@ namespace ryujin
           }
 
           limiter.reset(i, U_i, flux_i);
+          if (lagged_indicator_)
+            indicator.reset(i, U_i);
 
           /*
-           * Workaround: For shallow water we need to accumulate an affine
-           * shift over the stencil first before we can compute limiter
-           * bounds.
+           * For equilibrated states we need to accumulate an affine shift
+           * over the stencil first before we can compute limiter bounds.
            */
 
           [[maybe_unused]] state_type affine_shift;
 
-          const unsigned int *js = sparsity_simd.columns(i);
-          if constexpr (shallow_water) {
+          const unsigned int *js = columns_i;
+          if constexpr (View::have_equilibrated_states) {
             for (unsigned int col_idx = 0; col_idx < row_length;
                  ++col_idx, js += stride_size) {
 
               const auto U_j = old_U.template get_tensor<T>(js);
-              const auto flux_j = view.flux_contribution(
-                  new_precomputed, precomputed_initial_, js, U_j);
+              const auto flux_j =
+                  get_flux_j(0, new_precomputed, i, col_idx, js, U_j);
 
-              const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
+              const auto d_ij = get_dij(col_idx);
               const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
 
               const auto B_ij = view.affine_shift(flux_i, flux_j, c_ij, d_ij);
@@ -620,143 +2061,191 @@ namespace ryujin
             affine_shift *= tau * m_i_inv;
           }
 
-          js = sparsity_simd.columns(i);
-          for (unsigned int col_idx = 0; col_idx < row_length;
-               ++col_idx, js += stride_size) {
+          js = columns_i;
+          dispatch_row_length<dim>(row_length, [&](const auto n_cols) {
+            for (unsigned int col_idx = 0; col_idx < n_cols;
+                 ++col_idx, js += stride_size) {
+
+              if constexpr (PREFETCH_DISTANCE > 0) {
+                if (col_idx + PREFETCH_DISTANCE < n_cols) {
+                  old_U.template prefetch<T>(js +
+                                             PREFETCH_DISTANCE * stride_size);
+                  cij_matrix.template prefetch<T>(i,
+                                                  col_idx + PREFETCH_DISTANCE);
+                }
+              }
 
-            const auto U_j = old_U.template get_tensor<T>(js);
+              const auto U_j = old_U.template get_tensor<T>(js);
 
-            const auto alpha_j = load_value<T>(alpha_, js);
+              const auto alpha_j = load_value<T>(alpha_, js);
 
-            const auto d_ij = dij_matrix_.template get_entry<T>(i, col_idx);
-            const auto d_ijH = d_ij * (alpha_i + alpha_j) * Number(.5);
+              const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
 
-            const auto c_ij = cij_matrix.template get_tensor<T>(i, col_idx);
-            const auto d_ij_inv = Number(1.) / d_ij;
+              if (lagged_indicator_ && col_idx != 0)
+                indicator.accumulate(js, U_j, c_ij);
 
-            const auto beta_ij =
-                betaij_matrix.template get_entry<T>(i, col_idx);
+              const auto d_ij = get_dij(col_idx);
+              const auto d_ijH = d_ij * (alpha_i + alpha_j) * Number(.5);
 
-            const auto flux_j = view.flux_contribution(
-                new_precomputed, precomputed_initial_, js, U_j);
+              const auto d_ij_inv = Number(1.) / d_ij;
 
-            const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
+              const auto beta_ij =
+                  betaij_matrix.template get_entry<T>(i, col_idx);
 
-            /*
-             * Compute low-order flux and limiter bounds:
-             */
+              const auto flux_j =
+                  get_flux_j(0, new_precomputed, i, col_idx, js, U_j);
 
-            const auto flux_ij = view.flux(flux_i, flux_j);
-            U_i_new += tau * m_i_inv * contract(flux_ij, c_ij);
-            auto P_ij = -contract(flux_ij, c_ij);
+              const auto m_ij =
+                  lumped_high_order_
+                      ? (col_idx == 0 ? m_i : T(0.))
+                      : mass_matrix.template get_entry<T>(i, col_idx);
 
-            if constexpr (shallow_water) {
               /*
-               * Workaround: Shallow water (and related) are special:
+               * Compute low-order flux and limiter bounds:
                */
 
-              const auto &[U_star_ij, U_star_ji] =
-                  view.equilibrated_states(flux_i, flux_j);
+              const auto flux_ij = view.flux(flux_i, flux_j);
+              U_i_new += tau * m_i_inv * contract(flux_ij, c_ij);
+              auto P_ij = -contract(flux_ij, c_ij);
 
-              U_i_new += tau * m_i_inv * d_ij * (U_star_ji - U_star_ij);
-              F_iH += d_ijH * (U_star_ji - U_star_ij);
-              P_ij += (d_ijH - d_ij) * (U_star_ji - U_star_ij);
+              if constexpr (View::have_equilibrated_states) {
+                const auto &[U_star_ij, U_star_ji] =
+                    view.equilibrated_states(flux_i, flux_j);
 
-              limiter.accumulate(U_j,
-                                 U_star_ij,
-                                 U_star_ji,
-                                 d_ij_inv * c_ij,
-                                 beta_ij,
-                                 affine_shift);
+                U_i_new += tau * m_i_inv * d_ij * (U_star_ji - U_star_ij);
+                F_iH += d_ijH * (U_star_ji - U_star_ij);
+                P_ij += (d_ijH - d_ij) * (U_star_ji - U_star_ij);
 
-            } else {
-
-              U_i_new += tau * m_i_inv * d_ij * (U_j - U_i);
-              F_iH += d_ijH * (U_j - U_i);
-              P_ij += (d_ijH - d_ij) * (U_j - U_i);
-
-              limiter.accumulate(js, U_j, flux_j, d_ij_inv * c_ij, beta_ij);
-            }
+                limiter.accumulate(U_j,
+                                   U_star_ij,
+                                   U_star_ji,
+                                   d_ij_inv * c_ij,
+                                   beta_ij,
+                                   affine_shift);
 
-            if constexpr (View::have_source_terms) {
-              F_iH -= m_ij * S_iH;
-              P_ij -= m_ij * /*sic!*/ S_i;
-            }
+              } else {
 
-            /*
-             * Compute high-order fluxes and source terms:
-             */
+                U_i_new += tau * m_i_inv * d_ij * (U_j - U_i);
+                F_iH += d_ijH * (U_j - U_i);
+                P_ij += (d_ijH - d_ij) * (U_j - U_i);
 
-            if constexpr (View::have_high_order_flux) {
-              const auto high_order_flux_ij =
-                  view.high_order_flux(flux_i, flux_j);
-              F_iH += weight * contract(high_order_flux_ij, c_ij);
-              P_ij += weight * contract(high_order_flux_ij, c_ij);
-            } else {
-              F_iH += weight * contract(flux_ij, c_ij);
-              P_ij += weight * contract(flux_ij, c_ij);
-            }
+                limiter.accumulate(js, U_j, flux_j, d_ij_inv * c_ij, beta_ij);
+              }
 
-            if constexpr (View::have_source_terms) {
-              // FIXME: Chain through correct time
-              constexpr Number t = 0.;
-              const auto contribution =
-                  view.high_order_source(new_precomputed, js, U_j, t, tau);
-              F_iH += weight * m_ij * contribution;
-              P_ij += weight * m_ij * contribution;
-            }
+              if constexpr (View::have_source_terms) {
+                F_iH -= m_ij * S_iH;
+                P_ij -= m_ij * /*sic!*/ S_i;
+              }
 
-            for (int s = 0; s < stages; ++s) {
-              const auto U_jH = stage_U[s].get().template get_tensor<T>(js);
-              const auto p = view.flux_contribution(
-                  stage_precomputed[s].get(), precomputed_initial_, js, U_jH);
+              /*
+               * Compute high-order fluxes and source terms:
+               */
 
               if constexpr (View::have_high_order_flux) {
                 const auto high_order_flux_ij =
-                    view.high_order_flux(flux_iHs[s], p);
-                F_iH += stage_weights[s] * contract(high_order_flux_ij, c_ij);
-                P_ij += stage_weights[s] * contract(high_order_flux_ij, c_ij);
+                    view.high_order_flux(flux_i, flux_j);
+                F_iH += weight * contract(high_order_flux_ij, c_ij);
+                P_ij += weight * contract(high_order_flux_ij, c_ij);
               } else {
-                const auto flux_ij = view.flux(flux_iHs[s], p);
-                F_iH += stage_weights[s] * contract(flux_ij, c_ij);
-                P_ij += stage_weights[s] * contract(flux_ij, c_ij);
+                F_iH += weight * contract(flux_ij, c_ij);
+                P_ij += weight * contract(flux_ij, c_ij);
               }
 
               if constexpr (View::have_source_terms) {
                 // FIXME: Chain through correct time
                 constexpr Number t = 0.;
-                const auto contribution = view.high_order_source(
-                    stage_precomputed[s].get(), js, U_jH, t, tau);
-                F_iH += stage_weights[s] * m_ij * contribution;
-                P_ij += stage_weights[s] * m_ij * contribution;
+                const auto contribution =
+                    view.high_order_source(new_precomputed, js, U_j, t, tau);
+                F_iH += weight * m_ij * contribution;
+                P_ij += weight * m_ij * contribution;
               }
-            }
 
-            pij_matrix_.write_tensor(P_ij, i, col_idx, true);
-          }
+              for (int s = 0; s < stages; ++s) {
+                const auto U_jH = stage_U[s].get().template get_tensor<T>(js);
+                const auto p = get_flux_j(
+                    s + 1, stage_precomputed[s].get(), i, col_idx, js, U_jH);
+
+                if constexpr (View::have_high_order_flux) {
+                  const auto high_order_flux_ij =
+                      view.high_order_flux(flux_iHs[s], p);
+                  F_iH += stage_weights[s] * contract(high_order_flux_ij, c_ij);
+                  P_ij += stage_weights[s] * contract(high_order_flux_ij, c_ij);
+                } else {
+                  const auto flux_ij = view.flux(flux_iHs[s], p);
+                  F_iH += stage_weights[s] * contract(flux_ij, c_ij);
+                  P_ij += stage_weights[s] * contract(flux_ij, c_ij);
+                }
+
+                if constexpr (View::have_source_terms) {
+                  // FIXME: Chain through correct time
+                  constexpr Number t = 0.;
+                  const auto contribution = view.high_order_source(
+                      stage_precomputed[s].get(), js, U_jH, t, tau);
+                  F_iH += stage_weights[s] * m_ij * contribution;
+                  P_ij += stage_weights[s] * m_ij * contribution;
+                }
+              }
+
+              pij_matrix_.write_tensor(P_ij, i, col_idx, true);
+            }
+          });
 
 #ifdef CHECK_BOUNDS
-          if (!view.is_admissible(U_i_new)) {
+          if (!view.is_admissible(accumulated_value(U_i_new))) {
+            restart_needed = true;
+          }
+#else
+          /*
+           * Verify reused wave speed estimates (see Step 2) a posteriori
+           * independently of the limiter: If the low-order update is not
+           * admissible the step is repeated with recomputed estimates:
+           */
+          if (reuse_wave_speeds &&
+              !view.is_admissible(accumulated_value(U_i_new))) {
             restart_needed = true;
           }
 #endif
 
-          new_U.template write_tensor<T>(U_i_new, i);
-          r_.template write_tensor<T>(F_iH, i);
+          new_U.template write_tensor<T>(combine(accumulated_value(U_i_new)),
+                                         i);
+          r_.template write_tensor<T>(accumulated_value(F_iH), i);
 
           const auto hd_i = m_i * measure_of_omega_inverse;
-          const auto relaxed_bounds = limiter.bounds(hd_i);
+          if (lagged_indicator_)
+            store_value<T>(lagged_alpha_, indicator.alpha(hd_i), i);
+
+          auto relaxed_bounds = limiter.bounds(hd_i);
+#ifdef MIXED_PRECISION_BOUNDS
+          for (unsigned int d = 0; d < n_bounds; ++d)
+            relaxed_bounds[d] = round_to_float(relaxed_bounds[d],
+                                               Limiter::bounds_rounding[d]);
+#endif
           bounds_.template write_tensor<T>(relaxed_bounds, i);
         }
       };
 
       /* Parallel non-vectorized loop: */
       loop(Number(), n_internal, n_owned);
+      if (!overlap_scalar_loop_) {
+        RYUJIN_OMP_BARRIER
+      }
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      /* Synchronize tau max over all threads: */
+      Number current_tau_max = tau_max.load();
+      while (current_tau_max > local_tau_max &&
+             !tau_max.compare_exchange_weak(current_tau_max, local_tau_max))
+        ;
+
+      LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+      region.thread_done();
       RYUJIN_PARALLEL_REGION_END
+      region.stop();
+      region.synchronize(synchronization_dispatch);
+
+      if (lagged_indicator_)
+        lagged_alpha_valid_ = true;
     }
 
     /*
@@ -765,16 +2254,34 @@ namespace ryujin
      * -------------------------------------------------------------------------
      */
 
+    /* Limiter activity of the first pass, see n_limited_edges(): */
+    std::atomic<unsigned long long> n_limited_edges{0};
+    std::atomic<unsigned long long> n_edges{0};
+    std::array<unsigned long long, 4> limiter_histogram{{0, 0, 0, 0}};
+    unsigned long long n_bounds_violations = 0;
+
     if (limiter_iter_ != 0) {
-      Scope scope(computing_timer_, scoped_name("compute p_ij, and l_ij"));
+      const auto scope = scoped_timer("compute p_ij, and l_ij");
+
+      /*
+       * Column indices, m_ij, p_ij (read and written), l_ij (written),
+       * bounds, new U_i, r_i, and m_i^-1:
+       */
+      account_traffic(
+          entries * (bytes_column_index + bytes_number + bytes_lij +
+                     2. * bytes_state) +
+          rows * (bytes_bounds + 2. * bytes_state + bytes_number));
+      if (lumped_high_order_)
+        account_traffic(-entries * bytes_number);
 
       SynchronizationDispatch synchronization_dispatch([&]() {
         lij_matrix_.update_ghost_rows_start(channel++);
         lij_matrix_.update_ghost_rows_finish();
       });
 
+      const auto region = profiler_region();
       RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_START(current_step->likwid_name.c_str());
 
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
@@ -790,18 +2297,49 @@ namespace ryujin
                         limiter_newton_tolerance_,
                         limiter_newton_max_iter_);
         bool thread_ready = false;
+        std::vector<unsigned int> column_buffer(
+            sparsity_simd.column_buffer_size());
+        unsigned long long thread_n_limited_edges = 0;
+        unsigned long long thread_n_edges = 0;
+        std::array<unsigned long long, 4> thread_histogram{{0, 0, 0, 0}};
+        unsigned long long thread_n_bounds_violations = 0;
+
+        /* Sort a limiter coefficient into the bins of limiter_histogram: */
+        const auto record = [&](const Number l_ij) {
+          thread_histogram[l_ij <= Number(0.)    ? 0
+                           : l_ij < Number(0.5) ? 1
+                           : l_ij < Number(1.)  ? 2
+                                                : 3]++;
+        };
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
 
-          /* Skip constrained degrees of freedom: */
+        /* Constrained degrees of freedom are not in active_rows(): */
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
           const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
+          const unsigned int *columns_i =
+              sparsity_simd.columns(i, column_buffer.data());
 
           synchronization_dispatch.check(
               thread_ready, i >= n_export_indices && i < n_internal);
 
+          if (dry_stride(i)) {
+            /*
+             * Do not limit the edges of a dry stride but simply discard
+             * the antidiffusive fluxes. The symmetrization in Step 6
+             * ensures that the neighboring rows do the same:
+             */
+            for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx)
+              lij_matrix_.template write_entry<T>(T(0.), i, col_idx, true);
+            continue;
+          }
+
+          T n_limited_row = T(0.);
+
           const auto bounds =
               bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
 
@@ -815,24 +2353,29 @@ namespace ryujin
           const auto factor = tau * m_i_inv * lambda_inv;
 
           /* Skip diagonal. */
-          const unsigned int *js = sparsity_simd.columns(i) + stride_size;
+          const unsigned int *js = columns_i + stride_size;
           for (unsigned int col_idx = 1; col_idx < row_length;
                ++col_idx, js += stride_size) {
 
+            auto P_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
+
             /*
-             * Mass matrix correction:
+             * Mass matrix correction (b_ij = b_ji = 0 for the lumped mass
+             * matrix):
              */
 
-            const auto m_j_inv = load_value<T>(lumped_mass_matrix_inverse, js);
-            const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
+            if (!lumped_high_order_) {
+              const auto m_j_inv =
+                  load_value<T>(lumped_mass_matrix_inverse, js);
+              const auto m_ij = mass_matrix.template get_entry<T>(i, col_idx);
 
-            const auto b_ij = (col_idx == 0 ? T(1.) : T(0.)) - m_ij * m_j_inv;
-            /* m_ji = m_ij  so let's simply use m_ij: */
-            const auto b_ji = (col_idx == 0 ? T(1.) : T(0.)) - m_ij * m_i_inv;
+              const auto b_ij = (col_idx == 0 ? T(1.) : T(0.)) - m_ij * m_j_inv;
+              /* m_ji = m_ij  so let's simply use m_ij: */
+              const auto b_ji = (col_idx == 0 ? T(1.) : T(0.)) - m_ij * m_i_inv;
 
-            auto P_ij = pij_matrix_.template get_tensor<T>(i, col_idx);
-            const auto F_jH = r_.template get_tensor<T>(js);
-            P_ij += b_ij * F_jH - b_ji * F_iH;
+              const auto F_jH = r_.template get_tensor<T>(js);
+              P_ij += b_ij * F_jH - b_ji * F_iH;
+            }
             P_ij *= factor;
             pij_matrix_.write_tensor(P_ij, i, col_idx);
 
@@ -843,6 +2386,19 @@ namespace ryujin
             const auto &[l_ij, success] = limiter.limit(bounds, U_i_new, P_ij);
             lij_matrix_.template write_entry<T>(l_ij, i, col_idx, true);
 
+            n_limited_row += dealii::compare_and_apply_mask<
+                dealii::SIMDComparison::less_than>(l_ij, T(1.), T(1.), T(0.));
+
+            if (solver_statistics_) {
+              if constexpr (std::is_same_v<T, Number>) {
+                record(l_ij);
+              } else {
+                for (unsigned int k = 0; k < simd_length; ++k)
+                  record(l_ij[k]);
+              }
+              thread_n_bounds_violations += success ? 0 : 1;
+            }
+
             /*
              * If the success is set to false then the low-order update
              * resulted in a state outside of the limiter bounds. This can
@@ -855,16 +2411,63 @@ namespace ryujin
             if (!success)
               restart_needed = true;
           }
+
+          if constexpr (std::is_same_v<T, Number>) {
+            thread_n_limited_edges += static_cast<unsigned int>(n_limited_row);
+          } else {
+            for (unsigned int k = 0; k < simd_length; ++k)
+              thread_n_limited_edges +=
+                  static_cast<unsigned int>(n_limited_row[k]);
+          }
+          thread_n_edges += (row_length - 1) * stride_size;
+        }
+
+        n_limited_edges += thread_n_limited_edges;
+        n_edges += thread_n_edges;
+
+        if (solver_statistics_) {
+          RYUJIN_OMP_CRITICAL
+          {
+            for (unsigned int k = 0; k < 4; ++k)
+              limiter_histogram[k] += thread_histogram[k];
+            n_bounds_violations += thread_n_bounds_violations;
+          }
         }
       };
 
       /* Parallel non-vectorized loop: */
       loop(Number(), n_internal, n_owned);
+      if (!overlap_scalar_loop_) {
+        RYUJIN_OMP_BARRIER
+      }
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+      region.thread_done();
       RYUJIN_PARALLEL_REGION_END
+      region.stop();
+      region.synchronize(synchronization_dispatch);
+    }
+
+    /*
+     * Adaptive limiter iterations: In smooth phases of a simulation the
+     * first limiter pass limits almost no edges and a second pass would
+     * not change the high-order update in any meaningful way. We thus
+     * skip the second pass (and the associated sweep and ghost exchange)
+     * if the global fraction of limited edges is below the threshold.
+     * This costs a single small allreduce per step.
+     */
+    unsigned int n_limiter_passes = limiter_iter_;
+    if (limiter_iter_ == 2 && limiter_adaptive_threshold_ > Number(0.)) {
+      const std::array<double, 2> local_values{
+          {double(n_limited_edges.load()), double(n_edges.load())}};
+      std::array<double, 2> values;
+      Utilities::MPI::sum(ArrayView<const double>(local_values),
+                          mpi_communicator_,
+                          ArrayView<double>(values));
+      if (values[0] < double(limiter_adaptive_threshold_) * values[1])
+        n_limiter_passes = 1;
     }
 
     /*
@@ -874,62 +2477,86 @@ namespace ryujin
      *   Symmetrize l_ij
      *   High-order update: += l_ij * lambda * P_ij
      *   Compute next l_ij
+     *
+     * For a further limiter pass we replace p_ij by the remaining part
+     * (1 - l_ij) * p_ij row locally (p_ij is never accessed transposed)
+     * and, after all threads finished symmetrizing, compute the next
+     * l_ij in place. This way the second pass does not need a second
+     * l_ij matrix:
      * -------------------------------------------------------------------------
      */
 
-    for (unsigned int pass = 0; pass < limiter_iter_; ++pass) {
-      bool last_round = (pass + 1 == limiter_iter_);
+    for (unsigned int pass = 0; pass < n_limiter_passes; ++pass) {
+      bool last_round = (pass + 1 == n_limiter_passes);
 
-      std::string additional_step = (last_round ? "" : ", next l_ij");
-      Scope scope(
-          computing_timer_,
-          scoped_name("symmetrize l_ij, h.-o. update" + additional_step));
+      const auto scope =
+          scoped_timer(last_round ? "symmetrize l_ij, h.-o. update"
+                                  : "symmetrize l_ij, h.-o. update, next l_ij");
 
-      if ((limiter_iter_ == 2) && last_round) {
-        std::swap(lij_matrix_, lij_matrix_next_);
-      }
+      /*
+       * Column indices, l_ij and l_ji, p_ij, new U_i (read and written),
+       * and for a further limiter pass: p_ij (written and read again),
+       * bounds, and next l_ij:
+       */
+      account_traffic(entries * (bytes_index + 2. * bytes_lij +
+                                 bytes_state) +
+                      rows * 2. * bytes_state);
+      if (!last_round)
+        account_traffic(entries * (bytes_lij + 2. * bytes_state) +
+                        rows * (bytes_bounds + bytes_state));
+      else if (combination_U != nullptr)
+        account_traffic(rows * bytes_state);
 
       SynchronizationDispatch synchronization_dispatch([&]() {
         if (!last_round) {
-          lij_matrix_next_.update_ghost_rows_start(channel++);
-          lij_matrix_next_.update_ghost_rows_finish();
+          lij_matrix_.update_ghost_rows_start(channel++);
+          lij_matrix_.update_ghost_rows_finish();
         }
       });
 
+      const auto region = profiler_region();
       RYUJIN_PARALLEL_REGION_BEGIN
-      LIKWID_MARKER_START(("time_step_" + std::to_string(step_no)).c_str());
+      LIKWID_MARKER_START(current_step->likwid_name.c_str());
 
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
-        using View = typename HyperbolicSystem::template View<dim, T>;
-        using Limiter = typename Description::template Limiter<dim, T>;
-
         unsigned int stride_size = get_stride_size<T>;
 
-        /* Stored thread locally: */
-        AlignedVector<T> lij_row;
-        Limiter limiter(*hyperbolic_system_,
-                        new_precomputed,
-                        limiter_relaxation_factor_,
-                        limiter_newton_tolerance_,
-                        limiter_newton_max_iter_);
-        bool thread_ready = false;
-
-        RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
 
-          /* Skip constrained degrees of freedom: */
+        /* Constrained degrees of freedom are not in active_rows(): */
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
           const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
 
-          synchronization_dispatch.check(
-              thread_ready, i >= n_export_indices && i < n_internal);
+          /*
+           * Fused convex combination with combination_U for the final
+           * high-order update:
+           */
+          const auto combine = [&](const auto &U_i_new) {
+            if (!last_round || combination_U == nullptr)
+              return U_i_new;
+            const auto U_i_c = combination_U->template get_tensor<T>(i);
+            return T(combination_weight) * U_i_new +
+                   T(Number(1.) - combination_weight) * U_i_c;
+          };
+
+          /* Dry strides: l_ij = 0, and U_i_new has already been written: */
+          if (dry_stride(i)) {
+            if (last_round && combination_U != nullptr)
+              new_U.template write_tensor<T>(
+                  combine(new_U.template get_tensor<T>(i)), i);
+            continue;
+          }
 
-          auto U_i_new = new_U.template get_tensor<T>(i);
+          using state_type = decltype(new_U.template get_tensor<T>(i));
+          accumulator_type<state_type> U_i_new =
+              new_U.template get_tensor<T>(i);
 
           const Number lambda = Number(1.) / Number(row_length - 1);
-          lij_row.resize_fast(row_length);
 
           /* Skip diagonal. */
           for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
@@ -943,33 +2570,78 @@ namespace ryujin
             U_i_new += l_ij * lambda * p_ij;
 
             if (!last_round)
-              lij_row[col_idx] = l_ij;
+              pij_matrix_.write_tensor((T(1.) - l_ij) * p_ij, i, col_idx);
           }
 
 #ifdef CHECK_BOUNDS
           const auto view = hyperbolic_system_->template view<dim, T>();
-          if (!view.is_admissible(U_i_new)) {
+          if (!view.is_admissible(accumulated_value(U_i_new))) {
             restart_needed = true;
           }
 #endif
 
-          new_U.template write_tensor<T>(U_i_new, i);
+          new_U.template write_tensor<T>(combine(accumulated_value(U_i_new)),
+                                         i);
+        }
+      };
+
+      auto loop_next = [&](auto sentinel,
+                           unsigned int left,
+                           unsigned int right) {
+        using T = decltype(sentinel);
+        using Limiter = typename Description::template Limiter<dim, T>;
+
+        unsigned int stride_size = get_stride_size<T>;
+
+        /* Stored thread locally: */
+        Limiter limiter(*hyperbolic_system_,
+                        new_precomputed,
+                        limiter_relaxation_factor_,
+                        limiter_newton_tolerance_,
+                        limiter_newton_max_iter_);
+        bool thread_ready = false;
+
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
 
-          /* Skip computating l_ij and updating p_ij in the last round */
-          if (last_round)
+        /* Constrained degrees of freedom are not in active_rows(): */
+        RYUJIN_OMP_FOR_RUNTIME_NOWAIT
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
+          const unsigned int row_length = sparsity_simd.row_length(i);
+
+          synchronization_dispatch.check(
+              thread_ready, i >= n_export_indices && i < n_internal);
+
+          /* Keep l_ij = 0 for dry strides: */
+          if (dry_stride(i))
             continue;
 
+          const auto U_i_new = new_U.template get_tensor<T>(i);
+
           const auto bounds =
               bounds_.template get_tensor<T, std::array<T, n_bounds>>(i);
           /* Skip diagonal. */
           for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
 
-            const auto old_l_ij = lij_row[col_idx];
-
             const auto new_p_ij =
-                (T(1.) - old_l_ij) *
                 pij_matrix_.template get_tensor<T>(i, col_idx);
 
+#ifndef CHECK_BOUNDS
+            /*
+             * If the symmetrized l_ij of the first pass was one (in all
+             * SIMD lanes) the remaining antidiffusive flux vanishes and
+             * the limiter would simply return one. We thus skip the
+             * limiter. In smooth regions this is the case for the vast
+             * majority of edges.
+             */
+            if (all_zero<T>(new_p_ij.norm_square())) {
+              lij_matrix_.write_entry(T(1.), i, col_idx, true);
+              continue;
+            }
+#endif
+
             const auto &[new_l_ij, success] =
                 limiter.limit(bounds, U_i_new, new_p_ij);
 
@@ -989,24 +2661,42 @@ namespace ryujin
 #endif
 
             /*
-             * Shortcut: We omit updating the p_ij and q_ij matrices and
-             * simply write (1 - l_ij^(1)) * l_ij^(2) into the l_ij matrix.
-             *
-             * This approach only works for at most two limiting steps.
+             * The l_ij of the first pass are no longer needed (the
+             * symmetrization above has been completed by all threads),
+             * so we simply overwrite them. This approach only works for
+             * at most two limiting steps.
              */
-            const auto entry = (T(1.) - old_l_ij) * new_l_ij;
-            lij_matrix_next_.write_entry(entry, i, col_idx, true);
+            lij_matrix_.write_entry(new_l_ij, i, col_idx, true);
           }
         }
       };
 
       /* Parallel non-vectorized loop: */
       loop(Number(), n_internal, n_owned);
+      if (!overlap_scalar_loop_) {
+        RYUJIN_OMP_BARRIER
+      }
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
-      LIKWID_MARKER_STOP(("time_step_" + std::to_string(step_no)).c_str());
+      if (!last_round) {
+        /*
+         * The barrier guarantees that all symmetrized l_ij have been
+         * computed before we overwrite them:
+         */
+        RYUJIN_OMP_BARRIER
+        loop_next(Number(), n_internal, n_owned);
+        if (!overlap_scalar_loop_) {
+          RYUJIN_OMP_BARRIER
+        }
+        loop_next(VA(), 0, n_internal);
+      }
+
+      LIKWID_MARKER_STOP(current_step->likwid_name.c_str());
+      region.thread_done();
       RYUJIN_PARALLEL_REGION_END
+      region.stop();
+      region.synchronize(synchronization_dispatch);
     } /* limiter_iter_ */
 
     /* Update sources: */
@@ -1016,8 +2706,54 @@ namespace ryujin
 
     /* Do we have to restart? */
 
-    restart_needed.store(
-        Utilities::MPI::logical_or(restart_needed.load(), mpi_communicator_));
+    {
+      Scope scope(*barrier.timer, barrier.name);
+
+      if (tau_prescribed) {
+        /* Fused reduction of (deferred) tau_max and the restart flag: */
+        const std::array<Number, 2> local_values{
+            tau_max.load(), restart_needed ? Number(-1.) : Number(0.)};
+        std::array<Number, 2> values;
+        Utilities::MPI::min(ArrayView<const Number>(local_values),
+                            mpi_communicator_,
+                            ArrayView<Number>(values));
+        tau_max.store(values[0]);
+        restart_needed.store(values[1] < Number(0.));
+        check_tau_max();
+
+      } else {
+        restart_needed.store(Utilities::MPI::logical_or(restart_needed.load(),
+                                                        mpi_communicator_));
+      }
+    }
+
+    if (restart_needed && reuse_wave_speeds) {
+      /*
+       * The low-order update, or the limiter, detected an invariant
+       * domain violation with reused wave speed estimates. Repeat the
+       * step with recomputed estimates before taking any further
+       * action. The failed attempt also overwrote the lagged indicator,
+       * so that we recompute it as well:
+       */
+      reference_valid_ = false;
+      lagged_alpha_valid_ = false;
+      return step<stages>(old_U,
+                          stage_U,
+                          stage_precomputed,
+                          stage_weights,
+                          new_U,
+                          new_precomputed,
+                          tau,
+                          combination_U,
+                          combination_weight);
+    }
+
+    /* Only account for the limiter statistics of the final attempt: */
+    n_limited_edges_ += n_limited_edges.load();
+    n_edges_ += n_edges.load();
+    for (unsigned int k = 0; k < 4; ++k)
+      limiter_histogram_[k] += limiter_histogram[k];
+    n_bounds_violations_ += n_bounds_violations;
 
     if (restart_needed) {
       switch (id_violation_strategy_) {
@@ -1030,8 +2766,11 @@ namespace ryujin
       }
     }
 
-    /* Return tau_max: */
-    return tau_max;
+    if (tau_prescribed)
+      tau_ratio_ = std::min(tau_ratio_, Number(tau_max.load() / tau));
+
+    /* Return tau_max (or the bounded time-step size): */
+    return tau_prescribed ? tau_max.load() : tau;
   }
 
   /*
@@ -1058,37 +2797,135 @@ namespace ryujin
 
     LIKWID_MARKER_START(("time_step_" + std::to_string(cycle_number)).c_str());
 
-    const auto &boundary_map = offline_data_->boundary_map();
+    const auto &boundary_table = offline_data_->boundary_table();
+
+    /*
+     * Evaluate the Dirichlet data of all Dirichlet and dynamic boundary
+     * degrees of freedom at once. Time-independent data is only computed
+     * once:
+     */
+    if (!dirichlet_points_.empty() &&
+        (initial_values_->time_dependent() || !dirichlet_data_valid_)) {
+      initial_values_->initial_states(dirichlet_points_, t, dirichlet_data_);
+      dirichlet_data_valid_ = true;
+    }
+
+    RYUJIN_PARALLEL_REGION_BEGIN
 
-    for (auto entry : boundary_map) {
-      const auto i = entry.first;
+    const auto view = hyperbolic_system_->template view<dim, Number>();
 
-      const auto &[normal, normal_mass, boundary_mass, id, position] =
-          entry.second;
+    RYUJIN_OMP_FOR
+    for (unsigned int k = 0; k < boundary_table.size(); ++k) {
+      const auto i = boundary_table.index[k];
 
       /*
-       * Relay the task of applying appropriate boundary conditions to the
-       * Problem Description.
+       * A row might have more than one boundary description. Process all
+       * of them in order (and by the same thread) when encountering the
+       * first one:
        */
-
-      if (id == Boundary::do_nothing)
+      if (k != boundary_table.begin(i))
         continue;
 
       auto U_i = U.get_tensor(i);
 
-      /* Use a lambda to avoid computing unnecessary state values */
-      auto get_dirichlet_data = [position = position, t = t, this]() {
-        return initial_values_->initial_state(position, t);
-      };
+      for (unsigned int b = k; b < boundary_table.end(i); ++b) {
+        const auto id = boundary_table.id[b];
+
+        /*
+         * Relay the task of applying appropriate boundary conditions to
+         * the Problem Description.
+         */
+
+        if (id == Boundary::do_nothing)
+          continue;
+
+        const auto get_dirichlet_data = [&]() {
+          Assert(dirichlet_index_[b] != numbers::invalid_unsigned_int,
+                 ExcInternalError());
+          return dirichlet_data_[dirichlet_index_[b]];
+        };
+
+        U_i = view.apply_boundary_conditions(
+            id, U_i, boundary_table.normal[b], get_dirichlet_data);
+      }
 
-      const auto view = hyperbolic_system_->template view<dim, Number>();
-      U_i = view.apply_boundary_conditions(id, U_i, normal, get_dirichlet_data);
       U.write_tensor(U_i, i);
     }
 
+    RYUJIN_PARALLEL_REGION_END
+
     LIKWID_MARKER_STOP(("time_step_" + std::to_string(cycle_number)).c_str());
 
     U.update_ghost_values();
   }
 
+
+  template <typename Description, int dim, typename Number>
+  std::vector<double>
+  HyperbolicModule<Description, dim, Number>::local_time_step_levels(
+      const unsigned int n_levels) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "HyperbolicModule<Description, dim, "
+                 "Number>::local_time_step_levels()"
+              << std::endl;
+#endif
+
+    Assert(n_levels > 0, dealii::ExcInternalError());
+
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
+    const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
+    const auto &boundary_table = offline_data_->boundary_table();
+
+    /*
+     * The local admissible step size reads tau_i = cfl * m_i / (2 |d_ii|).
+     * The CFL number cancels in the ratio tau_i / tau_min, so we simply
+     * classify m_i / |d_ii|:
+     */
+
+    const auto skip = [&](const unsigned int i) {
+      return sparsity_simd.row_length(i) == 1 ||
+             (boundary_table.is_boundary(i) && !cfl_with_boundary_dofs_);
+    };
+
+    /*
+     * Rows with a vanishing diagonal (for example a state at rest) impose
+     * no step size restriction and are skipped as well. We mark them (and
+     * all rows with a non-finite ratio) with a zero ratio:
+     */
+
+    std::vector<Number> ratios(n_owned, Number(0.));
+    Number ratio_min = std::numeric_limits<Number>::max();
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      if (skip(i))
+        continue;
+      const Number d_ii = dij_matrix_.get_entry(i, 0);
+      const Number ratio =
+          lumped_mass_matrix.local_element(i) / std::abs(d_ii);
+      if (d_ii == Number(0.) || !std::isfinite(ratio) || !(ratio > 0.))
+        continue;
+      ratios[i] = ratio;
+      ratio_min = std::min(ratio_min, ratio);
+    }
+
+    ratio_min = Utilities::MPI::min(ratio_min, mpi_communicator_);
+
+    std::vector<double> levels(n_levels, 0.);
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      if (ratios[i] == Number(0.))
+        continue;
+      /* Clamp before the conversion to avoid overflowing the cast: */
+      const double level = std::min(
+          std::max(std::log2(double(ratios[i]) / double(ratio_min)), 0.),
+          double(n_levels - 1));
+      levels[static_cast<unsigned int>(level)] += 1.;
+    }
+
+    std::vector<double> result(n_levels, 0.);
+    Utilities::MPI::sum(levels, mpi_communicator_, result);
+
+    return result;
+  }
+
 } /* namespace ryujin */
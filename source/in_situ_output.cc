@@ -0,0 +1,16 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#include "in_situ_output.template.h"
+#include <instantiate.h>
+
+namespace ryujin
+{
+  /* instantiations */
+  template class InSituOutput<Description, 1, NUMBER>;
+  template class InSituOutput<Description, 2, NUMBER>;
+  template class InSituOutput<Description, 3, NUMBER>;
+
+} /* namespace ryujin */
@@ -0,0 +1,132 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "hyperbolic_module.h"
+#include "offline_data.h"
+#include "postprocessor.h"
+
+#include <deal.II/base/parameter_acceptor.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+
+  /**
+   * The InSituOutput class implements an adaptor for in-situ
+   * visualization with ParaView Catalyst (version 2).
+   *
+   * Instead of writing out vtu files the conserved state vector and all
+   * postprocessed quantities are handed over to Catalyst for every
+   * output cycle, which then runs a set of user supplied Python
+   * pipelines (for example rendering slices or iso-surfaces). The field
+   * data is passed without copying: The (interleaved) components of the
+   * MultiComponentVector and the scalar postprocessor vectors are
+   * described as strided external arrays over all locally relevant
+   * degrees of freedom. Vertex coordinates and the cell connectivity
+   * are only recomputed in prepare(), i.e., after the mesh changed.
+   *
+   * The adaptor is only functional if ryujin was configured with
+   * WITH_CATALYST; it is restricted to Q1 finite elements where the
+   * degrees of freedom coincide with the vertices of the mesh.
+   *
+   * @ingroup TimeLoop
+   */
+  template <typename Description, int dim, typename Number = double>
+  class InSituOutput final : public dealii::ParameterAcceptor
+  {
+    /**
+     * @copydoc HyperbolicSystem
+     */
+    using HyperbolicSystem = typename Description::HyperbolicSystem;
+
+    /**
+     * @copydoc HyperbolicSystem::View
+     */
+    using HyperbolicSystemView =
+        typename Description::HyperbolicSystem::template View<dim, Number>;
+
+  public:
+    /**
+     * @copydoc HyperbolicSystem::problem_dimension
+     */
+    static constexpr unsigned int problem_dimension =
+        HyperbolicSystemView::problem_dimension;
+
+    /**
+     * Typedef for a MultiComponentVector storing the state U.
+     */
+    using vector_type = MultiComponentVector<Number, problem_dimension>;
+
+    /**
+     * Constructor.
+     */
+    InSituOutput(const MPI_Comm &mpi_communicator,
+                 const OfflineData<dim, Number> &offline_data,
+                 const Postprocessor<Description, dim, Number> &postprocessor,
+                 const std::string &subsection = "/InSituOutput");
+
+    /**
+     * Destructor. Finalizes Catalyst if it was initialized.
+     */
+    ~InSituOutput();
+
+    /**
+     * Prepare in-situ output. The function initializes Catalyst (on first
+     * invocation) and recomputes vertex coordinates and the cell
+     * connectivity of the locally owned part of the mesh.
+     */
+    void prepare();
+
+    /**
+     * Given a state vector @p U, a channel name @p name, the current time
+     * @p t, and the current output cycle @p cycle, pass the state and all
+     * postprocessed quantities to the in-situ pipelines. The postprocessor
+     * quantities must have been computed prior to calling this function.
+     * Both @p U and the postprocessor quantities must have updated ghost
+     * values.
+     *
+     * The function requires MPI communication and is not reentrant.
+     */
+    void execute(const vector_type &U,
+                 const std::string &name,
+                 Number t,
+                 unsigned int cycle);
+
+  private:
+    /**
+     * @name Run time options
+     */
+    //@{
+
+    std::vector<std::string> catalyst_scripts_;
+
+    //@}
+    /**
+     * @name Internal data
+     */
+    //@{
+
+    const MPI_Comm &mpi_communicator_;
+
+    dealii::SmartPointer<const OfflineData<dim, Number>> offline_data_;
+    dealii::SmartPointer<const Postprocessor<Description, dim, Number>>
+        postprocessor_;
+
+    bool initialized_;
+
+    std::vector<double> coordinates_;
+    std::vector<std::int64_t> connectivity_;
+
+    //@}
+  };
+
+} /* namespace ryujin */
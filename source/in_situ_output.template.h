@@ -0,0 +1,206 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "in_situ_output.h"
+#include "local_index_handling.h"
+
+#ifdef WITH_CATALYST
+#include <catalyst.hpp>
+#endif
+
+#include <array>
+
+namespace ryujin
+{
+  using namespace dealii;
+
+
+  template <typename Description, int dim, typename Number>
+  InSituOutput<Description, dim, Number>::InSituOutput(
+      const MPI_Comm &mpi_communicator,
+      const OfflineData<dim, Number> &offline_data,
+      const Postprocessor<Description, dim, Number> &postprocessor,
+      const std::string &subsection /*= "InSituOutput"*/)
+      : ParameterAcceptor(subsection)
+      , mpi_communicator_(mpi_communicator)
+      , offline_data_(&offline_data)
+      , postprocessor_(&postprocessor)
+      , initialized_(false)
+  {
+    add_parameter("catalyst scripts",
+                  catalyst_scripts_,
+                  "List of ParaView Catalyst Python scripts that are executed "
+                  "for every in-situ output cycle");
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  InSituOutput<Description, dim, Number>::~InSituOutput()
+  {
+#ifdef WITH_CATALYST
+    if (initialized_) {
+      conduit_cpp::Node node;
+      catalyst_finalize(conduit_cpp::c_node(&node));
+    }
+#endif
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void InSituOutput<Description, dim, Number>::prepare()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "InSituOutput<dim, Number>::prepare()" << std::endl;
+#endif
+
+#ifndef WITH_CATALYST
+    AssertThrow(false,
+                ExcMessage("In-situ output requires ryujin to be configured "
+                           "with ParaView Catalyst support (WITH_CATALYST)"));
+#else
+    const auto &discretization = offline_data_->discretization();
+    AssertThrow(discretization.finite_element().degree == 1,
+                ExcMessage("In-situ output is only implemented for Q1 finite "
+                           "elements"));
+
+    if (!initialized_) {
+      conduit_cpp::Node node;
+      for (unsigned int s = 0; s < catalyst_scripts_.size(); ++s)
+        node["catalyst/scripts/script" + std::to_string(s)].set_string(
+            catalyst_scripts_[s]);
+      node["catalyst/mpi_comm"].set(MPI_Comm_c2f(mpi_communicator_));
+
+      const auto status = catalyst_initialize(conduit_cpp::c_node(&node));
+      AssertThrow(status == catalyst_status_ok,
+                  ExcMessage("Failed to initialize ParaView Catalyst"));
+      initialized_ = true;
+    }
+
+    /*
+     * Record the position of every locally relevant degree of freedom
+     * and the connectivity of all locally owned cells in local
+     * numbering. Vertices are reordered into VTK order:
+     */
+
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &scalar_partitioner = *offline_data_->scalar_partitioner();
+    const unsigned int n_relevant = offline_data_->n_locally_relevant();
+
+    constexpr unsigned int n_vertices = GeometryInfo<dim>::vertices_per_cell;
+    constexpr std::array<unsigned int, 8> vtk_order{0, 1, 3, 2, 4, 5, 7, 6};
+
+    coordinates_.assign(dim * n_relevant, 0.);
+    connectivity_.clear();
+
+    std::vector<types::global_dof_index> dof_indices(n_vertices);
+
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      cell->get_dof_indices(dof_indices);
+      transform_to_local_range(scalar_partitioner, dof_indices);
+
+      for (unsigned int v = 0; v < n_vertices; ++v) {
+        const auto index = dof_indices[v];
+        const auto vertex = cell->vertex(v);
+        for (unsigned int d = 0; d < dim; ++d)
+          coordinates_[dim * index + d] = vertex[d];
+      }
+
+      for (unsigned int v = 0; v < n_vertices; ++v)
+        connectivity_.push_back(dof_indices[dim == 1 ? v : vtk_order[v]]);
+    }
+#endif
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void
+  InSituOutput<Description, dim, Number>::execute(const vector_type &U,
+                                                  const std::string &name,
+                                                  Number t,
+                                                  unsigned int cycle)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "InSituOutput<dim, Number>::execute()" << std::endl;
+#endif
+
+#ifndef WITH_CATALYST
+    (void)U;
+    (void)name;
+    (void)t;
+    (void)cycle;
+#else
+    Assert(initialized_, ExcInternalError());
+
+    const unsigned int n_relevant = offline_data_->n_locally_relevant();
+
+    conduit_cpp::Node node;
+    node["catalyst/state/timestep"].set(cycle);
+    node["catalyst/state/time"].set(double(t));
+
+    auto channel = node["catalyst/channels/" + name];
+    channel["type"].set("mesh");
+
+    /* Mesh description (conduit mesh blueprint): */
+
+    auto mesh = channel["data"];
+    mesh["coordsets/coords/type"].set("explicit");
+
+    constexpr std::array<const char *, 3> names{"x", "y", "z"};
+    for (unsigned int d = 0; d < dim; ++d)
+      mesh["coordsets/coords/values/" + std::string(names[d])].set_external(
+          coordinates_.data(),
+          n_relevant,
+          d * sizeof(double),
+          dim * sizeof(double));
+
+    constexpr std::array<const char *, 3> shapes{"line", "quad", "hex"};
+    mesh["topologies/mesh/type"].set("unstructured");
+    mesh["topologies/mesh/coordset"].set("coords");
+    mesh["topologies/mesh/elements/shape"].set(shapes[dim - 1]);
+    mesh["topologies/mesh/elements/connectivity"].set_external(
+        connectivity_.data(), connectivity_.size());
+
+    /*
+     * Field data: The interleaved components of U and the postprocessed
+     * quantities are passed as (strided) external arrays:
+     */
+
+    const auto add_field = [&](const std::string &field_name,
+                               const Number *data,
+                               const unsigned int offset,
+                               const unsigned int stride) {
+      auto field = mesh["fields/" + field_name];
+      field["association"].set("vertex");
+      field["topology"].set("mesh");
+      field["volume_dependent"].set("false");
+      field["values"].set_external(
+          data, n_relevant, offset * sizeof(Number), stride * sizeof(Number));
+    };
+
+    for (unsigned int k = 0; k < problem_dimension; ++k)
+      add_field(HyperbolicSystemView::component_names[k],
+                U.begin(),
+                k,
+                vector_type::stride);
+
+    const auto n_quantities = postprocessor_->n_quantities();
+    for (unsigned int i = 0; i < n_quantities; ++i)
+      add_field(postprocessor_->component_names()[i],
+                postprocessor_->quantities()[i].begin(),
+                0,
+                1);
+
+    const auto status = catalyst_execute(conduit_cpp::c_node(&node));
+    AssertThrow(status == catalyst_status_ok,
+                ExcMessage("ParaView Catalyst pipeline execution failed"));
+#endif
+  }
+
+} /* namespace ryujin */
@@ -8,15 +8,44 @@
 #include <compile_time_options.h>
 
 #include "convenience_macros.h"
+#include "openmp.h"
 
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/tensor.h>
 
+#include <cctype>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace ryujin
 {
+  /**
+   * Return true if the function expression @p expression (in muparser
+   * syntax) references the time variable »t«.
+   *
+   * @ingroup InitialValues
+   */
+  inline bool expression_depends_on_time(const std::string &expression)
+  {
+    const auto is_identifier = [](const char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+
+    for (std::size_t k = 0; k < expression.size(); ++k) {
+      if (expression[k] != 't')
+        continue;
+      if (k > 0 && is_identifier(expression[k - 1]))
+        continue;
+      if (k + 1 < expression.size() && is_identifier(expression[k + 1]))
+        continue;
+      return true;
+    }
+
+    return false;
+  }
+
+
   /**
    * A small abstract base class to group configuration options for a
    * number of initial flow configurations.
@@ -63,6 +92,35 @@ namespace ryujin
      */
     virtual state_type compute(const dealii::Point<dim> &point, Number t) = 0;
 
+    /**
+     * Batched variant of compute(): compute the initial states for all
+     * points in @p points at time @p t and store them in @p states. The
+     * default implementation calls compute() for every point in parallel;
+     * compute() must thus be thread safe.
+     */
+    virtual void compute_list(const std::vector<dealii::Point<dim>> &points,
+                              Number t,
+                              std::vector<state_type> &states)
+    {
+      states.resize(points.size());
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int k = 0; k < points.size(); ++k)
+        states[k] = compute(points[k], t);
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    /**
+     * Return false if compute() does not depend on the time @p t. This
+     * allows to cache Dirichlet data. The default implementation returns
+     * true.
+     */
+    virtual bool time_dependent() const
+    {
+      return true;
+    }
+
     /**
      * Given a position @p point returns a precomputed value used for the
      * flux computation via HyperbolicSystem::flux_contribution().
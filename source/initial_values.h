@@ -14,6 +14,7 @@
 #include <deal.II/base/tensor.h>
 
 #include <functional>
+#include <vector>
 
 namespace ryujin
 {
@@ -107,9 +108,35 @@ namespace ryujin
     }
 
 
+    /**
+     * Batched variant of initial_state(): compute the initial states for
+     * all points in @p points at time @p t and store them in @p states.
+     * This is used to evaluate Dirichlet data for all boundary degrees of
+     * freedom at once.
+     */
+    void initial_states(const std::vector<dealii::Point<dim>> &points,
+                        Number t,
+                        std::vector<state_type> &states) const
+    {
+      initial_states_(points, t, states);
+    }
+
+
+    /**
+     * Return true if initial_state() depends on the time @p t. If false,
+     * Dirichlet data can be cached.
+     */
+    bool time_dependent() const
+    {
+      return time_dependent_();
+    }
+
+
     /**
      * This routine computes and returns a state vector populated with
-     * initial values for a specified time @p t.
+     * initial values for a specified time @p t. The initial state is
+     * evaluated only once per locally owned support point with a single
+     * call to initial_states().
      */
     vector_type interpolate(Number t = 0) const;
 
@@ -136,6 +163,13 @@ namespace ryujin
     interpolate_precomputed_initial_values() const;
 
   private:
+    /**
+     * Return the support points of all locally owned degrees of freedom
+     * in local numbering, see OfflineData::locally_owned_support_points().
+     */
+    const std::vector<dealii::Point<dim>> &
+    locally_owned_support_points() const;
+
     /**
      * @name Run time options
      */
@@ -164,6 +198,13 @@ namespace ryujin
     std::function<state_type(const dealii::Point<dim> &point, Number t)>
         initial_state_;
 
+    std::function<void(const std::vector<dealii::Point<dim>> &points,
+                       Number t,
+                       std::vector<state_type> &states)>
+        initial_states_;
+
+    std::function<bool()> time_dependent_;
+
     std::function<precomputed_state_type(const dealii::Point<dim> &point)>
         flux_contributions_;
 
@@ -6,11 +6,12 @@
 #pragma once
 
 #include "initial_values.h"
+#include "openmp.h"
 #include "simd.h"
 
-#include <deal.II/numerics/vector_tools.h>
-#include <deal.II/numerics/vector_tools.templates.h>
+#include <deal.II/dofs/dof_tools.h>
 
+#include <map>
 #include <random>
 
 namespace ryujin
@@ -178,6 +179,25 @@ namespace ryujin
             return state;
           };
 
+          initial_states_ = [this, &it](const auto &points,
+                                        Number t,
+                                        std::vector<state_type> &states) {
+            std::vector<dealii::Point<dim>> transformed_points(points.size());
+            for (unsigned int k = 0; k < points.size(); ++k)
+              transformed_points[k] = affine_transform(
+                  initial_direction_, initial_position_, points[k]);
+            it->compute_list(transformed_points, t, states);
+            const auto view = hyperbolic_system_->template view<dim, Number>();
+            for (auto &state : states)
+              state = view.apply_galilei_transform(
+                  state, [&](const auto &momentum) {
+                    return affine_transform_vector(initial_direction_,
+                                                   momentum);
+                  });
+          };
+
+          time_dependent_ = [&it]() { return it->time_dependent(); };
+
           flux_contributions_ = [this, &it](const dealii::Point<dim> &point) {
             const auto transformed_point =
                 affine_transform(initial_direction_, initial_position_, point);
@@ -214,10 +234,29 @@ namespace ryujin
 
         return state;
       };
+
+      /* Fall back to evaluating the perturbed states one by one: */
+      initial_states_ = [this](const auto &points,
+                               Number t,
+                               std::vector<state_type> &states) {
+        states.resize(points.size());
+        for (unsigned int k = 0; k < points.size(); ++k)
+          states[k] = initial_state_(points[k], t);
+      };
+
+      time_dependent_ = []() { return true; };
     }
   }
 
 
+  template <typename Description, int dim, typename Number>
+  const std::vector<dealii::Point<dim>> &
+  InitialValues<Description, dim, Number>::locally_owned_support_points() const
+  {
+    return offline_data_->locally_owned_support_points();
+  }
+
+
   template <typename Description, int dim, typename Number>
   auto InitialValues<Description, dim, Number>::interpolate(Number t) const
       -> vector_type
@@ -230,20 +269,25 @@ namespace ryujin
     vector_type U;
     U.reinit(offline_data_->vector_partitioner());
 
-    using scalar_type = typename OfflineData<dim, Number>::scalar_type;
+    /*
+     * Evaluate the initial state exactly once for every locally owned
+     * support point with a single (batched) call to initial_states().
+     * This allows the initial state configuration to parallelize (and
+     * vectorize) the evaluation, see InitialState::compute_list():
+     */
 
-    const auto callable = [&](const auto &p) { return initial_state(p, t); };
+    const auto &points = locally_owned_support_points();
+    std::vector<state_type> states;
+    initial_states(points, t, states);
 
-    scalar_type temp;
-    const auto scalar_partitioner = offline_data_->scalar_partitioner();
-    temp.reinit(scalar_partitioner);
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto &boundary_table = offline_data_->boundary_table();
 
-    for (unsigned int d = 0; d < problem_dimension; ++d) {
-      VectorTools::interpolate(offline_data_->dof_handler(),
-                               to_function<dim, Number>(callable, d),
-                               temp);
-      U.insert_component(temp, d);
-    }
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_owned; ++i)
+      U.write_tensor(states[i], i);
 
     /*
      * Cosmetic fix up: Ensure that the initial state is compatible with
@@ -252,26 +296,28 @@ namespace ryujin
      * initial conditions happen to be set incorrectly.
      */
 
-    const auto &boundary_map = offline_data_->boundary_map();
-    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const auto view = hyperbolic_system_->template view<dim, Number>();
 
-    for (auto entry : boundary_map) {
-      const auto i = entry.first;
-      if (i >= n_owned)
-        continue;
+    RYUJIN_OMP_FOR
+    for (unsigned int k = 0; k < boundary_table.size(); ++k) {
+      const auto i = boundary_table.index[k];
 
-      const auto normal = std::get<0>(entry.second);
-      const auto id = std::get<3>(entry.second);
+      /* Process all boundary descriptions of a row by the same thread: */
+      if (k != boundary_table.begin(i))
+        continue;
 
-      if (id == Boundary::slip || id == Boundary::no_slip) {
-        auto U_i = U.get_tensor(i);
-        const auto view = hyperbolic_system_->template view<dim, Number>();
-        U_i = view.apply_boundary_conditions(
-            id, U_i, normal, [&]() { return U_i; });
-        U.write_tensor(U_i, i);
+      auto U_i = U.get_tensor(i);
+      for (unsigned int b = k; b < boundary_table.end(i); ++b) {
+        const auto id = boundary_table.id[b];
+        if (id == Boundary::slip || id == Boundary::no_slip)
+          U_i = view.apply_boundary_conditions(
+              id, U_i, boundary_table.normal[b], [&]() { return U_i; });
       }
+      U.write_tensor(U_i, i);
     }
 
+    RYUJIN_PARALLEL_REGION_END
+
     U.update_ghost_values();
     return U;
   }
@@ -290,19 +336,13 @@ namespace ryujin
     if constexpr (n_precomputed_values == 0)
       return precomputed;
 
-    using scalar_type = typename OfflineData<dim, Number>::scalar_type;
+    const auto &points = locally_owned_support_points();
 
-    const auto callable = [&](const auto &p) { return flux_contributions(p); };
-
-    scalar_type temp;
-    temp.reinit(scalar_partitioner);
-
-    for (unsigned int d = 0; d < n_precomputed_values; ++d) {
-      VectorTools::interpolate(offline_data_->dof_handler(),
-                               to_function<dim, Number>(callable, d),
-                               temp);
-      precomputed.insert_component(temp, d);
-    }
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < points.size(); ++i)
+      precomputed.write_tensor(flux_contributions(points[i]), i);
+    RYUJIN_PARALLEL_REGION_END
 
     precomputed.update_ghost_values();
     return precomputed;
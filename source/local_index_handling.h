@@ -6,13 +6,21 @@
 #pragma once
 
 #include <deal.II/base/partitioner.h>
+#include <deal.II/base/utilities.h>
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_renumbering.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/fe/mapping.h>
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/sparsity_tools.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <vector>
+
 namespace ryujin
 {
   /**
@@ -88,6 +96,81 @@ namespace ryujin
      */
     using dealii::DoFRenumbering::Cuthill_McKee;
 
+    /**
+     * Import the hierarchical (Z-order) reordering from deal.II into the
+     * current namespace. It enumerates degrees of freedom following the
+     * recursive traversal of the cell hierarchy.
+     */
+    using dealii::DoFRenumbering::hierarchical;
+
+    /**
+     * Reorder all locally owned indices along a Hilbert space-filling
+     * curve through their support points.
+     *
+     * Compared to Cuthill_McKee() this ordering has no long bandwidth
+     * tail on unstructured meshes: Indices that are close on the curve
+     * are close in space, and vice versa (up to the jumps of the curve
+     * at the coarse level). The subsequent grouping into SIMD strides
+     * (see internal_range()) preserves most of it.
+     *
+     * @ingroup FiniteElement
+     */
+    template <int dim>
+    void Hilbert(dealii::DoFHandler<dim> &dof_handler,
+                 const dealii::Mapping<dim> &mapping)
+    {
+      using namespace dealii;
+
+      const IndexSet &locally_owned = dof_handler.locally_owned_dofs();
+      const auto n_locally_owned = locally_owned.n_elements();
+
+      /* The locally owned index range has to be contiguous */
+      Assert(locally_owned.is_contiguous() == true,
+             dealii::ExcMessage(
+                 "Need a contiguous set of locally owned indices."));
+
+      /* Offset to translate from global to local index range */
+      const auto offset = n_locally_owned != 0 ? *locally_owned.begin() : 0;
+
+      std::map<types::global_dof_index, Point<dim>> support_points;
+      DoFTools::map_dofs_to_support_points(
+          mapping, dof_handler, support_points);
+
+      std::vector<Point<dim>> points(n_locally_owned);
+      for (unsigned int i = 0; i < n_locally_owned; ++i) {
+        const auto it = support_points.find(offset + i);
+        Assert(it != support_points.end(), ExcInternalError());
+        points[i] = it->second;
+      }
+
+      /*
+       * Compute the position of every point on the curve (relative to
+       * the bounding box of all locally owned points):
+       */
+      constexpr int bits_per_dim = 64 / dim;
+      const auto hilbert_indices =
+          Utilities::inverse_Hilbert_space_filling_curve(points, bits_per_dim);
+
+      std::vector<std::uint64_t> keys(n_locally_owned);
+      for (unsigned int i = 0; i < n_locally_owned; ++i)
+        keys[i] = Utilities::pack_integers<dim>(hilbert_indices[i],
+                                                bits_per_dim);
+
+      std::vector<unsigned int> permutation(n_locally_owned);
+      std::iota(permutation.begin(), permutation.end(), 0u);
+      std::stable_sort(permutation.begin(),
+                       permutation.end(),
+                       [&](const auto a, const auto b) {
+                         return keys[a] < keys[b];
+                       });
+
+      std::vector<types::global_dof_index> new_order(n_locally_owned);
+      for (unsigned int k = 0; k < n_locally_owned; ++k)
+        new_order[permutation[k]] = offset + k;
+
+      dof_handler.renumber_dofs(new_order);
+    }
+
     /**
      * Reorder all (strides of) locally internal indices that contain
      * export indices to the start of the index range.
@@ -208,6 +291,16 @@ namespace ryujin
      * Reorder all strides of inconsistent locally internal indices to the
      * end of the locally internal index range.
      *
+     * All indices of inconsistent strides and all indices of the
+     * non-internal range [n_locally_internal, n_locally_owned) are grouped
+     * again by their (current) stencil size into strides of @p group_size
+     * that are placed immediately after the consistent strides. This way
+     * the affected indices are processed by the vectorized SIMD loops
+     * again instead of the scalar loops. Incomplete groups are placed at
+     * the end.
+     *
+     * Returns the right boundary of the regrouped index range.
+     *
      * @ingroup FiniteElement
      */
     template <int dim>
@@ -264,25 +357,44 @@ namespace ryujin
       }
 
       /*
-       * Second pass: append the rest:
+       * Second pass: sort the rest into bins of same stencil size:
        */
 
-      unsigned int running_index = n_consistent_range;
+      std::map<unsigned int, std::vector<unsigned int>> bins;
 
       for (unsigned int i = 0; i < n_locally_internal; i += group_size) {
         if (new_order[i] == dealii::numbers::invalid_dof_index) {
           for (unsigned int j = 0; j < group_size; ++j) {
             Assert(new_order[i + j] == dealii::numbers::invalid_dof_index,
                    dealii::ExcInternalError());
-            new_order[i + j] = offset + running_index++;
+            bins[sparsity.row_length(offset + i + j)].push_back(i + j);
           }
         }
       }
 
-      Assert(running_index == n_locally_internal, dealii::ExcInternalError());
-
       for (unsigned int i = n_locally_internal; i < n_locally_owned; i++) {
-        new_order[i] = offset + running_index++;
+        bins[sparsity.row_length(offset + i)].push_back(i);
+      }
+
+      /*
+       * Third pass: write out complete groups first, followed by the
+       * remaining indices:
+       */
+
+      unsigned int running_index = n_consistent_range;
+
+      for (const auto &[row_length, indices] : bins) {
+        const auto n_complete = indices.size() / group_size * group_size;
+        for (std::size_t k = 0; k < n_complete; ++k)
+          new_order[indices[k]] = offset + running_index++;
+      }
+
+      const unsigned int n_regrouped_range = running_index;
+
+      for (const auto &[row_length, indices] : bins) {
+        const auto n_complete = indices.size() / group_size * group_size;
+        for (std::size_t k = n_complete; k < indices.size(); ++k)
+          new_order[indices[k]] = offset + running_index++;
       }
 
       Assert(running_index == n_locally_owned, dealii::ExcInternalError());
@@ -290,9 +402,8 @@ namespace ryujin
       dof_handler.renumber_dofs(new_order);
 
       Assert(n_consistent_range % group_size == 0, dealii::ExcInternalError());
-      Assert(n_consistent_range < n_locally_internal,
-             dealii::ExcInternalError());
-      return n_consistent_range;
+      Assert(n_regrouped_range % group_size == 0, dealii::ExcInternalError());
+      return n_regrouped_range;
     }
 
 
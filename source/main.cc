@@ -16,8 +16,18 @@
 #include <omp.h>
 #endif
 
+#if defined(__x86_64) && defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 /**
  * Change rounding mode on X86-64 architecture: Denormals are flushed to
@@ -37,6 +47,93 @@ void flush_denormals_to_zero()
 }
 
 
+/**
+ * Runtime dispatch of the instruction set: The SIMD width of all kernels
+ * is fixed at compile time (and has to match the one of the deal.II
+ * library). In order to run on heterogeneous clusters with a single
+ * executable name this function detects the instruction sets supported
+ * by the CPU and replaces the running process by the sibling executable
+ * "<executable>.<isa>" (with isa one of avx512, avx2, avx, sse2) for the
+ * widest supported instruction set, provided that this is wider than the
+ * one the running executable was compiled for, or that the running
+ * executable is not supported by the CPU at all. Setting the environment
+ * variable RYUJIN_NO_ISA_DISPATCH disables the dispatch.
+ *
+ * The function returns false if the running executable is not
+ * supported by the CPU and no suitable variant could be found. It has to
+ * be called before MPI is initialized.
+ */
+bool dispatch_instruction_set(char *argv[] [[maybe_unused]])
+{
+#if defined(__x86_64) && defined(__linux__)
+  /* Instruction sets in decreasing order of SIMD width: */
+  const std::vector<std::pair<std::string, bool>> instruction_sets{
+      {"avx512", __builtin_cpu_supports("avx512f")},
+      {"avx2", __builtin_cpu_supports("avx2")},
+      {"avx", __builtin_cpu_supports("avx")},
+      {"sse2", __builtin_cpu_supports("sse2")}};
+
+#if defined(__AVX512F__)
+  constexpr unsigned int compiled = 0;
+#elif defined(__AVX2__)
+  constexpr unsigned int compiled = 1;
+#elif defined(__AVX__)
+  constexpr unsigned int compiled = 2;
+#elif defined(__SSE2__)
+  constexpr unsigned int compiled = 3;
+#else
+  constexpr unsigned int compiled = 4;
+#endif
+
+  const bool supported =
+      compiled >= instruction_sets.size() || instruction_sets[compiled].second;
+
+  if (std::getenv("RYUJIN_NO_ISA_DISPATCH") != nullptr)
+    return supported;
+
+  std::error_code error;
+  const auto executable =
+      std::filesystem::read_symlink("/proc/self/exe", error).string();
+  if (error)
+    return supported;
+
+  /* Strip an instruction set suffix from the name of the executable: */
+  auto base_name = executable;
+  for (const auto &[name, available] : instruction_sets) {
+    const auto suffix = "." + name;
+    if (base_name.size() > suffix.size() &&
+        base_name.compare(
+            base_name.size() - suffix.size(), suffix.size(), suffix) == 0)
+      base_name.erase(base_name.size() - suffix.size());
+  }
+
+  for (unsigned int i = 0; i < instruction_sets.size(); ++i) {
+    const auto &[name, available] = instruction_sets[i];
+    if (!available || (supported && i >= compiled))
+      continue;
+
+    const auto variant = base_name + "." + name;
+    if (variant == executable || !std::filesystem::exists(variant))
+      continue;
+
+    /* execv() only returns on failure, in which case we try the next. */
+    execv(variant.c_str(), argv);
+  }
+
+  if (!supported)
+    std::cerr << "[ERROR] The executable »" << executable
+              << "« was compiled for an instruction set that is not "
+                 "supported by this CPU and no suitable variant "
+                 "»<executable>.<isa>« was found."
+              << std::endl;
+
+  return supported;
+#else
+  return true;
+#endif
+}
+
+
 /**
  * Set up thread pools and obey thread limits:
  */
@@ -59,6 +156,9 @@ void set_thread_limit(const MPI_Comm &mpi_communicator [[maybe_unused]])
  */
 int main(int argc, char *argv[])
 {
+  if (!dispatch_instruction_set(argv))
+    return 1;
+
   flush_denormals_to_zero();
 
   LSAN_DISABLE;
@@ -73,10 +173,33 @@ int main(int argc, char *argv[])
     std::cout << "[INFO] initiating flux capacitor" << std::endl;
   }
 
-  if (argc > 2) {
+  /*
+   * Run in benchmark, autotune, replay, or parareal mode if the
+   * "--benchmark", "--autotune", "--replay", or "--parareal" flag is
+   * present:
+   */
+  std::vector<std::string> arguments(argv + 1, argv + argc);
+  auto mode = ryujin::RunMode::simulation;
+  unsigned int n_flags = 0;
+  for (const auto &[name, flag_mode] :
+       {std::make_pair("--benchmark", ryujin::RunMode::benchmark),
+        std::make_pair("--autotune", ryujin::RunMode::autotune),
+        std::make_pair("--replay", ryujin::RunMode::replay),
+        std::make_pair("--parareal", ryujin::RunMode::parareal)}) {
+    const auto flag = std::find(arguments.begin(), arguments.end(), name);
+    if (flag == arguments.end())
+      continue;
+    arguments.erase(flag);
+    mode = flag_mode;
+    ++n_flags;
+  }
+
+  if (arguments.size() > 1 || n_flags > 1) {
     if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
       std::cout << "[ERROR] Invalid number of parameters. At most one argument "
-                << "supported which has to be a parameter file." << std::endl;
+                << "supported which has to be a parameter file (optionally "
+                << "together with one of the --benchmark, --autotune, "
+                << "--replay, or --parareal flags)." << std::endl;
     }
 
     LIKWID_CLOSE;
@@ -87,8 +210,8 @@ int main(int argc, char *argv[])
   const auto executable_name = std::filesystem::path(argv[0]).filename();
   std::string parameter_file = executable_name.string() + ".prm";
 
-  if (argc == 2) {
-    parameter_file = argv[1];
+  if (arguments.size() == 1) {
+    parameter_file = arguments[0];
 
     if (!std::filesystem::exists(parameter_file)) {
       if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) {
@@ -118,7 +241,7 @@ int main(int argc, char *argv[])
 
   {
     ryujin::EquationDispatch equation_dispatch;
-    equation_dispatch.run(parameter_file, mpi_communicator);
+    equation_dispatch.run(parameter_file, mpi_communicator, mode);
   }
 
   LIKWID_CLOSE;
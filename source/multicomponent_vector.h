@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <compile_time_options.h>
+
+#include "huge_pages.h"
 #include "simd.h"
 
 #include <deal.II/base/mpi.h>
@@ -14,6 +17,39 @@
 
 namespace ryujin
 {
+  /**
+   * Return the number of storage locations per vector element that is
+   * used for a MultiComponentVector with @p n_comp components of type
+   * @a Number.
+   *
+   * If the compile-time option MULTICOMPONENT_VECTOR_PADDING is set, the
+   * number of components is rounded up to the next power of two as long
+   * as a padded vector element fits into a 64 byte cache line. For
+   * example, the 5 components of the 3D Euler equations are stored with
+   * a stride of 8 values. Every state is then aligned to a cache line
+   * and no gather access to a vector element ever touches two cache
+   * lines. This comes at the price of additional memory and MPI traffic
+   * for streaming access. Otherwise, the function returns @p n_comp.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  constexpr unsigned int storage_stride(const unsigned int n_comp)
+  {
+#ifdef MULTICOMPONENT_VECTOR_PADDING
+    if (n_comp == 0)
+      return 0;
+
+    unsigned int stride = 1;
+    while (stride < n_comp)
+      stride *= 2;
+    return stride * sizeof(Number) <= 64 ? stride : n_comp;
+#else
+    return n_comp;
+#endif
+  }
+
+
   /**
    * This function takes a scalar MPI partitioner @p scalar_partitioner as
    * argument and returns a shared pointer to a new "vector" multicomponent
@@ -28,6 +64,10 @@ namespace ryujin
    *  \ldots
    * \f}
    *
+   * @note In order to set up a partitioner for a MultiComponentVector
+   * the argument @p n_components has to be the storage stride returned
+   * by storage_stride().
+   *
    * @note This function is used to efficiently set up a single vector
    * partitioner in OfflineData used in all MultiComponentVector instances.
    *
@@ -77,6 +117,13 @@ namespace ryujin
      */
     using scalar_type::operator=;
 
+    /**
+     * The number of storage locations per vector element, see
+     * storage_stride(). The entries [n_comp, stride) of every element
+     * are padding and always zero.
+     */
+    static constexpr unsigned int stride = storage_stride<Number>(n_comp);
+
     /**
      * Reinitializes the MultiComponentVector with a scalar MPI
      * partitioner. The function calls create_vector_partitioner()
@@ -128,6 +175,10 @@ namespace ryujin
      * the function returns a SIMD vectorized dealii::Tensor populated with
      * entries from the @p n_comp component vectors stored at indices i,
      * i+1, ..., i+simd_length-1.
+     *
+     * If the scalar type of @a Number2 differs from @a Number (for
+     * example, when reading single precision storage into double
+     * precision values) then the values are converted on the fly.
      */
     template <typename Number2 = Number,
               typename Tensor = dealii::Tensor<1, n_comp, Number2>>
@@ -161,6 +212,16 @@ namespace ryujin
     template <typename Number2 = Number,
               typename Tensor = dealii::Tensor<1, n_comp, Number2>>
     void write_tensor(const Tensor &tensor, const unsigned int i);
+
+    /**
+     * Issue software prefetches for the vector elements stored at indices
+     * *(js), ..., *(js+simd_length-1) if the template parameter @a
+     * Number2 is a VectorizedArray, or at index *(js) otherwise. The
+     * function does nothing unless the compile-time option
+     * PREFETCH_DISTANCE is positive.
+     */
+    template <typename Number2 = Number>
+    void prefetch(const unsigned int *js) const;
   };
 
 
@@ -178,10 +239,13 @@ namespace ryujin
       return;
 
     auto vector_partitioner =
-        create_vector_partitioner(scalar_partitioner, n_comp);
+        create_vector_partitioner(scalar_partitioner, stride);
 
     dealii::LinearAlgebra::distributed::Vector<Number>::reinit(
         vector_partitioner);
+    advise_huge_pages(this->begin(),
+                      this->get_partitioner()->locally_owned_size() *
+                          sizeof(Number));
   }
 
 
@@ -193,7 +257,7 @@ namespace ryujin
            dealii::ExcMessage(
                "Cannot extract from a vector with zero components."));
 
-    Assert(n_comp * scalar_vector.get_partitioner()->locally_owned_size() ==
+    Assert(stride * scalar_vector.get_partitioner()->locally_owned_size() ==
                this->get_partitioner()->locally_owned_size(),
            dealii::ExcMessage("Called with a scalar_vector argument that has "
                               "incompatible local range."));
@@ -201,7 +265,7 @@ namespace ryujin
         scalar_vector.get_partitioner()->locally_owned_size();
     for (unsigned int i = 0; i < local_size; ++i)
       scalar_vector.local_element(i) =
-          this->local_element(i * n_comp + component);
+          this->local_element(i * stride + component);
     scalar_vector.update_ghost_values();
   }
 
@@ -214,14 +278,14 @@ namespace ryujin
            dealii::ExcMessage(
                "Cannot insert into a vector with zero components."));
 
-    Assert(n_comp * scalar_vector.get_partitioner()->locally_owned_size() ==
+    Assert(stride * scalar_vector.get_partitioner()->locally_owned_size() ==
                this->get_partitioner()->locally_owned_size(),
            dealii::ExcMessage("Called with a scalar_vector argument that has "
                               "incompatible local range."));
     const auto local_size =
         scalar_vector.get_partitioner()->locally_owned_size();
     for (unsigned int i = 0; i < local_size; ++i)
-      this->local_element(i * n_comp + component) =
+      this->local_element(i * stride + component) =
           scalar_vector.local_element(i);
   }
 
@@ -235,6 +299,7 @@ namespace ryujin
   {
     static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
                   "dummy type mismatch");
+    using ScalarNumber2 = typename get_value_type<Number2>::type;
     Tensor tensor;
 
     /* Special case of a zero component vector */
@@ -245,17 +310,29 @@ namespace ryujin
       /* Non-vectorized sequential access. */
 
       for (unsigned int d = 0; d < n_comp; ++d)
-        tensor[d] = this->local_element(i * n_comp + d);
+        tensor[d] = this->local_element(i * stride + d);
 
     } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
 
       /* Vectorized fast access. index must be divisible by simd_length */
       std::array<unsigned int, VectorizedArray::size()> indices;
       for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
-        indices[k] = k * n_comp;
+        indices[k] = k * stride;
 
       dealii::vectorized_load_and_transpose(
-          n_comp, this->begin() + i * n_comp, indices.data(), &tensor[0]);
+          n_comp, this->begin() + i * stride, indices.data(), &tensor[0]);
+
+    } else if constexpr (!std::is_same<Number, ScalarNumber2>::value) {
+      /* Mixed precision access: convert values on the fly. */
+
+      if constexpr (std::is_same<Number2, ScalarNumber2>::value) {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          tensor[d] = this->local_element(i * stride + d);
+      } else {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < Number2::size(); ++k)
+            tensor[d][k] = this->local_element((i + k) * stride + d);
+      }
 
     } else {
       /* not implemented */
@@ -274,6 +351,7 @@ namespace ryujin
   {
     static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
                   "dummy type mismatch");
+    using ScalarNumber2 = typename get_value_type<Number2>::type;
     Tensor tensor;
 
     /* Special case of a zero component vector */
@@ -284,18 +362,30 @@ namespace ryujin
       /* Non-vectorized sequential access. */
 
       for (unsigned int d = 0; d < n_comp; ++d)
-        tensor[d] = this->local_element(js[0] * n_comp + d);
+        tensor[d] = this->local_element(js[0] * stride + d);
 
     } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
       /* Vectorized fast access. index must be divisible by simd_length */
 
       std::array<unsigned int, VectorizedArray::size()> indices;
       for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
-        indices[k] = js[k] * n_comp;
+        indices[k] = js[k] * stride;
 
       dealii::vectorized_load_and_transpose(
           n_comp, this->begin(), indices.data(), &tensor[0]);
 
+    } else if constexpr (!std::is_same<Number, ScalarNumber2>::value) {
+      /* Mixed precision access: convert values on the fly. */
+
+      if constexpr (std::is_same<Number2, ScalarNumber2>::value) {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          tensor[d] = this->local_element(js[0] * stride + d);
+      } else {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < Number2::size(); ++k)
+            tensor[d][k] = this->local_element(js[k] * stride + d);
+      }
+
     } else {
       /* not implemented */
       __builtin_trap();
@@ -313,6 +403,7 @@ namespace ryujin
   {
     static_assert(std::is_same<Number2, typename Tensor::value_type>::value,
                   "dummy type mismatch");
+    using ScalarNumber2 = typename get_value_type<Number2>::type;
 
     /* Special case of a zero component vector */
     if constexpr (n_comp == 0)
@@ -322,26 +413,59 @@ namespace ryujin
       /* Non-vectorized sequential access. */
 
       for (unsigned int d = 0; d < n_comp; ++d)
-        this->local_element(i * n_comp + d) = tensor[d];
+        this->local_element(i * stride + d) = tensor[d];
 
     } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
       /* Vectorized fast access. index must be divisible by simd_length */
 
       std::array<unsigned int, VectorizedArray::size()> indices;
       for (unsigned int k = 0; k < VectorizedArray::size(); ++k)
-        indices[k] = k * n_comp;
+        indices[k] = k * stride;
 
       dealii::vectorized_transpose_and_store(false,
                                              n_comp,
                                              &tensor[0],
                                              indices.data(),
-                                             this->begin() + i * n_comp);
+                                             this->begin() + i * stride);
+
+    } else if constexpr (!std::is_same<Number, ScalarNumber2>::value) {
+      /*
+       * Mixed precision access: convert values on the fly. Values are
+       * rounded to nearest, round beforehand if a different rounding
+       * direction is needed.
+       */
+
+      if constexpr (std::is_same<Number2, ScalarNumber2>::value) {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          this->local_element(i * stride + d) = Number(tensor[d]);
+      } else {
+        for (unsigned int d = 0; d < n_comp; ++d)
+          for (unsigned int k = 0; k < Number2::size(); ++k)
+            this->local_element((i + k) * stride + d) =
+                Number(tensor[d][k]);
+      }
 
     } else {
       /* not implemented */
       __builtin_trap();
     }
   }
+
+
+  template <typename Number, int n_comp, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  MultiComponentVector<Number, n_comp, simd_length>::prefetch(
+      const unsigned int *js) const
+  {
+#if PREFETCH_DISTANCE > 0
+    const unsigned int n_lanes = get_stride_size<Number2>;
+    for (unsigned int k = 0; k < n_lanes; ++k)
+      prefetch_range(this->begin() + js[k] * stride, n_comp * sizeof(Number));
+#else
+    (void)js;
+#endif
+  }
 #endif
 
 } // namespace ryujin
@@ -12,8 +12,10 @@
 #include <convenience_macros.h>
 #include <initial_values.h>
 #include <offline_data.h>
+#include <patterns_conversion.h>
 #include <simd.h>
 #include <sparse_matrix_simd.h>
+#include <vector_pool.h>
 
 #include "parabolic_solver_gmg_operators.h"
 
@@ -29,6 +31,101 @@
 #include <deal.II/multigrid/mg_smoother.h>
 #include <deal.II/multigrid/mg_transfer_matrix_free.h>
 
+#include <array>
+#include <vector>
+
+namespace ryujin
+{
+  namespace NavierStokes
+  {
+    /**
+     * Controls the coarse grid solver used in the geometric multigrid
+     * preconditioner.
+     */
+    enum class CoarseGridSolver {
+      /**
+       * Apply a Chebyshev iteration on the coarsest level with a
+       * polynomial degree chosen such that the residual is reduced by
+       * roughly three orders of magnitude.
+       */
+      chebyshev,
+
+      /**
+       * Solve the coarse grid problem with a conjugate gradient method
+       * (preconditioned by the Chebyshev smoother of the coarsest level)
+       * up to the chosen relative tolerance.
+       */
+      cg,
+    };
+
+    /**
+     * Controls the outer Krylov solver used in combination with the
+     * geometric multigrid preconditioner.
+     */
+    enum class OuterSolver {
+      /**
+       * The conjugate gradient method.
+       */
+      cg,
+
+      /**
+       * The flexible GMRES method. This variant is robust with respect to
+       * an inexact (iterative) coarse grid solve that renders the
+       * multigrid preconditioner slightly nonlinear.
+       */
+      fgmres,
+
+      /**
+       * The pipelined conjugate gradient method (see SolverPipelinedCG)
+       * that hides the latency of the global reductions behind the
+       * application of the preconditioner and the operator.
+       */
+      pipelined_cg,
+    };
+
+    /**
+     * Controls how the velocity and internal energy updates of the
+     * parabolic sub-step are computed.
+     */
+    enum class TimeStepping {
+      /**
+       * Solve the linear systems of the implicit Crank-Nicolson scheme
+       * with a (multigrid preconditioned) Krylov method.
+       */
+      crank_nicolson,
+
+      /**
+       * Integrate the velocity and internal energy equations over the
+       * time step with the explicit second-order Runge-Kutta-Legendre
+       * (RKL2) super time stepping method. The number of stages is chosen
+       * from an estimate of the maximal eigenvalue of the operator. This
+       * only requires operator applications and thus only neighbor
+       * communication (besides a few reductions for the eigenvalue
+       * estimate).
+       */
+      rkl2,
+    };
+  } // namespace NavierStokes
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(
+    ryujin::NavierStokes::CoarseGridSolver,
+    LIST({ryujin::NavierStokes::CoarseGridSolver::chebyshev, "chebyshev"},
+         {ryujin::NavierStokes::CoarseGridSolver::cg, "cg"}, ));
+
+DECLARE_ENUM(
+    ryujin::NavierStokes::OuterSolver,
+    LIST({ryujin::NavierStokes::OuterSolver::cg, "cg"},
+         {ryujin::NavierStokes::OuterSolver::fgmres, "fgmres"},
+         {ryujin::NavierStokes::OuterSolver::pipelined_cg, "pipelined cg"}, ));
+
+DECLARE_ENUM(ryujin::NavierStokes::TimeStepping,
+             LIST({ryujin::NavierStokes::TimeStepping::crank_nicolson,
+                   "crank nicolson"},
+                  {ryujin::NavierStokes::TimeStepping::rkl2, "rkl2"}, ));
+#endif
+
 namespace ryujin
 {
   namespace NavierStokes
@@ -153,6 +250,28 @@ namespace ryujin
        */
       void prepare();
 
+      /**
+       * Append the memory consumption (in bytes) of the matrix-free data,
+       * the multigrid hierarchy and all temporary vectors to
+       * @p statistics.
+       */
+      void collect_memory_statistics(
+          std::vector<std::pair<std::string, std::size_t>> &statistics)
+          const;
+
+      /**
+       * Discard all information carried over from previous time steps:
+       * the previous solutions of "extrapolate initial guess" and the
+       * eigenvalue estimates of "multigrid - eigenvalue reuse tolerance".
+       */
+      void reset_history() const;
+
+      /**
+       * Return true if the solver is configured to carry information
+       * over from one time step to the next, see reset_history().
+       */
+      bool keeps_history() const;
+
       /**
        * @name Functions for performing implicit time steps
        */
@@ -162,6 +281,14 @@ namespace ryujin
        * Given a reference to a previous state vector @p old_U at time @p
        * old_t and a time-step size @p tau perform an implicit Crank-Nicolson
        * step (and store the result in @p new_U).
+       *
+       * If the "time stepping" parameter is set to rkl2 the linear solves
+       * are replaced by an explicit RKL2 super time step over the full
+       * interval [old_t, old_t + tau] for the velocity and the internal
+       * energy. The remaining structure of the scheme (the
+       * midpoint evaluation of the source term and the final write back)
+       * is unchanged. In this case the iteration counts reported by
+       * print_solver_statistics() are the number of stages.
        */
       void crank_nicolson_step(const vector_type &old_U,
                                const Number old_t,
@@ -177,6 +304,13 @@ namespace ryujin
        */
       void print_solver_statistics(std::ostream &output) const;
 
+      /**
+       * Append the averaged number of iterations of the velocity and
+       * internal energy solves to @p statistics.
+       */
+      void collect_solver_statistics(
+          std::vector<std::pair<std::string, double>> &statistics) const;
+
       //@}
       /**
        * @name Accessors
@@ -200,8 +334,14 @@ namespace ryujin
       bool use_gmg_internal_energy_;
       ACCESSOR_READ_ONLY(use_gmg_internal_energy)
 
+      bool fused_operator_evaluation_;
+
       Number tolerance_;
       bool tolerance_linfty_norm_;
+      bool tolerance_adaptive_;
+      Number tolerance_adaptive_factor_;
+      Number tolerance_adaptive_order_;
+      Number tolerance_adaptive_maximum_;
 
       unsigned int gmg_max_iter_vel_;
       unsigned int gmg_max_iter_en_;
@@ -212,6 +352,21 @@ namespace ryujin
       unsigned int gmg_smoother_degree_;
       unsigned int gmg_smoother_n_cg_iter_;
       unsigned int gmg_min_level_;
+      unsigned int gmg_min_cells_per_rank_;
+      CoarseGridSolver gmg_coarse_solver_;
+      double gmg_coarse_tolerance_;
+      unsigned int gmg_coarse_max_iter_;
+      OuterSolver gmg_outer_solver_;
+      double gmg_eigenvalue_reuse_tolerance_;
+      bool gmg_mixed_precision_;
+      double gmg_mixed_precision_reduction_;
+      unsigned int gmg_mixed_precision_max_refinement_;
+
+      bool extrapolate_initial_guess_;
+
+      TimeStepping time_stepping_;
+      unsigned int rkl2_eigenvalue_iterations_;
+      double rkl2_safety_factor_;
 
       //@}
       /**
@@ -246,8 +401,30 @@ namespace ryujin
       mutable Number tau_;
       mutable Number theta_;
 
+      mutable unsigned int n_previous_solutions_;
+      mutable std::array<Number, 2> previous_times_;
+      mutable std::array<block_vector_type, 2> previous_velocity_;
+      mutable std::array<scalar_type, 2> previous_internal_energy_;
+
+      mutable Number eigenvalue_tau_velocity_;
+      mutable Number eigenvalue_tau_energy_;
+      mutable std::vector<double> max_eigenvalues_velocity_;
+      mutable std::vector<double> max_eigenvalues_energy_;
+
+      mutable dealii::MatrixFree<dim, float> matrix_free_float_;
+      mutable dealii::LinearAlgebra::distributed::Vector<float>
+          lumped_mass_matrix_float_;
+      mutable dealii::LinearAlgebra::distributed::Vector<float>
+          density_float_;
+      mutable VectorPool<dealii::LinearAlgebra::distributed::Vector<float>>
+          float_vector_pool_;
+      mutable VectorPool<
+          dealii::LinearAlgebra::distributed::BlockVector<float>>
+          float_block_vector_pool_;
+
       mutable dealii::MGLevelObject<dealii::MatrixFree<dim, float>>
           level_matrix_free_;
+      std::vector<unsigned int> level_matrix_free_generation_;
       mutable dealii::MGConstrainedDoFs mg_constrained_dofs_;
       mutable dealii::MGLevelObject<
           dealii::LinearAlgebra::distributed::Vector<float>>
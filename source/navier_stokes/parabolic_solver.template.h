@@ -7,6 +7,7 @@
 
 #include "description.h"
 #include "parabolic_solver.h"
+#include "parabolic_solver_pipelined_cg.h"
 
 #include <introspection.h>
 #include <openmp.h>
@@ -16,6 +17,7 @@
 #include <deal.II/lac/linear_operator.h>
 #include <deal.II/lac/precondition.h>
 #include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_gmres.h>
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/multigrid/mg_coarse.h>
 #include <deal.II/multigrid/mg_matrix.h>
@@ -31,6 +33,209 @@ namespace ryujin
   {
     using namespace dealii;
 
+    namespace
+    {
+      /**
+       * A ReductionControl that accepts the current iterate once the
+       * maximal number of iterations is reached. This is used for the
+       * (inexact) coarse grid solve where we do not want to abort the
+       * outer iteration.
+       */
+      class CoarseReductionControl : public ReductionControl
+      {
+      public:
+        using ReductionControl::ReductionControl;
+
+        State check(const unsigned int step, const double check_value) override
+        {
+          const auto state = ReductionControl::check(step, check_value);
+          if (state == failure && step >= max_steps() &&
+              std::isfinite(check_value))
+            return success;
+          return state;
+        }
+      };
+
+
+      /**
+       * Mixed-precision iterative refinement: Starting from the initial
+       * guess @p x repeatedly compute the defect r = b - A x in full
+       * precision, approximately solve the correction equation A d = r
+       * with a single precision Krylov method on @p op_float that is
+       * preconditioned by @p preconditioner, and update x += d. The
+       * iteration stops as soon as the norm of the defect is below
+       * @p tolerance. A SolverControl::NoConvergence exception is thrown
+       * if this does not happen within @p max_refinement_steps. The
+       * function returns the total number of inner iterations.
+       */
+      template <typename Operator,
+                typename FloatOperator,
+                typename VectorType,
+                typename FloatVectorType,
+                typename Preconditioner>
+      unsigned int iterative_refinement(const Operator &op,
+                                        const FloatOperator &op_float,
+                                        VectorType &x,
+                                        const VectorType &b,
+                                        FloatVectorType &defect,
+                                        FloatVectorType &correction,
+                                        const Preconditioner &preconditioner,
+                                        const double tolerance,
+                                        const bool linfty_norm,
+                                        const bool use_fgmres,
+                                        const double inner_reduction,
+                                        const unsigned int max_inner_steps,
+                                        const unsigned int max_refinement)
+      {
+        VectorType residual;
+        residual.reinit(x, true);
+
+        unsigned int n_inner_steps = 0;
+        for (unsigned int step = 0;; ++step) {
+          op.vmult(residual, x);
+          residual.sadd(-1., 1., b);
+
+          const double norm =
+              linfty_norm ? residual.linfty_norm() : residual.l2_norm();
+          if (norm <= tolerance)
+            return n_inner_steps;
+          if (step == max_refinement || !std::isfinite(norm))
+            throw SolverControl::NoConvergence(step, norm);
+
+          defect = residual;
+          correction = 0.;
+
+          CoarseReductionControl inner_control(
+              max_inner_steps, 1.e-30, inner_reduction);
+          if (use_fgmres) {
+            SolverFGMRES<FloatVectorType> solver(inner_control);
+            solver.solve(op_float, correction, defect, preconditioner);
+          } else {
+            SolverCG<FloatVectorType> solver(inner_control);
+            solver.solve(op_float, correction, defect, preconditioner);
+          }
+          n_inner_steps += inner_control.last_step();
+
+          residual = correction;
+          x += residual;
+        }
+      }
+
+
+      /**
+       * RKL2 super time stepping @cite Meyer2014: Given the linear system
+       * A x = b of a theta-scheme step, where A = D^{-1} + theta tau L is
+       * the sum of the (inverse) diagonal @p diagonal and a stiffness
+       * part, integrate the ODE
+       *   dx/ds = 1 / theta (D (b - A x) + x - x_0),  s in [0, 1]
+       * with initial value x_0 = @p x. For b = D^{-1} x_0 + theta tau f
+       * this amounts to integrating D^{-1} dx/dt = f - L x over the full
+       * time step tau. Boundary rows are left untouched because A acts as
+       * identity on them (and b contains the boundary value).
+       *
+       * The number of stages s is chosen from an estimate of the maximal
+       * eigenvalue of D A that is obtained with
+       * @p n_eigenvalue_iterations CG iterations and scaled by
+       * @p safety_factor. The final result stores the theta-weighted
+       * average theta x(1) + (1 - theta) x_0 in @p x, i.e., the quantity
+       * that is computed by the linear solve of the theta-scheme. The
+       * function returns the number of stages.
+       */
+      template <typename Operator,
+                typename VectorType,
+                typename Preconditioner>
+      unsigned int rkl2_step(const Operator &op,
+                             VectorType &x,
+                             const VectorType &b,
+                             const Preconditioner &diagonal,
+                             const double theta,
+                             const unsigned int n_eigenvalue_iterations,
+                             const double safety_factor)
+      {
+        VectorType x_0, temp, L_0, L_j, y_1, y_2;
+        x_0.reinit(x, true);
+        temp.reinit(x, true);
+        L_0.reinit(x, true);
+        L_j.reinit(x, true);
+        y_1.reinit(x, true);
+        y_2.reinit(x, true);
+        x_0 = x;
+
+        /* Right hand side of the ODE: dst = 1/theta (D(b - A y) + y - x_0) */
+        const auto apply_rhs = [&](VectorType &dst, const VectorType &y) {
+          op.vmult(temp, y);
+          temp.sadd(-1., 1., b);
+          diagonal.vmult(dst, temp);
+          dst.add(1., y, -1., x_0);
+          dst *= 1. / theta;
+        };
+
+        apply_rhs(L_0, x_0);
+        if (L_0.l2_norm() == 0.)
+          return 0;
+
+        /*
+         * Estimate the maximal eigenvalue of D A with a few CG iterations.
+         * The right hand side L_0 vanishes on all boundary rows, so that
+         * the Krylov space does not see the (unrelated) eigenvalues of
+         * the boundary rows:
+         */
+        double max_eigenvalue = 1.;
+        {
+          IterationNumberControl control(n_eigenvalue_iterations, 1.e-30);
+          SolverCG<VectorType> solver(control);
+          solver.connect_eigenvalues_slot(
+              [&](const std::vector<double> &eigenvalues) {
+                if (!eigenvalues.empty())
+                  max_eigenvalue = eigenvalues.back();
+              });
+          temp = 0.;
+          solver.solve(op, temp, L_0, diagonal);
+        }
+
+        /*
+         * The eigenvalues of the ODE operator are (1 - lambda) / theta.
+         * RKL2 with s stages is stable for a spectral radius up to
+         * (s^2 + s - 2) / 2:
+         */
+        const double lambda =
+            std::max(0., safety_factor * (max_eigenvalue - 1.) / theta);
+        const unsigned int n_stages = std::max(
+            2u,
+            static_cast<unsigned int>(
+                std::ceil(0.5 * (std::sqrt(9. + 8. * lambda) - 1.))));
+
+        const auto b_j = [](const unsigned int j) {
+          return j < 2 ? 1. / 3. : (j * j + j - 2.) / (2. * j * (j + 1.));
+        };
+        const double w_1 = 4. / (n_stages * n_stages + n_stages - 2.);
+
+        /* y_2 = Y_{j-2}, y_1 = Y_{j-1}: */
+        y_2 = x_0;
+        y_1 = x_0;
+        y_1.add(b_j(1) * w_1, L_0);
+
+        for (unsigned int j = 2; j <= n_stages; ++j) {
+          const double mu = (2. * j - 1.) / j * b_j(j) / b_j(j - 1);
+          const double nu = -(j - 1.) / j * b_j(j) / b_j(j - 2);
+          const double mu_tilde = mu * w_1;
+          const double gamma_tilde = -(1. - b_j(j - 1)) * mu_tilde;
+
+          apply_rhs(L_j, y_1);
+          y_2.sadd(nu, mu, y_1);
+          y_2.add(1. - mu - nu, x_0, mu_tilde, L_j);
+          y_2.add(gamma_tilde, L_0);
+          y_1.swap(y_2);
+        }
+
+        x.equ(theta, y_1);
+        x.add(1. - theta, x_0);
+
+        return n_stages;
+      }
+    } // namespace
+
+
     template <typename Description, int dim, typename Number>
     ParabolicSolver<Description, dim, Number>::ParabolicSolver(
         const MPI_Comm &mpi_communicator,
@@ -51,6 +256,9 @@ namespace ryujin
         , n_warnings_(0)
         , n_iterations_velocity_(0.)
         , n_iterations_internal_energy_(0.)
+        , n_previous_solutions_(0)
+        , eigenvalue_tau_velocity_(0.)
+        , eigenvalue_tau_energy_(0.)
     {
       use_gmg_velocity_ = false;
       add_parameter("multigrid velocity",
@@ -109,7 +317,110 @@ namespace ryujin
           "multigrid - min level",
           gmg_min_level_,
           "Minimal mesh level to be visited in the geometric multigrid "
-          "cycle where the coarse grid solver (Chebyshev) is called");
+          "cycle where the coarse grid solver is called");
+
+      gmg_min_cells_per_rank_ = 0;
+      add_parameter(
+          "multigrid - min cells per rank",
+          gmg_min_cells_per_rank_,
+          "Raise the minimal level of the multigrid cycle (beyond \"min "
+          "level\") until the level has at least this many cells per MPI "
+          "rank on average. Coarser levels with only a handful of cells "
+          "per rank are latency dominated and are skipped in favor of a "
+          "more expensive coarse grid solve (see \"coarse solver\"). Set "
+          "to 0 to disable");
+
+      gmg_coarse_solver_ = CoarseGridSolver::chebyshev;
+      add_parameter("multigrid - coarse solver",
+                    gmg_coarse_solver_,
+                    "Coarse grid solver: chebyshev (a single Chebyshev "
+                    "iteration), cg (Chebyshev-preconditioned CG up to the "
+                    "coarse tolerance)");
+
+      gmg_coarse_tolerance_ = 1.e-3;
+      add_parameter("multigrid - coarse tolerance",
+                    gmg_coarse_tolerance_,
+                    "Relative tolerance of the cg coarse grid solver");
+
+      gmg_coarse_max_iter_ = 100;
+      add_parameter("multigrid - coarse max iter",
+                    gmg_coarse_max_iter_,
+                    "Maximal number of iterations of the cg coarse grid "
+                    "solver");
+
+      gmg_outer_solver_ = OuterSolver::cg;
+      add_parameter("multigrid - outer solver",
+                    gmg_outer_solver_,
+                    "Outer Krylov solver used with the multigrid "
+                    "preconditioner: cg, fgmres, pipelined cg (a single "
+                    "non-blocking reduction per iteration that is overlapped "
+                    "with the preconditioner and operator application; the "
+                    "mixed precision correction solve uses cg instead)");
+
+      gmg_eigenvalue_reuse_tolerance_ = 0.;
+      add_parameter(
+          "multigrid - eigenvalue reuse tolerance",
+          gmg_eigenvalue_reuse_tolerance_,
+          "Reuse the maximal eigenvalues estimated for the Chebyshev "
+          "smoothers when updating the multigrid matrices as long as the "
+          "time-step size tau changed by less than the given relative "
+          "tolerance. Set to 0 to always reestimate eigenvalues");
+
+      gmg_mixed_precision_ = false;
+      add_parameter(
+          "multigrid - mixed precision",
+          gmg_mixed_precision_,
+          "Use mixed-precision iterative refinement for the multigrid "
+          "solves: The defect is computed in full precision and the "
+          "correction is obtained with a single precision Krylov solve on "
+          "the active level preconditioned by the multigrid cycle");
+
+      gmg_mixed_precision_reduction_ = 1.e-2;
+      add_parameter("multigrid - mixed precision inner reduction",
+                    gmg_mixed_precision_reduction_,
+                    "Mixed precision: relative defect reduction of the "
+                    "single precision correction solve");
+
+      gmg_mixed_precision_max_refinement_ = 10;
+      add_parameter("multigrid - mixed precision max refinement steps",
+                    gmg_mixed_precision_max_refinement_,
+                    "Mixed precision: maximal number of iterative "
+                    "refinement steps");
+
+      extrapolate_initial_guess_ = false;
+      add_parameter("extrapolate initial guess",
+                    extrapolate_initial_guess_,
+                    "Use a linear extrapolation in time of the solutions of "
+                    "the last two Crank-Nicolson steps as initial guess for "
+                    "the velocity and internal energy updates");
+
+      time_stepping_ = TimeStepping::crank_nicolson;
+      add_parameter("time stepping",
+                    time_stepping_,
+                    "Scheme used for the velocity and internal energy "
+                    "updates: crank nicolson (implicit, linear solves), "
+                    "rkl2 (explicit Runge-Kutta-Legendre super time "
+                    "stepping)");
+
+      rkl2_eigenvalue_iterations_ = 10;
+      add_parameter("rkl2 eigenvalue iterations",
+                    rkl2_eigenvalue_iterations_,
+                    "RKL2: number of CG iterations to estimate the maximal "
+                    "eigenvalue that determines the number of stages");
+
+      rkl2_safety_factor_ = 1.2;
+      add_parameter("rkl2 safety factor",
+                    rkl2_safety_factor_,
+                    "RKL2: safety factor applied to the eigenvalue "
+                    "estimate");
+
+      fused_operator_evaluation_ = false;
+      add_parameter("fused operator evaluation",
+                    fused_operator_evaluation_,
+                    "Apply the lumped mass matrix contribution of the "
+                    "velocity and internal energy operators within the "
+                    "matrix-free cell loop (as pre-operation on each index "
+                    "range) instead of a separate pass over all vectors");
 
       tolerance_ = Number(1.0e-12);
       add_parameter("tolerance", tolerance_, "Tolerance for linear solvers");
@@ -119,6 +430,37 @@ namespace ryujin
                     tolerance_linfty_norm_,
                     "Use the l_infty norm instead of the l_2 norm for the "
                     "stopping criterion");
+
+      tolerance_adaptive_ = false;
+      add_parameter(
+          "tolerance adaptive",
+          tolerance_adaptive_,
+          "Tie the (relative) tolerance of the linear solvers to the time "
+          "step size: the solvers stop at min(maximum, max(tolerance, "
+          "factor * tau^order)), i.e., an algebraic error that stays below "
+          "the splitting and time discretization error. The fixed "
+          "\"tolerance\" acts as a floor. If the inexact internal energy "
+          "solve violates the minimum principle it is continued down to "
+          "the fixed tolerance before a restart is signalled");
+
+      tolerance_adaptive_factor_ = Number(1.);
+      add_parameter("tolerance adaptive factor",
+                    tolerance_adaptive_factor_,
+                    "Adaptive tolerance: the factor in front of tau^order. "
+                    "Note that tau is dimensional, the factor thus scales "
+                    "with one over a reference time to the power order");
+
+      tolerance_adaptive_order_ = Number(2.);
+      add_parameter("tolerance adaptive order",
+                    tolerance_adaptive_order_,
+                    "Adaptive tolerance: the power of tau, i.e., the order "
+                    "of the (Strang) splitting error");
+
+      tolerance_adaptive_maximum_ = Number(1.0e-4);
+      add_parameter("tolerance adaptive maximum",
+                    tolerance_adaptive_maximum_,
+                    "Adaptive tolerance: upper bound for the relative "
+                    "tolerance");
     }
 
 
@@ -135,11 +477,14 @@ namespace ryujin
       additional_data.tasks_parallel_scheme =
           MatrixFree<dim, Number>::AdditionalData::none;
 
-      matrix_free_.reinit(offline_data_->discretization().mapping(),
-                          offline_data_->dof_handler(),
-                          offline_data_->affine_constraints(),
-                          offline_data_->discretization().quadrature_1d(),
-                          additional_data);
+      {
+        SetupScope scope("parabolic solver - matrix free");
+        matrix_free_.reinit(offline_data_->discretization().mapping(),
+                            offline_data_->dof_handler(),
+                            offline_data_->affine_constraints(),
+                            offline_data_->discretization().quadrature_1d(),
+                            additional_data);
+      }
 
       const auto &scalar_partitioner =
           matrix_free_.get_dof_info(0).vector_partitioner;
@@ -156,6 +501,17 @@ namespace ryujin
 
       density_.reinit(scalar_partitioner);
 
+      n_previous_solutions_ = 0;
+      if (extrapolate_initial_guess_) {
+        for (auto &it : previous_velocity_)
+          it.reinit(velocity_);
+        for (auto &it : previous_internal_energy_)
+          it.reinit(scalar_partitioner);
+      }
+
+      max_eigenvalues_velocity_.clear();
+      max_eigenvalues_energy_.clear();
+
       /* Initialize multigrid: */
 
       if (!use_gmg_velocity_ && !use_gmg_internal_energy_)
@@ -163,7 +519,30 @@ namespace ryujin
 
       const unsigned int n_levels =
           offline_data_->dof_handler().get_triangulation().n_global_levels();
-      const unsigned int min_level = std::min(gmg_min_level_, n_levels - 1);
+      unsigned int min_level = std::min(gmg_min_level_, n_levels - 1);
+
+      if (gmg_min_cells_per_rank_ != 0) {
+        const auto &triangulation =
+            offline_data_->dof_handler().get_triangulation();
+        const auto n_ranks = Utilities::MPI::n_mpi_processes(mpi_communicator_);
+
+        /* Count the (global) number of cells on all levels: */
+        std::vector<double> n_cells(n_levels, 0.);
+        for (unsigned int level = min_level; level < n_levels; ++level)
+          for (const auto &cell : triangulation.cell_iterators_on_level(level))
+            if (cell->is_locally_owned_on_level())
+              n_cells[level] += 1.;
+        n_cells = Utilities::MPI::sum(n_cells, mpi_communicator_);
+
+        while (min_level + 1 < n_levels &&
+               n_cells[min_level] < double(gmg_min_cells_per_rank_) * n_ranks)
+          ++min_level;
+      }
+
+      offline_data_->prepare_multigrid_data(min_level);
+
+      SetupScope scope("parabolic solver - multigrid");
+
       MGLevelObject<IndexSet> relevant_sets(0, n_levels - 1);
       for (unsigned int level = 0; level < n_levels; ++level)
         dealii::DoFTools::extract_locally_relevant_level_dofs(
@@ -176,13 +555,59 @@ namespace ryujin
       mg_constrained_dofs_.make_zero_boundary_constraints(
           offline_data_->dof_handler(), boundary_ids);
 
+      /*
+       * For mixed-precision iterative refinement we need single precision
+       * versions of the operators on the active level:
+       */
+      float_vector_pool_.clear();
+      float_block_vector_pool_.clear();
+
+      if (gmg_mixed_precision_) {
+        typename MatrixFree<dim, float>::AdditionalData additional_data_float;
+        additional_data_float.tasks_parallel_scheme =
+            MatrixFree<dim, float>::AdditionalData::none;
+
+        matrix_free_float_.reinit(
+            offline_data_->discretization().mapping(),
+            offline_data_->dof_handler(),
+            offline_data_->affine_constraints(),
+            offline_data_->discretization().quadrature_1d(),
+            additional_data_float);
+        matrix_free_float_.initialize_dof_vector(density_float_);
+        matrix_free_float_.initialize_dof_vector(lumped_mass_matrix_float_);
+        lumped_mass_matrix_float_.copy_locally_owned_data_from(
+            offline_data_->lumped_mass_matrix());
+      }
+
       typename MatrixFree<dim, float>::AdditionalData additional_data_level;
       additional_data_level.tasks_parallel_scheme =
           MatrixFree<dim, float>::AdditionalData::none;
 
+      /*
+       * Keep a (shared) copy of the old level matrix-free objects. Levels
+       * with unchanged generation number (see
+       * OfflineData::level_generation()) are copied instead of being
+       * reinitialized from scratch:
+       */
+      const auto old_level_matrix_free = level_matrix_free_;
+      const auto &level_generation = offline_data_->level_generation();
+
       level_matrix_free_.resize(min_level, n_levels - 1);
       level_density_.resize(min_level, n_levels - 1);
+      level_matrix_free_generation_.resize(n_levels,
+                                           numbers::invalid_unsigned_int);
       for (unsigned int level = min_level; level < n_levels; ++level) {
+        if (old_level_matrix_free.n_levels() > 0 &&
+            level >= old_level_matrix_free.min_level() &&
+            level <= old_level_matrix_free.max_level() &&
+            level_matrix_free_generation_[level] == level_generation[level]) {
+          level_matrix_free_[level].copy_from(old_level_matrix_free[level]);
+          level_matrix_free_[level].initialize_dof_vector(
+              level_density_[level]);
+          continue;
+        }
+
+        level_matrix_free_generation_[level] = level_generation[level];
         additional_data_level.mg_level = level;
         AffineConstraints<double> constraints(relevant_sets[level]);
         // constraints.add_lines(mg_constrained_dofs_.get_boundary_indices(level));
@@ -204,6 +629,52 @@ namespace ryujin
                                 level_matrix_free_);
     }
 
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::reset_history() const
+    {
+      n_previous_solutions_ = 0;
+      max_eigenvalues_velocity_.clear();
+      max_eigenvalues_energy_.clear();
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    bool ParabolicSolver<Description, dim, Number>::keeps_history() const
+    {
+      return extrapolate_initial_guess_ || gmg_eigenvalue_reuse_tolerance_ > 0.;
+    }
+
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const
+    {
+      statistics.push_back({"ParabolicSolver: matrix free",
+                            matrix_free_.memory_consumption()});
+
+      statistics.push_back({"ParabolicSolver: multigrid",
+                            level_matrix_free_.memory_consumption() +
+                                level_density_.memory_consumption() +
+                                matrix_free_float_.memory_consumption() +
+                                density_float_.memory_consumption() +
+                                lumped_mass_matrix_float_.memory_consumption() +
+                                float_vector_pool_.memory_consumption() +
+                                float_block_vector_pool_.memory_consumption() +
+                                mg_transfer_velocity_.memory_consumption() +
+                                mg_transfer_energy_.memory_consumption()});
+
+      std::size_t vectors = velocity_.memory_consumption() +
+                            velocity_rhs_.memory_consumption() +
+                            internal_energy_.memory_consumption() +
+                            internal_energy_rhs_.memory_consumption() +
+                            density_.memory_consumption();
+      for (unsigned int i = 0; i < 2; ++i)
+        vectors += previous_velocity_[i].memory_consumption() +
+                   previous_internal_energy_[i].memory_consumption();
+      statistics.push_back({"ParabolicSolver: vectors", vectors});
+    }
+
     template <typename Description, int dim, typename Number>
     void ParabolicSolver<Description, dim, Number>::crank_nicolson_step(
         const vector_type &old_U,
@@ -249,6 +720,19 @@ namespace ryujin
       /* A boolean signalling that a restart is necessary: */
       std::atomic<bool> restart_needed = false;
 
+      /*
+       * The relative tolerance of the linear solvers, either fixed, or
+       * tied to tau^order and bounded from below by the fixed tolerance:
+       */
+      Number relative_tolerance = tolerance_;
+      if (tolerance_adaptive_) {
+        const Number adaptive =
+            tolerance_adaptive_factor_ *
+            std::pow(tau_, tolerance_adaptive_order_);
+        relative_tolerance = std::max(
+            tolerance_, std::min(adaptive, tolerance_adaptive_maximum_));
+      }
+
       /*
        * Step 1:
        *
@@ -298,6 +782,32 @@ namespace ryujin
           internal_energy_.local_element(i) = rho_e_i / rho_i;
         }
 
+        /*
+         * Replace the initial guess for the velocity and internal energy
+         * by a linear extrapolation in time of the solutions of the last
+         * two Crank-Nicolson steps:
+         */
+
+        if (extrapolate_initial_guess_ && n_previous_solutions_ > 0 &&
+            time_stepping_ == TimeStepping::crank_nicolson) {
+          velocity_ = previous_velocity_[0];
+          internal_energy_ = previous_internal_energy_[0];
+
+          const Number delta_t = previous_times_[0] - previous_times_[1];
+          if (n_previous_solutions_ > 1 && delta_t > Number(0.)) {
+            const Number factor =
+                (t + theta_ * tau_ - previous_times_[0]) / delta_t;
+            velocity_.add(factor,
+                          previous_velocity_[0],
+                          -factor,
+                          previous_velocity_[1]);
+            internal_energy_.add(factor,
+                                 previous_internal_energy_[0],
+                                 -factor,
+                                 previous_internal_energy_[1]);
+          }
+        }
+
         /*
          * Set up "strongly enforced" boundary conditions that are not stored
          * in the AffineConstraints map. In this case we enforce boundary
@@ -377,12 +887,17 @@ namespace ryujin
         diagonal_matrix.reinit(
             lumped_mass_matrix, density_, affine_constraints);
 
+        if (gmg_mixed_precision_ &&
+            (use_gmg_velocity_ || use_gmg_internal_energy_))
+          density_float_.copy_locally_owned_data_from(density_);
+
         /*
          * Update MG matrices all 4 time steps; this is a balance because more
          * refreshes will render the approximation better, at some additional
          * cost.
          */
-        if (use_gmg_velocity_ && reinitialize_gmg) {
+        if (use_gmg_velocity_ && reinitialize_gmg &&
+            time_stepping_ == TimeStepping::crank_nicolson) {
           MGLevelObject<typename PreconditionChebyshev<
               VelocityMatrix<dim, float, Number>,
               LinearAlgebra::distributed::BlockVector<float>,
@@ -395,6 +910,14 @@ namespace ryujin
           mg_transfer_velocity_.interpolate_to_mg(
               offline_data_->dof_handler(), level_density_, density_);
 
+          const unsigned int min_level = level_matrix_free_.min_level();
+          const bool reuse_eigenvalues =
+              gmg_eigenvalue_reuse_tolerance_ > 0. &&
+              gmg_smoother_n_cg_iter_ > 0 &&
+              !max_eigenvalues_velocity_.empty() &&
+              std::abs(tau_ - eigenvalue_tau_velocity_) <=
+                  gmg_eigenvalue_reuse_tolerance_ * eigenvalue_tau_velocity_;
+
           for (unsigned int level = level_matrix_free_.min_level();
                level <= level_matrix_free_.max_level();
                ++level) {
@@ -404,10 +927,12 @@ namespace ryujin
                 level_matrix_free_[level],
                 level_density_[level],
                 theta_ * tau_,
-                level);
+                level,
+                fused_operator_evaluation_);
             level_velocity_matrices_[level].compute_diagonal(
                 smoother_data[level].preconditioner);
-            if (level == level_matrix_free_.min_level()) {
+            if (level == level_matrix_free_.min_level() &&
+                gmg_coarse_solver_ == CoarseGridSolver::chebyshev) {
               smoother_data[level].degree = numbers::invalid_unsigned_int;
               smoother_data[level].eig_cg_n_iterations = 500;
               smoother_data[level].smoothing_range = 1e-3;
@@ -418,10 +943,35 @@ namespace ryujin
               smoother_data[level].smoothing_range = gmg_smoother_range_vel_;
               if (gmg_smoother_n_cg_iter_ == 0)
                 smoother_data[level].max_eigenvalue = gmg_smoother_max_eig_vel_;
+              if (reuse_eigenvalues) {
+                smoother_data[level].eig_cg_n_iterations = 0;
+                smoother_data[level].max_eigenvalue =
+                    max_eigenvalues_velocity_[level - min_level];
+              }
             }
           }
           mg_smoother_velocity_.initialize(level_velocity_matrices_,
                                            smoother_data);
+
+          /* Record the eigenvalue estimates for later reuse: */
+          if (gmg_eigenvalue_reuse_tolerance_ > 0. &&
+              gmg_smoother_n_cg_iter_ > 0 && !reuse_eigenvalues) {
+            max_eigenvalues_velocity_.resize(level_matrix_free_.max_level() -
+                                             min_level + 1);
+            for (unsigned int level = min_level;
+                 level <= level_matrix_free_.max_level();
+                 ++level) {
+              LinearAlgebra::distributed::BlockVector<float> temp(dim);
+              for (unsigned int d = 0; d < dim; ++d)
+                level_matrix_free_[level].initialize_dof_vector(temp.block(d));
+              temp.collect_sizes();
+              const auto info =
+                  mg_smoother_velocity_[level].estimate_eigenvalues(temp);
+              max_eigenvalues_velocity_[level - min_level] =
+                  info.max_eigenvalue_estimate;
+            }
+            eigenvalue_tau_velocity_ = tau_;
+          }
         }
 
         LIKWID_MARKER_STOP("time_step_parabolic_1");
@@ -452,62 +1002,163 @@ namespace ryujin
                                      *offline_data_,
                                      matrix_free_,
                                      density_,
-                                     theta_ * tau_);
+                                     theta_ * tau_,
+                                     numbers::invalid_unsigned_int,
+                                     fused_operator_evaluation_);
 
         const auto tolerance_velocity =
             (tolerance_linfty_norm_ ? velocity_rhs_.linfty_norm()
                                     : velocity_rhs_.l2_norm()) *
-            tolerance_;
+            relative_tolerance;
 
         /*
          * Multigrid might lack robustness for some cases, so in case it takes
          * too many iterations we better switch to the more robust plain
          * conjugate gradient method.
          */
-        try {
-          if (!use_gmg_velocity_)
-            throw SolverControl::NoConvergence(0, 0.);
-
-          using bvt_float = LinearAlgebra::distributed::BlockVector<float>;
-
-          MGCoarseGridApplySmoother<bvt_float> mg_coarse;
-          mg_coarse.initialize(mg_smoother_velocity_);
-
-          mg::Matrix<bvt_float> mg_matrix(level_velocity_matrices_);
-
-          Multigrid<bvt_float> mg(mg_matrix,
-                                  mg_coarse,
-                                  mg_transfer_velocity_,
-                                  mg_smoother_velocity_,
-                                  mg_smoother_velocity_,
-                                  level_velocity_matrices_.min_level(),
-                                  level_velocity_matrices_.max_level());
-
-          const auto &dof_handler = offline_data_->dof_handler();
-          PreconditionMG<dim, bvt_float, MGTransferVelocity<dim, float>>
-              preconditioner(dof_handler, mg, mg_transfer_velocity_);
-
-          SolverControl solver_control(gmg_max_iter_vel_, tolerance_velocity);
-          SolverCG<block_vector_type> solver(solver_control);
-          solver.solve(
-              velocity_operator, velocity_, velocity_rhs_, preconditioner);
+        if (time_stepping_ == TimeStepping::rkl2) {
+          const auto n_stages = rkl2_step(velocity_operator,
+                                          velocity_,
+                                          velocity_rhs_,
+                                          diagonal_matrix,
+                                          theta_,
+                                          rkl2_eigenvalue_iterations_,
+                                          rkl2_safety_factor_);
 
           /* update exponential moving average */
           n_iterations_velocity_ =
-              0.9 * n_iterations_velocity_ + 0.1 * solver_control.last_step();
+              0.9 * n_iterations_velocity_ + 0.1 * n_stages;
+
+        } else {
+          try {
+            if (!use_gmg_velocity_)
+              throw SolverControl::NoConvergence(0, 0.);
+
+            using bvt_float = LinearAlgebra::distributed::BlockVector<float>;
+            const auto min_level = level_velocity_matrices_.min_level();
+
+            MGCoarseGridApplySmoother<bvt_float> mg_coarse_smoother;
+            mg_coarse_smoother.initialize(mg_smoother_velocity_);
+
+            CoarseReductionControl coarse_control(
+                gmg_coarse_max_iter_, 1.e-30, gmg_coarse_tolerance_);
+            SolverCG<bvt_float> coarse_solver(coarse_control);
+            MGCoarseGridIterativeSolver<
+                bvt_float,
+                SolverCG<bvt_float>,
+                VelocityMatrix<dim, float, Number>,
+                std::remove_reference_t<decltype(mg_smoother_velocity_[0])>>
+                mg_coarse_cg;
+            if (gmg_coarse_solver_ == CoarseGridSolver::cg)
+              mg_coarse_cg.initialize(coarse_solver,
+                                      level_velocity_matrices_[min_level],
+                                      mg_smoother_velocity_[min_level]);
+
+            const MGCoarseGridBase<bvt_float> &mg_coarse =
+                gmg_coarse_solver_ == CoarseGridSolver::cg
+                    ? static_cast<const MGCoarseGridBase<bvt_float> &>(
+                          mg_coarse_cg)
+                    : mg_coarse_smoother;
+
+            mg::Matrix<bvt_float> mg_matrix(level_velocity_matrices_);
+
+            Multigrid<bvt_float> mg(mg_matrix,
+                                    mg_coarse,
+                                    mg_transfer_velocity_,
+                                    mg_smoother_velocity_,
+                                    mg_smoother_velocity_,
+                                    level_velocity_matrices_.min_level(),
+                                    level_velocity_matrices_.max_level());
+
+            const auto &dof_handler = offline_data_->dof_handler();
+            PreconditionMG<dim, bvt_float, MGTransferVelocity<dim, float>>
+                preconditioner(dof_handler, mg, mg_transfer_velocity_);
+
+            unsigned int n_steps = 0;
+            if (gmg_mixed_precision_) {
+              VelocityMatrix<dim, float, Number> velocity_operator_float;
+              velocity_operator_float.initialize(*parabolic_system_,
+                                                 *offline_data_,
+                                                 matrix_free_float_,
+                                                 density_float_,
+                                                 theta_ * tau_,
+                                                 numbers::invalid_unsigned_int,
+                                                 fused_operator_evaluation_);
+              velocity_operator_float.set_lumped_mass_matrix(
+                  lumped_mass_matrix_float_);
+
+              /* Borrow the (idle) temporaries of the last solve: */
+              const auto initialize = [&](bvt_float &vector) {
+                vector.reinit(dim);
+                for (unsigned int d = 0; d < dim; ++d)
+                  matrix_free_float_.initialize_dof_vector(vector.block(d));
+                vector.collect_sizes();
+              };
+              const auto &partitioner =
+                  matrix_free_float_.get_vector_partitioner();
+              auto defect =
+                  float_block_vector_pool_.acquire(partitioner, initialize);
+              auto correction =
+                  float_block_vector_pool_.acquire(partitioner, initialize);
+
+              n_steps = iterative_refinement(
+                  velocity_operator,
+                  velocity_operator_float,
+                  velocity_,
+                  velocity_rhs_,
+                  *defect,
+                  *correction,
+                  preconditioner,
+                  tolerance_velocity,
+                  tolerance_linfty_norm_,
+                  gmg_outer_solver_ == OuterSolver::fgmres,
+                  gmg_mixed_precision_reduction_,
+                  gmg_max_iter_vel_,
+                  gmg_mixed_precision_max_refinement_);
+
+            } else {
+              SolverControl solver_control(gmg_max_iter_vel_,
+                                           tolerance_velocity);
+              if (gmg_outer_solver_ == OuterSolver::fgmres) {
+                SolverFGMRES<block_vector_type> solver(solver_control);
+                solver.solve(velocity_operator,
+                             velocity_,
+                             velocity_rhs_,
+                             preconditioner);
+              } else if (gmg_outer_solver_ == OuterSolver::pipelined_cg) {
+                SolverPipelinedCG<block_vector_type> solver(
+                    solver_control, mpi_communicator_, tolerance_linfty_norm_);
+                solver.solve(velocity_operator,
+                             velocity_,
+                             velocity_rhs_,
+                             preconditioner);
+              } else {
+                SolverCG<block_vector_type> solver(solver_control);
+                solver.solve(velocity_operator,
+                             velocity_,
+                             velocity_rhs_,
+                             preconditioner);
+              }
+              n_steps = solver_control.last_step();
+            }
+
+            /* update exponential moving average */
+            n_iterations_velocity_ =
+                0.9 * n_iterations_velocity_ + 0.1 * n_steps;
 
-        } catch (SolverControl::NoConvergence &) {
+          } catch (SolverControl::NoConvergence &) {
 
-          SolverControl solver_control(1000, tolerance_velocity);
-          SolverCG<block_vector_type> solver(solver_control);
-          solver.solve(
-              velocity_operator, velocity_, velocity_rhs_, diagonal_matrix);
+            SolverControl solver_control(1000, tolerance_velocity);
+            SolverCG<block_vector_type> solver(solver_control);
+            solver.solve(
+                velocity_operator, velocity_, velocity_rhs_, diagonal_matrix);
 
-          /* update exponential moving average, counting also GMG iterations */
-          n_iterations_velocity_ *= 0.9;
-          n_iterations_velocity_ +=
-              0.1 * (use_gmg_velocity_ ? gmg_max_iter_vel_ : 0) +
-              0.1 * solver_control.last_step();
+            /* update exponential moving average, counting GMG iterations */
+            n_iterations_velocity_ *= 0.9;
+            n_iterations_velocity_ +=
+                0.1 * (use_gmg_velocity_ ? gmg_max_iter_vel_ : 0) +
+                0.1 * solver_control.last_step();
+          }
         }
 
         LIKWID_MARKER_STOP("time_step_parabolic_1");
@@ -644,7 +1295,8 @@ namespace ryujin
          * refreshes will render the approximation better, at some additional
          * cost.
          */
-        if (use_gmg_internal_energy_ && reinitialize_gmg) {
+        if (use_gmg_internal_energy_ && reinitialize_gmg &&
+            time_stepping_ == TimeStepping::crank_nicolson) {
           MGLevelObject<typename PreconditionChebyshev<
               EnergyMatrix<dim, float, Number>,
               LinearAlgebra::distributed::Vector<float>>::AdditionalData>
@@ -654,6 +1306,14 @@ namespace ryujin
           level_energy_matrices_.resize(level_matrix_free_.min_level(),
                                         level_matrix_free_.max_level());
 
+          const unsigned int min_level = level_matrix_free_.min_level();
+          const bool reuse_eigenvalues =
+              gmg_eigenvalue_reuse_tolerance_ > 0. &&
+              gmg_smoother_n_cg_iter_ > 0 &&
+              !max_eigenvalues_energy_.empty() &&
+              std::abs(tau_ - eigenvalue_tau_energy_) <=
+                  gmg_eigenvalue_reuse_tolerance_ * eigenvalue_tau_energy_;
+
           for (unsigned int level = level_matrix_free_.min_level();
                level <= level_matrix_free_.max_level();
                ++level) {
@@ -662,10 +1322,12 @@ namespace ryujin
                 level_matrix_free_[level],
                 level_density_[level],
                 theta_ * tau_ * parabolic_system_->cv_inverse_kappa(),
-                level);
+                level,
+                fused_operator_evaluation_);
             level_energy_matrices_[level].compute_diagonal(
                 smoother_data[level].preconditioner);
-            if (level == level_matrix_free_.min_level()) {
+            if (level == level_matrix_free_.min_level() &&
+                gmg_coarse_solver_ == CoarseGridSolver::chebyshev) {
               smoother_data[level].degree = numbers::invalid_unsigned_int;
               smoother_data[level].eig_cg_n_iterations = 500;
               smoother_data[level].smoothing_range = 1e-3;
@@ -676,9 +1338,32 @@ namespace ryujin
               smoother_data[level].smoothing_range = gmg_smoother_range_en_;
               if (gmg_smoother_n_cg_iter_ == 0)
                 smoother_data[level].max_eigenvalue = gmg_smoother_max_eig_en_;
+              if (reuse_eigenvalues) {
+                smoother_data[level].eig_cg_n_iterations = 0;
+                smoother_data[level].max_eigenvalue =
+                    max_eigenvalues_energy_[level - min_level];
+              }
             }
           }
           mg_smoother_energy_.initialize(level_energy_matrices_, smoother_data);
+
+          /* Record the eigenvalue estimates for later reuse: */
+          if (gmg_eigenvalue_reuse_tolerance_ > 0. &&
+              gmg_smoother_n_cg_iter_ > 0 && !reuse_eigenvalues) {
+            max_eigenvalues_energy_.resize(level_matrix_free_.max_level() -
+                                           min_level + 1);
+            for (unsigned int level = min_level;
+                 level <= level_matrix_free_.max_level();
+                 ++level) {
+              LinearAlgebra::distributed::Vector<float> temp;
+              level_matrix_free_[level].initialize_dof_vector(temp);
+              const auto info =
+                  mg_smoother_energy_[level].estimate_eigenvalues(temp);
+              max_eigenvalues_energy_[level - min_level] =
+                  info.max_eigenvalue_estimate;
+            }
+            eigenvalue_tau_energy_ = tau_;
+          }
         }
 
         LIKWID_MARKER_STOP("time_step_parabolic_2");
@@ -694,64 +1379,161 @@ namespace ryujin
         LIKWID_MARKER_START("time_step_parabolic_2");
 
         EnergyMatrix<dim, Number, Number> energy_operator;
-        energy_operator.initialize(*offline_data_,
-                                   matrix_free_,
-                                   density_,
-                                   theta_ * tau_ *
-                                       parabolic_system_->cv_inverse_kappa());
-
+        energy_operator.initialize(
+            *offline_data_,
+            matrix_free_,
+            density_,
+            theta_ * tau_ * parabolic_system_->cv_inverse_kappa(),
+            numbers::invalid_unsigned_int,
+            fused_operator_evaluation_);
+
+        const auto rhs_norm_internal_energy =
+            tolerance_linfty_norm_ ? internal_energy_rhs_.linfty_norm()
+                                   : internal_energy_rhs_.l2_norm();
         const auto tolerance_internal_energy =
-            (tolerance_linfty_norm_ ? internal_energy_rhs_.linfty_norm()
-                                    : internal_energy_rhs_.l2_norm()) *
-            tolerance_;
-
-        try {
-          if (!use_gmg_internal_energy_)
-            throw SolverControl::NoConvergence(0, 0.);
-
-          using vt_float = LinearAlgebra::distributed::Vector<float>;
-          MGCoarseGridApplySmoother<vt_float> mg_coarse;
-          mg_coarse.initialize(mg_smoother_energy_);
-          mg::Matrix<vt_float> mg_matrix(level_energy_matrices_);
-
-          Multigrid<vt_float> mg(mg_matrix,
-                                 mg_coarse,
-                                 mg_transfer_energy_,
-                                 mg_smoother_energy_,
-                                 mg_smoother_energy_,
-                                 level_energy_matrices_.min_level(),
-                                 level_energy_matrices_.max_level());
-
-          const auto &dof_handler = offline_data_->dof_handler();
-          PreconditionMG<dim, vt_float, MGTransferEnergy<dim, float>>
-              preconditioner(dof_handler, mg, mg_transfer_energy_);
-
-          SolverControl solver_control(gmg_max_iter_en_,
-                                       tolerance_internal_energy);
-          SolverCG<scalar_type> solver(solver_control);
-          solver.solve(energy_operator,
-                       internal_energy_,
-                       internal_energy_rhs_,
-                       preconditioner);
+            rhs_norm_internal_energy * relative_tolerance;
+
+        if (time_stepping_ == TimeStepping::rkl2) {
+          const auto n_stages = rkl2_step(energy_operator,
+                                          internal_energy_,
+                                          internal_energy_rhs_,
+                                          diagonal_matrix,
+                                          theta_,
+                                          rkl2_eigenvalue_iterations_,
+                                          rkl2_safety_factor_);
 
           /* update exponential moving average */
-          n_iterations_internal_energy_ = 0.9 * n_iterations_internal_energy_ +
-                                          0.1 * solver_control.last_step();
-
-        } catch (SolverControl::NoConvergence &) {
-
-          SolverControl solver_control(1000, tolerance_internal_energy);
-          SolverCG<scalar_type> solver(solver_control);
-          solver.solve(energy_operator,
-                       internal_energy_,
-                       internal_energy_rhs_,
-                       diagonal_matrix);
-
-          /* update exponential moving average, counting also GMG iterations */
-          n_iterations_internal_energy_ *= 0.9;
-          n_iterations_internal_energy_ +=
-              0.1 * (use_gmg_internal_energy_ ? gmg_max_iter_en_ : 0) +
-              0.1 * solver_control.last_step();
+          n_iterations_internal_energy_ =
+              0.9 * n_iterations_internal_energy_ + 0.1 * n_stages;
+
+        } else {
+          try {
+            if (!use_gmg_internal_energy_)
+              throw SolverControl::NoConvergence(0, 0.);
+
+            using vt_float = LinearAlgebra::distributed::Vector<float>;
+            const auto min_level = level_energy_matrices_.min_level();
+
+            MGCoarseGridApplySmoother<vt_float> mg_coarse_smoother;
+            mg_coarse_smoother.initialize(mg_smoother_energy_);
+
+            CoarseReductionControl coarse_control(
+                gmg_coarse_max_iter_, 1.e-30, gmg_coarse_tolerance_);
+            SolverCG<vt_float> coarse_solver(coarse_control);
+            MGCoarseGridIterativeSolver<
+                vt_float,
+                SolverCG<vt_float>,
+                EnergyMatrix<dim, float, Number>,
+                std::remove_reference_t<decltype(mg_smoother_energy_[0])>>
+                mg_coarse_cg;
+            if (gmg_coarse_solver_ == CoarseGridSolver::cg)
+              mg_coarse_cg.initialize(coarse_solver,
+                                      level_energy_matrices_[min_level],
+                                      mg_smoother_energy_[min_level]);
+
+            const MGCoarseGridBase<vt_float> &mg_coarse =
+                gmg_coarse_solver_ == CoarseGridSolver::cg
+                    ? static_cast<const MGCoarseGridBase<vt_float> &>(
+                          mg_coarse_cg)
+                    : mg_coarse_smoother;
+
+            mg::Matrix<vt_float> mg_matrix(level_energy_matrices_);
+
+            Multigrid<vt_float> mg(mg_matrix,
+                                   mg_coarse,
+                                   mg_transfer_energy_,
+                                   mg_smoother_energy_,
+                                   mg_smoother_energy_,
+                                   level_energy_matrices_.min_level(),
+                                   level_energy_matrices_.max_level());
+
+            const auto &dof_handler = offline_data_->dof_handler();
+            PreconditionMG<dim, vt_float, MGTransferEnergy<dim, float>>
+                preconditioner(dof_handler, mg, mg_transfer_energy_);
+
+            unsigned int n_steps = 0;
+            if (gmg_mixed_precision_) {
+              EnergyMatrix<dim, float, Number> energy_operator_float;
+              energy_operator_float.initialize(
+                  *offline_data_,
+                  matrix_free_float_,
+                  density_float_,
+                  theta_ * tau_ * parabolic_system_->cv_inverse_kappa(),
+                  numbers::invalid_unsigned_int,
+                  fused_operator_evaluation_);
+              energy_operator_float.set_lumped_mass_matrix(
+                  lumped_mass_matrix_float_);
+
+              /* Borrow the (idle) temporaries of the last solve: */
+              const auto initialize = [&](vt_float &vector) {
+                matrix_free_float_.initialize_dof_vector(vector);
+              };
+              const auto &partitioner =
+                  matrix_free_float_.get_vector_partitioner();
+              auto defect = float_vector_pool_.acquire(partitioner, initialize);
+              auto correction =
+                  float_vector_pool_.acquire(partitioner, initialize);
+
+              n_steps = iterative_refinement(
+                  energy_operator,
+                  energy_operator_float,
+                  internal_energy_,
+                  internal_energy_rhs_,
+                  *defect,
+                  *correction,
+                  preconditioner,
+                  tolerance_internal_energy,
+                  tolerance_linfty_norm_,
+                  gmg_outer_solver_ == OuterSolver::fgmres,
+                  gmg_mixed_precision_reduction_,
+                  gmg_max_iter_en_,
+                  gmg_mixed_precision_max_refinement_);
+
+            } else {
+              SolverControl solver_control(gmg_max_iter_en_,
+                                           tolerance_internal_energy);
+              if (gmg_outer_solver_ == OuterSolver::fgmres) {
+                SolverFGMRES<scalar_type> solver(solver_control);
+                solver.solve(energy_operator,
+                             internal_energy_,
+                             internal_energy_rhs_,
+                             preconditioner);
+              } else if (gmg_outer_solver_ == OuterSolver::pipelined_cg) {
+                SolverPipelinedCG<scalar_type> solver(
+                    solver_control, mpi_communicator_, tolerance_linfty_norm_);
+                solver.solve(energy_operator,
+                             internal_energy_,
+                             internal_energy_rhs_,
+                             preconditioner);
+              } else {
+                SolverCG<scalar_type> solver(solver_control);
+                solver.solve(energy_operator,
+                             internal_energy_,
+                             internal_energy_rhs_,
+                             preconditioner);
+              }
+              n_steps = solver_control.last_step();
+            }
+
+            /* update exponential moving average */
+            n_iterations_internal_energy_ =
+                0.9 * n_iterations_internal_energy_ + 0.1 * n_steps;
+
+          } catch (SolverControl::NoConvergence &) {
+
+            SolverControl solver_control(1000, tolerance_internal_energy);
+            SolverCG<scalar_type> solver(solver_control);
+            solver.solve(energy_operator,
+                         internal_energy_,
+                         internal_energy_rhs_,
+                         diagonal_matrix);
+
+            /* update exponential moving average, counting GMG iterations */
+            n_iterations_internal_energy_ *= 0.9;
+            n_iterations_internal_energy_ +=
+                0.1 * (use_gmg_internal_energy_ ? gmg_max_iter_en_ : 0) +
+                0.1 * solver_control.last_step();
+          }
         }
 
         /*
@@ -763,6 +1545,25 @@ namespace ryujin
                                              internal_energy_.end());
           e_min_new = Utilities::MPI::min(e_min_new, mpi_communicator_);
 
+          /*
+           * Positivity floor for the adaptive tolerance: continue the
+           * inexact solve down to the fixed tolerance first:
+           */
+          if (e_min_new < e_min_old && relative_tolerance > tolerance_ &&
+              time_stepping_ != TimeStepping::rkl2) {
+            SolverControl solver_control(1000,
+                                         rhs_norm_internal_energy * tolerance_);
+            SolverCG<scalar_type> solver(solver_control);
+            solver.solve(energy_operator,
+                         internal_energy_,
+                         internal_energy_rhs_,
+                         diagonal_matrix);
+
+            e_min_new = *std::min_element(internal_energy_.begin(),
+                                          internal_energy_.end());
+            e_min_new = Utilities::MPI::min(e_min_new, mpi_communicator_);
+          }
+
           if (e_min_new < e_min_old) {
 #ifdef DEBUG_OUTPUT
             std::cout << std::fixed << std::setprecision(16);
@@ -865,6 +1666,17 @@ namespace ryujin
           throw Restart();
         }
       }
+
+      /* Store solutions for the extrapolated initial guess: */
+      if (extrapolate_initial_guess_) {
+        previous_velocity_[1].swap(previous_velocity_[0]);
+        previous_internal_energy_[1].swap(previous_internal_energy_[0]);
+        previous_velocity_[0] = velocity_;
+        previous_internal_energy_[0] = internal_energy_;
+        previous_times_[1] = previous_times_[0];
+        previous_times_[0] = t + theta_ * tau_;
+        n_previous_solutions_ = std::min(n_previous_solutions_ + 1, 2u);
+      }
     }
 
 
@@ -880,5 +1692,15 @@ namespace ryujin
              << std::endl;
     }
 
+
+    template <typename Description, int dim, typename Number>
+    void ParabolicSolver<Description, dim, Number>::collect_solver_statistics(
+        std::vector<std::pair<std::string, double>> &statistics) const
+    {
+      statistics.push_back({"velocity_iterations", n_iterations_velocity_});
+      statistics.push_back(
+          {"internal_energy_iterations", n_iterations_internal_energy_});
+    }
+
   } // namespace NavierStokes
 } /* namespace ryujin */
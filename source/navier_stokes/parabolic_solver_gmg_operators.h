@@ -150,6 +150,16 @@ namespace ryujin
      * An operator describing the velocity-velocity subblock of the
      * parabolic system.
      *
+     * All dim velocity components are processed together by a single
+     * vector-valued FEEvaluation within one cell loop, i.e., the geometry
+     * data (Jacobians and JxW values) of a cell batch is loaded only once
+     * per operator application for all components. This also holds for
+     * the Chebyshev smoother that uses this operator on the multigrid
+     * levels. Note that the components are coupled through the symmetric
+     * gradient of the stress tensor and through slip boundary
+     * conditions; thus the system cannot be split into dim independent
+     * scalar solves.
+     *
      * @ingroup NavierStokesEquations
      */
     template <int dim, typename Number, typename Number2>
@@ -168,7 +178,8 @@ namespace ryujin
           const dealii::MatrixFree<dim, Number> &matrix_free,
           const dealii::LinearAlgebra::distributed::Vector<Number> &density,
           const Number theta_x_tau,
-          const unsigned int level = dealii::numbers::invalid_unsigned_int)
+          const unsigned int level = dealii::numbers::invalid_unsigned_int,
+          const bool fused = false)
       {
         parabolic_system_ = &parabolic_system;
         offline_data_ = &offline_data;
@@ -176,6 +187,20 @@ namespace ryujin
         density_ = &density;
         theta_x_tau_ = theta_x_tau;
         level_ = level;
+        fused_ = fused;
+        lumped_mass_matrix_ = nullptr;
+      }
+
+      /**
+       * Use @p lumped_mass_matrix instead of the lumped mass matrix
+       * stored in OfflineData. This is needed for an operator on the
+       * active level with a precision Number that differs from the
+       * precision Number2 of OfflineData. Has to be called after
+       * initialize().
+       */
+      void set_lumped_mass_matrix(const vector_type &lumped_mass_matrix)
+      {
+        lumped_mass_matrix_ = &lumped_mass_matrix;
       }
 
       void Tvmult(block_vector_type &dst, const block_vector_type &src) const
@@ -185,55 +210,57 @@ namespace ryujin
 
       void vmult(block_vector_type &dst, const block_vector_type &src) const
       {
-        /* Apply action of m_i rho_i V_i: */
-
         using VA = dealii::VectorizedArray<Number>;
         constexpr auto simd_length = VA::size();
 
-        const vector_type *lumped_mass_matrix = nullptr;
-        if constexpr (std::is_same<Number, Number2>::value) {
-          if constexpr (std::is_same<Number, float>::value) {
-            if (level_ == dealii::numbers::invalid_unsigned_int)
+        const vector_type *lumped_mass_matrix = lumped_mass_matrix_;
+        if (lumped_mass_matrix == nullptr) {
+          if constexpr (std::is_same<Number, Number2>::value) {
+            if constexpr (std::is_same<Number, float>::value) {
+              if (level_ == dealii::numbers::invalid_unsigned_int)
+                lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
+              else
+                lumped_mass_matrix =
+                    &offline_data_->level_lumped_mass_matrix()[level_];
+            } else {
+              Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                     dealii::ExcInternalError());
               lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-            else
-              lumped_mass_matrix =
-                  &offline_data_->level_lumped_mass_matrix()[level_];
-          } else {
-            Assert(level_ == dealii::numbers::invalid_unsigned_int,
-                   dealii::ExcInternalError());
-            lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-          }
-        } else
-          lumped_mass_matrix =
-              &offline_data_->level_lumped_mass_matrix()[level_];
+            }
+          } else
+            lumped_mass_matrix =
+                &offline_data_->level_lumped_mass_matrix()[level_];
+        }
 
         const unsigned int n_owned =
             lumped_mass_matrix->get_partitioner()->locally_owned_size();
-        const unsigned int size_regular = n_owned / simd_length * simd_length;
 
-        RYUJIN_PARALLEL_REGION_BEGIN
+        /* Apply action of m_i rho_i V_i on the index range [left, right): */
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = 0; i < size_regular; i += simd_length) {
-          const auto m_i = load_value<VA>(*lumped_mass_matrix, i);
-          const auto rho_i = load_value<VA>(*density_, i);
-          for (unsigned int d = 0; d < dim; ++d) {
-            const auto temp = load_value<VA>(src.block(d), i);
-            store_value<VA>(dst.block(d), m_i * rho_i * temp, i);
-          }
-        }
+        const auto apply_mass = [&](const unsigned int left,
+                                    const unsigned int right) {
+          const unsigned int size_regular =
+              left + (right - left) / simd_length * simd_length;
 
-        RYUJIN_PARALLEL_REGION_END
+          for (unsigned int i = left; i < size_regular; i += simd_length) {
+            const auto m_i = load_value<VA>(*lumped_mass_matrix, i);
+            const auto rho_i = load_value<VA>(*density_, i);
+            for (unsigned int d = 0; d < dim; ++d) {
+              const auto temp = load_value<VA>(src.block(d), i);
+              store_value<VA>(dst.block(d), m_i * rho_i * temp, i);
+            }
+          }
 
-        for (unsigned int i = size_regular; i < n_owned; ++i) {
-          const auto m_i = lumped_mass_matrix->local_element(i);
-          const auto rho_i = density_->local_element(i);
+          for (unsigned int i = size_regular; i < right; ++i) {
+            const auto m_i = lumped_mass_matrix->local_element(i);
+            const auto rho_i = density_->local_element(i);
 
-          for (unsigned int d = 0; d < dim; ++d) {
-            const auto temp = src.block(d).local_element(i);
-            dst.block(d).local_element(i) = m_i * rho_i * temp;
+            for (unsigned int d = 0; d < dim; ++d) {
+              const auto temp = src.block(d).local_element(i);
+              dst.block(d).local_element(i) = m_i * rho_i * temp;
+            }
           }
-        }
+        };
 
         /* Apply action of stress tensor: + theta * \sum_j B_ij V_j: */
 
@@ -254,8 +281,38 @@ namespace ryujin
           }
         };
 
-        matrix_free_->template cell_loop<block_vector_type, block_vector_type>(
-            integrator, dst, src, /* zero destination */ false);
+        if (fused_) {
+          /*
+           * Apply the mass matrix on each index range right before the
+           * first cell touching it is processed. This way the vectors
+           * are streamed only once per application:
+           */
+          matrix_free_
+              ->template cell_loop<block_vector_type, block_vector_type>(
+                  integrator,
+                  dst,
+                  src,
+                  apply_mass,
+                  [](const unsigned int, const unsigned int) {});
+
+        } else {
+          const unsigned int size_regular =
+              n_owned / simd_length * simd_length;
+
+          RYUJIN_PARALLEL_REGION_BEGIN
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = 0; i < size_regular; i += simd_length)
+            apply_mass(i, i + simd_length);
+
+          RYUJIN_PARALLEL_REGION_END
+
+          apply_mass(size_regular, n_owned);
+
+          matrix_free_
+              ->template cell_loop<block_vector_type, block_vector_type>(
+                  integrator, dst, src, /* zero destination */ false);
+        }
 
         /* (5.4a) Fix up constrained degrees of freedom: */
 
@@ -401,6 +458,8 @@ namespace ryujin
       const vector_type *density_;
       Number theta_x_tau_;
       unsigned int level_;
+      bool fused_;
+      const vector_type *lumped_mass_matrix_;
 
       template <typename Evaluator>
       void apply_local_operator(Evaluator &velocity) const
@@ -533,6 +592,12 @@ namespace ryujin
         }
       }
 
+      std::size_t memory_consumption() const
+      {
+        return transfer_.memory_consumption() +
+               scalar_vector.memory_consumption();
+      }
+
     private:
       dealii::MGTransferMatrixFree<dim, Number> transfer_;
       const dealii::MGLevelObject<dealii::MatrixFree<dim, Number>>
@@ -557,13 +622,28 @@ namespace ryujin
           const dealii::MatrixFree<dim, Number> &matrix_free,
           const dealii::LinearAlgebra::distributed::Vector<Number> &density,
           const Number time_factor,
-          const unsigned int level = dealii::numbers::invalid_unsigned_int)
+          const unsigned int level = dealii::numbers::invalid_unsigned_int,
+          const bool fused = false)
       {
         offline_data_ = &offline_data;
         matrix_free_ = &matrix_free;
         density_ = &density;
         factor_ = time_factor;
         level_ = level;
+        fused_ = fused;
+        lumped_mass_matrix_ = nullptr;
+      }
+
+      /**
+       * Use @p lumped_mass_matrix instead of the lumped mass matrix
+       * stored in OfflineData. This is needed for an operator on the
+       * active level with a precision Number that differs from the
+       * precision Number2 of OfflineData. Has to be called after
+       * initialize().
+       */
+      void set_lumped_mass_matrix(const vector_type &lumped_mass_matrix)
+      {
+        lumped_mass_matrix_ = &lumped_mass_matrix;
       }
 
       void Tvmult(vector_type &dst, const vector_type &src) const
@@ -584,50 +664,52 @@ namespace ryujin
 
       void vmult(vector_type &dst, const vector_type &src) const
       {
-        /* Apply action of m_i rho_i V_i: */
-
         using VA = dealii::VectorizedArray<Number>;
         constexpr auto simd_length = VA::size();
 
-        const vector_type *lumped_mass_matrix = nullptr;
-        if constexpr (std::is_same<Number, Number2>::value) {
-          if constexpr (std::is_same<Number, float>::value) {
-            if (level_ == dealii::numbers::invalid_unsigned_int)
+        const vector_type *lumped_mass_matrix = lumped_mass_matrix_;
+        if (lumped_mass_matrix == nullptr) {
+          if constexpr (std::is_same<Number, Number2>::value) {
+            if constexpr (std::is_same<Number, float>::value) {
+              if (level_ == dealii::numbers::invalid_unsigned_int)
+                lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
+              else
+                lumped_mass_matrix =
+                    &offline_data_->level_lumped_mass_matrix()[level_];
+            } else {
+              Assert(level_ == dealii::numbers::invalid_unsigned_int,
+                     dealii::ExcInternalError());
               lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-            else
-              lumped_mass_matrix =
-                  &offline_data_->level_lumped_mass_matrix()[level_];
-          } else {
-            Assert(level_ == dealii::numbers::invalid_unsigned_int,
-                   dealii::ExcInternalError());
-            lumped_mass_matrix = &offline_data_->lumped_mass_matrix();
-          }
-        } else
-          lumped_mass_matrix =
-              &offline_data_->level_lumped_mass_matrix()[level_];
+            }
+          } else
+            lumped_mass_matrix =
+                &offline_data_->level_lumped_mass_matrix()[level_];
+        }
 
         const unsigned int n_owned =
             lumped_mass_matrix->get_partitioner()->locally_owned_size();
-        const unsigned int size_regular = n_owned / simd_length * simd_length;
 
-        RYUJIN_PARALLEL_REGION_BEGIN
+        /* Apply action of m_i rho_i e_i on the index range [left, right): */
 
-        RYUJIN_OMP_FOR
-        for (unsigned int i = 0; i < size_regular; i += simd_length) {
-          const auto m_i = load_value<VA>(*lumped_mass_matrix, i);
-          const auto rho_i = load_value<VA>(*density_, i);
-          const auto e_i = load_value<VA>(src, i);
-          store_value<VA>(dst, m_i * rho_i * e_i, i);
-        }
+        const auto apply_mass = [&](const unsigned int left,
+                                    const unsigned int right) {
+          const unsigned int size_regular =
+              left + (right - left) / simd_length * simd_length;
 
-        RYUJIN_PARALLEL_REGION_END
+          for (unsigned int i = left; i < size_regular; i += simd_length) {
+            const auto m_i = load_value<VA>(*lumped_mass_matrix, i);
+            const auto rho_i = load_value<VA>(*density_, i);
+            const auto e_i = load_value<VA>(src, i);
+            store_value<VA>(dst, m_i * rho_i * e_i, i);
+          }
 
-        for (unsigned int i = size_regular; i < n_owned; ++i) {
-          const auto m_i = lumped_mass_matrix->local_element(i);
-          const auto rho_i = density_->local_element(i);
-          const auto e_i = src.local_element(i);
-          dst.local_element(i) = m_i * rho_i * e_i;
-        }
+          for (unsigned int i = size_regular; i < right; ++i) {
+            const auto m_i = lumped_mass_matrix->local_element(i);
+            const auto rho_i = density_->local_element(i);
+            const auto e_i = src.local_element(i);
+            dst.local_element(i) = m_i * rho_i * e_i;
+          }
+        };
 
         /* Apply action of diffusion operator \sum_j beta_ij e_j: */
 
@@ -648,8 +730,32 @@ namespace ryujin
           }
         };
 
-        matrix_free_->template cell_loop<vector_type, vector_type>(
-            integrator, dst, src, /* zero destination */ false);
+        if (fused_) {
+          /* Apply the mass matrix as pre-operation, see VelocityMatrix: */
+          matrix_free_->template cell_loop<vector_type, vector_type>(
+              integrator,
+              dst,
+              src,
+              apply_mass,
+              [](const unsigned int, const unsigned int) {});
+
+        } else {
+          const unsigned int size_regular =
+              n_owned / simd_length * simd_length;
+
+          RYUJIN_PARALLEL_REGION_BEGIN
+
+          RYUJIN_OMP_FOR
+          for (unsigned int i = 0; i < size_regular; i += simd_length)
+            apply_mass(i, i + simd_length);
+
+          RYUJIN_PARALLEL_REGION_END
+
+          apply_mass(size_regular, n_owned);
+
+          matrix_free_->template cell_loop<vector_type, vector_type>(
+              integrator, dst, src, /* zero destination */ false);
+        }
 
         /* Fix up constrained degrees of freedom: */
 
@@ -747,6 +853,8 @@ namespace ryujin
       const dealii::LinearAlgebra::distributed::Vector<Number> *density_;
       Number factor_;
       unsigned int level_;
+      bool fused_;
+      const vector_type *lumped_mass_matrix_;
 
       template <typename Evaluator>
       void apply_local_operator(Evaluator &energy) const
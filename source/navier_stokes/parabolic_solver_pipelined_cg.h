@@ -0,0 +1,220 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/block_vector_base.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ryujin
+{
+  namespace NavierStokes
+  {
+    namespace PipelinedCGImplementation
+    {
+      /**
+       * Accumulate the locally owned part of the inner products (r, u),
+       * (w, u), (r, r) into @p sums and the maximal absolute value of @p r
+       * into @p max.
+       */
+      template <typename Number>
+      void local_reductions(
+          const dealii::LinearAlgebra::distributed::Vector<Number> &r,
+          const dealii::LinearAlgebra::distributed::Vector<Number> &u,
+          const dealii::LinearAlgebra::distributed::Vector<Number> &w,
+          std::array<double, 3> &sums,
+          double &max)
+      {
+        const unsigned int n_owned =
+            r.get_partitioner()->locally_owned_size();
+
+        Number gamma = 0.;
+        Number delta = 0.;
+        Number norm = 0.;
+        Number maximum = 0.;
+        for (unsigned int i = 0; i < n_owned; ++i) {
+          const auto r_i = r.local_element(i);
+          const auto u_i = u.local_element(i);
+          gamma += r_i * u_i;
+          delta += w.local_element(i) * u_i;
+          norm += r_i * r_i;
+          maximum = std::max(maximum, std::abs(r_i));
+        }
+
+        sums[0] += gamma;
+        sums[1] += delta;
+        sums[2] += norm;
+        max = std::max(max, double(maximum));
+      }
+
+
+      /**
+       * Variant of above function for block vectors.
+       */
+      template <typename Number>
+      void local_reductions(
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &r,
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &u,
+          const dealii::LinearAlgebra::distributed::BlockVector<Number> &w,
+          std::array<double, 3> &sums,
+          double &max)
+      {
+        for (unsigned int b = 0; b < r.n_blocks(); ++b)
+          local_reductions(r.block(b), u.block(b), w.block(b), sums, max);
+      }
+    } // namespace PipelinedCGImplementation
+
+
+    /**
+     * The pipelined preconditioned conjugate gradient method of Ghysels
+     * and Vanroose @cite GhyselsVanroose2014.
+     *
+     * In contrast to dealii::SolverCG, which performs two blocking global
+     * reductions per iteration, this variant combines all inner products
+     * of an iteration into a single non-blocking MPI_Iallreduce that is
+     * overlapped with the application of the preconditioner and the
+     * operator. This comes at the cost of storing five additional vectors
+     * and of four additional vector updates per iteration. The method is
+     * mathematically equivalent to the preconditioned CG method but
+     * slightly less stable in finite precision arithmetic.
+     *
+     * The residual is measured in the l_2 norm, or in the l_infty norm if
+     * @p linfty_norm is set.
+     *
+     * @ingroup NavierStokesEquations
+     */
+    template <typename VectorType>
+    class SolverPipelinedCG
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      SolverPipelinedCG(dealii::SolverControl &solver_control,
+                        const MPI_Comm &mpi_communicator,
+                        const bool linfty_norm = false)
+          : solver_control_(solver_control)
+          , mpi_communicator_(mpi_communicator)
+          , linfty_norm_(linfty_norm)
+      {
+      }
+
+      /**
+       * Solve the linear system A x = b with the preconditioner P.
+       * Throws a dealii::SolverControl::NoConvergence exception if the
+       * SolverControl object signals a failure.
+       */
+      template <typename MatrixType, typename PreconditionerType>
+      void solve(const MatrixType &A,
+                 VectorType &x,
+                 const VectorType &b,
+                 const PreconditionerType &P)
+      {
+        using dealii::SolverControl;
+
+        VectorType r, u, w, m, n, p, s, q, z;
+        for (auto *it : {&r, &u, &w, &m, &n})
+          it->reinit(x, /*omit_zeroing_entries*/ true);
+        for (auto *it : {&p, &s, &q, &z})
+          it->reinit(x);
+
+        /* r = b - A x, u = P r, w = A u: */
+        A.vmult(r, x);
+        r.sadd(-1., 1., b);
+        P.vmult(u, r);
+        A.vmult(w, u);
+
+        double gamma_old = 0.;
+        double alpha_old = 0.;
+
+        SolverControl::State state = SolverControl::iterate;
+        for (unsigned int step = 0;; ++step) {
+          /* Start the fused global reduction: */
+          std::array<double, 3> sums{{0., 0., 0.}};
+          double maximum = 0.;
+          PipelinedCGImplementation::local_reductions(
+              r, u, w, sums, maximum);
+
+          MPI_Request requests[2];
+          int ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                    sums.data(),
+                                    sums.size(),
+                                    MPI_DOUBLE,
+                                    MPI_SUM,
+                                    mpi_communicator_,
+                                    &requests[0]);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Iallreduce(MPI_IN_PLACE,
+                                &maximum,
+                                linfty_norm_ ? 1 : 0,
+                                MPI_DOUBLE,
+                                MPI_MAX,
+                                mpi_communicator_,
+                                &requests[1]);
+          AssertThrowMPI(ierr);
+
+          /* Overlap with: m = P w, n = A m: */
+          P.vmult(m, w);
+          A.vmult(n, m);
+
+          ierr = MPI_Waitall(2, requests, MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+
+          const double gamma = sums[0];
+          const double delta = sums[1];
+          const double norm = linfty_norm_ ? maximum : std::sqrt(sums[2]);
+
+          state = solver_control_.check(step, norm);
+          if (state != SolverControl::iterate)
+            break;
+
+          double alpha = gamma / delta;
+          double beta = 0.;
+          if (step > 0) {
+            beta = gamma / gamma_old;
+            alpha = gamma / (delta - beta * gamma / alpha_old);
+          }
+
+          if (!std::isfinite(alpha) || !std::isfinite(beta)) {
+            state = SolverControl::failure;
+            break;
+          }
+
+          z.sadd(beta, 1., n);
+          q.sadd(beta, 1., m);
+          s.sadd(beta, 1., w);
+          p.sadd(beta, 1., u);
+
+          x.add(alpha, p);
+          r.add(-alpha, s);
+          u.add(-alpha, q);
+          w.add(-alpha, z);
+
+          gamma_old = gamma;
+          alpha_old = alpha;
+        }
+
+        AssertThrow(state == SolverControl::success,
+                    SolverControl::NoConvergence(
+                        solver_control_.last_step(),
+                        solver_control_.last_value()));
+      }
+
+    private:
+      dealii::SolverControl &solver_control_;
+      const MPI_Comm &mpi_communicator_;
+      const bool linfty_norm_;
+    };
+  } // namespace NavierStokes
+} // namespace ryujin
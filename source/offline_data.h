@@ -7,9 +7,11 @@
 
 #include <compile_time_options.h>
 
+#include "boundary_table.h"
 #include "convenience_macros.h"
 #include "discretization.h"
 #include "multicomponent_vector.h"
+#include "patterns_conversion.h"
 #include "sparse_matrix_simd.h"
 
 #include <deal.II/base/parameter_acceptor.h>
@@ -21,6 +23,45 @@
 
 #include <deal.II/numerics/data_out.h>
 
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * Controls the locality optimizing renumbering of the locally owned
+   * degrees of freedom that is applied prior to grouping them into SIMD
+   * strides.
+   */
+  enum class DoFOrdering {
+    /**
+     * Cuthill McKee renumbering (bandwidth reduction).
+     */
+    cuthill_mckee,
+
+    /**
+     * Order degrees of freedom along a Hilbert space-filling curve
+     * through their support points.
+     */
+    hilbert,
+
+    /**
+     * Order degrees of freedom by a hierarchical (Z-order) traversal of
+     * the cell hierarchy.
+     */
+    hierarchical,
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::DoFOrdering,
+             LIST({ryujin::DoFOrdering::cuthill_mckee, "Cuthill McKee"},
+                  {ryujin::DoFOrdering::hilbert, "Hilbert"},
+                  {ryujin::DoFOrdering::hierarchical, "hierarchical"}, ));
+#endif
+
 namespace ryujin
 {
   /**
@@ -65,6 +106,65 @@ namespace ryujin
                    dealii::types::boundary_id /*id*/,
                    dealii::Point<dim>> /*position*/;
 
+    /**
+     * The number type used for storing the mass matrix, the beta_ij
+     * matrix, and the c_ij matrix. If the compile-time option
+     * MIXED_PRECISION_OFFLINE_MATRICES is set we store these matrices in
+     * single precision. The values are converted to Number on the fly.
+     */
+#ifdef MIXED_PRECISION_OFFLINE_MATRICES
+    using matrix_number_type = float;
+#else
+    using matrix_number_type = Number;
+#endif
+
+    /**
+     * The matrix type used for storing symmetric (scalar valued)
+     * matrices. If the compile-time option SYMMETRIC_SPARSE_MATRIX is set
+     * we store every pair of transposed entries only once.
+     */
+#ifdef SYMMETRIC_SPARSE_MATRIX
+    using symmetric_matrix_type = SymmetricSparseMatrixSIMD<Number>;
+#else
+    using symmetric_matrix_type = SparseMatrixSIMD<Number>;
+#endif
+
+    /**
+     * The matrix type used for storing the mass matrix and the beta_ij
+     * matrix. This is symmetric_matrix_type with storage type
+     * matrix_number_type.
+     */
+#ifdef SYMMETRIC_SPARSE_MATRIX
+    using mass_matrix_type =
+        SymmetricSparseMatrixSIMD<matrix_number_type,
+                                  dealii::VectorizedArray<Number>::size()>;
+#else
+    using mass_matrix_type =
+        SparseMatrixSIMD<matrix_number_type,
+                         1,
+                         dealii::VectorizedArray<Number>::size()>;
+#endif
+
+    /**
+     * The matrix type used for storing the c_ij matrix. If the
+     * compile-time option SKEW_SYMMETRIC_CIJ_MATRIX is set we store every
+     * pair of entries with c_ij = - c_ji only once. If the compile-time
+     * option STENCIL_COMPRESSED_CIJ_MATRIX is set we in addition store
+     * every distinct entry only once, see
+     * SkewSymmetricSparseMatrixSIMD::set_stencil_compression().
+     */
+#ifdef SKEW_SYMMETRIC_CIJ_MATRIX
+    using cij_matrix_type =
+        SkewSymmetricSparseMatrixSIMD<matrix_number_type,
+                                      dim,
+                                      dealii::VectorizedArray<Number>::size()>;
+#else
+    using cij_matrix_type =
+        SparseMatrixSIMD<matrix_number_type,
+                         dim,
+                         dealii::VectorizedArray<Number>::size()>;
+#endif
+
     /**
      * Constructor
      */
@@ -78,14 +178,96 @@ namespace ryujin
      *
      * The problem_dimension parameter is used to setup up an
      * appropriately sized vector partitioner for the MultiComponentVector.
+     *
+     * If a non-empty @p assembled_name is given, prepare() first tries to
+     * read in assembled offline data previously stored with
+     * write_assembled() and only calls assemble() if this fails.
      */
-    void prepare(const unsigned int problem_dimension)
+    void prepare(const unsigned int problem_dimension,
+                 const std::string &assembled_name = "")
     {
       setup(problem_dimension);
-      assemble();
-      create_multigrid_data();
+      if (assembled_name.empty() || !read_assembled(assembled_name))
+        assemble();
+      assemble_cij_norms();
     }
 
+    /**
+     * Create the multigrid data, i.e., distribute level degrees of
+     * freedom and populate the level boundary maps and level lumped mass
+     * matrices for all levels greater or equal to @p min_level. The data
+     * of coarser levels is released.
+     *
+     * The multigrid data is not created by prepare() but only on demand
+     * by a parabolic solver that actually uses a geometric multigrid
+     * method. The function thus has to be called after every call to
+     * prepare() when multigrid data is needed. Data of levels that did
+     * not change since the last call is kept.
+     *
+     * @note The function merely populates cached data and is thus
+     * logically const.
+     */
+    void prepare_multigrid_data(const unsigned int min_level = 0) const;
+
+    /**
+     * Return the positions (support points) of all locally owned degrees
+     * of freedom in local numbering. The positions are computed with a
+     * single pass over all locally owned cells on first use after every
+     * call to prepare() and are cached. Modules that evaluate functions
+     * on (a subset of) all locally owned degrees of freedom, for example
+     * the level set manifolds of Quantities, should use this function
+     * instead of transforming unit support points on every cell.
+     *
+     * @note The function merely populates cached data and is thus
+     * logically const.
+     */
+    const std::vector<dealii::Point<dim>> &
+    locally_owned_support_points() const;
+
+    /**
+     * Write out all assembled offline data of this rank (lumped mass
+     * matrix, mass, beta_ij and c_ij matrices, boundary map, and coupling
+     * boundary pairs) in binary format to the file
+     * <code>name + "." + rank</code>.
+     */
+    void write_assembled(const std::string &name) const;
+
+    /**
+     * Read in offline data written by write_assembled(). This replaces a
+     * call to assemble(). The function verifies that the mesh, the
+     * partitioning, and the degree of freedom numbering match the ones
+     * recorded in the file. If this is not the case on any rank the
+     * function returns false on all ranks and assemble() has to be
+     * called instead.
+     */
+    bool read_assembled(const std::string &name);
+
+    /**
+     * Return a description of the compile-time layout of the assembled
+     * offline data: the code revision, the SIMD width, the floating
+     * point type of the matrices, and the storage format of the c_ij
+     * matrix. Data written with write_assembled() can only be read back
+     * by an executable with identical layout.
+     */
+    static std::string assembled_layout();
+
+    /**
+     * Return a hash over the mesh, the partitioning, and the degree of
+     * freedom numbering of this rank, i.e., over all entries of the
+     * fingerprint used by read_assembled() except for the compile-time
+     * layout. This is used to verify that a checkpoint written with
+     * collective MPI IO is resumed with an identical numbering.
+     */
+    unsigned long long partition_fingerprint() const;
+
+    /**
+     * Append the memory consumption (in bytes) of the DoFHandler, the
+     * sparsity patterns, all matrices and the multigrid data to
+     * @p statistics.
+     */
+    void collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const;
+
     /**
      * The DofHandler for our (scalar) CG ansatz space in (deal.II typical)
      * global numbering.
@@ -160,6 +342,15 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(boundary_map)
 
+    /**
+     * The boundary map stored as a flat table sorted by (local) degree
+     * of freedom index, see BoundaryTable. This is the preferred way of
+     * accessing boundary data in hot loops: the test whether a given row
+     * is a boundary degree of freedom is an O(1) operation, and all
+     * boundary descriptions can be processed in parallel.
+     */
+    ACCESSOR_READ_ONLY(boundary_table)
+
     /**
      * A vector of tuples describing coupling degrees of freedom i and j
      * where both degrees of freedom are collocated at the boundary (and
@@ -170,13 +361,16 @@ namespace ryujin
 
     /**
      * The boundary map on all levels of the grid in case multilevel
-     * support was enabled.
+     * data was created with prepare_multigrid_data().
      */
     ACCESSOR_READ_ONLY(level_boundary_map)
 
     /**
      * A sparsity pattern for (standard deal.II) matrices storing indices
      * in (Deal.II typical) global numbering.
+     *
+     * @note The sparsity pattern is released at the end of setup() if the
+     * streaming assembly is used.
      */
     ACCESSOR_READ_ONLY(sparsity_pattern)
 
@@ -203,10 +397,21 @@ namespace ryujin
 
     /**
      * The lumped mass matrix on all levels of the grid in case multilevel
-     * support was enabled.
+     * data was created with prepare_multigrid_data().
      */
     ACCESSOR_READ_ONLY(level_lumped_mass_matrix)
 
+    /**
+     * A generation number for every level of the grid in case multilevel
+     * data was created with prepare_multigrid_data(). The number of a
+     * level changes (consistently on all ranks) whenever the level data
+     * had to be recreated because the cells, the partitioning, or the
+     * degree of freedom numbering of the level changed. Level data
+     * derived from it can thus be reused as long as the generation number
+     * of the level is unchanged.
+     */
+    ACCESSOR_READ_ONLY(level_generation)
+
     /**
      * The stiffness matrix \f$(beta_{ij})\f$:
      *   \f$\beta_{ij} = \nabla\varphi_{j}\cdot\nabla\varphi_{i}\f$
@@ -219,6 +424,19 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(cij_matrix)
 
+    /**
+     * Return whether the norms \f$|c_{ij}|\f$ are precomputed, see the
+     * "precompute cij norms" parameter.
+     */
+    ACCESSOR_READ_ONLY(precompute_cij_norms)
+
+    /**
+     * The matrix of norms \f$|c_{ij}|\f$. (SIMD storage, local
+     * numbering). The matrix is only populated if the "precompute cij
+     * norms" parameter is set.
+     */
+    ACCESSOR_READ_ONLY(cij_norm_matrix)
+
     /**
      * Size of computational domain.
      */
@@ -251,9 +469,37 @@ namespace ryujin
     void assemble();
 
     /**
-     * Create multigrid data.
+     * Assemble all matrices directly into the SIMD storage without
+     * creating intermediate deal.II sparse matrices. This is only
+     * possible if there are no affine constraints. Internally used in
+     * assemble().
+     */
+    void assemble_streaming();
+
+    /**
+     * Compute the norms of the c_ij matrix if the "precompute cij norms"
+     * parameter is set. Internally used in prepare().
      */
-    void create_multigrid_data();
+    void assemble_cij_norms();
+
+    /**
+     * Populate the boundary map and extract the coupling boundary pairs.
+     * Internally used in assemble().
+     */
+    void create_boundary_data();
+
+    /**
+     * Return a hash over all locally relevant cells (and their level
+     * degree of freedom indices) of the given @p level.
+     */
+    unsigned long long level_dof_fingerprint(const unsigned int level) const;
+
+    /**
+     * Return a fingerprint of the compile-time layout (see
+     * assembled_layout()), the current mesh, partitioning, and sparsity
+     * pattern used to validate data read in with read_assembled().
+     */
+    std::array<unsigned long long, 9> assembled_fingerprint() const;
 
     std::unique_ptr<dealii::DoFHandler<dim>> dof_handler_;
 
@@ -277,26 +523,41 @@ namespace ryujin
                                unsigned int,
                                dealii::types::global_dof_index>>;
     boundary_map_type boundary_map_;
+    BoundaryTable<dim, Number> boundary_table_;
     coupling_boundary_pairs_type coupling_boundary_pairs_;
 
-    std::vector<boundary_map_type> level_boundary_map_;
+    mutable std::vector<boundary_map_type> level_boundary_map_;
+
+    mutable std::vector<dealii::Point<dim>> locally_owned_support_points_;
 
     dealii::DynamicSparsityPattern sparsity_pattern_;
+    unsigned long long sparsity_pattern_hash_;
+
+    bool streaming_assembly_;
+    bool use_streaming_assembly_;
+
+    bool precompute_cij_norms_;
+
+    DoFOrdering dof_ordering_;
 
     SparsityPatternSIMD<dealii::VectorizedArray<Number>::size()>
         sparsity_pattern_simd_;
 
-    SparseMatrixSIMD<Number> mass_matrix_;
+    mass_matrix_type mass_matrix_;
 
     dealii::LinearAlgebra::distributed::Vector<Number> lumped_mass_matrix_;
     dealii::LinearAlgebra::distributed::Vector<Number>
         lumped_mass_matrix_inverse_;
 
-    std::vector<dealii::LinearAlgebra::distributed::Vector<float>>
+    mutable std::vector<dealii::LinearAlgebra::distributed::Vector<float>>
         level_lumped_mass_matrix_;
 
-    SparseMatrixSIMD<Number> betaij_matrix_;
-    SparseMatrixSIMD<Number, dim> cij_matrix_;
+    mutable std::vector<unsigned long long> level_fingerprint_;
+    mutable std::vector<unsigned int> level_generation_;
+
+    mass_matrix_type betaij_matrix_;
+    cij_matrix_type cij_matrix_;
+    SparseMatrixSIMD<Number> cij_norm_matrix_;
 
     Number measure_of_omega_;
 
@@ -304,6 +565,8 @@ namespace ryujin
 
     const MPI_Comm &mpi_communicator_;
 
+    mutable unsigned int n_level_generations_;
+
     /**
      * Construct a boundary map for a given set of DoFHandler iterators.
      */
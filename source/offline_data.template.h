@@ -8,6 +8,8 @@
 #include "local_index_handling.h"
 #include "multicomponent_vector.h"
 #include "offline_data.h"
+#include "openmp.h"
+#include "scope.h"
 #include "scratch_data.h"
 #include "sparse_matrix_simd.template.h" /* instantiate read_in */
 
@@ -24,6 +26,12 @@
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #endif
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+
 #ifdef FORCE_DEAL_II_SPARSE_MATRIX
 #undef DEAL_II_WITH_TRILINOS
 #endif
@@ -41,13 +49,41 @@ namespace ryujin
       : ParameterAcceptor(subsection)
       , discretization_(&discretization)
       , mpi_communicator_(mpi_communicator)
+      , n_level_generations_(0)
   {
+    streaming_assembly_ = false;
+    add_parameter("streaming assembly",
+                  streaming_assembly_,
+                  "Assemble all matrices directly into the SIMD storage and "
+                  "release the global sparsity pattern after setup. This "
+                  "reduces the peak memory consumption during setup. The "
+                  "option is ignored if affine constraints (hanging nodes "
+                  "or periodic boundaries) are present");
+
+    dof_ordering_ = DoFOrdering::cuthill_mckee;
+    add_parameter("dof ordering",
+                  dof_ordering_,
+                  "Locality optimizing renumbering of the locally owned "
+                  "degrees of freedom prior to grouping them into SIMD "
+                  "strides. Options are \"Cuthill McKee\", \"Hilbert\" "
+                  "(space-filling curve through the support points), and "
+                  "\"hierarchical\" (Z-order traversal of the cells)");
+
+    precompute_cij_norms_ = false;
+    add_parameter("precompute cij norms",
+                  precompute_cij_norms_,
+                  "Precompute and store the norms |c_ij| of the c_ij matrix "
+                  "instead of recomputing them for every edge and stage in "
+                  "the hyperbolic module. This trades memory bandwidth for "
+                  "arithmetic");
   }
 
 
   template <int dim, typename Number>
   void OfflineData<dim, Number>::create_constraints_and_sparsity_pattern()
   {
+    SetupScope scope("offline data - constraints and sparsity pattern");
+
     /*
      * First, we set up the locally_relevant index set, determine (globally
      * indexed) affine constraints and create a (globally indexed) sparsity
@@ -152,7 +188,13 @@ namespace ryujin
       dof_handler_ = std::make_unique<dealii::DoFHandler<dim>>(triangulation);
     auto &dof_handler = *dof_handler_;
 
-    dof_handler.distribute_dofs(discretization_->finite_element());
+    /* The support points are recomputed on demand: */
+    locally_owned_support_points_.clear();
+
+    {
+      SetupScope scope("offline data - distribute dofs");
+      dof_handler.distribute_dofs(discretization_->finite_element());
+    }
 
     n_locally_owned_ = dof_handler.locally_owned_dofs().n_elements();
 
@@ -160,14 +202,30 @@ namespace ryujin
      * Renumbering:
      */
 
-    DoFRenumbering::Cuthill_McKee(dof_handler);
+    {
+      SetupScope scope("offline data - renumbering (dof ordering)");
+      switch (dof_ordering_) {
+      case DoFOrdering::cuthill_mckee:
+        DoFRenumbering::Cuthill_McKee(dof_handler);
+        break;
+      case DoFOrdering::hilbert:
+        DoFRenumbering::Hilbert(dof_handler, discretization_->mapping());
+        break;
+      case DoFOrdering::hierarchical:
+        DoFRenumbering::hierarchical(dof_handler);
+        break;
+      }
+    }
 
     /*
      * Reorder all export indices at the beginning of the locally_internal index
      * range to achieve a better packging:
      */
-    DoFRenumbering::export_indices_first(
-        dof_handler, mpi_communicator_, n_locally_owned_, 1);
+    {
+      SetupScope scope("offline data - renumbering (export indices)");
+      DoFRenumbering::export_indices_first(
+          dof_handler, mpi_communicator_, n_locally_owned_, 1);
+    }
 
     /*
      * Group degrees of freedom that have the same stencil size in groups
@@ -177,8 +235,11 @@ namespace ryujin
      * temporary sparsity pattern:
      */
     create_constraints_and_sparsity_pattern();
-    n_locally_internal_ = DoFRenumbering::internal_range(
-        dof_handler, sparsity_pattern_, VectorizedArray<Number>::size());
+    {
+      SetupScope scope("offline data - renumbering (internal range)");
+      n_locally_internal_ = DoFRenumbering::internal_range(
+          dof_handler, sparsity_pattern_, VectorizedArray<Number>::size());
+    }
 
     /*
      * Reorder all (strides of) locally internal indices that contain
@@ -186,11 +247,14 @@ namespace ryujin
      * preserves the binning introduced by
      * DoFRenumbering::internal_range().
      */
-    n_export_indices_ =
-        DoFRenumbering::export_indices_first(dof_handler,
-                                             mpi_communicator_,
-                                             n_locally_internal_,
-                                             VectorizedArray<Number>::size());
+    {
+      SetupScope scope("offline data - renumbering (export indices)");
+      n_export_indices_ =
+          DoFRenumbering::export_indices_first(dof_handler,
+                                               mpi_communicator_,
+                                               n_locally_internal_,
+                                               VectorizedArray<Number>::size());
+    }
 
     /*
      * A small lambda to check for stride-level consistency of the internal
@@ -248,14 +312,19 @@ namespace ryujin
       if (locally_inconsistent) {
         /*
          * In this case we try to fix up the numbering by pushing affected
-         * strides to the end and slightly lowering the n_locally_internal_
-         * marker.
+         * strides to the end and regrouping them (together with the
+         * non-internal range) by their new stencil size. The
+         * n_locally_internal_ marker is then set to the consistent part of
+         * the regrouped range.
          */
-        n_locally_internal_ = DoFRenumbering::inconsistent_strides_last(
-            dof_handler,
-            sparsity_pattern_,
-            n_locally_internal_,
-            VectorizedArray<Number>::size());
+        {
+          SetupScope scope("offline data - renumbering (inconsistent strides)");
+          n_locally_internal_ = DoFRenumbering::inconsistent_strides_last(
+              dof_handler,
+              sparsity_pattern_,
+              n_locally_internal_,
+              VectorizedArray<Number>::size());
+        }
         create_constraints_and_sparsity_pattern();
         n_locally_internal_ = consistent_stride_range();
       }
@@ -283,9 +352,10 @@ namespace ryujin
            dealii::ExcInternalError());
 
     IndexSet locally_relevant;
-    DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant);
-    /* Enlarge the locally relevant set to include all additional couplings: */
     {
+      SetupScope scope("offline data - locally relevant set");
+      DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant);
+      /* Enlarge the locally relevant set to include all couplings: */
       IndexSet additional_dofs(dof_handler.n_dofs());
       for (auto &entry : sparsity_pattern_)
         if (!locally_relevant.is_element(entry.column())) {
@@ -302,33 +372,41 @@ namespace ryujin
     scalar_partitioner_ = std::make_shared<dealii::Utilities::MPI::Partitioner>(
         locally_owned, locally_relevant, mpi_communicator_);
 
-    vector_partitioner_ =
-        create_vector_partitioner(scalar_partitioner_, problem_dimension);
+    vector_partitioner_ = create_vector_partitioner(
+        scalar_partitioner_, storage_stride<Number>(problem_dimension));
+
 
+    /*
+     * Return the right boundary of all exported indices within the
+     * locally internal range [0, n_locally_internal_). Ranges of import
+     * indices (of neighboring ranks) that straddle n_locally_internal_
+     * are clamped to the locally internal range.
+     */
+    const auto export_range_boundary = [&]() {
+      unsigned int boundary = 0;
+      for (const auto &[first, last] : scalar_partitioner_->import_indices())
+        if (first < n_locally_internal_)
+          boundary = std::max(boundary, std::min(last, n_locally_internal_));
+      return boundary;
+    };
 
     if (periodic_faces.size() > 0) {
       /*
        * In case of periodic boundary conditions we might need to update
-       * n_export_indices_ again - just do it unconiditionally
+       * n_export_indices_ again - just do it unconiditionally. Regrouped
+       * strides (see DoFRenumbering::inconsistent_strides_last()) might
+       * contain export indices that are located after the consistent
+       * strides:
        */
-      n_export_indices_ = 0;
-      for (const auto &it : scalar_partitioner_->import_indices())
-        if (it.second <= n_locally_internal_)
-          n_export_indices_ = std::max(n_export_indices_, it.second);
-
       constexpr auto simd_length = VectorizedArray<Number>::size();
-      n_export_indices_ =
-          (n_export_indices_ + simd_length - 1) / simd_length * simd_length;
+      n_export_indices_ = (export_range_boundary() + simd_length - 1) /
+                          simd_length * simd_length;
       Assert(n_export_indices_ <= n_locally_internal_, ExcInternalError());
 #ifdef DEBUG
     } else {
       /* Check that n_export_indices_ is valid: */
-      unsigned int control = 0;
-      for (const auto &it : scalar_partitioner_->import_indices())
-        if (it.second <= n_locally_internal_)
-          control = std::max(control, it.second);
-
-      Assert(control <= n_export_indices_, ExcInternalError());
+      Assert(export_range_boundary() <= n_export_indices_,
+             ExcInternalError());
       Assert(n_export_indices_ <= n_locally_internal_, ExcInternalError());
 #endif
     }
@@ -339,8 +417,31 @@ namespace ryujin
      * from global deal.II (typical) dof indexing to local indices.
      */
 
-    sparsity_pattern_simd_.reinit(
-        n_locally_internal_, sparsity_pattern_, scalar_partitioner_);
+    {
+      SetupScope scope("offline data - simd sparsity pattern");
+      sparsity_pattern_simd_.reinit(
+          n_locally_internal_, sparsity_pattern_, scalar_partitioner_);
+    }
+
+    /* A simple hash over the (global) sparsity pattern: */
+    sparsity_pattern_hash_ = 14695981039346656037ull;
+    const auto combine = [&](const unsigned long long value) {
+      auto &hash = sparsity_pattern_hash_;
+      hash = (hash ^ value) * 1099511628211ull;
+    };
+    for (const auto &entry : sparsity_pattern_) {
+      combine(entry.row());
+      combine(entry.column());
+    }
+
+    /*
+     * The streaming assembly only needs the SIMD sparsity pattern. We can
+     * thus release the global sparsity pattern right away.
+     */
+    use_streaming_assembly_ =
+        streaming_assembly_ && affine_constraints_.n_constraints() == 0;
+    if (use_streaming_assembly_)
+      sparsity_pattern_.reinit(0, 0);
 
     /*
      * Next we can (re)initialize all local matrices:
@@ -352,6 +453,9 @@ namespace ryujin
     mass_matrix_.reinit(sparsity_pattern_simd_);
     betaij_matrix_.reinit(sparsity_pattern_simd_);
     cij_matrix_.reinit(sparsity_pattern_simd_);
+#ifdef STENCIL_COMPRESSED_CIJ_MATRIX
+    cij_matrix_.set_stencil_compression(true);
+#endif
   }
 
 
@@ -362,6 +466,14 @@ namespace ryujin
     std::cout << "OfflineData<dim, Number>::assemble()" << std::endl;
 #endif
 
+    SetupScope scope("offline data - assembly");
+
+    if (use_streaming_assembly_) {
+      assemble_streaming();
+      create_boundary_data();
+      return;
+    }
+
     auto &dof_handler = *dof_handler_;
 
     measure_of_omega_ = 0.;
@@ -432,6 +544,10 @@ namespace ryujin
      * Now, assemble all matrices:
      */
 
+    /* Measure of all locally owned cells, indexed by active cell index: */
+    std::vector<Number> cell_measures(
+        dof_handler.get_triangulation().n_active_cells(), Number(0.));
+
     /* The local, per-cell assembly routine: */
 
     const auto local_assemble_system =
@@ -502,6 +618,12 @@ namespace ryujin
               } /* for i */
             }   /* for j */
           }     /* for q */
+
+          /*
+           * Record the cell measure by active cell index: Copiers of cells
+           * with the same color might run concurrently, see below.
+           */
+          cell_measures[cell->active_cell_index()] = cell_measure;
         };
 
     const auto copy_local_to_global = [&](const auto &copy) {
@@ -510,7 +632,6 @@ namespace ryujin
       const auto &cell_mass_matrix = copy.cell_mass_matrix_;
       const auto &cell_cij_matrix = copy.cell_cij_matrix_;
       const auto &cell_betaij_matrix = copy.cell_betaij_matrix_;
-      const auto &cell_measure = copy.cell_measure_;
 
       if (!is_locally_owned)
         return;
@@ -529,21 +650,57 @@ namespace ryujin
 
       affine_constraints_assembly.distribute_local_to_global(
           cell_betaij_matrix, local_dof_indices, betaij_matrix_tmp);
-
-      measure_of_omega_ += cell_measure;
     };
 
+#ifdef DEAL_II_WITH_TRILINOS
+    /*
+     * Concurrent writes into a TrilinosWrappers::SparseMatrix are not
+     * safe: Only the local assembly runs in parallel, the copier is
+     * serialized by WorkStream.
+     */
     WorkStream::run(dof_handler.begin_active(),
                     dof_handler.end(),
                     local_assemble_system,
                     copy_local_to_global,
                     AssemblyScratchData<dim>(*discretization_),
-#ifdef DEAL_II_WITH_TRILINOS
                     AssemblyCopyData<dim, double>());
 #else
+    /*
+     * For the local dealii::SparseMatrix<Number> we color the cells such
+     * that no two cells of the same color write into the same matrix row.
+     * This allows WorkStream to run the copier concurrently as well. Note
+     * that distribute_local_to_global() also writes into rows of dofs
+     * that constrain a local dof, so we have to resolve the constraints
+     * when computing conflict indices.
+     */
+    using iterator = typename DoFHandler<dim>::active_cell_iterator;
+    const auto get_conflict_indices = [&](const iterator &cell) {
+      std::vector<types::global_dof_index> local_dof_indices;
+      if (cell->is_artificial())
+        return local_dof_indices;
+
+      local_dof_indices.resize(dofs_per_cell);
+      cell->get_dof_indices(local_dof_indices);
+      transform_to_local_range(*scalar_partitioner_, local_dof_indices);
+      affine_constraints_assembly.resolve_indices(local_dof_indices);
+      return local_dof_indices;
+    };
+
+    const auto colored_cells = GraphColoring::make_graph_coloring(
+        dof_handler.begin_active(),
+        iterator(dof_handler.end()),
+        std::function<std::vector<types::global_dof_index>(const iterator &)>(
+            get_conflict_indices));
+
+    WorkStream::run(colored_cells,
+                    local_assemble_system,
+                    copy_local_to_global,
+                    AssemblyScratchData<dim>(*discretization_),
                     AssemblyCopyData<dim, Number>());
 #endif
 
+    measure_of_omega_ = std::accumulate(
+        cell_measures.begin(), cell_measures.end(), Number(0.));
     measure_of_omega_ =
         Utilities::MPI::sum(measure_of_omega_, mpi_communicator_);
 
@@ -568,13 +725,18 @@ namespace ryujin
       mass_matrix_tmp.vmult(local_lumped_mass_matrix, one);
       lumped_mass_matrix_.compress(VectorOperation::add);
 
-      for (unsigned int i = 0; i < scalar_partitioner_->locally_owned_size();
-           ++i) {
+      const unsigned int n_owned = scalar_partitioner_->locally_owned_size();
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
         lumped_mass_matrix_.local_element(i) =
             local_lumped_mass_matrix.local_element(i);
         lumped_mass_matrix_inverse_.local_element(i) =
             1. / lumped_mass_matrix_.local_element(i);
       }
+      RYUJIN_PARALLEL_REGION_END
+
       lumped_mass_matrix_.update_ghost_values();
       lumped_mass_matrix_inverse_.update_ghost_values();
 
@@ -586,34 +748,357 @@ namespace ryujin
       Vector<Number> local_lumped_mass_matrix(mass_matrix_tmp.m());
       mass_matrix_tmp.vmult(local_lumped_mass_matrix, one);
 
-      for (unsigned int i = 0; i < scalar_partitioner_->locally_owned_size();
-           ++i) {
+      const unsigned int n_owned = scalar_partitioner_->locally_owned_size();
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+      RYUJIN_OMP_FOR
+      for (unsigned int i = 0; i < n_owned; ++i) {
         lumped_mass_matrix_.local_element(i) = local_lumped_mass_matrix(i);
         lumped_mass_matrix_inverse_.local_element(i) =
             1. / lumped_mass_matrix_.local_element(i);
       }
+      RYUJIN_PARALLEL_REGION_END
+
       lumped_mass_matrix_.update_ghost_values();
       lumped_mass_matrix_inverse_.update_ghost_values();
 #endif
     }
 
+    {
+      SetupScope read_in_scope("offline data - assembly (simd read_in)");
 #ifdef DEAL_II_WITH_TRILINOS
-    betaij_matrix_.read_in(betaij_matrix_tmp, /*locally_indexed*/ false);
-    mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ false);
-    cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ false);
+      betaij_matrix_.read_in(betaij_matrix_tmp, /*locally_indexed*/ false);
+      mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ false);
+      cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ false);
 #else
-    betaij_matrix_.read_in(betaij_matrix_tmp, /*locally_indexed*/ true);
-    mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ true);
-    cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ true);
+      betaij_matrix_.read_in(betaij_matrix_tmp, /*locally_indexed*/ true);
+      mass_matrix_.read_in(mass_matrix_tmp, /*locally_indexed*/ true);
+      cij_matrix_.read_in(cij_matrix_tmp, /*locally_indexed*/ true);
 #endif
-    betaij_matrix_.update_ghost_rows();
-    mass_matrix_.update_ghost_rows();
+    }
+    if constexpr (!mass_matrix_type::is_symmetric) {
+      /*
+       * With symmetric storage all (relevant) off-diagonal entries of
+       * ghost rows share storage with a locally owned transposed entry.
+       */
+      betaij_matrix_.update_ghost_rows();
+      mass_matrix_.update_ghost_rows();
+    }
     cij_matrix_.update_ghost_rows();
 
+    create_boundary_data();
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::assemble_streaming()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::assemble_streaming()" << std::endl;
+#endif
+
+    Assert(affine_constraints_.n_constraints() == 0,
+           dealii::ExcInternalError());
+
+    auto &dof_handler = *dof_handler_;
+
+    constexpr auto simd_length = VectorizedArray<Number>::size();
+
+    /*
+     * A skew-symmetric c_ij matrix can only be populated with read_in().
+     * In this case we assemble into a temporary matrix with full SIMD
+     * storage first.
+     */
+    using cij_full_type =
+        SparseMatrixSIMD<matrix_number_type, dim, simd_length>;
+    constexpr bool cij_is_full = std::is_same_v<cij_matrix_type, cij_full_type>;
+
+    cij_full_type cij_matrix_tmp;
+    auto &cij_matrix = [&]() -> cij_full_type & {
+      if constexpr (cij_is_full)
+        return cij_matrix_;
+      else
+        return cij_matrix_tmp;
+    }();
+    if constexpr (!cij_is_full)
+      cij_matrix.reinit(sparsity_pattern_simd_);
+
+    /*
+     * Clear out all locally owned rows. (With symmetric storage this also
+     * clears all off-diagonal entries of ghost rows.)
+     */
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_locally_owned_; ++i) {
+      const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        mass_matrix_.write_entry(Number(0.), i, col_idx);
+        betaij_matrix_.write_entry(Number(0.), i, col_idx);
+        cij_matrix.write_tensor(dealii::Tensor<1, dim, Number>(), i, col_idx);
+      }
+    }
+    RYUJIN_PARALLEL_REGION_END
+
+    lumped_mass_matrix_ = Number(0.);
+
+    const unsigned int dofs_per_cell =
+        discretization_->finite_element().dofs_per_cell;
+
+    const unsigned int n_q_points = discretization_->quadrature().size();
+
+    /* Measure of all locally owned cells, indexed by active cell index: */
+    std::vector<Number> cell_measures(
+        dof_handler.get_triangulation().n_active_cells(), Number(0.));
+
+    /*
+     * The local, per-cell assembly routine. We assemble over all locally
+     * relevant (non artificial) cells, so that all locally owned rows are
+     * complete:
+     */
+
+    const auto local_assemble_system =
+        [&](const auto &cell, auto &scratch, auto &copy) {
+          auto &is_locally_owned = copy.is_locally_owned_;
+          auto &local_dof_indices = copy.local_dof_indices_;
+
+          auto &cell_mass_matrix = copy.cell_mass_matrix_;
+          auto &cell_betaij_matrix = copy.cell_betaij_matrix_;
+          auto &cell_cij_matrix = copy.cell_cij_matrix_;
+
+          auto &fe_values = scratch.fe_values_;
+
+          is_locally_owned = !cell->is_artificial();
+          if (!is_locally_owned)
+            return;
+
+          cell_mass_matrix.reinit(dofs_per_cell, dofs_per_cell);
+          cell_betaij_matrix.reinit(dofs_per_cell, dofs_per_cell);
+          for (auto &matrix : cell_cij_matrix)
+            matrix.reinit(dofs_per_cell, dofs_per_cell);
+
+          fe_values.reinit(cell);
+
+          local_dof_indices.resize(dofs_per_cell);
+          cell->get_dof_indices(local_dof_indices);
+          transform_to_local_range(*scalar_partitioner_, local_dof_indices);
+
+          /* clear out copy data: */
+          cell_mass_matrix = 0.;
+          cell_betaij_matrix = 0.;
+          for (auto &matrix : cell_cij_matrix)
+            matrix = 0.;
+          Number cell_measure = 0.;
+
+          for (unsigned int q_point = 0; q_point < n_q_points; ++q_point) {
+            const auto JxW = fe_values.JxW(q_point);
+
+            if (cell->is_locally_owned())
+              cell_measure += Number(JxW);
+
+            for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+              const auto value_JxW = fe_values.shape_value(j, q_point) * JxW;
+              const auto grad_JxW = fe_values.shape_grad(j, q_point) * JxW;
+
+              for (unsigned int i = 0; i < dofs_per_cell; ++i) {
+
+                const auto value = fe_values.shape_value(i, q_point);
+                const auto grad = fe_values.shape_grad(i, q_point);
+
+                cell_mass_matrix(i, j) += Number(value * value_JxW);
+                cell_betaij_matrix(i, j) += Number(grad * grad_JxW);
+                for (unsigned int d = 0; d < dim; ++d)
+                  cell_cij_matrix[d](i, j) += Number((value * grad_JxW)[d]);
+
+              } /* for i */
+            }   /* for j */
+          }     /* for q */
+
+          cell_measures[cell->active_cell_index()] = cell_measure;
+        };
+
+    /*
+     * Add a value to the (symmetric) mass or beta_ij matrix. With
+     * symmetric storage the entries a_ij and a_ji share a storage
+     * location, so we only add contributions with j >= i. Locally owned
+     * indices come first in local numbering, thus all contributions of
+     * a locally owned row i to a ghost column j are added as well.
+     */
+    const auto add_entry = [&](auto &matrix,
+                               const Number value,
+                               const unsigned int i,
+                               const unsigned int j,
+                               const unsigned int col_idx) {
+      if constexpr (mass_matrix_type::is_symmetric) {
+        if (j < i)
+          return;
+      }
+      const auto entry = matrix.template get_entry<Number>(i, col_idx);
+      matrix.write_entry(entry + value, i, col_idx);
+    };
+
+    /*
+     * Add the local contributions directly into all locally owned rows
+     * of the SIMD storage. The cells are colored such that copiers of
+     * cells with the same color never write into the same row and can
+     * run concurrently.
+     */
+    const auto copy_local_to_global = [&](const auto &copy) {
+      const auto &is_locally_owned = copy.is_locally_owned_;
+      const auto &local_dof_indices = copy.local_dof_indices_;
+      const auto &cell_mass_matrix = copy.cell_mass_matrix_;
+      const auto &cell_cij_matrix = copy.cell_cij_matrix_;
+      const auto &cell_betaij_matrix = copy.cell_betaij_matrix_;
+
+      if (!is_locally_owned)
+        return;
+
+      for (unsigned int a = 0; a < dofs_per_cell; ++a) {
+        const unsigned int i = local_dof_indices[a];
+        if (i >= n_locally_owned_)
+          continue;
+
+        const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+        const unsigned int stride = sparsity_pattern_simd_.stride_of_row(i);
+        const unsigned int *js = sparsity_pattern_simd_.columns(i);
+
+        Number lumped_mass = 0.;
+        for (unsigned int b = 0; b < dofs_per_cell; ++b) {
+          const unsigned int j = local_dof_indices[b];
+
+          unsigned int col_idx = 0;
+          while (col_idx < row_length && js[col_idx * stride] != j)
+            ++col_idx;
+          Assert(col_idx < row_length, dealii::ExcInternalError());
+
+          lumped_mass += cell_mass_matrix(a, b);
+          add_entry(mass_matrix_, cell_mass_matrix(a, b), i, j, col_idx);
+          add_entry(betaij_matrix_, cell_betaij_matrix(a, b), i, j, col_idx);
+
+          auto c_ij = cij_matrix.template get_tensor<Number>(i, col_idx);
+          for (unsigned int d = 0; d < dim; ++d)
+            c_ij[d] += cell_cij_matrix[d](a, b);
+          cij_matrix.write_tensor(c_ij, i, col_idx);
+        }
+
+        lumped_mass_matrix_.local_element(i) += lumped_mass;
+      }
+    };
+
+    using iterator = typename DoFHandler<dim>::active_cell_iterator;
+    const auto get_conflict_indices = [&](const iterator &cell) {
+      std::vector<types::global_dof_index> local_dof_indices;
+      if (!cell->is_artificial()) {
+        local_dof_indices.resize(dofs_per_cell);
+        cell->get_dof_indices(local_dof_indices);
+      }
+      return local_dof_indices;
+    };
+
+    const auto colored_cells = GraphColoring::make_graph_coloring(
+        dof_handler.begin_active(),
+        iterator(dof_handler.end()),
+        std::function<std::vector<types::global_dof_index>(const iterator &)>(
+            get_conflict_indices));
+
+    WorkStream::run(colored_cells,
+                    local_assemble_system,
+                    copy_local_to_global,
+                    AssemblyScratchData<dim>(*discretization_),
+                    AssemblyCopyData<dim, Number>());
+
+    measure_of_omega_ = std::accumulate(
+        cell_measures.begin(), cell_measures.end(), Number(0.));
+    measure_of_omega_ =
+        Utilities::MPI::sum(measure_of_omega_, mpi_communicator_);
+
+    /*
+     * Invert lumped mass matrix:
+     */
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_locally_owned_; ++i)
+      lumped_mass_matrix_inverse_.local_element(i) =
+          1. / lumped_mass_matrix_.local_element(i);
+    RYUJIN_PARALLEL_REGION_END
+
+    lumped_mass_matrix_.update_ghost_values();
+    lumped_mass_matrix_inverse_.update_ghost_values();
+
+    if constexpr (!mass_matrix_type::is_symmetric) {
+      betaij_matrix_.update_ghost_rows();
+      mass_matrix_.update_ghost_rows();
+    }
+    cij_matrix.update_ghost_rows();
+
+    if constexpr (!cij_is_full)
+      cij_matrix_.read_in(cij_matrix_tmp);
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::assemble_cij_norms()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::assemble_cij_norms()" << std::endl;
+#endif
+
+    if (!precompute_cij_norms_)
+      return;
+
+    using VA = VectorizedArray<Number>;
+    constexpr auto simd_length = VA::size();
+
+    cij_norm_matrix_.reinit(sparsity_pattern_simd_);
+
+    /*
+     * Compute the norms exactly the way the hyperbolic module does, i.e.,
+     * after converting c_ij to Number, so that the results are bitwise
+     * identical:
+     */
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_locally_internal_; i += simd_length) {
+      const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const auto c_ij = cij_matrix_.template get_tensor<VA>(i, col_idx);
+        cij_norm_matrix_.write_entry(c_ij.norm(), i, col_idx);
+      }
+    }
+
+    RYUJIN_OMP_FOR
+    for (unsigned int i = n_locally_internal_; i < n_locally_owned_; ++i) {
+      const unsigned int row_length = sparsity_pattern_simd_.row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const auto c_ij = cij_matrix_.template get_tensor<Number>(i, col_idx);
+        cij_norm_matrix_.write_entry(c_ij.norm(), i, col_idx);
+      }
+    }
+
+    RYUJIN_PARALLEL_REGION_END
+
+    cij_norm_matrix_.update_ghost_rows();
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::create_boundary_data()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::create_boundary_data()"
+              << std::endl;
+#endif
+
+    auto &dof_handler = *dof_handler_;
+
     /* Populate boundary map: */
 
     boundary_map_ = construct_boundary_map(
         dof_handler.begin_active(), dof_handler.end(), *scalar_partitioner_);
+    boundary_table_.reinit(boundary_map_, n_locally_owned_);
 
     /* Extract coupling boundary pairs: */
 
@@ -631,7 +1116,7 @@ namespace ryujin
       for (unsigned int col_idx = 1; col_idx < row_length; ++col_idx) {
         const auto j = *(i < n_locally_internal_ ? js + col_idx * simd_length
                                                  : js + col_idx);
-        if (boundary_map_.count(j) != 0) {
+        if (boundary_table_.is_boundary(j)) {
           coupling_boundary_pairs_.push_back({i, col_idx, j});
         }
       }
@@ -640,13 +1125,319 @@ namespace ryujin
 
 
   template <int dim, typename Number>
-  void OfflineData<dim, Number>::create_multigrid_data()
+  std::string OfflineData<dim, Number>::assembled_layout()
+  {
+    std::string layout = "revision = " RYUJIN_GIT_REVISION "\n";
+    layout += "dim = " + std::to_string(dim) + "\n";
+    layout += "simd length = " +
+              std::to_string(VectorizedArray<Number>::size()) + "\n";
+    layout += "number size = " + std::to_string(sizeof(Number)) + "\n";
+    layout += "matrix number size = " +
+              std::to_string(sizeof(matrix_number_type)) + "\n";
+#ifdef MIXED_PRECISION_OFFLINE_MATRICES
+    layout += "MIXED_PRECISION_OFFLINE_MATRICES\n";
+#endif
+#ifdef SKEW_SYMMETRIC_CIJ_MATRIX
+    layout += "SKEW_SYMMETRIC_CIJ_MATRIX\n";
+#endif
+#ifdef STENCIL_COMPRESSED_CIJ_MATRIX
+    layout += "STENCIL_COMPRESSED_CIJ_MATRIX\n";
+#endif
+    return layout;
+  }
+
+
+  template <int dim, typename Number>
+  std::array<unsigned long long, 9>
+  OfflineData<dim, Number>::assembled_fingerprint() const
+  {
+    return {fnv_hash(assembled_layout()),
+            Utilities::MPI::n_mpi_processes(mpi_communicator_),
+            discretization_->triangulation().n_global_active_cells(),
+            dof_handler_->n_dofs(),
+            n_locally_owned_,
+            n_locally_internal_,
+            n_locally_relevant_,
+            n_export_indices_,
+            sparsity_pattern_hash_};
+  }
+
+
+  template <int dim, typename Number>
+  unsigned long long OfflineData<dim, Number>::partition_fingerprint() const
+  {
+    const auto fingerprint = assembled_fingerprint();
+
+    /* Skip the first entry, the hash of the compile-time layout: */
+    unsigned long long hash = 14695981039346656037ull;
+    for (unsigned int k = 1; k < fingerprint.size(); ++k)
+      hash = (hash ^ fingerprint[k]) * 1099511628211ull;
+    return hash;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::write_assembled(const std::string &name) const
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::write_assembled()" << std::endl;
+#endif
+
+    const auto rank = Utilities::MPI::this_mpi_process(mpi_communicator_);
+    const auto filename = name + "." + Utilities::to_string(rank);
+
+    /* Write to a temporary file first so that we never leave a partial file: */
+    {
+      std::ofstream output(filename + "~", std::ios::binary | std::ios::trunc);
+
+      const auto write = [&](const auto &value) {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(value));
+      };
+
+      write(assembled_fingerprint());
+      write(measure_of_omega_);
+
+      const auto &partitioner = *lumped_mass_matrix_.get_partitioner();
+      const auto size =
+          partitioner.locally_owned_size() + partitioner.n_ghost_indices();
+      output.write(reinterpret_cast<const char *>(lumped_mass_matrix_.begin()),
+                   size * sizeof(Number));
+      output.write(
+          reinterpret_cast<const char *>(lumped_mass_matrix_inverse_.begin()),
+          size * sizeof(Number));
+
+      mass_matrix_.write_data(output);
+      betaij_matrix_.write_data(output);
+      cij_matrix_.write_data(output);
+
+      write(boundary_map_.size());
+      for (const auto &[i, description] : boundary_map_) {
+        const auto &[normal, normal_mass, boundary_mass, id, position] =
+            description;
+        write(i);
+        write(normal);
+        write(normal_mass);
+        write(boundary_mass);
+        write(id);
+        write(position);
+      }
+
+      write(coupling_boundary_pairs_.size());
+      for (const auto &[i, col_idx, j] : coupling_boundary_pairs_) {
+        write(i);
+        write(col_idx);
+        write(j);
+      }
+
+      AssertThrow(output.good(),
+                  ExcMessage("Could not write out offline data to " +
+                             filename));
+    }
+
+    std::filesystem::rename(filename + "~", filename);
+  }
+
+
+  template <int dim, typename Number>
+  bool OfflineData<dim, Number>::read_assembled(const std::string &name)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "OfflineData<dim, Number>::read_assembled()" << std::endl;
+#endif
+
+    const auto rank = Utilities::MPI::this_mpi_process(mpi_communicator_);
+    const auto filename = name + "." + Utilities::to_string(rank);
+
+    std::ifstream input(filename, std::ios::binary);
+
+    const auto read = [&](auto &value) {
+      input.read(reinterpret_cast<char *>(&value), sizeof(value));
+    };
+
+    /* Check that the offline data is compatible on all ranks: */
+
+    std::array<unsigned long long, 9> fingerprint;
+    fingerprint.fill(0);
+    if (input.good())
+      read(fingerprint);
+
+    const bool match = input.good() && fingerprint == assembled_fingerprint();
+    if (Utilities::MPI::min(match ? 1u : 0u, mpi_communicator_) == 0)
+      return false;
+
+    read(measure_of_omega_);
+
+    const auto &partitioner = *lumped_mass_matrix_.get_partitioner();
+    const auto size =
+        partitioner.locally_owned_size() + partitioner.n_ghost_indices();
+    input.read(reinterpret_cast<char *>(lumped_mass_matrix_.begin()),
+               size * sizeof(Number));
+    input.read(reinterpret_cast<char *>(lumped_mass_matrix_inverse_.begin()),
+               size * sizeof(Number));
+
+    mass_matrix_.read_data(input);
+    betaij_matrix_.read_data(input);
+    cij_matrix_.read_data(input);
+
+    boundary_map_.clear();
+    typename boundary_map_type::size_type n_boundary_entries;
+    read(n_boundary_entries);
+    for (std::size_t k = 0; k < n_boundary_entries; ++k) {
+      typename boundary_map_type::key_type i;
+      boundary_description description;
+      auto &[normal, normal_mass, boundary_mass, id, position] = description;
+      read(i);
+      read(normal);
+      read(normal_mass);
+      read(boundary_mass);
+      read(id);
+      read(position);
+      boundary_map_.insert(boundary_map_.end(), {i, description});
+    }
+    boundary_table_.reinit(boundary_map_, n_locally_owned_);
+
+    coupling_boundary_pairs_.clear();
+    typename coupling_boundary_pairs_type::size_type n_pairs;
+    read(n_pairs);
+    coupling_boundary_pairs_.resize(n_pairs);
+    for (auto &[i, col_idx, j] : coupling_boundary_pairs_) {
+      read(i);
+      read(col_idx);
+      read(j);
+    }
+
+    AssertThrow(input.good(),
+                ExcMessage("Could not read in offline data from " + filename));
+
+    return true;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::collect_memory_statistics(
+      std::vector<std::pair<std::string, std::size_t>> &statistics) const
+  {
+    statistics.push_back({"OfflineData: dof handler and constraints",
+                          dof_handler_->memory_consumption() +
+                              affine_constraints_.memory_consumption()});
+
+    statistics.push_back({"OfflineData: sparsity patterns",
+                          sparsity_pattern_.memory_consumption() +
+                              sparsity_pattern_simd_.memory_consumption()});
+
+    statistics.push_back(
+        {"OfflineData: mass matrix", mass_matrix_.memory_consumption()});
+    statistics.push_back(
+        {"OfflineData: betaij matrix", betaij_matrix_.memory_consumption()});
+    statistics.push_back(
+        {"OfflineData: cij matrix", cij_matrix_.memory_consumption()});
+    if (precompute_cij_norms_)
+      statistics.push_back({"OfflineData: cij norm matrix",
+                            cij_norm_matrix_.memory_consumption()});
+
+    statistics.push_back({"OfflineData: boundary table",
+                          boundary_table_.memory_consumption()});
+
+    statistics.push_back(
+        {"OfflineData: lumped mass matrix",
+         lumped_mass_matrix_.memory_consumption() +
+             lumped_mass_matrix_inverse_.memory_consumption()});
+
+    std::size_t multigrid = 0;
+    for (const auto &it : level_lumped_mass_matrix_)
+      multigrid += it.memory_consumption();
+    statistics.push_back({"OfflineData: multigrid data", multigrid});
+  }
+
+
+  template <int dim, typename Number>
+  unsigned long long
+  OfflineData<dim, Number>::level_dof_fingerprint(
+      const unsigned int level) const
+  {
+    /* A simple hash over cells, cell centers and level dof indices: */
+    unsigned long long hash = 14695981039346656037ull;
+    const auto combine = [&](const unsigned long long value) {
+      hash = (hash ^ value) * 1099511628211ull;
+    };
+
+    std::vector<types::global_dof_index> dof_indices(
+        dof_handler_->get_fe().dofs_per_cell);
+
+    for (const auto &cell : dof_handler_->cell_iterators_on_level(level)) {
+      if (cell->level_subdomain_id() == numbers::artificial_subdomain_id)
+        continue;
+
+      combine(cell->index());
+      combine(cell->level_subdomain_id());
+
+      const auto center = cell->center();
+      for (unsigned int d = 0; d < dim; ++d) {
+        const double value = center[d];
+        unsigned long long bits = 0;
+        std::memcpy(&bits, &value, sizeof(value));
+        combine(bits);
+      }
+
+      cell->get_mg_dof_indices(dof_indices);
+      for (const auto index : dof_indices)
+        combine(index);
+    }
+
+    return hash;
+  }
+
+
+  template <int dim, typename Number>
+  const std::vector<Point<dim>> &
+  OfflineData<dim, Number>::locally_owned_support_points() const
+  {
+    if (!locally_owned_support_points_.empty() || n_locally_owned_ == 0)
+      return locally_owned_support_points_;
+
+    SetupScope scope("offline data - support points");
+
+    const auto &finite_element = discretization_->finite_element();
+    const unsigned int dofs_per_cell = finite_element.dofs_per_cell;
+
+    const Quadrature<dim> quadrature(finite_element.get_unit_support_points());
+    FEValues<dim> fe_values(discretization_->mapping(),
+                            finite_element,
+                            quadrature,
+                            update_quadrature_points);
+
+    locally_owned_support_points_.resize(n_locally_owned_);
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+    for (const auto &cell : dof_handler_->active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      fe_values.reinit(cell);
+      cell->get_dof_indices(dof_indices);
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+        const auto index = scalar_partitioner_->global_to_local(dof_indices[j]);
+        if (index < n_locally_owned_)
+          locally_owned_support_points_[index] = fe_values.quadrature_point(j);
+      }
+    }
+
+    return locally_owned_support_points_;
+  }
+
+
+  template <int dim, typename Number>
+  void OfflineData<dim, Number>::prepare_multigrid_data(
+      const unsigned int min_level) const
   {
 #ifdef DEBUG_OUTPUT
-    std::cout << "OfflineData<dim, Number>::create_multigrid_data()"
+    std::cout << "OfflineData<dim, Number>::prepare_multigrid_data()"
               << std::endl;
 #endif
 
+    SetupScope scope("offline data - multigrid data");
+
     auto &dof_handler = *dof_handler_;
 
     dof_handler.distribute_mg_dofs();
@@ -658,8 +1449,37 @@ namespace ryujin
 
     level_boundary_map_.resize(n_levels);
     level_lumped_mass_matrix_.resize(n_levels);
+    level_fingerprint_.resize(n_levels, 0);
+    level_generation_.resize(n_levels, numbers::invalid_unsigned_int);
+
+    /* Release the data of levels that are not visited: */
+    for (unsigned int level = 0; level < std::min(min_level, n_levels);
+         ++level) {
+      level_boundary_map_[level].clear();
+      level_lumped_mass_matrix_[level].reinit(0);
+      level_generation_[level] = numbers::invalid_unsigned_int;
+    }
+
+    for (unsigned int level = min_level; level < n_levels; ++level) {
+      /*
+       * Skip levels whose mesh, partitioning and degree of freedom
+       * numbering did not change since the last call. This is for example
+       * the case for all old levels after a global refinement:
+       */
+
+      const auto fingerprint = level_dof_fingerprint(level);
+      const bool unchanged = Utilities::MPI::min(
+          level_generation_[level] != numbers::invalid_unsigned_int &&
+                  level_fingerprint_[level] == fingerprint
+              ? 1u
+              : 0u,
+          mpi_communicator_);
+      if (unchanged == 1u)
+        continue;
+
+      level_fingerprint_[level] = fingerprint;
+      level_generation_[level] = n_level_generations_++;
 
-    for (unsigned int level = 0; level < n_levels; ++level) {
       /* Assemble lumped mass matrix vector: */
 
       IndexSet relevant_dofs;
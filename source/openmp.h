@@ -14,7 +14,12 @@
 #endif
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <mutex>
+#include <thread>
 
 /**
  * @name OpenMP parallel for macros
@@ -78,6 +83,24 @@
  */
 #define RYUJIN_OMP_FOR_NOWAIT RYUJIN_PRAGMA(omp for nowait)
 
+/**
+ * Enter a parallel for loop with a schedule selected at run time with
+ * ryujin::set_runtime_schedule(). This allows to switch between a static
+ * distribution of the iteration range and a dynamic distribution of
+ * chunks of iterations to worker threads on demand.
+ *
+ * @ingroup Miscellaneous
+ */
+#define RYUJIN_OMP_FOR_RUNTIME RYUJIN_PRAGMA(omp for schedule(runtime))
+
+/**
+ * Variant of RYUJIN_OMP_FOR_RUNTIME with "nowait" declaration.
+ *
+ * @ingroup Miscellaneous
+ */
+#define RYUJIN_OMP_FOR_RUNTIME_NOWAIT                                          \
+  RYUJIN_PRAGMA(omp for schedule(runtime) nowait)
+
 /**
  * Declare an explicit Thread synchronization barrier.
  *
@@ -134,7 +157,132 @@
 namespace ryujin
 {
   /**
-   * @todo write documentation
+   * Select the schedule of all subsequent parallel for loops annotated
+   * with RYUJIN_OMP_FOR_RUNTIME. If @p chunk_size is zero the iteration
+   * range is statically distributed on all available worker threads (the
+   * behavior of RYUJIN_OMP_FOR). Otherwise, chunks of @p chunk_size
+   * iterations are handed out dynamically to worker threads on demand.
+   * The dynamic schedule is requested with the monotonic modifier, i.e.,
+   * every thread receives its chunks in increasing iteration order. The
+   * SynchronizationDispatch relies on this ordering; the default
+   * (nonmonotonic) dynamic schedule of OpenMP 5.0 does not guarantee it.
+   *
+   * @note This function has to be called in serial, non thread-parallel
+   * context. The schedule is inherited by all subsequent parallel regions.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline void set_runtime_schedule([[maybe_unused]] unsigned int chunk_size)
+  {
+#ifdef WITH_OPENMP
+    if (chunk_size == 0)
+      omp_set_schedule(omp_sched_static, 0);
+    else
+#if _OPENMP >= 201811
+      omp_set_schedule(
+          omp_sched_t(omp_sched_dynamic | omp_sched_monotonic), chunk_size);
+#else
+      /* Prior to OpenMP 5.0 dynamic schedules are always monotonic: */
+      omp_set_schedule(omp_sched_dynamic, chunk_size);
+#endif
+#endif
+  }
+
+
+  /**
+   * A dedicated, persistent communication thread that executes payloads
+   * (typically MPI ghost exchanges) asynchronously in the order they have
+   * been submitted. Compared to launching a new thread for every payload
+   * this avoids the thread creation overhead and guarantees that at most
+   * one payload communicates at any given time.
+   *
+   * @ingroup Miscellaneous
+   */
+  class CommunicationThread
+  {
+  public:
+    /**
+     * Return a reference to the communication thread. The thread is
+     * started on first use.
+     */
+    static CommunicationThread &instance()
+    {
+      static CommunicationThread communication_thread;
+      return communication_thread;
+    }
+
+    /**
+     * Submit a @p payload for asynchronous execution.
+     */
+    std::future<void> submit(const std::function<void()> &payload)
+    {
+      std::packaged_task<void()> task(payload);
+      auto future = task.get_future();
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+      }
+      condition_.notify_one();
+      return future;
+    }
+
+    ~CommunicationThread()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+      }
+      condition_.notify_one();
+      thread_.join();
+    }
+
+  private:
+    CommunicationThread()
+        : shutdown_(false)
+        , thread_([this]() { run(); })
+    {
+    }
+
+    void run()
+    {
+      for (;;) {
+        std::packaged_task<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          condition_.wait(lock,
+                          [this]() { return shutdown_ || !queue_.empty(); });
+          if (queue_.empty())
+            return;
+          task = std::move(queue_.front());
+          queue_.pop_front();
+        }
+        task();
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::packaged_task<void()>> queue_;
+    bool shutdown_;
+    std::thread thread_;
+  };
+
+
+  /**
+   * A small helper class for overlapping a (MPI) synchronization payload
+   * with thread-parallel work.
+   *
+   * Every worker thread calls check() in its loop. As soon as all threads
+   * signalled that the condition is satisfied (typically, that all export
+   * indices have been computed) the payload is submitted to the
+   * CommunicationThread. The payload is guaranteed to have completed
+   * after a call to wait(), or on destruction of the object. A call to
+   * launch() in serial context submits the payload if this has not
+   * happened yet; this allows to overlap the payload with subsequent
+   * work before calling wait().
+   *
+   * Without the compile-time option ASYNC_MPI_EXCHANGE the payload is
+   * simply executed synchronously in wait().
    *
    * @ingroup Miscellaneous
    */
@@ -143,6 +291,7 @@ namespace ryujin
   public:
     SynchronizationDispatch(const std::function<void()> &async_payload)
         : async_payload_(async_payload)
+        , payload_done_(false)
         , n_threads_ready_(0)
     {
     }
@@ -150,12 +299,39 @@ namespace ryujin
     ~SynchronizationDispatch()
     {
       /* Executes in serial, non thread-parallel context: */
+      wait();
+    }
+
+    /**
+     * Submit the payload to the CommunicationThread if this has not
+     * happened yet. Executes in serial, non thread-parallel context.
+     */
+    void launch()
+    {
+#ifdef ASYNC_MPI_EXCHANGE
+      if (!payload_done_ && !payload_status_.valid())
+        payload_status_ =
+            CommunicationThread::instance().submit(async_payload_);
+#endif
+    }
+
+    /**
+     * Wait for the payload to complete, or execute it synchronously if it
+     * has not been submitted. Executes in serial, non thread-parallel
+     * context.
+     */
+    void wait()
+    {
+      if (payload_done_)
+        return;
 
       if (payload_status_.valid()) {
         payload_status_.wait();
       } else {
         async_payload_();
       }
+
+      payload_done_ = true;
     }
 
 #ifdef ASYNC_MPI_EXCHANGE
@@ -168,7 +344,8 @@ namespace ryujin
 #ifdef WITH_OPENMP
         if (++n_threads_ready_ == omp_get_num_threads())
 #endif
-          payload_status_ = std::async(std::launch::async, async_payload_);
+          payload_status_ =
+              CommunicationThread::instance().submit(async_payload_);
       }
     }
 #else
@@ -178,6 +355,7 @@ namespace ryujin
   private:
     const std::function<void()> async_payload_;
     std::future<void> payload_status_;
+    bool payload_done_;
     std::atomic_int n_threads_ready_;
   };
 } // namespace ryujin
@@ -80,6 +80,29 @@ namespace ryujin
      */
     void prepare();
 
+    /**
+     * Append the memory consumption (in bytes) of the parabolic solver
+     * to @p statistics. This is a no-op if the parabolic system is the
+     * identity.
+     */
+    void collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const;
+
+    /**
+     * Discard all information carried over from previous time steps so
+     * that the next step does not depend on the trajectory computed so
+     * far. This is used for switching between ensemble members, see
+     * TimeLoop. The multigrid hierarchy is rebuilt in the next step.
+     */
+    void reset_history() const;
+
+    /**
+     * Return true if the parabolic solver is configured to carry
+     * information (such as previous solutions for extrapolating an
+     * initial guess) over from one time step to the next.
+     */
+    bool keeps_history() const;
+
     /**
      * @name Functons for performing explicit time steps
      */
@@ -120,6 +143,14 @@ namespace ryujin
      */
     void print_solver_statistics(std::ostream &output) const;
 
+    /**
+     * Append (name, value) pairs of solver statistics (such as averaged
+     * iteration counts) to @p statistics. This function is used for the
+     * telemetry output of the TimeLoop.
+     */
+    void collect_solver_statistics(
+        std::vector<std::pair<std::string, double>> &statistics) const;
+
     //@}
     /**
      * @name Accessors
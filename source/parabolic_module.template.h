@@ -49,6 +49,38 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void ParabolicModule<Description, dim, Number>::collect_memory_statistics(
+      std::vector<std::pair<std::string, std::size_t>> &statistics) const
+  {
+    if constexpr (!ParabolicSystem::is_identity) {
+      parabolic_solver_.collect_memory_statistics(statistics);
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void ParabolicModule<Description, dim, Number>::reset_history() const
+  {
+    if constexpr (!ParabolicSystem::is_identity) {
+      parabolic_solver_.reset_history();
+    }
+
+    cycle_ = 0;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  bool ParabolicModule<Description, dim, Number>::keeps_history() const
+  {
+    if constexpr (!ParabolicSystem::is_identity) {
+      return parabolic_solver_.keeps_history();
+    } else {
+      return false;
+    }
+  }
+
+
   template <typename Description, int dim, typename Number>
   template <int stages>
   void ParabolicModule<Description, dim, Number>::step(
@@ -107,4 +139,14 @@ namespace ryujin
     }
   }
 
+
+  template <typename Description, int dim, typename Number>
+  void ParabolicModule<Description, dim, Number>::collect_solver_statistics(
+      std::vector<std::pair<std::string, double>> &statistics) const
+  {
+    if constexpr (!ParabolicSystem::is_identity) {
+      parabolic_solver_.collect_solver_statistics(statistics);
+    }
+  }
+
 } /* namespace ryujin */
@@ -121,7 +121,7 @@ namespace ryujin
     const auto &sparsity_simd = offline_data_->sparsity_pattern_simd();
     const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
     const auto &cij_matrix = offline_data_->cij_matrix();
-    const auto &boundary_map = offline_data_->boundary_map();
+    const auto &boundary_table = offline_data_->boundary_table();
 
     const unsigned int n_internal = offline_data_->n_locally_internal();
     const unsigned int n_owned = offline_data_->n_locally_owned();
@@ -136,13 +136,49 @@ namespace ryujin
     Assert(n_quantities == quantities_.size(), dealii::ExcInternalError());
     Assert(n_quantities == component_names_.size(), dealii::ExcInternalError());
 
+    /* Force recomputation of bounds: */
+    if (recompute_bounds_)
+      bounds_.clear();
+
+    const bool compute_bounds = (bounds_.size() != n_quantities);
+    if (compute_bounds) {
+      bounds_.clear();
+      bounds_.resize(
+          n_quantities,
+          std::make_pair(Number(0.), std::numeric_limits<Number>::max()));
+    }
+
+    /*
+     * Normalize a quantity q with index d on an exponential scale. We
+     * use exp(-beta * s) = pow(exp(-beta), s) in order to use the
+     * vectorized pow() implementation:
+     */
+    const Number decay = std::exp(-beta_);
+    const auto normalize = [&](const auto q, const unsigned int d) {
+      using T = std::remove_const_t<decltype(q)>;
+      const auto &[q_max, q_min] = bounds_[d];
+      constexpr auto eps = std::numeric_limits<Number>::epsilon();
+      const T s = (std::abs(q) - T(q_min)) / T(q_max - q_min + eps);
+      const T magnitude = T(1.) - ryujin::pow(T(decay), s);
+      return dealii::compare_and_apply_mask<dealii::SIMDComparison::less_than>(
+          q, T(0.), -magnitude, magnitude);
+    };
+
     /*
-     * Step 1: Compute quantities:
+     * Step 1: Compute quantities. If the bounds are known already we
+     * normalize every value right away. Otherwise, we record the local
+     * bounds while the values are still in registers. We store the
+     * negative minimum so that all bounds can be reduced with a maximum:
      */
 
+    std::vector<Number> local_bounds(2 * n_quantities,
+                                     std::numeric_limits<Number>::lowest());
     {
       RYUJIN_PARALLEL_REGION_BEGIN
 
+      std::vector<Number> thread_bounds(
+          2 * n_quantities, std::numeric_limits<Number>::lowest());
+
       auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
         using T = decltype(sentinel);
         unsigned int stride_size = get_stride_size<T>;
@@ -150,18 +186,25 @@ namespace ryujin
         std::vector<grad_type<T>> local_schlieren_values(n_schlieren);
         std::vector<curl_type<T>> local_vorticity_values(n_vorticities);
 
+        std::vector<T> chunk_bounds(
+            compute_bounds ? 2 * n_quantities : 0,
+            T(std::numeric_limits<Number>::lowest()));
+
+        const unsigned int *active_rows = sparsity_simd.active_rows();
+        const unsigned int first = sparsity_simd.active_position(left);
+        const unsigned int last = sparsity_simd.active_position(right);
+
+        /* Constrained degrees of freedom are not in active_rows(): */
         RYUJIN_OMP_FOR
-        for (unsigned int i = left; i < right; i += stride_size) {
+        for (unsigned int r = first; r < last; ++r) {
+          const unsigned int i = active_rows[r];
 
           for (auto &it : local_schlieren_values)
             it = grad_type<T>();
           for (auto &it : local_vorticity_values)
             it = curl_type<T>();
 
-          /* Skip constrained degrees of freedom: */
           const unsigned int row_length = sparsity_simd.row_length(i);
-          if (row_length == 1)
-            continue;
 
           const unsigned int *js = sparsity_simd.columns(i);
           for (unsigned int col_idx = 0; col_idx < row_length;
@@ -197,10 +240,11 @@ namespace ryujin
 
           /* Serialize over the stride: */
           for (unsigned int k = 0; k < stride_size; ++k) {
-            const auto range = boundary_map.equal_range(i + k);
-            for (auto it = range.first; it != range.second; ++it) {
-              const auto normal = std::get<0>(it->second);
-              const auto id = std::get<3>(it->second);
+            for (auto b = boundary_table.begin(i + k);
+                 b < boundary_table.end(i + k);
+                 ++b) {
+              const auto &normal = boundary_table.normal[b];
+              const auto id = boundary_table.id[b];
 
               if (id == Boundary::slip || id == Boundary::no_slip) {
                 /* Remove normal component of schlieren values at slip
@@ -236,19 +280,37 @@ namespace ryujin
 
           const auto m_i = load_value<T>(lumped_mass_matrix, i);
 
+          const auto populate = [&](const unsigned int d, T value_i) {
+            if (compute_bounds) {
+              const auto q = std::abs(value_i);
+              chunk_bounds[d] = std::max(chunk_bounds[d], q);
+              chunk_bounds[n_quantities + d] =
+                  std::max(chunk_bounds[n_quantities + d], -q);
+            } else {
+              value_i = normalize(value_i, d);
+            }
+            store_value<T>(quantities_[d], value_i, i);
+          };
+
           unsigned int k = 0;
 
-          for (const auto &schlieren : local_schlieren_values) {
-            const auto value_i = schlieren.norm() / m_i;
-            store_value<T>(quantities_[k++], value_i, i);
-          }
+          for (const auto &schlieren : local_schlieren_values)
+            populate(k++, schlieren.norm() / m_i);
 
-          for (const auto &vorticity : local_vorticity_values) {
-            auto value_i =
-                (dim == 2 ? vorticity[0] / m_i : vorticity.norm() / m_i);
-            store_value<T>(quantities_[k++], value_i, i);
-          }
+          for (const auto &vorticity : local_vorticity_values)
+            populate(k++,
+                     (dim == 2 ? vorticity[0] / m_i : vorticity.norm() / m_i));
         } /* i */
+
+        /* Reduce over the stride: */
+        for (unsigned int d = 0; d < chunk_bounds.size(); ++d) {
+          if constexpr (std::is_same_v<T, Number>) {
+            thread_bounds[d] = std::max(thread_bounds[d], chunk_bounds[d]);
+          } else {
+            for (unsigned int k = 0; k < stride_size; ++k)
+              thread_bounds[d] = std::max(thread_bounds[d], chunk_bounds[d][k]);
+          }
+        }
       };
 
       /* Parallel non-vectorized loop: */
@@ -256,62 +318,67 @@ namespace ryujin
       /* Parallel vectorized SIMD loop: */
       loop(VA(), 0, n_internal);
 
+      if (compute_bounds) {
+        RYUJIN_OMP_CRITICAL
+        for (unsigned int d = 0; d < 2 * n_quantities; ++d)
+          local_bounds[d] = std::max(local_bounds[d], thread_bounds[d]);
+      }
+
       RYUJIN_PARALLEL_REGION_END
     }
 
     /*
-     * Step 2: Compute bounds and synchronize over MPI ranks:
+     * Step 2: Synchronize bounds over all MPI ranks with a single MPI
+     * call and normalize all quantities on an exponential scale:
      */
 
-    /* Force recomputation of bounds: */
-    if (recompute_bounds_)
-      bounds_.clear();
-
-    if (bounds_.size() != n_quantities) {
-      bounds_.clear();
-      bounds_.resize(
-          n_quantities,
-          std::make_pair(Number(0.), std::numeric_limits<Number>::max()));
+    if (compute_bounds) {
+      std::vector<Number> global_bounds(2 * n_quantities);
+      dealii::Utilities::MPI::max(
+          local_bounds, mpi_communicator_, global_bounds);
 
       for (unsigned int d = 0; d < n_quantities; ++d) {
         auto &[q_max, q_min] = bounds_[d];
-        for (unsigned int i = 0; i < n_owned; ++i) {
-          const auto q = quantities_[d].local_element(i);
-          q_max = std::max(q_max, std::abs(q));
-          q_min = std::min(q_min, std::abs(q));
-        }
-        q_max = dealii::Utilities::MPI::max(q_max, mpi_communicator_);
-        q_min = dealii::Utilities::MPI::min(q_min, mpi_communicator_);
+        q_max = std::max(q_max, global_bounds[d]);
+        q_min = std::min(q_min, -global_bounds[n_quantities + d]);
         Assert(q_max >= q_min, dealii::ExcInternalError());
       }
-    }
 
-    /*
-     * Step 3: Normalize quantities on exponential scale:
-     */
+      RYUJIN_PARALLEL_REGION_BEGIN
 
-    {
-      for (unsigned int d = 0; d < n_quantities; ++d) {
-        auto &[q_max, q_min] = bounds_[d];
-        for (unsigned int i = 0; i < n_owned; ++i) {
-          auto &q = quantities_[d].local_element(i);
-          constexpr auto eps = std::numeric_limits<Number>::epsilon();
-          const auto magnitude =
-              Number(1.) -
-              std::exp(-beta_ * (std::abs(q) - q_min) / (q_max - q_min + eps));
-          q = std::copysign(magnitude, q);
+      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+        using T = decltype(sentinel);
+        const unsigned int stride_size = get_stride_size<T>;
+
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; i += stride_size) {
+          for (unsigned int d = 0; d < n_quantities; ++d) {
+            const auto q = load_value<T>(quantities_[d], i);
+            store_value<T>(quantities_[d], normalize(q, d), i);
+          }
         }
-      }
+      };
+
+      /* Parallel non-vectorized loop: */
+      loop(Number(), n_internal, n_owned);
+      /* Parallel vectorized SIMD loop: */
+      loop(VA(), 0, n_internal);
+
+      RYUJIN_PARALLEL_REGION_END
     }
 
     /*
-     * Step 4: Fix up constraints and distribute:
+     * Step 3: Fix up constraints and distribute. All ghost exchanges are
+     * kept in flight simultaneously:
      */
 
-    for (auto &it : quantities_) {
+    for (auto &it : quantities_)
       affine_constraints.distribute(it);
-      it.update_ghost_values();
-    }
+
+    for (unsigned int d = 0; d < n_quantities; ++d)
+      quantities_[d].update_ghost_values_start(d);
+    for (unsigned int d = 0; d < n_quantities; ++d)
+      quantities_[d].update_ghost_values_finish();
   }
 
 } // namespace ryujin
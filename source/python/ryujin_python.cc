@@ -0,0 +1,257 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#include <compile_time_options.h>
+
+#include "equation_dispatch.h"
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace py = pybind11;
+
+namespace ryujin
+{
+  namespace Python
+  {
+    /**
+     * A Python (pybind11) handle for a TimeLoop. The object owns the
+     * state vector and the current time and exposes the locally owned
+     * part of the state, the support points and the boundary table as
+     * NumPy arrays that share the memory with ryujin (zero copy). The
+     * arrays are invalidated by a subsequent call to prepare().
+     *
+     * All parameters are read from a parameter file with the usual
+     * layout. Because deal.II's ParameterAcceptor is a global registry
+     * only one Simulation object may exist at any time.
+     */
+    template <typename Description, int dim>
+    class Simulation
+    {
+    public:
+      using TimeLoop = ryujin::TimeLoop<Description, dim, NUMBER>;
+      using vector_type = typename TimeLoop::vector_type;
+      static constexpr unsigned int problem_dimension =
+          TimeLoop::problem_dimension;
+
+      Simulation(const std::string &parameter_file)
+          : time_loop_(MPI_COMM_WORLD)
+          , t_(0.)
+      {
+        dealii::ParameterAcceptor::initialize(parameter_file);
+      }
+
+      /**
+       * Create the mesh and all data structures and interpolate the
+       * initial values.
+       */
+      void prepare()
+      {
+        time_loop_.prepare_state(U_);
+        t_ = 0.;
+
+        const auto &offline_data = time_loop_.offline_data();
+        const auto &partitioner = offline_data.scalar_partitioner();
+        const unsigned int n_owned = offline_data.n_locally_owned();
+
+        std::map<dealii::types::global_dof_index, dealii::Point<dim>> map;
+        dealii::DoFTools::map_dofs_to_support_points(
+            time_loop_.discretization().mapping(),
+            offline_data.dof_handler(),
+            map);
+
+        support_points_.assign(std::size_t(n_owned) * dim, 0.);
+        for (const auto &[index, point] : map) {
+          const auto i = partitioner->global_to_local(index);
+          if (i >= n_owned)
+            continue;
+          for (unsigned int d = 0; d < dim; ++d)
+            support_points_[std::size_t(i) * dim + d] = point[d];
+        }
+      }
+
+      /**
+       * Perform one time step and return the new time.
+       */
+      double step()
+      {
+        /* The locally owned part might have been modified via state(): */
+        U_.update_ghost_values();
+        t_ += time_loop_.step(U_, t_);
+        return t_;
+      }
+
+      /**
+       * Advance the state up to (at least) time @p t_end.
+       */
+      double advance(const double t_end)
+      {
+        while (t_ < t_end)
+          step();
+        return t_;
+      }
+
+      /**
+       * Write out the current state.
+       */
+      void output(const std::string &name, const unsigned int cycle)
+      {
+        U_.update_ghost_values();
+        time_loop_.write_output(U_, name, t_, cycle);
+      }
+
+      double time() const
+      {
+        return t_;
+      }
+
+      /**
+       * A (n_locally_owned, problem_dimension) view into the locally
+       * owned part of the state vector. Writing into the array modifies
+       * the state. Ghost values are updated on the next call to step()
+       * or output().
+       */
+      py::array_t<NUMBER> state(py::object self)
+      {
+        const auto n_owned = time_loop_.offline_data().n_locally_owned();
+        constexpr auto stride = vector_type::stride;
+        return py::array_t<NUMBER>(
+            {std::size_t(n_owned), std::size_t(problem_dimension)},
+            {stride * sizeof(NUMBER), sizeof(NUMBER)},
+            U_.begin(),
+            self);
+      }
+
+      /**
+       * A (n_locally_owned, dim) array of the support points of all
+       * locally owned degrees of freedom.
+       */
+      py::array_t<double> support_points(py::object self)
+      {
+        const std::size_t n_owned = support_points_.size() / dim;
+        return py::array_t<double>({n_owned, std::size_t(dim)},
+                                   {dim * sizeof(double), sizeof(double)},
+                                   support_points_.data(),
+                                   self);
+      }
+
+      /**
+       * Views into the boundary table: local indices, boundary ids, and
+       * normals of all boundary degrees of freedom.
+       */
+      py::tuple boundary_table(py::object self)
+      {
+        const auto &table = time_loop_.offline_data().boundary_table();
+        const std::size_t n = table.size();
+
+        static_assert(sizeof(typename decltype(table.normal)::value_type) ==
+                      dim * sizeof(NUMBER));
+        static_assert(sizeof(Boundary) == sizeof(dealii::types::boundary_id));
+
+        py::array_t<unsigned int> index({n}, {sizeof(unsigned int)},
+                                        table.index.data(),
+                                        self);
+        py::array_t<dealii::types::boundary_id> id(
+            {n},
+            {sizeof(dealii::types::boundary_id)},
+            reinterpret_cast<const dealii::types::boundary_id *>(
+                table.id.data()),
+            self);
+        py::array_t<NUMBER> normal({n, std::size_t(dim)},
+                                   {dim * sizeof(NUMBER), sizeof(NUMBER)},
+                                   reinterpret_cast<const NUMBER *>(
+                                       table.normal.data()),
+                                   self);
+        return py::make_tuple(index, id, normal);
+      }
+
+    private:
+      TimeLoop time_loop_;
+      vector_type U_;
+      double t_;
+      std::vector<double> support_points_;
+    };
+
+
+    template <typename Description, int dim>
+    void declare_simulation(py::module_ &m, const std::string &name)
+    {
+      using S = Simulation<Description, dim>;
+      py::class_<S>(m, name.c_str())
+          .def(py::init<const std::string &>(), py::arg("parameter_file"))
+          .def("prepare", &S::prepare)
+          .def("step", &S::step)
+          .def("advance", &S::advance, py::arg("t_end"))
+          .def("output", &S::output, py::arg("name"), py::arg("cycle"))
+          .def_property_readonly("time", &S::time)
+          .def("state",
+               [](py::object self) { return self.cast<S &>().state(self); })
+          .def("support_points",
+               [](py::object self) {
+                 return self.cast<S &>().support_points(self);
+               })
+          .def("boundary_table", [](py::object self) {
+            return self.cast<S &>().boundary_table(self);
+          });
+    }
+  } // namespace Python
+} // namespace ryujin
+
+
+PYBIND11_MODULE(ryujin_python, m)
+{
+  using namespace ryujin;
+  using namespace ryujin::Python;
+
+  m.doc() = "In-memory interface to the ryujin time loop";
+
+  /* Initialize MPI (if necessary) for the lifetime of the module: */
+  static std::unique_ptr<dealii::Utilities::MPI::MPI_InitFinalize> mpi;
+  int initialized = 0;
+  MPI_Initialized(&initialized);
+  if (!initialized) {
+    static int argc = 0;
+    static char **argv = nullptr;
+    mpi = std::make_unique<dealii::Utilities::MPI::MPI_InitFinalize>(
+        argc, argv, 1);
+  }
+
+#ifdef WITH_EQUATION_EULER
+  declare_simulation<Euler::Description, 1>(m, "Euler1D");
+  declare_simulation<Euler::Description, 2>(m, "Euler2D");
+  declare_simulation<Euler::Description, 3>(m, "Euler3D");
+#endif
+#ifdef WITH_EQUATION_EULER_AEOS
+  declare_simulation<EulerAEOS::Description, 1>(m, "EulerAEOS1D");
+  declare_simulation<EulerAEOS::Description, 2>(m, "EulerAEOS2D");
+  declare_simulation<EulerAEOS::Description, 3>(m, "EulerAEOS3D");
+#endif
+#ifdef WITH_EQUATION_NAVIER_STOKES
+  declare_simulation<NavierStokes::Description, 1>(m, "NavierStokes1D");
+  declare_simulation<NavierStokes::Description, 2>(m, "NavierStokes2D");
+  declare_simulation<NavierStokes::Description, 3>(m, "NavierStokes3D");
+#endif
+#ifdef WITH_EQUATION_SCALAR_CONSERVATION
+  declare_simulation<ScalarConservation::Description, 1>(
+      m, "ScalarConservation1D");
+  declare_simulation<ScalarConservation::Description, 2>(
+      m, "ScalarConservation2D");
+  declare_simulation<ScalarConservation::Description, 3>(
+      m, "ScalarConservation3D");
+#endif
+#ifdef WITH_EQUATION_SHALLOW_WATER
+  declare_simulation<ShallowWater::Description, 1>(m, "ShallowWater1D");
+  declare_simulation<ShallowWater::Description, 2>(m, "ShallowWater2D");
+  declare_simulation<ShallowWater::Description, 3>(m, "ShallowWater3D");
+#endif
+}
@@ -10,6 +10,7 @@
 #include "convenience_macros.h"
 #include "initial_values.h"
 #include "offline_data.h"
+#include "patterns_conversion.h"
 #include "simd.h"
 #include "sparse_matrix_simd.h"
 
@@ -19,6 +20,36 @@
 #include <deal.II/lac/sparse_matrix.templates.h>
 #include <deal.II/lac/vector.h>
 
+#include <fstream>
+
+namespace ryujin
+{
+  /**
+   * Controls the file format of space averaged time series written by
+   * the Quantities class.
+   */
+  enum class TimeSeriesFormat {
+    /**
+     * Human readable text output with one line per sample.
+     */
+    ascii,
+
+    /**
+     * Raw binary output. Every sample is stored as a contiguous record
+     * of (1 + 2 * n) numbers of type Number in native byte order: the
+     * time t, the n components of the primitive state, and the n second
+     * moments.
+     */
+    binary,
+  };
+} // namespace ryujin
+
+#ifndef DOXYGEN
+DECLARE_ENUM(ryujin::TimeSeriesFormat,
+             LIST({ryujin::TimeSeriesFormat::ascii, "ascii"},
+                  {ryujin::TimeSeriesFormat::binary, "binary"}));
+#endif
+
 namespace ryujin
 {
   /**
@@ -63,6 +94,11 @@ namespace ryujin
      */
     using vector_type = MultiComponentVector<Number, problem_dimension>;
 
+    /**
+     * @copydoc OfflineData::scalar_type
+     */
+    using scalar_type = typename OfflineData<dim, Number>::scalar_type;
+
     /**
      * Constructor.
      */
@@ -96,6 +132,21 @@ namespace ryujin
      */
     void write_out(const vector_type &U, const Number t, unsigned int cycle);
 
+    /**
+     * Return a boolean indicating whether full-field statistics of the
+     * primitive state are accumulated by accumulate().
+     */
+    ACCESSOR_READ_ONLY_NO_DEREFERENCE(full_field_statistics)
+
+    /**
+     * Return the full-field temporal mean and root mean square
+     * fluctuation of every component of the primitive state accumulated
+     * so far, as a vector of scalar fields named "<component>_mean" and
+     * "<component>_rms". The fields are suitable for
+     * VTUOutput::schedule_output().
+     */
+    std::vector<std::tuple<std::string, scalar_type>> field_statistics() const;
+
     //@}
 
   private:
@@ -112,6 +163,15 @@ namespace ryujin
 
     bool clear_temporal_statistics_on_writeout_;
 
+    TimeSeriesFormat time_series_format_;
+    unsigned int time_series_buffer_size_;
+
+    bool full_field_statistics_;
+
+    std::vector<std::tuple<std::string, std::string>> point_probe_sets_;
+
+    bool boundary_integrals_;
+
     //@}
     /**
      * @name Internal data
@@ -185,6 +245,25 @@ namespace ryujin
      */
     std::map<std::string, std::vector<interior_point>> interior_maps_;
 
+    /**
+     * A struct-of-arrays index of the probe points of a manifold storing
+     * the (local) dof indices and the associated (interior or boundary)
+     * masses contiguously, as well as the (local) sum of all masses. It
+     * is created from the interior and boundary maps in prepare() and
+     * used by accumulate().
+     */
+    struct ProbeIndex {
+      std::vector<unsigned int> indices;
+      std::vector<Number> masses;
+      Number mass_sum;
+    };
+
+    /**
+     * Probe indices of all interior and boundary manifolds.
+     */
+    std::map<std::string, ProbeIndex> interior_probes_;
+    std::map<std::string, ProbeIndex> boundary_probes_;
+
     /**
      * A tuple describing interior values we are interested in: the
      * primitive state and its second moment.
@@ -211,9 +290,81 @@ namespace ryujin
     std::map<std::string, std::vector<std::tuple<Number, interior_value>>>
         interior_time_series_;
 
+    /**
+     * Output streams for space averaged time series (only used on rank
+     * 0). The streams are kept open between calls to write_out() and
+     * use a user-provided buffer of "time series buffer size" samples.
+     */
+    struct TimeSeriesStream {
+      std::vector<char> buffer;
+      std::ofstream output;
+    };
+
+    std::map<std::string, TimeSeriesStream> time_series_streams_;
+
+    /**
+     * A point probe set located in prepare(): For every probe evaluated
+     * on this rank the probe number and an offset into the (local) dof
+     * indices and interpolation weights (the shape function values of
+     * the owning cell at the probe location with all constraints
+     * resolved), stored in compressed row format. Probes that could not
+     * be located on any rank are recorded (on rank 0) in @p missing.
+     */
+    struct PointProbeMap {
+      unsigned int n_probes;
+      std::vector<unsigned int> probe_numbers;
+      std::vector<unsigned int> offsets;
+      std::vector<unsigned int> indices;
+      std::vector<Number> weights;
+      std::vector<unsigned int> missing;
+    };
+
+    std::map<std::string, PointProbeMap> point_probe_maps_;
+
+    /**
+     * Sampled point probe values (only used on rank 0): a sequence of
+     * records consisting of the time t followed by the primitive state
+     * of all probes of the set.
+     */
+    std::map<std::string, std::vector<Number>> point_probe_samples_;
+
+    /**
+     * A flat index of all locally owned (and unconstrained) boundary
+     * degrees of freedom used for computing boundary integrals: the
+     * (local) dof index, boundary mass, normal, and boundary id. The
+     * vector @p active_ids holds all boundary ids that are present on
+     * any rank.
+     */
+    struct BoundaryIntegralIndex {
+      std::vector<unsigned int> indices;
+      std::vector<Number> masses;
+      std::vector<dealii::Tensor<1, dim, Number>> normals;
+      std::vector<dealii::types::boundary_id> ids;
+      std::vector<dealii::types::boundary_id> active_ids;
+    };
+
+    BoundaryIntegralIndex boundary_integral_index_;
+
+    /**
+     * Sampled boundary integrals (only used on rank 0): a sequence of
+     * records consisting of the time t followed by the integrals of all
+     * active boundary ids.
+     */
+    std::vector<Number> boundary_integral_samples_;
+
     std::string base_name_;
     unsigned int time_series_cycle_;
-    bool first_cycle_;
+
+    /**
+     * Full-field statistics: the time weighted running mean and the sum
+     * of weighted squared deviations from the mean (primitive state), the
+     * time of the last sample and the accumulated time.
+     */
+    vector_type field_mean_;
+    vector_type field_deviation_sum_;
+    bool field_statistics_initialized_;
+    Number field_t_old_;
+    Number field_t_sum_;
 
     //@}
     /**
@@ -223,11 +374,23 @@ namespace ryujin
 
     void clear_statistics();
 
+    void prepare_point_probes();
+
+    void accumulate_point_probes(const vector_type &U, const Number t);
+
+    void write_out_point_probes();
+
+    void prepare_boundary_integrals();
+
+    void accumulate_boundary_integrals(const vector_type &U, const Number t);
+
+    void write_out_boundary_integrals();
+
     std::string header_;
 
-    template <typename point_type, typename value_type>
+    template <typename value_type>
     value_type internal_accumulate(const vector_type &U,
-                                   const std::vector<point_type> &interior_map,
+                                   const ProbeIndex &probes,
                                    std::vector<value_type> &new_val);
 
     template <typename value_type>
@@ -15,8 +15,12 @@
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/work_stream.h>
 #include <deal.II/dofs/dof_tools.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
 
+#include <array>
 #include <fstream>
+#include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
 template <int rank, int dim, typename Number>
@@ -47,6 +51,61 @@ namespace ryujin
       Assert(it != manifolds.end(), dealii::ExcInternalError());
       return std::get<2>(*it);
     }
+
+
+    /*
+     * Read a list of points (one point with dim coordinates per line,
+     * text after a "#" is ignored) from the file @p file_name.
+     */
+    template <int dim>
+    std::vector<dealii::Point<dim>>
+    read_point_file(const std::string &file_name)
+    {
+      std::ifstream file(file_name);
+      AssertThrow(file,
+                  dealii::ExcMessage("Could not open point probe file \"" +
+                                     file_name + "\""));
+
+      std::vector<dealii::Point<dim>> points;
+      std::string line;
+      while (std::getline(file, line)) {
+        const auto comment = line.find('#');
+        if (comment != std::string::npos)
+          line.erase(comment);
+
+        std::istringstream stream(line);
+        dealii::Point<dim> point;
+        unsigned int d = 0;
+        while (d < dim && stream >> point[d])
+          ++d;
+
+        if (d == 0)
+          continue;
+        AssertThrow(d == dim,
+                    dealii::ExcMessage("Malformed line \"" + line +
+                                       "\" in point probe file \"" +
+                                       file_name + "\""));
+        points.push_back(point);
+      }
+
+      return points;
+    }
+
+
+    /*
+     * A type trait detecting whether a HyperbolicSystem::View provides a
+     * static momentum(U) function.
+     */
+    template <typename View, typename = void>
+    struct has_momentum : std::false_type {
+    };
+
+    template <typename View>
+    struct has_momentum<View,
+                        std::void_t<decltype(View::momentum(
+                            std::declval<typename View::state_type>()))>>
+        : std::true_type {
+    };
   } // namespace
 
 
@@ -62,7 +121,9 @@ namespace ryujin
       , offline_data_(&offline_data)
       , base_name_("")
       , time_series_cycle_(1)
-      , first_cycle_(true)
+      , field_statistics_initialized_(false)
+      , field_t_old_(0.)
+      , field_t_sum_(0.)
   {
 
     add_parameter("interior manifolds",
@@ -87,6 +148,49 @@ namespace ryujin
                   "If set to true then all temporal statistics (for "
                   "\"time_averaged\" quantities) accumulated so far are reset "
                   "each time a writeout of quantities is performed");
+
+    time_series_format_ = TimeSeriesFormat::ascii;
+    add_parameter("time series format",
+                  time_series_format_,
+                  "File format of space averaged time series: \"ascii\" "
+                  "(one line of text per sample), or \"binary\" (one record "
+                  "of 1 + 2 * n raw numbers per sample: time t, primitive "
+                  "state, and second moments)");
+
+    time_series_buffer_size_ = 0;
+    add_parameter("time series buffer size",
+                  time_series_buffer_size_,
+                  "Number of samples of space averaged time series that are "
+                  "buffered in memory before they are written to disk in a "
+                  "single block. If set to 0, time series are flushed to "
+                  "disk on every writeout");
+
+    full_field_statistics_ = false;
+    add_parameter("full field statistics",
+                  full_field_statistics_,
+                  "If set to true then the temporal mean and root mean "
+                  "square fluctuation of the primitive state are "
+                  "accumulated on the full field in every cycle. The "
+                  "statistics are reset whenever the mesh changes");
+
+    add_parameter("point probes",
+                  point_probe_sets_,
+                  "List of point probe sets at arbitrary coordinates. Each "
+                  "point file contains one point per line. The owning cells "
+                  "and interpolation weights of all probes are determined "
+                  "once whenever the mesh changes. The primitive state at "
+                  "all probes is sampled in every cycle and written as a "
+                  "time series in the chosen \"time series format\". "
+                  "Format: '<name> : <point file> , [...]'");
+
+    boundary_integrals_ = false;
+    add_parameter("boundary integrals",
+                  boundary_integrals_,
+                  "If set to true then the boundary integrals of the normal "
+                  "mass flux and of every primitive component times the "
+                  "normal (e.g., the pressure force) are computed per "
+                  "boundary id in every cycle and written as a compact time "
+                  "series in the chosen \"time series format\"");
   }
 
 
@@ -100,7 +204,9 @@ namespace ryujin
 
     base_name_ = name;
     time_series_cycle_ = cycle;
-    first_cycle_ = true;
+
+    /* Close (and flush) all time series streams of the last cycle: */
+    time_series_streams_.clear();
 
     const unsigned int n_owned = offline_data_->n_locally_owned();
 
@@ -120,63 +226,23 @@ namespace ryujin
           FunctionParser<dim> level_set_function(expression);
 
           std::vector<interior_point> map;
-          std::map<int, interior_point> preliminary_map;
 
-          const auto &discretization = offline_data_->discretization();
-          const auto &dof_handler = offline_data_->dof_handler();
-
-          const unsigned int dofs_per_cell = dof_handler.get_fe().dofs_per_cell;
-
-          const auto support_points =
-              dof_handler.get_fe().get_unit_support_points();
-
-          std::vector<dealii::types::global_dof_index> local_dof_indices(
-              dofs_per_cell);
-
-          /* Loop over cells */
-          for (auto cell : dof_handler.active_cell_iterators()) {
+          /*
+           * Evaluate the level set function exactly once for every locally
+           * owned degree of freedom. The support points are cached by
+           * OfflineData and traversed in ascending index order:
+           */
+          const auto &support_points =
+              offline_data_->locally_owned_support_points();
+          const auto &lumped_mass_matrix = offline_data_->lumped_mass_matrix();
 
-            /* skip if not locally owned */
-            if (!cell->is_locally_owned())
+          for (unsigned int index = 0; index < n_owned; ++index) {
+            const auto &position = support_points[index];
+            if (std::abs(level_set_function.value(position)) > 1.e-12)
               continue;
 
-            cell->get_active_or_mg_dof_indices(local_dof_indices);
-
-            for (unsigned int j = 0; j < dofs_per_cell; ++j) {
-
-              Point<dim> position =
-                  discretization.mapping().transform_unit_to_real_cell(
-                      cell, support_points[j]);
-
-              /*
-               * Insert index, interior mass value and position into
-               * a preliminary map if we satisfy level set condition.
-               */
-
-              if (std::abs(level_set_function.value(position)) > 1.e-12)
-                continue;
-
-              const auto global_index = local_dof_indices[j];
-              const auto index =
-                  offline_data_->scalar_partitioner()->global_to_local(
-                      global_index);
-
-              if (index >= n_owned)
-                continue;
-
-              const Number interior_mass =
-                  offline_data_->lumped_mass_matrix().local_element(index);
-              // FIXME: change to std::set
-              preliminary_map[index] = {index, interior_mass, position};
-            }
-          }
-
-          /*
-           * Now we populate the std::vector(interior_point) object called map.
-           */
-          // FIXME: use std::copy
-          for (const auto &[index, tuple] : preliminary_map) {
-            map.push_back(tuple);
+            map.push_back(
+                {index, lumped_mass_matrix.local_element(index), position});
           }
 
           return std::make_pair(name, map);
@@ -310,9 +376,55 @@ namespace ryujin
       }
     }
 
+    /*
+     * Create probe indices:
+     */
+
+    const auto create_probes = [](const auto &point_maps, auto &probes) {
+      probes.clear();
+      for (const auto &[name, point_map] : point_maps) {
+        /*
+         * Small trick to get the correct index for retrieving the
+         * interior or boundary mass:
+         */
+        using point_type =
+            typename std::decay_t<decltype(point_map)>::value_type;
+        constexpr auto index =
+            std::is_same<point_type, interior_point>::value ? 1 : 3;
+
+        auto &[indices, masses, mass_sum] = probes[name];
+        indices.reserve(point_map.size());
+        masses.reserve(point_map.size());
+        mass_sum = Number(0.);
+        for (const auto &point : point_map) {
+          indices.push_back(std::get<0>(point));
+          masses.push_back(std::get<index>(point));
+          mass_sum += std::get<index>(point);
+        }
+      }
+    };
+
+    create_probes(interior_maps_, interior_probes_);
+    create_probes(boundary_maps_, boundary_probes_);
+
+    prepare_point_probes();
+    prepare_boundary_integrals();
+
     /* Clear statistics: */
     clear_statistics();
 
+    /* Allocate and reset full-field statistics: */
+    if (full_field_statistics_) {
+      field_mean_.reinit(offline_data_->vector_partitioner());
+      field_deviation_sum_.reinit(offline_data_->vector_partitioner());
+    } else {
+      field_mean_.reinit(0);
+      field_deviation_sum_.reinit(0);
+    }
+    field_statistics_initialized_ = false;
+    field_t_old_ = Number(0.);
+    field_t_sum_ = Number(0.);
+
     /* Prepare header string: */
     const auto &names = HyperbolicSystemView::primitive_component_names;
     header_ =
@@ -356,58 +468,536 @@ namespace ryujin
 
 
   template <typename Description, int dim, typename Number>
-  template <typename point_type, typename value_type>
+  void Quantities<Description, dim, Number>::prepare_point_probes()
+  {
+    point_probe_maps_.clear();
+    point_probe_samples_.clear();
+
+    if (point_probe_sets_.empty())
+      return;
+
+    const auto &discretization = offline_data_->discretization();
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto &finite_element = dof_handler.get_fe();
+    const auto &scalar_partitioner = offline_data_->scalar_partitioner();
+    const auto &affine_constraints = offline_data_->affine_constraints();
+
+    const unsigned int dofs_per_cell = finite_element.dofs_per_cell;
+    std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
+
+    const unsigned int this_rank =
+        Utilities::MPI::this_mpi_process(mpi_communicator_);
+
+    /*
+     * The cache holds a bounding box tree of all (locally relevant) cells
+     * that is used for locating the probes:
+     */
+    GridTools::Cache<dim> cache(discretization.triangulation(),
+                                discretization.mapping());
+
+    for (const auto &[name, file_name] : point_probe_sets_) {
+      const auto points = read_point_file<dim>(file_name);
+      const unsigned int n_probes = points.size();
+
+      auto &map = point_probe_maps_[name];
+      map.n_probes = n_probes;
+      map.offsets.push_back(0);
+
+      /*
+       * Locate all probes in locally owned cells. A probe on an interface
+       * between two MPI ranks is found by both ranks, we assign it to the
+       * one with the smallest rank:
+       */
+
+      using cell_type = typename Triangulation<dim>::active_cell_iterator;
+      std::vector<std::pair<cell_type, Point<dim>>> located(n_probes);
+      std::vector<unsigned int> local_owner(n_probes,
+                                            numbers::invalid_unsigned_int);
+
+      cell_type hint = discretization.triangulation().begin_active();
+      for (unsigned int k = 0; k < n_probes; ++k) {
+        located[k] =
+            GridTools::find_active_cell_around_point(cache, points[k], hint);
+        const auto &cell = located[k].first;
+        if (cell.state() != IteratorState::valid || !cell->is_locally_owned())
+          continue;
+        local_owner[k] = this_rank;
+        hint = cell;
+      }
+
+      std::vector<unsigned int> owner(n_probes);
+      Utilities::MPI::min(ArrayView<const unsigned int>(local_owner),
+                          mpi_communicator_,
+                          ArrayView<unsigned int>(owner));
+
+      /*
+       * Tabulate interpolation weights. Constrained degrees of freedom
+       * are replaced by the degrees of freedom they are constrained to so
+       * that sampling only requires a weighted gather of the state:
+       */
+
+      const auto add_entry = [&](const dealii::types::global_dof_index global,
+                                 const Number weight) {
+        AssertThrow(scalar_partitioner->in_local_range(global) ||
+                        scalar_partitioner->is_ghost_entry(global),
+                    dealii::ExcMessage("Interpolation stencil of a point "
+                                       "probe is not locally relevant"));
+        map.indices.push_back(scalar_partitioner->global_to_local(global));
+        map.weights.push_back(weight);
+      };
+
+      for (unsigned int k = 0; k < n_probes; ++k) {
+        if (owner[k] == numbers::invalid_unsigned_int) {
+          if (this_rank == 0)
+            map.missing.push_back(k);
+          continue;
+        }
+
+        if (owner[k] != this_rank)
+          continue;
+
+        const auto &[cell, unit_point] = located[k];
+        typename DoFHandler<dim>::active_cell_iterator dof_cell(
+            &discretization.triangulation(),
+            cell->level(),
+            cell->index(),
+            &dof_handler);
+        dof_cell->get_dof_indices(dof_indices);
+
+        for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+          const Number weight = finite_element.shape_value(j, unit_point);
+          if (std::abs(weight) < std::numeric_limits<Number>::epsilon())
+            continue;
+
+          const auto global = dof_indices[j];
+          if (affine_constraints.is_constrained(global)) {
+            for (const auto &[index, factor] :
+                 *affine_constraints.get_constraint_entries(global))
+              add_entry(index, weight * Number(factor));
+          } else {
+            add_entry(global, weight);
+          }
+        }
+
+        map.probe_numbers.push_back(k);
+        map.offsets.push_back(map.indices.size());
+      }
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::accumulate_point_probes(
+      const vector_type &U, const Number t)
+  {
+    constexpr unsigned int n_components = primitive_state_type::dimension;
+
+    const auto view = hyperbolic_system_->template view<dim, Number>();
+
+    for (const auto &[name, map] : point_probe_maps_) {
+      const unsigned int n_local = map.probe_numbers.size();
+
+      /*
+       * Interpolate the state with a weighted gather on all locally
+       * evaluated probes and collect the primitive state of all probes
+       * with a single reduction:
+       */
+
+      std::vector<Number> local_values(map.n_probes * n_components, 0.);
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      RYUJIN_OMP_FOR
+      for (unsigned int k = 0; k < n_local; ++k) {
+        state_type U_k;
+        for (unsigned int l = map.offsets[k]; l < map.offsets[k + 1]; ++l)
+          U_k += map.weights[l] * U.get_tensor(map.indices[l]);
+
+        const auto primitive_state = view.to_primitive_state(U_k);
+        const auto offset = map.probe_numbers[k] * n_components;
+        for (unsigned int c = 0; c < n_components; ++c)
+          local_values[offset + c] = primitive_state[c];
+      }
+
+      RYUJIN_PARALLEL_REGION_END
+
+      std::vector<Number> values(local_values.size());
+      Utilities::MPI::sum(ArrayView<const Number>(local_values),
+                          mpi_communicator_,
+                          ArrayView<Number>(values));
+
+      if (Utilities::MPI::this_mpi_process(mpi_communicator_) != 0)
+        continue;
+
+      for (const auto k : map.missing)
+        for (unsigned int c = 0; c < n_components; ++c)
+          values[k * n_components + c] =
+              std::numeric_limits<Number>::quiet_NaN();
+
+      auto &samples = point_probe_samples_[name];
+      samples.push_back(t);
+      samples.insert(samples.end(), values.begin(), values.end());
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::write_out_point_probes()
+  {
+    if (Utilities::MPI::this_mpi_process(mpi_communicator_) != 0)
+      return;
+
+    constexpr unsigned int n_components = primitive_state_type::dimension;
+    const bool binary = (time_series_format_ == TimeSeriesFormat::binary);
+
+    for (const auto &[name, map] : point_probe_maps_) {
+      auto &samples = point_probe_samples_[name];
+
+      /*
+       * Open the stream on first use and keep it open for all subsequent
+       * writeouts:
+       */
+      auto [it, first_write] =
+          time_series_streams_.try_emplace(name + "-point_probes");
+      auto &output = it->second.output;
+
+      if (first_write) {
+        const auto file_name = base_name_ + "-" + name + "-R" +
+                               Utilities::to_string(time_series_cycle_, 4) +
+                               "-point_probes" + (binary ? ".bin" : ".dat");
+
+        output.open(file_name,
+                    binary ? std::ofstream::out | std::ofstream::trunc |
+                                 std::ofstream::binary
+                           : std::ofstream::out | std::ofstream::trunc);
+        output << std::scientific << std::setprecision(14);
+
+        if (!binary) {
+          const auto &names = HyperbolicSystemView::primitive_component_names;
+          output << "# time t\tprimitive state (";
+          for (unsigned int c = 0; c < n_components; ++c)
+            output << (c == 0 ? "" : ", ") << names[c];
+          output << ") of probes 0 to " << map.n_probes - 1 << "\n";
+        }
+      }
+
+      /* Every record consists of t followed by all probe values: */
+      const auto record_size = 1 + map.n_probes * n_components;
+      Assert(samples.size() % record_size == 0, dealii::ExcInternalError());
+
+      if (binary) {
+        output.write(reinterpret_cast<const char *>(samples.data()),
+                     samples.size() * sizeof(Number));
+      } else {
+        for (std::size_t k = 0; k < samples.size(); ++k)
+          output << samples[k] << ((k + 1) % record_size == 0 ? "\n" : "\t");
+      }
+
+      /* Leave flushing to the stream buffer for buffered output: */
+      if (time_series_buffer_size_ == 0)
+        output << std::flush;
+
+      samples.clear();
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::prepare_boundary_integrals()
+  {
+    boundary_integral_index_ = BoundaryIntegralIndex();
+    boundary_integral_samples_.clear();
+
+    if (!boundary_integrals_)
+      return;
+
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    auto &[indices, masses, normals, ids, active_ids] =
+        boundary_integral_index_;
+
+    /* Mark all boundary ids that are present on this rank: */
+    constexpr unsigned int n_ids = Boundary::dynamic + 1;
+    std::array<unsigned int, n_ids> local_present{};
+
+    for (const auto &entry : offline_data_->boundary_map()) {
+      /* skip nonlocal */
+      if (entry.first >= n_owned)
+        continue;
+
+      /* skip constrained */
+      if (offline_data_->affine_constraints().is_constrained(
+              offline_data_->scalar_partitioner()->local_to_global(
+                  entry.first)))
+        continue;
+
+      const auto &[normal, normal_mass, boundary_mass, id, position] =
+          entry.second;
+      indices.push_back(entry.first);
+      masses.push_back(boundary_mass);
+      normals.push_back(normal);
+      ids.push_back(id);
+      local_present[id] = 1;
+    }
+
+    std::array<unsigned int, n_ids> present;
+    Utilities::MPI::max(ArrayView<const unsigned int>(local_present),
+                        mpi_communicator_,
+                        ArrayView<unsigned int>(present));
+
+    for (unsigned int id = 0; id < n_ids; ++id)
+      if (present[id] != 0)
+        active_ids.push_back(id);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::accumulate_boundary_integrals(
+      const vector_type &U, const Number t)
+  {
+    if (!boundary_integrals_)
+      return;
+
+    using View = HyperbolicSystemView;
+    constexpr unsigned int n_components = primitive_state_type::dimension;
+    constexpr bool momentum = has_momentum<View>::value;
+    constexpr unsigned int n_integrals =
+        1 + (momentum ? 1 : 0) + n_components * dim;
+
+    constexpr unsigned int n_ids = Boundary::dynamic + 1;
+
+    const auto &[indices, masses, normals, ids, active_ids] =
+        boundary_integral_index_;
+    const unsigned int n_points = indices.size();
+
+    const auto view = hyperbolic_system_->template view<dim, Number>();
+
+    /*
+     * Compute all boundary integrals in a single parallel pass over all
+     * boundary degrees of freedom:
+     *
+     *   \int_{\Gamma_b} 1 ds,  \int_{\Gamma_b} m \cdot n ds,  and
+     *   \int_{\Gamma_b} w_c n ds  for every primitive component w_c.
+     *
+     * For the Euler equations the latter contains the pressure force
+     * \int p n ds on a wall:
+     */
+
+    std::vector<Number> local_values(n_ids * n_integrals, 0.);
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    std::vector<Number> thread_values(n_ids * n_integrals, 0.);
+
+    RYUJIN_OMP_FOR
+    for (unsigned int k = 0; k < n_points; ++k) {
+      const auto U_k = U.get_tensor(indices[k]);
+      const auto &n_k = normals[k];
+      const Number m_k = masses[k];
+
+      auto *values = thread_values.data() + ids[k] * n_integrals;
+      *values++ += m_k;
+
+      if constexpr (momentum)
+        *values++ += m_k * (View::momentum(U_k) * n_k);
+
+      const auto primitive_state = view.to_primitive_state(U_k);
+      for (unsigned int c = 0; c < n_components; ++c)
+        for (unsigned int d = 0; d < dim; ++d)
+          *values++ += m_k * primitive_state[c] * n_k[d];
+    }
+
+    RYUJIN_OMP_CRITICAL
+    {
+      for (unsigned int l = 0; l < local_values.size(); ++l)
+        local_values[l] += thread_values[l];
+    }
+
+    RYUJIN_PARALLEL_REGION_END
+
+    /* Synchronize MPI ranks with a single reduction: */
+
+    std::vector<Number> values(local_values.size());
+    Utilities::MPI::sum(ArrayView<const Number>(local_values),
+                        mpi_communicator_,
+                        ArrayView<Number>(values));
+
+    if (Utilities::MPI::this_mpi_process(mpi_communicator_) != 0)
+      return;
+
+    boundary_integral_samples_.push_back(t);
+    for (const auto id : active_ids)
+      boundary_integral_samples_.insert(boundary_integral_samples_.end(),
+                                        values.begin() + id * n_integrals,
+                                        values.begin() +
+                                            (id + 1) * n_integrals);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void Quantities<Description, dim, Number>::write_out_boundary_integrals()
+  {
+    if (!boundary_integrals_ ||
+        Utilities::MPI::this_mpi_process(mpi_communicator_) != 0)
+      return;
+
+    constexpr unsigned int n_components = primitive_state_type::dimension;
+    constexpr bool momentum = has_momentum<HyperbolicSystemView>::value;
+    const bool binary = (time_series_format_ == TimeSeriesFormat::binary);
+
+    /*
+     * Open the stream on first use and keep it open for all subsequent
+     * writeouts:
+     */
+    auto [it, first_write] =
+        time_series_streams_.try_emplace("boundary_integrals");
+    auto &output = it->second.output;
+
+    if (first_write) {
+      const auto file_name = base_name_ + "-boundary_integrals-R" +
+                             Utilities::to_string(time_series_cycle_, 4) +
+                             (binary ? ".bin" : ".dat");
+
+      output.open(file_name,
+                  binary ? std::ofstream::out | std::ofstream::trunc |
+                               std::ofstream::binary
+                         : std::ofstream::out | std::ofstream::trunc);
+      output << std::scientific << std::setprecision(14);
+
+      if (!binary) {
+        const auto &names = HyperbolicSystemView::primitive_component_names;
+        output << "# time t";
+        for (const auto id : boundary_integral_index_.active_ids) {
+          const auto prefix =
+              Patterns::Tools::Convert<Boundary>::to_string(Boundary(id));
+          output << "\t" << prefix << ":area";
+          if (momentum)
+            output << "\t" << prefix << ":mass_flux";
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int d = 0; d < dim; ++d)
+              output << "\t" << prefix << ":" << names[c] << "_n_" << d + 1;
+        }
+        output << "\n";
+      }
+    }
+
+    auto &samples = boundary_integral_samples_;
+
+    if (binary) {
+      output.write(reinterpret_cast<const char *>(samples.data()),
+                   samples.size() * sizeof(Number));
+    } else {
+      /* Every record consists of t followed by all integrals: */
+      const auto record_size =
+          1 + boundary_integral_index_.active_ids.size() *
+                  (1 + (momentum ? 1 : 0) + n_components * dim);
+      for (std::size_t k = 0; k < samples.size(); ++k)
+        output << samples[k] << ((k + 1) % record_size == 0 ? "\n" : "\t");
+    }
+
+    /* Leave flushing to the stream buffer for buffered output: */
+    if (time_series_buffer_size_ == 0)
+      output << std::flush;
+
+    samples.clear();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  template <typename value_type>
   value_type Quantities<Description, dim, Number>::internal_accumulate(
       const vector_type &U,
-      const std::vector<point_type> &points_vector,
+      const ProbeIndex &probes,
       std::vector<value_type> &val_new)
   {
+    using VA = VectorizedArray<Number>;
+    constexpr auto simd_length = VA::size();
+
+    const auto &[indices, masses, mass_sum] = probes;
+    const unsigned int n_points = indices.size();
+    const unsigned int n_vectorized = n_points - n_points % simd_length;
+
+    Assert(val_new.size() == n_points, dealii::ExcInternalError());
+
     value_type spatial_average;
-    Number mass_sum = Number(0.);
 
-    std::transform(
-        points_vector.begin(),
-        points_vector.end(),
-        val_new.begin(),
-        [&](auto point) -> value_type {
-          const auto i = std::get<0>(point);
-          /*
-           * Small trick to get the correct index for retrieving the
-           * boundary mass.
-           */
-          constexpr auto index =
-              std::is_same<point_type, interior_point>::value ? 1 : 3;
-          const auto mass_i = std::get<index>(point);
+    RYUJIN_PARALLEL_REGION_BEGIN
 
-          const auto U_i = U.get_tensor(i);
-          const auto view = hyperbolic_system_->template view<dim, Number>();
-          const auto primitive_state = view.to_primitive_state(U_i);
+    /* Stored thread locally: */
+    value_type local_average;
 
-          value_type result;
-          std::get<0>(result) = primitive_state;
-          /* Compute second moments of the primitive state: */
-          std::get<1>(result) = schur_product(primitive_state, primitive_state);
+    auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+      using T = decltype(sentinel);
+      using View = typename HyperbolicSystem::template View<dim, T>;
+      unsigned int stride_size = get_stride_size<T>;
 
-          mass_sum += mass_i;
-          std::get<0>(spatial_average) += mass_i * std::get<0>(result);
-          std::get<1>(spatial_average) += mass_i * std::get<1>(result);
+      const auto view = hyperbolic_system_->template view<dim, T>();
 
-          return result;
-        });
+      typename View::primitive_state_type state_sum;
+      typename View::primitive_state_type state_square_sum;
+
+      RYUJIN_OMP_FOR
+      for (unsigned int k = left; k < right; k += stride_size) {
+        const auto U_k = U.template get_tensor<T>(indices.data() + k);
+        const auto mass_k = load_value<T>(masses, k);
 
-    /* synchronize MPI ranks (MPI Barrier): */
+        const auto primitive_state = view.to_primitive_state(U_k);
+        /* Compute second moments of the primitive state: */
+        const auto state_square =
+            schur_product(primitive_state, primitive_state);
 
-    mass_sum = Utilities::MPI::sum(mass_sum, mpi_communicator_);
+        state_sum += mass_k * primitive_state;
+        state_square_sum += mass_k * state_square;
 
-    std::get<0>(spatial_average) =
-        Utilities::MPI::sum(std::get<0>(spatial_average), mpi_communicator_);
-    std::get<1>(spatial_average) =
-        Utilities::MPI::sum(std::get<1>(spatial_average), mpi_communicator_);
+        for (unsigned int l = 0; l < stride_size; ++l) {
+          auto &[state_l, state_square_l] = val_new[k + l];
+          state_l = serialize_tensor(primitive_state, l);
+          state_square_l = serialize_tensor(state_square, l);
+        }
+      }
+
+      for (unsigned int l = 0; l < stride_size; ++l) {
+        std::get<0>(local_average) += serialize_tensor(state_sum, l);
+        std::get<1>(local_average) += serialize_tensor(state_square_sum, l);
+      }
+    };
+
+    /* Parallel vectorized SIMD loop: */
+    loop(VA(), 0, n_vectorized);
+    /* Parallel non-vectorized loop: */
+    loop(Number(), n_vectorized, n_points);
+
+    RYUJIN_OMP_CRITICAL
+    {
+      std::get<0>(spatial_average) += std::get<0>(local_average);
+      std::get<1>(spatial_average) += std::get<1>(local_average);
+    }
+
+    RYUJIN_PARALLEL_REGION_END
+
+    /*
+     * Synchronize MPI ranks with a single reduction of the mass sum and
+     * the mass weighted primitive state and second moments (MPI Barrier):
+     */
+
+    constexpr unsigned int n_components = primitive_state_type::dimension;
+
+    std::vector<Number> local_values(2 * n_components + 1);
+    local_values[0] = mass_sum;
+    for (unsigned int c = 0; c < n_components; ++c) {
+      local_values[1 + c] = std::get<0>(spatial_average)[c];
+      local_values[1 + n_components + c] = std::get<1>(spatial_average)[c];
+    }
+
+    std::vector<Number> values(2 * n_components + 1);
+    Utilities::MPI::sum(local_values, mpi_communicator_, values);
 
     /* take average: */
 
-    std::get<0>(spatial_average) /= mass_sum;
-    std::get<1>(spatial_average) /= mass_sum;
+    for (unsigned int c = 0; c < n_components; ++c) {
+      std::get<0>(spatial_average)[c] = values[1 + c] / values[0];
+      std::get<1>(spatial_average)[c] =
+          values[1 + n_components + c] / values[0];
+    }
 
     return spatial_average;
   }
@@ -455,17 +1045,35 @@ namespace ryujin
   {
     if (Utilities::MPI::this_mpi_process(mpi_communicator_) == 0) {
 
-      if (!append)
-        output << "# time t\t" << header_;
+      if (time_series_format_ == TimeSeriesFormat::binary) {
+        for (const auto &entry : values) {
+          const auto t = std::get<0>(entry);
+          const auto &[state, state_square] = std::get<1>(entry);
+
+          output.write(reinterpret_cast<const char *>(&t), sizeof(Number));
+          output.write(reinterpret_cast<const char *>(state.begin_raw()),
+                       state.n_independent_components * sizeof(Number));
+          output.write(
+              reinterpret_cast<const char *>(state_square.begin_raw()),
+              state_square.n_independent_components * sizeof(Number));
+        }
+
+      } else {
+
+        if (!append)
+          output << "# time t\t" << header_;
 
-      for (const auto &entry : values) {
-        const auto t = std::get<0>(entry);
-        const auto &[state, state_square] = std::get<1>(entry);
+        for (const auto &entry : values) {
+          const auto t = std::get<0>(entry);
+          const auto &[state, state_square] = std::get<1>(entry);
 
-        output << t << "\t" << state << "\t" << state_square << "\n";
+          output << t << "\t" << state << "\t" << state_square << "\n";
+        }
       }
 
-      output << std::flush;
+      /* Leave flushing to the stream buffer for buffered output: */
+      if (time_series_buffer_size_ == 0)
+        output << std::flush;
     }
   }
 
@@ -478,11 +1086,11 @@ namespace ryujin
     std::cout << "Quantities<dim, Number>::accumulate()" << std::endl;
 #endif
 
-    const auto accumulate = [&](const auto &point_maps,
+    const auto accumulate = [&](const auto &probe_maps,
                                 const auto &manifolds,
                                 auto &statistics,
                                 auto &time_series) {
-      for (const auto &[name, point_map] : point_maps) {
+      for (const auto &[name, probes] : probe_maps) {
 
         /* Find the correct option string in manifolds */
         const auto &options = get_options_from_name(manifolds, name);
@@ -500,7 +1108,7 @@ namespace ryujin
 
         /* accumulate new values */
 
-        const auto spatial_average = internal_accumulate(U, point_map, val_new);
+        const auto spatial_average = internal_accumulate(U, probes, val_new);
 
         /* Average in time with trapezoidal rule: */
 
@@ -528,15 +1136,122 @@ namespace ryujin
       }
     };
 
-    accumulate(interior_maps_,
+    accumulate(interior_probes_,
                interior_manifolds_,
                interior_statistics_,
                interior_time_series_);
 
-    accumulate(boundary_maps_,
+    accumulate(boundary_probes_,
                boundary_manifolds_,
                boundary_statistics_,
                boundary_time_series_);
+
+    accumulate_point_probes(U, t);
+    accumulate_boundary_integrals(U, t);
+
+    if (!full_field_statistics_)
+      return;
+
+    /*
+     * Update the full-field statistics with a weighted variant of
+     * Welford's algorithm: Every sample U(t) is weighted with the time
+     * step size tau = t - t_old. In contrast to accumulating plain sums
+     * of the state and its square this avoids catastrophic cancellation
+     * when computing the fluctuation, which matters for long averaging
+     * windows and single precision builds.
+     */
+
+    if (RYUJIN_UNLIKELY(!field_statistics_initialized_)) {
+      /* We have not accumulated any statistics yet: */
+      field_statistics_initialized_ = true;
+      field_t_old_ = t;
+      return;
+    }
+
+    const Number tau = t - field_t_old_;
+    if (tau <= Number(0.))
+      return;
+
+    field_t_old_ = t;
+    field_t_sum_ += tau;
+    const Number weight = tau / field_t_sum_;
+
+    using VA = VectorizedArray<Number>;
+    constexpr auto simd_length = VA::size();
+
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+    const unsigned int n_regular = n_owned / simd_length * simd_length;
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+      using T = decltype(sentinel);
+      unsigned int stride_size = get_stride_size<T>;
+
+      const auto view = hyperbolic_system_->template view<dim, T>();
+
+      RYUJIN_OMP_FOR
+      for (unsigned int i = left; i < right; i += stride_size) {
+        const auto U_i = U.template get_tensor<T>(i);
+        const auto primitive_state = view.to_primitive_state(U_i);
+
+        auto mean = field_mean_.template get_tensor<T>(i);
+        auto deviation_sum = field_deviation_sum_.template get_tensor<T>(i);
+
+        const auto delta = primitive_state - mean;
+        mean += weight * delta;
+        deviation_sum += tau * schur_product(delta, primitive_state - mean);
+
+        field_mean_.template write_tensor<T>(mean, i);
+        field_deviation_sum_.template write_tensor<T>(deviation_sum, i);
+      }
+    };
+
+    /* Parallel vectorized SIMD loop: */
+    loop(VA(), 0, n_regular);
+    /* Parallel non-vectorized loop: */
+    loop(Number(), n_regular, n_owned);
+
+    RYUJIN_PARALLEL_REGION_END
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  auto Quantities<Description, dim, Number>::field_statistics() const
+      -> std::vector<std::tuple<std::string, scalar_type>>
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "Quantities<dim, Number>::field_statistics()" << std::endl;
+#endif
+
+    std::vector<std::tuple<std::string, scalar_type>> result;
+    if (!full_field_statistics_)
+      return result;
+
+    const auto &scalar_partitioner = offline_data_->scalar_partitioner();
+    const auto &names = HyperbolicSystemView::primitive_component_names;
+    const unsigned int n_owned = offline_data_->n_locally_owned();
+
+    for (unsigned int k = 0; k < problem_dimension; ++k) {
+      scalar_type mean(scalar_partitioner);
+      field_mean_.extract_component(mean, k);
+
+      /* Convert the sum of weighted squared deviations into a rms: */
+      scalar_type rms(scalar_partitioner);
+      field_deviation_sum_.extract_component(rms, k);
+      for (unsigned int i = 0; i < n_owned; ++i) {
+        const Number deviation_sum = std::max(rms.local_element(i), Number(0.));
+        rms.local_element(i) = field_t_sum_ > Number(0.)
+                                   ? std::sqrt(deviation_sum / field_t_sum_)
+                                   : Number(0.);
+      }
+      rms.update_ghost_values();
+
+      result.emplace_back(std::string(names[k]) + "_mean", std::move(mean));
+      result.emplace_back(std::string(names[k]) + "_rms", std::move(rms));
+    }
+
+    return result;
   }
 
 
@@ -549,11 +1264,11 @@ namespace ryujin
     std::cout << "Quantities<dim, Number>::write_out()" << std::endl;
 #endif
 
-    const auto write_out = [&](const auto &point_maps,
+    const auto write_out = [&](const auto &probe_maps,
                                const auto &manifolds,
                                auto &statistics,
                                auto &time_series) {
-      for (const auto &[name, point_map] : point_maps) {
+      for (const auto &[name, probes] : probe_maps) {
 
         /* Find the correct option string in manifolds */
         const auto &options = get_options_from_name(manifolds, name);
@@ -574,7 +1289,7 @@ namespace ryujin
 
           if (options.find("time_averaged") == std::string::npos &&
               options.find("space_averaged") == std::string::npos)
-            internal_accumulate(U, point_map, val_new);
+            internal_accumulate(U, probes, val_new);
           else
             AssertThrow(t_new == t, dealii::ExcInternalError());
 
@@ -612,22 +1327,41 @@ namespace ryujin
 
           auto &series = time_series[name];
 
-          std::ofstream output;
-          const auto file_name = base_name_ + "-" + name + "-R" +
-                                 Utilities::to_string(time_series_cycle_, 4) +
-                                 "-space_averaged_time_series.dat";
-
-          output << std::scientific << std::setprecision(14);
-
-          if (first_cycle_) {
-            first_cycle_ = false;
-            output.open(file_name, std::ofstream::out | std::ofstream::trunc);
-            internal_write_out_time_series(output, series, /*append*/ false);
-
-          } else {
+          if (Utilities::MPI::this_mpi_process(mpi_communicator_) == 0) {
+            const bool binary =
+                (time_series_format_ == TimeSeriesFormat::binary);
+
+            /*
+             * Open the stream on first use and keep it open for all
+             * subsequent writeouts:
+             */
+            auto [it, first_write] = time_series_streams_.try_emplace(name);
+            auto &[buffer, output] = it->second;
+
+            if (first_write) {
+              const auto file_name =
+                  base_name_ + "-" + name + "-R" +
+                  Utilities::to_string(time_series_cycle_, 4) +
+                  "-space_averaged_time_series" + (binary ? ".bin" : ".dat");
+
+              if (time_series_buffer_size_ != 0) {
+                constexpr auto record_size =
+                    (1 + 2 * primitive_state_type::n_independent_components) *
+                    sizeof(Number);
+                /* Generous line length for ascii output: */
+                buffer.resize(time_series_buffer_size_ * record_size *
+                              (binary ? 1 : 3));
+                output.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+              }
+
+              output.open(file_name,
+                          binary ? std::ofstream::out | std::ofstream::trunc |
+                                       std::ofstream::binary
+                                 : std::ofstream::out | std::ofstream::trunc);
+              output << std::scientific << std::setprecision(14);
+            }
 
-            output.open(file_name, std::ofstream::out | std::ofstream::app);
-            internal_write_out_time_series(output, series, /*append*/ true);
+            internal_write_out_time_series(output, series, !first_write);
           }
 
           series.clear();
@@ -635,16 +1369,19 @@ namespace ryujin
       }
     };
 
-    write_out(interior_maps_,
+    write_out(interior_probes_,
               interior_manifolds_,
               interior_statistics_,
               interior_time_series_);
 
-    write_out(boundary_maps_,
+    write_out(boundary_probes_,
               boundary_manifolds_,
               boundary_statistics_,
               boundary_time_series_);
 
+    write_out_point_probes();
+    write_out_boundary_integrals();
+
     if (clear_temporal_statistics_on_writeout_)
       clear_statistics();
   }
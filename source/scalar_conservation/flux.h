@@ -9,6 +9,7 @@
 
 #include "convenience_macros.h"
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/function.h>
 #include <deal.II/base/parameter_acceptor.h>
 
@@ -42,6 +43,7 @@ namespace ryujin
       {
         derivative_approximation_delta_ =
             1.e4 * std::numeric_limits<double>::epsilon();
+        convex_ = false;
       }
 
 
@@ -52,12 +54,46 @@ namespace ryujin
       virtual double value(double state, unsigned int direction) const = 0;
 
 
+      /**
+       * Variant of above function operating on a contiguous range of
+       * states. The result is stored in the first argument @p result,
+       * overriding previous contents.
+       */
+      virtual void value(const dealii::ArrayView<double> &result,
+                         const dealii::ArrayView<const double> &state,
+                         const unsigned int direction) const
+      {
+        Assert(result.size() == state.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < state.size(); ++k)
+          result[k] = value(state[k], direction);
+      }
+
+
       /**
        * Return the gradient f'(u) of the flux for the given state @p u and
        * direction @p direction.
        */
       virtual double gradient(double state, unsigned int direction) const = 0;
 
+
+      /**
+       * Variant of above function operating on a contiguous range of
+       * states. The result is stored in the first argument @p result,
+       * overriding previous contents.
+       */
+      virtual void gradient(const dealii::ArrayView<double> &result,
+                            const dealii::ArrayView<const double> &state,
+                            const unsigned int direction) const
+      {
+        Assert(result.size() == state.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        for (unsigned int k = 0; k < state.size(); ++k)
+          result[k] = gradient(state[k], direction);
+      }
+
       /**
        * The name of the flux function
        */
@@ -76,6 +112,16 @@ namespace ryujin
        */
       ACCESSOR_READ_ONLY(derivative_approximation_delta)
 
+      /**
+       * Return true if the projected flux f(u) * n is convex (or concave)
+       * in u for every direction n. For such fluxes the derivative of the
+       * projected flux is monotone and the maximal wavespeed of the 1D
+       * Riemann problem is attained at one of the two states, see Example
+       * 79.17 in @cite ErnGuermond2021. The Riemann solver then reduces
+       * to an evaluation of the flux gradient at both endpoints.
+       */
+      ACCESSOR_READ_ONLY(convex)
+
       /**
        * A string showing a detailed formula of the chosen flux function
        * (such as "f(u)=0.5*u*u").
@@ -84,6 +130,7 @@ namespace ryujin
 
     protected:
       double derivative_approximation_delta_;
+      bool convex_;
       std::string flux_formula_;
 
     private:
@@ -23,6 +23,8 @@ namespace ryujin
           : Flux("burgers", subsection)
       {
         flux_formula_ = "f(u)={0.5u^2}";
+        /* f(u) * n = 0.5 (n_1 + ... + n_d) u^2 is convex or concave: */
+        convex_ = true;
       }
 
 
@@ -0,0 +1,429 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <deal.II/base/exceptions.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  namespace FluxLibrary
+  {
+    /**
+     * A small compiler for scalar function expressions \f$f(u)\f$ in the
+     * single variable "u". The expression is translated once into a
+     * program for a stack machine that is then evaluated on a whole batch
+     * of states at once: every instruction loops over the full batch, so
+     * that the interpreter overhead is paid only once per batch and the
+     * inner loops can be vectorized by the compiler.
+     *
+     * The supported syntax is a subset of the muparser syntax: the binary
+     * operators +, -, *, /, ^ (right associative), unary minus and plus,
+     * parentheses, floating point literals, the constants _pi and _e, the
+     * functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp,
+     * ln, log2, log10, sqrt, abs, sign, and the variadic functions min and
+     * max. compile() returns false for any other input, in which case the
+     * caller is expected to fall back to muparser.
+     *
+     * @ingroup ScalarConservation
+     */
+    class CompiledExpression
+    {
+    public:
+      /**
+       * Compile the given @p expression. Returns true on success, false
+       * otherwise. In the latter case the object is left empty.
+       */
+      bool compile(const std::string &expression)
+      {
+        program_.clear();
+        input_ = expression;
+        position_ = 0;
+        stack_depth_ = 0;
+        max_stack_depth_ = 0;
+
+        bool success = parse_expression();
+        skip_whitespace();
+        success = success && position_ == input_.size();
+
+        if (!success)
+          program_.clear();
+
+        Assert(!success || stack_depth_ == 1, dealii::ExcInternalError());
+        return success;
+      }
+
+      /**
+       * Return true if no program has been compiled.
+       */
+      bool empty() const
+      {
+        return program_.empty();
+      }
+
+      /**
+       * Evaluate the compiled expression for the @p n states stored in
+       * @p u and store the results in @p result.
+       *
+       * @note This function is not reentrant.
+       */
+      void evaluate(double *result, const double *u, const unsigned int n) const
+      {
+        Assert(!empty(), dealii::ExcMessage("No program has been compiled"));
+
+        thread_local static std::vector<double> stack;
+        stack.resize(max_stack_depth_ * n);
+
+        /* Return a pointer to the beginning of stack slot i: */
+        const auto slot = [&](unsigned int i) { return stack.data() + i * n; };
+
+        unsigned int top = 0;
+
+        const auto unary = [&](const auto &f) {
+          double *x = slot(top - 1);
+          for (unsigned int k = 0; k < n; ++k)
+            x[k] = f(x[k]);
+        };
+
+        const auto binary = [&](const auto &f) {
+          --top;
+          double *x = slot(top - 1);
+          const double *y = slot(top);
+          for (unsigned int k = 0; k < n; ++k)
+            x[k] = f(x[k], y[k]);
+        };
+
+        for (const auto &[op, value] : program_) {
+          switch (op) {
+          case OpCode::constant:
+            std::fill(slot(top), slot(top) + n, value);
+            ++top;
+            break;
+          case OpCode::variable:
+            std::copy(u, u + n, slot(top));
+            ++top;
+            break;
+          /* Binary operators: */
+          case OpCode::add:
+            binary([](double a, double b) { return a + b; });
+            break;
+          case OpCode::subtract:
+            binary([](double a, double b) { return a - b; });
+            break;
+          case OpCode::multiply:
+            binary([](double a, double b) { return a * b; });
+            break;
+          case OpCode::divide:
+            binary([](double a, double b) { return a / b; });
+            break;
+          case OpCode::power:
+            binary([](double a, double b) { return std::pow(a, b); });
+            break;
+          case OpCode::min:
+            binary([](double a, double b) { return std::min(a, b); });
+            break;
+          case OpCode::max:
+            binary([](double a, double b) { return std::max(a, b); });
+            break;
+          /* Unary operators and functions: */
+          case OpCode::negate:
+            unary([](double a) { return -a; });
+            break;
+          case OpCode::sin:
+            unary([](double a) { return std::sin(a); });
+            break;
+          case OpCode::cos:
+            unary([](double a) { return std::cos(a); });
+            break;
+          case OpCode::tan:
+            unary([](double a) { return std::tan(a); });
+            break;
+          case OpCode::asin:
+            unary([](double a) { return std::asin(a); });
+            break;
+          case OpCode::acos:
+            unary([](double a) { return std::acos(a); });
+            break;
+          case OpCode::atan:
+            unary([](double a) { return std::atan(a); });
+            break;
+          case OpCode::sinh:
+            unary([](double a) { return std::sinh(a); });
+            break;
+          case OpCode::cosh:
+            unary([](double a) { return std::cosh(a); });
+            break;
+          case OpCode::tanh:
+            unary([](double a) { return std::tanh(a); });
+            break;
+          case OpCode::exp:
+            unary([](double a) { return std::exp(a); });
+            break;
+          case OpCode::ln:
+            unary([](double a) { return std::log(a); });
+            break;
+          case OpCode::log2:
+            unary([](double a) { return std::log2(a); });
+            break;
+          case OpCode::log10:
+            unary([](double a) { return std::log10(a); });
+            break;
+          case OpCode::sqrt:
+            unary([](double a) { return std::sqrt(a); });
+            break;
+          case OpCode::abs:
+            unary([](double a) { return std::abs(a); });
+            break;
+          case OpCode::sign:
+            unary([](double a) { return double((a > 0.) - (a < 0.)); });
+            break;
+          }
+        }
+
+        Assert(top == 1, dealii::ExcInternalError());
+        std::copy(stack.data(), stack.data() + n, result);
+      }
+
+    private:
+      enum class OpCode {
+        constant,
+        variable,
+        add,
+        subtract,
+        multiply,
+        divide,
+        power,
+        min,
+        max,
+        negate,
+        sin,
+        cos,
+        tan,
+        asin,
+        acos,
+        atan,
+        sinh,
+        cosh,
+        tanh,
+        exp,
+        ln,
+        log2,
+        log10,
+        sqrt,
+        abs,
+        sign,
+      };
+
+      struct Instruction {
+        OpCode op;
+        double value;
+      };
+
+      std::vector<Instruction> program_;
+      unsigned int max_stack_depth_ = 0;
+
+      /*
+       * Parser state, only used during compile():
+       */
+
+      std::string input_;
+      std::size_t position_ = 0;
+      unsigned int stack_depth_ = 0;
+
+      void emit(const OpCode op, const double value = 0.)
+      {
+        program_.push_back({op, value});
+
+        if (op == OpCode::constant || op == OpCode::variable)
+          ++stack_depth_;
+        else if (op < OpCode::negate)
+          --stack_depth_;
+
+        max_stack_depth_ = std::max(max_stack_depth_, stack_depth_);
+      }
+
+      void skip_whitespace()
+      {
+        while (position_ < input_.size() &&
+               std::isspace(static_cast<unsigned char>(input_[position_])))
+          ++position_;
+      }
+
+      bool accept(const char c)
+      {
+        skip_whitespace();
+        if (position_ < input_.size() && input_[position_] == c) {
+          ++position_;
+          return true;
+        }
+        return false;
+      }
+
+      /* expression := term { ("+" | "-") term } */
+      bool parse_expression()
+      {
+        if (!parse_term())
+          return false;
+
+        for (;;) {
+          if (accept('+')) {
+            if (!parse_term())
+              return false;
+            emit(OpCode::add);
+          } else if (accept('-')) {
+            if (!parse_term())
+              return false;
+            emit(OpCode::subtract);
+          } else {
+            return true;
+          }
+        }
+      }
+
+      /* term := unary { ("*" | "/") unary } */
+      bool parse_term()
+      {
+        if (!parse_unary())
+          return false;
+
+        for (;;) {
+          if (accept('*')) {
+            if (!parse_unary())
+              return false;
+            emit(OpCode::multiply);
+          } else if (accept('/')) {
+            if (!parse_unary())
+              return false;
+            emit(OpCode::divide);
+          } else {
+            return true;
+          }
+        }
+      }
+
+      /* unary := ("-" | "+") unary | power */
+      bool parse_unary()
+      {
+        if (accept('-')) {
+          if (!parse_unary())
+            return false;
+          emit(OpCode::negate);
+          return true;
+        }
+
+        if (accept('+'))
+          return parse_unary();
+
+        return parse_power();
+      }
+
+      /* power := primary [ "^" unary ] */
+      bool parse_power()
+      {
+        if (!parse_primary())
+          return false;
+
+        if (accept('^')) {
+          if (!parse_unary())
+            return false;
+          emit(OpCode::power);
+        }
+
+        return true;
+      }
+
+      /* primary := number | identifier | function | "(" expression ")" */
+      bool parse_primary()
+      {
+        skip_whitespace();
+        if (position_ >= input_.size())
+          return false;
+
+        if (accept('('))
+          return parse_expression() && accept(')');
+
+        const char c = input_[position_];
+
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+          const char *begin = input_.c_str() + position_;
+          char *end = nullptr;
+          const double value = std::strtod(begin, &end);
+          if (end == begin)
+            return false;
+          position_ += end - begin;
+          emit(OpCode::constant, value);
+          return true;
+        }
+
+        if (!(std::isalpha(static_cast<unsigned char>(c)) || c == '_'))
+          return false;
+
+        const auto start = position_;
+        while (position_ < input_.size() &&
+               (std::isalnum(static_cast<unsigned char>(input_[position_])) ||
+                input_[position_] == '_'))
+          ++position_;
+        const auto name = input_.substr(start, position_ - start);
+
+        if (name == "u") {
+          emit(OpCode::variable);
+          return true;
+        }
+
+        if (name == "_pi") {
+          emit(OpCode::constant, M_PI);
+          return true;
+        }
+
+        if (name == "_e") {
+          emit(OpCode::constant, M_E);
+          return true;
+        }
+
+        if (name == "min" || name == "max") {
+          const auto op = (name == "min") ? OpCode::min : OpCode::max;
+          if (!accept('(') || !parse_expression())
+            return false;
+          while (accept(',')) {
+            if (!parse_expression())
+              return false;
+            emit(op);
+          }
+          return accept(')');
+        }
+
+        static const std::vector<std::pair<std::string, OpCode>> functions{
+            {"sin", OpCode::sin},     {"cos", OpCode::cos},
+            {"tan", OpCode::tan},     {"asin", OpCode::asin},
+            {"acos", OpCode::acos},   {"atan", OpCode::atan},
+            {"sinh", OpCode::sinh},   {"cosh", OpCode::cosh},
+            {"tanh", OpCode::tanh},   {"exp", OpCode::exp},
+            {"ln", OpCode::ln},       {"log2", OpCode::log2},
+            {"log10", OpCode::log10}, {"sqrt", OpCode::sqrt},
+            {"abs", OpCode::abs},     {"sign", OpCode::sign},
+        };
+
+        const auto it = std::find_if(
+            functions.begin(), functions.end(), [&](const auto &entry) {
+              return entry.first == name;
+            });
+        if (it == functions.end())
+          return false;
+
+        if (!accept('(') || !parse_expression() || !accept(')'))
+          return false;
+        emit(it->second);
+        return true;
+      }
+    };
+  } // namespace FluxLibrary
+} // namespace ryujin
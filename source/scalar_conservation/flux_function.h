@@ -6,13 +6,19 @@
 #pragma once
 
 #include "flux.h"
+#include "flux_expression.h"
 
 #include <deal.II/base/function_parser.h>
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <numeric>
+#include <string>
+#include <vector>
 
 namespace ryujin
 {
@@ -43,6 +49,55 @@ namespace ryujin
                       "Step size of the central difference quotient to compute "
                       "an approximation of the flux derivative");
 
+        this->convex_ = false;
+        add_parameter(
+            "convex",
+            this->convex_,
+            "Declare that the projected flux f(u) * n is convex (or concave) "
+            "in u for every direction n, for example if all components are "
+            "multiples of the same convex function. The Riemann solver then "
+            "computes the maximal wavespeed from the flux derivatives of the "
+            "two states alone");
+
+        compile_expression_ = false;
+        add_parameter(
+            "compile expression",
+            compile_expression_,
+            "Translate the flux expression once into a stack machine program "
+            "that is evaluated on whole SIMD batches instead of calling into "
+            "muparser for every single state. If the expression uses syntax "
+            "that is not supported by the expression compiler we fall back "
+            "to muparser.");
+
+        tabulate_ = false;
+        add_parameter(
+            "tabulate",
+            tabulate_,
+            "Sample the flux and its derivative once on a uniform table over "
+            "the state range given by \"table range\" and evaluate with "
+            "piecewise cubic Hermite interpolation. States outside of the "
+            "table range are evaluated directly.");
+
+        table_range_ = {0., 1.};
+        add_parameter("table range",
+                      table_range_,
+                      "Table: state range [u_min, u_max]. By the maximum "
+                      "principle this range is bounded by the minimum and "
+                      "maximum of the initial and boundary data");
+
+        table_size_ = 1024;
+        add_parameter("table size",
+                      table_size_,
+                      "Table: number of sampling points");
+
+        table_tolerance_ = 1.0e-8;
+        add_parameter(
+            "table tolerance",
+            table_tolerance_,
+            "Table: maximal admissible interpolation error of the flux, "
+            "estimated at the midpoints of all table intervals and relative "
+            "to the maximal magnitude of the flux");
+
         /*
          * Set up the muparser object with the final flux description from
          * the parameter file:
@@ -62,6 +117,22 @@ namespace ryujin
           flux_function_->initialize({"u"}, split_expressions, {});
 
           flux_formula_ = "f(u)={" + expression_ + "}";
+
+          compiled_flux_.clear();
+          if (compile_expression_) {
+            compiled_flux_.resize(size);
+            for (unsigned int k = 0; k < size; ++k)
+              if (!compiled_flux_[k].compile(split_expressions[k])) {
+                compiled_flux_.clear();
+                break;
+              }
+          }
+
+          n_components_ = size;
+          table_value_.clear();
+          table_gradient_.clear();
+          if (tabulate_)
+            set_up_table();
         };
 
         set_up_muparser();
@@ -72,19 +143,232 @@ namespace ryujin
       double value(const double state,
                    const unsigned int direction) const override
       {
+        double result;
+        if (!table_value_.empty() &&
+            table_lookup(&result, nullptr, state, direction))
+          return result;
+
+        if (!compiled_flux_.empty()) {
+          double result;
+          value(dealii::ArrayView<double>(&result, 1),
+                dealii::ArrayView<const double>(&state, 1),
+                direction);
+          return result;
+        }
+
         return flux_function_->value(dealii::Point<1>(state), direction);
       }
 
 
+      void value(const dealii::ArrayView<double> &result,
+                 const dealii::ArrayView<const double> &state,
+                 const unsigned int direction) const override
+      {
+        Assert(result.size() == state.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        if (!table_value_.empty()) {
+          for (unsigned int k = 0; k < state.size(); ++k)
+            if (!table_lookup(&result[k], nullptr, state[k], direction))
+              result[k] = value(state[k], direction);
+          return;
+        }
+
+        if (compiled_flux_.empty()) {
+          Flux::value(result, state, direction);
+          return;
+        }
+
+        compiled_flux_[direction].evaluate(
+            result.data(), state.data(), state.size());
+      }
+
+
       double gradient(const double state,
                       const unsigned int direction) const override
       {
+        double result;
+        if (!table_value_.empty() &&
+            table_lookup(nullptr, &result, state, direction))
+          return result;
+
+        if (!compiled_flux_.empty()) {
+          double result;
+          gradient(dealii::ArrayView<double>(&result, 1),
+                   dealii::ArrayView<const double>(&state, 1),
+                   direction);
+          return result;
+        }
+
         return flux_function_->gradient(dealii::Point<1>(state), direction)[0];
       }
 
 
+      /**
+       * We use the same central difference quotient as
+       * dealii::FunctionParser::gradient():
+       * \f{align}
+       *   f'(u) \approx \frac{f(u + h) - f(u - h)}{2h}
+       * \f}
+       */
+      void gradient(const dealii::ArrayView<double> &result,
+                    const dealii::ArrayView<const double> &state,
+                    const unsigned int direction) const override
+      {
+        Assert(result.size() == state.size(),
+               dealii::ExcMessage("vectors have different size"));
+
+        if (!table_value_.empty()) {
+          for (unsigned int k = 0; k < state.size(); ++k)
+            if (!table_lookup(nullptr, &result[k], state[k], direction))
+              result[k] = gradient(state[k], direction);
+          return;
+        }
+
+        if (compiled_flux_.empty()) {
+          Flux::gradient(result, state, direction);
+          return;
+        }
+
+        const auto n = state.size();
+        const auto h = this->derivative_approximation_delta_;
+
+        /* FIXME: this is not reentrant... */
+        thread_local static std::vector<double> u_plus;
+        thread_local static std::vector<double> u_minus;
+        u_plus.resize(n);
+        u_minus.resize(n);
+        for (unsigned int k = 0; k < n; ++k) {
+          u_plus[k] = state[k] + h;
+          u_minus[k] = state[k] - h;
+        }
+
+        const auto &program = compiled_flux_[direction];
+        program.evaluate(u_plus.data(), u_plus.data(), n);
+        program.evaluate(u_minus.data(), u_minus.data(), n);
+
+        for (unsigned int k = 0; k < n; ++k)
+          result[k] = (u_plus[k] - u_minus[k]) / (2. * h);
+      }
+
+
     private:
       std::string expression_;
+      bool compile_expression_;
+
+      std::vector<CompiledExpression> compiled_flux_;
+
+      bool tabulate_;
+      std::array<double, 2> table_range_;
+      unsigned int table_size_;
+      double table_tolerance_;
+
+      unsigned int n_components_;
+      double table_inverse_h_;
+
+      /*
+       * Sampled flux values and derivatives stored component by
+       * component, i.e., the sampling point k of component d is stored at
+       * index d * table_size_ + k.
+       */
+      std::vector<double> table_value_;
+      std::vector<double> table_gradient_;
+
+      /**
+       * Sample the flux and its derivative on a uniform table and verify
+       * the interpolation error at the midpoints of all intervals.
+       */
+      void set_up_table()
+      {
+        const auto [u_min, u_max] = table_range_;
+        AssertThrow(table_size_ >= 2 && u_min < u_max,
+                    dealii::ExcMessage("Invalid table range or table size"));
+
+        const double h = (u_max - u_min) / (table_size_ - 1);
+
+        /* Sample with table_value_ empty, i.e., by direct evaluation: */
+        std::vector<double> values(n_components_ * table_size_);
+        std::vector<double> gradients(n_components_ * table_size_);
+        for (unsigned int d = 0; d < n_components_; ++d)
+          for (unsigned int k = 0; k < table_size_; ++k) {
+            const double u = u_min + k * h;
+            values[d * table_size_ + k] = value(u, d);
+            gradients[d * table_size_ + k] = gradient(u, d);
+          }
+
+        /* Estimate the interpolation error on interval midpoints: */
+        std::vector<double> exact(n_components_ * (table_size_ - 1));
+        for (unsigned int d = 0; d < n_components_; ++d)
+          for (unsigned int k = 0; k + 1 < table_size_; ++k)
+            exact[d * (table_size_ - 1) + k] = value(u_min + (k + 0.5) * h, d);
+
+        table_inverse_h_ = 1. / h;
+        table_value_ = std::move(values);
+        table_gradient_ = std::move(gradients);
+
+        double max_error = 0.;
+        double max_value = 0.;
+        for (unsigned int d = 0; d < n_components_; ++d)
+          for (unsigned int k = 0; k + 1 < table_size_; ++k) {
+            double interpolated;
+            table_lookup(&interpolated, nullptr, u_min + (k + 0.5) * h, d);
+            const double reference = exact[d * (table_size_ - 1) + k];
+            max_error = std::max(max_error, std::abs(interpolated - reference));
+            max_value = std::max(max_value, std::abs(reference));
+          }
+
+        const double relative_error = max_error / std::max(max_value, 1.);
+        AssertThrow(relative_error <= table_tolerance_,
+                    dealii::ExcMessage(
+                        "The estimated relative interpolation error of the "
+                        "tabulated flux (" +
+                        std::to_string(relative_error) +
+                        ") exceeds the table tolerance. Increase the table "
+                        "size or reduce the table range."));
+      }
+
+      /**
+       * Evaluate the cubic Hermite interpolant of the tabulated flux
+       * (stored in @p value) and/or its derivative (stored in
+       * @p gradient) for a given @p state. Returns false if the state lies
+       * outside of the table range.
+       */
+      bool table_lookup(double *value,
+                        double *gradient,
+                        const double state,
+                        const unsigned int direction) const
+      {
+        const double x = (state - table_range_[0]) * table_inverse_h_;
+
+        /* Written such that NaN values fail the test: */
+        if (!(x >= 0. && x <= double(table_size_ - 1)))
+          return false;
+
+        const unsigned int k =
+            std::min(static_cast<unsigned int>(x), table_size_ - 2);
+        const double t = x - k;
+        const double h = 1. / table_inverse_h_;
+
+        const auto offset = direction * table_size_ + k;
+        const double f_0 = table_value_[offset];
+        const double f_1 = table_value_[offset + 1];
+        const double g_0 = h * table_gradient_[offset];
+        const double g_1 = h * table_gradient_[offset + 1];
+
+        if (value != nullptr) {
+          const double s = 1. - t;
+          *value = (1. + 2. * t) * s * s * f_0 + t * s * s * g_0 +
+                   t * t * (3. - 2. * t) * f_1 + t * t * (t - 1.) * g_1;
+        }
+
+        if (gradient != nullptr) {
+          const double d_f = 6. * t * (t - 1.) * table_inverse_h_;
+          *gradient = d_f * f_0 + (3. * t * t - 4. * t + 1.) * g_0 / h -
+                      d_f * f_1 + (3. * t * t - 2. * t) * g_1 / h;
+        }
+
+        return true;
+      }
 
       std::unique_ptr<dealii::FunctionParser<1>> flux_function_;
     };
@@ -129,6 +129,11 @@ namespace ryujin
           return ScalarNumber(flux->derivative_approximation_delta());
         }
 
+        DEAL_II_ALWAYS_INLINE inline bool riemann_solver_convex_flux() const
+        {
+          return hyperbolic_system_.selected_flux_->convex();
+        }
+
         //@}
         /**
          * @name Low-level access to the flux function parser:
@@ -241,11 +246,24 @@ namespace ryujin
         static inline const auto precomputed_initial_names =
             std::array<std::string, n_precomputed_initial_values>{};
 
+        /**
+         * The number of precomputed (time-independent) edge values.
+         */
+        static constexpr unsigned int n_precomputed_edge_values = 0;
+
         /**
          * The number of precomputed values.
          */
         static constexpr unsigned int n_precomputed_values = 2. * dim;
 
+        /**
+         * Set to true if the approximate Riemann solver computes the
+         * maximal wave speed from precomputed values. Such values must
+         * not be exchanged with reduced precision because rounding
+         * could underestimate the wave speed.
+         */
+        static constexpr bool wave_speed_uses_precomputed_values = true;
+
         /**
          * Array type used for precomputed values.
          */
@@ -431,6 +449,13 @@ namespace ryujin
         high_order_flux(const flux_contribution_type &,
                         const flux_contribution_type &) const = delete;
 
+        /**
+         * The low-order update is formed with the states U_i and U_j
+         * directly, and the limiter bounds are not shifted (see
+         * ShallowWater::HyperbolicSystem::View::have_equilibrated_states):
+         */
+        static constexpr bool have_equilibrated_states = false;
+
         //@}
         /**
          * @name Computing stencil source terms
@@ -613,14 +638,25 @@ namespace ryujin
       const auto &flux = hyperbolic_system_.selected_flux_;
       dealii::Tensor<1, dim, Number> result;
 
-      /* This access by calling into value() repeatedly is terrible: */
-      for (unsigned int k = 0; k < dim; ++k) {
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        for (unsigned int k = 0; k < dim; ++k)
           result[k] = flux->value(u, k);
-        } else {
-          for (unsigned int s = 0; s < Number::size(); ++s) {
-            result[k][s] = flux->value(u[s], k);
-          }
+      } else {
+        /*
+         * Call into the batched interface so that we pay for the virtual
+         * dispatch only once per SIMD batch and direction:
+         */
+        constexpr auto n = Number::size();
+        std::array<double, n> u_batch, result_batch;
+        for (unsigned int s = 0; s < n; ++s)
+          u_batch[s] = u[s];
+
+        for (unsigned int k = 0; k < dim; ++k) {
+          flux->value(dealii::ArrayView<double>(result_batch.data(), n),
+                     dealii::ArrayView<const double>(u_batch.data(), n),
+                     k);
+          for (unsigned int s = 0; s < n; ++s)
+            result[k][s] = result_batch[s];
         }
       }
 
@@ -636,14 +672,25 @@ namespace ryujin
       const auto &flux = hyperbolic_system_.selected_flux_;
       dealii::Tensor<1, dim, Number> result;
 
-      /* This access by calling into value() repeatedly is terrible: */
-      for (unsigned int k = 0; k < dim; ++k) {
-        if constexpr (std::is_same_v<ScalarNumber, Number>) {
+      if constexpr (std::is_same_v<ScalarNumber, Number>) {
+        for (unsigned int k = 0; k < dim; ++k)
           result[k] = flux->gradient(u, k);
-        } else {
-          for (unsigned int s = 0; s < Number::size(); ++s) {
-            result[k][s] = flux->gradient(u[s], k);
-          }
+      } else {
+        /*
+         * Call into the batched interface so that we pay for the virtual
+         * dispatch only once per SIMD batch and direction:
+         */
+        constexpr auto n = Number::size();
+        std::array<double, n> u_batch, result_batch;
+        for (unsigned int s = 0; s < n; ++s)
+          u_batch[s] = u[s];
+
+        for (unsigned int k = 0; k < dim; ++k) {
+          flux->gradient(dealii::ArrayView<double>(result_batch.data(), n),
+                        dealii::ArrayView<const double>(u_batch.data(), n),
+                        k);
+          for (unsigned int s = 0; s < n; ++s)
+            result[k][s] = result_batch[s];
         }
       }
 
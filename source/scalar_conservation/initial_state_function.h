@@ -7,6 +7,7 @@
 
 #include "hyperbolic_system.h"
 #include <initial_state_library.h>
+#include <openmp.h>
 
 #include <deal.II/base/function_parser.h>
 
@@ -58,6 +59,11 @@ namespace ryujin
         this->parse_parameters_call_back.connect(set_up_muparser);
       }
 
+      bool time_dependent() const final
+      {
+        return expression_depends_on_time(expression_);
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number t) final
       {
         function_->set_time(t);
@@ -66,6 +72,28 @@ namespace ryujin
         return result;
       }
 
+      /*
+       * Set the time once and evaluate all points in parallel. This is
+       * safe because dealii::FunctionParser uses a thread-local parser:
+       */
+      void compute_list(const std::vector<dealii::Point<dim>> &points,
+                        Number t,
+                        std::vector<state_type> &states) final
+      {
+        function_->set_time(t);
+
+        states.resize(points.size());
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (unsigned int k = 0; k < points.size(); ++k) {
+          state_type result;
+          result[0] = function_->value(points[k]);
+          states[k] = result;
+        }
+        RYUJIN_PARALLEL_REGION_END
+      }
+
     private:
       const HyperbolicSystemView hyperbolic_system;
 
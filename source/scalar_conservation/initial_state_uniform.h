@@ -38,6 +38,11 @@ namespace ryujin
             "primitive state", primitive_, "Initial 1d primitive state");
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> & /*point*/,
                          Number /*t*/) final
       {
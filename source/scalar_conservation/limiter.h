@@ -81,6 +81,12 @@ namespace ryujin
        */
       using Bounds = std::array<Number, n_bounds>;
 
+      /**
+       * Rounding directions for storing the bounds in single precision,
+       * see Euler::Limiter::bounds_rounding.
+       */
+      static constexpr std::array<int, n_bounds> bounds_rounding{{-1, 1}};
+
       /**
        * Constructor taking a HyperbolicSystem instance as argument
        */
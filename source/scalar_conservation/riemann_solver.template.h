@@ -46,6 +46,22 @@ namespace ryujin
       std::cout << "df_j = " << df_j << std::endl;
 #endif
 
+      /*
+       * For a convex (or concave) projected flux the derivative is
+       * monotone and the maximal wavespeed is attained at one of the two
+       * states. In this case max(|f'(u_i)|, |f'(u_j)|) is a guaranteed and
+       * sharp upper bound and neither the Roe average nor any of the
+       * entropy inequalities can improve on it.
+       */
+      if (view.riemann_solver_convex_flux() &&
+          !view.riemann_solver_greedy_wavespeed()) {
+        const Number lambda_max = std::max(std::abs(df_i), std::abs(df_j));
+#ifdef DEBUG_RIEMANN_SOLVER
+        std::cout << "   convex flux       = " << lambda_max << std::endl;
+#endif
+        return lambda_max;
+      }
+
       /*
        * The Roe average with a regularization based on $h$ which is the
        * step size used for the central difference approximation of f'(u).
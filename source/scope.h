@@ -5,10 +5,14 @@
 
 #pragma once
 
+#include "energy_counters.h"
+
 #include <deal.II/base/timer.h>
 
 #include <map>
+#include <optional>
 #include <string>
+#include <utility>
 
 namespace ryujin
 {
@@ -16,7 +20,9 @@ namespace ryujin
    * A RAII scope for deal.II timer objects.
    *
    * This class does not perform MPI synchronization in contrast to the
-   * deal.II counterpart.
+   * deal.II counterpart. If energy counters are active (see
+   * EnergyCounters::set_active()) the energy consumed during the scope
+   * is recorded for the section as well.
    *
    * @ingroup Miscellaneous
    */
@@ -28,10 +34,25 @@ namespace ryujin
      */
     Scope(std::map<std::string, dealii::Timer> &computing_timer,
           const std::string &section)
-        : computing_timer_(computing_timer)
+        : Scope(*computing_timer.try_emplace(section).first)
+    {
+    }
+
+    /**
+     * Constructor. Starts the given (pre-registered) @p timer. The
+     * string @p section is only used for debug output and must outlive
+     * the Scope object. This variant avoids the lookup (and string
+     * construction) of the other constructor and is thus suitable for
+     * hot code paths.
+     */
+    Scope(dealii::Timer &timer, const std::string &section)
+        : timer_(timer)
         , section_(section)
+        , energy_counters_(EnergyCounters::active())
     {
-      computing_timer_[section_].start();
+      if (energy_counters_ != nullptr)
+        energy_ = energy_counters_->read();
+      timer_.start();
 #ifdef DEBUG_OUTPUT
       std::cout << "{scoped timer} \"" << section_ << "\" started" << std::endl;
 #endif
@@ -45,11 +66,80 @@ namespace ryujin
 #ifdef DEBUG_OUTPUT
       std::cout << "{scoped timer} \"" << section_ << "\" stopped" << std::endl;
 #endif
-      computing_timer_[section_].stop();
+      timer_.stop();
+      if (energy_counters_ != nullptr)
+        energy_counters_->accumulate(section_,
+                                     energy_counters_->read() - energy_);
+    }
+
+  private:
+    Scope(std::pair<const std::string, dealii::Timer> &entry)
+        : Scope(entry.second, entry.first)
+    {
+    }
+
+    dealii::Timer &timer_;
+    const std::string &section_;
+
+    EnergyCounters *energy_counters_;
+    double energy_ = 0.;
+  };
+
+
+  /**
+   * A RAII scope for the timers of the setup phase (mesh creation,
+   * offline data, multigrid setup, etc.). In contrast to Scope the timer
+   * map is not passed in explicitly: classes such as Discretization or
+   * OfflineData do not hold a reference to the computing timers of the
+   * TimeLoop. Instead, the timers of all SetupScope objects are recorded
+   * in the map selected with set_active(). If no map is active the
+   * SetupScope is a no-op. Usage:
+   *
+   * @code
+   * SetupScope::set_active(&setup_timer);
+   * {
+   *   SetupScope scope("offline data - distribute dofs");
+   *   // work
+   * }
+   * SetupScope::set_active(nullptr);
+   * @endcode
+   *
+   * Not thread safe, only use in serial (non thread-parallel) context.
+   *
+   * @ingroup Miscellaneous
+   */
+  class SetupScope
+  {
+  public:
+    /**
+     * Constructor. Starts the timer for the selected @p section.
+     */
+    SetupScope(const std::string &section)
+    {
+      if (active_ != nullptr)
+        scope_.emplace(*active_, section);
+    }
+
+    /**
+     * Return the timer map all SetupScope objects record into, or a
+     * nullptr if none is active.
+     */
+    static std::map<std::string, dealii::Timer> *active()
+    {
+      return active_;
+    }
+
+    /**
+     * Select the timer map all SetupScope objects record into.
+     */
+    static void set_active(std::map<std::string, dealii::Timer> *timer)
+    {
+      active_ = timer;
     }
 
   private:
-    std::map<std::string, dealii::Timer> &computing_timer_;
-    const std::string section_;
+    std::optional<Scope> scope_;
+
+    static inline std::map<std::string, dealii::Timer> *active_ = nullptr;
   };
 } // namespace ryujin
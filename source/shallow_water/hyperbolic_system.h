@@ -266,11 +266,46 @@ namespace ryujin
         static inline const auto precomputed_initial_names =
             std::array<std::string, n_precomputed_initial_values>{"bathymetry"};
 
+        /**
+         * The number of precomputed (time-independent) edge values: the
+         * bathymetry Z_j of the neighbor j. If "precompute edge values" is
+         * set, the values are computed once in HyperbolicModule::prepare()
+         * and stored contiguously per edge, which replaces the indirect
+         * gather of Z_j from the precomputed initial values in every
+         * stage. Because Z_j does not depend on i this is a plain copy
+         * that trades the gather for a matrix stream and is thus disabled
+         * by default.
+         */
+        static constexpr unsigned int n_precomputed_edge_values = 1;
+
+        /**
+         * Tensor type used for precomputed edge values.
+         */
+        using precomputed_edge_state_type =
+            dealii::Tensor<1, n_precomputed_edge_values, Number>;
+
+        /**
+         * Compute the precomputed edge values of the edge (i, js) from the
+         * precomputed initial values @p piv.
+         */
+        precomputed_edge_state_type
+        precomputed_edge_values(const precomputed_initial_vector_type &piv,
+                                const unsigned int i,
+                                const unsigned int *js) const;
+
         /**
          * The number of precomputed values.
          */
         static constexpr unsigned int n_precomputed_values = 2;
 
+        /**
+         * Set to true if the approximate Riemann solver computes the
+         * maximal wave speed from precomputed values. Such values must
+         * not be exchanged with reduced precision because rounding
+         * could underestimate the wave speed.
+         */
+        static constexpr bool wave_speed_uses_precomputed_values = false;
+
         /**
          * Array type used for precomputed values.
          */
@@ -507,6 +542,16 @@ namespace ryujin
                           const unsigned int *js,
                           const state_type &U_j) const;
 
+        /**
+         * Variant of above function that retrieves the bathymetry of the
+         * neighbor from the precomputed edge values @p pev.
+         */
+        flux_contribution_type
+        flux_contribution(const precomputed_vector_type &pv,
+                          const precomputed_edge_state_type &pev,
+                          const unsigned int *js,
+                          const state_type &U_j) const;
+
         /**
          * Given precomputed flux contributions @p prec_i and @p prec_j
          * compute the equilibrated, low-order flux \f$(f(U_i^{\ast,j}) +
@@ -538,6 +583,15 @@ namespace ryujin
                                 const dealii::Tensor<1, dim, Number> &c_ij,
                                 const Number &d_ij) const;
 
+        /**
+         * The low-order update is formed with the equilibrated states
+         * returned by equilibrated_states() instead of U_i and U_j, and
+         * the limiter bounds are shifted by the accumulated affine_shift().
+         * This also guarantees that the low-order update of a dry stencil
+         * (with vanishing states) is the identity.
+         */
+        static constexpr bool have_equilibrated_states = true;
+
         //@}
         /**
          * @name Computing source terms
@@ -1136,6 +1190,31 @@ namespace ryujin
     }
 
 
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystem::View<dim, Number>::flux_contribution(
+        const precomputed_vector_type & /*pv*/,
+        const precomputed_edge_state_type &pev,
+        const unsigned int * /*js*/,
+        const state_type &U_j) const -> flux_contribution_type
+    {
+      return {U_j, pev[0]};
+    }
+
+
+    template <int dim, typename Number>
+    DEAL_II_ALWAYS_INLINE inline auto
+    HyperbolicSystem::View<dim, Number>::precomputed_edge_values(
+        const precomputed_initial_vector_type &piv,
+        const unsigned int /*i*/,
+        const unsigned int *js) const -> precomputed_edge_state_type
+    {
+      precomputed_edge_state_type result;
+      result[0] = piv.template get_tensor<Number>(js)[0];
+      return result;
+    }
+
+
     template <int dim, typename Number>
     DEAL_II_ALWAYS_INLINE inline auto HyperbolicSystem::View<dim, Number>::flux(
         const flux_contribution_type &flux_i,
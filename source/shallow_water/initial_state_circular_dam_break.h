@@ -47,6 +47,11 @@ namespace ryujin
             "dam amplitude", dam_amplitude_, "Amplitude of circular dam");
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         const Number r = point.norm_square();
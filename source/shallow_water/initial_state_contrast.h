@@ -46,6 +46,11 @@ namespace ryujin
                             "Initial 1d primitive state (h, u) on the right");
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number /*t*/) final
       {
         const auto temp = point[0] > 0. ? primitive_right_ : primitive_left_;
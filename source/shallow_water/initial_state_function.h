@@ -8,6 +8,7 @@
 #pragma once
 
 #include <initial_state_library.h>
+#include <openmp.h>
 
 #include <deal.II/base/function_parser.h>
 
@@ -65,6 +66,12 @@ namespace ryujin
         this->parse_parameters_call_back.connect(set_up_muparser);
       }
 
+      bool time_dependent() const final
+      {
+        return expression_depends_on_time(depth_expression_) ||
+               expression_depends_on_time(velocity_expression_);
+      }
+
       state_type compute(const dealii::Point<dim> &point, Number t) final
       {
         dealii::Tensor<1, 2, Number> primitive;
@@ -77,6 +84,30 @@ namespace ryujin
         return hyperbolic_system_.from_initial_state(primitive);
       }
 
+      /*
+       * Set the time once and evaluate all points in parallel. This is
+       * safe because dealii::FunctionParser uses a thread-local parser:
+       */
+      void compute_list(const std::vector<dealii::Point<dim>> &points,
+                        Number t,
+                        std::vector<state_type> &states) final
+      {
+        depth_function_->set_time(t);
+        velocity_function_->set_time(t);
+
+        states.resize(points.size());
+
+        RYUJIN_PARALLEL_REGION_BEGIN
+        RYUJIN_OMP_FOR
+        for (unsigned int k = 0; k < points.size(); ++k) {
+          dealii::Tensor<1, 2, Number> primitive;
+          primitive[0] = depth_function_->value(points[k]);
+          primitive[1] = velocity_function_->value(points[k]);
+          states[k] = hyperbolic_system_.from_initial_state(primitive);
+        }
+        RYUJIN_PARALLEL_REGION_END
+      }
+
     private:
       const HyperbolicSystemView hyperbolic_system_;
 
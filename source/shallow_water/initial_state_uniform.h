@@ -42,6 +42,11 @@ namespace ryujin
             "primitive state", primitive_, "Initial 1d primitive state (h, u)");
       }
 
+      bool time_dependent() const final
+      {
+        return false;
+      }
+
       state_type compute(const dealii::Point<dim> & /*point*/,
                          Number /*t*/) final
       {
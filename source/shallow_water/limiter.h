@@ -83,6 +83,14 @@ namespace ryujin
        */
       using Bounds = std::array<Number, n_bounds>;
 
+      /**
+       * Rounding directions for storing the bounds in single precision:
+       * h_min and h_small toward negative infinity, all other bounds
+       * toward positive infinity. See Euler::Limiter::bounds_rounding.
+       */
+      static constexpr std::array<int, n_bounds> bounds_rounding{
+          {-1, 1, -1, 1, 1}};
+
       /**
        * Constructor taking a HyperbolicSystem instance as argument
        */
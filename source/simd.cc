@@ -103,6 +103,38 @@ namespace ryujin
            const Bias);
 #endif
 
+#if DEAL_II_VECTORIZATION_WIDTH_IN_BITS >= 128 && defined(__ARM_NEON)
+  template dealii::VectorizedArray<double, 2>
+  pow(const dealii::VectorizedArray<double, 2>, const double);
+
+  template dealii::VectorizedArray<double, 2>
+  pow(const dealii::VectorizedArray<double, 2>,
+      const dealii::VectorizedArray<double, 2>);
+
+  template dealii::VectorizedArray<float, 4>
+  pow(const dealii::VectorizedArray<float, 4>, const float);
+
+  template dealii::VectorizedArray<float, 4>
+  pow(const dealii::VectorizedArray<float, 4>,
+      const dealii::VectorizedArray<float, 4>);
+
+  template dealii::VectorizedArray<double, 2>
+  fast_pow(const dealii::VectorizedArray<double, 2>, const double, const Bias);
+
+  template dealii::VectorizedArray<double, 2>
+  fast_pow(const dealii::VectorizedArray<double, 2>,
+           const dealii::VectorizedArray<double, 2>,
+           const Bias);
+
+  template dealii::VectorizedArray<float, 4>
+  fast_pow(const dealii::VectorizedArray<float, 4>, const float, const Bias);
+
+  template dealii::VectorizedArray<float, 4>
+  fast_pow(const dealii::VectorizedArray<float, 4>,
+           const dealii::VectorizedArray<float, 4>,
+           const Bias);
+#endif
+
   template dealii::VectorizedArray<double, 1>
   pow(const dealii::VectorizedArray<double, 1>, const double);
 
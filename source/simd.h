@@ -11,6 +11,10 @@
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/vectorization.h>
 
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 namespace ryujin
 {
   /**
@@ -96,6 +100,32 @@ namespace ryujin
       it++;
   }
 
+
+  /**
+   * Issue a software prefetch (for reading) of all cache lines of the
+   * memory range [@p first, @p first + @p n_bytes). The function does
+   * nothing unless the compile-time option PREFETCH_DISTANCE is
+   * positive.
+   *
+   * @ingroup SIMD
+   */
+  DEAL_II_ALWAYS_INLINE inline void prefetch_range(const void *first,
+                                                   const std::size_t n_bytes)
+  {
+#if PREFETCH_DISTANCE > 0
+    constexpr std::size_t cache_line = 64;
+    const char *address = static_cast<const char *>(first);
+    for (std::size_t offset = 0; offset < n_bytes; offset += cache_line)
+      __builtin_prefetch(address + offset, 0, 3);
+    /* Also cover the last cache line of an unaligned range: */
+    if (n_bytes > 0)
+      __builtin_prefetch(address + n_bytes - 1, 0, 3);
+#else
+    (void)first;
+    (void)n_bytes;
+#endif
+  }
+
   //@}
   /**
    * @name Transcendental and other mathematical operations
@@ -126,6 +156,56 @@ namespace ryujin
   }
 
 
+  /**
+   * Round a number to the nearest value representable in single
+   * precision in the given @p direction: toward negative infinity for
+   * direction < 0, toward positive infinity for direction > 0, and to
+   * the nearest value otherwise. Subnormal results are avoided (they
+   * might be flushed to zero). For single precision arguments the number
+   * is returned unchanged.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  inline DEAL_II_ALWAYS_INLINE Number round_to_float(Number number,
+                                                     const int direction)
+  {
+    using ScalarNumber = typename get_value_type<Number>::type;
+
+    if constexpr (std::is_same_v<ScalarNumber, float>) {
+      return number;
+
+    } else {
+      const auto round = [direction](const ScalarNumber value) {
+        constexpr float infinity = std::numeric_limits<float>::infinity();
+        constexpr float min = std::numeric_limits<float>::min();
+
+        float result = static_cast<float>(value);
+        if (std::abs(result) < min)
+          result = 0.f;
+
+        if (direction < 0 && static_cast<ScalarNumber>(result) > value)
+          result = (result == 0.f ? -min : std::nextafter(result, -infinity));
+        else if (direction > 0 && static_cast<ScalarNumber>(result) < value)
+          result = (result == 0.f ? min : std::nextafter(result, infinity));
+
+        if (std::abs(result) < min)
+          result = 0.f;
+
+        return static_cast<ScalarNumber>(result);
+      };
+
+      if constexpr (std::is_same_v<Number, ScalarNumber>) {
+        return round(number);
+      } else {
+        for (unsigned int k = 0; k < Number::size(); ++k)
+          number[k] = round(number[k]);
+        return number;
+      }
+    }
+  }
+
+
   /**
    * A wrapper around dealii::Utilities::fixed_power. We use a wrapper
    * instead of calling the function directly so that we can easily change
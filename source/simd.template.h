@@ -6,6 +6,7 @@
 #pragma once
 
 #include "simd.h"
+#include "simd_accurate_pow.template.h"
 #include "simd_fast_pow.template.h"
 
 #include <cmath>
@@ -193,7 +194,55 @@ namespace ryujin
    *                           pow() implementation:                           *
    ****************************************************************************/
 
-#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
+#if defined(ACCURATE_POW)
+  template <>
+  // DEAL_II_ALWAYS_INLINE inline
+  float pow(const float x, const float b)
+  {
+    /* Use the accurate builtin implementation in double precision: */
+    return static_cast<float>(
+        accurate_pow_impl(static_cast<double>(x), static_cast<double>(b)));
+  }
+
+
+  template <>
+  // DEAL_II_ALWAYS_INLINE inline
+  double pow(const double x, const double b)
+  {
+    /* Use the accurate builtin implementation: */
+    return accurate_pow_impl(x, b);
+  }
+
+
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width>
+  pow(const dealii::VectorizedArray<T, width> x,
+      const dealii::VectorizedArray<T, width> b)
+  {
+    if constexpr (std::is_same_v<T, double>) {
+      return accurate_pow_impl(x, b);
+    } else {
+      /* There is no double precision array of matching width: */
+      dealii::VectorizedArray<T, width> result;
+      for (unsigned int k = 0; k < width; ++k)
+        result[k] = static_cast<T>(accurate_pow_impl(
+            static_cast<double>(x[k]), static_cast<double>(b[k])));
+      return result;
+    }
+  }
+
+
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width>
+  pow(const dealii::VectorizedArray<T, width> x, const T b)
+  {
+    return pow(x, dealii::VectorizedArray<T, width>(b));
+  }
+
+
+#elif DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
   template <>
   // DEAL_II_ALWAYS_INLINE inline
   float pow(const float x, const float b)
@@ -232,6 +281,8 @@ namespace ryujin
 #endif
 
 
+#if !defined(ACCURATE_POW) &&                                                  \
+    DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
   template <typename T, std::size_t width>
   // DEAL_II_ALWAYS_INLINE inline
   dealii::VectorizedArray<T, width>
@@ -251,6 +302,38 @@ namespace ryujin
   }
 
 
+#elif !defined(ACCURATE_POW)
+  /*
+   * There is no VCL backend for non-x86 targets (such as NEON on
+   * aarch64). We thus use a width agnostic lane-wise loop over the
+   * scalar implementation. The simd pragma allows the compiler to map
+   * the loop onto vector math library calls (e.g., glibc's libmvec or
+   * the Arm performance libraries).
+   */
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width>
+  pow(const dealii::VectorizedArray<T, width> x,
+      const dealii::VectorizedArray<T, width> b)
+  {
+    dealii::VectorizedArray<T, width> result;
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int k = 0; k < width; ++k)
+      result[k] = std::pow(x[k], b[k]);
+    return result;
+  }
+
+
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width>
+  pow(const dealii::VectorizedArray<T, width> x, const T b)
+  {
+    return pow(x, dealii::VectorizedArray<T, width>(b));
+  }
+#endif
+
+
   /*****************************************************************************
    *                         Fast pow() implementation:                        *
    ****************************************************************************/
@@ -294,6 +377,7 @@ namespace ryujin
 #endif
 
 
+#if DEAL_II_COMPILER_VECTORIZATION_LEVEL >= 1 && defined(__SSE2__)
   template <typename T, std::size_t width>
   // DEAL_II_ALWAYS_INLINE inline
   dealii::VectorizedArray<T, width> fast_pow(
@@ -318,4 +402,35 @@ namespace ryujin
                                               bias)));
   }
 
+
+#else
+  /*
+   * Width agnostic lane-wise fallback (see pow() above). The result is
+   * computed in single precision, identical to the scalar fast_pow():
+   */
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width>
+  fast_pow(const dealii::VectorizedArray<T, width> x,
+           const dealii::VectorizedArray<T, width> b,
+           const Bias)
+  {
+    dealii::VectorizedArray<T, width> result;
+    DEAL_II_OPENMP_SIMD_PRAGMA
+    for (unsigned int k = 0; k < width; ++k)
+      result[k] =
+          std::pow(static_cast<float>(x[k]), static_cast<float>(b[k]));
+    return result;
+  }
+
+
+  template <typename T, std::size_t width>
+  // DEAL_II_ALWAYS_INLINE inline
+  dealii::VectorizedArray<T, width> fast_pow(
+      const dealii::VectorizedArray<T, width> x, const T b, const Bias bias)
+  {
+    return fast_pow(x, dealii::VectorizedArray<T, width>(b), bias);
+  }
+#endif
+
 } // namespace ryujin
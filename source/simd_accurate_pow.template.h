@@ -0,0 +1,294 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "simd.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace ryujin
+{
+  /*****************************************************************************
+   *         Accurate pow() implementation based on double-double log:        *
+   ****************************************************************************/
+
+  /*
+   * A self-contained, vectorized implementation of pow(x, b) =
+   * exp(b * log(x)) for double precision arguments that does not depend
+   * on an external SIMD math library. The implementation is written in
+   * terms of arithmetic operations on dealii::VectorizedArray (or
+   * double) so that it is executed with the full SIMD width. Only the
+   * extraction of the exponent, the scaling by 2^n, and the treatment of
+   * special values are performed lane by lane.
+   *
+   * The logarithm is computed in double-double arithmetic (as an
+   * unevaluated sum hi + lo) and the product b * log(x) is formed with an
+   * error-free transformation. This avoids the amplification of the
+   * rounding error of log(x) by the factor |b log(x)| that a naive
+   * exp(b * log(x)) suffers from. The maximal observed error is about one
+   * ulp.
+   *
+   * Arguments that are not positive and finite, as well as results that
+   * would overflow or underflow, are computed with std::pow() instead.
+   */
+  namespace
+  {
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline constexpr unsigned int n_lanes()
+    {
+      if constexpr (std::is_same_v<T, double>)
+        return 1;
+      else
+        return T::size();
+    }
+
+
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline double &lane(T &x, const unsigned int l)
+    {
+      if constexpr (std::is_same_v<T, double>) {
+        (void)l;
+        return x;
+      } else {
+        return x[l];
+      }
+    }
+
+
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline double lane(const T &x, const unsigned int l)
+    {
+      if constexpr (std::is_same_v<T, double>) {
+        (void)l;
+        return x;
+      } else {
+        return x[l];
+      }
+    }
+
+
+    /*
+     * Error-free transformation of a sum: a + b = s + error
+     */
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline T two_sum(const T a, const T b, T &error)
+    {
+      const T s = a + b;
+      const T bb = s - a;
+      error = (a - (s - bb)) + (b - bb);
+      return s;
+    }
+
+
+    /*
+     * Error-free transformation of a product: a * b = p + error (Dekker's
+     * algorithm, which does not require a fused multiply add)
+     */
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline T two_product(const T a, const T b, T &error)
+    {
+      constexpr double splitter = 134217729.; /* 2^27 + 1 */
+
+      const T p = a * b;
+
+      const T ca = T(splitter) * a;
+      const T a_hi = ca - (ca - a);
+      const T a_lo = a - a_hi;
+
+      const T cb = T(splitter) * b;
+      const T b_hi = cb - (cb - b);
+      const T b_lo = b - b_hi;
+
+      error = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+      return p;
+    }
+
+
+    /*
+     * ln(2) split into a leading part with 32 trailing zero bits (so that
+     * k * ln2_hi is exact for |k| < 2^20) and a trailing part.
+     */
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+
+    /*
+     * Compute log(x) = hi + lo in double-double arithmetic for positive,
+     * finite, normalized x.
+     */
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline T log_dd(const T x, T &lo)
+    {
+      /*
+       * Decompose x = 2^k * m with m in [sqrt(1/2), sqrt(2)).
+       */
+      T m, k;
+      for (unsigned int l = 0; l < n_lanes<T>(); ++l) {
+        std::uint64_t bits;
+        const double value = lane(x, l);
+        std::memcpy(&bits, &value, sizeof(double));
+
+        int exponent = static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+        bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+
+        double mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(double));
+        if (mantissa > 1.41421356237309504880) {
+          mantissa *= 0.5;
+          exponent += 1;
+        }
+        lane(m, l) = mantissa;
+        lane(k, l) = static_cast<double>(exponent);
+      }
+
+      /*
+       * log(m) = 2 atanh(s) with s = f / (2 + f) and f = m - 1. Note that
+       * f is exact. We compute s = s_hi + s_lo in double-double.
+       */
+      const T f = m - T(1.);
+
+      T den_lo;
+      const T den = two_sum(T(2.), f, den_lo);
+
+      const T s = f / den;
+      T p_lo;
+      const T p = two_product(s, den, p_lo);
+      const T s_lo = (((f - p) - p_lo) - s * den_lo) / den;
+
+      /*
+       * 2 atanh(s) = 2 s + s^3 sum_{j >= 1} 2 / (2j+1) s^(2j - 2). We have
+       * |s| <= 0.1716, thus the tail is less than 1% of the leading term
+       * and can be computed in ordinary double precision.
+       */
+      const T s2 = s * s;
+      T poly = T(2. / 21.);
+      poly = poly * s2 + T(2. / 19.);
+      poly = poly * s2 + T(2. / 17.);
+      poly = poly * s2 + T(2. / 15.);
+      poly = poly * s2 + T(2. / 13.);
+      poly = poly * s2 + T(2. / 11.);
+      poly = poly * s2 + T(2. / 9.);
+      poly = poly * s2 + T(2. / 7.);
+      poly = poly * s2 + T(2. / 5.);
+      poly = poly * s2 + T(2. / 3.);
+      const T tail = s * s2 * poly;
+
+      /*
+       * log(x) = k ln2 + 2 s + tail. Both k * ln2_hi and 2 s are exact.
+       */
+      T error;
+      const T sum = two_sum(k * T(ln2_hi), T(2.) * s, error);
+      const T sum_lo = error + ((T(2.) * s_lo + tail) + k * T(ln2_lo));
+
+      const T hi = sum + sum_lo;
+      lo = sum_lo - (hi - sum);
+      return hi;
+    }
+
+
+    /*
+     * Compute exp(a + a_lo) for |a| <= 708.
+     */
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline T exp_dd(const T a, const T a_lo)
+    {
+      /*
+       * Range reduction: a = n ln2 + r with |r| <= ln2 / 2. Rounding to
+       * the nearest integer is done by adding and subtracting 1.5 * 2^52.
+       */
+      constexpr double log2e = 1.44269504088896338700;
+      constexpr double shifter = 6755399441055744.; /* 1.5 * 2^52 */
+
+      const T n = (a * T(log2e) + T(shifter)) - T(shifter);
+      const T r = (a - n * T(ln2_hi)) + (a_lo - n * T(ln2_lo));
+
+      /*
+       * exp(r) = 1 + q with q = r + r^2 (1/2 + r/6 + ...). The Taylor
+       * series up to order 13 is accurate to 2^-58 for |r| <= ln2 / 2.
+       */
+      T poly = T(1. / 6227020800.);
+      poly = poly * r + T(1. / 479001600.);
+      poly = poly * r + T(1. / 39916800.);
+      poly = poly * r + T(1. / 3628800.);
+      poly = poly * r + T(1. / 362880.);
+      poly = poly * r + T(1. / 40320.);
+      poly = poly * r + T(1. / 5040.);
+      poly = poly * r + T(1. / 720.);
+      poly = poly * r + T(1. / 120.);
+      poly = poly * r + T(1. / 24.);
+      poly = poly * r + T(1. / 6.);
+      poly = poly * r + T(1. / 2.);
+      const T q = r + r * r * poly;
+
+      T result = T(1.) + q;
+
+      /*
+       * Scale by 2^n:
+       */
+      for (unsigned int l = 0; l < n_lanes<T>(); ++l) {
+        const auto exponent = static_cast<std::int64_t>(lane(n, l)) + 1023;
+        const std::uint64_t bits = static_cast<std::uint64_t>(exponent)
+                                   << 52;
+        double scale;
+        std::memcpy(&scale, &bits, sizeof(double));
+        lane(result, l) *= scale;
+      }
+
+      return result;
+    }
+
+
+    template <typename T>
+    DEAL_II_ALWAYS_INLINE inline T accurate_pow_impl(const T x, const T b)
+    {
+      static_assert(std::is_same_v<typename get_value_type<T>::type, double>,
+                    "only implemented for double precision");
+
+      T log_lo;
+      const T log_hi = log_dd(x, log_lo);
+
+      T y_lo;
+      const T y_hi = two_product(b, log_hi, y_lo);
+      y_lo = y_lo + b * log_lo;
+
+      /*
+       * Replace all special values by a safe argument before calling
+       * exp_dd() and fall back to std::pow() for them afterwards:
+       */
+      constexpr double max_double = std::numeric_limits<double>::max();
+      T y_safe = y_hi;
+      unsigned int n_special = 0;
+      for (unsigned int l = 0; l < n_lanes<T>(); ++l) {
+        const double x_l = lane(x, l);
+        const bool special = !(x_l >= std::numeric_limits<double>::min() &&
+                               x_l <= max_double) ||
+                             !(std::abs(lane(y_hi, l)) <= 708.);
+        if (special) {
+          lane(y_safe, l) = 0.;
+          n_special++;
+        }
+      }
+
+      T result = exp_dd(y_safe, y_lo);
+
+      if (n_special > 0) {
+        for (unsigned int l = 0; l < n_lanes<T>(); ++l) {
+          const double x_l = lane(x, l);
+          if (!(x_l >= std::numeric_limits<double>::min() &&
+                x_l <= max_double) ||
+              !(std::abs(lane(y_hi, l)) <= 708.))
+            lane(result, l) = std::pow(x_l, lane(b, l));
+        }
+      }
+
+      return result;
+    }
+  } // namespace
+} // namespace ryujin
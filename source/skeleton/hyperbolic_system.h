@@ -173,11 +173,30 @@ namespace ryujin
         static inline const auto precomputed_initial_names =
             std::array<std::string, n_precomputed_initial_values>{};
 
+        /**
+         * The number of precomputed (time-independent) edge values. If
+         * nonzero and "precompute edge values" is set,
+         * HyperbolicModule::prepare() evaluates
+         * precomputed_edge_values(piv, i, js) once for every edge and the
+         * result is handed to the flux_contribution(pv, pev, js, U_j)
+         * overload of the neighbor instead of the precomputed initial
+         * values (see the shallow water equations for an example).
+         */
+        static constexpr unsigned int n_precomputed_edge_values = 0;
+
         /**
          * The number of precomputed values.
          */
         static constexpr unsigned int n_precomputed_values = 0;
 
+        /**
+         * Set to true if the approximate Riemann solver computes the
+         * maximal wave speed from precomputed values. Such values must
+         * not be exchanged with reduced precision because rounding
+         * could underestimate the wave speed.
+         */
+        static constexpr bool wave_speed_uses_precomputed_values = false;
+
         /**
          * Array type used for precomputed values.
          */
@@ -311,6 +330,13 @@ namespace ryujin
         high_order_flux(const flux_contribution_type &,
                         const flux_contribution_type &) const = delete;
 
+        /**
+         * The low-order update is formed with the states U_i and U_j
+         * directly, and the limiter bounds are not shifted (see
+         * ShallowWater::HyperbolicSystem::View::have_equilibrated_states):
+         */
+        static constexpr bool have_equilibrated_states = false;
+
         //@}
         /**
          * @name Computing stencil source terms
@@ -81,6 +81,12 @@ namespace ryujin
        */
       using Bounds = std::array<Number, n_bounds>;
 
+      /**
+       * Rounding directions for storing the bounds in single precision
+       * (-1 for lower bounds, +1 for upper bounds).
+       */
+      static constexpr std::array<int, n_bounds> bounds_rounding{};
+
       /**
        * Constructor taking a HyperbolicSystem instance as argument
        */
@@ -8,7 +8,10 @@
 #include <compile_time_options.h>
 
 #include "offline_data.h"
+#include "openmp.h"
+#include "simd.h"
 
+#include <deal.II/base/mpi.h>
 #include <deal.II/distributed/solution_transfer.h>
 
 namespace ryujin
@@ -80,28 +83,112 @@ namespace ryujin
      */
     void prepare_for_interpolation(const vector_type &U)
     {
+      using VA = dealii::VectorizedArray<Number>;
+
       const auto &scalar_partitioner = offline_data_->scalar_partitioner();
       const auto &affine_constraints = offline_data_->affine_constraints();
 
+      const unsigned int n_internal = offline_data_->n_locally_internal();
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      const unsigned int n_relevant = offline_data_->n_locally_relevant();
+
+      /*
+       * Convert the state into primitive variables with a thread-parallel
+       * and SIMD vectorized loop:
+       */
+
+      primitive_state_.reinit(offline_data_->vector_partitioner());
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+        using T = decltype(sentinel);
+        unsigned int stride_size = get_stride_size<T>;
+        const auto view = hyperbolic_system_.template view<dim, T>();
+
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; i += stride_size) {
+          const auto U_i = U.template get_tensor<T>(i);
+          const auto primitive_state = view.to_primitive_state(U_i);
+          primitive_state_.template write_tensor<T>(primitive_state, i);
+        }
+      };
+
+      /* Parallel non-vectorized loop: */
+      loop(Number(), n_internal, n_owned);
+      /* Parallel vectorized SIMD loop: */
+      loop(VA(), 0, n_internal);
+
+      RYUJIN_PARALLEL_REGION_END
+
+      /*
+       * Apply affine constraints to all components at once. If the
+       * constraints of a locally owned degree of freedom refer to a
+       * degree of freedom that is not locally relevant (on any rank) we
+       * fall back to AffineConstraints::distribute() for every component.
+       */
+
+      bool constraints_are_local = true;
+      for (const auto &line : affine_constraints.get_lines()) {
+        if (!scalar_partitioner->in_local_range(line.index))
+          continue;
+        for (const auto &[j, weight] : line.entries)
+          if (!scalar_partitioner->in_local_range(j) &&
+              !scalar_partitioner->is_ghost_entry(j))
+            constraints_are_local = false;
+      }
+      constraints_are_local = dealii::Utilities::MPI::min(
+          constraints_are_local ? 1u : 0u,
+          scalar_partitioner->get_mpi_communicator());
+
       state_.resize(problem_dimension);
       for (auto &it : state_)
         it.reinit(scalar_partitioner);
 
-      const unsigned int n_owned = offline_data_->n_locally_owned();
-
-      /* copy over the primitive state: */
-
-      for (unsigned int i = 0; i < n_owned; ++i) {
-        const auto U_i = U.get_tensor(i);
-        const auto primitive_state = hyperbolic_system_.to_primitive_state(U_i);
-
-        for (unsigned int k = 0; k < problem_dimension; ++k)
-          state_[k].local_element(i) = primitive_state[k];
-      }
-
-      for (auto &it : state_) {
-        affine_constraints.distribute(it);
-        it.update_ghost_values();
+      if (constraints_are_local) {
+        /* A single ghost exchange for all components: */
+        primitive_state_.update_ghost_values();
+
+        for (const auto &line : affine_constraints.get_lines()) {
+          if (!scalar_partitioner->in_local_range(line.index))
+            continue;
+
+          state_type P_i;
+          for (unsigned int k = 0; k < problem_dimension; ++k)
+            P_i[k] = line.inhomogeneity;
+          for (const auto &[j, weight] : line.entries)
+            P_i += weight * primitive_state_.get_tensor(
+                                scalar_partitioner->global_to_local(j));
+
+          primitive_state_.write_tensor(
+              P_i, scalar_partitioner->global_to_local(line.index));
+        }
+
+        /* And a second one to update constrained ghost entries: */
+        primitive_state_.update_ghost_values();
+
+        for (unsigned int i = 0; i < n_relevant; ++i) {
+          const auto P_i = primitive_state_.get_tensor(i);
+          for (unsigned int k = 0; k < problem_dimension; ++k)
+            state_[k].local_element(i) = P_i[k];
+        }
+
+        /* All ghost entries are up to date: */
+        for (auto &it : state_)
+          it.set_ghost_state(true);
+
+      } else {
+
+        for (unsigned int i = 0; i < n_owned; ++i) {
+          const auto P_i = primitive_state_.get_tensor(i);
+          for (unsigned int k = 0; k < problem_dimension; ++k)
+            state_[k].local_element(i) = P_i[k];
+        }
+
+        for (auto &it : state_) {
+          affine_constraints.distribute(it);
+          it.update_ghost_values();
+        }
       }
 
       std::vector<const scalar_type *> ptr_state;
@@ -166,6 +253,7 @@ namespace ryujin
     dealii::parallel::distributed::SolutionTransfer<dim, scalar_type>
         solution_transfer_;
 
+    vector_type primitive_state_;
     std::vector<scalar_type> state_;
     std::vector<scalar_type> interpolated_state_;
     //@}
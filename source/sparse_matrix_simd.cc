@@ -11,9 +11,18 @@ namespace ryujin
 {
   /* instantiations */
 
+  /*
+   * Without vectorization the sparsity pattern of both precisions is
+   * identical and must only be instantiated once:
+   */
+#if !defined(RYUJIN_SECONDARY_PRECISION) ||                                   \
+    DEAL_II_VECTORIZATION_WIDTH_IN_BITS > 0
   template class SparsityPatternSIMD<dealii::VectorizedArray<NUMBER>::size()>;
+#endif
 
   template class SparseMatrixSIMD<NUMBER, 1>;
   template class SparseMatrixSIMD<NUMBER, 2>;
   template class SparseMatrixSIMD<NUMBER, 3>;
+
+  template class SymmetricSparseMatrixSIMD<NUMBER>;
 } /* namespace ryujin */
@@ -9,6 +9,17 @@
 #include <deal.II/base/partitioner.h>
 #include <deal.II/lac/dynamic_sparsity_pattern.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+#include "ghost_compression.h"
+#include "huge_pages.h"
 #include "openmp.h"
 #include "simd.h"
 
@@ -19,6 +30,15 @@ namespace ryujin
             int simd_length = dealii::VectorizedArray<Number>::size()>
   class SparseMatrixSIMD;
 
+  template <typename Number,
+            int simd_length = dealii::VectorizedArray<Number>::size()>
+  class SymmetricSparseMatrixSIMD;
+
+  template <typename Number,
+            int n_components = 1,
+            int simd_length = dealii::VectorizedArray<Number>::size()>
+  class SkewSymmetricSparseMatrixSIMD;
+
   /**
    * A specialized sparsity pattern for efficient vectorized SIMD access.
    *
@@ -40,6 +60,24 @@ namespace ryujin
    * For the non-vectorized row index region [n_internal_dofs,
    * n_locally_relevant_dofs) we store the matrix in CSR format (equivalent
    * to the static dealii::SparsityPattern).
+   *
+   * In addition, the class precomputes a compressed index map that
+   * assigns a common storage location to every pair of transposed
+   * entries. This map is used by SymmetricSparseMatrixSIMD.
+   *
+   * For the vectorized row index region the class also stores a batched
+   * list of all upper triangular entries (see edge_positions()) that
+   * allows to traverse every edge i < j only once with full SIMD width.
+   *
+   * Finally, the class stores a compacted list of all active rows of the
+   * locally owned index range (see active_rows()) that allows to skip
+   * constrained degrees of freedom in row loops without branching.
+   *
+   * If the compile-time option COMPRESSED_COLUMN_INDICES is set the
+   * column indices are in addition stored as 16 bit differences to the
+   * row index. Hot loops decode a row with columns(row, buffer) which
+   * halves the index traffic provided that the degrees of freedom are
+   * renumbered with a bandwidth reducing ordering.
    */
   template <int simd_length>
   class SparsityPatternSIMD
@@ -81,12 +119,85 @@ namespace ryujin
 
     const unsigned int *columns(const unsigned int row) const;
 
+    /**
+     * Variant of above function that returns the column indices of
+     * @p row decoded from the compressed column index format if the
+     * compile-time option COMPRESSED_COLUMN_INDICES is set. In this case
+     * the column indices of the whole SIMD stride containing @p row are
+     * written to @p buffer, which must hold at least column_buffer_size()
+     * entries, and a pointer into @p buffer is returned. Otherwise the
+     * function returns columns(row) and @p buffer is not touched.
+     */
+    const unsigned int *columns(const unsigned int row,
+                                unsigned int *buffer) const;
+
     unsigned int row_length(const unsigned int row) const;
 
+    /**
+     * Return the number of entries of the buffer that has to be passed to
+     * columns(row, buffer). This is the maximal row length times
+     * simd_length if the compile-time option COMPRESSED_COLUMN_INDICES is
+     * set and zero otherwise.
+     */
+    unsigned int column_buffer_size() const;
+
     unsigned int n_rows() const;
 
     std::size_t n_nonzero_elements() const;
 
+    /**
+     * Return the number of edge batches of the SIMD stride starting at
+     * @p row. The index @p row must be within the interval
+     * [0, n_internal_dofs) and must be divisible by simd_length.
+     */
+    unsigned int n_edge_batches(const unsigned int row) const;
+
+    /**
+     * Return a pointer to the positions within the row of all edge
+     * batches of the SIMD stride starting at @p row. Every batch consists
+     * of simd_length consecutive positions, one for every lane k. Every
+     * upper triangular entry (i + k, j) with j > i + k of the stride is
+     * contained in exactly one batch. Lanes with fewer upper triangular
+     * entries are padded with a repeated upper triangular entry, or with a
+     * lower triangular entry if the lane has none. The index @p row must
+     * be within the interval [0, n_internal_dofs) and must be divisible
+     * by simd_length.
+     */
+    const unsigned int *edge_positions(const unsigned int row) const;
+
+    /**
+     * Return a pointer to the ascending list of all active rows of the
+     * locally owned index range, i.e., all rows with at least one
+     * off-diagonal entry. Constrained degrees of freedom (whose row only
+     * consists of the diagonal entry) are omitted. In the vectorized row
+     * index region [0, n_internal_dofs) the list only contains the first
+     * row of every active SIMD stride. Usage:
+     *
+     * @code
+     * const unsigned int *active_rows = sparsity.active_rows();
+     * const unsigned int first = sparsity.active_position(left);
+     * const unsigned int last = sparsity.active_position(right);
+     * for (unsigned int r = first; r < last; ++r) {
+     *   const unsigned int i = active_rows[r];
+     *   // ...
+     * }
+     * @endcode
+     */
+    const unsigned int *active_rows() const;
+
+    /**
+     * Return the position of the first row greater or equal to @p row in
+     * active_rows(). The index @p row must be within the interval
+     * [0, n_locally_owned_dofs].
+     */
+    unsigned int active_position(const unsigned int row) const;
+
+    /**
+     * Return an estimate (in bytes) of the memory consumption of this
+     * object.
+     */
+    std::size_t memory_consumption() const;
+
   private:
     unsigned int n_internal_dofs;
     unsigned int n_locally_owned_dofs;
@@ -95,14 +206,257 @@ namespace ryujin
     dealii::AlignedVector<std::size_t> row_starts;
     dealii::AlignedVector<unsigned int> column_indices;
     dealii::AlignedVector<unsigned int> indices_transposed;
+    unsigned int max_entries_per_row;
+
+#ifdef COMPRESSED_COLUMN_INDICES
+    /**
+     * The column indices stored as 16 bit differences to the (lane) row
+     * index. Columns that are too far away from the row are marked with
+     * escape_delta and have to be looked up in column_indices instead.
+     */
+    dealii::AlignedVector<std::int16_t> column_deltas;
+    static constexpr std::int16_t escape_delta =
+        std::numeric_limits<std::int16_t>::min();
+#endif
+
+    /**
+     * Return the column index stored at @p position, where @p row is the
+     * (lane) row the entry belongs to.
+     */
+    unsigned int column_at(const std::size_t position,
+                           const unsigned int row) const;
+
+    dealii::AlignedVector<unsigned int> indices_symmetric;
+    std::size_t n_symmetric_nonzero_elements;
+
+    dealii::AlignedVector<unsigned int> edge_starts;
+    dealii::AlignedVector<unsigned int> edge_batches;
+
+    dealii::AlignedVector<unsigned int> active_row_indices;
 
     dealii::AlignedVector<std::size_t> indices_to_be_sent;
     std::vector<std::pair<unsigned int, unsigned int>> send_targets;
     std::vector<std::pair<unsigned int, unsigned int>> receive_targets;
     MPI_Comm mpi_communicator;
 
+    /**
+     * The sparse ("transposed only") variant of above exchange pattern:
+     * It omits the diagonal entry of every ghost row because a receiving
+     * rank only reads the transposed entries (j, i) that couple a ghost
+     * row j to its own locally owned dofs i. Received entries are
+     * scattered into the ghost rows at transposed_receive_positions.
+     */
+    dealii::AlignedVector<std::size_t> transposed_indices_to_be_sent;
+    std::vector<std::pair<unsigned int, unsigned int>> transposed_send_targets;
+    std::vector<std::pair<unsigned int, unsigned int>>
+        transposed_receive_targets;
+    dealii::AlignedVector<std::size_t> transposed_receive_positions;
+
     template <typename, int, int>
     friend class SparseMatrixSIMD;
+
+    template <typename, int>
+    friend class SymmetricSparseMatrixSIMD;
+
+    template <typename, int, int>
+    friend class SkewSymmetricSparseMatrixSIMD;
+  };
+
+
+  /**
+   * A small owning container for persistent MPI requests (created with
+   * MPI_Send_init and MPI_Recv_init) that frees all requests on
+   * destruction. Persistent requests are bound to the buffers they have
+   * been created for. A copy therefore starts out empty, whereas moves
+   * transfer ownership of the requests.
+   *
+   * @ingroup SIMD
+   */
+  class PersistentRequests
+  {
+  public:
+    PersistentRequests() = default;
+
+    PersistentRequests(const PersistentRequests &)
+    {
+    }
+
+    PersistentRequests(PersistentRequests &&other) noexcept
+    {
+      requests.swap(other.requests);
+    }
+
+    PersistentRequests &operator=(const PersistentRequests &)
+    {
+      clear();
+      return *this;
+    }
+
+    PersistentRequests &operator=(PersistentRequests &&other) noexcept
+    {
+      if (this != &other) {
+        clear();
+        requests.swap(other.requests);
+      }
+      return *this;
+    }
+
+    ~PersistentRequests()
+    {
+      clear();
+    }
+
+    /**
+     * Free all requests.
+     */
+    void clear()
+    {
+#ifdef DEAL_II_WITH_MPI
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (!finalized)
+        for (auto &request : requests)
+          if (request != MPI_REQUEST_NULL)
+            MPI_Request_free(&request);
+#endif
+      requests.clear();
+    }
+
+    std::vector<MPI_Request> requests;
+  };
+
+
+  /**
+   * A small owning container for the MPI-3 shared memory window and the
+   * node-local communicator used by the intra-node ghost row exchange of
+   * SparseMatrixSIMD (see
+   * SparseMatrixSIMD::initialize_shared_memory_ghost_rows()). The window
+   * holds two export buffers of size @p buffer_size that are used
+   * alternately. Similarly to PersistentRequests a copy starts out
+   * empty, whereas moves transfer ownership of the window.
+   *
+   * @ingroup SIMD
+   */
+  template <typename Number>
+  class SharedMemoryWindow
+  {
+  public:
+    SharedMemoryWindow() = default;
+
+    SharedMemoryWindow(const SharedMemoryWindow &)
+    {
+    }
+
+    SharedMemoryWindow(SharedMemoryWindow &&other) noexcept
+    {
+      swap(other);
+    }
+
+    SharedMemoryWindow &operator=(const SharedMemoryWindow &)
+    {
+      clear();
+      return *this;
+    }
+
+    SharedMemoryWindow &operator=(SharedMemoryWindow &&other) noexcept
+    {
+      if (this != &other) {
+        clear();
+        swap(other);
+      }
+      return *this;
+    }
+
+    ~SharedMemoryWindow()
+    {
+      clear();
+    }
+
+    /**
+     * Free the window and the node communicator. This is a collective
+     * operation on the node communicator.
+     */
+    void clear()
+    {
+#ifdef DEAL_II_WITH_MPI
+      int finalized = 0;
+      MPI_Finalized(&finalized);
+      if (!finalized && window != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(window);
+        MPI_Win_free(&window);
+      }
+      if (!finalized && node_communicator != MPI_COMM_NULL)
+        MPI_Comm_free(&node_communicator);
+      window = MPI_WIN_NULL;
+      node_communicator = MPI_COMM_NULL;
+#endif
+      buffer = nullptr;
+      buffer_size = 0;
+      parity = 0;
+      mpi_tag = 0;
+      receives.clear();
+      remote_receive_targets.clear();
+      remote_send_targets.clear();
+    }
+
+    /**
+     * Return true if no window has been allocated.
+     */
+    bool empty() const
+    {
+      return buffer == nullptr;
+    }
+
+    void swap(SharedMemoryWindow &other) noexcept
+    {
+#ifdef DEAL_II_WITH_MPI
+      std::swap(window, other.window);
+      std::swap(node_communicator, other.node_communicator);
+#endif
+      std::swap(buffer, other.buffer);
+      std::swap(buffer_size, other.buffer_size);
+      std::swap(parity, other.parity);
+      std::swap(mpi_tag, other.mpi_tag);
+      receives.swap(other.receives);
+      remote_receive_targets.swap(other.remote_receive_targets);
+      remote_send_targets.swap(other.remote_send_targets);
+    }
+
+#ifdef DEAL_II_WITH_MPI
+    MPI_Win window = MPI_WIN_NULL;
+    MPI_Comm node_communicator = MPI_COMM_NULL;
+#endif
+
+    /**
+     * The two (local) export buffers within the window.
+     */
+    Number *buffer = nullptr;
+    std::size_t buffer_size = 0;
+
+    /**
+     * The export buffer (0 or 1) used for the next exchange.
+     */
+    unsigned int parity = 0;
+
+    unsigned int mpi_tag = 0;
+
+    /**
+     * Intra-node receives: the two export buffers of the sender (already
+     * offset to the first entry destined for this rank), the offset of
+     * the first ghost entry in the local data array, and the number of
+     * entries.
+     */
+    std::vector<
+        std::tuple<std::array<const Number *, 2>, std::size_t, std::size_t>>
+        receives;
+
+    /**
+     * Indices into SparsityPatternSIMD::receive_targets and
+     * SparsityPatternSIMD::send_targets of all ranks that are not on the
+     * same node. These are exchanged with regular MPI messages.
+     */
+    std::vector<unsigned int> remote_receive_targets;
+    std::vector<unsigned int> remote_send_targets;
   };
 
 
@@ -114,11 +468,22 @@ namespace ryujin
    * SparsityPatternSIMD for details). For the non-vectorized row index
    * region [n_internal_dofs, n_locally_relevant_dofs) we store the matrix in
    * CSR format (equivalent to the static dealii::SparsityPattern).
+   *
+   * The number type @a Number2 of all accessors may differ from the
+   * storage type @a Number. This allows, for example, to store a matrix in
+   * single precision and to access it with double and
+   * dealii::VectorizedArray<double, simd_length>. The values are
+   * converted on the fly.
    */
   template <typename Number, int n_components, int simd_length>
   class SparseMatrixSIMD
   {
   public:
+    /**
+     * The matrix stores all entries individually.
+     */
+    static constexpr bool is_symmetric = false;
+
     SparseMatrixSIMD();
 
     SparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity);
@@ -194,6 +559,17 @@ namespace ryujin
     get_transposed_tensor(const unsigned int row,
                           const unsigned int position_within_column) const;
 
+    /**
+     * Issue software prefetches for the entry indexed by @p row and
+     * @p position_within_column. If the template argument @a Number2 is a
+     * vectorized array the entries of all simd_length rows are
+     * prefetched. The function does nothing unless the compile-time
+     * option PREFETCH_DISTANCE is positive.
+     */
+    template <typename Number2 = Number>
+    void prefetch(const unsigned int row,
+                  const unsigned int position_within_column) const;
+
     /* Write scalar or tensor entry: */
 
     /**
@@ -228,317 +604,1687 @@ namespace ryujin
 
     /* Synchronize over MPI ranks: */
 
+    /**
+     * Create persistent MPI requests for the ghost row exchange using
+     * the given @p communication_channel. The communication pattern is
+     * fixed for a given sparsity pattern, so all subsequent calls to
+     * update_ghost_rows_start() simply start these requests instead of
+     * posting new ones. The communication_channel argument of
+     * update_ghost_rows_start() is ignored in this case.
+     *
+     * @note The persistent requests are released by reinit() and have to
+     * be recreated afterwards.
+     */
+    void
+    initialize_persistent_ghost_rows(const unsigned int communication_channel);
+
+    /**
+     * Set up an intra-node ghost row exchange with the given
+     * @p communication_channel. All ranks sharing a node (as determined
+     * by MPI_Comm_split_type with MPI_COMM_TYPE_SHARED) allocate their
+     * export buffers in a common MPI-3 shared memory window. Ghost rows
+     * owned by a rank on the same node are then copied directly out of
+     * the export buffer of the owner after a node-local barrier, only
+     * ranks on other nodes are served with MPI messages. Two export
+     * buffers are used alternately so that a single barrier per exchange
+     * suffices. The communication_channel argument of
+     * update_ghost_rows_start() is ignored in this case.
+     *
+     * @note This function and all subsequent ghost row exchanges are
+     * collective over the communicator of the sparsity pattern. The
+     * window is released by reinit().
+     */
+    void initialize_shared_memory_ghost_rows(
+        const unsigned int communication_channel);
+
+    /**
+     * Send the payload of the ghost row exchange with reduced precision
+     * @p compression. All values are rounded in the given @p direction
+     * (see round_to_float()) and all exported locally owned entries are
+     * replaced by their rounded counterparts; see CompressedGhostExchange
+     * for details. Reduced precision ghost rows can neither be combined
+     * with persistent requests nor with the shared memory exchange.
+     */
+    void set_ghost_compression(const GhostCompression compression,
+                               const int direction);
+
+    /**
+     * Only exchange the transposed entries (j, i) of ghost rows j that
+     * couple to locally owned dofs i but not the diagonal entries (j, j)
+     * of the ghost rows. This suffices for matrices that are only
+     * accessed via get_transposed_entry() / get_transposed_tensor() in
+     * ghost rows. Received entries are written into a contiguous buffer
+     * and scattered into the ghost rows in update_ghost_rows_finish().
+     * The diagonal entries of the ghost rows are left untouched.
+     *
+     * @note This function has to be called before
+     * initialize_persistent_ghost_rows() and
+     * initialize_shared_memory_ghost_rows().
+     */
+    void set_transposed_ghost_exchange(const bool transposed_only);
+
     void update_ghost_rows_start(const unsigned int communication_channel = 0);
 
     void update_ghost_rows_finish();
 
     void update_ghost_rows();
 
+    /* Binary (de)serialization of the matrix entries: */
+
+    /**
+     * Write all matrix entries (including ghost rows) in binary format to
+     * @p output. The entries are preceded by a header with the element
+     * size and the number of entries. The sparsity pattern is not stored.
+     */
+    void write_data(std::ostream &output) const;
+
+    /**
+     * Read in matrix entries written by write_data(). The matrix must
+     * have been initialized with an identical sparsity pattern. An
+     * exception is raised if the element size or the number of entries
+     * stored in the header do not match.
+     */
+    void read_data(std::istream &input);
+
+    /**
+     * Return an estimate (in bytes) of the memory consumption of this
+     * object. The memory of the sparsity pattern is not included.
+     */
+    std::size_t memory_consumption() const;
+
   private:
     const SparsityPatternSIMD<simd_length> *sparsity;
     dealii::AlignedVector<Number> data;
     dealii::AlignedVector<Number> exchange_buffer;
     std::vector<MPI_Request> requests;
-  };
-
-  /*
-   * Inline function  definitions:
-   */
-
-
-  template <int simd_length>
-  DEAL_II_ALWAYS_INLINE inline unsigned int
-  SparsityPatternSIMD<simd_length>::stride_of_row(const unsigned int row) const
-  {
-    AssertIndexRange(row, row_starts.size());
-
-    if (row < n_internal_dofs)
-      return simd_length;
-    else
-      return 1;
-  }
+    PersistentRequests persistent_requests;
+    SharedMemoryWindow<Number> shared_window;
 
+    GhostCompression ghost_compression;
+    int ghost_rounding;
+    std::vector<std::uint16_t> compressed_exchange_buffer;
+    std::vector<std::uint16_t> compressed_receive_buffer;
 
-  template <int simd_length>
-  DEAL_II_ALWAYS_INLINE inline const unsigned int *
-  SparsityPatternSIMD<simd_length>::columns(const unsigned int row) const
-  {
-    AssertIndexRange(row, row_starts.size() - 1);
+    bool transposed_ghost_exchange;
+    dealii::AlignedVector<Number> receive_buffer;
 
-    if (row < n_internal_dofs)
-      return column_indices.data() + row_starts[row / simd_length] +
-             row % simd_length;
-    else
-      return column_indices.data() + row_starts[row];
-  }
+    /**
+     * Return the indices to be sent, the send and receive targets, and
+     * the receive buffer of the exchange pattern selected with
+     * set_transposed_ghost_exchange().
+     */
+    const dealii::AlignedVector<std::size_t> &ghost_indices_to_be_sent() const
+    {
+      return transposed_ghost_exchange
+                 ? sparsity->transposed_indices_to_be_sent
+                 : sparsity->indices_to_be_sent;
+    }
 
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    ghost_send_targets() const
+    {
+      return transposed_ghost_exchange ? sparsity->transposed_send_targets
+                                       : sparsity->send_targets;
+    }
 
-  template <int simd_length>
-  DEAL_II_ALWAYS_INLINE inline unsigned int
-  SparsityPatternSIMD<simd_length>::row_length(const unsigned int row) const
-  {
-    AssertIndexRange(row, row_starts.size() - 1);
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    ghost_receive_targets() const
+    {
+      return transposed_ghost_exchange ? sparsity->transposed_receive_targets
+                                       : sparsity->receive_targets;
+    }
 
-    if (row < n_internal_dofs) {
-      const unsigned int simd_row = row / simd_length;
-      return (row_starts[simd_row + 1] - row_starts[simd_row]) / simd_length;
-    } else {
-      return row_starts[row + 1] - row_starts[row];
+    Number *ghost_receive_buffer()
+    {
+      if (transposed_ghost_exchange) {
+        receive_buffer.resize_fast(
+            n_components * sparsity->transposed_receive_positions.size());
+        return receive_buffer.data();
+      }
+      return data.data() +
+             n_components *
+                 sparsity->row_starts[sparsity->n_locally_owned_dofs];
     }
-  }
+  };
 
 
-  template <int simd_length>
-  DEAL_II_ALWAYS_INLINE inline unsigned int
-  SparsityPatternSIMD<simd_length>::n_rows() const
+  /**
+   * A specialized sparse matrix for efficient vectorized SIMD access of
+   * symmetric, scalar-valued matrices.
+   *
+   * In contrast to SparseMatrixSIMD every pair of transposed entries
+   * a_ij = a_ji is only stored once. The storage location of an entry is
+   * looked up with the help of a compressed index map precomputed in
+   * SparsityPatternSIMD. This roughly halves the memory footprint of the
+   * matrix. As a consequence, writing an entry a_ij also changes the
+   * transposed entry a_ji, and vectorized access is performed with gather
+   * and scatter operations.
+   *
+   * @note All off-diagonal entries of ghost rows share their storage
+   * location with the transposed entry of a locally owned row. The
+   * diagonal of ghost rows is not synchronized over MPI ranks.
+   */
+  template <typename Number, int simd_length>
+  class SymmetricSparseMatrixSIMD
   {
-    return row_starts.size() - 1;
-  }
+  public:
+    /**
+     * The matrix stores every pair of transposed entries only once.
+     */
+    static constexpr bool is_symmetric = true;
 
+    SymmetricSparseMatrixSIMD();
 
-  template <int simd_length>
-  DEAL_II_ALWAYS_INLINE inline std::size_t
-  SparsityPatternSIMD<simd_length>::n_nonzero_elements() const
-  {
-    Assert(row_starts.size() > 0, dealii::ExcNotInitialized());
+    SymmetricSparseMatrixSIMD(const SparsityPatternSIMD<simd_length> &sparsity);
 
-    return row_starts.back();
-  }
+    void reinit(const SparsityPatternSIMD<simd_length> &sparsity);
 
+    /**
+     * Read in a symmetric @p sparse_matrix. Only entries a_ij with j >= i
+     * are accessed.
+     */
+    template <typename SparseMatrix>
+    void read_in(const SparseMatrix &sparse_matrix,
+                 bool locally_indexed = true);
 
-  template <typename Number, int n_components, int simd_length>
-  template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline Number2
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_entry(
-      const unsigned int row, const unsigned int position_within_column) const
-  {
+    using VectorizedArray = dealii::VectorizedArray<Number, simd_length>;
+
+    /**
+     * return the (scalar) entry indexed by @p row and
+     * @p position_within_column.
+     *
+     * @note If the template argument @a Number2
+     * is a vetorized array a specialized, faster access will be performed.
+     * In this case the index @p row must be within the interval
+     * [0, n_internal_dofs) and must be divisible by simd_length.
+     */
+    template <typename Number2 = Number>
+    Number2 get_entry(const unsigned int row,
+                      const unsigned int position_within_column) const;
+
+    /**
+     * return the transposed (scalar) entry indexed by @p row and
+     * @p position_within_column. This is the same as get_entry().
+     */
+    template <typename Number2 = Number>
+    Number2
+    get_transposed_entry(const unsigned int row,
+                         const unsigned int position_within_column) const;
+
+    /**
+     * Write a (scalar valued) @p entry to the matrix indexed by @p row
+     * and @p position_within_column. This also sets the transposed
+     * entry.
+     *
+     * @note If the template argument @a Number2
+     * is a vetorized array a specialized, faster access will be performed.
+     * In this case the index @p row must be within the interval
+     * [0, n_internal_dofs) and must be divisible by simd_length.
+     *
+     * @note The parameter @p do_streaming_store is ignored. It is only
+     * provided for interface compatibility with SparseMatrixSIMD.
+     */
+    template <typename Number2 = Number>
+    void write_entry(const Number2 entry,
+                     const unsigned int row,
+                     const unsigned int position_within_column,
+                     const bool do_streaming_store = false);
+
+    /**
+     * @copydoc SparseMatrixSIMD::write_data()
+     */
+    void write_data(std::ostream &output) const;
+
+    /**
+     * @copydoc SparseMatrixSIMD::read_data()
+     */
+    void read_data(std::istream &input);
+
+    /**
+     * @copydoc SparseMatrixSIMD::memory_consumption()
+     */
+    std::size_t memory_consumption() const;
+
+  private:
+    const SparsityPatternSIMD<simd_length> *sparsity;
+    dealii::AlignedVector<Number> data;
+  };
+
+
+  /**
+   * A specialized sparse matrix for efficient vectorized SIMD access of
+   * vector-valued matrices that are skew-symmetric up to a small number
+   * of entries. The prime example is the c_ij matrix: For all pairs of
+   * degrees of freedom except the ones that are both located on the
+   * boundary we have c_ij = - c_ji.
+   *
+   * Every pair of transposed entries with c_ij = - c_ji is only stored
+   * once, all remaining entries (the diagonal and couplings between
+   * boundary degrees of freedom) have their own storage location. The
+   * storage location of every entry (and whether the stored value has to
+   * be negated) is recorded in a compressed index map that is computed in
+   * read_in(). This roughly halves the storage required for the matrix
+   * entries at the cost of an additional index map and gather access.
+   *
+   * The matrix is read-only after read_in(), which also sets up all ghost
+   * rows.
+   *
+   * Optionally (see set_stencil_compression()), read_in() furthermore
+   * merges all entries that agree up to round-off. On translation
+   * invariant (structured) meshes every stencil class then contributes
+   * only a handful of distinct values, so that the stored values fit
+   * into cache and the matrix traffic reduces to the index map.
+   */
+  template <typename Number, int n_components, int simd_length>
+  class SkewSymmetricSparseMatrixSIMD
+  {
+  public:
+    SkewSymmetricSparseMatrixSIMD();
+
+    SkewSymmetricSparseMatrixSIMD(
+        const SparsityPatternSIMD<simd_length> &sparsity);
+
+    void reinit(const SparsityPatternSIMD<simd_length> &sparsity);
+
+    /**
+     * Read in the components of a vector-valued matrix and compute the
+     * compressed index map. Entries c_ij and c_ji with c_ij = - c_ji (up
+     * to round-off) share a storage location.
+     *
+     * @note This function requires MPI communication for initializing
+     * ghost rows.
+     */
+    template <typename SparseMatrix>
+    void read_in(const std::array<SparseMatrix, n_components> &sparse_matrix,
+                 bool locally_indexed = true);
+
+    /**
+     * Compute the compressed index map from a matrix @p full_matrix with
+     * full SIMD storage and the same sparsity pattern. All ghost rows of
+     * @p full_matrix have to be up to date.
+     */
+    void read_in(const SparseMatrixSIMD<Number, n_components, simd_length>
+                     &full_matrix);
+
+    /**
+     * Enable or disable stencil compression for subsequent calls to
+     * read_in(). If enabled, all entries whose components agree up to
+     * 100 times the machine epsilon relative to the largest entry of the
+     * matrix (or up to sign), share a common storage location. The
+     * default is false.
+     */
+    void set_stencil_compression(const bool compress)
+    {
+      stencil_compression = compress;
+    }
+
+    /**
+     * Return the number of distinct (tensor-valued) entries that are
+     * stored.
+     */
+    std::size_t n_stored_entries() const
+    {
+      return data.size() / n_components;
+    }
+
+    using VectorizedArray = dealii::VectorizedArray<Number, simd_length>;
+
+    /**
+     * Return the tensor-valued entry indexed by @p row and
+     * @p position_within_column. See SparseMatrixSIMD::get_tensor().
+     */
+    template <typename Number2 = Number>
+    dealii::Tensor<1, n_components, Number2>
+    get_tensor(const unsigned int row,
+               const unsigned int position_within_column) const;
+
+    /**
+     * Return the transposed tensor-valued entry indexed by @p row and
+     * @p position_within_column. See
+     * SparseMatrixSIMD::get_transposed_tensor().
+     */
+    template <typename Number2 = Number>
+    dealii::Tensor<1, n_components, Number2>
+    get_transposed_tensor(const unsigned int row,
+                          const unsigned int position_within_column) const;
+
+    /**
+     * @copydoc SparseMatrixSIMD::prefetch()
+     */
+    template <typename Number2 = Number>
+    void prefetch(const unsigned int row,
+                  const unsigned int position_within_column) const;
+
+    /**
+     * Ghost rows are already populated by read_in(). This function is
+     * only provided for interface compatibility with SparseMatrixSIMD.
+     */
+    void update_ghost_rows()
+    {
+    }
+
+    /**
+     * @copydoc SparseMatrixSIMD::write_data()
+     *
+     * In addition to the matrix entries the compressed index map is
+     * written.
+     */
+    void write_data(std::ostream &output) const;
+
+    /**
+     * @copydoc SparseMatrixSIMD::read_data()
+     */
+    void read_data(std::istream &input);
+
+    /**
+     * @copydoc SparseMatrixSIMD::memory_consumption()
+     */
+    std::size_t memory_consumption() const;
+
+  private:
+    /**
+     * The most significant bit of an entry of the index map marks that
+     * the stored value has to be negated.
+     */
+    static constexpr unsigned int sign_bit = 1u << 31;
+
+    /**
+     * Return the position of the entry (@p row, @p position_within_column)
+     * in the index map.
+     */
+    std::size_t index_of(const unsigned int row,
+                         const unsigned int position_within_column) const;
+
+    /**
+     * Return the entry stored for the position @p index of the index map.
+     */
+    template <typename Number2>
+    dealii::Tensor<1, n_components, Number2>
+    get_tensor_at(const std::size_t index) const;
+
+    const SparsityPatternSIMD<simd_length> *sparsity;
+    dealii::AlignedVector<unsigned int> indices;
+    dealii::AlignedVector<Number> data;
+    bool stencil_compression;
+  };
+
+  /*
+   * Inline function  definitions:
+   */
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::stride_of_row(const unsigned int row) const
+  {
+    AssertIndexRange(row, row_starts.size());
+
+    if (row < n_internal_dofs)
+      return simd_length;
+    else
+      return 1;
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SparsityPatternSIMD<simd_length>::columns(const unsigned int row) const
+  {
+    AssertIndexRange(row, row_starts.size() - 1);
+
+    if (row < n_internal_dofs)
+      return column_indices.data() + row_starts[row / simd_length] +
+             row % simd_length;
+    else
+      return column_indices.data() + row_starts[row];
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SparsityPatternSIMD<simd_length>::columns(const unsigned int row,
+                                            unsigned int *buffer) const
+  {
+#ifdef COMPRESSED_COLUMN_INDICES
+    AssertIndexRange(row, row_starts.size() - 1);
+
+    if (row < n_internal_dofs) {
+      const unsigned int simd_row = row / simd_length;
+      const unsigned int first_row = simd_row * simd_length;
+      const std::size_t offset = row_starts[simd_row];
+      const unsigned int n_entries = row_starts[simd_row + 1] - offset;
+      const std::int16_t *deltas = column_deltas.data() + offset;
+
+      for (unsigned int e = 0; e < n_entries; ++e) {
+        const int delta = deltas[e];
+        buffer[e] = delta != escape_delta
+                        ? first_row + e % simd_length + delta
+                        : column_indices[offset + e];
+      }
+      return buffer + row % simd_length;
+
+    } else {
+      const std::size_t offset = row_starts[row];
+      const unsigned int n_entries = row_starts[row + 1] - offset;
+      const std::int16_t *deltas = column_deltas.data() + offset;
+
+      for (unsigned int e = 0; e < n_entries; ++e) {
+        const int delta = deltas[e];
+        buffer[e] = delta != escape_delta ? row + delta
+                                          : column_indices[offset + e];
+      }
+      return buffer;
+    }
+#else
+    (void)buffer;
+    return columns(row);
+#endif
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::column_at(const std::size_t position,
+                                              const unsigned int row) const
+  {
+    AssertIndexRange(position, column_indices.size());
+
+#ifdef COMPRESSED_COLUMN_INDICES
+    const int delta = column_deltas[position];
+    return delta != escape_delta ? row + delta : column_indices[position];
+#else
+    (void)row;
+    return column_indices[position];
+#endif
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::row_length(const unsigned int row) const
+  {
+    AssertIndexRange(row, row_starts.size() - 1);
+
+    if (row < n_internal_dofs) {
+      const unsigned int simd_row = row / simd_length;
+      return (row_starts[simd_row + 1] - row_starts[simd_row]) / simd_length;
+    } else {
+      return row_starts[row + 1] - row_starts[row];
+    }
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::column_buffer_size() const
+  {
+#ifdef COMPRESSED_COLUMN_INDICES
+    return max_entries_per_row * simd_length;
+#else
+    return 0;
+#endif
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::n_rows() const
+  {
+    return row_starts.size() - 1;
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline std::size_t
+  SparsityPatternSIMD<simd_length>::n_nonzero_elements() const
+  {
+    Assert(row_starts.size() > 0, dealii::ExcNotInitialized());
+
+    return row_starts.back();
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline unsigned int
+  SparsityPatternSIMD<simd_length>::n_edge_batches(
+      const unsigned int row) const
+  {
+    AssertIndexRange(row, n_internal_dofs);
+    Assert(row % simd_length == 0, dealii::ExcInternalError());
+
+    const unsigned int simd_row = row / simd_length;
+    return edge_starts[simd_row + 1] - edge_starts[simd_row];
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SparsityPatternSIMD<simd_length>::edge_positions(
+      const unsigned int row) const
+  {
+    AssertIndexRange(row, n_internal_dofs);
+    Assert(row % simd_length == 0, dealii::ExcInternalError());
+
+    return edge_batches.data() +
+           std::size_t(edge_starts[row / simd_length]) * simd_length;
+  }
+
+
+  template <int simd_length>
+  DEAL_II_ALWAYS_INLINE inline const unsigned int *
+  SparsityPatternSIMD<simd_length>::active_rows() const
+  {
+    return active_row_indices.data();
+  }
+
+
+  template <int simd_length>
+  inline unsigned int SparsityPatternSIMD<simd_length>::active_position(
+      const unsigned int row) const
+  {
+    AssertIndexRange(row, n_locally_owned_dofs + 1);
+
+    return std::lower_bound(active_row_indices.begin(),
+                            active_row_indices.end(),
+                            row) -
+           active_row_indices.begin();
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SparseMatrixSIMD<Number, n_components, simd_length>::get_entry(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
     return get_tensor<Number2>(row, position_within_column)[0];
   }
 
 
-  template <typename Number, int n_components, int simd_length>
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
+  SparseMatrixSIMD<Number, n_components, simd_length>::get_tensor(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
+
+    dealii::Tensor<1, n_components, Number2> result;
+
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+      if (row < sparsity->n_internal_dofs) {
+        // go through vectorized part
+        const unsigned int simd_row = row / simd_length;
+        const unsigned int simd_offset = row % simd_length;
+        for (unsigned int d = 0; d < n_components; ++d)
+          result[d] = data[(sparsity->row_starts[simd_row] +
+                            position_within_column * simd_length) *
+                               n_components +
+                           d * simd_length + simd_offset];
+      } else {
+        // go through standard part
+        for (unsigned int d = 0; d < n_components; ++d)
+          result[d] =
+              data[(sparsity->row_starts[row] + position_within_column) *
+                       n_components +
+                   d];
+      }
+
+    } else if constexpr (Number2::size() == simd_length) {
+      /*
+       * Vectorized fast access. Indices must be in the range
+       * [0,n_internal), index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      const Number *load_pos =
+          data.data() + (sparsity->row_starts[row / simd_length] +
+                         position_within_column * simd_length) *
+                            n_components;
+
+      if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+        for (unsigned int d = 0; d < n_components; ++d)
+          result[d].load(load_pos + d * simd_length);
+      } else {
+        /* Convert from the storage type on the fly: */
+        for (unsigned int d = 0; d < n_components; ++d)
+          for (unsigned int k = 0; k < simd_length; ++k)
+            result[d][k] = load_pos[d * simd_length + k];
+      }
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+
+    return result;
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_entry(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    return get_transposed_tensor<Number2>(row, position_within_column)[0];
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
+  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_tensor(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
+
+    dealii::Tensor<1, n_components, Number2> result;
+
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+
+      if (row < sparsity->n_internal_dofs) {
+        // go through vectorized part
+        const unsigned int simd_row = row / simd_length;
+        const unsigned int simd_offset = row % simd_length;
+        const std::size_t index =
+            sparsity->indices_transposed[sparsity->row_starts[simd_row] +
+                                         simd_offset +
+                                         position_within_column * simd_length];
+        if (n_components > 1) {
+          const unsigned int col = sparsity->column_at(
+              sparsity->row_starts[simd_row] + simd_offset +
+                  position_within_column * simd_length,
+              row);
+          if (col < sparsity->n_internal_dofs)
+            for (unsigned int d = 0; d < n_components; ++d)
+              result[d] =
+                  data[index / simd_length * simd_length * n_components +
+                       simd_length * d + index % simd_length];
+          else
+            for (unsigned int d = 0; d < n_components; ++d)
+              result[d] = data[index * n_components + d];
+        } else
+          result[0] = data[index];
+      } else {
+        // go through standard part
+        const std::size_t index =
+            sparsity->indices_transposed[sparsity->row_starts[row] +
+                                         position_within_column];
+        if (n_components > 1) {
+          const unsigned int col = sparsity->column_at(
+              sparsity->row_starts[row] + position_within_column, row);
+          if (col < sparsity->n_internal_dofs)
+            for (unsigned int d = 0; d < n_components; ++d)
+              result[d] =
+                  data[index / simd_length * simd_length * n_components +
+                       simd_length * d + index % simd_length];
+          else
+            for (unsigned int d = 0; d < n_components; ++d)
+              result[d] = data[index * n_components + d];
+        } else
+          result[0] = data[index];
+      }
+
+    } else if constexpr ((Number2::size() == simd_length) &&
+                         (n_components == 1)) {
+      /*
+       * Vectorized fast access. Indices must be in the range
+       * [0,n_internal), index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      const unsigned int offset = sparsity->row_starts[row / simd_length] +
+                                  position_within_column * simd_length;
+      const unsigned int *indices =
+          sparsity->indices_transposed.data() + offset;
+      if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+        result[0].gather(data.data(), indices);
+      } else {
+        /* Convert from the storage type on the fly: */
+        for (unsigned int k = 0; k < simd_length; ++k)
+          result[0][k] = data[indices[k]];
+      }
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+
+    return result;
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::prefetch(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+#if PREFETCH_DISTANCE > 0
+    if (row < sparsity->n_internal_dofs) {
+      const std::size_t index = sparsity->row_starts[row / simd_length] +
+                                position_within_column * simd_length;
+      const unsigned int n_lanes = get_stride_size<Number2>;
+      prefetch_range(data.data() + index * n_components + row % simd_length,
+                     (simd_length * (n_components - 1) + n_lanes) *
+                         sizeof(Number));
+    } else {
+      const std::size_t index =
+          sparsity->row_starts[row] + position_within_column;
+      prefetch_range(data.data() + index * n_components,
+                     n_components * sizeof(Number));
+    }
+#else
+    (void)row;
+    (void)position_within_column;
+#endif
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::write_entry(
+      const Number2 entry,
+      const unsigned int row,
+      const unsigned int position_within_column,
+      const bool do_streaming_store)
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
+
+    dealii::Tensor<1, n_components, Number2> result;
+    result[0] = entry;
+
+    write_tensor<Number2>(
+        result, row, position_within_column, do_streaming_store);
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::write_tensor(
+      const dealii::Tensor<1, n_components, Number2> &entry,
+      const unsigned int row,
+      const unsigned int position_within_column,
+      const bool do_streaming_store)
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
+
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+
+      if (row < sparsity->n_internal_dofs) {
+        // go through vectorized part
+        const unsigned int simd_row = row / simd_length;
+        const unsigned int simd_offset = row % simd_length;
+        for (unsigned int d = 0; d < n_components; ++d)
+          data[(sparsity->row_starts[simd_row] +
+                position_within_column * simd_length) *
+                   n_components +
+               d * simd_length + simd_offset] = entry[d];
+      } else {
+        // go through standard part
+        for (unsigned int d = 0; d < n_components; ++d)
+          data[(sparsity->row_starts[row] + position_within_column) *
+                   n_components +
+               d] = entry[d];
+      }
+
+    } else if constexpr (Number2::size() == simd_length) {
+      /*
+       * Vectorized fast access. Indices must be in the range
+       * [0,n_internal), index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      Number *store_pos =
+          data.data() + (sparsity->row_starts[row / simd_length] +
+                         position_within_column * simd_length) *
+                            n_components;
+      if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+        if (do_streaming_store)
+          for (unsigned int d = 0; d < n_components; ++d)
+            entry[d].streaming_store(store_pos + d * simd_length);
+        else
+          for (unsigned int d = 0; d < n_components; ++d)
+            entry[d].store(store_pos + d * simd_length);
+      } else {
+        /* Convert to the storage type on the fly: */
+        for (unsigned int d = 0; d < n_components; ++d)
+          for (unsigned int k = 0; k < simd_length; ++k)
+            store_pos[d * simd_length + k] = entry[d][k];
+      }
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Number, int simd_length>
   template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_tensor(
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SymmetricSparseMatrixSIMD<Number, simd_length>::get_entry(
       const unsigned int row, const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
     AssertIndexRange(row, sparsity->row_starts.size() - 1);
     AssertIndexRange(position_within_column, sparsity->row_length(row));
 
-    dealii::Tensor<1, n_components, Number2> result;
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
+      /*
+       * Non-vectorized slow access. Supports all row indices in
+       * [0,n_owned)
+       */
+      std::size_t index;
+      if (row < sparsity->n_internal_dofs) {
+        // go through vectorized part
+        const unsigned int simd_row = row / simd_length;
+        const unsigned int simd_offset = row % simd_length;
+        index = sparsity->row_starts[simd_row] + simd_offset +
+                position_within_column * simd_length;
+      } else {
+        // go through standard part
+        index = sparsity->row_starts[row] + position_within_column;
+      }
+      return data[sparsity->indices_symmetric[index]];
+
+    } else if constexpr (Number2::size() == simd_length) {
+      /*
+       * Vectorized fast access. Indices must be in the range
+       * [0,n_internal), index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      const std::size_t offset = sparsity->row_starts[row / simd_length] +
+                                 position_within_column * simd_length;
+      const unsigned int *indices = sparsity->indices_symmetric.data() + offset;
+      Number2 result;
+      if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+        result.gather(data.data(), indices);
+      } else {
+        /* Convert from the storage type on the fly: */
+        for (unsigned int k = 0; k < simd_length; ++k)
+          result[k] = data[indices[k]];
+      }
+      return result;
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Number, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline Number2
+  SymmetricSparseMatrixSIMD<Number, simd_length>::get_transposed_entry(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    return get_entry<Number2>(row, position_within_column);
+  }
+
+
+  template <typename Number, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SymmetricSparseMatrixSIMD<Number, simd_length>::write_entry(
+      const Number2 entry,
+      const unsigned int row,
+      const unsigned int position_within_column,
+      const bool /*do_streaming_store*/)
+  {
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
 
-    if constexpr (std::is_same<Number, Number2>::value) {
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
       /*
        * Non-vectorized slow access. Supports all row indices in
        * [0,n_owned)
        */
+      std::size_t index;
       if (row < sparsity->n_internal_dofs) {
         // go through vectorized part
         const unsigned int simd_row = row / simd_length;
         const unsigned int simd_offset = row % simd_length;
-        for (unsigned int d = 0; d < n_components; ++d)
-          result[d] = data[(sparsity->row_starts[simd_row] +
-                            position_within_column * simd_length) *
-                               n_components +
-                           d * simd_length + simd_offset];
+        index = sparsity->row_starts[simd_row] + simd_offset +
+                position_within_column * simd_length;
       } else {
         // go through standard part
-        for (unsigned int d = 0; d < n_components; ++d)
-          result[d] =
-              data[(sparsity->row_starts[row] + position_within_column) *
-                       n_components +
-                   d];
+        index = sparsity->row_starts[row] + position_within_column;
+      }
+      data[sparsity->indices_symmetric[index]] = entry;
+
+    } else if constexpr (Number2::size() == simd_length) {
+      /*
+       * Vectorized fast access. Indices must be in the range
+       * [0,n_internal), index must be divisible by simd_length
+       */
+
+      Assert(row < sparsity->n_internal_dofs,
+             dealii::ExcMessage(
+                 "Vectorized access only possible in vectorized part"));
+      Assert(row % simd_length == 0,
+             dealii::ExcMessage(
+                 "Access only supported for rows at the SIMD granularity"));
+
+      const std::size_t offset = sparsity->row_starts[row / simd_length] +
+                                 position_within_column * simd_length;
+      const unsigned int *indices = sparsity->indices_symmetric.data() + offset;
+      if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+        entry.scatter(indices, data.data());
+      } else {
+        /* Convert to the storage type on the fly: */
+        for (unsigned int k = 0; k < simd_length; ++k)
+          data[indices[k]] = entry[k];
+      }
+
+    } else {
+      /* not implemented */
+      __builtin_trap();
+    }
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+      initialize_persistent_ghost_rows(const unsigned int communication_channel)
+  {
+    persistent_requests.clear();
+
+#ifdef DEAL_II_WITH_MPI
+    AssertIndexRange(communication_channel, 200);
+
+    const unsigned int mpi_tag =
+        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+        communication_channel;
+    Assert(mpi_tag <=
+               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
+           dealii::ExcInternalError());
+
+    const std::size_t n_indices = ghost_indices_to_be_sent().size();
+    exchange_buffer.resize_fast(n_components * n_indices);
+    Number *receive_base = ghost_receive_buffer();
+
+    const auto &receive_targets = ghost_receive_targets();
+    const auto &send_targets = ghost_send_targets();
+    std::vector<MPI_Request> new_requests(receive_targets.size() +
+                                          send_targets.size());
+    {
+      const auto &targets = receive_targets;
+      for (unsigned int p = 0; p < targets.size(); ++p) {
+        const int ierr = MPI_Recv_init(
+            receive_base +
+                n_components * (p == 0 ? 0 : targets[p - 1].second),
+            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+                n_components * sizeof(Number),
+            MPI_BYTE,
+            targets[p].first,
+            mpi_tag,
+            sparsity->mpi_communicator,
+            &new_requests[p]);
+        AssertThrowMPI(ierr);
+      }
+    }
+
+    {
+      const auto &targets = send_targets;
+      for (unsigned int p = 0; p < targets.size(); ++p) {
+        const int ierr = MPI_Send_init(
+            exchange_buffer.data() +
+                n_components * (p == 0 ? 0 : targets[p - 1].second),
+            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+                n_components * sizeof(Number),
+            MPI_BYTE,
+            targets[p].first,
+            mpi_tag,
+            sparsity->mpi_communicator,
+            &new_requests[p + receive_targets.size()]);
+        AssertThrowMPI(ierr);
+      }
+    }
+
+    persistent_requests.requests.swap(new_requests);
+#endif
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+      initialize_shared_memory_ghost_rows(
+          const unsigned int communication_channel)
+  {
+    persistent_requests.clear();
+    shared_window.clear();
+
+#ifdef DEAL_II_WITH_MPI
+    AssertIndexRange(communication_channel, 200);
+
+    const unsigned int mpi_tag =
+        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+        communication_channel;
+    Assert(mpi_tag <=
+               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
+           dealii::ExcInternalError());
+
+    const auto &communicator = sparsity->mpi_communicator;
+    const auto &receive_targets = ghost_receive_targets();
+    const auto &send_targets = ghost_send_targets();
+
+    auto &window = shared_window;
+    window.mpi_tag = mpi_tag;
+
+    int ierr = MPI_Comm_split_type(communicator,
+                                   MPI_COMM_TYPE_SHARED,
+                                   /*key*/ 0,
+                                   MPI_INFO_NULL,
+                                   &window.node_communicator);
+    AssertThrowMPI(ierr);
+
+    /* Translate the ranks of all targets into ranks on the node: */
+
+    const auto translate_ranks = [&](const auto &targets) {
+      std::vector<int> ranks(targets.size());
+      std::vector<int> node_ranks(targets.size());
+      for (unsigned int p = 0; p < targets.size(); ++p)
+        ranks[p] = targets[p].first;
+
+      MPI_Group group, node_group;
+      int ierr = MPI_Comm_group(communicator, &group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Comm_group(window.node_communicator, &node_group);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Group_translate_ranks(
+          group, ranks.size(), ranks.data(), node_group, node_ranks.data());
+      AssertThrowMPI(ierr);
+      MPI_Group_free(&group);
+      MPI_Group_free(&node_group);
+      return node_ranks;
+    };
+
+    const auto receive_node_ranks = translate_ranks(receive_targets);
+    const auto send_node_ranks = translate_ranks(send_targets);
+
+    /* Allocate two export buffers in the shared memory window: */
+
+    window.buffer_size = n_components * ghost_indices_to_be_sent().size();
+    ierr = MPI_Win_allocate_shared(2 * window.buffer_size * sizeof(Number),
+                                   sizeof(Number),
+                                   MPI_INFO_NULL,
+                                   window.node_communicator,
+                                   &window.buffer,
+                                   &window.window);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK, window.window);
+    AssertThrowMPI(ierr);
+
+    /*
+     * Every intra-node sender tells the receiver where the entries
+     * destined for the receiver start within its export buffer:
+     */
+
+    std::vector<unsigned int> receive_offsets(receive_targets.size());
+    std::vector<unsigned int> send_offsets(send_targets.size());
+    std::vector<MPI_Request> offset_requests;
+
+    for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+      if (receive_node_ranks[p] == MPI_UNDEFINED) {
+        window.remote_receive_targets.push_back(p);
+        continue;
+      }
+      offset_requests.emplace_back();
+      ierr = MPI_Irecv(&receive_offsets[p],
+                       1,
+                       MPI_UNSIGNED,
+                       receive_targets[p].first,
+                       mpi_tag,
+                       communicator,
+                       &offset_requests.back());
+      AssertThrowMPI(ierr);
+    }
+
+    for (unsigned int p = 0; p < send_targets.size(); ++p) {
+      if (send_node_ranks[p] == MPI_UNDEFINED) {
+        window.remote_send_targets.push_back(p);
+        continue;
+      }
+      send_offsets[p] = p == 0 ? 0 : send_targets[p - 1].second;
+      offset_requests.emplace_back();
+      ierr = MPI_Isend(&send_offsets[p],
+                       1,
+                       MPI_UNSIGNED,
+                       send_targets[p].first,
+                       mpi_tag,
+                       communicator,
+                       &offset_requests.back());
+      AssertThrowMPI(ierr);
+    }
+
+    ierr = MPI_Waitall(offset_requests.size(),
+                       offset_requests.data(),
+                       MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+
+    /*
+     * Look up the export buffers of all intra-node senders. The offsets
+     * of the receives are relative to ghost_receive_buffer():
+     */
+
+    for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+      if (receive_node_ranks[p] == MPI_UNDEFINED)
+        continue;
+
+      MPI_Aint size;
+      int disp_unit;
+      Number *base;
+      ierr = MPI_Win_shared_query(
+          window.window, receive_node_ranks[p], &size, &disp_unit, &base);
+      AssertThrowMPI(ierr);
+
+      const std::size_t sender_buffer_size = size / (2 * sizeof(Number));
+      const std::size_t offset = n_components * receive_offsets[p];
+      const std::size_t first = p == 0 ? 0 : receive_targets[p - 1].second;
+
+      window.receives.push_back(
+          {{{base + offset, base + sender_buffer_size + offset}},
+           n_components * first,
+           n_components * (receive_targets[p].second - first)});
+    }
+#else
+    (void)communication_channel;
+#endif
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::set_ghost_compression(
+      const GhostCompression compression, const int direction)
+  {
+    AssertThrow(compression == GhostCompression::none ||
+                    std::is_floating_point_v<Number>,
+                dealii::ExcMessage("Reduced precision ghost rows require a "
+                                   "floating point number type"));
+    ghost_compression = compression;
+    ghost_rounding = direction;
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+      set_transposed_ghost_exchange(const bool transposed_only)
+  {
+    Assert(persistent_requests.requests.empty() && shared_window.empty(),
+           dealii::ExcMessage("The ghost exchange pattern has to be selected "
+                              "before persistent requests or the shared "
+                              "memory exchange are initialized"));
+    transposed_ghost_exchange = transposed_only;
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows_start(
+      const unsigned int communication_channel)
+  {
+#ifdef DEAL_II_WITH_MPI
+    AssertIndexRange(communication_channel, 200);
+
+    const unsigned int mpi_tag =
+        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
+        communication_channel;
+    Assert(mpi_tag <=
+               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
+           dealii::ExcInternalError());
+
+    const auto &indices_to_be_sent = ghost_indices_to_be_sent();
+    const std::size_t n_indices = indices_to_be_sent.size();
+    const auto &receive_targets = ghost_receive_targets();
+    const auto &send_targets = ghost_send_targets();
+
+    if (ghost_compression != GhostCompression::none) {
+      Assert(persistent_requests.requests.empty() && shared_window.empty(),
+             dealii::ExcMessage("Reduced precision ghost rows cannot be "
+                                "combined with persistent requests or the "
+                                "shared memory exchange"));
+      if constexpr (std::is_floating_point_v<Number>) {
+        using namespace GhostCompressionImplementation;
+        const unsigned int words = n_words(ghost_compression);
+
+        const std::size_t n_ghost_entries =
+            receive_targets.empty() ? 0 : receive_targets.back().second;
+
+        compressed_receive_buffer.resize(words * n_components *
+                                         n_ghost_entries);
+        compressed_exchange_buffer.resize(words * n_components * n_indices);
+        requests.resize(receive_targets.size() + send_targets.size());
+
+        for (unsigned int p = 0; p < receive_targets.size(); ++p) {
+          const auto first = p == 0 ? 0 : receive_targets[p - 1].second;
+          const int ierr = MPI_Irecv(
+              compressed_receive_buffer.data() + words * n_components * first,
+              words * n_components * (receive_targets[p].second - first),
+              MPI_UINT16_T,
+              receive_targets[p].first,
+              mpi_tag,
+              sparsity->mpi_communicator,
+              &requests[p]);
+          AssertThrowMPI(ierr);
+        }
+
+        for (std::size_t c = 0; c < n_indices; ++c)
+          for (unsigned int comp = 0; comp < n_components; ++comp) {
+            auto &entry =
+                data[n_components * indices_to_be_sent[c] + comp];
+            entry = encode(entry,
+                           ghost_compression,
+                           ghost_rounding,
+                           compressed_exchange_buffer.data() +
+                               words * (n_components * c + comp));
+          }
+
+        for (unsigned int p = 0; p < send_targets.size(); ++p) {
+          const auto first = p == 0 ? 0 : send_targets[p - 1].second;
+          const int ierr = MPI_Isend(
+              compressed_exchange_buffer.data() + words * n_components * first,
+              words * n_components * (send_targets[p].second - first),
+              MPI_UINT16_T,
+              send_targets[p].first,
+              mpi_tag,
+              sparsity->mpi_communicator,
+              &requests[p + receive_targets.size()]);
+          AssertThrowMPI(ierr);
+        }
+      }
+      return;
+    }
+
+    if (!shared_window.empty()) {
+      auto &window = shared_window;
+      Number *export_buffer =
+          window.buffer + window.parity * window.buffer_size;
+
+      for (std::size_t c = 0; c < n_indices; ++c)
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          export_buffer[n_components * c + comp] =
+              data[n_components * indices_to_be_sent[c] + comp];
+
+      /* Publish the export buffer to all ranks on the node: */
+      int ierr = MPI_Win_sync(window.window);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Barrier(window.node_communicator);
+      AssertThrowMPI(ierr);
+      ierr = MPI_Win_sync(window.window);
+      AssertThrowMPI(ierr);
+
+      Number *receive_base = ghost_receive_buffer();
+      requests.resize(window.remote_receive_targets.size() +
+                      window.remote_send_targets.size());
+      auto request = requests.begin();
+
+      for (const auto p : window.remote_receive_targets) {
+        const auto first = p == 0 ? 0 : receive_targets[p - 1].second;
+        ierr = MPI_Irecv(
+            receive_base + n_components * first,
+            (receive_targets[p].second - first) * n_components *
+                sizeof(Number),
+            MPI_BYTE,
+            receive_targets[p].first,
+            window.mpi_tag,
+            sparsity->mpi_communicator,
+            &*request++);
+        AssertThrowMPI(ierr);
+      }
+
+      for (const auto p : window.remote_send_targets) {
+        const auto first = p == 0 ? 0 : send_targets[p - 1].second;
+        ierr = MPI_Isend(export_buffer + n_components * first,
+                         (send_targets[p].second - first) * n_components *
+                             sizeof(Number),
+                         MPI_BYTE,
+                         send_targets[p].first,
+                         window.mpi_tag,
+                         sparsity->mpi_communicator,
+                         &*request++);
+        AssertThrowMPI(ierr);
+      }
+      return;
+    }
+
+    if (!persistent_requests.requests.empty()) {
+      for (std::size_t c = 0; c < n_indices; ++c)
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          exchange_buffer[n_components * c + comp] =
+              data[n_components * indices_to_be_sent[c] + comp];
+
+      const int ierr = MPI_Startall(persistent_requests.requests.size(),
+                                    persistent_requests.requests.data());
+      AssertThrowMPI(ierr);
+      return;
+    }
+
+    exchange_buffer.resize_fast(n_components * n_indices);
+    Number *receive_base = ghost_receive_buffer();
+
+    requests.resize(receive_targets.size() + send_targets.size());
+    {
+      const auto &targets = receive_targets;
+      for (unsigned int p = 0; p < targets.size(); ++p) {
+        const int ierr = MPI_Irecv(
+            receive_base +
+                n_components * (p == 0 ? 0 : targets[p - 1].second),
+            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+                n_components * sizeof(Number),
+            MPI_BYTE,
+            targets[p].first,
+            mpi_tag,
+            sparsity->mpi_communicator,
+            &requests[p]);
+        AssertThrowMPI(ierr);
+      }
+    }
+
+    for (std::size_t c = 0; c < n_indices; ++c)
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        exchange_buffer[n_components * c + comp] =
+            data[n_components * indices_to_be_sent[c] + comp];
+
+    {
+      const auto &targets = send_targets;
+      for (unsigned int p = 0; p < targets.size(); ++p) {
+        const int ierr = MPI_Isend(
+            exchange_buffer.data() +
+                n_components * (p == 0 ? 0 : targets[p - 1].second),
+            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
+                n_components * sizeof(Number),
+            MPI_BYTE,
+            targets[p].first,
+            mpi_tag,
+            sparsity->mpi_communicator,
+            &requests[p + receive_targets.size()]);
+        AssertThrowMPI(ierr);
+      }
+    }
+#endif
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
+      update_ghost_rows_finish()
+  {
+#ifdef DEAL_II_WITH_MPI
+    auto &active_requests = persistent_requests.requests.empty()
+                                ? requests
+                                : persistent_requests.requests;
+    const int ierr = MPI_Waitall(active_requests.size(),
+                                 active_requests.data(),
+                                 MPI_STATUSES_IGNORE);
+    AssertThrowMPI(ierr);
+
+    if constexpr (std::is_floating_point_v<Number>) {
+      if (ghost_compression != GhostCompression::none) {
+        using namespace GhostCompressionImplementation;
+        const unsigned int words = n_words(ghost_compression);
+        Number *receive_base = ghost_receive_buffer();
+        const std::size_t n_entries = compressed_receive_buffer.size() / words;
+
+        for (std::size_t k = 0; k < n_entries; ++k)
+          receive_base[k] = decode<Number>(
+              compressed_receive_buffer.data() + words * k, ghost_compression);
       }
+    }
 
-    } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+    if (!shared_window.empty()) {
       /*
-       * Vectorized fast access. Indices must be in the range
-       * [0,n_internal), index must be divisible by simd_length
+       * Copy ghost rows owned by ranks on the same node directly out of
+       * their export buffers. The owner will only overwrite this export
+       * buffer again in the exchange after the next one, i.e., after we
+       * passed the barrier of the next exchange:
        */
+      auto &window = shared_window;
+      Number *receive_base = ghost_receive_buffer();
+      for (const auto &[sources, offset, size] : window.receives)
+        std::copy(sources[window.parity],
+                  sources[window.parity] + size,
+                  receive_base + offset);
+      window.parity ^= 1;
+    }
 
-      Assert(row < sparsity->n_internal_dofs,
-             dealii::ExcMessage(
-                 "Vectorized access only possible in vectorized part"));
-      Assert(row % simd_length == 0,
-             dealii::ExcMessage(
-                 "Access only supported for rows at the SIMD granularity"));
+    if (transposed_ghost_exchange) {
+      const auto &positions = sparsity->transposed_receive_positions;
+      for (std::size_t k = 0; k < positions.size(); ++k)
+        for (unsigned int comp = 0; comp < n_components; ++comp)
+          data[n_components * positions[k] + comp] =
+              receive_buffer[n_components * k + comp];
+    }
+#endif
+  }
 
-      const Number *load_pos =
-          data.data() + (sparsity->row_starts[row / simd_length] +
-                         position_within_column * simd_length) *
-                            n_components;
 
-      for (unsigned int d = 0; d < n_components; ++d)
-        result[d].load(load_pos + d * simd_length);
+  template <typename Number, int n_components, int simd_length>
+  inline void
+  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows()
+  {
+    update_ghost_rows_start();
+    update_ghost_rows_finish();
+  }
 
-    } else {
-      /* not implemented */
-      __builtin_trap();
-    }
 
-    return result;
+
+  template <int simd_length>
+  inline std::size_t
+  SparsityPatternSIMD<simd_length>::memory_consumption() const
+  {
+    return row_starts.memory_consumption() +
+           column_indices.memory_consumption() +
+           indices_transposed.memory_consumption() +
+#ifdef COMPRESSED_COLUMN_INDICES
+           column_deltas.memory_consumption() +
+#endif
+           indices_symmetric.memory_consumption() +
+           edge_starts.memory_consumption() +
+           edge_batches.memory_consumption() +
+           active_row_indices.memory_consumption() +
+           indices_to_be_sent.memory_consumption() +
+           send_targets.capacity() * sizeof(send_targets[0]) +
+           receive_targets.capacity() * sizeof(receive_targets[0]) +
+           transposed_indices_to_be_sent.memory_consumption() +
+           transposed_send_targets.capacity() *
+               sizeof(transposed_send_targets[0]) +
+           transposed_receive_targets.capacity() *
+               sizeof(transposed_receive_targets[0]) +
+           transposed_receive_positions.memory_consumption();
   }
 
 
   template <typename Number, int n_components, int simd_length>
-  template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline Number2
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_entry(
-      const unsigned int row, const unsigned int position_within_column) const
+  inline std::size_t
+  SparseMatrixSIMD<Number, n_components, simd_length>::memory_consumption()
+      const
   {
-    return get_transposed_tensor<Number2>(row, position_within_column)[0];
+    return data.memory_consumption() + exchange_buffer.memory_consumption() +
+           receive_buffer.memory_consumption();
   }
 
 
   template <typename Number, int n_components, int simd_length>
-  template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
-  SparseMatrixSIMD<Number, n_components, simd_length>::get_transposed_tensor(
-      const unsigned int row, const unsigned int position_within_column) const
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::write_data(
+      std::ostream &output) const
   {
-    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
-    AssertIndexRange(row, sparsity->row_starts.size() - 1);
-    AssertIndexRange(position_within_column, sparsity->row_length(row));
+    const std::array<std::size_t, 2> header{sizeof(Number), data.size()};
+    output.write(reinterpret_cast<const char *>(header.data()),
+                 sizeof(header));
+    output.write(reinterpret_cast<const char *>(data.data()),
+                 data.size() * sizeof(Number));
+  }
 
-    dealii::Tensor<1, n_components, Number2> result;
 
-    if constexpr (std::is_same<Number, Number2>::value) {
-      /*
-       * Non-vectorized slow access. Supports all row indices in
-       * [0,n_owned)
-       */
+  template <typename Number, int n_components, int simd_length>
+  inline void SparseMatrixSIMD<Number, n_components, simd_length>::read_data(
+      std::istream &input)
+  {
+    std::array<std::size_t, 2> header{0, 0};
+    input.read(reinterpret_cast<char *>(header.data()), sizeof(header));
+    AssertThrow(input.good() && header[0] == sizeof(Number) &&
+                    header[1] == data.size(),
+                dealii::ExcMessage("Could not read in matrix entries: "
+                                   "incompatible element size or count"));
+
+    input.read(reinterpret_cast<char *>(data.data()),
+               data.size() * sizeof(Number));
+    AssertThrow(input.good(),
+                dealii::ExcMessage("Could not read in matrix entries"));
+  }
 
-      if (row < sparsity->n_internal_dofs) {
-        // go through vectorized part
-        const unsigned int simd_row = row / simd_length;
-        const unsigned int simd_offset = row % simd_length;
-        const std::size_t index =
-            sparsity->indices_transposed[sparsity->row_starts[simd_row] +
-                                         simd_offset +
-                                         position_within_column * simd_length];
-        if (n_components > 1) {
-          const unsigned int col =
-              sparsity->column_indices[sparsity->row_starts[simd_row] +
-                                       simd_offset +
-                                       position_within_column * simd_length];
-          if (col < sparsity->n_internal_dofs)
-            for (unsigned int d = 0; d < n_components; ++d)
-              result[d] =
-                  data[index / simd_length * simd_length * n_components +
-                       simd_length * d + index % simd_length];
-          else
-            for (unsigned int d = 0; d < n_components; ++d)
-              result[d] = data[index * n_components + d];
-        } else
-          result[0] = data[index];
-      } else {
-        // go through standard part
-        const std::size_t index =
-            sparsity->indices_transposed[sparsity->row_starts[row] +
-                                         position_within_column];
-        if (n_components > 1) {
-          const unsigned int col =
-              sparsity->column_indices[sparsity->row_starts[row] +
-                                       position_within_column];
-          if (col < sparsity->n_internal_dofs)
-            for (unsigned int d = 0; d < n_components; ++d)
-              result[d] =
-                  data[index / simd_length * simd_length * n_components +
-                       simd_length * d + index % simd_length];
-          else
-            for (unsigned int d = 0; d < n_components; ++d)
-              result[d] = data[index * n_components + d];
-        } else
-          result[0] = data[index];
-      }
 
-    } else if constexpr (std::is_same<VectorizedArray, Number2>::value &&
-                         (n_components == 1)) {
-      /*
-       * Vectorized fast access. Indices must be in the range
-       * [0,n_internal), index must be divisible by simd_length
-       */
+  template <typename Number, int simd_length>
+  inline std::size_t
+  SymmetricSparseMatrixSIMD<Number, simd_length>::memory_consumption() const
+  {
+    return data.memory_consumption();
+  }
+
+
+  template <typename Number, int simd_length>
+  inline void SymmetricSparseMatrixSIMD<Number, simd_length>::write_data(
+      std::ostream &output) const
+  {
+    const std::array<std::size_t, 2> header{sizeof(Number), data.size()};
+    output.write(reinterpret_cast<const char *>(header.data()),
+                 sizeof(header));
+    output.write(reinterpret_cast<const char *>(data.data()),
+                 data.size() * sizeof(Number));
+  }
+
+
+  template <typename Number, int simd_length>
+  inline void SymmetricSparseMatrixSIMD<Number, simd_length>::read_data(
+      std::istream &input)
+  {
+    std::array<std::size_t, 2> header{0, 0};
+    input.read(reinterpret_cast<char *>(header.data()), sizeof(header));
+    AssertThrow(input.good() && header[0] == sizeof(Number) &&
+                    header[1] == data.size(),
+                dealii::ExcMessage("Could not read in matrix entries: "
+                                   "incompatible element size or count"));
+
+    input.read(reinterpret_cast<char *>(data.data()),
+               data.size() * sizeof(Number));
+    AssertThrow(input.good(),
+                dealii::ExcMessage("Could not read in matrix entries"));
+  }
 
-      Assert(row < sparsity->n_internal_dofs,
-             dealii::ExcMessage(
-                 "Vectorized access only possible in vectorized part"));
-      Assert(row % simd_length == 0,
-             dealii::ExcMessage(
-                 "Access only supported for rows at the SIMD granularity"));
 
-      const unsigned int offset = sparsity->row_starts[row / simd_length] +
-                                  position_within_column * simd_length;
-      result[0].gather(data.data(),
-                       sparsity->indices_transposed.data() + offset);
 
+  template <typename Number, int n_components, int simd_length>
+  DEAL_II_ALWAYS_INLINE inline std::size_t
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::index_of(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+    if (row < sparsity->n_internal_dofs) {
+      // go through vectorized part
+      const unsigned int simd_row = row / simd_length;
+      const unsigned int simd_offset = row % simd_length;
+      return sparsity->row_starts[simd_row] + simd_offset +
+             position_within_column * simd_length;
     } else {
-      /* not implemented */
-      __builtin_trap();
+      // go through standard part
+      return sparsity->row_starts[row] + position_within_column;
     }
-
-    return result;
   }
 
 
   template <typename Number, int n_components, int simd_length>
   template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_entry(
-      const Number2 entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      get_tensor_at(const std::size_t index) const
   {
-    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
-    AssertIndexRange(row, sparsity->row_starts.size() - 1);
-    AssertIndexRange(position_within_column, sparsity->row_length(row));
+    const unsigned int entry = indices[index];
+    const std::size_t offset = (entry & ~sign_bit) * n_components;
 
     dealii::Tensor<1, n_components, Number2> result;
-    result[0] = entry;
+    for (unsigned int d = 0; d < n_components; ++d)
+      result[d] = data[offset + d];
 
-    write_tensor<Number2>(
-        result, row, position_within_column, do_streaming_store);
+    return (entry & sign_bit) ? -result : result;
   }
 
 
   template <typename Number, int n_components, int simd_length>
   template <typename Number2>
-  DEAL_II_ALWAYS_INLINE inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::write_tensor(
-      const dealii::Tensor<1, n_components, Number2> &entry,
-      const unsigned int row,
-      const unsigned int position_within_column,
-      const bool do_streaming_store)
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      get_tensor(const unsigned int row,
+                 const unsigned int position_within_column) const
   {
     Assert(sparsity != nullptr, dealii::ExcNotInitialized());
     AssertIndexRange(row, sparsity->row_starts.size() - 1);
     AssertIndexRange(position_within_column, sparsity->row_length(row));
 
-    if constexpr (std::is_same<Number, Number2>::value) {
+    if constexpr (std::is_same_v<Number2,
+                                 typename get_value_type<Number2>::type>) {
       /*
        * Non-vectorized slow access. Supports all row indices in
        * [0,n_owned)
        */
+      return get_tensor_at<Number2>(index_of(row, position_within_column));
 
-      if (row < sparsity->n_internal_dofs) {
-        // go through vectorized part
-        const unsigned int simd_row = row / simd_length;
-        const unsigned int simd_offset = row % simd_length;
-        for (unsigned int d = 0; d < n_components; ++d)
-          data[(sparsity->row_starts[simd_row] +
-                position_within_column * simd_length) *
-                   n_components +
-               d * simd_length + simd_offset] = entry[d];
-      } else {
-        // go through standard part
-        for (unsigned int d = 0; d < n_components; ++d)
-          data[(sparsity->row_starts[row] + position_within_column) *
-                   n_components +
-               d] = entry[d];
-      }
-
-    } else if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+    } else if constexpr (Number2::size() == simd_length) {
       /*
        * Vectorized fast access. Indices must be in the range
        * [0,n_internal), index must be divisible by simd_length
@@ -551,16 +2297,28 @@ namespace ryujin
              dealii::ExcMessage(
                  "Access only supported for rows at the SIMD granularity"));
 
-      Number *store_pos =
-          data.data() + (sparsity->row_starts[row / simd_length] +
-                         position_within_column * simd_length) *
-                            n_components;
-      if (do_streaming_store)
-        for (unsigned int d = 0; d < n_components; ++d)
-          entry[d].streaming_store(store_pos + d * simd_length);
-      else
-        for (unsigned int d = 0; d < n_components; ++d)
-          entry[d].store(store_pos + d * simd_length);
+      const unsigned int *entries =
+          indices.data() + index_of(row, position_within_column);
+
+      unsigned int offsets[simd_length];
+      Number2 sign;
+      for (unsigned int k = 0; k < simd_length; ++k) {
+        offsets[k] = (entries[k] & ~sign_bit) * n_components;
+        sign[k] = (entries[k] & sign_bit) ? -1. : 1.;
+      }
+
+      dealii::Tensor<1, n_components, Number2> result;
+      for (unsigned int d = 0; d < n_components; ++d) {
+        if constexpr (std::is_same<VectorizedArray, Number2>::value) {
+          result[d].gather(data.data() + d, offsets);
+        } else {
+          /* Convert from the storage type on the fly: */
+          for (unsigned int k = 0; k < simd_length; ++k)
+            result[d][k] = data[offsets[k] + d];
+        }
+        result[d] *= sign;
+      }
+      return result;
 
     } else {
       /* not implemented */
@@ -570,87 +2328,99 @@ namespace ryujin
 
 
   template <typename Number, int n_components, int simd_length>
-  inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows_start(
-      const unsigned int communication_channel)
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline dealii::Tensor<1, n_components, Number2>
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      get_transposed_tensor(const unsigned int row,
+                            const unsigned int position_within_column) const
   {
-#ifdef DEAL_II_WITH_MPI
-    AssertIndexRange(communication_channel, 200);
-
-    const unsigned int mpi_tag =
-        dealii::Utilities::MPI::internal::Tags::partitioner_export_start +
-        communication_channel;
-    Assert(mpi_tag <=
-               dealii::Utilities::MPI::internal::Tags::partitioner_export_end,
-           dealii::ExcInternalError());
+    Assert(sparsity != nullptr, dealii::ExcNotInitialized());
+    AssertIndexRange(row, sparsity->row_starts.size() - 1);
+    AssertIndexRange(position_within_column, sparsity->row_length(row));
 
-    const std::size_t n_indices = sparsity->indices_to_be_sent.size();
-    exchange_buffer.resize_fast(n_components * n_indices);
+    static_assert(
+        std::is_same_v<Number2, typename get_value_type<Number2>::type>,
+        "Only non-vectorized access is supported for transposed entries");
 
-    requests.resize(sparsity->receive_targets.size() +
-                    sparsity->send_targets.size());
-    {
-      const auto &targets = sparsity->receive_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Irecv(
-            data.data() +
-                n_components *
-                    (sparsity->row_starts[sparsity->n_locally_owned_dofs] +
-                     (p == 0 ? 0 : targets[p - 1].second)),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                n_components * sizeof(Number),
-            MPI_BYTE,
-            targets[p].first,
-            mpi_tag,
-            sparsity->mpi_communicator,
-            &requests[p]);
-        AssertThrowMPI(ierr);
-      }
-    }
+    const auto index = index_of(row, position_within_column);
+    return get_tensor_at<Number2>(sparsity->indices_transposed[index]);
+  }
 
-    for (std::size_t c = 0; c < n_indices; ++c)
-      for (unsigned int comp = 0; comp < n_components; ++comp)
-        exchange_buffer[n_components * c + comp] =
-            data[n_components * sparsity->indices_to_be_sent[c] + comp];
 
-    {
-      const auto &targets = sparsity->send_targets;
-      for (unsigned int p = 0; p < targets.size(); ++p) {
-        const int ierr = MPI_Isend(
-            exchange_buffer.data() +
-                n_components * (p == 0 ? 0 : targets[p - 1].second),
-            (targets[p].second - (p == 0 ? 0 : targets[p - 1].second)) *
-                n_components * sizeof(Number),
-            MPI_BYTE,
-            targets[p].first,
-            mpi_tag,
-            sparsity->mpi_communicator,
-            &requests[p + sparsity->receive_targets.size()]);
-        AssertThrowMPI(ierr);
-      }
-    }
+  template <typename Number, int n_components, int simd_length>
+  template <typename Number2>
+  DEAL_II_ALWAYS_INLINE inline void
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::prefetch(
+      const unsigned int row, const unsigned int position_within_column) const
+  {
+#if PREFETCH_DISTANCE > 0
+    /* Entries are stored compressed, prefetch through the index map: */
+    const unsigned int *entries =
+        indices.data() + index_of(row, position_within_column);
+    const unsigned int n_lanes = get_stride_size<Number2>;
+    for (unsigned int k = 0; k < n_lanes; ++k)
+      prefetch_range(data.data() + (entries[k] & ~sign_bit) * n_components,
+                     n_components * sizeof(Number));
+#else
+    (void)row;
+    (void)position_within_column;
 #endif
   }
 
 
   template <typename Number, int n_components, int simd_length>
-  inline void SparseMatrixSIMD<Number, n_components, simd_length>::
-      update_ghost_rows_finish()
+  inline std::size_t SkewSymmetricSparseMatrixSIMD<Number,
+                                                   n_components,
+                                                   simd_length>::
+      memory_consumption() const
   {
-#ifdef DEAL_II_WITH_MPI
-    const int ierr =
-        MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
-    AssertThrowMPI(ierr);
-#endif
+    return indices.memory_consumption() + data.memory_consumption();
   }
 
 
   template <typename Number, int n_components, int simd_length>
   inline void
-  SparseMatrixSIMD<Number, n_components, simd_length>::update_ghost_rows()
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::write_data(
+      std::ostream &output) const
   {
-    update_ghost_rows_start();
-    update_ghost_rows_finish();
+    const std::size_t n_indices = indices.size();
+    const std::size_t n_data = data.size();
+    const std::size_t element_size = sizeof(Number);
+    output.write(reinterpret_cast<const char *>(&element_size),
+                 sizeof(element_size));
+    output.write(reinterpret_cast<const char *>(&n_indices), sizeof(n_indices));
+    output.write(reinterpret_cast<const char *>(&n_data), sizeof(n_data));
+    output.write(reinterpret_cast<const char *>(indices.data()),
+                 n_indices * sizeof(unsigned int));
+    output.write(reinterpret_cast<const char *>(data.data()),
+                 n_data * sizeof(Number));
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  inline void
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::read_data(
+      std::istream &input)
+  {
+    std::size_t element_size = 0;
+    std::size_t n_indices = 0;
+    std::size_t n_data = 0;
+    input.read(reinterpret_cast<char *>(&element_size), sizeof(element_size));
+    input.read(reinterpret_cast<char *>(&n_indices), sizeof(n_indices));
+    input.read(reinterpret_cast<char *>(&n_data), sizeof(n_data));
+    AssertThrow(input.good() && element_size == sizeof(Number) &&
+                    n_indices == sparsity->n_nonzero_elements() &&
+                    n_data <= n_indices * n_components,
+                dealii::ExcMessage("Could not read in matrix entries: "
+                                   "incompatible element size or count"));
+
+    indices.resize_fast(n_indices);
+    data.resize_fast(n_data);
+    input.read(reinterpret_cast<char *>(indices.data()),
+               n_indices * sizeof(unsigned int));
+    input.read(reinterpret_cast<char *>(data.data()), n_data * sizeof(Number));
+    AssertThrow(input.good(),
+                dealii::ExcMessage("Could not read in matrix entries"));
   }
 
 } // namespace ryujin
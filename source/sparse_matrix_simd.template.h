@@ -10,13 +10,23 @@
 #include <deal.II/base/vectorization.h>
 #include <deal.II/lac/sparse_matrix.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
 namespace ryujin
 {
 
   template <int simd_length>
   SparsityPatternSIMD<simd_length>::SparsityPatternSIMD()
       : n_internal_dofs(0)
+      , n_locally_owned_dofs(0)
       , row_starts(1)
+      , max_entries_per_row(0)
+      , n_symmetric_nonzero_elements(0)
       , mpi_communicator(MPI_COMM_SELF)
   {
   }
@@ -29,6 +39,8 @@ namespace ryujin
       const std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
           &partitioner)
       : n_internal_dofs(0)
+      , max_entries_per_row(0)
+      , n_symmetric_nonzero_elements(0)
       , mpi_communicator(MPI_COMM_SELF)
   {
     reinit(n_internal_dofs, sparsity, partitioner);
@@ -85,6 +97,9 @@ namespace ryujin
     row_starts.resize_fast(sparsity.n_rows() + 1);
     column_indices.resize_fast(sparsity.n_nonzero_elements());
     indices_transposed.resize_fast(sparsity.n_nonzero_elements());
+    advise_huge_pages(row_starts);
+    advise_huge_pages(column_indices);
+    advise_huge_pages(indices_transposed);
     AssertThrow(sparsity.n_nonzero_elements() <
                     std::numeric_limits<unsigned int>::max(),
                 dealii::ExcMessage("Transposed indices only support up to 4 "
@@ -147,6 +162,114 @@ namespace ryujin
 
     Assert(col_ptr == column_indices.end(), dealii::ExcInternalError());
 
+    max_entries_per_row = sparsity.max_entries_per_row();
+
+#ifdef COMPRESSED_COLUMN_INDICES
+    /*
+     * Store every column index as a 16 bit difference to its (lane) row
+     * index. With a bandwidth reducing renumbering (such as Cuthill-McKee)
+     * almost all differences fit, the remaining far neighbors are marked
+     * with escape_delta and looked up in column_indices.
+     */
+
+    column_deltas.resize_fast(column_indices.size());
+    advise_huge_pages(column_deltas);
+
+    const auto compress = [&](const std::size_t position,
+                              const unsigned int row) {
+      const long delta = long(column_indices[position]) - long(row);
+      column_deltas[position] =
+          delta > escape_delta &&
+                  delta <= std::numeric_limits<std::int16_t>::max()
+              ? std::int16_t(delta)
+              : escape_delta;
+    };
+
+    for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+      const std::size_t first = row_starts[i / simd_length];
+      const std::size_t last = row_starts[i / simd_length + 1];
+      for (std::size_t position = first; position < last; ++position)
+        compress(position, i + (position - first) % simd_length);
+    }
+
+    for (unsigned int i = n_internal_dofs; i < sparsity.n_rows(); ++i)
+      for (auto position = row_starts[i]; position < row_starts[i + 1];
+           ++position)
+        compress(position, i);
+#endif
+
+    /*
+     * Compute the batched edge list of the vectorized part: For every
+     * SIMD stride and every lane k we collect the positions within the
+     * row of all upper triangular entries (column > i + k). The b-th
+     * batch of a stride then combines the b-th upper triangular entry of
+     * every lane. Lanes with fewer entries repeat their last entry, lanes
+     * without any upper triangular entry use the (lower triangular)
+     * first off-diagonal entry.
+     */
+
+    edge_starts.resize_fast(n_internal_dofs / simd_length + 1);
+    edge_batches.clear();
+
+    edge_starts[0] = 0;
+    std::array<std::vector<unsigned int>, simd_length> upper;
+
+    for (unsigned int i = 0; i < n_internal_dofs; i += simd_length) {
+      const unsigned int *js = columns(i);
+      const unsigned int length = row_length(i);
+
+      std::size_t n_batches = 0;
+      for (unsigned int k = 0; k < simd_length; ++k) {
+        upper[k].clear();
+        for (unsigned int col_idx = 1; col_idx < length; ++col_idx)
+          if (js[col_idx * simd_length + k] > i + k)
+            upper[k].push_back(col_idx);
+        n_batches = std::max(n_batches, upper[k].size());
+      }
+
+      for (std::size_t b = 0; b < n_batches; ++b)
+        for (unsigned int k = 0; k < simd_length; ++k)
+          edge_batches.push_back(
+              upper[k].empty() ? 1
+                               : upper[k][std::min(b, upper[k].size() - 1)]);
+
+      edge_starts[i / simd_length + 1] =
+          edge_batches.size() / simd_length;
+    }
+
+    /*
+     * Compute the compacted list of active rows (and SIMD strides) of the
+     * locally owned index range. Constrained degrees of freedom only
+     * store the diagonal entry and are skipped:
+     */
+
+    active_row_indices.clear();
+    for (unsigned int i = 0; i < n_locally_owned_dofs; i += stride_of_row(i))
+      if (row_length(i) != 1)
+        active_row_indices.push_back(i);
+
+    /*
+     * Compute the compressed index map for symmetric matrices: Every pair
+     * of transposed entries is assigned a common storage location. We
+     * enumerate the storage locations in the order of the first entry of
+     * every pair.
+     */
+
+    indices_symmetric.resize_fast(sparsity.n_nonzero_elements());
+    advise_huge_pages(indices_symmetric);
+    n_symmetric_nonzero_elements = 0;
+
+    for (std::size_t p = 0; p < indices_symmetric.size(); ++p) {
+      Assert(indices_transposed[indices_transposed[p]] == p,
+             dealii::ExcInternalError());
+      if (indices_transposed[p] >= p)
+        indices_symmetric[p] = n_symmetric_nonzero_elements++;
+    }
+
+    for (std::size_t p = 0; p < indices_symmetric.size(); ++p)
+      if (indices_transposed[p] < p)
+        indices_symmetric[p] = indices_symmetric[indices_transposed[p]];
+
     /* Compute the data exchange pattern: */
 
     if (sparsity.n_rows() > n_locally_owned_dofs) {
@@ -192,6 +315,8 @@ namespace ryujin
 
       indices_to_be_sent.clear();
       send_targets.resize(partitioner->import_targets().size());
+      transposed_indices_to_be_sent.clear();
+      transposed_send_targets.resize(partitioner->import_targets().size());
       auto idx = import_indices_part.begin();
 
       for (unsigned int p = 0; p < partitioner->import_targets().size(); ++p) {
@@ -204,16 +329,22 @@ namespace ryujin
                                            : row_starts[row]);
           for (auto jt = ++sparsity.begin(row); jt != sparsity.end(row); ++jt)
             if (jt->column() >= ghost_ranges[p] &&
-                jt->column() < ghost_ranges[p + 1])
-              indices_to_be_sent.push_back(
+                jt->column() < ghost_ranges[p + 1]) {
+              const std::size_t index =
                   row < n_internal_dofs
                       ? row_starts[row / simd_length] + row % simd_length +
                             (jt - sparsity.begin(row)) * simd_length
-                      : row_starts[row] + (jt - sparsity.begin(row)));
+                      : row_starts[row] + (jt - sparsity.begin(row));
+              indices_to_be_sent.push_back(index);
+              transposed_indices_to_be_sent.push_back(index);
+            }
         }
 
         send_targets[p].first = partitioner->import_targets()[p].first;
         send_targets[p].second = indices_to_be_sent.size();
+        transposed_send_targets[p].first = send_targets[p].first;
+        transposed_send_targets[p].second =
+            transposed_indices_to_be_sent.size();
       }
 
       /*
@@ -221,14 +352,22 @@ namespace ryujin
        * the MPI communication.
        */
 
+      transposed_receive_targets.resize(receive_targets.size());
+      transposed_receive_positions.clear();
+
       std::size_t receive_counter = 0;
       unsigned int loc_count = 0;
       for (unsigned int i = n_locally_owned_dofs; i < sparsity.n_rows(); ++i) {
         receive_counter += sparsity.row_length(i);
+        for (std::size_t k = 1; k < sparsity.row_length(i); ++k)
+          transposed_receive_positions.push_back(row_starts[i] + k);
         ++loc_count;
         if (loc_count == vec_gt->second) {
-          receive_targets[vec_gt - partitioner->ghost_targets().begin()]
-              .second = receive_counter;
+          const auto p = vec_gt - partitioner->ghost_targets().begin();
+          receive_targets[p].second = receive_counter;
+          transposed_receive_targets[p].first = receive_targets[p].first;
+          transposed_receive_targets[p].second =
+              transposed_receive_positions.size();
           loc_count = 0;
           ++vec_gt;
         }
@@ -243,6 +382,9 @@ namespace ryujin
   template <typename Number, int n_components, int simd_length>
   SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD()
       : sparsity(nullptr)
+      , ghost_compression(GhostCompression::none)
+      , ghost_rounding(0)
+      , transposed_ghost_exchange(false)
   {
   }
 
@@ -250,9 +392,12 @@ namespace ryujin
   template <typename Number, int n_components, int simd_length>
   SparseMatrixSIMD<Number, n_components, simd_length>::SparseMatrixSIMD(
       const SparsityPatternSIMD<simd_length> &sparsity)
-      : sparsity(&sparsity)
+      : sparsity(nullptr)
+      , ghost_compression(GhostCompression::none)
+      , ghost_rounding(0)
+      , transposed_ghost_exchange(false)
   {
-    data.resize(sparsity.n_nonzero_elements() * n_components);
+    reinit(sparsity);
   }
 
 
@@ -261,7 +406,45 @@ namespace ryujin
       const SparsityPatternSIMD<simd_length> &sparsity)
   {
     this->sparsity = &sparsity;
-    data.resize(sparsity.n_nonzero_elements() * n_components);
+    persistent_requests.clear();
+    shared_window.clear();
+
+    /*
+     * Allocate storage without initialization and first touch every
+     * block of rows from the thread that works on it in the (statically
+     * scheduled) row loops of the time stepping. On NUMA systems this
+     * places the memory pages close to the owning thread.
+     */
+
+    data.clear();
+    data.resize_fast(sparsity.n_nonzero_elements() * n_components);
+    advise_huge_pages(data);
+
+    const auto first_touch = [&](const std::size_t begin,
+                                 const std::size_t end) {
+      std::fill(data.begin() + n_components * begin,
+                data.begin() + n_components * end,
+                Number(0.));
+    };
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = sparsity.n_internal_dofs;
+         i < sparsity.n_locally_owned_dofs;
+         ++i)
+      first_touch(sparsity.row_starts[i], sparsity.row_starts[i + 1]);
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = 0; i < sparsity.n_internal_dofs; i += simd_length)
+      first_touch(sparsity.row_starts[i / simd_length],
+                  sparsity.row_starts[i / simd_length + 1]);
+
+    RYUJIN_PARALLEL_REGION_END
+
+    /* Ghost rows are only written by the ghost row exchange: */
+    first_touch(sparsity.row_starts[sparsity.n_locally_owned_dofs],
+                sparsity.n_nonzero_elements());
   }
 
 
@@ -271,6 +454,17 @@ namespace ryujin
       const std::array<SparseMatrix, n_components> &sparse_matrix,
       bool locally_indexed /*= true*/)
   {
+    /*
+     * In case of mixed-precision storage (with simd_length chosen for a
+     * different number type) we read in with the precision of the sparse
+     * matrix.
+     */
+    using VectorizedArray2 = std::conditional_t<
+        simd_length == dealii::VectorizedArray<Number>::size(),
+        VectorizedArray,
+        dealii::VectorizedArray<typename SparseMatrix::value_type,
+                                simd_length>>;
+
     RYUJIN_PARALLEL_REGION_BEGIN
 
     /*
@@ -289,7 +483,7 @@ namespace ryujin
       for (unsigned int col_idx = 0; col_idx < row_length;
            ++col_idx, js += simd_length) {
 
-        dealii::Tensor<1, n_components, VectorizedArray> temp;
+        dealii::Tensor<1, n_components, VectorizedArray2> temp;
         for (unsigned int k = 0; k < simd_length; ++k)
           for (unsigned int d = 0; d < n_components; ++d)
             if (locally_indexed)
@@ -332,6 +526,17 @@ namespace ryujin
   void SparseMatrixSIMD<Number, n_components, simd_length>::read_in(
       const SparseMatrix &sparse_matrix, bool locally_indexed /*= true*/)
   {
+    /*
+     * In case of mixed-precision storage (with simd_length chosen for a
+     * different number type) we read in with the precision of the sparse
+     * matrix.
+     */
+    using VectorizedArray2 = std::conditional_t<
+        simd_length == dealii::VectorizedArray<Number>::size(),
+        VectorizedArray,
+        dealii::VectorizedArray<typename SparseMatrix::value_type,
+                                simd_length>>;
+
     RYUJIN_PARALLEL_REGION_BEGIN
 
     /*
@@ -350,7 +555,7 @@ namespace ryujin
       for (unsigned int col_idx = 0; col_idx < row_length;
            ++col_idx, js += simd_length) {
 
-        VectorizedArray temp = {};
+        VectorizedArray2 temp = {};
         for (unsigned int k = 0; k < simd_length; ++k)
           if (locally_indexed)
             temp[k] = sparse_matrix(i + k, js[k]);
@@ -385,4 +590,226 @@ namespace ryujin
     RYUJIN_PARALLEL_REGION_END
   }
 
+
+
+  template <typename Number, int simd_length>
+  SymmetricSparseMatrixSIMD<Number, simd_length>::SymmetricSparseMatrixSIMD()
+      : sparsity(nullptr)
+  {
+  }
+
+
+  template <typename Number, int simd_length>
+  SymmetricSparseMatrixSIMD<Number, simd_length>::SymmetricSparseMatrixSIMD(
+      const SparsityPatternSIMD<simd_length> &sparsity)
+      : sparsity(&sparsity)
+  {
+    data.resize(sparsity.n_symmetric_nonzero_elements);
+  }
+
+
+  template <typename Number, int simd_length>
+  void SymmetricSparseMatrixSIMD<Number, simd_length>::reinit(
+      const SparsityPatternSIMD<simd_length> &sparsity)
+  {
+    this->sparsity = &sparsity;
+    data.resize(sparsity.n_symmetric_nonzero_elements);
+  }
+
+
+  template <typename Number, int simd_length>
+  template <typename SparseMatrix>
+  void SymmetricSparseMatrixSIMD<Number, simd_length>::read_in(
+      const SparseMatrix &sparse_matrix, bool locally_indexed /*= true*/)
+  {
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    /*
+     * We use the indirect (and slow) access via operator()(i, j) into the
+     * sparse matrix we are copying from. In order to not depend on the
+     * thread schedule we only read in entries with j >= i - the
+     * transposed entries share the same storage location.
+     */
+
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < sparsity->n_locally_owned_dofs; ++i) {
+
+      const unsigned int row_length = sparsity->row_length(i);
+      const unsigned int stride = sparsity->stride_of_row(i);
+      const unsigned int *js = sparsity->columns(i);
+      for (unsigned int col_idx = 0; col_idx < row_length;
+           ++col_idx, js += stride) {
+
+        const unsigned int j = js[0];
+        if (j < i)
+          continue;
+
+        const Number temp =
+            locally_indexed
+                ? sparse_matrix(i, j)
+                : sparse_matrix.el(sparsity->partitioner->local_to_global(i),
+                                   sparsity->partitioner->local_to_global(j));
+        write_entry(temp, i, col_idx);
+      }
+    }
+
+    RYUJIN_PARALLEL_REGION_END
+  }
+
+
+
+  template <typename Number, int n_components, int simd_length>
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      SkewSymmetricSparseMatrixSIMD()
+      : sparsity(nullptr)
+      , stencil_compression(false)
+  {
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      SkewSymmetricSparseMatrixSIMD(
+          const SparsityPatternSIMD<simd_length> &sparsity)
+      : sparsity(&sparsity)
+      , stencil_compression(false)
+  {
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  void SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::reinit(
+      const SparsityPatternSIMD<simd_length> &sparsity)
+  {
+    this->sparsity = &sparsity;
+    indices.clear();
+    data.clear();
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  template <typename SparseMatrix>
+  void SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      read_in(const std::array<SparseMatrix, n_components> &sparse_matrix,
+              bool locally_indexed /*= true*/)
+  {
+    /*
+     * Read in the full matrix (including ghost rows) first:
+     */
+
+    SparseMatrixSIMD<Number, n_components, simd_length> full_matrix(
+        *sparsity);
+    full_matrix.read_in(sparse_matrix, locally_indexed);
+    full_matrix.update_ghost_rows();
+
+    read_in(full_matrix);
+  }
+
+
+  template <typename Number, int n_components, int simd_length>
+  void SkewSymmetricSparseMatrixSIMD<Number, n_components, simd_length>::
+      read_in(const SparseMatrixSIMD<Number, n_components, simd_length>
+                  &full_matrix)
+  {
+    /*
+     * Compute the compressed index map: We enumerate the storage
+     * locations in the order of the first entry of every pair of
+     * transposed entries. The transposed entry of a skew-symmetric pair
+     * shares the storage location and is marked with the sign bit.
+     */
+
+    constexpr auto invalid = dealii::numbers::invalid_unsigned_int;
+    indices.resize_fast(sparsity->n_nonzero_elements());
+    std::fill(indices.begin(), indices.end(), invalid);
+
+    std::vector<dealii::Tensor<1, n_components, Number>> values;
+    values.reserve(sparsity->n_nonzero_elements() / 2 + sparsity->n_rows());
+
+    const auto skew_symmetric = [](const auto &c_ij, const auto &c_ji) {
+      constexpr auto eps = std::numeric_limits<Number>::epsilon();
+      const auto norm = c_ij.norm() + c_ji.norm();
+      return (c_ij + c_ji).norm() <= Number(100.) * eps * norm;
+    };
+
+    /*
+     * For stencil compression we identify every entry with a point on a
+     * uniform grid with spacing 100 eps times the largest entry and
+     * store only one representative per grid point:
+     */
+
+    using key_type = std::array<long long, n_components>;
+    std::map<key_type, unsigned int> representatives;
+
+    Number spacing = Number(1.);
+    if (stencil_compression) {
+      Number max_norm = Number(0.);
+      for (unsigned int i = 0; i < sparsity->n_rows(); ++i)
+        for (unsigned int col_idx = 0; col_idx < sparsity->row_length(i);
+             ++col_idx)
+          max_norm = std::max(
+              max_norm,
+              Number(full_matrix.template get_tensor<Number>(i, col_idx)
+                         .norm()));
+      if (max_norm > Number(0.))
+        spacing = Number(100.) * std::numeric_limits<Number>::epsilon() *
+                  max_norm;
+    }
+
+    const auto quantize = [&](const auto &c_ij) {
+      key_type key;
+      for (unsigned int d = 0; d < n_components; ++d)
+        key[d] = std::llround(c_ij[d] / spacing);
+      return key;
+    };
+
+    /* Return the storage location of an entry, creating it if necessary: */
+    const auto storage_location = [&](const auto &c_ij) -> unsigned int {
+      if (stencil_compression) {
+        auto key = quantize(c_ij);
+        if (const auto it = representatives.find(key);
+            it != representatives.end())
+          return it->second;
+        for (auto &k : key)
+          k = -k;
+        if (const auto it = representatives.find(key);
+            it != representatives.end())
+          return it->second | sign_bit;
+        for (auto &k : key)
+          k = -k;
+        representatives[key] = values.size();
+      }
+
+      AssertThrow(values.size() < sign_bit,
+                  dealii::ExcMessage("Too many matrix entries per MPI rank"));
+      values.push_back(c_ij);
+      return values.size() - 1;
+    };
+
+    for (unsigned int i = 0; i < sparsity->n_rows(); ++i) {
+      const unsigned int row_length = sparsity->row_length(i);
+      for (unsigned int col_idx = 0; col_idx < row_length; ++col_idx) {
+        const auto p = index_of(i, col_idx);
+        if (indices[p] != invalid)
+          continue;
+
+        const auto q = sparsity->indices_transposed[p];
+        const auto c_ij = full_matrix.template get_tensor<Number>(i, col_idx);
+
+        indices[p] = storage_location(c_ij);
+
+        if (q != p) {
+          const auto c_ji =
+              full_matrix.template get_transposed_tensor<Number>(i, col_idx);
+          if (skew_symmetric(c_ij, c_ji))
+            indices[q] = indices[p] ^ sign_bit;
+        }
+      }
+    }
+
+    data.resize_fast(values.size() * n_components);
+    for (std::size_t k = 0; k < values.size(); ++k)
+      for (unsigned int d = 0; d < n_components; ++d)
+        data[k * n_components + d] = values[k][d];
+  }
+
 } // namespace ryujin
@@ -0,0 +1,367 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include "openmp.h"
+
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A small profiler for the thread parallel regions of a time step. For
+   * every region the profiler records the wall time of the region, the
+   * time every OpenMP thread spends on computing (i.e., the time until
+   * the thread arrives at the implicit barrier at the end of the
+   * region), and the time spent waiting for the completion of the MPI
+   * exchange dispatched by a SynchronizationDispatch object. Usage:
+   *
+   * @code
+   * auto region = step_profiler.region("[H] 2");
+   * RYUJIN_PARALLEL_REGION_BEGIN
+   * // thread parallel work
+   * region.thread_done();
+   * RYUJIN_PARALLEL_REGION_END
+   * region.stop();
+   * region.synchronize(synchronization_dispatch);
+   * @endcode
+   *
+   * All functions are no-ops if the profiler is disabled.
+   *
+   * In addition, the profiler can record the last executions of every
+   * region (and the compute time of every thread within the region) in
+   * a ring buffer of fixed size, see enable_trace(). The recorded events
+   * can be exported in the Chrome trace (JSON) format with
+   * write_trace() for inspection with Perfetto or chrome://tracing.
+   *
+   * @ingroup Miscellaneous
+   */
+  class StepProfiler
+  {
+    using clock = std::chrono::steady_clock;
+
+    struct Data {
+      const std::string *name = nullptr;
+      unsigned long long n_calls = 0;
+      double wall_time = 0.;
+      double synchronization_time = 0.;
+      std::vector<double> thread_time;
+    };
+
+  public:
+    /**
+     * A handle for a single execution of a thread parallel region.
+     */
+    class Region
+    {
+    public:
+      Region() = default;
+
+      /**
+       * Record the compute time of the calling thread. Executes in
+       * concurrent, thread-parallel context.
+       */
+      void thread_done() const
+      {
+        if (data_ == nullptr)
+          return;
+#ifdef WITH_OPENMP
+        const unsigned int thread = omp_get_thread_num();
+#else
+        const unsigned int thread = 0;
+#endif
+        const auto now = clock::now();
+        data_->thread_time[thread] += seconds_between(start_, now);
+        profiler_->record(thread + 1, data_->name, start_, now);
+      }
+
+      /**
+       * Record the wall time of the region. Executes in serial, non
+       * thread-parallel context.
+       */
+      void stop() const
+      {
+        if (data_ == nullptr)
+          return;
+        const auto now = clock::now();
+        data_->wall_time += seconds_between(start_, now);
+        data_->n_calls++;
+        profiler_->record(0, data_->name, start_, now);
+      }
+
+      /**
+       * Wait for the payload of the given SynchronizationDispatch and
+       * record the time spent waiting. Executes in serial, non
+       * thread-parallel context.
+       */
+      void synchronize(SynchronizationDispatch &dispatch) const
+      {
+        const auto start = clock::now();
+        dispatch.wait();
+        if (data_ != nullptr)
+          data_->synchronization_time += seconds_since(start);
+      }
+
+    private:
+      friend class StepProfiler;
+
+      static double seconds_between(const clock::time_point &start,
+                                    const clock::time_point &end)
+      {
+        return std::chrono::duration<double>(end - start).count();
+      }
+
+      static double seconds_since(const clock::time_point &start)
+      {
+        return seconds_between(start, clock::now());
+      }
+
+      StepProfiler *profiler_ = nullptr;
+      Data *data_ = nullptr;
+      clock::time_point start_;
+    };
+
+    /**
+     * Enable or disable the profiler. Disabling the profiler does not
+     * clear recorded data.
+     */
+    void enable(const bool enabled)
+    {
+      enabled_ = enabled;
+    }
+
+    /**
+     * Enable recording of the last @p n_events executions of every
+     * region per thread in a ring buffer. A value of 0 disables the
+     * trace. Enabling the trace discards all previously recorded events.
+     */
+    void enable_trace(const unsigned int n_events)
+    {
+#ifdef WITH_OPENMP
+      const unsigned int n_threads = omp_get_max_threads();
+#else
+      const unsigned int n_threads = 1;
+#endif
+      trace_capacity_ = n_events;
+      trace_.assign(n_events == 0 ? 0 : n_threads + 1, Track());
+      for (auto &track : trace_)
+        track.events.resize(n_events);
+      origin_ = clock::now();
+    }
+
+    /**
+     * Return whether the profiler is enabled.
+     */
+    bool enabled() const
+    {
+      return enabled_;
+    }
+
+    /**
+     * Clear all recorded data. Recorded trace events are kept.
+     */
+    void clear()
+    {
+      data_.clear();
+    }
+
+    /**
+     * Start a new execution of the region @p name. Executes in serial,
+     * non thread-parallel context.
+     */
+    Region region(const std::string &name)
+    {
+      Region region;
+      if (!enabled_ && trace_capacity_ == 0)
+        return region;
+
+      auto &data = data_[name];
+      if (data.name == nullptr)
+        data.name = &*names_.insert(name).first;
+#ifdef WITH_OPENMP
+      const unsigned int n_threads = omp_get_max_threads();
+#else
+      const unsigned int n_threads = 1;
+#endif
+      if (data.thread_time.size() < n_threads)
+        data.thread_time.resize(n_threads, 0.);
+
+      region.profiler_ = this;
+      region.data_ = &data;
+      region.start_ = clock::now();
+      return region;
+    }
+
+    /**
+     * Print a table with load imbalance statistics of all regions to
+     * @p output on rank 0:
+     *
+     *  - thread imbalance: maximal over average compute time of all
+     *    threads (averaged over all ranks),
+     *  - barrier: average fraction of the wall time a thread spends
+     *    waiting at the implicit barrier,
+     *  - sync: time spent waiting for MPI exchanges,
+     *  - rank imbalance: maximal over average wall time of all ranks.
+     *
+     * This function has to be called on all ranks.
+     */
+    void print_statistics(std::ostream &output,
+                          const MPI_Comm &mpi_communicator) const
+    {
+      if (!enabled_)
+        return;
+
+      const auto rank = dealii::Utilities::MPI::this_mpi_process(
+          mpi_communicator);
+
+      std::ostringstream stream;
+      stream << "\nLoad imbalance statistics:\n";
+
+      for (const auto &[name, data] : data_) {
+        const auto n_threads =
+            std::max<std::size_t>(1, data.thread_time.size());
+        const double thread_max =
+            data.thread_time.empty()
+                ? 0.
+                : *std::max_element(data.thread_time.begin(),
+                                    data.thread_time.end());
+        const double thread_avg = std::accumulate(data.thread_time.begin(),
+                                                  data.thread_time.end(),
+                                                  0.) /
+                                  n_threads;
+
+        const double thread_imbalance =
+            thread_avg > 0. ? thread_max / thread_avg : 1.;
+        const double barrier =
+            data.wall_time > 0.
+                ? (data.wall_time - thread_avg) / data.wall_time
+                : 0.;
+
+        const auto imbalance = dealii::Utilities::MPI::min_max_avg(
+            thread_imbalance, mpi_communicator);
+        const auto barrier_fraction =
+            dealii::Utilities::MPI::min_max_avg(barrier, mpi_communicator);
+        const auto synchronization = dealii::Utilities::MPI::min_max_avg(
+            data.synchronization_time, mpi_communicator);
+        const auto wall_time = dealii::Utilities::MPI::min_max_avg(
+            data.wall_time, mpi_communicator);
+
+        const double rank_imbalance =
+            wall_time.avg > 0. ? wall_time.max / wall_time.avg : 1.;
+
+        stream << "  " << std::left << std::setw(8) << name << std::right
+               << std::fixed << std::setprecision(2) << std::setw(9)
+               << wall_time.avg << "s  [thread imb: " << std::setw(5)
+               << imbalance.avg << " (max " << std::setw(5) << imbalance.max
+               << ")] [barrier: " << std::setprecision(1) << std::setw(5)
+               << 100. * barrier_fraction.avg << "%] [sync: "
+               << std::setprecision(3) << std::setw(7) << synchronization.avg
+               << "s] [rank imb: " << std::setprecision(2) << std::setw(5)
+               << rank_imbalance << " (p" << wall_time.max_index << ")]\n";
+      }
+
+      if (rank == 0)
+        output << stream.str() << std::flush;
+    }
+
+    /**
+     * Write all recorded trace events to the file
+     * "<base_name>-<rank>.json" in the Chrome trace (JSON) format. Track
+     * 0 of every rank holds the wall time of all regions, track k > 0
+     * the compute time of thread k - 1. Does nothing if the trace is
+     * disabled.
+     */
+    void write_trace(const std::string &base_name,
+                     const MPI_Comm &mpi_communicator) const
+    {
+      if (trace_capacity_ == 0)
+        return;
+
+      const auto rank = dealii::Utilities::MPI::this_mpi_process(
+          mpi_communicator);
+
+      std::ofstream output(base_name + "-" + std::to_string(rank) + ".json");
+      output << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+      bool first = true;
+      for (unsigned int k = 0; k < trace_.size(); ++k) {
+        const auto &[events, n_events] = trace_[k];
+
+        output << (first ? "" : ",") << "\n  {\"name\": \"thread_name\", "
+               << "\"ph\": \"M\", \"pid\": " << rank
+               << ", \"tid\": " << k << ", \"args\": {\"name\": \""
+               << (k == 0 ? std::string("regions")
+                          : "thread " + std::to_string(k - 1))
+               << "\"}}";
+        first = false;
+
+        /* Print the ring buffer starting with the oldest event: */
+        const auto size = std::min<unsigned long long>(n_events, events.size());
+        for (unsigned long long n = n_events - size; n < n_events; ++n) {
+          const auto &event = events[n % events.size()];
+          output << ",\n  {\"name\": \"" << *event.name
+                 << "\", \"ph\": \"X\", \"pid\": " << rank
+                 << ", \"tid\": " << k << std::fixed << std::setprecision(3)
+                 << ", \"ts\": " << 1.e6 * event.begin
+                 << ", \"dur\": " << 1.e6 * (event.end - event.begin) << "}";
+        }
+      }
+
+      output << "\n]}\n";
+    }
+
+  private:
+    /**
+     * Record an event of @p name on the given @p track. Executes in
+     * concurrent, thread-parallel context for different tracks.
+     */
+    void record(const unsigned int track,
+                const std::string *name,
+                const clock::time_point &begin,
+                const clock::time_point &end)
+    {
+      if (track >= trace_.size())
+        return;
+
+      auto &[events, n_events] = trace_[track];
+      events[n_events++ % trace_capacity_] = {
+          name,
+          Region::seconds_between(origin_, begin),
+          Region::seconds_between(origin_, end)};
+    }
+
+    struct Event {
+      const std::string *name;
+      double begin;
+      double end;
+    };
+
+    struct Track {
+      std::vector<Event> events;
+      unsigned long long n_events = 0;
+    };
+
+    bool enabled_ = false;
+    std::map<std::string, Data> data_;
+    std::set<std::string> names_;
+
+    unsigned int trace_capacity_ = 0;
+    std::vector<Track> trace_;
+    clock::time_point origin_;
+  };
+} // namespace ryujin
@@ -0,0 +1,243 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include "openmp.h"
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace ryujin
+{
+  /**
+   * The placement of a single OpenMP thread: the CPU (hardware thread)
+   * it currently runs on, the physical core, package (socket), and NUMA
+   * node of this CPU, and the number of CPUs in its affinity mask. A
+   * thread with more than one CPU in its affinity mask is not pinned and
+   * may migrate. Entries are -1 if unknown.
+   *
+   * @ingroup Miscellaneous
+   */
+  struct ThreadPlacement {
+    int cpu = -1;
+    int core = -1;
+    int package = -1;
+    int numa_node = -1;
+    int n_allowed_cpus = -1;
+  };
+
+
+  namespace internal
+  {
+    /**
+     * Read an integer topology entry of @p cpu from sysfs, for example
+     * "core_id" or "physical_package_id".
+     */
+    inline int read_cpu_topology(const int cpu, const std::string &entry)
+    {
+      int value = -1;
+      std::ifstream("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                    "/topology/" + entry) >>
+          value;
+      return value;
+    }
+
+
+    /**
+     * Return the NUMA node of @p cpu (the "node<k>" link in sysfs).
+     */
+    inline int numa_node_of_cpu(const int cpu)
+    {
+      namespace fs = std::filesystem;
+      std::error_code error;
+      const fs::path path("/sys/devices/system/cpu/cpu" + std::to_string(cpu));
+      for (const auto &entry : fs::directory_iterator(path, error)) {
+        const auto name = entry.path().filename().string();
+        if (name.size() > 4 && name.rfind("node", 0) == 0 &&
+            std::all_of(name.begin() + 4, name.end(), [](const char c) {
+              return std::isdigit(static_cast<unsigned char>(c)) != 0;
+            }))
+          return std::stoi(name.substr(4));
+      }
+      return -1;
+    }
+  } // namespace internal
+
+
+  /**
+   * Return the placement of all threads of the OpenMP thread pool of
+   * the calling process (or of the calling thread if compiled without
+   * OpenMP). The function is only functional on Linux. Executes in
+   * serial, non thread-parallel context.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline std::vector<ThreadPlacement> thread_placement()
+  {
+#ifdef WITH_OPENMP
+    std::vector<ThreadPlacement> placement(omp_get_max_threads());
+#else
+    std::vector<ThreadPlacement> placement(1);
+#endif
+
+#ifdef __linux__
+    RYUJIN_PARALLEL_REGION_BEGIN
+#ifdef WITH_OPENMP
+    auto &entry = placement[omp_get_thread_num()];
+#else
+    auto &entry = placement[0];
+#endif
+    entry.cpu = sched_getcpu();
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+      entry.n_allowed_cpus = CPU_COUNT(&mask);
+    RYUJIN_PARALLEL_REGION_END
+
+    for (auto &entry : placement) {
+      if (entry.cpu < 0)
+        continue;
+      entry.core = internal::read_cpu_topology(entry.cpu, "core_id");
+      entry.package =
+          internal::read_cpu_topology(entry.cpu, "physical_package_id");
+      entry.numa_node = internal::numa_node_of_cpu(entry.cpu);
+    }
+#endif
+
+    return placement;
+  }
+
+
+  /**
+   * Pin all threads of the OpenMP thread pool of every rank to a single
+   * CPU each. The CPUs available to a rank are given by the affinity
+   * mask of the process (usually set by the launcher). If several ranks
+   * on the same node share an identical mask the CPUs are split evenly
+   * among them. The CPUs are handed out compactly per package (socket):
+   * first one hardware thread of every physical core of package 0,
+   * then package 1, and so on; additional hardware threads of a core
+   * (hyperthreads) are only used once every core is occupied.
+   *
+   * Returns false if pinning failed or is not supported on this
+   * platform. This function has to be called on all ranks of
+   * @p mpi_communicator.
+   *
+   * @ingroup Miscellaneous
+   */
+  inline bool
+  pin_threads_compact([[maybe_unused]] const MPI_Comm &mpi_communicator)
+  {
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) != 0)
+      return false;
+
+    /*
+     * Determine all ranks on the node with an identical affinity mask and
+     * our position among them:
+     */
+
+    MPI_Comm node_communicator;
+    int ierr = MPI_Comm_split_type(mpi_communicator,
+                                   MPI_COMM_TYPE_SHARED,
+                                   /*key*/ 0,
+                                   MPI_INFO_NULL,
+                                   &node_communicator);
+    AssertThrowMPI(ierr);
+    const auto node_rank =
+        dealii::Utilities::MPI::this_mpi_process(node_communicator);
+    const auto node_size =
+        dealii::Utilities::MPI::n_mpi_processes(node_communicator);
+
+    std::vector<cpu_set_t> masks(node_size);
+    ierr = MPI_Allgather(&mask,
+                         sizeof(mask),
+                         MPI_BYTE,
+                         masks.data(),
+                         sizeof(mask),
+                         MPI_BYTE,
+                         node_communicator);
+    AssertThrowMPI(ierr);
+    ierr = MPI_Comm_free(&node_communicator);
+    AssertThrowMPI(ierr);
+
+    unsigned int n_sharing = 0;
+    unsigned int position = 0;
+    for (unsigned int r = 0; r < node_size; ++r)
+      if (CPU_EQUAL(&masks[r], &mask)) {
+        if (r == node_rank)
+          position = n_sharing;
+        ++n_sharing;
+      }
+
+    /* Order all CPUs of the mask compactly: */
+
+    std::vector<std::tuple<int, int, int, int>> cpus;
+    std::vector<std::pair<int, int>> seen_cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (!CPU_ISSET(cpu, &mask))
+        continue;
+      const int package =
+          internal::read_cpu_topology(cpu, "physical_package_id");
+      const int core = internal::read_cpu_topology(cpu, "core_id");
+      /* The index of the hardware thread within its core: */
+      const int smt = std::count(seen_cores.begin(),
+                                 seen_cores.end(),
+                                 std::make_pair(package, core));
+      seen_cores.emplace_back(package, core);
+      cpus.emplace_back(smt, package, core, cpu);
+    }
+    std::sort(cpus.begin(), cpus.end());
+
+    const std::size_t chunk =
+        std::max<std::size_t>(cpus.size() / n_sharing, 1);
+    const std::size_t begin = std::min(position * chunk, cpus.size() - 1);
+    const std::size_t end = std::min(begin + chunk, cpus.size());
+    std::vector<int> assigned;
+    for (std::size_t k = begin; k < end; ++k)
+      assigned.push_back(std::get<3>(cpus[k]));
+    if (assigned.empty())
+      return false;
+
+    /* Every thread pins itself: */
+
+    bool success = true;
+    RYUJIN_PARALLEL_REGION_BEGIN
+#ifdef WITH_OPENMP
+    const unsigned int thread = omp_get_thread_num();
+#else
+    const unsigned int thread = 0;
+#endif
+    cpu_set_t thread_mask;
+    CPU_ZERO(&thread_mask);
+    CPU_SET(assigned[thread % assigned.size()], &thread_mask);
+    if (sched_setaffinity(0, sizeof(thread_mask), &thread_mask) != 0) {
+      RYUJIN_OMP_CRITICAL
+      success = false;
+    }
+    RYUJIN_PARALLEL_REGION_END
+
+    return success;
+#else
+    return false;
+#endif
+  }
+} // namespace ryujin
@@ -12,6 +12,7 @@
 #include "offline_data.h"
 #include "parabolic_module.h"
 #include "patterns_conversion.h"
+#include "vector_pool.h"
 
 namespace ryujin
 {
@@ -32,6 +33,19 @@ namespace ryujin
      * warning is emitted.
      */
     bang_bang_control,
+
+    /**
+     * Adapt the CFL number smoothly within the interval ["cfl min", "cfl
+     * max"] with a proportional-integral controller driven by the
+     * fraction of edges for which the limiter is active. The CFL number
+     * is raised while the fraction stays below "cfl controller target
+     * limiter fraction" and lowered otherwise. In case an invariant
+     * domain and or CFL condition violation is detected, the time step
+     * is repeated with "cfl min" and the CFL number for subsequent steps
+     * is reduced. If the repeated step is unsuccessful as well, a warning
+     * is emitted.
+     */
+    adaptive_control,
   };
 
 
@@ -102,11 +116,65 @@ namespace ryujin
     erk_43,
 
     /**
-     * The explicit Runge-Kutta method RK(5,4;1) with the butcher tableau
-     * TODO
+     * The explicit Runge-Kutta method RK(5,4;1) with equidistant nodes
+     * c_i = (i-1)/5 and the butcher tableau given by ERK54Tableau.
      */
     erk_54,
 
+    /**
+     * The low-storage strong stability preserving Runge Kutta method
+     * SSPRK(4,3;2) of Ketcheson @cite Ketcheson2008 given in Shu-Osher
+     * form by
+     * \f{align*}
+     *   U^{(1)} &= U^n + \tfrac{\tau}{2} L(U^n),
+     *   \qquad
+     *   U^{(2)} = U^{(1)} + \tfrac{\tau}{2} L(U^{(1)}),
+     *   \\
+     *   U^{(3)} &= \tfrac{2}{3} U^n + \tfrac{1}{3}\big(U^{(2)} +
+     *   \tfrac{\tau}{2} L(U^{(2)})\big),
+     *   \qquad
+     *   U^{n+1} = U^{(3)} + \tfrac{\tau}{2} L(U^{(3)}).
+     * \f}
+     * The scheme has an SSP coefficient of 2 and only requires two
+     * temporary state vectors.
+     */
+    ssprk_43,
+
+    /**
+     * The low-storage strong stability preserving Runge Kutta method
+     * SSPRK(9,3;6) of Ketcheson @cite Ketcheson2008, i.e., the n = 3
+     * member of the SSPRK(n^2,3) family. Every stage is a forward Euler
+     * step of size tau/6; after the fifth stage the intermediate state is
+     * combined with the state after the first stage. The scheme has an
+     * SSP coefficient of 6 and requires three temporary state vectors.
+     */
+    ssprk_93,
+
+    /**
+     * The strong stability preserving Runge Kutta method SSPRK(10,4;6)
+     * of Ketcheson @cite Ketcheson2008. Every stage is a forward Euler
+     * step of size tau/6. The scheme has an SSP coefficient of 6 and
+     * requires three temporary state vectors.
+     */
+    ssprk_104,
+
+    /**
+     * The s-stage, second-order strong stability preserving Runge Kutta
+     * method SSPRK(s,2;s-1) of Ketcheson @cite Ketcheson2008 given in
+     * Shu-Osher form by
+     * \f{align*}
+     *   U^{(k)} &= U^{(k-1)} + \tfrac{\tau}{s-1} L(U^{(k-1)}),
+     *   \qquad k = 1,\ldots,s-1,\quad U^{(0)} = U^n,
+     *   \\
+     *   U^{n+1} &= \tfrac{1}{s} U^n + \tfrac{s-1}{s}\big(U^{(s-1)} +
+     *   \tfrac{\tau}{s-1} L(U^{(s-1)})\big).
+     * \f}
+     * The number of stages s is set by the "ssprk s2 stages" runtime
+     * parameter. The scheme has an SSP coefficient of s-1 and requires
+     * two temporary state vectors.
+     */
+    ssprk_s2,
+
     /**
      * A Strang split using ssprk 33 for the hyperbolic subproblem and
      * Crank-Nicolson for the parabolic subproblem
@@ -131,7 +199,9 @@ namespace ryujin
 DECLARE_ENUM(ryujin::CFLRecoveryStrategy,
              LIST({ryujin::CFLRecoveryStrategy::none, "none"},
                   {ryujin::CFLRecoveryStrategy::bang_bang_control,
-                   "bang bang control"}));
+                   "bang bang control"},
+                  {ryujin::CFLRecoveryStrategy::adaptive_control,
+                   "adaptive control"}));
 
 DECLARE_ENUM(
     ryujin::TimeSteppingScheme,
@@ -141,6 +211,10 @@ DECLARE_ENUM(
          {ryujin::TimeSteppingScheme::erk_33, "erk 33"},
          {ryujin::TimeSteppingScheme::erk_43, "erk 43"},
          {ryujin::TimeSteppingScheme::erk_54, "erk 54"},
+         {ryujin::TimeSteppingScheme::ssprk_43, "ssprk 43"},
+         {ryujin::TimeSteppingScheme::ssprk_93, "ssprk 93"},
+         {ryujin::TimeSteppingScheme::ssprk_104, "ssprk 104"},
+         {ryujin::TimeSteppingScheme::ssprk_s2, "ssprk s2"},
          {ryujin::TimeSteppingScheme::strang_ssprk_33_cn, "strang ssprk 33 cn"},
          {ryujin::TimeSteppingScheme::strang_erk_33_cn, "strang erk 33 cn"},
          {ryujin::TimeSteppingScheme::strang_erk_43_cn, "strang erk 43 cn"}, ));
@@ -152,6 +226,37 @@ namespace ryujin
    * The TimeIntegrator class implements IMEX timestepping strategies based
    * on explicit and diagonally-implicit Runge Kutta schemes.
    *
+   * <h3>Hyperbolic substeps of the Strang split</h3>
+   *
+   * The strang_* schemes perform m explicit hyperbolic steps, a single
+   * Crank-Nicolson step spanning the time interval of all 2m explicit
+   * steps, and again m explicit steps. All explicit steps use the
+   * time-step size chosen by the first stage of the first explicit
+   * step, which keeps the split symmetric. The number m is set by the
+   * "strang substeps" parameter, or, if "strang parabolic tau" is
+   * nonzero, chosen after every step from the ratio of the parabolic time
+   * scale and the time span of the explicit steps. For m = 1 the schemes
+   * are unchanged.
+   *
+   * <h3>Overlap of the Strang split sub-steps</h3>
+   *
+   * The sub-steps of the strang_* schemes are executed strictly one after
+   * another: every hyperbolic stage consumes the result of the preceding
+   * stage or Crank-Nicolson step, and the Crank-Nicolson step consumes
+   * the result of the last hyperbolic stage of the first half step. There
+   * is thus no independent work within a time step that could be
+   * scheduled concurrently to the parabolic solve. Moreover, MPI is
+   * initialized with MPI_THREAD_SERIALIZED, so that work overlapping the
+   * (main thread) reductions of the Krylov solvers must not communicate.
+   * The work that is independent of the time step is already overlapped:
+   * the ghost exchange of the hyperbolic stages runs on the
+   * CommunicationThread, and VTUOutput ("asynchronous writeback") and
+   * the Checkpointing writer ("checkpoint asynchronous") move output
+   * into background threads that run concurrently to the subsequent
+   * steps. The latency of the reductions of the parabolic solve itself
+   * is best hidden with the "pipelined cg" outer solver of the
+   * NavierStokes::ParabolicSolver.
+   *
    * @ingroup TimeLoop
    */
   template <typename Description, int dim, typename Number = double>
@@ -196,6 +301,12 @@ namespace ryujin
      */
     using precomputed_type = MultiComponentVector<Number, n_precomputed_values>;
 
+    /**
+     * @copydoc HyperbolicModule::stage_vector_type
+     */
+    using stage_vector_type =
+        typename HyperbolicModule<Description, dim, Number>::stage_vector_type;
+
     /**
      * Constructor.
      */
@@ -214,6 +325,13 @@ namespace ryujin
      */
     void prepare();
 
+    /**
+     * Append the memory consumption (in bytes) of the temporary state
+     * vectors to @p statistics. See TimeLoop::print_memory_statistics().
+     */
+    void collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const;
+
     /**
      * @name Functions for performing explicit time steps
      */
@@ -246,7 +364,85 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(efficiency);
 
+    /**
+     * Print statistics of the adaptive CFL controller and the step-size
+     * predictor to the given output stream. The function does nothing
+     * unless the "adaptive control" CFL recovery strategy or the "cfl
+     * predictor" is selected.
+     */
+    void print_controller_statistics(std::ostream &output) const;
+
+    /**
+     * The state of the adaptive CFL controller, the CFL predictor, and
+     * the adaptive number of Strang substeps. This state is accumulated
+     * over the time steps of a single trajectory.
+     */
+    struct ControllerState {
+      Number cfl;
+      Number cfl_current;
+      Number cfl_lowest;
+      Number cfl_highest;
+      Number limiter_fraction;
+      Number controller_error_old;
+      unsigned int n_cfl_reductions;
+      Number predictor_factor;
+      unsigned int n_avoided_restarts;
+      unsigned int strang_substeps_current;
+      double efficiency;
+    };
+
+    /**
+     * Return the current controller state. Together with
+     * controller_state(const ControllerState &) this allows to advance
+     * several independent trajectories (such as the members of an
+     * ensemble, see TimeLoop) with the same TimeIntegrator.
+     */
+    ControllerState controller_state() const;
+
+    /**
+     * Restore a controller state previously obtained with
+     * controller_state(). The fraction of limited edges reported by the
+     * next step only accounts for the edges of that step.
+     */
+    void controller_state(const ControllerState &state);
+
+    /**
+     * A pool of temporary precomputed vectors that can be borrowed by
+     * other modules in between time steps, for example for preparing an
+     * output cycle. The pool is cleared in prepare().
+     */
+    ACCESSOR(precomputed_pool);
+
   protected:
+    /**
+     * Update the CFL number of the adaptive CFL controller after a
+     * successful time step. The function computes the global fraction
+     * of limited edges of the last step and has to be called on all
+     * ranks. If @p restarted is set to true the CFL number is not
+     * raised.
+     */
+    void update_cfl_controller(bool restarted);
+
+    /**
+     * Update the step-size reduction factor of the CFL predictor after a
+     * successful time step. The factor for the next step is set to the
+     * ratio of the smallest CFL bound of all later stages to the CFL
+     * bound of the first stage observed in the last step (limited to the
+     * interval [0.1, 1]). The parameter @p restarted has to be set to
+     * true if the step was repeated with "cfl min".
+     */
+    void update_cfl_predictor(bool restarted);
+
+    /**
+     * Update the number of explicit substeps of the strang_* schemes
+     * after a successful time step with (first stage) time-step size
+     * @p tau. If "strang parabolic tau" is nonzero the number is set to
+     * the ratio of "strang parabolic tau" and the time span of the
+     * Crank-Nicolson step per substep, bounded to the interval
+     * [1, "strang substeps"]. The efficiency() is updated accordingly.
+     */
+    void update_strang_substeps(const Number tau);
+
     /**
      * Given a reference to a previous state vector U performs an explicit
      * third-order strong-stability preserving Runge-Kutta SSPRK(3,3,1/3)
@@ -289,12 +485,44 @@ namespace ryujin
 
     /**
      * Given a reference to a previous state vector U performs an explicit
-     * 4 stage fourth-order Runge-Kutta ERK(5,4,1) time step (and store
+     * 5 stage fourth-order Runge-Kutta ERK(5,4,1) time step (and store
      * the result in U). The function returns the chosen time step size
      * tau.
      */
     Number step_erk_54(vector_type &U, Number t);
 
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * 4 stage third-order low-storage strong-stability preserving
+     * Runge-Kutta SSPRK(4,3;2) time step (and store the result in U). The
+     * function returns the chosen time step size tau.
+     */
+    Number step_ssprk_43(vector_type &U, Number t);
+
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * 9 stage third-order low-storage strong-stability preserving
+     * Runge-Kutta SSPRK(9,3;6) time step (and store the result in U). The
+     * function returns the chosen time step size tau.
+     */
+    Number step_ssprk_93(vector_type &U, Number t);
+
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * 10 stage fourth-order strong-stability preserving Runge-Kutta
+     * SSPRK(10,4;6) time step (and store the result in U). The function
+     * returns the chosen time step size tau.
+     */
+    Number step_ssprk_104(vector_type &U, Number t);
+
+    /**
+     * Given a reference to a previous state vector U performs an explicit
+     * s stage second-order strong-stability preserving Runge-Kutta
+     * SSPRK(s,2;s-1) time step (and store the result in U). The function
+     * returns the chosen time step size tau.
+     */
+    Number step_ssprk_s2(vector_type &U, Number t);
+
     /**
      * Given a reference to a previous state vector U performs a combined
      * explicit implicit Strang split using a third-order Runge-Kutta
@@ -323,6 +551,32 @@ namespace ryujin
     Number step_strang_erk_43_cn(vector_type &U, Number t);
 
   private:
+    /**
+     * Return the state @p U for use as an intermediate stage of
+     * HyperbolicModule::step(). If the compile-time option
+     * MIXED_PRECISION_STAGES is set all locally relevant states of @p U
+     * (including ghost values) are converted to single precision and
+     * stored in the temporary stage vector number @p index first.
+     * Otherwise, @p U is returned.
+     */
+    const stage_vector_type &stage_state(const unsigned int index,
+                                         const vector_type &U);
+
+    /**
+     * Compute dst = s * dst + a * src for all locally owned entries. In
+     * contrast to dealii::LinearAlgebra::distributed::Vector::sadd() the
+     * update runs on the OpenMP thread team used by HyperbolicModule
+     * (instead of the TBB thread pool of deal.II). This avoids oversubscribing
+     * the cores of a rank and keeps the data local to the threads that
+     * wrote it in the preceding stage. The ghost values of @p dst are
+     * invalidated; they are updated by
+     * HyperbolicModule::apply_boundary_conditions().
+     */
+    void sadd(vector_type &dst,
+              const Number s,
+              const Number a,
+              const vector_type &src) const;
+
     //@}
     /**
      * @name Run time options
@@ -334,7 +588,16 @@ namespace ryujin
 
     CFLRecoveryStrategy cfl_recovery_strategy_;
 
+    Number cfl_controller_target_;
+    Number cfl_controller_integral_gain_;
+    Number cfl_controller_proportional_gain_;
+
+    bool cfl_predictor_;
+
     TimeSteppingScheme time_stepping_scheme_;
+    unsigned int ssprk_s2_stages_;
+    unsigned int strang_substeps_;
+    Number strang_parabolic_tau_;
     double efficiency_;
 
     //@}
@@ -356,6 +619,24 @@ namespace ryujin
 
     std::vector<vector_type> U_;
     std::vector<precomputed_type> precomputed_;
+    VectorPool<precomputed_type> precomputed_pool_;
+#ifdef MIXED_PRECISION_STAGES
+    std::vector<stage_vector_type> stage_U_;
+#endif
+
+    Number cfl_current_;
+    Number cfl_lowest_;
+    Number cfl_highest_;
+    Number limiter_fraction_;
+    Number controller_error_old_;
+    unsigned long long n_limited_edges_old_;
+    unsigned long long n_edges_old_;
+    unsigned int n_cfl_reductions_;
+
+    Number predictor_factor_;
+    unsigned int n_avoided_restarts_;
+
+    unsigned int strang_substeps_current_;
 
     //@}
   };
@@ -5,8 +5,13 @@
 
 #pragma once
 
+#include "butcher_tableau.h"
+#include "openmp.h"
 #include "time_integrator.h"
 
+#include <algorithm>
+#include <iomanip>
+
 namespace ryujin
 {
   using namespace dealii;
@@ -44,17 +49,75 @@ namespace ryujin
     add_parameter("cfl recovery strategy",
                   cfl_recovery_strategy_,
                   "CFL/invariant domain violation recovery strategy: none, "
-                  "bang bang control");
-
-    if (ParabolicSystem::is_identity)
+                  "bang bang control, adaptive control");
+
+    cfl_controller_target_ = Number(0.05);
+    add_parameter("cfl controller target limiter fraction",
+                  cfl_controller_target_,
+                  "Adaptive control: target fraction of edges with active "
+                  "limiter (l_ij < 1). The CFL number is raised while the "
+                  "observed fraction stays below the target and lowered "
+                  "otherwise");
+
+    cfl_controller_integral_gain_ = Number(0.2);
+    add_parameter("cfl controller integral gain",
+                  cfl_controller_integral_gain_,
+                  "Adaptive control: integral gain of the PI controller");
+
+    cfl_controller_proportional_gain_ = Number(0.1);
+    add_parameter("cfl controller proportional gain",
+                  cfl_controller_proportional_gain_,
+                  "Adaptive control: proportional gain of the PI controller");
+
+    cfl_predictor_ = false;
+    add_parameter("cfl predictor",
+                  cfl_predictor_,
+                  "Reduce the time-step size of the first stage in advance "
+                  "by the ratio of the CFL bounds of later stages to the CFL "
+                  "bound of the first stage observed in the last step. This "
+                  "avoids restarts when the maximal wave speed grows during "
+                  "a multi-stage step");
+
+    if constexpr (ParabolicSystem::is_identity) {
       time_stepping_scheme_ = TimeSteppingScheme::erk_33;
-    else
+      add_parameter("time stepping scheme",
+                    time_stepping_scheme_,
+                    "Time stepping scheme: ssprk 33, erk 11, erk 22, erk 33, "
+                    "erk 43, erk 54, ssprk 43, ssprk 93, ssprk 104, ssprk s2");
+    } else {
       time_stepping_scheme_ = TimeSteppingScheme::strang_erk_33_cn;
-    add_parameter(
-        "time stepping scheme",
-        time_stepping_scheme_,
-        "Time stepping scheme: ssprk 33, erk 11, erk 22, erk 33, erk 43, erk "
-        "54, strang ssprk 33 cn, strang erk 33 cn, strang erk 43 cn");
+      add_parameter("time stepping scheme",
+                    time_stepping_scheme_,
+                    "Time stepping scheme: strang ssprk 33 cn, strang erk 33 "
+                    "cn, strang erk 43 cn");
+    }
+
+    ssprk_s2_stages_ = 4;
+    add_parameter("ssprk s2 stages",
+                  ssprk_s2_stages_,
+                  "Number of stages s of the SSPRK(s,2) scheme (\"ssprk s2\"). "
+                  "The scheme advances by s-1 forward Euler steps per time "
+                  "step");
+
+    strang_substeps_ = 1;
+    strang_parabolic_tau_ = Number(0.);
+    if constexpr (!ParabolicSystem::is_identity) {
+      add_parameter("strang substeps",
+                    strang_substeps_,
+                    "Strang split schemes (strang_*): maximal number of "
+                    "explicit hyperbolic steps performed in each half step, "
+                    "i.e., the Crank-Nicolson step spans 2 x substeps "
+                    "explicit steps");
+
+      add_parameter("strang parabolic tau",
+                    strang_parabolic_tau_,
+                    "Strang split schemes (strang_*): time scale resolved by "
+                    "the Crank-Nicolson step. If set to a nonzero value the "
+                    "number of substeps is chosen after every step as the "
+                    "ratio of this time scale and the time span of the "
+                    "explicit steps (bounded by \"strang substeps\"). "
+                    "Otherwise \"strang substeps\" steps are performed");
+    }
   }
 
 
@@ -67,6 +130,11 @@ namespace ryujin
 
     /* Resize temporary storage to appropriate sizes: */
 
+    AssertThrow(strang_substeps_ >= 1,
+                ExcMessage("strang substeps must be at least 1"));
+    strang_substeps_current_ =
+        (strang_parabolic_tau_ == Number(0.)) ? strang_substeps_ : 1;
+
     switch (time_stepping_scheme_) {
     case TimeSteppingScheme::ssprk_33:
       U_.resize(2);
@@ -98,20 +166,42 @@ namespace ryujin
       precomputed_.resize(5);
       efficiency_ = 5.;
       break;
+    case TimeSteppingScheme::ssprk_43:
+      U_.resize(2);
+      precomputed_.resize(1);
+      efficiency_ = 2.;
+      break;
+    case TimeSteppingScheme::ssprk_93:
+      U_.resize(3);
+      precomputed_.resize(1);
+      efficiency_ = 6.;
+      break;
+    case TimeSteppingScheme::ssprk_104:
+      U_.resize(3);
+      precomputed_.resize(1);
+      efficiency_ = 6.;
+      break;
+    case TimeSteppingScheme::ssprk_s2:
+      AssertThrow(ssprk_s2_stages_ >= 2,
+                  ExcMessage("ssprk s2 stages must be at least 2"));
+      U_.resize(2);
+      precomputed_.resize(1);
+      efficiency_ = ssprk_s2_stages_ - 1.;
+      break;
     case TimeSteppingScheme::strang_ssprk_33_cn:
       U_.resize(3);
       precomputed_.resize(1);
-      efficiency_ = 2.;
+      efficiency_ = 2. * strang_substeps_current_;
       break;
     case TimeSteppingScheme::strang_erk_33_cn:
       U_.resize(4);
       precomputed_.resize(3);
-      efficiency_ = 6.;
+      efficiency_ = 6. * strang_substeps_current_;
       break;
     case TimeSteppingScheme::strang_erk_43_cn:
       U_.resize(4); // FIXME
       precomputed_.resize(4);
-      efficiency_ = 8.;
+      efficiency_ = 8. * strang_substeps_current_;
       break;
     }
 
@@ -125,6 +215,14 @@ namespace ryujin
     for (auto &it : precomputed_)
       it.reinit_with_scalar_partitioner(scalar_partitioner);
 
+    precomputed_pool_.clear();
+
+#ifdef MIXED_PRECISION_STAGES
+    /* The stage vectors are initialized on demand in stage_state(): */
+    stage_U_.clear();
+    stage_U_.resize(U_.size());
+#endif
+
     /* Reset CFL to canonical starting value: */
 
     AssertThrow(cfl_min_ > 0., ExcMessage("cfl min must be a positive value"));
@@ -133,6 +231,21 @@ namespace ryujin
 
     hyperbolic_module_->cfl(cfl_max_);
 
+    AssertThrow(cfl_controller_target_ > 0.,
+                ExcMessage("cfl controller target limiter fraction must be a "
+                           "positive value"));
+
+    cfl_current_ = cfl_max_;
+    cfl_lowest_ = cfl_max_;
+    cfl_highest_ = cfl_max_;
+    limiter_fraction_ = Number(0.);
+    controller_error_old_ = Number(1.);
+    n_limited_edges_old_ = hyperbolic_module_->n_limited_edges();
+    n_edges_old_ = hyperbolic_module_->n_edges();
+    n_cfl_reductions_ = 0;
+    predictor_factor_ = Number(1.);
+    n_avoided_restarts_ = 0;
+
     const auto check_whether_timestepping_makes_sense = [&]() {
       /*
        * Make sure the user selects an appropriate time-stepping scheme.
@@ -149,7 +262,15 @@ namespace ryujin
         [[fallthrough]];
       case TimeSteppingScheme::erk_43:
         [[fallthrough]];
-      case TimeSteppingScheme::erk_54: {
+      case TimeSteppingScheme::erk_54:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_43:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_93:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_104:
+        [[fallthrough]];
+      case TimeSteppingScheme::ssprk_s2: {
         AssertThrow(
             ParabolicSystem::is_identity,
             dealii::ExcMessage(
@@ -179,6 +300,81 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::collect_memory_statistics(
+      std::vector<std::pair<std::string, std::size_t>> &statistics) const
+  {
+    std::size_t vectors = 0;
+    for (const auto &it : U_)
+      vectors += it.memory_consumption();
+    for (const auto &it : precomputed_)
+      vectors += it.memory_consumption();
+    vectors += precomputed_pool_.memory_consumption();
+#ifdef MIXED_PRECISION_STAGES
+    for (const auto &it : stage_U_)
+      vectors += it.memory_consumption();
+#endif
+    statistics.push_back({"TimeIntegrator: vectors", vectors});
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  auto TimeIntegrator<Description, dim, Number>::stage_state(
+      [[maybe_unused]] const unsigned int index, const vector_type &U)
+      -> const stage_vector_type &
+  {
+#ifdef MIXED_PRECISION_STAGES
+    AssertIndexRange(index, stage_U_.size());
+
+    auto &stage_U = stage_U_[index];
+    if (stage_U.size() == 0)
+      stage_U.reinit_with_scalar_partitioner(
+          offline_data_->scalar_partitioner());
+
+    /*
+     * Convert all locally relevant states. The ghost values of U are
+     * valid after apply_boundary_conditions(), so that we can avoid a
+     * ghost exchange of the stage vector:
+     */
+    const unsigned int n_relevant = offline_data_->n_locally_relevant();
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int i = 0; i < n_relevant; ++i)
+      stage_U.template write_tensor<Number>(U.get_tensor(i), i);
+    RYUJIN_PARALLEL_REGION_END
+
+    return stage_U;
+#else
+    return U;
+#endif
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::sadd(
+      vector_type &dst,
+      const Number s,
+      const Number a,
+      const vector_type &src) const
+  {
+    Assert(dst.locally_owned_size() == src.locally_owned_size(),
+           dealii::ExcInternalError());
+
+    dst.zero_out_ghost_values();
+
+    const unsigned int size = dst.locally_owned_size();
+    Number *dst_values = dst.begin();
+    const Number *src_values = src.begin();
+
+    RYUJIN_PARALLEL_REGION_BEGIN
+    RYUJIN_OMP_FOR
+    for (unsigned int k = 0; k < size; ++k)
+      dst_values[k] = s * dst_values[k] + a * src_values[k];
+    RYUJIN_PARALLEL_REGION_END
+  }
+
+
   template <typename Description, int dim, typename Number>
   Number TimeIntegrator<Description, dim, Number>::step(vector_type &U,
                                                         Number t)
@@ -188,6 +384,7 @@ namespace ryujin
 #endif
 
     const auto single_step = [&]() {
+      hyperbolic_module_->reset_hardware_counter_stages();
       switch (time_stepping_scheme_) {
       case TimeSteppingScheme::ssprk_33:
         return step_ssprk_33(U, t);
@@ -201,45 +398,255 @@ namespace ryujin
         return step_erk_43(U, t);
       case TimeSteppingScheme::erk_54:
         return step_erk_54(U, t);
+      case TimeSteppingScheme::ssprk_43:
+        return step_ssprk_43(U, t);
+      case TimeSteppingScheme::ssprk_93:
+        return step_ssprk_93(U, t);
+      case TimeSteppingScheme::ssprk_104:
+        return step_ssprk_104(U, t);
+      case TimeSteppingScheme::ssprk_s2:
+        return step_ssprk_s2(U, t);
+      /*
+       * The strang_* schemes are rejected by the parameter check for a
+       * trivial parabolic subsystem. We do not even instantiate the
+       * dispatch in this case:
+       */
       case TimeSteppingScheme::strang_ssprk_33_cn:
-        return step_strang_ssprk_33_cn(U, t);
+        if constexpr (!ParabolicSystem::is_identity)
+          return step_strang_ssprk_33_cn(U, t);
+        [[fallthrough]];
       case TimeSteppingScheme::strang_erk_33_cn:
-        return step_strang_erk_33_cn(U, t);
+        if constexpr (!ParabolicSystem::is_identity)
+          return step_strang_erk_33_cn(U, t);
+        [[fallthrough]];
       case TimeSteppingScheme::strang_erk_43_cn:
-        return step_strang_erk_43_cn(U, t);
+        if constexpr (!ParabolicSystem::is_identity)
+          return step_strang_erk_43_cn(U, t);
+        [[fallthrough]];
       default:
         __builtin_unreachable();
       }
     };
 
-    if (cfl_recovery_strategy_ == CFLRecoveryStrategy::bang_bang_control) {
+    const bool adaptive_control =
+        cfl_recovery_strategy_ == CFLRecoveryStrategy::adaptive_control;
+
+    if (cfl_recovery_strategy_ != CFLRecoveryStrategy::none) {
       hyperbolic_module_->id_violation_strategy_ =
           IDViolationStrategy::raise_exception;
-      parabolic_module_->id_violation_strategy_ =
-          IDViolationStrategy::raise_exception;
-      hyperbolic_module_->cfl(cfl_max_);
+      if constexpr (!ParabolicSystem::is_identity)
+        parabolic_module_->id_violation_strategy_ =
+            IDViolationStrategy::raise_exception;
+      hyperbolic_module_->cfl(adaptive_control ? cfl_current_ : cfl_max_);
+    }
+
+    if (cfl_predictor_) {
+      const Number cfl = adaptive_control ? cfl_current_ : cfl_max_;
+      hyperbolic_module_->cfl(predictor_factor_ * cfl);
+      hyperbolic_module_->reset_tau_ratio();
     }
 
     try {
-      return single_step();
+      const Number tau = single_step();
+      if (adaptive_control)
+        update_cfl_controller(false);
+      if (cfl_predictor_)
+        update_cfl_predictor(false);
+      return tau;
 
     } catch (Restart) {
 
       AssertThrow(cfl_recovery_strategy_ != CFLRecoveryStrategy::none,
                   dealii::ExcInternalError());
 
-      if (cfl_recovery_strategy_ == CFLRecoveryStrategy::bang_bang_control) {
-        hyperbolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
+      hyperbolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
+      if constexpr (!ParabolicSystem::is_identity)
         parabolic_module_->id_violation_strategy_ = IDViolationStrategy::warn;
-        hyperbolic_module_->cfl(cfl_min_);
-        return single_step();
+      hyperbolic_module_->cfl(cfl_min_);
+      hyperbolic_module_->reset_tau_ratio();
+
+      if (cfl_recovery_strategy_ == CFLRecoveryStrategy::bang_bang_control) {
+        const Number tau = single_step();
+        if (cfl_predictor_)
+          update_cfl_predictor(true);
+        return tau;
       }
 
-      __builtin_unreachable();
+      /*
+       * Adaptive control: Repeat the step with the safe "cfl min" value
+       * and back off for subsequent steps so that we do not run into the
+       * same violation immediately again:
+       */
+      cfl_current_ = std::max(cfl_min_, Number(0.8) * cfl_current_);
+      n_cfl_reductions_++;
+
+      const Number tau = single_step();
+      update_cfl_controller(true);
+      if (cfl_predictor_)
+        update_cfl_predictor(true);
+      return tau;
     }
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::update_cfl_controller(
+      bool restarted)
+  {
+    /* Global fraction of limited edges of all stages of the last step: */
+
+    const std::vector<double> local_counts{
+        double(hyperbolic_module_->n_limited_edges() - n_limited_edges_old_),
+        double(hyperbolic_module_->n_edges() - n_edges_old_)};
+    n_limited_edges_old_ = hyperbolic_module_->n_limited_edges();
+    n_edges_old_ = hyperbolic_module_->n_edges();
+
+    std::vector<double> counts(2, 0.);
+    Utilities::MPI::sum(local_counts, mpi_communicator_, counts);
+
+    /* Nothing to control if the limiter was not run at all: */
+    if (counts[1] == 0.)
+      return;
+
+    limiter_fraction_ = Number(counts[0] / counts[1]);
+
+    /*
+     * A PI controller on the relative error e = fraction / target (see
+     * for example the step-size controllers of Gustafsson and Söderlind):
+     *
+     *   cfl_new = cfl * e^{-k_I} * (e_old / e)^{k_P}.
+     *
+     * We limit the growth per step to 10% and never raise the CFL number
+     * after a restart.
+     */
+
+    const Number error = std::max(limiter_fraction_, Number(1.e-3)) /
+                         cfl_controller_target_;
+
+    Number factor =
+        std::pow(error, -cfl_controller_integral_gain_) *
+        std::pow(controller_error_old_ / error,
+                 cfl_controller_proportional_gain_);
+    factor = std::min(factor, restarted ? Number(1.) : Number(1.1));
+
+    controller_error_old_ = error;
+
+    cfl_current_ = std::clamp(cfl_current_ * factor, cfl_min_, cfl_max_);
+    cfl_lowest_ = std::min(cfl_lowest_, cfl_current_);
+    cfl_highest_ = std::max(cfl_highest_, cfl_current_);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::update_cfl_predictor(
+      bool restarted)
+  {
+    /*
+     * The CFL bounds of all stages scale with the CFL number. Thus, the
+     * ratio is independent of the reduction factor used for the last
+     * step. The tau_max values are already synchronized over all ranks.
+     */
+    const Number ratio = hyperbolic_module_->tau_ratio();
+
+    /*
+     * An unreduced step would have exceeded the CFL bound of a later
+     * stage, whereas the reduced step did not. A repeated step uses
+     * "cfl min" instead and is not counted:
+     */
+    if (!restarted && ratio < Number(1.) && predictor_factor_ <= ratio)
+      n_avoided_restarts_++;
+
+    predictor_factor_ = std::clamp(ratio, Number(0.1), Number(1.));
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::update_strang_substeps(
+      const Number tau)
+  {
+    if (strang_parabolic_tau_ == Number(0.))
+      return;
+
+    /*
+     * The time span of the Crank-Nicolson step per substep. tau is
+     * identical on all ranks, so that all ranks choose the same number
+     * of substeps:
+     */
+    const double span = efficiency_ / strang_substeps_current_ * tau;
+    const double ratio = strang_parabolic_tau_ / span;
+
+    const auto substeps = static_cast<unsigned int>(
+        std::clamp(ratio, 1., static_cast<double>(strang_substeps_)));
+
+    efficiency_ = efficiency_ / strang_substeps_current_ * substeps;
+    strang_substeps_current_ = substeps;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  typename TimeIntegrator<Description, dim, Number>::ControllerState
+  TimeIntegrator<Description, dim, Number>::controller_state() const
+  {
+    return {hyperbolic_module_->cfl(),
+            cfl_current_,
+            cfl_lowest_,
+            cfl_highest_,
+            limiter_fraction_,
+            controller_error_old_,
+            n_cfl_reductions_,
+            predictor_factor_,
+            n_avoided_restarts_,
+            strang_substeps_current_,
+            efficiency_};
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::controller_state(
+      const ControllerState &state)
+  {
+    hyperbolic_module_->cfl(state.cfl);
+    cfl_current_ = state.cfl_current;
+    cfl_lowest_ = state.cfl_lowest;
+    cfl_highest_ = state.cfl_highest;
+    limiter_fraction_ = state.limiter_fraction;
+    controller_error_old_ = state.controller_error_old;
+    n_cfl_reductions_ = state.n_cfl_reductions;
+    predictor_factor_ = state.predictor_factor;
+    n_avoided_restarts_ = state.n_avoided_restarts;
+    strang_substeps_current_ = state.strang_substeps_current;
+    efficiency_ = state.efficiency;
+
+    /* The counters of the HyperbolicModule are shared by all states: */
+    n_limited_edges_old_ = hyperbolic_module_->n_limited_edges();
+    n_edges_old_ = hyperbolic_module_->n_edges();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeIntegrator<Description, dim, Number>::print_controller_statistics(
+      std::ostream &output) const
+  {
+    if (cfl_predictor_)
+      output << "        [ CFL predictor: factor " << std::setprecision(2)
+             << std::fixed << predictor_factor_ << " (" << n_avoided_restarts_
+             << " avoided restarts) ]" << std::endl;
+
+    if (strang_substeps_ > 1)
+      output << "        [ Strang substeps: " << strang_substeps_current_
+             << " of " << strang_substeps_ << " ]" << std::endl;
+
+    if (cfl_recovery_strategy_ != CFLRecoveryStrategy::adaptive_control)
+      return;
+
+    output << "        [ adaptive CFL: " << std::setprecision(2) << std::fixed
+           << cfl_current_ << " in [" << cfl_lowest_ << ", " << cfl_highest_
+           << "] (" << std::setprecision(1) << 100. * limiter_fraction_
+           << "% limited, target " << 100. * cfl_controller_target_
+           << "%) (" << n_cfl_reductions_ << " reductions) ]" << std::endl;
+  }
+
+
   template <typename Description, int dim, typename Number>
   Number TimeIntegrator<Description, dim, Number>::step_ssprk_33(vector_type &U,
                                                                  Number t)
@@ -253,14 +660,12 @@ namespace ryujin
 
     /* Step 2: U2 = 3/4 U_old + 1/4 (U1 + tau L(U1)) at time t + 0.5 * tau */
     hyperbolic_module_->template step<0>(
-        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
-    U_[1].sadd(Number(1. / 4.), Number(3. / 4.), U);
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau, &U, Number(1. / 4.));
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 0.5 * tau);
 
     /* Step 3: U3 = 1/3 U_old + 2/3 (U2 + tau L(U2)) at final time t + tau */
     hyperbolic_module_->template step<0>(
-        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
-    U_[0].sadd(Number(2. / 3.), Number(1. / 3.), U);
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau, &U, Number(2. / 3.));
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
     U.swap(U_[0]);
@@ -301,7 +706,7 @@ namespace ryujin
 
     /* Step 2: U2 <- {U1, 2} and {U, -1} at time t + 2 tau */
     hyperbolic_module_->template step<1>(U_[0],
-                                         {{U}},
+                                         {{stage_state(0, U)}},
                                          {{precomputed_[0]}},
                                          {{Number(-1.)}},
                                          U_[1],
@@ -328,8 +733,9 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
     /* Step 2: U2 <- {U1, 2} and {U, -1} at time t + 2 tau */
+    const auto &stage_U = stage_state(0, U);
     hyperbolic_module_->template step<1>(U_[0],
-                                         {{U}},
+                                         {{stage_U}},
                                          {{precomputed_[0]}},
                                          {{Number(-1.)}},
                                          U_[1],
@@ -338,8 +744,9 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
 
     /* Step 3: U3 <- {U2, 9/4} and {U1, -2} and {U, 3/4} at time t + 3 tau */
+    const auto &stage_U1 = stage_state(1, U_[0]);
     hyperbolic_module_->template step<2>(U_[1],
-                                         {{U, U_[0]}},
+                                         {{stage_U, stage_U1}},
                                          {{precomputed_[0], precomputed_[1]}},
                                          {{Number(0.75), Number(-2.)}},
                                          U_[2],
@@ -367,7 +774,7 @@ namespace ryujin
 
     /* Step 2: U2 <- {U1, 2} and {U, -1} at time t + 2 tau */
     hyperbolic_module_->template step<1>(U_[0],
-                                         {{U}},
+                                         {{stage_state(0, U)}},
                                          {{precomputed_[0]}},
                                          {{Number(-1.)}},
                                          U_[1],
@@ -376,8 +783,9 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
 
     /* Step 3: U3 <- {U2, 2} and {U1, -1} at time t + 3 tau */
+    const auto &stage_U1 = stage_state(1, U_[0]);
     hyperbolic_module_->template step<1>(U_[1],
-                                         {{U_[0]}},
+                                         {{stage_U1}},
                                          {{precomputed_[1]}},
                                          {{Number(-1.)}},
                                          U_[2],
@@ -387,7 +795,7 @@ namespace ryujin
 
     /* Step 4: U4 <- {U3, 8/3} and {U2,-10/3} and {U1, 5/3} at time t + 4 tau */
     hyperbolic_module_->template step<2>(U_[2],
-                                         {{U_[0], U_[1]}},
+                                         {{stage_U1, stage_state(2, U_[1])}},
                                          {{precomputed_[1], precomputed_[2]}},
                                          {{Number(5. / 3.), Number(-10. / 3.)}},
                                          U_[3],
@@ -408,22 +816,31 @@ namespace ryujin
     std::cout << "TimeIntegrator<dim, Number>::step_erk_54()" << std::endl;
 #endif
 
-    constexpr Number c = 0.2; /* equidistant c_i */
-    constexpr Number a_21 = +0.2;
-    constexpr Number a_31 = +0.26075582269554909;
-    constexpr Number a_32 = +0.13924417730445096;
-    constexpr Number a_41 = -0.25856517872570289;
-    constexpr Number a_42 = +0.91136274166280729;
-    constexpr Number a_43 = -0.05279756293710430;
-    constexpr Number a_51 = +0.21623276431503774;
-    constexpr Number a_52 = +0.51534223099602405;
-    constexpr Number a_53 = -0.81662794199265554;
-    constexpr Number a_54 = +0.88505294668159373;
-    constexpr Number a_61 = -0.10511678454691901; /* aka b_1 */
-    constexpr Number a_62 = +0.87880047152100838; /* aka b_2 */
-    constexpr Number a_63 = -0.58903404061484477; /* aka b_3 */
-    constexpr Number a_64 = +0.46213380485434047; /* aka b_4 */
-    // constexpr Number a_65 = +0.35321654878641495; /* aka b_5 */
+    /*
+     * Every stage k + 1 is written as a forward Euler step of stage k
+     * with step size tau = c dt plus the differences of the tableau rows
+     * k + 1 and k (scaled by 1 / c) applied to the earlier stage updates.
+     * All contributions are combined in a single pass of
+     * HyperbolicModule::step(). The weight of stage k itself is implicit
+     * in the forward Euler step due to the equidistant nodes.
+     */
+
+    using Tableau = ERK54Tableau;
+    constexpr Number c = Tableau::c;
+    constexpr Number a_21 = Tableau::a[1][0];
+    constexpr Number a_31 = Tableau::a[2][0];
+    constexpr Number a_32 = Tableau::a[2][1];
+    constexpr Number a_41 = Tableau::a[3][0];
+    constexpr Number a_42 = Tableau::a[3][1];
+    constexpr Number a_43 = Tableau::a[3][2];
+    constexpr Number a_51 = Tableau::a[4][0];
+    constexpr Number a_52 = Tableau::a[4][1];
+    constexpr Number a_53 = Tableau::a[4][2];
+    constexpr Number a_54 = Tableau::a[4][3];
+    constexpr Number a_61 = Tableau::b[0];
+    constexpr Number a_62 = Tableau::b[1];
+    constexpr Number a_63 = Tableau::b[2];
+    constexpr Number a_64 = Tableau::b[3];
 
     /* Step 1: */
     Number tau = hyperbolic_module_->template step<0>(
@@ -431,8 +848,9 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
     /* Step 2: */
+    const auto &stage_U = stage_state(0, U);
     hyperbolic_module_->template step<1>(U_[0],
-                                         {{U}},
+                                         {{stage_U}},
                                          {{precomputed_[0]}},
                                          {{(a_31 - a_21) / c}},
                                          U_[1],
@@ -441,9 +859,10 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
 
     /* Step 3: */
+    const auto &stage_U1 = stage_state(1, U_[0]);
     hyperbolic_module_->template step<2>(
         U_[1],
-        {{U, U_[0]}},
+        {{stage_U, stage_U1}},
         {{precomputed_[0], precomputed_[1]}},
         {{(a_41 - a_31) / c, (a_42 - a_32) / c}},
         U_[2],
@@ -452,9 +871,10 @@ namespace ryujin
     hyperbolic_module_->apply_boundary_conditions(U_[2], t + 3. * tau);
 
     /* Step 4: */
+    const auto &stage_U2 = stage_state(2, U_[1]);
     hyperbolic_module_->template step<3>(
         U_[2],
-        {{U, U_[0], U_[1]}},
+        {{stage_U, stage_U1, stage_U2}},
         {{precomputed_[0], precomputed_[1], precomputed_[2]}},
         {{(a_51 - a_41) / c, (a_52 - a_42) / c, (a_53 - a_43) / c}},
         U_[3],
@@ -465,7 +885,7 @@ namespace ryujin
     /* Step 5: */
     hyperbolic_module_->template step<4>(
         U_[3],
-        {{U, U_[0], U_[1], U_[2]}},
+        {{stage_U, stage_U1, stage_U2, stage_state(3, U_[2])}},
         {{precomputed_[0], precomputed_[1], precomputed_[2], precomputed_[3]}},
         {{(a_61 - a_51) / c,
           (a_62 - a_52) / c,
@@ -482,216 +902,470 @@ namespace ryujin
 
 
   template <typename Description, int dim, typename Number>
-  Number TimeIntegrator<Description, dim, Number>::step_strang_ssprk_33_cn(
-      vector_type &U, Number t)
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_43(vector_type &U,
+                                                                 Number t)
   {
-    // FIXME: avoid code duplication with step_ssprk_33
-
 #ifdef DEBUG_OUTPUT
-    std::cout << "TimeIntegrator<dim, Number>::step_strang_ssprk_33_cn()"
-              << std::endl;
+    std::cout << "TimeIntegrator<dim, Number>::step_ssprk_43()" << std::endl;
 #endif
 
-    /* First explicit SSPRK 3 step with final result in U_[0]: */
+    /*
+     * Low-storage SSPRK(4,3), see @cite Ketcheson2008. All stages are
+     * forward Euler steps of size tau, the combined step is 2 tau.
+     */
 
+    /* Step 1: U1 = U_old + tau * L(U_old) at time t + tau */
     Number tau = hyperbolic_module_->template step<0>(
-        /*input*/ U, {}, {}, {}, U_[0], precomputed_[0]);
+        U, {}, {}, {}, U_[0], precomputed_[0]);
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
+    /* Step 2: U2 = U1 + tau * L(U1) at time t + 2 tau */
     hyperbolic_module_->template step<0>(
         U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
-    U_[1].sadd(Number(1. / 4.), Number(3. / 4.), /*input*/ U);
-    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 0.5 * tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
 
+    /* Step 3: U3 = 2/3 U_old + 1/3 (U2 + tau L(U2)) at time t + tau */
     hyperbolic_module_->template step<0>(
-        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
-    U_[0].sadd(Number(2. / 3.), Number(1. / 3.), /*input*/ U);
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau, &U, Number(1. / 3.));
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
-    /* Implicit Crank-Nicolson step with final result in U_[2]: */
+    /* Step 4: U4 = U3 + tau * L(U3) at final time t + 2 tau */
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
+
+    U.swap(U_[1]);
+    return 2. * tau;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_93(vector_type &U,
+                                                                 Number t)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_ssprk_93()" << std::endl;
+#endif
 
-    parabolic_module_->crank_nicolson_step(U_[0], t, U_[2], 2.0 * tau);
+    /*
+     * Low-storage SSPRK(9,3), see @cite Ketcheson2008. All stages are
+     * forward Euler steps of size tau, the combined step is 6 tau. The
+     * state after the first stage is kept in U_[2]; all other stages
+     * alternate between U_[0] and U_[1].
+     */
 
-    /* Second SSPRK 3 step with final result in U_[0]: */
+    /* Step 1: U1 = U_old + tau * L(U_old) at time t + tau */
+    Number tau = hyperbolic_module_->template step<0>(
+        U, {}, {}, {}, U_[2], precomputed_[0]);
+    hyperbolic_module_->apply_boundary_conditions(U_[2], t + tau);
 
+    /* Steps 2 - 5: U_k = U_{k-1} + tau * L(U_{k-1}) at time t + k tau */
     hyperbolic_module_->template step<0>(
-        /*intermediate*/ U_[2], {}, {}, {}, U_[0], precomputed_[0], tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 2.0 * tau);
+        U_[2], {}, {}, {}, U_[0], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 2. * tau);
 
     hyperbolic_module_->template step<0>(
         U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
-    U_[1].sadd(Number(1. / 4.), Number(3. / 4.), /*intermediate*/ U_[2]);
-    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 1.5 * tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 3. * tau);
 
     hyperbolic_module_->template step<0>(
         U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
-    U_[0].sadd(Number(2. / 3.), Number(1. / 3.), /*intermediate*/ U_[2]);
-    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 2.0 * tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 4. * tau);
 
-    U.swap(U_[0]);
-    return 2.0 * tau;
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 5. * tau);
+
+    /* Step 6: U6 = 3/5 U1 + 2/5 (U5 + tau L(U5)) at time t + 3 tau */
+    hyperbolic_module_->template step<0>(U_[1],
+                                         {},
+                                         {},
+                                         {},
+                                         U_[0],
+                                         precomputed_[0],
+                                         tau,
+                                         &U_[2],
+                                         Number(2. / 5.));
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 3. * tau);
+
+    /* Steps 7 - 9: U_k = U_{k-1} + tau * L(U_{k-1}) at time t + (k-3) tau */
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 4. * tau);
+
+    hyperbolic_module_->template step<0>(
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 5. * tau);
+
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 6. * tau);
+
+    U.swap(U_[1]);
+    return 6. * tau;
   }
 
 
   template <typename Description, int dim, typename Number>
-  Number TimeIntegrator<Description, dim, Number>::step_strang_erk_33_cn(
-      vector_type &U, Number t)
+  Number
+  TimeIntegrator<Description, dim, Number>::step_ssprk_104(vector_type &U,
+                                                           Number t)
   {
-    // FIXME: refactor to avoid code duplication with step_erk_33
-
 #ifdef DEBUG_OUTPUT
-    std::cout << "TimeIntegrator<dim, Number>::step_strang_erk_33_cn()"
-              << std::endl;
+    std::cout << "TimeIntegrator<dim, Number>::step_ssprk_104()" << std::endl;
 #endif
 
-    /* First explicit ERK(3,3,1) step with final result in U_[2]: */
+    /*
+     * SSPRK(10,4), see @cite Ketcheson2008. All stages are forward Euler
+     * steps of size tau, the combined step is 6 tau. U_[0] and U_[1]
+     * alternate, U_[2] holds the combination 1/25 U_old + 9/25 U5.
+     */
 
+    /* Steps 1 - 5: U_k = U_{k-1} + tau * L(U_{k-1}) at time t + k tau */
     Number tau = hyperbolic_module_->template step<0>(
-        /*input*/ U, {}, {}, {}, U_[0], precomputed_[0]);
+        U, {}, {}, {}, U_[0], precomputed_[0]);
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
 
-    hyperbolic_module_->template step<1>(U_[0],
-                                         {{/*input*/ U}},
-                                         {{precomputed_[0]}},
-                                         {{Number(-1.)}},
-                                         U_[1],
-                                         precomputed_[1],
-                                         tau);
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
 
-    hyperbolic_module_->template step<2>(U_[1],
-                                         {{/*input*/ U, U_[0]}},
-                                         {{precomputed_[0], precomputed_[1]}},
-                                         {{Number(0.75), Number(-2.)}},
-                                         U_[2],
-                                         precomputed_[2],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[2], t + 3. * tau);
+    hyperbolic_module_->template step<0>(
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 3. * tau);
 
-    /* Implicit Crank-Nicolson step with final result in U_[3]: */
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 4. * tau);
 
-    parabolic_module_->crank_nicolson_step(U_[2], t, U_[3], 6.0 * tau);
+    hyperbolic_module_->template step<0>(
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 5. * tau);
 
-    /* First explicit SSPRK 3 step with final result in U_[2]: */
+    /* Set U_[2] = 1/25 U_old + 9/25 U5 and U5 <- 3/5 U_old + 2/5 U5: */
+    U_[2].equ(Number(9. / 25.), U_[0]);
+    U_[2].add(Number(1. / 25.), U);
+    sadd(U_[0], Number(2. / 5.), Number(3. / 5.), U);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 2. * tau);
 
+    /* Steps 6 - 9: U_k = U_{k-1} + tau * L(U_{k-1}) at time t + (k-3) tau */
     hyperbolic_module_->template step<0>(
-        /*intermediate*/ U_[3], {}, {}, {}, U_[0], precomputed_[0], tau);
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 3. * tau);
+
+    hyperbolic_module_->template step<0>(
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
     hyperbolic_module_->apply_boundary_conditions(U_[0], t + 4. * tau);
 
-    hyperbolic_module_->template step<1>(U_[0],
-                                         {{/*intermediate*/ U_[3]}},
-                                         {{precomputed_[0]}},
-                                         {{Number(-1.)}},
-                                         U_[1],
-                                         precomputed_[1],
-                                         tau);
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
     hyperbolic_module_->apply_boundary_conditions(U_[1], t + 5. * tau);
 
-    hyperbolic_module_->template step<2>(U_[1],
-                                         {{/*intermediate*/ U_[3], U_[0]}},
-                                         {{precomputed_[0], precomputed_[1]}},
-                                         {{Number(0.75), Number(-2.)}},
-                                         U_[2],
-                                         precomputed_[2],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[2], t + 6. * tau);
+    hyperbolic_module_->template step<0>(
+        U_[1], {}, {}, {}, U_[0], precomputed_[0], tau);
+    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 6. * tau);
 
-    U.swap(U_[2]);
+    /* Step 10: U10 = U_[2] + 3/5 (U9 + tau L(U9)) at final time t + 6 tau */
+    hyperbolic_module_->template step<0>(
+        U_[0], {}, {}, {}, U_[1], precomputed_[0], tau);
+    sadd(U_[1], Number(3. / 5.), Number(1.), U_[2]);
+    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 6. * tau);
+
+    U.swap(U_[1]);
     return 6. * tau;
   }
 
 
   template <typename Description, int dim, typename Number>
-  Number TimeIntegrator<Description, dim, Number>::step_strang_erk_43_cn(
+  Number TimeIntegrator<Description, dim, Number>::step_ssprk_s2(vector_type &U,
+                                                                 Number t)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_ssprk_s2()" << std::endl;
+#endif
+
+    /*
+     * SSPRK(s,2), see @cite Ketcheson2008. All stages are forward Euler
+     * steps of size tau, the combined step is (s-1) tau. The stages
+     * alternate between U_[0] and U_[1].
+     */
+
+    const unsigned int s = ssprk_s2_stages_;
+
+    /* Step 1: U1 = U_old + tau * L(U_old) at time t + tau */
+    Number tau = hyperbolic_module_->template step<0>(
+        U, {}, {}, {}, U_[0], precomputed_[0]);
+
+    /*
+     * Steps 2 - s: U_k = U_{k-1} + tau * L(U_{k-1}) at time t + k tau,
+     * the final step is combined to U_new = 1/s U_old + (s-1)/s Us at
+     * time t + (s-1) tau:
+     */
+    for (unsigned int k = 2; k <= s; ++k) {
+      auto &old_U = U_[k % 2];
+      auto &new_U = U_[(k + 1) % 2];
+      hyperbolic_module_->apply_boundary_conditions(old_U, t + (k - 1) * tau);
+      hyperbolic_module_->template step<0>(old_U,
+                                           {},
+                                           {},
+                                           {},
+                                           new_U,
+                                           precomputed_[0],
+                                           tau,
+                                           k == s ? &U : nullptr,
+                                           Number((s - 1.) / s));
+    }
+
+    auto &new_U = U_[(s + 1) % 2];
+    hyperbolic_module_->apply_boundary_conditions(new_U, t + (s - 1.) * tau);
+
+    U.swap(new_U);
+    return (s - 1.) * tau;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_strang_ssprk_33_cn(
       vector_type &U, Number t)
   {
-    // FIXME: refactor to avoid code duplication with step_erk_43
+    // FIXME: avoid code duplication with step_ssprk_33
 
 #ifdef DEBUG_OUTPUT
-    std::cout << "TimeIntegrator<dim, Number>::step_strang_erk_43_cn()"
+    std::cout << "TimeIntegrator<dim, Number>::step_strang_ssprk_33_cn()"
               << std::endl;
 #endif
 
-    /* First explicit ERK(4,3,1) step with final result in U_[3]: */
+    /*
+     * A single explicit SSPRK 3 step starting from V at time t0 with
+     * final result in U_[0]. If tau is zero the time-step size is chosen
+     * by the first stage. Returns the time-step size:
+     */
+    const auto explicit_step =
+        [&](const vector_type &V, const Number t0, Number tau) {
+          const Number tau_max = hyperbolic_module_->template step<0>(
+              V, {}, {}, {}, U_[0], precomputed_[0], tau);
+          if (tau == Number(0.))
+            tau = tau_max;
+          hyperbolic_module_->apply_boundary_conditions(U_[0], t0 + tau);
+
+          hyperbolic_module_->template step<0>(U_[0],
+                                               {},
+                                               {},
+                                               {},
+                                               U_[1],
+                                               precomputed_[0],
+                                               tau,
+                                               &V,
+                                               Number(1. / 4.));
+          hyperbolic_module_->apply_boundary_conditions(U_[1],
+                                                        t0 + 0.5 * tau);
+
+          hyperbolic_module_->template step<0>(U_[1],
+                                               {},
+                                               {},
+                                               {},
+                                               U_[0],
+                                               precomputed_[0],
+                                               tau,
+                                               &V,
+                                               Number(2. / 3.));
+          hyperbolic_module_->apply_boundary_conditions(U_[0], t0 + tau);
+          return tau;
+        };
+
+    const unsigned int m = strang_substeps_current_;
+
+    /* First m explicit SSPRK 3 steps with final result in U_[2]: */
+
+    const Number tau = explicit_step(/*input*/ U, t, Number(0.));
+    U_[0].swap(U_[2]);
+    for (unsigned int k = 1; k < m; ++k) {
+      explicit_step(U_[2], t + k * tau, tau);
+      U_[0].swap(U_[2]);
+    }
 
-    /* Step 1: U1 <- {U, 1} at time t + tau */
-    Number tau = hyperbolic_module_->template step<0>(
-        /*input*/ U, {}, {}, {}, U_[0], precomputed_[0]);
-    hyperbolic_module_->apply_boundary_conditions(U_[0], t + tau);
+    /* Implicit Crank-Nicolson step with final result in U_[2]: */
 
-    /* Step 2: U2 <- {U1, 2} and {U, -1} at time t + 2 tau */
-    hyperbolic_module_->template step<1>(U_[0],
-                                         {{/*input*/ U}},
-                                         {{precomputed_[0]}},
-                                         {{Number(-1.)}},
-                                         U_[1],
-                                         precomputed_[1],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 2. * tau);
+    parabolic_module_->crank_nicolson_step(U_[2], t, U_[0], 2.0 * m * tau);
+    U_[0].swap(U_[2]);
 
-    /* Step 3: U3 <- {U2, 2} and {U1, -1} at time t + 3 tau */
-    hyperbolic_module_->template step<1>(U_[1],
-                                         {{U_[0]}},
-                                         {{precomputed_[1]}},
-                                         {{Number(-1.)}},
-                                         U_[2],
-                                         precomputed_[2],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[2], t + 3. * tau);
+    /* Second m explicit SSPRK 3 steps with final result in U_[2]: */
 
-    /* Step 4: U4 <- {U3, 8/3} and {U2,-10/3} and {U1, 5/3} at time t + 4 tau */
-    hyperbolic_module_->template step<2>(U_[2],
-                                         {{U_[0], U_[1]}},
-                                         {{precomputed_[1], precomputed_[2]}},
-                                         {{Number(5. / 3.), Number(-10. / 3.)}},
-                                         U_[3],
-                                         precomputed_[3],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[3], t + 4. * tau);
+    for (unsigned int k = 0; k < m; ++k) {
+      explicit_step(/*intermediate*/ U_[2], t + (m + k) * tau, tau);
+      U_[0].swap(U_[2]);
+    }
 
-    /* Implicit Crank-Nicolson step with final result in U_[2]: */
+    U.swap(U_[2]);
+    update_strang_substeps(tau);
+    return 2.0 * m * tau;
+  }
 
-    parabolic_module_->crank_nicolson_step(U_[3], t, U_[2], 8.0 * tau);
 
-    /* First explicit SSPRK 3 step with final result in U_[3]: */
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_strang_erk_33_cn(
+      vector_type &U, Number t)
+  {
+    // FIXME: refactor to avoid code duplication with step_erk_33
 
-    /* Step 1: U1 <- {U, 1} at time t + tau */
-    hyperbolic_module_->template step<0>(
-        /*intermediate*/ U_[2], {}, {}, {}, U_[0], precomputed_[0], tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[0], t + 5. * tau);
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_strang_erk_33_cn()"
+              << std::endl;
+#endif
 
-    /* Step 2: U2 <- {U1, 2} and {U, -1} at time t + 2 tau */
-    hyperbolic_module_->template step<1>(U_[0],
-                                         {{/*intermediate*/ U_[2]}},
-                                         {{precomputed_[0]}},
-                                         {{Number(-1.)}},
-                                         U_[1],
-                                         precomputed_[1],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[1], t + 6. * tau);
+    /*
+     * A single explicit ERK(3,3,1) step starting from V at time t0 with
+     * final result in U_[2]. If tau is zero the time-step size is chosen
+     * by the first stage. Returns the time-step size:
+     */
+    const auto explicit_step = [&](const vector_type &V,
+                                   const Number t0,
+                                   Number tau) {
+      const Number tau_max = hyperbolic_module_->template step<0>(
+          V, {}, {}, {}, U_[0], precomputed_[0], tau);
+      if (tau == Number(0.))
+        tau = tau_max;
+      hyperbolic_module_->apply_boundary_conditions(U_[0], t0 + tau);
+
+      const auto &stage_V = stage_state(0, V);
+      hyperbolic_module_->template step<1>(U_[0],
+                                           {{stage_V}},
+                                           {{precomputed_[0]}},
+                                           {{Number(-1.)}},
+                                           U_[1],
+                                           precomputed_[1],
+                                           tau);
+      hyperbolic_module_->apply_boundary_conditions(U_[1], t0 + 2. * tau);
+
+      hyperbolic_module_->template step<2>(
+          U_[1],
+          {{stage_V, stage_state(1, U_[0])}},
+          {{precomputed_[0], precomputed_[1]}},
+          {{Number(0.75), Number(-2.)}},
+          U_[2],
+          precomputed_[2],
+          tau);
+      hyperbolic_module_->apply_boundary_conditions(U_[2], t0 + 3. * tau);
+      return tau;
+    };
 
-    /* Step 3: U3 <- {U2, 2} and {U1, -1} at time t + 3 tau */
-    hyperbolic_module_->template step<1>(U_[1],
-                                         {{U_[0]}},
-                                         {{precomputed_[1]}},
-                                         {{Number(-1.)}},
-                                         U_[2],
-                                         precomputed_[2],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[2], t + 7. * tau);
+    const unsigned int m = strang_substeps_current_;
 
-    /* Step 4: U4 <- {U3, 8/3} and {U2,-10/3} and {U1, 5/3} at time t + 4 tau */
-    hyperbolic_module_->template step<2>(U_[2],
-                                         {{U_[0], U_[1]}},
-                                         {{precomputed_[1], precomputed_[2]}},
-                                         {{Number(5. / 3.), Number(-10. / 3.)}},
-                                         U_[3],
-                                         precomputed_[3],
-                                         tau);
-    hyperbolic_module_->apply_boundary_conditions(U_[3], t + 8. * tau);
+    /* First m explicit ERK(3,3,1) steps with final result in U_[3]: */
+
+    const Number tau = explicit_step(/*input*/ U, t, Number(0.));
+    U_[2].swap(U_[3]);
+    for (unsigned int k = 1; k < m; ++k) {
+      explicit_step(U_[3], t + 3. * k * tau, tau);
+      U_[2].swap(U_[3]);
+    }
+
+    /* Implicit Crank-Nicolson step with final result in U_[3]: */
+
+    parabolic_module_->crank_nicolson_step(U_[3], t, U_[2], 6.0 * m * tau);
+    U_[2].swap(U_[3]);
+
+    /* Second m explicit ERK(3,3,1) steps with final result in U_[3]: */
+
+    for (unsigned int k = 0; k < m; ++k) {
+      explicit_step(/*intermediate*/ U_[3], t + 3. * (m + k) * tau, tau);
+      U_[2].swap(U_[3]);
+    }
+
+    U.swap(U_[3]);
+    update_strang_substeps(tau);
+    return 6. * m * tau;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeIntegrator<Description, dim, Number>::step_strang_erk_43_cn(
+      vector_type &U, Number t)
+  {
+    // FIXME: refactor to avoid code duplication with step_erk_43
+
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeIntegrator<dim, Number>::step_strang_erk_43_cn()"
+              << std::endl;
+#endif
+
+    /*
+     * A single explicit ERK(4,3,1) step starting from V at time t0 with
+     * final result in U_[3]. If tau is zero the time-step size is chosen
+     * by the first stage. Returns the time-step size. The input V may be
+     * U_[2], it is overwritten in Step 3 after its last use:
+     */
+    const auto explicit_step = [&](const vector_type &V,
+                                   const Number t0,
+                                   Number tau) {
+      /* Step 1: U1 <- {V, 1} at time t0 + tau */
+      const Number tau_max = hyperbolic_module_->template step<0>(
+          V, {}, {}, {}, U_[0], precomputed_[0], tau);
+      if (tau == Number(0.))
+        tau = tau_max;
+      hyperbolic_module_->apply_boundary_conditions(U_[0], t0 + tau);
+
+      /* Step 2: U2 <- {U1, 2} and {V, -1} at time t0 + 2 tau */
+      hyperbolic_module_->template step<1>(U_[0],
+                                           {{stage_state(0, V)}},
+                                           {{precomputed_[0]}},
+                                           {{Number(-1.)}},
+                                           U_[1],
+                                           precomputed_[1],
+                                           tau);
+      hyperbolic_module_->apply_boundary_conditions(U_[1], t0 + 2. * tau);
+
+      /* Step 3: U3 <- {U2, 2} and {U1, -1} at time t0 + 3 tau */
+      const auto &stage_U1 = stage_state(1, U_[0]);
+      hyperbolic_module_->template step<1>(U_[1],
+                                           {{stage_U1}},
+                                           {{precomputed_[1]}},
+                                           {{Number(-1.)}},
+                                           U_[2],
+                                           precomputed_[2],
+                                           tau);
+      hyperbolic_module_->apply_boundary_conditions(U_[2], t0 + 3. * tau);
+
+      /* Step 4: U4 <- {U3, 8/3} and {U2,-10/3} and {U1, 5/3} at t0 + 4 tau */
+      hyperbolic_module_->template step<2>(
+          U_[2],
+          {{stage_U1, stage_state(2, U_[1])}},
+          {{precomputed_[1], precomputed_[2]}},
+          {{Number(5. / 3.), Number(-10. / 3.)}},
+          U_[3],
+          precomputed_[3],
+          tau);
+      hyperbolic_module_->apply_boundary_conditions(U_[3], t0 + 4. * tau);
+      return tau;
+    };
+
+    const unsigned int m = strang_substeps_current_;
+
+    /* First m explicit ERK(4,3,1) steps with final result in U_[2]: */
+
+    const Number tau = explicit_step(/*input*/ U, t, Number(0.));
+    U_[2].swap(U_[3]);
+    for (unsigned int k = 1; k < m; ++k) {
+      explicit_step(U_[2], t + 4. * k * tau, tau);
+      U_[2].swap(U_[3]);
+    }
+
+    /* Implicit Crank-Nicolson step with final result in U_[2]: */
+
+    parabolic_module_->crank_nicolson_step(U_[2], t, U_[3], 8.0 * m * tau);
+    U_[2].swap(U_[3]);
+
+    /* Second m explicit ERK(4,3,1) steps with final result in U_[3]: */
+
+    for (unsigned int k = 0; k < m; ++k) {
+      explicit_step(/*intermediate*/ U_[2], t + 4. * (m + k) * tau, tau);
+      if (k + 1 < m)
+        U_[2].swap(U_[3]);
+    }
 
     U.swap(U_[3]);
-    return 8. * tau;
+    update_strang_substeps(tau);
+    return 8. * m * tau;
   }
 
 } /* namespace ryujin */
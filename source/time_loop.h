@@ -7,8 +7,12 @@
 
 #include <compile_time_options.h>
 
+#include "checkpointing.h"
 #include "discretization.h"
+#include "energy_counters.h"
+#include "grid_output.h"
 #include "hyperbolic_module.h"
+#include "in_situ_output.h"
 #include "initial_values.h"
 #include "offline_data.h"
 #include "parabolic_module.h"
@@ -20,8 +24,11 @@
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/base/timer.h>
 
+#include <array>
+#include <chrono>
 #include <fstream>
 #include <future>
+#include <map>
 #include <sstream>
 
 namespace ryujin
@@ -90,12 +97,134 @@ namespace ryujin
      */
     void run();
 
+    /**
+     * Run a benchmark instead of the high-level time loop: For every
+     * refinement level given by the "benchmark refinements" option the
+     * mesh is recreated and a fixed number of "benchmark cycles" time
+     * steps is performed without any output, refinement, or
+     * checkpointing. A summary table with the achieved throughput and
+     * the average wall time per cycle of all steps is printed to the
+     * terminal and written to the file "<base name>-benchmark.dat". In
+     * addition, the ns per dof and cycle, the achieved bandwidth and the
+     * floating point performance of all steps is written to the
+     * machine-readable summary "<base name>-benchmark.json". Bandwidth
+     * and floating point rate require the "traffic model" and the
+     * "hardware counters" options of the HyperbolicModule.
+     */
+    void run_benchmark();
+
+    /**
+     * Tune runtime parameters instead of running the high-level time
+     * loop: The parameters listed in "autotune parameters" are varied
+     * one at a time (coordinate descent) over their candidate values.
+     * For every trial the hyperbolic module, the parabolic module, and
+     * the time integrator are prepared anew and "autotune cycles" time
+     * steps are performed from the initial state. A trial is scored by
+     * the simulated time advanced per wall-clock second (so that trading
+     * throughput for a larger time-step size is accounted for) and
+     * rejected if its restart rate exceeds "autotune maximal restart
+     * rate". The mesh and offline data are set up only once. A summary
+     * of all trials is printed to the terminal and the best parameters
+     * are written to the file "<base name>-autotune.prm".
+     */
+    void run_autotune();
+
+    /**
+     * Replay time steps on a production state instead of running the
+     * high-level time loop: The mesh and the state vector are loaded
+     * from the checkpoint "replay checkpoint" and "replay cycles" steps
+     * are performed, every one of them starting from the loaded state.
+     * Depending on "replay target" a single (forward Euler) invocation of
+     * HyperbolicModule::step() with the fixed step size "replay tau" or a
+     * full TimeIntegrator::step() is performed per cycle. No output,
+     * refinement, or checkpointing takes place. A warm-up cycle is
+     * performed first and is not timed. Timer statistics of all phases
+     * are printed to the terminal and written to the file
+     * "<base name>-replay.dat".
+     *
+     * If "replay instrumentation" is set only the timed cycles are
+     * enclosed in CALLGRIND_START_INSTRUMENTATION /
+     * CALLGRIND_STOP_INSTRUMENTATION and a LIKWID marker region
+     * "replay" (started and stopped on every thread).
+     */
+    void run_replay();
+
+    /**
+     * Experimental: Run the Parareal algorithm instead of the high-level
+     * time loop. The interval [0, final time] is split into as many time
+     * slices as there are ranks in @p time_communicator, and every time
+     * slice is handled by one group of MPI ranks (the communicator this
+     * TimeLoop was constructed with). The coarse propagator is a second
+     * TimeIntegrator configured in the subsection "K - Parareal coarse
+     * TimeIntegrator" (e.g., erk_11 with a large CFL number), and the
+     * fine propagator is the regular TimeIntegrator. In every iteration
+     * all groups propagate their slice with the fine integrator in
+     * parallel, exchange the results, and perform the (inexpensive)
+     * sequential coarse correction redundantly. Every group holds the
+     * full state, so the method is only sensible for small meshes where
+     * spatial strong scaling has flattened out. The final state is
+     * written out by the group of the first time slice.
+     */
+    void run_parareal(const MPI_Comm &time_communicator);
+
+    /**
+     * Create the mesh and return a distributed graph communicator with
+     * MPI rank reordering enabled that is derived from the resulting
+     * partition, see Discretization::create_reordered_communicator().
+     * The TimeLoop object is not usable for a subsequent run.
+     */
+    MPI_Comm create_reordered_communicator();
+
+    /**
+     * @name Interface for driving the TimeLoop from an embedding
+     * application (such as the Python module)
+     */
+    //@{
+
+    /**
+     * Create the mesh, set up all modules and initialize @p U with the
+     * initial values at time t = 0.
+     */
+    void prepare_state(vector_type &U);
+
+    /**
+     * Perform a single time step starting from @p U at time @p t and
+     * return the time-step size.
+     */
+    Number step(vector_type &U, Number t);
+
+    /**
+     * Write out the state @p U at time @p t with the configured output
+     * modules under the name "<base name>-@p name". The function waits
+     * until all output has been written.
+     */
+    void write_output(const vector_type &U,
+                      const std::string &name,
+                      Number t,
+                      unsigned int cycle);
+
+    /**
+     * Return a read-only const reference to the discretization.
+     */
+    ACCESSOR_READ_ONLY(discretization)
+
+    /**
+     * Return a read-only const reference to the offline data.
+     */
+    ACCESSOR_READ_ONLY(offline_data)
+
+    //@}
+
   protected:
     /**
      * @name Private methods for run()
      */
     //@{
 
+    void mark_cells_for_adaptive_refinement();
+
+    std::vector<double> compute_cell_cost();
+
     void compute_error(const vector_type &U, Number t);
 
     void output(const vector_type &U,
@@ -103,8 +232,20 @@ namespace ryujin
                 Number t,
                 unsigned int cycle);
 
+    void write_checkpoint(const vector_type &U, Number t, unsigned int cycle);
+
+    /**
+     * Return true (on all ranks) if a final checkpoint has to be written
+     * now, either because a termination signal was received, or because
+     * the remaining walltime is about to fall below the predicted cost
+     * of another cycle and a checkpoint plus the safety margin.
+     */
+    bool final_checkpoint_due(unsigned int cycle);
+
     void print_parameters(std::ostream &stream);
     void print_mpi_partition(std::ostream &stream);
+    void print_thread_placement(std::ostream &stream);
+    void print_setup_timers(std::ostream &stream);
     void print_memory_statistics(std::ostream &stream);
     void print_timers(std::ostream &stream);
     void print_throughput(unsigned int cycle,
@@ -122,6 +263,25 @@ namespace ryujin
                                 unsigned int output_cycle,
                                 bool write_to_logfile = false,
                                 bool final_time = false);
+
+    void write_telemetry(unsigned int cycle, Number t, Number tau);
+
+    /**
+     * Record the compute time per cycle @p compute_time of this rank and
+     * report all ranks whose compute time per locally owned degree of
+     * freedom stayed above the median of all ranks (times one plus the
+     * "straggler detection threshold") for "straggler detection count"
+     * consecutive measurements. Has to be called on all ranks.
+     */
+    void detect_stragglers(double compute_time);
+
+    /**
+     * Return the base name of the on-disk cache for mesh and offline
+     * data. The name contains a hash of all Discretization and
+     * OfflineData parameters, the number of MPI ranks, and the compile
+     * time options. Returns an empty string if caching is disabled.
+     */
+    std::string offline_data_cache_name();
     //@}
 
   private:
@@ -135,17 +295,41 @@ namespace ryujin
     Number t_final_;
     std::vector<Number> t_refinements_;
 
+    unsigned int adaptive_refinement_interval_;
+    std::array<Number, 2> adaptive_refinement_thresholds_;
+    std::array<unsigned int, 2> adaptive_refinement_levels_;
+
+    unsigned int rebalancing_interval_;
+    double rebalancing_threshold_;
+    double rebalancing_indicator_weight_;
+
+    unsigned int straggler_interval_;
+    double straggler_threshold_;
+    unsigned int straggler_count_;
+
     Number output_granularity_;
 
     bool enable_checkpointing_;
+    std::string checkpoint_backend_;
+    std::string checkpoint_local_path_;
+    bool checkpoint_asynchronous_;
+    unsigned int checkpoint_full_interval_;
+    bool checkpoint_offline_data_;
+    std::string offline_data_cache_directory_;
     bool enable_output_full_;
     bool enable_output_levelsets_;
+    bool enable_output_preview_;
+    bool enable_output_in_situ_;
+    bool enable_output_grid_;
     bool enable_compute_error_;
     bool enable_compute_quantities_;
 
     unsigned int output_checkpoint_multiplier_;
     unsigned int output_full_multiplier_;
     unsigned int output_levelsets_multiplier_;
+    unsigned int output_preview_multiplier_;
+    unsigned int output_in_situ_multiplier_;
+    unsigned int output_grid_multiplier_;
     unsigned int output_quantities_multiplier_;
 
     std::vector<std::string> error_quantities_;
@@ -154,8 +338,45 @@ namespace ryujin
     bool resume_;
     bool resume_at_time_zero_;
 
+    std::string warm_start_;
+    unsigned int warm_start_refinements_;
+
     Number terminal_update_interval_;
     bool terminal_show_rank_throughput_;
+    unsigned int terminal_tau_levels_;
+
+    unsigned int telemetry_interval_;
+
+    double terminal_peak_bandwidth_;
+
+    bool energy_counters_enabled_;
+
+    bool transparent_huge_pages_;
+
+    bool pin_threads_;
+
+    std::vector<unsigned int> benchmark_refinements_;
+    unsigned int benchmark_cycles_;
+
+    std::string replay_checkpoint_;
+    unsigned int replay_cycles_;
+    Number replay_tau_;
+    std::string replay_target_;
+    bool replay_instrumentation_;
+
+    std::string autotune_parameters_;
+    unsigned int autotune_cycles_;
+    double autotune_maximal_restart_rate_;
+
+    unsigned int ensemble_size_;
+
+    double walltime_limit_;
+    bool walltime_from_environment_;
+    double walltime_margin_;
+    bool checkpoint_on_signal_;
+
+    unsigned int parareal_iterations_;
+    Number parareal_tolerance_;
 
     //@}
     /**
@@ -166,6 +387,8 @@ namespace ryujin
     const MPI_Comm &mpi_communicator_;
 
     std::map<std::string, dealii::Timer> computing_timer_;
+    std::map<std::string, dealii::Timer> setup_timer_;
+    EnergyCounters energy_counters_;
 
     HyperbolicSystem hyperbolic_system_;
     ParabolicSystem parabolic_system_;
@@ -175,15 +398,42 @@ namespace ryujin
     HyperbolicModule<Description, dim, Number> hyperbolic_module_;
     ParabolicModule<Description, dim, Number> parabolic_module_;
     TimeIntegrator<Description, dim, Number> time_integrator_;
+    TimeIntegrator<Description, dim, Number> coarse_time_integrator_;
     Postprocessor<Description, dim, Number> postprocessor_;
     VTUOutput<Description, dim, Number> vtu_output_;
+    InSituOutput<Description, dim, Number> in_situ_output_;
+    GridOutput<Description, dim, Number> grid_output_;
     Quantities<Description, dim, Number> quantities_;
 
+    Checkpointing::CollectiveWriter<Number> checkpoint_writer_;
+    bool offline_data_checkpointed_;
+
+    /* Walltime-aware checkpointing: */
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point walltime_deadline_;
+    double last_checkpoint_duration_;
+
     const unsigned int mpi_rank_;
     const unsigned int n_mpi_processes_;
 
     std::ofstream logfile_; /* log file */
 
+    std::ofstream telemetry_file_; /* telemetry stream (JSON lines) */
+
+    /* Straggler detection (only populated on rank 0): */
+    std::vector<std::string> straggler_hostnames_;
+    std::vector<unsigned int> straggler_slow_measurements_;
+
+    /* Values recorded at the last telemetry output: */
+    struct TelemetryData {
+      unsigned int cycle = 0;
+      double wall_time = 0.;
+      unsigned long long n_limited_edges = 0;
+      unsigned long long n_edges = 0;
+      double energy = 0.;
+      std::map<std::string, double> timer_wall_time;
+    } telemetry_previous_;
+
     //@}
   };
 
@@ -6,24 +6,50 @@
 #pragma once
 
 #include "checkpointing.h"
+#include "huge_pages.h"
 #include "introspection.h"
+#include "local_index_handling.h"
+#include "openmp.h"
 #include "scope.h"
 #include "solution_transfer.h"
+#include "thread_affinity.h"
 #include "time_loop.h"
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/revision.h>
 #include <deal.II/base/work_stream.h>
-#include <deal.II/numerics/vector_tools.h>
-#include <deal.II/numerics/vector_tools.templates.h>
+#include <deal.II/fe/fe_values.h>
 
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <tuple>
 
 using namespace dealii;
 
 namespace ryujin
 {
+  namespace
+  {
+    /*
+     * Set by the signal handler installed with "checkpoint on signal":
+     */
+    volatile std::sig_atomic_t checkpoint_signal_received = 0;
+
+    void checkpoint_signal_handler(int /*signal*/)
+    {
+      checkpoint_signal_received = 1;
+    }
+  } // namespace
+
+
   template <typename Description, int dim, typename Number>
   TimeLoop<Description, dim, Number>::TimeLoop(const MPI_Comm &mpi_comm)
       : ParameterAcceptor("/A - TimeLoop")
@@ -52,6 +78,12 @@ namespace ryujin
                          hyperbolic_module_,
                          parabolic_module_,
                          "/H - TimeIntegrator")
+      , coarse_time_integrator_(mpi_communicator_,
+                                computing_timer_,
+                                offline_data_,
+                                hyperbolic_module_,
+                                parabolic_module_,
+                                "/K - Parareal coarse TimeIntegrator")
       , postprocessor_(mpi_communicator_,
                        hyperbolic_system_,
                        offline_data_,
@@ -61,10 +93,21 @@ namespace ryujin
                     hyperbolic_module_,
                     postprocessor_,
                     "/I - VTUOutput")
+      , in_situ_output_(mpi_communicator_,
+                        offline_data_,
+                        postprocessor_,
+                        "/I - VTUOutput")
+      , grid_output_(mpi_communicator_,
+                     hyperbolic_system_,
+                     offline_data_,
+                     "/I - GridOutput")
       , quantities_(mpi_communicator_,
                     hyperbolic_system_,
                     offline_data_,
                     "/J - Quantities")
+      , start_time_(std::chrono::steady_clock::now())
+      , walltime_deadline_(std::chrono::steady_clock::time_point::max())
+      , last_checkpoint_duration_(0.)
       , mpi_rank_(dealii::Utilities::MPI::this_mpi_process(mpi_communicator_))
       , n_mpi_processes_(
             dealii::Utilities::MPI::n_mpi_processes(mpi_communicator_))
@@ -80,6 +123,76 @@ namespace ryujin
                   "List of points in (simulation) time at which the mesh will "
                   "be globally refined");
 
+    adaptive_refinement_interval_ = 0;
+    add_parameter("adaptive refinement interval",
+                  adaptive_refinement_interval_,
+                  "If set to a nonzero number n the mesh is adaptively "
+                  "refined and coarsened every n cycles based on the "
+                  "indicator values alpha_i of the last time step. Set to 0 "
+                  "to disable.");
+
+    adaptive_refinement_thresholds_ = {Number(0.1), Number(0.5)};
+    add_parameter(
+        "adaptive refinement thresholds",
+        adaptive_refinement_thresholds_,
+        "Adaptive refinement: a cell is coarsened if the maximal indicator "
+        "value alpha_i on the cell is below the first threshold, and it is "
+        "refined if it is above the second threshold");
+
+    adaptive_refinement_levels_ = {0, 10};
+    add_parameter("adaptive refinement levels",
+                  adaptive_refinement_levels_,
+                  "Adaptive refinement: the minimal and maximal refinement "
+                  "level a cell can be coarsened to, or refined to");
+
+    rebalancing_interval_ = 0;
+    add_parameter(
+        "mesh rebalancing interval",
+        rebalancing_interval_,
+        "If set to a nonzero number n the throughput of every MPI rank is "
+        "measured over n cycles and the mesh is repartitioned such that "
+        "faster ranks receive proportionally more cells. Requires \"mesh "
+        "repartitioning\". Set to 0 to disable.");
+
+    rebalancing_threshold_ = 0.;
+    add_parameter("mesh rebalancing threshold",
+                  rebalancing_threshold_,
+                  "Mesh rebalancing: only repartition the mesh if the load "
+                  "imbalance, i.e., the maximal compute time of all ranks "
+                  "over the average compute time minus one, exceeds this "
+                  "threshold");
+
+    rebalancing_indicator_weight_ = 0.;
+    add_parameter(
+        "mesh rebalancing indicator weight",
+        rebalancing_indicator_weight_,
+        "Mesh rebalancing: additional cost of a cell with maximal indicator "
+        "value alpha_i = 1 relative to the cost of an interior cell. The "
+        "cost is scaled linearly with the maximal indicator of the cell "
+        "and accounts for the additional limiter work at shocks");
+
+    straggler_interval_ = 0;
+    add_parameter(
+        "straggler detection interval",
+        straggler_interval_,
+        "If set to a nonzero number n the compute time (excluding "
+        "synchronization) of every MPI rank is measured over n cycles and "
+        "ranks that are persistently slower than the median are reported "
+        "together with their host name. Set to 0 to disable.");
+
+    straggler_threshold_ = 0.2;
+    add_parameter("straggler detection threshold",
+                  straggler_threshold_,
+                  "Straggler detection: a rank is considered slow if its "
+                  "compute time per locally owned degree of freedom exceeds "
+                  "the median of all ranks by more than this fraction");
+
+    straggler_count_ = 3;
+    add_parameter("straggler detection count",
+                  straggler_count_,
+                  "Straggler detection: number of consecutive measurements "
+                  "a rank has to be slow before it is reported");
+
     output_granularity_ = Number(0.01);
     add_parameter(
         "output granularity",
@@ -95,6 +208,63 @@ namespace ryujin
         "at output granularity intervals. The frequency is determined by "
         "\"output granularity\" times \"output checkpoint multiplier\"");
 
+    checkpoint_backend_ = "solution transfer";
+    add_parameter(
+        "checkpoint backend",
+        checkpoint_backend_,
+        "Backend used for writing checkpoints: \"solution transfer\" attaches "
+        "the state to the mesh and allows to resume on a different number of "
+        "ranks, \"mpi io\" writes the locally owned state directly with "
+        "collective MPI IO and requires to resume with an identical "
+        "partitioning, \"burst buffer\" behaves like \"mpi io\" but writes "
+        "the state of every rank into \"checkpoint local path\" first and "
+        "drains it to the checkpoint location in the background, \"cell "
+        "ordered\" writes the state cell by cell in the partition independent "
+        "order of the p4est forest with collective MPI IO and allows to resume "
+        "on a different number of ranks");
+
+    checkpoint_local_path_ = "";
+    add_parameter("checkpoint local path",
+                  checkpoint_local_path_,
+                  "Node-local directory (for example on NVMe storage) used "
+                  "for staging checkpoints with the \"burst buffer\" backend");
+
+    checkpoint_asynchronous_ = false;
+    add_parameter("checkpoint asynchronous",
+                  checkpoint_asynchronous_,
+                  "If enabled, and if the \"mpi io\" backend is used, the "
+                  "state is written with a nonblocking collective write that "
+                  "overlaps with subsequent time steps");
+
+    checkpoint_full_interval_ = 1;
+    add_parameter(
+        "checkpoint full interval",
+        checkpoint_full_interval_,
+        "Only used with the \"mpi io\" and \"burst buffer\" backends: Only "
+        "every n-th checkpoint stores the mesh and the full state. All other "
+        "checkpoints store a compressed difference against the last full "
+        "checkpoint. The default of 1 writes full checkpoints only");
+
+    checkpoint_offline_data_ = false;
+    add_parameter(
+        "checkpoint offline data",
+        checkpoint_offline_data_,
+        "If enabled, assembled offline data (matrices, lumped mass matrix, "
+        "boundary map) is stored alongside checkpoints once per mesh. On "
+        "resume with an unchanged mesh and partitioning the offline data is "
+        "read in instead of being reassembled");
+
+    offline_data_cache_directory_ = "";
+    add_parameter(
+        "offline data cache directory",
+        offline_data_cache_directory_,
+        "If set to a (shared) directory, the refined mesh and the assembled "
+        "offline data are stored in this directory under a key computed from "
+        "the Discretization and OfflineData parameters, the number of MPI "
+        "ranks, the compile time options, and the code revision. Subsequent "
+        "runs with the same key read in mesh and offline data instead of "
+        "recreating them");
+
     enable_output_full_ = false;
     add_parameter("enable output full",
                   enable_output_full_,
@@ -108,6 +278,32 @@ namespace ryujin
         "Write out levelsets pvtu records. The frequency is determined by "
         "\"output granularity\" times \"output levelsets multiplier\"");
 
+    enable_output_preview_ = false;
+    add_parameter(
+        "enable output preview",
+        enable_output_preview_,
+        "Write out the solution interpolated to the triangulation level "
+        "\"preview level\". The frequency is determined by \"output "
+        "granularity\" times \"output preview multiplier\"");
+
+    enable_output_in_situ_ = false;
+    add_parameter(
+        "enable output in situ",
+        enable_output_in_situ_,
+        "Pass the state and postprocessed quantities to the ParaView "
+        "Catalyst pipelines listed in \"catalyst scripts\" instead of "
+        "writing files. The frequency is determined by \"output granularity\" "
+        "times \"output in situ multiplier\"");
+
+    enable_output_grid_ = false;
+    add_parameter(
+        "enable output grid",
+        enable_output_grid_,
+        "Resample the state onto the uniform Cartesian grid described in "
+        "the section \"I - GridOutput\" and write it out as a binary array. "
+        "The frequency is determined by \"output granularity\" times "
+        "\"output grid multiplier\"");
+
     enable_compute_error_ = false;
     add_parameter("enable compute error",
                   enable_compute_error_,
@@ -141,6 +337,24 @@ namespace ryujin
                   "Multiplicative modifier applied to \"output granularity\" "
                   "that determines the levelsets pvtu writeout granularity");
 
+    output_preview_multiplier_ = 1;
+    add_parameter("output preview multiplier",
+                  output_preview_multiplier_,
+                  "Multiplicative modifier applied to \"output granularity\" "
+                  "that determines the preview pvtu writeout granularity");
+
+    output_in_situ_multiplier_ = 1;
+    add_parameter("output in situ multiplier",
+                  output_in_situ_multiplier_,
+                  "Multiplicative modifier applied to \"output granularity\" "
+                  "that determines the in-situ visualization granularity");
+
+    output_grid_multiplier_ = 1;
+    add_parameter("output grid multiplier",
+                  output_grid_multiplier_,
+                  "Multiplicative modifier applied to \"output granularity\" "
+                  "that determines the resampled grid writeout granularity");
+
     output_quantities_multiplier_ = 1;
     add_parameter(
         "output quantities multiplier",
@@ -171,6 +385,26 @@ namespace ryujin
                   resume_at_time_zero_,
                   "Resume from the latest checkpoint but set the time to t=0.");
 
+    warm_start_ = "";
+    add_parameter(
+        "warm start",
+        warm_start_,
+        "If set to the base name of a previous run, start from the last "
+        "checkpoint of that run (written on a possibly coarser mesh) instead "
+        "of the initial values. A checkpoint backend that is independent "
+        "of the partitioning allows for a different number of MPI ranks. "
+        "The state is "
+        "interpolated in parallel onto the mesh obtained by \"warm start "
+        "refinements\" additional global refinements of the checkpointed "
+        "mesh. The time and output cycle of the checkpoint are kept unless "
+        "\"resume at time zero\" is set.");
+
+    warm_start_refinements_ = 1;
+    add_parameter("warm start refinements",
+                  warm_start_refinements_,
+                  "Warm start: number of global refinements of the "
+                  "checkpointed mesh");
+
     terminal_update_interval_ = 5;
     add_parameter("terminal update interval",
                   terminal_update_interval_,
@@ -185,6 +419,184 @@ namespace ryujin
                   "number of threads (per rank). If set to false then a plain "
                   "average per thread \"CPU\" throughput value is computed by "
                   "using the umodified total accumulated CPU time.");
+
+    terminal_tau_levels_ = 0;
+    add_parameter("terminal tau levels",
+                  terminal_tau_levels_,
+                  "If set to a nonzero number n the distribution of the local "
+                  "admissible time-step sizes over n levels (tau_min * 2^k) "
+                  "is printed together with an estimate of the possible "
+                  "speedup of a multirate scheme. Set to 0 to disable.");
+
+    telemetry_interval_ = 0;
+    add_parameter("telemetry interval",
+                  telemetry_interval_,
+                  "If set to a nonzero number n a line of performance "
+                  "telemetry (timer deltas, throughput, time-step size, "
+                  "restarts, warnings, solver statistics and memory, reduced "
+                  "over all ranks) is appended every n cycles to the file "
+                  "<base name>-telemetry.jsonl in JSON lines format. Set to 0 "
+                  "to disable.");
+
+    terminal_peak_bandwidth_ = 0.;
+    add_parameter("terminal peak bandwidth",
+                  terminal_peak_bandwidth_,
+                  "Peak memory bandwidth per rank (in GB/s). If the traffic "
+                  "model of the HyperbolicModule is enabled the achieved "
+                  "bandwidth of every step is additionally reported as a "
+                  "fraction of this value. Set to 0 to disable.");
+
+    energy_counters_enabled_ = false;
+    add_parameter("energy counters",
+                  energy_counters_enabled_,
+                  "Record the energy consumption of all nodes (RAPL package "
+                  "and DRAM counters of the powercap interface, and NVML "
+                  "if configured) per timer section and report it in Joules "
+                  "per Qdof and substep in the terminal output and the "
+                  "telemetry stream");
+
+    add_parameter("benchmark refinements",
+                  benchmark_refinements_,
+                  "List of global refinement levels used when running in "
+                  "benchmark mode (--benchmark). If empty, the mesh "
+                  "refinement of the discretization is used.");
+
+    benchmark_cycles_ = 10;
+    add_parameter("benchmark cycles",
+                  benchmark_cycles_,
+                  "Number of cycles performed per refinement level when "
+                  "running in benchmark mode (--benchmark)");
+
+    add_parameter("replay checkpoint",
+                  replay_checkpoint_,
+                  "Base name of the checkpoint loaded in replay mode "
+                  "(--replay). If empty the base name is used");
+
+    replay_cycles_ = 10;
+    add_parameter("replay cycles",
+                  replay_cycles_,
+                  "Number of (timed) cycles performed in replay mode "
+                  "(--replay)");
+
+    replay_tau_ = Number(0.);
+    add_parameter("replay tau",
+                  replay_tau_,
+                  "Replay mode (--replay): fixed time-step size of the "
+                  "replayed hyperbolic steps. If set to 0 the CFL bound of "
+                  "the warm-up step is used");
+
+    replay_target_ = "hyperbolic module";
+    add_parameter("replay target",
+                  replay_target_,
+                  "Replay mode (--replay): replay single steps of the "
+                  "\"hyperbolic module\" or complete steps of the \"time "
+                  "integrator\"");
+
+    replay_instrumentation_ = false;
+    add_parameter("replay instrumentation",
+                  replay_instrumentation_,
+                  "Replay mode (--replay): enclose only the timed cycles "
+                  "in Callgrind instrumentation and a LIKWID marker region "
+                  "\"replay\"");
+
+    add_parameter(
+        "autotune parameters",
+        autotune_parameters_,
+        "List of runtime parameters explored when running in autotune mode "
+        "(--autotune). Entries are separated by \";\" and have the form "
+        "\"<subsection>/<parameter>: <value 1> | <value 2> | ...\", for "
+        "example \"F - HyperbolicModule/limiter iterations: 1 | 2\". The "
+        "special entry \"threads: ...\" varies the number of threads. "
+        "Only parameters of the equation, the hyperbolic and parabolic "
+        "modules, and the time integrator take effect.");
+
+    autotune_cycles_ = 10;
+    add_parameter("autotune cycles",
+                  autotune_cycles_,
+                  "Number of cycles performed per trial when running in "
+                  "autotune mode (--autotune)");
+
+    autotune_maximal_restart_rate_ = 0.05;
+    add_parameter("autotune maximal restart rate",
+                  autotune_maximal_restart_rate_,
+                  "Maximal number of restarts per cycle of the hyperbolic "
+                  "and parabolic modules tolerated for an autotune trial");
+
+    transparent_huge_pages_ = false;
+    add_parameter("transparent huge pages",
+                  transparent_huge_pages_,
+                  "Advise the kernel to back the large arrays of the SIMD "
+                  "sparsity pattern, all SIMD sparse matrices and all "
+                  "multicomponent vectors with transparent huge pages. This "
+                  "reduces dTLB misses of the indirect access to U_j");
+
+    pin_threads_ = false;
+    add_parameter("pin threads",
+                  pin_threads_,
+                  "Pin every OpenMP thread to a single CPU. The CPUs of the "
+                  "affinity mask of every rank (as set by the launcher) are "
+                  "handed out compactly per socket, one hardware thread per "
+                  "physical core first. Ranks on the same node with an "
+                  "identical affinity mask split the CPUs evenly");
+
+    ensemble_size_ = 1;
+    add_parameter(
+        "ensemble size",
+        ensemble_size_,
+        "Number of ensemble members. If set to a value larger than one, "
+        "additional state vectors are interpolated from the (randomly "
+        "perturbed) initial values and advanced with their own time step "
+        "size on the same mesh, OfflineData, and modules. Every member "
+        "catches up with the first member after each cycle. Output files "
+        "of member k carry the suffix \"-member<k>\". Ensemble mode does "
+        "not support mesh refinement, checkpointing, resume, and options "
+        "that carry information from one time step to the next (\"wave "
+        "speed reuse tolerance\", \"lagged indicator\", and the initial "
+        "guess extrapolation and eigenvalue reuse of the parabolic "
+        "solver)");
+
+    walltime_limit_ = 0.;
+    add_parameter("walltime limit",
+                  walltime_limit_,
+                  "Walltime limit of the job in seconds (measured from the "
+                  "start of the program). If checkpointing is enabled, a "
+                  "final checkpoint is written and the computation stopped "
+                  "once the remaining walltime falls below the predicted "
+                  "cost of a cycle and a checkpoint plus the walltime "
+                  "margin. Set to 0 to disable");
+
+    walltime_from_environment_ = false;
+    add_parameter("walltime from environment",
+                  walltime_from_environment_,
+                  "Determine the walltime limit from the end time of the "
+                  "batch job given by the SLURM_JOB_END_TIME environment "
+                  "variable (if set)");
+
+    walltime_margin_ = 300.;
+    add_parameter("walltime margin",
+                  walltime_margin_,
+                  "Safety margin in seconds for walltime-aware "
+                  "checkpointing");
+
+    parareal_iterations_ = 4;
+    add_parameter("parareal iterations",
+                  parareal_iterations_,
+                  "Parareal mode (--parareal): maximal number of parareal "
+                  "iterations");
+
+    parareal_tolerance_ = Number(0.);
+    add_parameter("parareal tolerance",
+                  parareal_tolerance_,
+                  "Parareal mode (--parareal): stop iterating once the "
+                  "maximal change of all slice start states (in the "
+                  "l_infty norm of the conserved state) drops below this "
+                  "tolerance");
+
+    checkpoint_on_signal_ = false;
+    add_parameter("checkpoint on signal",
+                  checkpoint_on_signal_,
+                  "If checkpointing is enabled, write a final checkpoint and "
+                  "stop the computation after receiving SIGTERM or SIGUSR1");
   }
 
 
@@ -197,30 +609,180 @@ namespace ryujin
 
     const bool write_output_files = enable_checkpointing_ ||
                                     enable_output_full_ ||
-                                    enable_output_levelsets_;
+                                    enable_output_levelsets_ ||
+                                    enable_output_preview_ ||
+                                    enable_output_in_situ_ ||
+                                    enable_output_grid_ ||
+                                    vtu_output_.has_regions_of_interest();
 
     /* Attach log file: */
     if (mpi_rank_ == 0)
       logfile_.open(base_name_ + ".log");
 
+    /* Attach telemetry stream: */
+    if (mpi_rank_ == 0 && telemetry_interval_ != 0)
+      telemetry_file_.open(base_name_ + "-telemetry.jsonl",
+                           resume_ ? std::ios_base::app : std::ios_base::out);
+    telemetry_previous_ = TelemetryData();
+
+    /* Attach energy counters to all Scope objects: */
+    energy_counters_.reinit(energy_counters_enabled_, mpi_communicator_);
+    EnergyCounters::set_active(&energy_counters_);
+
+    /* Record fine grained timings of the setup phase: */
+    setup_timer_.clear();
+    SetupScope::set_active(&setup_timer_);
+
     print_parameters(logfile_);
 
+    set_transparent_huge_pages(transparent_huge_pages_);
+
+    if (pin_threads_) {
+      const unsigned int failed =
+          pin_threads_compact(mpi_communicator_) ? 0 : 1;
+      if (Utilities::MPI::max(failed, mpi_communicator_) != 0)
+        print_info("warning: pinning threads failed on at least one rank");
+    }
+    print_thread_placement(logfile_);
+
+    straggler_slow_measurements_.clear();
+    if (straggler_interval_ != 0)
+      straggler_hostnames_ = Utilities::MPI::gather(
+          mpi_communicator_, Utilities::System::get_hostname(), 0);
+
+    /* Set up walltime-aware checkpointing: */
+    walltime_deadline_ = std::chrono::steady_clock::time_point::max();
+    if (walltime_limit_ > 0.)
+      walltime_deadline_ =
+          start_time_ + std::chrono::duration_cast<
+                            std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(walltime_limit_));
+    if (walltime_from_environment_) {
+      if (const char *end = std::getenv("SLURM_JOB_END_TIME")) {
+        const auto now = std::chrono::system_clock::now();
+        const double remaining =
+            std::atof(end) -
+            std::chrono::duration<double>(now.time_since_epoch()).count();
+        walltime_deadline_ = std::min(
+            walltime_deadline_,
+            std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(remaining)));
+      }
+    }
+
+    if (checkpoint_on_signal_) {
+      checkpoint_signal_received = 0;
+      std::signal(SIGTERM, checkpoint_signal_handler);
+      std::signal(SIGUSR1, checkpoint_signal_handler);
+    }
+
+    AssertThrow(checkpoint_backend_ == "solution transfer" ||
+                    checkpoint_backend_ == "mpi io" ||
+                    checkpoint_backend_ == "burst buffer" ||
+                    checkpoint_backend_ == "cell ordered",
+                ExcMessage("Unknown checkpoint backend »" +
+                           checkpoint_backend_ + "«"));
+    AssertThrow(checkpoint_backend_ != "burst buffer" ||
+                    !checkpoint_local_path_.empty(),
+                ExcMessage("The \"burst buffer\" checkpoint backend requires "
+                           "a \"checkpoint local path\""));
+    checkpoint_writer_.set_asynchronous(checkpoint_asynchronous_);
+    checkpoint_writer_.set_local_path(
+        checkpoint_backend_ == "burst buffer" ? checkpoint_local_path_ : "");
+    checkpoint_writer_.set_full_interval(checkpoint_full_interval_);
+
+    AssertThrow(ensemble_size_ > 0,
+                ExcMessage("The ensemble size must be at least one"));
+    AssertThrow(ensemble_size_ == 1 ||
+                    (!enable_checkpointing_ && !resume_ &&
+                     t_refinements_.empty() &&
+                     adaptive_refinement_interval_ == 0),
+                ExcMessage("Ensemble mode does not support mesh refinement, "
+                           "checkpointing, and resume"));
+
+    AssertThrow(ensemble_size_ == 1 || (!hyperbolic_module_.keeps_history() &&
+                                        !parabolic_module_.keeps_history()),
+                ExcMessage("Ensemble mode does not support options that "
+                           "carry information from one time step to the "
+                           "next: \"wave speed reuse tolerance\", \"lagged "
+                           "indicator\", \"extrapolate initial guess\", and "
+                           "\"multigrid - eigenvalue reuse tolerance\""));
+
+    AssertThrow(rebalancing_interval_ == 0 ||
+                    (have_distributed_triangulation<dim> &&
+                     discretization_.repartitioning() && ensemble_size_ == 1),
+                ExcMessage("Mesh rebalancing requires a distributed "
+                           "triangulation with \"mesh repartitioning\" "
+                           "enabled and does not support ensemble mode"));
+
     Number t = 0.;
     unsigned int output_cycle = 0;
     vector_type U;
 
+    const std::string offline_data_name = base_name_ + "-checkpoint.offline";
+
     /* Prepare data structures: */
 
-    const auto prepare_compute_kernels = [&]() {
-      offline_data_.prepare(problem_dimension);
-      hyperbolic_module_.prepare();
-      parabolic_module_.prepare();
-      time_integrator_.prepare();
-      postprocessor_.prepare();
-      vtu_output_.prepare();
-      /* We skip the first output cycle for quantities: */
-      quantities_.prepare(base_name_, output_cycle == 0 ? 1 : output_cycle);
-      print_mpi_partition(logfile_);
+    const auto prepare_compute_kernels =
+        [&](const std::string &assembled_name = "") {
+          offline_data_.prepare(problem_dimension, assembled_name);
+          offline_data_checkpointed_ = false;
+          /* Differential checkpoints require an unchanged mesh: */
+          checkpoint_writer_.invalidate_reference();
+          {
+            SetupScope scope("modules - hyperbolic module");
+            hyperbolic_module_.prepare();
+          }
+          {
+            SetupScope scope("modules - parabolic module");
+            parabolic_module_.prepare();
+          }
+          {
+            SetupScope scope("modules - time integrator");
+            time_integrator_.prepare();
+          }
+          {
+            SetupScope scope("output - postprocessor and vtu");
+            postprocessor_.prepare();
+            vtu_output_.prepare();
+            if (enable_output_in_situ_)
+              in_situ_output_.prepare();
+            if (enable_output_grid_)
+              grid_output_.prepare();
+          }
+          {
+            SetupScope scope("output - quantities");
+            /* We skip the first output cycle for quantities: */
+            quantities_.prepare(base_name_,
+                                output_cycle == 0 ? 1 : output_cycle);
+          }
+          print_mpi_partition(logfile_);
+        };
+
+    /*
+     * Refine and coarsen the mesh according to the flags set by the
+     * function object @p mark_cells and transfer the state vector U to the
+     * new mesh:
+     */
+    const auto refine_mesh = [&](const auto &mark_cells) {
+      /* A pending write-out still refers to the old mesh: */
+      vtu_output_.wait();
+
+      SolutionTransfer<Description, dim, Number> solution_transfer(
+          offline_data_, hyperbolic_system_);
+
+      auto &triangulation = discretization_.triangulation();
+      mark_cells(triangulation);
+      triangulation.prepare_coarsening_and_refinement();
+
+      solution_transfer.prepare_for_interpolation(U);
+
+      triangulation.execute_coarsening_and_refinement();
+      discretization_.update_mapping();
+      prepare_compute_kernels();
+
+      solution_transfer.interpolate(U);
     };
 
     {
@@ -229,10 +791,14 @@ namespace ryujin
 
       if (resume_) {
         print_info("resuming computation: recreating mesh");
-        Checkpointing::load_mesh(discretization_, base_name_);
+        {
+          SetupScope setup_scope("mesh - load from checkpoint");
+          Checkpointing::load_mesh(discretization_, base_name_);
+        }
 
         print_info("preparing compute kernels");
-        prepare_compute_kernels();
+        prepare_compute_kernels(checkpoint_offline_data_ ? offline_data_name
+                                                         : "");
 
         print_info("resuming computation: loading state vector");
         U.reinit(offline_data_.vector_partitioner());
@@ -257,15 +823,98 @@ namespace ryujin
                            [&](const Number &t_ref) { return (t >= t_ref); });
         t_refinements_.erase(new_end, t_refinements_.end());
 
+      } else if (!warm_start_.empty()) {
+        print_info("warm start: recreating mesh of »" + warm_start_ + "«");
+        {
+          SetupScope setup_scope("mesh - load from checkpoint");
+          Checkpointing::load_mesh(discretization_, warm_start_);
+        }
+
+        print_info("preparing compute kernels");
+        prepare_compute_kernels();
+
+        print_info("warm start: loading state vector");
+        U.reinit(offline_data_.vector_partitioner());
+        Checkpointing::load_state_vector(
+            offline_data_, warm_start_, U, t, output_cycle, mpi_communicator_);
+
+        if (resume_at_time_zero_) {
+          t = 0.;
+          output_cycle = 0;
+        }
+
+        /* Workaround: Reinitialize Quantities with correct output cycle: */
+        quantities_.prepare(base_name_, output_cycle);
+
+        for (unsigned int level = 0; level < warm_start_refinements_;
+             ++level) {
+          print_info("warm start: refining mesh and interpolating state");
+          refine_mesh([](auto &triangulation) {
+            for (auto &cell : triangulation.active_cell_iterators())
+              cell->set_refine_flag();
+          });
+        }
+
+        /* Remove outdated refinement timestamps: */
+        const auto new_end =
+            std::remove_if(t_refinements_.begin(),
+                           t_refinements_.end(),
+                           [&](const Number &t_ref) { return (t >= t_ref); });
+        t_refinements_.erase(new_end, t_refinements_.end());
+
       } else {
 
-        print_info("creating mesh");
-        discretization_.prepare();
+        const auto cache_name = offline_data_cache_name();
+
+        const auto cached = [&](const std::string &filename) {
+          const bool exists =
+              !cache_name.empty() && std::filesystem::exists(filename);
+          return Utilities::MPI::min(exists ? 1u : 0u, mpi_communicator_) ==
+                 1u;
+        };
+
+        const std::string rank_suffix = "." + std::to_string(mpi_rank_);
+        const bool mesh_cached =
+            have_distributed_triangulation<dim> &&
+            cached(cache_name + "-checkpoint.mesh");
+        const bool offline_data_cached =
+            cached(cache_name + "-checkpoint.offline" + rank_suffix);
+
+        if (mesh_cached) {
+          print_info("reading cached mesh");
+          /* load_mesh() resets the refinement level, restore it: */
+          const auto refinement = discretization_.refinement();
+          {
+            SetupScope setup_scope("mesh - load from cache");
+            Checkpointing::load_mesh(discretization_, cache_name);
+          }
+          discretization_.refinement() = refinement;
+        } else {
+          print_info("creating mesh");
+          discretization_.prepare();
+        }
 
         print_info("preparing compute kernels");
-        prepare_compute_kernels();
+        prepare_compute_kernels(offline_data_cached
+                                    ? cache_name + "-checkpoint.offline"
+                                    : "");
+
+        if (!cache_name.empty()) {
+          if constexpr (have_distributed_triangulation<dim>) {
+            if (!mesh_cached) {
+              print_info("storing mesh in cache");
+              discretization_.triangulation().save(cache_name +
+                                                   "-checkpoint.mesh");
+            }
+          }
+          if (!offline_data_cached) {
+            print_info("storing offline data in cache");
+            offline_data_.write_assembled(cache_name + "-checkpoint.offline");
+          }
+        }
 
         print_info("interpolating initial values");
+        SetupScope setup_scope("initial values - interpolation");
         U.reinit(offline_data_.vector_partitioner());
         U = initial_values_.interpolate();
 #ifdef DEBUG
@@ -283,6 +932,116 @@ namespace ryujin
       }
     }
 
+    /*
+     * Additional ensemble members share the mesh, OfflineData and all
+     * modules with the primary state U and only differ in their
+     * (perturbed) initial values.
+     *
+     * Members are advanced one after another with the regular (dof
+     * vectorized) kernels of the HyperbolicModule. Vectorizing across
+     * members instead would require a common step size for all members
+     * and an interleaved storage of the member states.
+     *
+     * Every member keeps its own state of the CFL controller of the
+     * TimeIntegrator and its own indicator vector alpha of the
+     * HyperbolicModule (used for output). All other information carried
+     * over from one time step to the next is discarded when switching
+     * between members, and options relying on such information are
+     * rejected above. Thus, the trajectory of a member does not depend on
+     * the other members. The controller statistics printed in the status
+     * report refer to the primary state U:
+     */
+
+    using ControllerState =
+        typename TimeIntegrator<Description, dim, Number>::ControllerState;
+
+    struct EnsembleMember {
+      vector_type U;
+      Number t = 0.;
+      unsigned int output_cycle = 0;
+      ControllerState controller_state;
+      scalar_type alpha;
+    };
+    std::vector<EnsembleMember> ensemble(ensemble_size_ - 1);
+
+    if (!ensemble.empty()) {
+      print_info("interpolating initial values of ensemble members");
+      for (auto &member : ensemble) {
+        member.U.reinit(offline_data_.vector_partitioner());
+        member.U = initial_values_.interpolate();
+        member.controller_state = time_integrator_.controller_state();
+        member.alpha.reinit(offline_data_.scalar_partitioner());
+      }
+    }
+
+    /*
+     * Discard all information of the modules that refers to the
+     * trajectory advanced last and load the given controller state:
+     */
+    const auto switch_trajectory = [&](const ControllerState &state) {
+      hyperbolic_module_.reset_history();
+      parabolic_module_.reset_history();
+      time_integrator_.controller_state(state);
+    };
+
+    /*
+     * Advance all ensemble members up to (at least) time @p t_target
+     * and perform output as necessary:
+     */
+    const auto advance_ensemble = [&](const Number t_target) {
+      if (ensemble.empty())
+        return;
+
+      const auto primary_state = time_integrator_.controller_state();
+
+      for (unsigned int k = 0; k < ensemble.size(); ++k) {
+        auto &[U_k, t_k, output_cycle_k, controller_state_k, alpha_k] =
+            ensemble[k];
+        const auto name =
+            base_name_ + "-member" + Utilities::to_string(k + 1, 3);
+
+        hyperbolic_module_.alpha().swap(alpha_k);
+        switch_trajectory(controller_state_k);
+
+        for (;;) {
+          if (t_k >= output_cycle_k * output_granularity_) {
+            if (write_output_files)
+              output(U_k, name + "-solution", t_k, output_cycle_k);
+            ++output_cycle_k;
+          }
+
+          if (t_k >= t_target || t_k >= t_final_)
+            break;
+
+          t_k += time_integrator_.step(U_k, t_k);
+        }
+
+        controller_state_k = time_integrator_.controller_state();
+        hyperbolic_module_.alpha().swap(alpha_k);
+      }
+
+      switch_trajectory(primary_state);
+    };
+
+    /*
+     * Return the accumulated compute time of the HyperbolicModule on this
+     * rank. We only sum up the time steps of the HyperbolicModule and omit
+     * the synchronization barrier, i.e., the time a rank waits for the
+     * slowest rank. This quantity is used for measuring the throughput of
+     * a rank for mesh rebalancing:
+     */
+    const auto hyperbolic_compute_time = [&]() {
+      double time = 0.;
+      for (const auto &[name, timer] : computing_timer_) {
+        if (name.rfind("time step [H]", 0) == 0 &&
+            name.find("synchronization barrier") == std::string::npos)
+          time += timer.wall_time();
+      }
+      return time;
+    };
+    double last_compute_time = hyperbolic_compute_time();
+    double last_straggler_compute_time = last_compute_time;
+
     unsigned int cycle = 1;
     Number last_terminal_output = (terminal_update_interval_ == Number(0.)
                                        ? std::numeric_limits<Number>::max()
@@ -290,6 +1049,8 @@ namespace ryujin
 
     /* Loop: */
 
+    print_setup_timers(logfile_);
+
     print_info("entering main loop");
     computing_timer_["time loop"].start();
 
@@ -330,6 +1091,7 @@ namespace ryujin
 
       /* Perform global refinement: */
 
+      bool globally_refined = false;
       const auto new_end = std::remove_if(
           t_refinements_.begin(),
           t_refinements_.end(),
@@ -342,72 +1104,1041 @@ namespace ryujin
 
             print_info("performing global refinement");
 
-            SolutionTransfer<Description, dim, Number> solution_transfer(
-                offline_data_, hyperbolic_system_);
-
-            auto &triangulation = discretization_.triangulation();
-            for (auto &cell : triangulation.active_cell_iterators())
-              cell->set_refine_flag();
-            triangulation.prepare_coarsening_and_refinement();
-
-            solution_transfer.prepare_for_interpolation(U);
-
-            triangulation.execute_coarsening_and_refinement();
-            prepare_compute_kernels();
-
-            solution_transfer.interpolate(U);
+            refine_mesh([](auto &triangulation) {
+              for (auto &cell : triangulation.active_cell_iterators())
+                cell->set_refine_flag();
+            });
+            globally_refined = true;
 
             computing_timer_["time loop"].start();
             return true;
           });
       t_refinements_.erase(new_end, t_refinements_.end());
 
+      /*
+       * Perform adaptive refinement. We need indicator values from at
+       * least one time step on the current mesh, thus skip the first
+       * cycle and cycles with a global refinement:
+       */
+
+      if (adaptive_refinement_interval_ != 0 && cycle > 1 &&
+          !globally_refined && cycle % adaptive_refinement_interval_ == 0 &&
+          t < t_final_) {
+        computing_timer_["time loop"].stop();
+        Scope scope(computing_timer_, "(re)initialize data structures");
+
+        refine_mesh([&](auto & /*triangulation*/) {
+          mark_cells_for_adaptive_refinement();
+        });
+
+        computing_timer_["time loop"].start();
+      }
+
+      /* Detect ranks that are persistently slower than the median: */
+
+      if (straggler_interval_ != 0 && cycle % straggler_interval_ == 0) {
+        const double compute_time =
+            hyperbolic_compute_time() - last_straggler_compute_time;
+        detect_stragglers(compute_time / straggler_interval_);
+        last_straggler_compute_time = hyperbolic_compute_time();
+      }
+
+      /*
+       * Repartition the mesh with cell weights scaled by the measured
+       * throughput of every rank (in locally owned degrees of freedom per
+       * second of compute time):
+       */
+
+      if (rebalancing_interval_ != 0 && cycle > 1 &&
+          cycle % rebalancing_interval_ == 0 && t < t_final_) {
+        computing_timer_["time loop"].stop();
+
+        const double compute_time =
+            std::max(hyperbolic_compute_time() - last_compute_time, 1.e-12);
+        const auto statistics =
+            Utilities::MPI::min_max_avg(compute_time, mpi_communicator_);
+        const double imbalance = statistics.max / statistics.avg - 1.;
+
+        if (imbalance > rebalancing_threshold_) {
+          Scope scope(computing_timer_, "(re)initialize data structures");
+
+          std::ostringstream message;
+          message << "rebalancing mesh (load imbalance " << std::fixed
+                  << std::setprecision(1) << 100. * imbalance << "%)";
+          print_info(message.str());
+
+          const double n_owned =
+              std::max(offline_data_.n_locally_owned(), 1u);
+          discretization_.rank_speed(n_owned / compute_time);
+          if (rebalancing_indicator_weight_ != 0.)
+            discretization_.cell_cost(compute_cell_cost());
+
+          refine_mesh([](auto & /*triangulation*/) {});
+          discretization_.cell_cost({});
+        }
+
+        last_compute_time = hyperbolic_compute_time();
+        computing_timer_["time loop"].start();
+      }
+
       /* Break if we have reached the final time: */
 
       if (t >= t_final_)
         break;
 
-      /* Do a time step: */
+      /* Do a time step: */
+
+      const auto tau = time_integrator_.step(U, t);
+      t += tau;
+
+      advance_ensemble(t);
+
+      /* Write a final checkpoint before we run out of walltime: */
+
+      if (enable_checkpointing_ && final_checkpoint_due(cycle)) {
+        print_info("walltime limit or termination signal: writing final "
+                   "checkpoint and stopping");
+        write_checkpoint(U, t, output_cycle);
+        /* Account for the cycle that we just performed: */
+        ++cycle;
+        break;
+      }
+
+      if (telemetry_interval_ != 0 && cycle % telemetry_interval_ == 0)
+        write_telemetry(cycle, t, tau);
+
+      /* Print and record cycle statistics: */
+
+      const bool write_to_log_file = (t >= output_cycle * output_granularity_);
+      const auto wall_time = computing_timer_["time loop"].wall_time();
+      const auto data =
+          Utilities::MPI::min_max_avg(wall_time, mpi_communicator_);
+      const bool update_terminal =
+          (data.avg >= last_terminal_output + terminal_update_interval_);
+      if (terminal_update_interval_ != Number(0.)) {
+        if (write_to_log_file || update_terminal) {
+          print_cycle_statistics(
+              cycle, t, output_cycle, /*logfile*/ write_to_log_file);
+          last_terminal_output = data.avg;
+        }
+      }
+    } /* end of loop */
+
+    /* We have actually performed one cycle less. */
+    --cycle;
+
+    /* Make sure that the last vtu output and checkpoint are written out: */
+    vtu_output_.wait();
+    checkpoint_writer_.finish();
+    hyperbolic_module_.write_trace(base_name_ + "-trace");
+
+    computing_timer_["time loop"].stop();
+
+    if (terminal_update_interval_ != Number(0.)) {
+      /* Write final timing statistics to screen and logfile: */
+      print_cycle_statistics(
+          cycle, t, output_cycle, /*logfile*/ true, /*final*/ true);
+    }
+
+    if (enable_compute_error_) {
+      /* Output final error: */
+      compute_error(U, t);
+    }
+
+    EnergyCounters::set_active(nullptr);
+    SetupScope::set_active(nullptr);
+
+#ifdef WITH_VALGRIND
+    CALLGRIND_DUMP_STATS;
+#endif
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::run_benchmark()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::run_benchmark()" << std::endl;
+#endif
+
+    AssertThrow(benchmark_cycles_ > 0,
+                ExcMessage("The number of benchmark cycles must be positive"));
+
+    std::vector<unsigned int> refinements = benchmark_refinements_;
+    if (refinements.empty())
+      refinements.push_back(discretization_.refinement());
+    const auto n_levels = refinements.size();
+
+    /* Summary table with one column per refinement level: */
+    const std::vector<std::pair<std::string, unsigned int>> rows{
+        {"refinement", 0},
+        {"Qdofs", 0},
+        {"wall time per cycle [s]", 5},
+        {"throughput [MQdofs/s]", 4},
+        {"average tau", 8}};
+    std::vector<std::vector<double>> values(rows.size(),
+                                            std::vector<double>(n_levels));
+    std::map<std::string, std::vector<double>> step_times;
+
+    /*
+     * Per step metrics of every level for the machine-readable summary:
+     * ns per dof and cycle, achieved bandwidth in GB/s (only with the
+     * "traffic model" option of the HyperbolicModule), and GFLOP/s (only
+     * with floating point events of the "hardware counters" option):
+     */
+    std::map<std::string, std::vector<std::array<double, 3>>> step_metrics;
+
+    for (unsigned int level = 0; level < n_levels; ++level) {
+      print_info("benchmark: refinement level " +
+                 std::to_string(refinements[level]));
+
+      computing_timer_.clear();
+
+      discretization_.refinement() = refinements[level];
+      discretization_.prepare();
+      offline_data_.prepare(problem_dimension);
+      hyperbolic_module_.prepare();
+      parabolic_module_.prepare();
+      time_integrator_.prepare();
+
+      vector_type U;
+      U.reinit(offline_data_.vector_partitioner());
+      U = initial_values_.interpolate();
+
+      print_info("benchmark: performing " + std::to_string(benchmark_cycles_) +
+                 " cycles");
+
+      hyperbolic_module_.reset_data_traffic();
+      hyperbolic_module_.reset_hardware_counters();
+
+      Number t = 0.;
+      computing_timer_["time loop"].start();
+      for (unsigned int cycle = 0; cycle < benchmark_cycles_; ++cycle)
+        t += time_integrator_.step(U, t);
+      computing_timer_["time loop"].stop();
+
+      const auto n_dofs =
+          static_cast<double>(offline_data_.dof_handler().n_dofs());
+      const double wall_time = Utilities::MPI::max(
+          computing_timer_["time loop"].wall_time(), mpi_communicator_);
+
+      values[0][level] = refinements[level];
+      values[1][level] = n_dofs;
+      values[2][level] = wall_time / benchmark_cycles_;
+      values[3][level] = benchmark_cycles_ * n_dofs / 1.e6 / wall_time *
+                         time_integrator_.efficiency();
+      values[4][level] = t / benchmark_cycles_;
+
+      /*
+       * Collect the wall time, the data traffic and the floating point
+       * operations of all steps into a single buffer that is reduced
+       * with one collective operation:
+       */
+      const auto &data_traffic = hyperbolic_module_.data_traffic();
+      const auto flops = hyperbolic_module_.floating_point_operations();
+
+      std::vector<std::string> names;
+      std::vector<double> step_values;
+      for (auto &[name, timer] : computing_timer_) {
+        if (name.find("time step") != 0)
+          continue;
+        const auto key = name.substr(0, name.find(" - "));
+        const auto bytes = data_traffic.find(key);
+        const auto operations = flops.find(key);
+        names.push_back(name);
+        step_values.push_back(timer.wall_time());
+        step_values.push_back(bytes == data_traffic.end() ? 0.
+                                                          : bytes->second);
+        step_values.push_back(operations == flops.end() ? 0.
+                                                        : operations->second);
+      }
+
+      const auto statistics =
+          Utilities::MPI::min_max_avg(step_values, mpi_communicator_);
+
+      const auto ratio = [](const double a, const double b) {
+        return b > 0. ? a / b : 0.;
+      };
+
+      for (unsigned int k = 0; k < names.size(); ++k) {
+        const auto &wall_time = statistics[3 * k];
+        auto &times = step_times[names[k]];
+        times.resize(n_levels, 0.);
+        times[level] = wall_time.avg / benchmark_cycles_;
+
+        auto &metrics = step_metrics[names[k]];
+        metrics.resize(n_levels, {0., 0., 0.});
+        metrics[level] = {
+            1.e9 * times[level] / n_dofs,
+            ratio(statistics[3 * k + 1].sum, wall_time.max) / 1.e9,
+            ratio(statistics[3 * k + 2].sum, wall_time.max) / 1.e9};
+      }
+    }
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::size_t width = 0;
+    for (const auto &row : rows)
+      width = std::max(width, row.first.size());
+    for (const auto &[name, times] : step_times)
+      width = std::max(width, name.size());
+
+    std::ostringstream output;
+    output << "Benchmark summary: " << n_mpi_processes_ << " ranks / "
+#ifdef WITH_OPENMP
+           << MultithreadInfo::n_threads() << " threads, "
+#else
+           << "[openmp disabled], "
+#endif
+           << benchmark_cycles_ << " cycles per level\n\n";
+
+    for (unsigned int i = 0; i < rows.size(); ++i) {
+      output << "  " << std::left << std::setw(width) << rows[i].first
+             << std::right << std::fixed
+             << std::setprecision(rows[i].second);
+      for (const auto value : values[i])
+        output << " " << std::setw(14) << value;
+      output << "\n";
+    }
+
+    output << "\n  Wall time per cycle [s] of all steps:\n";
+    for (const auto &[name, times] : step_times) {
+      output << "  " << std::left << std::setw(width) << name << std::right
+             << std::fixed << std::setprecision(5);
+      for (const auto value : times)
+        output << " " << std::setw(14) << value;
+      output << "\n";
+    }
+
+    print_head("benchmark", "summary", std::cout);
+    std::cout << output.str() << std::flush;
+
+    std::ofstream file(base_name_ + "-benchmark.dat");
+    file << output.str() << std::flush;
+
+    /*
+     * Machine-readable summary. Metrics that are not available are
+     * reported as null:
+     */
+
+    const auto metric = [](const double value) {
+      std::ostringstream stream;
+      stream << std::setprecision(6) << std::scientific;
+      if (value > 0.)
+        stream << value;
+      else
+        stream << "null";
+      return stream.str();
+    };
+
+#ifdef WITH_OPENMP
+    const unsigned int n_threads = MultithreadInfo::n_threads();
+#else
+    const unsigned int n_threads = 1;
+#endif
+
+    std::ofstream json(base_name_ + "-benchmark.json");
+    json << std::setprecision(6) << std::scientific;
+    json << "{\"problem\": \"" << hyperbolic_system_.problem_name
+         << "\", \"dimension\": " << dim << ", \"ranks\": " << n_mpi_processes_
+         << ", \"threads\": " << n_threads
+         << ", \"cycles\": " << benchmark_cycles_ << ", \"levels\": [";
+    for (unsigned int level = 0; level < n_levels; ++level) {
+      json << (level == 0 ? "" : ", ") << "{\"refinement\": "
+           << refinements[level]
+           << ", \"dofs\": " << static_cast<std::size_t>(values[1][level])
+           << ", \"wall_time_per_cycle\": " << values[2][level]
+           << ", \"mqdofs_per_second\": " << values[3][level]
+           << ", \"ns_per_dof\": "
+           << 1.e9 * values[2][level] / values[1][level] << ", \"steps\": {";
+      bool first = true;
+      for (const auto &[name, metrics] : step_metrics) {
+        const auto &[ns_per_dof, bandwidth, gflops] = metrics[level];
+        json << (first ? "" : ", ") << "\"" << name
+             << "\": {\"ns_per_dof\": " << metric(ns_per_dof)
+             << ", \"bandwidth_gb_per_second\": " << metric(bandwidth)
+             << ", \"gflop_per_second\": " << metric(gflops) << "}";
+        first = false;
+      }
+      json << "}}";
+    }
+    json << "]}" << std::endl;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::run_replay()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::run_replay()" << std::endl;
+#endif
+
+    AssertThrow(replay_cycles_ > 0,
+                ExcMessage("The number of replay cycles must be positive"));
+    AssertThrow(replay_target_ == "hyperbolic module" ||
+                    replay_target_ == "time integrator",
+                ExcMessage("Invalid \"replay target\" »" + replay_target_ +
+                           "«. Expected \"hyperbolic module\" or \"time "
+                           "integrator\"."));
+    const bool hyperbolic_only = replay_target_ == "hyperbolic module";
+
+    const std::string name =
+        replay_checkpoint_.empty() ? base_name_ : replay_checkpoint_;
+
+    print_info("replay: recreating mesh of »" + name + "«");
+    Checkpointing::load_mesh(discretization_, name);
+
+    print_info("replay: preparing compute kernels");
+    offline_data_.prepare(problem_dimension);
+    hyperbolic_module_.prepare();
+    parabolic_module_.prepare();
+    time_integrator_.prepare();
+
+    print_info("replay: loading state vector");
+    vector_type U;
+    U.reinit(offline_data_.vector_partitioner());
+    Number t = 0.;
+    unsigned int output_cycle = 0;
+    Checkpointing::load_state_vector(
+        offline_data_, name, U, t, output_cycle, mpi_communicator_);
+    U.update_ghost_values();
+
+    vector_type new_U;
+    new_U.reinit(offline_data_.vector_partitioner());
+    precomputed_type precomputed;
+    precomputed.reinit_with_scalar_partitioner(
+        offline_data_.scalar_partitioner());
+
+    /*
+     * Every cycle starts from the loaded state U so that all cycles
+     * operate on identical data:
+     */
+    Number tau = replay_tau_;
+    const auto replay_cycle = [&]() {
+      if (hyperbolic_only) {
+        computing_timer_["time loop"].start();
+        const auto tau_max = hyperbolic_module_.template step<0>(
+            U, {}, {}, {}, new_U, precomputed, tau);
+        computing_timer_["time loop"].stop();
+        if (tau == Number(0.))
+          tau = tau_max;
+      } else {
+        new_U = U;
+        computing_timer_["time loop"].start();
+        tau = time_integrator_.step(new_U, t);
+        computing_timer_["time loop"].stop();
+      }
+    };
+
+    print_info("replay: performing warm-up cycle");
+    replay_cycle();
+
+    print_info("replay: performing " + std::to_string(replay_cycles_) +
+               " cycles");
+
+    computing_timer_.clear();
+    hyperbolic_module_.reset_data_traffic();
+
+    if (replay_instrumentation_) {
+      CALLGRIND_START_INSTRUMENTATION;
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_START("replay");
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    for (unsigned int cycle = 0; cycle < replay_cycles_; ++cycle)
+      replay_cycle();
+
+    if (replay_instrumentation_) {
+      RYUJIN_PARALLEL_REGION_BEGIN
+      LIKWID_MARKER_STOP("replay");
+      RYUJIN_PARALLEL_REGION_END
+      CALLGRIND_STOP_INSTRUMENTATION;
+    }
+
+    const auto n_dofs =
+        static_cast<double>(offline_data_.dof_handler().n_dofs());
+    const double wall_time = Utilities::MPI::max(
+        computing_timer_["time loop"].wall_time(), mpi_communicator_);
+    const double efficiency =
+        hyperbolic_only ? 1. : time_integrator_.efficiency();
+
+    std::ostringstream output;
+    print_timers(output);
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::ostringstream summary;
+    summary << "Replay summary: " << n_mpi_processes_ << " ranks / "
+#ifdef WITH_OPENMP
+            << MultithreadInfo::n_threads() << " threads, "
+#else
+            << "[openmp disabled], "
+#endif
+            << replay_cycles_ << " cycles of the " << replay_target_
+            << " on »" << name << "« at t = " << t << "\n\n"
+            << std::scientific << std::setprecision(4)
+            << "  Qdofs:                   " << n_dofs << "\n"
+            << "  tau:                     " << tau << "\n"
+            << std::fixed << std::setprecision(5)
+            << "  wall time per cycle [s]: " << wall_time / replay_cycles_
+            << "\n"
+            << std::setprecision(4) << "  throughput [MQdofs/s]:   "
+            << replay_cycles_ * n_dofs / 1.e6 / wall_time * efficiency
+            << "\n"
+            << output.str();
+
+    print_head("replay", "summary", std::cout);
+    std::cout << summary.str() << std::flush;
+
+    std::ofstream file(base_name_ + "-replay.dat");
+    file << summary.str() << std::flush;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::run_autotune()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::run_autotune()" << std::endl;
+#endif
+
+    AssertThrow(autotune_cycles_ > 0,
+                ExcMessage("The number of autotune cycles must be positive"));
+
+    /*
+     * Parse the list of knobs. Every knob is described by the
+     * subsection path, the name of the parameter and a list of candidate
+     * values:
+     */
+
+    struct Knob {
+      std::vector<std::string> path;
+      std::string name;
+      std::vector<std::string> candidates;
+    };
+
+    std::vector<Knob> knobs;
+    for (const auto &entry :
+         Utilities::split_string_list(autotune_parameters_, ';')) {
+      const auto colon = entry.find(':');
+      AssertThrow(colon != std::string::npos,
+                  ExcMessage("Invalid entry »" + entry +
+                             "« in \"autotune parameters\". Expected "
+                             "\"<subsection>/<parameter>: <values>\"."));
+
+      Knob knob;
+      knob.path = Utilities::split_string_list(entry.substr(0, colon), '/');
+      knob.path.erase(std::remove(knob.path.begin(), knob.path.end(), ""),
+                      knob.path.end());
+      AssertThrow(!knob.path.empty(),
+                  ExcMessage("Invalid entry »" + entry +
+                             "« in \"autotune parameters\": missing "
+                             "parameter name."));
+      knob.name = knob.path.back();
+      knob.path.pop_back();
+      knob.candidates =
+          Utilities::split_string_list(entry.substr(colon + 1), '|');
+      AssertThrow(!knob.candidates.empty(),
+                  ExcMessage("Invalid entry »" + entry +
+                             "« in \"autotune parameters\": no candidate "
+                             "values given."));
+      knobs.push_back(std::move(knob));
+    }
+
+    AssertThrow(!knobs.empty(),
+                ExcMessage("No parameters to tune given in \"autotune "
+                           "parameters\""));
+
+    const auto is_threads = [](const Knob &knob) {
+      return knob.path.empty() && knob.name == "threads";
+    };
+
+    auto &prm = ParameterAcceptor::prm;
+
+    const auto get_value = [&](const Knob &knob) -> std::string {
+      if (is_threads(knob)) {
+#ifdef WITH_OPENMP
+        return std::to_string(MultithreadInfo::n_threads());
+#else
+        return "1";
+#endif
+      }
+      for (const auto &it : knob.path)
+        prm.enter_subsection(it);
+      const auto value = prm.get(knob.name);
+      for (unsigned int i = 0; i < knob.path.size(); ++i)
+        prm.leave_subsection();
+      return value;
+    };
+
+    /* Setting a parameter runs the action attached by add_parameter(): */
+    const auto set_value = [&](const Knob &knob, const std::string &value) {
+      if (is_threads(knob)) {
+        const auto n_threads = Utilities::string_to_int(value);
+        AssertThrow(n_threads > 0,
+                    ExcMessage("The number of threads must be positive"));
+#ifdef WITH_OPENMP
+        omp_set_num_threads(n_threads);
+        MultithreadInfo::set_thread_limit(n_threads);
+#endif
+        return;
+      }
+      for (const auto &it : knob.path)
+        prm.enter_subsection(it);
+      prm.set(knob.name, value);
+      for (unsigned int i = 0; i < knob.path.size(); ++i)
+        prm.leave_subsection();
+    };
+
+    /*
+     * Set up the mesh and offline data once:
+     */
+
+    print_info("autotune: setting up offline data");
+
+    discretization_.prepare();
+    offline_data_.prepare(problem_dimension);
+
+    const auto n_dofs =
+        static_cast<double>(offline_data_.dof_handler().n_dofs());
+
+    struct Trial {
+      std::string description;
+      double throughput;
+      double simulated_time_rate;
+      double restart_rate;
+      bool accepted;
+    };
+
+    std::vector<Trial> trials;
+
+    /*
+     * Run a trial with the current parameters and return the simulated
+     * time advanced per wall-clock second, or a negative value if the
+     * restart rate is too high:
+     */
+
+    const auto run_trial = [&](const std::string &description) {
+      print_info("autotune: trial " + std::to_string(trials.size()) + " (" +
+                 description + ")");
+
+      computing_timer_.clear();
+
+      hyperbolic_module_.prepare();
+      parabolic_module_.prepare();
+      time_integrator_.prepare();
+
+      vector_type U;
+      U.reinit(offline_data_.vector_partitioner());
+      U = initial_values_.interpolate();
+
+      /* One warm-up cycle to exclude first touch and setup costs: */
+      Number t = time_integrator_.step(U, Number(0.));
+
+      const auto restarts_before =
+          hyperbolic_module_.n_restarts() + parabolic_module_.n_restarts();
+      const Number t_before = t;
+
+      computing_timer_["time loop"].start();
+      for (unsigned int cycle = 0; cycle < autotune_cycles_; ++cycle)
+        t += time_integrator_.step(U, t);
+      computing_timer_["time loop"].stop();
+
+      const double wall_time = Utilities::MPI::max(
+          computing_timer_["time loop"].wall_time(), mpi_communicator_);
+
+      const auto restarts =
+          hyperbolic_module_.n_restarts() + parabolic_module_.n_restarts() -
+          restarts_before;
+
+      Trial trial;
+      trial.description = description;
+      trial.throughput = autotune_cycles_ * n_dofs / 1.e6 / wall_time *
+                         time_integrator_.efficiency();
+      trial.simulated_time_rate = double(t - t_before) / wall_time;
+      trial.restart_rate = double(restarts) / autotune_cycles_;
+      trial.accepted = trial.restart_rate <= autotune_maximal_restart_rate_;
+      trials.push_back(trial);
+
+      return trial.accepted ? trial.simulated_time_rate : -1.;
+    };
+
+    /*
+     * Coordinate descent over all knobs:
+     */
+
+    std::vector<std::string> best_values;
+    for (const auto &knob : knobs)
+      best_values.push_back(get_value(knob));
+
+    const auto describe = [&](const unsigned int k, const std::string &value) {
+      return (knobs[k].path.empty() ? "" : knobs[k].path.back() + "/") +
+             knobs[k].name + " = " + value;
+    };
+
+    double best_score = run_trial("initial parameters");
+
+    for (unsigned int k = 0; k < knobs.size(); ++k) {
+      for (const auto &candidate : knobs[k].candidates) {
+        if (candidate == best_values[k])
+          continue;
+
+        set_value(knobs[k], candidate);
+        const double score = run_trial(describe(k, candidate));
+        if (score > best_score) {
+          best_score = score;
+          best_values[k] = candidate;
+        }
+      }
+      set_value(knobs[k], best_values[k]);
+    }
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::ostringstream output;
+    output << "Autotune summary: " << n_mpi_processes_ << " ranks / "
+#ifdef WITH_OPENMP
+           << MultithreadInfo::n_threads() << " threads, "
+#else
+           << "[openmp disabled], "
+#endif
+           << autotune_cycles_ << " cycles per trial\n\n";
+
+    std::size_t width = 0;
+    for (const auto &trial : trials)
+      width = std::max(width, trial.description.size());
+
+    output << "  " << std::left << std::setw(width) << "trial" << std::right
+           << " " << std::setw(14) << "[MQdofs/s]" << " " << std::setw(14)
+           << "[t/s]" << " " << std::setw(14) << "[restarts/cycle]\n";
+    for (const auto &trial : trials) {
+      output << "  " << std::left << std::setw(width) << trial.description
+             << std::right << std::fixed << std::setprecision(4) << " "
+             << std::setw(14) << trial.throughput << " "
+             << std::scientific << std::setw(14) << trial.simulated_time_rate
+             << " " << std::fixed << std::setw(14) << trial.restart_rate
+             << (trial.accepted ? "" : "  (rejected)") << "\n";
+    }
+
+    output << "\n  Best parameters:\n";
+    for (unsigned int k = 0; k < knobs.size(); ++k)
+      output << "  " << describe(k, best_values[k]) << "\n";
+
+    print_head("autotune", "summary", std::cout);
+    std::cout << output.str() << std::flush;
+
+    std::ofstream file(base_name_ + "-autotune.prm");
+    std::istringstream lines(output.str());
+    for (std::string line; std::getline(lines, line);)
+      file << "#" << (line.empty() ? "" : " ") << line << "\n";
+    file << "\n";
+    prm.print_parameters(file, ParameterHandler::ShortPRM);
+    file << std::flush;
+  }
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::run_parareal(
+      const MPI_Comm &time_communicator)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::run_parareal()" << std::endl;
+#endif
+
+    const unsigned int slice =
+        Utilities::MPI::this_mpi_process(time_communicator);
+    const unsigned int n_slices =
+        Utilities::MPI::n_mpi_processes(time_communicator);
+
+    AssertThrow(parareal_iterations_ > 0,
+                ExcMessage("The number of parareal iterations must be "
+                           "positive"));
+
+    /* Only the group of the first time slice reports: */
+    const auto info = [&](const std::string &message) {
+      if (slice == 0)
+        print_info("parareal: " + message);
+    };
+
+    /*
+     * Every group of MPI ranks (time slice) sets up the full spatial
+     * discretization with an identical partitioning of the mesh. Thus
+     * the locally owned parts of a state vector of all groups match
+     * rank by rank, which we exploit for exchanging states over the
+     * time communicator:
+     */
+
+    info("setting up " + std::to_string(n_slices) + " time slices");
+
+    discretization_.prepare();
+    offline_data_.prepare(problem_dimension);
+    hyperbolic_module_.prepare();
+    parabolic_module_.prepare();
+    time_integrator_.prepare();
+    coarse_time_integrator_.prepare();
+    postprocessor_.prepare();
+    vtu_output_.prepare();
+
+    vector_type U_initial;
+    U_initial.reinit(offline_data_.vector_partitioner());
+    U_initial = initial_values_.interpolate();
+
+    const unsigned int n_local = U_initial.locally_owned_size();
+    const Number delta_t = t_final_ / n_slices;
+
+    /*
+     * Propagate U from time t to t_end with the given time integrator.
+     * The time-step size of the last step is bounded such that we land
+     * exactly on t_end:
+     */
+    const auto propagate = [&](auto &integrator,
+                               vector_type &U,
+                               Number t,
+                               const Number t_end) {
+      integrator.prepare();
+      const Number tolerance = Number(100.) *
+                               std::numeric_limits<Number>::epsilon() *
+                               std::max(Number(1.), std::abs(t_end));
+      while (t_end - t > tolerance) {
+        hyperbolic_module_.tau_limit((t_end - t) / integrator.efficiency());
+        t += integrator.step(U, t);
+      }
+      hyperbolic_module_.tau_limit(std::numeric_limits<Number>::max());
+    };
+
+    /* Set the locally owned part of dst to a + b - c: */
+    const auto combine = [&](vector_type &dst,
+                             const vector_type &a,
+                             const Number *b,
+                             const vector_type &c) {
+      for (unsigned int i = 0; i < n_local; ++i)
+        dst.local_element(i) =
+            a.local_element(i) + b[i] - c.local_element(i);
+      dst.update_ghost_values();
+    };
+
+    /*
+     * Initial coarse sweep: Every group computes the coarse solution on
+     * all time slices. We keep the coarse predictions G(U_j) for the
+     * correction step and the start state U_j of our own slice:
+     */
+
+    info("initial coarse sweep");
+
+    std::vector<vector_type> coarse(n_slices);
+    vector_type U_start;
+    vector_type U = U_initial;
+
+    for (unsigned int j = 0; j < n_slices; ++j) {
+      if (j == slice)
+        U_start = U;
+      propagate(coarse_time_integrator_, U, j * delta_t, (j + 1) * delta_t);
+      coarse[j] = U;
+    }
+
+    std::vector<Number> fine(std::size_t(n_slices) * n_local);
+    AssertThrow(n_local * sizeof(Number) <=
+                    std::size_t(std::numeric_limits<int>::max()),
+                ExcMessage("State vector too large for the time slice "
+                           "exchange"));
+
+    for (unsigned int k = 0; k < parareal_iterations_; ++k) {
+      Scope scope(computing_timer_, "parareal iteration");
+
+      /* Fine propagation of all time slices in parallel: */
+      vector_type F = U_start;
+      propagate(time_integrator_, F, slice * delta_t, (slice + 1) * delta_t);
+
+      /* Exchange all fine solutions: */
+      const int ierr = MPI_Allgather(F.begin(),
+                                     n_local * sizeof(Number),
+                                     MPI_BYTE,
+                                     fine.data(),
+                                     n_local * sizeof(Number),
+                                     MPI_BYTE,
+                                     time_communicator);
+      AssertThrowMPI(ierr);
+
+      /*
+       * Sequential correction (redundantly on all groups):
+       *   U_{j+1} = G(U_j^new) + F(U_j^old) - G(U_j^old)
+       */
+      Number defect = 0.;
+      U = U_initial;
+      for (unsigned int j = 0; j < n_slices; ++j) {
+        if (j == slice) {
+          for (unsigned int i = 0; i < n_local; ++i)
+            defect = std::max(defect,
+                              std::abs(U.local_element(i) -
+                                       U_start.local_element(i)));
+          U_start = U;
+        }
+
+        vector_type G = U;
+        propagate(coarse_time_integrator_, G, j * delta_t, (j + 1) * delta_t);
+        combine(U, G, fine.data() + std::size_t(j) * n_local, coarse[j]);
+        coarse[j] = std::move(G);
+      }
+
+      /* The defect of all slice start states: */
+      defect = Utilities::MPI::max(defect, mpi_communicator_);
+      defect = Utilities::MPI::max(defect, time_communicator);
+
+      std::ostringstream message;
+      message << "iteration " << k + 1 << ", defect " << std::scientific
+              << std::setprecision(4) << defect;
+      info(message.str());
+
+      if (defect <= parareal_tolerance_)
+        break;
+    }
+
+    /* All groups hold the final state U at t_final_: */
+
+    if (slice == 0) {
+      output(U, base_name_ + "-solution", t_final_, 0);
+      vtu_output_.wait();
+      if (enable_compute_error_)
+        compute_error(U, t_final_);
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  MPI_Comm TimeLoop<Description, dim, Number>::create_reordered_communicator()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::create_reordered_communicator()"
+              << std::endl;
+#endif
+
+    discretization_.prepare();
+    return discretization_.create_reordered_communicator();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::prepare_state(vector_type &U)
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::prepare_state()" << std::endl;
+#endif
+
+    Scope scope(computing_timer_, "(re)initialize data structures");
+
+    discretization_.prepare();
+    offline_data_.prepare(problem_dimension);
+    hyperbolic_module_.prepare();
+    parabolic_module_.prepare();
+    time_integrator_.prepare();
+    postprocessor_.prepare();
+    vtu_output_.prepare();
+
+    U.reinit(offline_data_.vector_partitioner());
+    U = initial_values_.interpolate();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  Number TimeLoop<Description, dim, Number>::step(vector_type &U,
+                                                  const Number t)
+  {
+    Scope scope(computing_timer_, "time loop");
+    return time_integrator_.step(U, t);
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::write_output(
+      const vector_type &U,
+      const std::string &name,
+      const Number t,
+      const unsigned int cycle)
+  {
+    output(U, base_name_ + "-" + name, t, cycle);
+    vtu_output_.wait();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::mark_cells_for_adaptive_refinement()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::mark_cells_for_adaptive_refinement()"
+              << std::endl;
+#endif
+
+    const auto &alpha = hyperbolic_module_.alpha();
+    const auto &scalar_partitioner = offline_data_.scalar_partitioner();
+    const auto &dof_handler = offline_data_.dof_handler();
+
+    const auto [coarsening_threshold, refinement_threshold] =
+        adaptive_refinement_thresholds_;
+    const auto [min_level, max_level] = adaptive_refinement_levels_;
+
+    const unsigned int dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+    std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
+
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
+
+      /*
+       * The indicator values of all degrees of freedom of a locally owned
+       * cell are available (alpha has up-to-date ghost values).
+       */
+      cell->get_dof_indices(dof_indices);
+      Number alpha_max = 0.;
+      for (const auto index : dof_indices)
+        alpha_max = std::max(alpha_max,
+                             alpha.local_element(
+                                 scalar_partitioner->global_to_local(index)));
+
+      const auto level = static_cast<unsigned int>(cell->level());
+      if (alpha_max > refinement_threshold && level < max_level)
+        cell->set_refine_flag();
+      else if (alpha_max < coarsening_threshold && level > min_level)
+        cell->set_coarsen_flag();
+    }
+  }
+
 
-      const auto tau = time_integrator_.step(U, t);
-      t += tau;
+  template <typename Description, int dim, typename Number>
+  std::vector<double> TimeLoop<Description, dim, Number>::compute_cell_cost()
+  {
+#ifdef DEBUG_OUTPUT
+    std::cout << "TimeLoop<dim, Number>::compute_cell_cost()" << std::endl;
+#endif
 
-      /* Print and record cycle statistics: */
+    const auto &alpha = hyperbolic_module_.alpha();
+    const auto &scalar_partitioner = offline_data_.scalar_partitioner();
+    const auto &dof_handler = offline_data_.dof_handler();
 
-      const bool write_to_log_file = (t >= output_cycle * output_granularity_);
-      const auto wall_time = computing_timer_["time loop"].wall_time();
-      const auto data =
-          Utilities::MPI::min_max_avg(wall_time, mpi_communicator_);
-      const bool update_terminal =
-          (data.avg >= last_terminal_output + terminal_update_interval_);
-      if (terminal_update_interval_ != Number(0.)) {
-        if (write_to_log_file || update_terminal) {
-          print_cycle_statistics(
-              cycle, t, output_cycle, /*logfile*/ write_to_log_file);
-          last_terminal_output = data.avg;
-        }
-      }
-    } /* end of loop */
+    const unsigned int dofs_per_cell = dof_handler.get_fe().n_dofs_per_cell();
+    std::vector<dealii::types::global_dof_index> dof_indices(dofs_per_cell);
 
-    /* We have actually performed one cycle less. */
-    --cycle;
+    std::vector<double> cost(
+        discretization_.triangulation().n_active_cells(), 0.);
 
-    computing_timer_["time loop"].stop();
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+      if (!cell->is_locally_owned())
+        continue;
 
-    if (terminal_update_interval_ != Number(0.)) {
-      /* Write final timing statistics to screen and logfile: */
-      print_cycle_statistics(
-          cycle, t, output_cycle, /*logfile*/ true, /*final*/ true);
-    }
+      cell->get_dof_indices(dof_indices);
+      Number alpha_max = 0.;
+      for (const auto index : dof_indices)
+        alpha_max = std::max(alpha_max,
+                             alpha.local_element(
+                                 scalar_partitioner->global_to_local(index)));
 
-    if (enable_compute_error_) {
-      /* Output final error: */
-      compute_error(U, t);
+      cost[cell->active_cell_index()] =
+          rebalancing_indicator_weight_ * std::min(double(alpha_max), 1.);
     }
 
-#ifdef WITH_VALGRIND
-    CALLGRIND_DUMP_STATS;
-#endif
+    return cost;
   }
 
 
@@ -420,21 +2151,9 @@ namespace ryujin
     std::cout << "TimeLoop<dim, Number>::compute_error()" << std::endl;
 #endif
 
-    Vector<Number> difference_per_cell(
-        discretization_.triangulation().n_active_cells());
-
-    Number linf_norm = 0.;
-    Number l1_norm = 0;
-    Number l2_norm = 0;
-
-    const auto analytic = initial_values_.interpolate(t);
-
-    scalar_type analytic_component;
-    scalar_type error_component;
-    analytic_component.reinit(offline_data_.scalar_partitioner());
-    error_component.reinit(offline_data_.scalar_partitioner());
+    /* Translate all selected quantities into component indices: */
 
-    /* Loop over all selected components: */
+    std::vector<unsigned int> components;
     for (const auto &entry : error_quantities_) {
       const auto &names = HyperbolicSystemView::component_names;
       const auto pos = std::find(std::begin(names), std::end(names), entry);
@@ -444,76 +2163,158 @@ namespace ryujin
             dealii::ExcMessage("Unknown component name »" + entry + "«"));
         __builtin_trap();
       }
+      components.push_back(std::distance(std::begin(names), pos));
+    }
+    const unsigned int n_components = components.size();
+
+    const auto analytic = initial_values_.interpolate(t);
+
+    /*
+     * Constrained degrees of freedom due to periodicity are not updated
+     * by the time stepping. Instead of distributing the constraints into
+     * a temporary copy of U we resolve them on the fly (in local
+     * numbering):
+     */
+
+    const auto &scalar_partitioner = *offline_data_.scalar_partitioner();
+    AffineConstraints<Number> affine_constraints;
+    affine_constraints.copy_from(offline_data_.affine_constraints());
+    transform_to_local_range(scalar_partitioner, affine_constraints);
+
+    const auto get_state = [&](const unsigned int i) {
+      auto U_i = U.get_tensor(i);
+      if (!affine_constraints.is_constrained(i))
+        return U_i;
+
+      const Number inhomogeneity = affine_constraints.get_inhomogeneity(i);
+      for (unsigned int c = 0; c < problem_dimension; ++c)
+        U_i[c] = inhomogeneity;
+      for (const auto &[j, weight] :
+           *affine_constraints.get_constraint_entries(i))
+        U_i += Number(weight) * U.get_tensor(j);
+      return U_i;
+    };
 
-      const auto index = std::distance(std::begin(names), pos);
+    /*
+     * Compute the Linf, L1, and L2 norms of the error and of the
+     * (interpolated) analytic solution for all selected components in a
+     * single, parallel pass over all locally owned degrees of freedom
+     * and cells. The norms are stored in the order: error and analytic
+     * Linf, error and analytic L1, error and analytic L2 (squared).
+     */
 
-      analytic.extract_component(analytic_component, index);
+    const auto &dof_handler = offline_data_.dof_handler();
+    const unsigned int n_owned = offline_data_.n_locally_owned();
 
-      /* Compute norms of analytic solution: */
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        cells.push_back(cell);
 
-      Number linf_norm_analytic = 0.;
-      Number l1_norm_analytic = 0.;
-      Number l2_norm_analytic = 0.;
+    std::vector<double> norms(6 * n_components, 0.);
 
-      if (error_normalize_) {
-        linf_norm_analytic = Utilities::MPI::max(
-            analytic_component.linfty_norm(), mpi_communicator_);
-
-        VectorTools::integrate_difference(
-            offline_data_.dof_handler(),
-            analytic_component,
-            Functions::ZeroFunction<dim, Number>(),
-            difference_per_cell,
-            QGauss<dim>(3),
-            VectorTools::L1_norm);
-
-        l1_norm_analytic = Utilities::MPI::sum(difference_per_cell.l1_norm(),
-                                               mpi_communicator_);
-
-        VectorTools::integrate_difference(
-            offline_data_.dof_handler(),
-            analytic_component,
-            Functions::ZeroFunction<dim, Number>(),
-            difference_per_cell,
-            QGauss<dim>(3),
-            VectorTools::L2_norm);
-
-        l2_norm_analytic = Number(std::sqrt(Utilities::MPI::sum(
-            std::pow(difference_per_cell.l2_norm(), 2), mpi_communicator_)));
+    RYUJIN_PARALLEL_REGION_BEGIN
+
+    std::vector<double> thread_norms(6 * n_components, 0.);
+
+    RYUJIN_OMP_FOR_NOWAIT
+    for (unsigned int i = 0; i < n_owned; ++i) {
+      const auto U_i = get_state(i);
+      const auto analytic_i = analytic.get_tensor(i);
+      for (unsigned int k = 0; k < n_components; ++k) {
+        const auto c = components[k];
+        const double error = std::abs(U_i[c] - analytic_i[c]);
+        const double value = std::abs(analytic_i[c]);
+        thread_norms[k] = std::max(thread_norms[k], error);
+        thread_norms[n_components + k] =
+            std::max(thread_norms[n_components + k], value);
       }
+    }
 
-      /* Compute norms of error: */
+    const auto &finite_element = discretization_.finite_element();
+    const unsigned int dofs_per_cell = finite_element.n_dofs_per_cell();
+
+    FEValues<dim> fe_values(discretization_.mapping(),
+                            finite_element,
+                            QGauss<dim>(3),
+                            update_values | update_JxW_values);
+    const unsigned int n_q_points = fe_values.n_quadrature_points;
+
+    std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+    std::vector<double> error_values(dofs_per_cell * n_components);
+    std::vector<double> analytic_values(dofs_per_cell * n_components);
+
+    RYUJIN_OMP_FOR
+    for (unsigned int n = 0; n < cells.size(); ++n) {
+      const auto &cell = cells[n];
+      fe_values.reinit(cell);
+
+      cell->get_dof_indices(dof_indices);
+      transform_to_local_range(scalar_partitioner, dof_indices);
+
+      for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+        const auto U_j = get_state(dof_indices[j]);
+        const auto analytic_j = analytic.get_tensor(dof_indices[j]);
+        for (unsigned int k = 0; k < n_components; ++k) {
+          const auto c = components[k];
+          error_values[j * n_components + k] = U_j[c] - analytic_j[c];
+          analytic_values[j * n_components + k] = analytic_j[c];
+        }
+      }
 
-      U.extract_component(error_component, index);
-      /* Populate constrained dofs due to periodicity: */
-      offline_data_.affine_constraints().distribute(error_component);
-      error_component.update_ghost_values();
-      error_component -= analytic_component;
+      for (unsigned int q = 0; q < n_q_points; ++q) {
+        const auto JxW = fe_values.JxW(q);
+        for (unsigned int k = 0; k < n_components; ++k) {
+          double error = 0.;
+          double value = 0.;
+          for (unsigned int j = 0; j < dofs_per_cell; ++j) {
+            const auto phi = fe_values.shape_value(j, q);
+            error += phi * error_values[j * n_components + k];
+            value += phi * analytic_values[j * n_components + k];
+          }
+          thread_norms[2 * n_components + k] += std::abs(error) * JxW;
+          thread_norms[3 * n_components + k] += std::abs(value) * JxW;
+          thread_norms[4 * n_components + k] += error * error * JxW;
+          thread_norms[5 * n_components + k] += value * value * JxW;
+        }
+      }
+    }
 
-      const Number linf_norm_error =
-          Utilities::MPI::max(error_component.linfty_norm(), mpi_communicator_);
+    RYUJIN_OMP_CRITICAL
+    {
+      for (unsigned int k = 0; k < 2 * n_components; ++k)
+        norms[k] = std::max(norms[k], thread_norms[k]);
+      for (unsigned int k = 2 * n_components; k < 6 * n_components; ++k)
+        norms[k] += thread_norms[k];
+    }
 
-      VectorTools::integrate_difference(offline_data_.dof_handler(),
-                                        error_component,
-                                        Functions::ZeroFunction<dim, Number>(),
-                                        difference_per_cell,
-                                        QGauss<dim>(3),
-                                        VectorTools::L1_norm);
+    RYUJIN_PARALLEL_REGION_END
 
-      const Number l1_norm_error =
-          Utilities::MPI::sum(difference_per_cell.l1_norm(), mpi_communicator_);
+    {
+      std::vector<double> maxima(norms.begin(),
+                                 norms.begin() + 2 * n_components);
+      std::vector<double> sums(norms.begin() + 2 * n_components,
+                               norms.end());
+      Utilities::MPI::max(maxima, mpi_communicator_, maxima);
+      Utilities::MPI::sum(sums, mpi_communicator_, sums);
+      std::copy(maxima.begin(), maxima.end(), norms.begin());
+      std::copy(sums.begin(), sums.end(), norms.begin() + 2 * n_components);
+    }
 
-      VectorTools::integrate_difference(offline_data_.dof_handler(),
-                                        error_component,
-                                        Functions::ZeroFunction<dim, Number>(),
-                                        difference_per_cell,
-                                        QGauss<dim>(3),
-                                        VectorTools::L2_norm);
+    Number linf_norm = 0.;
+    Number l1_norm = 0;
+    Number l2_norm = 0;
 
-      const Number l2_norm_error = Number(std::sqrt(Utilities::MPI::sum(
-          std::pow(difference_per_cell.l2_norm(), 2), mpi_communicator_)));
+    for (unsigned int k = 0; k < n_components; ++k) {
+      const Number linf_norm_error = norms[k];
+      const Number l1_norm_error = norms[2 * n_components + k];
+      const Number l2_norm_error = std::sqrt(norms[4 * n_components + k]);
 
       if (error_normalize_) {
+        const Number linf_norm_analytic = norms[n_components + k];
+        const Number l1_norm_analytic = norms[3 * n_components + k];
+        const Number l2_norm_analytic = std::sqrt(norms[5 * n_components + k]);
+
         linf_norm += linf_norm_error / linf_norm_analytic;
         l1_norm += l1_norm_error / l1_norm_analytic;
         l2_norm += l2_norm_error / l2_norm_analytic;
@@ -567,15 +2368,35 @@ namespace ryujin
         (cycle % output_full_multiplier_ == 0) && enable_output_full_;
     const bool do_levelsets =
         (cycle % output_levelsets_multiplier_ == 0) && enable_output_levelsets_;
+    const bool do_preview =
+        (cycle % output_preview_multiplier_ == 0) && enable_output_preview_;
+    const bool do_regions = vtu_output_.regions_of_interest_due(cycle);
+    const bool do_in_situ =
+        (cycle % output_in_situ_multiplier_ == 0) && enable_output_in_situ_;
+    const bool do_grid =
+        (cycle % output_grid_multiplier_ == 0) && enable_output_grid_;
     const bool do_checkpointing =
         (cycle % output_checkpoint_multiplier_ == 0) && enable_checkpointing_;
 
+    /*
+     * Full-field statistics are only accumulated for the solution and
+     * are written out with every checkpoint and at the final time:
+     */
+    const bool do_statistics = enable_compute_quantities_ &&
+                               quantities_.full_field_statistics() &&
+                               name == base_name_ + "-solution" &&
+                               (do_checkpointing || t >= t_final_);
+
+    const bool do_vtu_output =
+        do_full_output || do_levelsets || do_preview || do_regions;
+
     /* There is nothing to do: */
-    if (!(do_full_output || do_levelsets || do_checkpointing))
+    if (!(do_vtu_output || do_in_situ || do_grid || do_checkpointing ||
+          do_statistics))
       return;
 
     /* Data output: */
-    if (do_full_output || do_levelsets) {
+    if (do_vtu_output || do_in_situ || do_statistics) {
       Scope scope(computing_timer_, "time step [X] 3 - output vtu");
       print_info("scheduling output");
 
@@ -588,16 +2409,22 @@ namespace ryujin
       if (cycle == 0)
         postprocessor_.reset_bounds();
 
-      precomputed_type precomputed_values;
+      /*
+       * Borrow a temporary from the (idle) time integrator:
+       */
+      const auto &scalar_partitioner = offline_data_.scalar_partitioner();
+      auto precomputed_pointer = time_integrator_.precomputed_pool().acquire(
+          scalar_partitioner, [&](precomputed_type &vector) {
+            if (vtu_output_.need_to_prepare_step())
+              vector.reinit_with_scalar_partitioner(scalar_partitioner);
+          });
+      auto &precomputed_values = *precomputed_pointer;
 
       if (vtu_output_.need_to_prepare_step()) {
         /*
          * In case we output a precomputed value or alpha we have to run
          * Steps 0 - 2 of the explicit Euler step:
          */
-        const auto &scalar_partitioner = offline_data_.scalar_partitioner();
-        precomputed_values.reinit_with_scalar_partitioner(scalar_partitioner);
-
         vector_type dummy;
         hyperbolic_module_.precompute_only_ = true;
         hyperbolic_module_.template step<0>(
@@ -605,18 +2432,192 @@ namespace ryujin
         hyperbolic_module_.precompute_only_ = false;
       }
 
-      vtu_output_.schedule_output(
-          U, precomputed_values, name, t, cycle, do_full_output, do_levelsets);
+      if (do_vtu_output)
+        vtu_output_.schedule_output(U,
+                                    precomputed_values,
+                                    name,
+                                    t,
+                                    cycle,
+                                    do_full_output,
+                                    do_levelsets,
+                                    do_preview,
+                                    do_regions);
+
+      if (do_statistics) {
+        print_info("scheduling output of full-field statistics");
+        vtu_output_.schedule_output(U,
+                                    precomputed_values,
+                                    base_name_ + "-statistics",
+                                    t,
+                                    cycle,
+                                    /*full*/ true,
+                                    /*levelsets*/ false,
+                                    /*preview*/ false,
+                                    /*regions*/ false,
+                                    quantities_.field_statistics());
+      }
+    }
+
+    /* In-situ visualization: */
+    if (do_in_situ) {
+      Scope scope(computing_timer_, "time step [X] 3 - output in situ");
+      print_info("executing in-situ pipelines");
+
+      /* Use the name without the base name prefix as channel name: */
+      const auto channel = name.substr(base_name_.size() + 1);
+      in_situ_output_.execute(U, channel, t, cycle);
+    }
+
+    /* Resampled output on a uniform grid: */
+    if (do_grid) {
+      Scope scope(computing_timer_, "time step [X] 3 - output grid");
+      print_info("writing resampled grid output");
+      grid_output_.write(U, name, t, cycle);
     }
 
     /* Checkpointing: */
-    if (do_checkpointing) {
-      Scope scope(computing_timer_, "time step [X] 4 - checkpointing");
-      print_info("scheduling checkpointing");
+    if (do_checkpointing)
+      write_checkpoint(U, t, cycle);
+  }
 
-      Checkpointing::write_checkpoint(
+
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::write_checkpoint(
+      const typename TimeLoop<Description, dim, Number>::vector_type &U,
+      Number t,
+      unsigned int cycle)
+  {
+    Scope scope(computing_timer_, "time step [X] 4 - checkpointing");
+    print_info("scheduling checkpointing");
+
+    const auto start = std::chrono::steady_clock::now();
+
+    if (checkpoint_backend_ == "cell ordered")
+      Checkpointing::write_cell_ordered_checkpoint(
           offline_data_, base_name_, U, t, cycle, mpi_communicator_);
+    else
+      Checkpointing::write_checkpoint(
+          offline_data_,
+          base_name_,
+          U,
+          t,
+          cycle,
+          mpi_communicator_,
+          checkpoint_backend_ == "solution transfer" ? nullptr
+                                                     : &checkpoint_writer_);
+
+    /* Assembled offline data only has to be stored once per mesh: */
+    if (checkpoint_offline_data_ && !offline_data_checkpointed_) {
+      offline_data_.write_assembled(base_name_ + "-checkpoint.offline");
+      offline_data_checkpointed_ = true;
+    }
+
+    last_checkpoint_duration_ = std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  bool
+  TimeLoop<Description, dim, Number>::final_checkpoint_due(unsigned int cycle)
+  {
+    const bool have_deadline =
+        walltime_deadline_ != std::chrono::steady_clock::time_point::max();
+    if (!have_deadline && !checkpoint_on_signal_)
+      return false;
+
+    bool due = checkpoint_on_signal_ && checkpoint_signal_received != 0;
+
+    if (have_deadline) {
+      const double remaining =
+          std::chrono::duration<double>(walltime_deadline_ -
+                                        std::chrono::steady_clock::now())
+              .count();
+
+      /*
+       * Predict the cost of the next cycle from the average wall time of
+       * all cycles so far. We reserve time for two cycles to account for
+       * fluctuations (and for an output cycle):
+       */
+      const double cycle_cost =
+          computing_timer_["time loop"].wall_time() / std::max(cycle, 1u);
+
+      due = due || (remaining < walltime_margin_ + 2. * cycle_cost +
+                                    last_checkpoint_duration_);
+    }
+
+    /* Take a collective decision: */
+    return Utilities::MPI::max(due ? 1u : 0u, mpi_communicator_) == 1u;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  std::string TimeLoop<Description, dim, Number>::offline_data_cache_name()
+  {
+    if (offline_data_cache_directory_.empty())
+      return "";
+
+    /*
+     * Randomly distorted meshes cannot be recreated from a stored
+     * refinement history:
+     */
+    if (std::abs(discretization_.mesh_distortion()) > 1.0e-10)
+      return "";
+
+    /*
+     * Collect all run time parameters of the Discretization and
+     * OfflineData subsections (including nested geometry subsections)
+     * from the ShortPRM representation of the parameter handler:
+     */
+
+    const std::set<std::string> sections{
+        discretization_.get_section_path().front(),
+        offline_data_.get_section_path().front()};
+
+    std::stringstream parameters;
+    ParameterAcceptor::prm.print_parameters(parameters,
+                                            ParameterHandler::ShortPRM);
+
+    std::string key_string;
+    std::string line;
+    unsigned int depth = 0;
+    bool recording = false;
+    while (std::getline(parameters, line)) {
+      const auto first = line.find_first_not_of(' ');
+      if (first == std::string::npos)
+        continue;
+      const auto trimmed = line.substr(first);
+
+      if (trimmed.rfind("subsection ", 0) == 0) {
+        if (depth++ == 0)
+          recording = sections.count(trimmed.substr(11)) != 0;
+      } else if (trimmed == "end") {
+        depth--;
+      }
+
+      if (recording)
+        key_string += trimmed + "\n";
     }
+
+    /* Add compile time options and the number of MPI ranks: */
+
+    key_string += OfflineData<dim, Number>::assembled_layout();
+    key_string += "order = " +
+                  std::to_string(Discretization<dim>::order_finite_element) +
+                  " " + std::to_string(Discretization<dim>::order_mapping) +
+                  " " + std::to_string(Discretization<dim>::order_quadrature) +
+                  "\n";
+    key_string += "ranks = " +
+                  std::to_string(Utilities::MPI::n_mpi_processes(
+                      mpi_communicator_)) +
+                  "\n";
+
+    std::stringstream name;
+    name << offline_data_cache_directory_ << "/ryujin-" << std::hex
+         << std::setw(16) << std::setfill('0')
+         << fnv_hash(key_string);
+    return name.str();
   }
 
 
@@ -741,6 +2742,207 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::print_thread_placement(
+      std::ostream &stream)
+  {
+    /*
+     * Gather the placement of all threads of all ranks together with the
+     * host name on rank 0:
+     */
+
+    const auto placement = thread_placement();
+    std::vector<int> local;
+    for (const auto &entry : placement)
+      local.insert(local.end(),
+                   {entry.cpu,
+                    entry.core,
+                    entry.package,
+                    entry.numa_node,
+                    entry.n_allowed_cpus});
+
+    const auto hostnames = Utilities::MPI::gather(
+        mpi_communicator_, Utilities::System::get_hostname(), 0);
+    const auto data = Utilities::MPI::gather(mpi_communicator_, local, 0);
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::ostringstream output;
+    const unsigned int n = dealii::Utilities::needed_digits(n_mpi_processes_);
+
+    /* All (host, cpu) and (host, package, core) tuples in use: */
+    std::map<std::pair<std::string, int>, unsigned int> cpu_count;
+    std::map<std::tuple<std::string, int, int>, std::set<int>> core_cpus;
+    bool unpinned = false;
+
+    output << std::endl << "Thread placement:" << std::endl;
+    for (unsigned int rank = 0; rank < data.size(); ++rank) {
+      const auto &values = data[rank];
+      for (unsigned int k = 0; 5 * k + 4 < values.size(); ++k) {
+        const int cpu = values[5 * k];
+        const int core = values[5 * k + 1];
+        const int package = values[5 * k + 2];
+        const int numa_node = values[5 * k + 3];
+        const int n_allowed = values[5 * k + 4];
+
+        output << "    [p" << std::setw(n) << rank << "] thread "
+               << std::setw(3) << k << "  @ " << hostnames[rank]
+               << "  cpu " << std::setw(4) << cpu << "  core "
+               << std::setw(4) << core << "  socket " << std::setw(2)
+               << package << "  numa " << std::setw(2) << numa_node
+               << (n_allowed == 1
+                       ? "  (pinned)"
+                       : "  (unpinned, " + std::to_string(n_allowed) +
+                             " cpus)")
+               << std::endl;
+
+        if (n_allowed != 1)
+          unpinned = true;
+        if (cpu < 0)
+          continue;
+        cpu_count[{hostnames[rank], cpu}]++;
+        core_cpus[{hostnames[rank], package, core}].insert(cpu);
+      }
+    }
+
+    /* Detect oversubscription and hyperthread sharing: */
+
+    unsigned int n_oversubscribed = 0;
+    for (const auto &it : cpu_count)
+      if (it.second > 1)
+        n_oversubscribed++;
+
+    unsigned int n_shared_cores = 0;
+    for (const auto &it : core_cpus)
+      if (it.second.size() > 1)
+        n_shared_cores++;
+
+    std::vector<std::string> warnings;
+    if (n_oversubscribed > 0)
+      warnings.push_back(
+          std::to_string(n_oversubscribed) +
+          " CPU(s) are running more than one thread (oversubscription)");
+    if (n_shared_cores > 0)
+      warnings.push_back(std::to_string(n_shared_cores) +
+                         " physical core(s) are shared by threads running "
+                         "on different hyperthreads");
+    if (unpinned && (n_oversubscribed > 0 || n_shared_cores > 0))
+      warnings.push_back("threads are not pinned, the placement above is "
+                         "only a snapshot (consider \"pin threads\")");
+
+    for (const auto &warning : warnings) {
+      output << "    Warning: " << warning << std::endl;
+      std::cout << "[INFO] warning: " << warning << std::endl;
+    }
+
+    stream << output.str() << std::endl;
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void
+  TimeLoop<Description, dim, Number>::detect_stragglers(double compute_time)
+  {
+    /*
+     * Normalize by the number of locally owned degrees of freedom so that
+     * a (deliberate or residual) partition imbalance is not mistaken for
+     * a slow node:
+     */
+    const double n_owned = std::max(offline_data_.n_locally_owned(), 1u);
+    const auto times =
+        Utilities::MPI::gather(mpi_communicator_, compute_time / n_owned, 0);
+
+    if (mpi_rank_ != 0)
+      return;
+
+    auto sorted = times;
+    const auto middle = sorted.begin() + sorted.size() / 2;
+    std::nth_element(sorted.begin(), middle, sorted.end());
+    const double median = *middle;
+    if (median <= 0.)
+      return;
+
+    straggler_slow_measurements_.resize(times.size(), 0);
+    const unsigned int n = dealii::Utilities::needed_digits(n_mpi_processes_);
+
+    for (unsigned int rank = 0; rank < times.size(); ++rank) {
+      if (times[rank] <= (1. + straggler_threshold_) * median) {
+        straggler_slow_measurements_[rank] = 0;
+        continue;
+      }
+
+      /* Report a slow rank once when it reaches the required count: */
+      if (++straggler_slow_measurements_[rank] != straggler_count_)
+        continue;
+
+      std::ostringstream message;
+      message << "warning: straggler [p" << std::setw(n) << rank << "] @ "
+              << straggler_hostnames_[rank] << " is " << std::fixed
+              << std::setprecision(1)
+              << 100. * (times[rank] / median - 1.)
+              << "% slower than the median for " << straggler_count_
+              << " consecutive measurements";
+      print_info(message.str());
+      logfile_ << "[INFO] " << message.str() << std::endl;
+    }
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void
+  TimeLoop<Description, dim, Number>::print_setup_timers(std::ostream &stream)
+  {
+    /*
+     * The set of setup timers might differ between ranks (for example, if
+     * only some ranks read a cache). Agree on the union of all names
+     * first:
+     */
+
+    std::vector<std::string> names;
+    for (const auto &it : setup_timer_)
+      names.push_back(it.first);
+    std::set<std::string> all_names;
+    for (const auto &list :
+         Utilities::MPI::all_gather(mpi_communicator_, names))
+      all_names.insert(list.begin(), list.end());
+
+    std::vector<double> values;
+    for (const auto &name : all_names) {
+      const auto it = setup_timer_.find(name);
+      values.push_back(it == setup_timer_.end() ? 0. : it->second.wall_time());
+    }
+
+    const auto statistics =
+        Utilities::MPI::min_max_avg(values, mpi_communicator_);
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::size_t length = 0;
+    for (const auto &name : all_names)
+      length = std::max(length, name.length());
+
+    const unsigned int n = dealii::Utilities::needed_digits(n_mpi_processes_);
+
+    std::ostringstream output;
+    output << std::endl
+           << "Setup timers (wall time: min [rank], avg, max [rank]):";
+    unsigned int k = 0;
+    for (const auto &name : all_names) {
+      const auto &data = statistics[k++];
+      output << std::endl
+             << "  " << std::left << std::setw(length) << name << std::right
+             << std::setprecision(2) << std::fixed << std::setw(9)
+             << data.min << "s [p" << std::setw(n) << data.min_index << "] "
+             << std::setw(9) << data.avg << "s " << std::setw(9) << data.max
+             << "s [p" << std::setw(n) << data.max_index << "]";
+    }
+
+    stream << output.str() << std::endl;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void TimeLoop<Description, dim, Number>::print_memory_statistics(
       std::ostream &stream)
@@ -748,8 +2950,26 @@ namespace ryujin
     Utilities::System::MemoryStats stats;
     Utilities::System::get_memory_stats(stats);
 
-    Utilities::MPI::MinMaxAvg data =
-        Utilities::MPI::min_max_avg(stats.VmRSS / 1024., mpi_communicator_);
+    /*
+     * Collect the memory consumption of all major data structures. The
+     * list of entries is identical on all ranks. All values (including
+     * the resident set size) are reduced with a single collective
+     * operation.
+     */
+
+    std::vector<std::pair<std::string, std::size_t>> statistics;
+    offline_data_.collect_memory_statistics(statistics);
+    hyperbolic_module_.collect_memory_statistics(statistics);
+    parabolic_module_.collect_memory_statistics(statistics);
+    time_integrator_.collect_memory_statistics(statistics);
+    vtu_output_.collect_memory_statistics(statistics);
+
+    std::vector<double> values{stats.VmRSS / 1024.};
+    for (const auto &[name, bytes] : statistics)
+      values.push_back(bytes / 1024. / 1024.);
+
+    const auto reduced = Utilities::MPI::min_max_avg(values, mpi_communicator_);
+    const auto &data = reduced[0];
 
     if (mpi_rank_ != 0)
       return;
@@ -765,6 +2985,21 @@ namespace ryujin
            << std::setw(8) << data.max                        //
            << " [p" << std::setw(n) << data.max_index << "]"; //
 
+    std::size_t width = 0;
+    for (const auto &it : statistics)
+      width = std::max(width, it.first.length());
+
+    output << std::fixed << std::setprecision(1);
+    for (unsigned int i = 0; i < statistics.size(); ++i) {
+      const auto &entry = reduced[i + 1];
+      output << "\n  " << std::left << std::setw(width + 2)
+             << statistics[i].first << std::right << "[MiB]"
+             << std::setw(8) << entry.min << " [p" << std::setw(n)
+             << entry.min_index << "] " << std::setw(8) << entry.avg << " "
+             << std::setw(8) << entry.max << " [p" << std::setw(n)
+             << entry.max_index << "]";
+    }
+
     stream << output.str() << std::endl;
   }
 
@@ -786,10 +3021,28 @@ namespace ryujin
         it << std::string(length - it.str().length() + 1, ' ');
     };
 
-    const auto print_wall_time = [&](auto &timer, auto &stream) {
-      const auto wall_time =
-          Utilities::MPI::min_max_avg(timer.wall_time(), mpi_communicator_);
+    /*
+     * Collect the wall time, the cpu time and the data traffic of all
+     * timers into a single buffer that is reduced with one collective
+     * operation:
+     */
+
+    const auto &data_traffic = hyperbolic_module_.data_traffic();
+
+    std::vector<double> values;
+    values.reserve(3 * computing_timer_.size());
+    for (auto &it : computing_timer_) {
+      const auto key = it.first.substr(0, it.first.find(" - "));
+      const auto pos = data_traffic.find(key);
+      values.push_back(it.second.wall_time());
+      values.push_back(it.second.cpu_time());
+      values.push_back(pos == data_traffic.end() ? 0. : pos->second);
+    }
+
+    const auto statistics =
+        Utilities::MPI::min_max_avg(values, mpi_communicator_);
 
+    const auto print_wall_time = [&](const auto &wall_time, auto &stream) {
       constexpr auto eps = std::numeric_limits<double>::epsilon();
       /*
        * Cut off at 99.9% to avoid silly percentages cluttering up the
@@ -809,15 +3062,18 @@ namespace ryujin
              << wall_time.max_index << "]";
     };
 
-    const auto cpu_time_statistics = Utilities::MPI::min_max_avg(
-        computing_timer_["time loop"].cpu_time(), mpi_communicator_);
-    const double total_cpu_time = cpu_time_statistics.sum;
+    double total_cpu_time = 0.;
+    {
+      unsigned int k = 0;
+      for (auto &it : computing_timer_) {
+        if (it.first == "time loop")
+          total_cpu_time = statistics[3 * k + 1].sum;
+        ++k;
+      }
+    }
 
     const auto print_cpu_time =
-        [&](auto &timer, auto &stream, bool percentage) {
-          const auto cpu_time =
-              Utilities::MPI::min_max_avg(timer.cpu_time(), mpi_communicator_);
-
+        [&](const auto &cpu_time, auto &stream, bool percentage) {
           stream << std::setprecision(2) << std::fixed << std::setw(9)
                  << cpu_time.sum << "s ";
 
@@ -832,14 +3088,42 @@ namespace ryujin
     equalize();
 
     jt = output.begin();
-    for (auto &it : computing_timer_)
-      print_wall_time(it.second, *jt++);
+    for (unsigned int k = 0; k < computing_timer_.size(); ++k)
+      print_wall_time(statistics[3 * k], *jt++);
     equalize();
 
+    /*
+     * Print the achieved bandwidth of all steps for which the
+     * HyperbolicModule provides an estimate of the memory traffic:
+     */
+    if (!data_traffic.empty()) {
+      jt = output.begin();
+      for (unsigned int k = 0; k < computing_timer_.size(); ++k) {
+        const double bytes = statistics[3 * k + 2].sum;
+        const double wall_time = statistics[3 * k].max;
+
+        auto &entry = *jt++;
+        if (bytes == 0. || wall_time == 0.)
+          continue;
+
+        const double bandwidth = bytes / wall_time / 1.e9;
+        entry << "[" << std::setprecision(1) << std::fixed << std::setw(7)
+              << bandwidth << " GB/s";
+        if (terminal_peak_bandwidth_ > 0.)
+          entry << ", " << std::setw(5)
+                << 100. * bandwidth /
+                       (terminal_peak_bandwidth_ * n_mpi_processes_)
+                << "% peak";
+        entry << "]";
+      }
+      equalize();
+    }
+
     jt = output.begin();
     bool compute_percentages = false;
+    unsigned int k = 0;
     for (auto &it : computing_timer_) {
-      print_cpu_time(it.second, *jt++, compute_percentages);
+      print_cpu_time(statistics[3 * k++ + 1], *jt++, compute_percentages);
       if (it.first.find("time loop") == 0)
         compute_percentages = true;
     }
@@ -870,6 +3154,7 @@ namespace ryujin
       double cpu_time_min = 0.;
       double cpu_time_max = 0.;
       double wall_time = 0.;
+      double energy = 0.;
     } previous, current;
 
     static double time_per_second_exp = 0.;
@@ -882,16 +3167,26 @@ namespace ryujin
       current.cycle = cycle;
       current.t = t;
 
-      const auto wall_time_statistics = Utilities::MPI::min_max_avg(
-          computing_timer_["time loop"].wall_time(), mpi_communicator_);
+      /*
+       * Reduce wall and cpu time (and the energy) with a single
+       * collective operation:
+       */
+      const auto &timer = computing_timer_["time loop"];
+      const auto statistics = Utilities::MPI::min_max_avg(
+          std::vector<double>{
+              timer.wall_time(), timer.cpu_time(), energy_counters_.read()},
+          mpi_communicator_);
+
+      const auto &wall_time_statistics = statistics[0];
       current.wall_time = wall_time_statistics.max;
 
-      const auto cpu_time_statistics = Utilities::MPI::min_max_avg(
-          computing_timer_["time loop"].cpu_time(), mpi_communicator_);
+      const auto &cpu_time_statistics = statistics[1];
       current.cpu_time_sum = cpu_time_statistics.sum;
       current.cpu_time_avg = cpu_time_statistics.avg;
       current.cpu_time_min = cpu_time_statistics.min;
       current.cpu_time_max = cpu_time_statistics.max;
+
+      current.energy = statistics[2].sum;
     }
 
     if (final_time)
@@ -963,6 +3258,17 @@ namespace ryujin
            << std::setprecision(2) << std::fixed << cycles_per_second
            << " cycles/s)" << std::endl;
 
+    if (energy_counters_.enabled()) {
+      const double delta_energy = current.energy - previous.energy;
+      output << "  ENER: "
+             << std::setprecision(4) << std::scientific
+             << delta_energy / (delta_cycles * n_dofs * efficiency)
+             << " J/Qdof/substep  ("
+             << std::setprecision(1) << std::fixed
+             << delta_energy / (current.wall_time - previous.wall_time)
+             << " W)" << std::endl;
+    }
+
     const auto &scheme = time_integrator_.time_stepping_scheme();
     output << "        [ "
            << Patterns::Tools::Convert<TimeSteppingScheme>::to_string(scheme)
@@ -978,6 +3284,26 @@ namespace ryujin
            << std::setprecision(0) << std::fixed << parabolic_module_.n_warnings()
            << " warn) ]" << std::endl;
 
+    time_integrator_.print_controller_statistics(output);
+
+    if (terminal_tau_levels_ > 0) {
+      const auto levels =
+          hyperbolic_module_.local_time_step_levels(terminal_tau_levels_);
+      const double total = std::accumulate(levels.begin(), levels.end(), 0.);
+
+      /* Work of an ideal multirate scheme relative to a global tau_min: */
+      double work = 0.;
+      for (unsigned int k = 0; k < levels.size(); ++k)
+        work += levels[k] / std::pow(2., k);
+
+      output << "        [ tau levels:";
+      for (const auto &level : levels)
+        output << " " << std::setprecision(1) << std::fixed
+               << (total > 0. ? 100. * level / total : 0.) << "%";
+      output << " (multirate est. " << std::setprecision(2) << std::fixed
+             << (work > 0. ? total / work : 1.) << "x) ]" << std::endl;
+    }
+
     if constexpr (!ParabolicSystem::is_identity)
       parabolic_module_.print_solver_statistics(output);
 
@@ -1017,6 +3343,125 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void TimeLoop<Description, dim, Number>::write_telemetry(unsigned int cycle,
+                                                           Number t,
+                                                           Number tau)
+  {
+    /*
+     * Note: All ranks have to call this function, only rank 0 writes.
+     */
+
+    const auto format = [](const Utilities::MPI::MinMaxAvg &data) {
+      std::ostringstream output;
+      output << std::setprecision(6) << std::scientific
+             << "{\"min\": " << data.min << ", \"avg\": " << data.avg
+             << ", \"max\": " << data.max << "}";
+      return output.str();
+    };
+
+    TelemetryData current;
+    current.cycle = cycle;
+    current.wall_time = Utilities::MPI::max(
+        computing_timer_["time loop"].wall_time(), mpi_communicator_);
+    current.n_limited_edges = Utilities::MPI::sum(
+        hyperbolic_module_.n_limited_edges(), mpi_communicator_);
+    current.n_edges =
+        Utilities::MPI::sum(hyperbolic_module_.n_edges(), mpi_communicator_);
+
+    /*
+     * Timer deltas and the resident set size, reduced with a single
+     * collective operation:
+     */
+
+    std::vector<double> values;
+    for (auto &[name, timer] : computing_timer_) {
+      const double wall_time = timer.wall_time();
+      current.timer_wall_time[name] = wall_time;
+      const auto it = telemetry_previous_.timer_wall_time.find(name);
+      values.push_back(
+          wall_time -
+          (it != telemetry_previous_.timer_wall_time.end() ? it->second : 0.));
+    }
+
+    values.push_back(energy_counters_.read());
+
+    Utilities::System::MemoryStats stats;
+    Utilities::System::get_memory_stats(stats);
+    values.push_back(stats.VmRSS / 1024.);
+
+    const auto statistics =
+        Utilities::MPI::min_max_avg(values, mpi_communicator_);
+
+    std::ostringstream timers;
+    std::string separator = "";
+    unsigned int k = 0;
+    for (auto &it : computing_timer_) {
+      timers << separator << "\"" << it.first
+             << "\": " << format(statistics[k++]);
+      separator = ", ";
+    }
+    current.energy = statistics[k].sum;
+    const auto memory = format(statistics.back());
+
+    /* Throughput: */
+
+    const double delta_cycles = current.cycle - telemetry_previous_.cycle;
+    const double delta_wall_time =
+        current.wall_time - telemetry_previous_.wall_time;
+    const auto n_dofs =
+        static_cast<double>(offline_data_.dof_handler().n_dofs());
+    const double wall_m_dofs_per_sec =
+        delta_wall_time > 0. ? delta_cycles * n_dofs / 1.e6 / delta_wall_time *
+                                   time_integrator_.efficiency()
+                             : 0.;
+
+    const double delta_energy = current.energy - telemetry_previous_.energy;
+    const double delta_q_dofs =
+        delta_cycles * n_dofs * time_integrator_.efficiency();
+    const double joules_per_q_dof =
+        delta_q_dofs > 0. ? delta_energy / delta_q_dofs : 0.;
+    const double power =
+        delta_wall_time > 0. ? delta_energy / delta_wall_time : 0.;
+
+    const auto delta_edges = current.n_edges - telemetry_previous_.n_edges;
+    const double limited_edges_fraction =
+        delta_edges > 0 ? double(current.n_limited_edges -
+                                 telemetry_previous_.n_limited_edges) /
+                              double(delta_edges)
+                        : 0.;
+
+    std::vector<std::pair<std::string, double>> solver_statistics;
+    hyperbolic_module_.collect_solver_statistics(solver_statistics);
+    parabolic_module_.collect_solver_statistics(solver_statistics);
+
+    telemetry_previous_ = std::move(current);
+
+    if (mpi_rank_ != 0)
+      return;
+
+    std::ostringstream output;
+    output << std::setprecision(6) << std::scientific;
+    output << "{\"cycle\": " << cycle << ", \"t\": " << t
+           << ", \"tau\": " << tau
+           << ", \"wall_mq_per_second\": " << wall_m_dofs_per_sec
+           << ", \"hyperbolic_restarts\": " << hyperbolic_module_.n_restarts()
+           << ", \"hyperbolic_warnings\": " << hyperbolic_module_.n_warnings()
+           << ", \"parabolic_restarts\": " << parabolic_module_.n_restarts()
+           << ", \"parabolic_warnings\": " << parabolic_module_.n_warnings()
+           << ", \"limited_edges_fraction\": " << limited_edges_fraction;
+    if (energy_counters_.enabled())
+      output << ", \"joules_per_qdof_step\": " << joules_per_q_dof
+             << ", \"power_watts\": " << power;
+    for (const auto &[name, value] : solver_statistics)
+      output << ", \"" << name << "\": " << value;
+    output << ", \"memory_mib\": " << memory;
+    output << ", \"timers\": {" << timers.str() << "}}";
+
+    telemetry_file_ << output.str() << std::endl;
+  }
+
+
   template <typename Description, int dim, typename Number>
   void TimeLoop<Description, dim, Number>::print_info(const std::string &header)
   {
@@ -1099,6 +3544,10 @@ namespace ryujin
 
     print_memory_statistics(output);
     print_timers(output);
+    hyperbolic_module_.print_load_imbalance_statistics(output);
+    hyperbolic_module_.print_hardware_counter_statistics(output);
+    energy_counters_.print_statistics(output, mpi_communicator_);
+    hyperbolic_module_.print_solver_statistics(output);
     print_throughput(cycle, t, output, final_time);
 
     if (mpi_rank_ == 0) {
@@ -9,6 +9,8 @@
 #include <deal.II/base/config.h>
 #include <deal.II/grid/manifold.h>
 
+#include <atomic>
+
 namespace ryujin
 {
   using namespace dealii; // FIXME: namespace pollution
@@ -18,6 +20,12 @@ namespace ryujin
    * deal.II. In contrast to the deal.II version it copies the coarse grid
    * and all relevant Manifold information. That way it can be initialized
    * with one Triangulation and be used with another Triangulation.
+   *
+   * Furthermore, the coarse cell of the last successful pull back is
+   * remembered and tried first when computing chart points for a new
+   * set of surrounding points. Consecutive queries (as issued during
+   * refinement and when computing the support points of a higher order
+   * mapping) thus skip the search over all coarse cells.
    */
   template <int dim, int spacedim = dim>
   class TransfiniteInterpolationManifold : public Manifold<dim, spacedim>
@@ -70,6 +78,8 @@ namespace ryujin
 
     std::vector<bool> coarse_cell_is_flat;
 
+    mutable std::atomic<unsigned int> last_coarse_cell;
+
     std::unique_ptr<Manifold<dim, spacedim>> chart_manifold;
   };
 
@@ -25,6 +25,7 @@ namespace ryujin
   TransfiniteInterpolationManifold<dim,
                                    spacedim>::TransfiniteInterpolationManifold()
       : level_coarse(-1)
+      , last_coarse_cell(numbers::invalid_unsigned_int)
   {
     AssertThrow(dim > 1, ExcNotImplemented());
   }
@@ -51,6 +52,8 @@ namespace ryujin
 
     this->chart_manifold = chart_manifold.clone();
 
+    last_coarse_cell = numbers::invalid_unsigned_int;
+
     level_coarse = triangulation.last()->level();
     coarse_cell_is_flat.resize(triangulation.n_cells(level_coarse), false);
     typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -645,9 +648,6 @@ namespace ryujin
            ExcMessage("The chart points array view must be as large as the "
                       "surrounding points array view."));
 
-    std::array<unsigned int, 20> nearby_cells =
-        get_possible_cells_around_points(surrounding_points);
-
     // This function is nearly always called to place new points on a cell or
     // cell face. In this case, the general structure of the surrounding points
     // is known (i.e., if there are eight surrounding points, then they will
@@ -828,23 +828,45 @@ namespace ryujin
           }
         };
 
-    // check whether all points are inside the unit cell of the current chart
+    // check whether all points are inside the unit cell of the given chart
+    const auto all_points_inside_unit_cell =
+        [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+          for (unsigned int i = 0; i < surrounding_points.size(); ++i) {
+            compute_chart_point(cell, i);
+
+            // Tolerance 5e-4 chosen that the method also works with
+            // manifolds that have some discretization error like
+            // SphericalManifold
+            if (GeometryInfo<dim>::is_inside_unit_cell(chart_points[i],
+                                                       5e-4) == false)
+              return false;
+          }
+          return true;
+        };
+
+    // This function is typically called many times in a row for points
+    // located on the same coarse cell (for example, for all new points of
+    // a cell that is refined, or for all support points of a cell of a
+    // higher order mapping). We thus first try the coarse cell of the last
+    // successful inversion, which avoids the (expensive) search over all
+    // coarse cells in get_possible_cells_around_points().
+    const unsigned int hint = last_coarse_cell.load(std::memory_order_relaxed);
+    if (hint != numbers::invalid_unsigned_int) {
+      typename Triangulation<dim, spacedim>::cell_iterator cell(
+          &triangulation, level_coarse, hint);
+      if (all_points_inside_unit_cell(cell))
+        return cell;
+    }
+
+    std::array<unsigned int, 20> nearby_cells =
+        get_possible_cells_around_points(surrounding_points);
+
     for (unsigned int c = 0; c < nearby_cells.size(); ++c) {
+      // (the cell given by the hint has already been tested above)
       typename Triangulation<dim, spacedim>::cell_iterator cell(
           &triangulation, level_coarse, nearby_cells[c]);
-      bool inside_unit_cell = true;
-      for (unsigned int i = 0; i < surrounding_points.size(); ++i) {
-        compute_chart_point(cell, i);
-
-        // Tolerance 5e-4 chosen that the method also works with manifolds
-        // that have some discretization error like SphericalManifold
-        if (GeometryInfo<dim>::is_inside_unit_cell(chart_points[i], 5e-4) ==
-            false) {
-          inside_unit_cell = false;
-          break;
-        }
-      }
-      if (inside_unit_cell == true) {
+      if (nearby_cells[c] != hint && all_points_inside_unit_cell(cell)) {
+        last_coarse_cell.store(nearby_cells[c], std::memory_order_relaxed);
         return cell;
       }
 
@@ -0,0 +1,163 @@
+//
+// SPDX-License-Identifier: MIT
+// Copyright (C) 2020 - 2023 by the ryujin authors
+//
+
+#pragma once
+
+#include <compile_time_options.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/partitioner.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ryujin
+{
+  /**
+   * A small pool of temporary vectors keyed by their MPI partitioner.
+   *
+   * Modules that need scratch vectors only for the duration of a phase
+   * (such as an output cycle or a linear solve) borrow them with
+   * acquire() and automatically return them to the pool when the
+   * returned Pointer goes out of scope. This avoids a reallocation (and
+   * the associated first touch) of the temporary storage in every call.
+   *
+   * The pool holds a reference to every partitioner it has seen, which
+   * guarantees that keys stay unique. Owners of a pool must call clear()
+   * whenever the partitioners change (i.e., in their prepare() function
+   * after a mesh refinement) so that stale storage does not accumulate.
+   *
+   * @note A borrowed vector has unspecified content, in particular it is
+   * not zeroed out. Not thread safe.
+   *
+   * @ingroup Miscellaneous
+   */
+  template <typename VectorType>
+  class VectorPool
+  {
+  public:
+    using partitioner_type = dealii::Utilities::MPI::Partitioner;
+
+    /**
+     * A handle to a borrowed vector. The vector is returned to the pool
+     * on destruction.
+     */
+    class Pointer
+    {
+    public:
+      Pointer(VectorPool *pool,
+              const partitioner_type *key,
+              std::unique_ptr<VectorType> &&vector)
+          : pool_(pool)
+          , key_(key)
+          , vector_(std::move(vector))
+      {
+      }
+
+      Pointer(const Pointer &) = delete;
+      Pointer &operator=(const Pointer &) = delete;
+
+      Pointer(Pointer &&other) = default;
+
+      ~Pointer()
+      {
+        if (vector_)
+          pool_->release(key_, std::move(vector_));
+      }
+
+      VectorType &operator*() const
+      {
+        return *vector_;
+      }
+
+      VectorType *operator->() const
+      {
+        return vector_.get();
+      }
+
+    private:
+      VectorPool *pool_;
+      const partitioner_type *key_;
+      std::unique_ptr<VectorType> vector_;
+    };
+
+    /**
+     * Destructor.
+     */
+    ~VectorPool()
+    {
+      Assert(n_borrowed_ == 0,
+             dealii::ExcMessage("VectorPool destroyed while vectors are "
+                                "still borrowed"));
+    }
+
+    /**
+     * Borrow a vector associated with @p partitioner. If the pool has no
+     * idle vector for the partitioner a new vector is created and
+     * initialized by calling @p initializer with it as argument.
+     */
+    template <typename Initializer>
+    Pointer acquire(const std::shared_ptr<const partitioner_type> &partitioner,
+                    const Initializer &initializer)
+    {
+      auto &[owner, vectors] = pool_[partitioner.get()];
+      if (!owner)
+        owner = partitioner;
+
+      ++n_borrowed_;
+
+      if (!vectors.empty()) {
+        auto vector = std::move(vectors.back());
+        vectors.pop_back();
+        return Pointer(this, partitioner.get(), std::move(vector));
+      }
+
+      auto vector = std::make_unique<VectorType>();
+      initializer(*vector);
+      return Pointer(this, partitioner.get(), std::move(vector));
+    }
+
+    /**
+     * Release all vectors. All borrowed vectors must have been returned
+     * prior to calling this function.
+     */
+    void clear()
+    {
+      Assert(n_borrowed_ == 0,
+             dealii::ExcMessage("VectorPool cleared while vectors are "
+                                "still borrowed"));
+      pool_.clear();
+    }
+
+    /**
+     * Return the memory consumption (in bytes) of all idle vectors.
+     */
+    std::size_t memory_consumption() const
+    {
+      std::size_t result = 0;
+      for (const auto &[key, entry] : pool_)
+        for (const auto &it : entry.second)
+          result += it->memory_consumption();
+      return result;
+    }
+
+  private:
+    void release(const partitioner_type *key,
+                 std::unique_ptr<VectorType> &&vector)
+    {
+      --n_borrowed_;
+      pool_[key].second.push_back(std::move(vector));
+    }
+
+    std::map<const partitioner_type *,
+             std::pair<std::shared_ptr<const partitioner_type>,
+                       std::vector<std::unique_ptr<VectorType>>>>
+        pool_;
+
+    unsigned int n_borrowed_ = 0;
+  };
+} // namespace ryujin
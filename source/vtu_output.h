@@ -12,11 +12,19 @@
 #include "offline_data.h"
 #include "postprocessor.h"
 
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/data_out_base.h>
 #include <deal.II/base/parameter_acceptor.h>
 #include <deal.II/grid/intergrid_map.h>
+#include <deal.II/grid/tria.h>
 #include <deal.II/multigrid/mg_transfer_matrix_free.h>
 
+#include <boost/signals2/connection.hpp>
+
 #include <future>
+#include <map>
+#include <memory>
+#include <set>
 
 namespace ryujin
 {
@@ -60,6 +68,12 @@ namespace ryujin
     static constexpr unsigned int n_precomputed_values =
         HyperbolicSystemView::n_precomputed_values;
 
+    /**
+     * @copydoc HyperbolicSystem::n_precomputed_initial_values
+     */
+    static constexpr unsigned int n_precomputed_initial_values =
+        HyperbolicSystemView::n_precomputed_initial_values;
+
     /**
      * @copydoc OfflineData::scalar_type
      */
@@ -85,6 +99,11 @@ namespace ryujin
         const Postprocessor<Description, dim, Number> &postprocessor,
         const std::string &subsection = "/VTUOutput");
 
+    /**
+     * Destructor. Waits for a pending asynchronous write-out to complete.
+     */
+    ~VTUOutput();
+
     /**
      * Prepare VTU output. A call to @ref prepare() allocates temporary
      * storage and is necessary before schedule_output() can be called.
@@ -94,6 +113,13 @@ namespace ryujin
      */
     void prepare();
 
+    /**
+     * Append the memory consumption (in bytes) of the output buffers to
+     * @p statistics.
+     */
+    void collect_memory_statistics(
+        std::vector<std::pair<std::string, std::size_t>> &statistics) const;
+
     /**
      * Given a state vector @p U and a file name prefix @p name, the
      * current time @p t, and the current output cycle @p cycle) schedule a
@@ -107,17 +133,40 @@ namespace ryujin
      * The booleans @p output_full controls whether the full vector field
      * is written out. Correspondingly, @p output_cutplanes controls
      * whether cells in the vicinity of predefined cutplanes are written
-     * out.
+     * out, and @p output_preview controls whether a preview of the
+     * solution interpolated to the coarser mesh level "preview level" is
+     * written out.
+     *
+     * If @p output_regions is set, all "regions of interest" whose output
+     * multiplier divides @p cycle are written out as well. Only ranks
+     * owning cells that intersect a region participate in its write-out.
+     *
+     * The optional @p additional_quantities, a list of named scalar
+     * fields (for example the full-field statistics computed by
+     * Quantities), are appended to the full output.
      *
      * The function requires MPI communication and is not reentrant.
      */
-    void schedule_output(const vector_type &U,
-                         const precomputed_type &precomputed_values,
-                         std::string name,
-                         Number t,
-                         unsigned int cycle,
-                         bool output_full = true,
-                         bool output_cutplanes = true);
+    void schedule_output(
+        const vector_type &U,
+        const precomputed_type &precomputed_values,
+        std::string name,
+        Number t,
+        unsigned int cycle,
+        bool output_full = true,
+        bool output_cutplanes = true,
+        bool output_preview = false,
+        bool output_regions = false,
+        const std::vector<std::tuple<std::string, scalar_type>>
+            &additional_quantities = {});
+
+    /**
+     * Wait for a write-out that was scheduled asynchronously by
+     * schedule_output() to complete. This function has to be called
+     * before the underlying triangulation, or DoFHandler are modified.
+     * The function returns immediately if no write-out is pending.
+     */
+    void wait();
 
     /**
      * Return a boolean indicating whether Steps 0 to 2 of an explicit
@@ -127,6 +176,20 @@ namespace ryujin
      */
     ACCESSOR_READ_ONLY(need_to_prepare_step)
 
+    /**
+     * Return true if at least one region of interest is configured.
+     */
+    bool has_regions_of_interest() const
+    {
+      return !regions_of_interest_.empty();
+    }
+
+    /**
+     * Return true if the output multiplier of at least one region of
+     * interest divides @p cycle.
+     */
+    bool regions_of_interest_due(unsigned int cycle) const;
+
   private:
     /**
      * @name Run time options
@@ -135,10 +198,23 @@ namespace ryujin
 
     bool use_mpi_io_;
 
+    bool asynchronous_writeback_;
+
+    std::string output_format_;
+
     std::vector<std::string> manifolds_;
 
+    unsigned int preview_level_;
+
     std::vector<std::string> vtu_output_quantities_;
 
+    std::vector<std::tuple<std::string /*name*/,
+                           std::string /*lower corner*/,
+                           std::string /*upper corner*/,
+                           std::string /*quantities*/,
+                           unsigned int /*multiplier*/>>
+        regions_of_interest_;
+
     //@}
     /**
      * @name Internal data
@@ -157,12 +233,66 @@ namespace ryujin
 
     std::vector<scalar_type> quantities_;
 
+    std::vector<scalar_type> postprocessor_quantities_;
+
+    std::vector<std::tuple<std::string, scalar_type>> additional_quantities_;
+
+    std::vector<typename dealii::Triangulation<dim>::cell_iterator>
+        levelset_cells_;
+
+    /**
+     * A region of interest described by an axis-aligned bounding box.
+     * The list of locally owned cells intersecting the box and the
+     * communicator of all ranks owning at least one such cell are
+     * recomputed in prepare(), i.e., once per mesh. The communicator is
+     * MPI_COMM_NULL on all other ranks.
+     */
+    struct RegionOfInterest {
+      std::string name;
+      dealii::BoundingBox<dim> box;
+      std::vector<std::string> quantities;
+      unsigned int multiplier;
+      std::vector<typename dealii::Triangulation<dim>::cell_iterator> cells;
+      MPI_Comm communicator;
+      unsigned int this_rank;
+      unsigned int n_ranks;
+    };
+
+    std::vector<RegionOfInterest> regions_;
+
+    void free_region_communicators();
+
+    std::unique_ptr<dealii::MGTransferMatrixFree<dim, Number>>
+        preview_transfer_;
+    std::vector<dealii::MGLevelObject<scalar_type>> preview_quantities_;
+
+    std::future<void> background_thread_status_;
+
+    unsigned int mesh_cycle_;
+    bool mesh_changed_;
+    const void *tracked_triangulation_;
+    boost::signals2::connection mesh_connection_;
+    std::set<std::string> hdf5_meshes_written_;
+    std::map<std::string, std::vector<dealii::XDMFEntry>> xdmf_entries_;
+
+    /**
+     * The origin of a requested output quantity.
+     */
+    enum class QuantityType {
+      conserved,
+      primitive,
+      precomputed_initial,
+      precomputed,
+      alpha,
+    };
+
     std::vector<std::tuple<std::string /*name*/,
-                           std::function<void(scalar_type & /*result*/,
-                                              const vector_type & /*U*/,
-                                              const precomputed_type &)>>>
+                           QuantityType /*type*/,
+                           unsigned int /*component*/>>
         quantities_mapping_;
 
+    bool need_primitive_state_;
+
     //@}
   };
 
@@ -5,16 +5,22 @@
 
 #pragma once
 
+#include "openmp.h"
 #include "simd.h"
 #include "vtu_output.h"
 
 #include <deal.II/base/function_parser.h>
+#include <deal.II/dofs/dof_tools.h>
 #include <deal.II/numerics/data_out.h>
 #include <deal.II/numerics/vector_tools.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <sstream>
 
 namespace ryujin
 {
@@ -34,6 +40,9 @@ namespace ryujin
       , hyperbolic_module_(&hyperbolic_module)
       , postprocessor_(&postprocessor)
       , need_to_prepare_step_(false)
+      , mesh_cycle_(0)
+      , mesh_changed_(true)
+      , tracked_triangulation_(nullptr)
   {
     use_mpi_io_ = true;
     add_parameter("use mpi io",
@@ -42,11 +51,37 @@ namespace ryujin
                   "write_vtu_in_parallel() instead of independent output files "
                   "via write_vtu_with_pvtu_record()");
 
+    asynchronous_writeback_ = false;
+    add_parameter(
+        "asynchronous writeback",
+        asynchronous_writeback_,
+        "If enabled, the (patch building and) write-out of vtu files is "
+        "performed on a background thread overlapping with subsequent time "
+        "steps. Asynchronous writeback ignores \"use mpi io\" and writes one "
+        "vtu file per rank and a pvtu record.");
+
+    output_format_ = "vtu";
+    add_parameter(
+        "output format",
+        output_format_,
+        "File format used for output: \"vtu\", or \"hdf5\". The latter "
+        "writes the solution with collective MPI IO into HDF5 files together "
+        "with an XDMF record. The mesh is only written after it changed, "
+        "i.e., once per refinement cycle, and all subsequent snapshots "
+        "contain field data only.");
+
     add_parameter("manifolds",
                   manifolds_,
                   "List of level set functions. The description is used to "
                   "only output cells that intersect the given level set.");
 
+    preview_level_ = 0;
+    add_parameter("preview level",
+                  preview_level_,
+                  "Level of the triangulation the solution is interpolated to "
+                  "for preview output. Level 0 is the coarse mesh; levels "
+                  "beyond the finest level are clamped.");
+
     std::copy(std::begin(HyperbolicSystemView::component_names),
               std::end(HyperbolicSystemView::component_names),
               std::back_inserter(vtu_output_quantities_));
@@ -59,6 +94,57 @@ namespace ryujin
                   vtu_output_quantities_,
                   "List of conserved, primitive, precomputed, or postprocessed "
                   "quantities that will be written to the vtu files.");
+
+    add_parameter(
+        "regions of interest",
+        regions_of_interest_,
+        "List of axis-aligned bounding boxes. Only cells intersecting a "
+        "box are written out for the region, with the given subset of "
+        "\"vtu output quantities\" and postprocessed quantities (all if "
+        "empty), whenever the region multiplier divides the output cycle. "
+        "Format: '<name> : <lower corner> : <upper corner> : <quantities> "
+        ": <multiplier> , [...]' with space separated coordinates and "
+        "quantities");
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  VTUOutput<Description, dim, Number>::~VTUOutput()
+  {
+    if (background_thread_status_.valid())
+      background_thread_status_.wait();
+    mesh_connection_.disconnect();
+    free_region_communicators();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::free_region_communicators()
+  {
+    for (auto &region : regions_)
+      if (region.communicator != MPI_COMM_NULL)
+        MPI_Comm_free(&region.communicator);
+    regions_.clear();
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  bool VTUOutput<Description, dim, Number>::regions_of_interest_due(
+      unsigned int cycle) const
+  {
+    return std::any_of(
+        regions_of_interest_.begin(),
+        regions_of_interest_.end(),
+        [cycle](const auto &it) { return cycle % std::get<4>(it) == 0; });
+  }
+
+
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::wait()
+  {
+    /* Rethrows an exception that might have occured in the background: */
+    if (background_thread_status_.valid())
+      background_thread_status_.get();
   }
 
 
@@ -69,7 +155,174 @@ namespace ryujin
     std::cout << "VTUOutput<dim, Number>::prepare()" << std::endl;
 #endif
 
+    /* The pending write-out still refers to the old DoFHandler: */
+    wait();
+
+    AssertThrow(output_format_ == "vtu" || output_format_ == "hdf5",
+                ExcMessage("Unknown output format »" + output_format_ + "«"));
+#ifndef DEAL_II_WITH_HDF5
+    AssertThrow(output_format_ != "hdf5",
+                ExcMessage("The \"hdf5\" output format requires deal.II to be "
+                           "configured with HDF5 support"));
+#endif
+
+    /*
+     * Keep track of whether the triangulation changed since the last
+     * call to prepare(). Only in this case do we have to write out new
+     * HDF5 mesh files:
+     */
+    const auto &triangulation = offline_data_->discretization().triangulation();
+    if (&triangulation != tracked_triangulation_) {
+      mesh_connection_.disconnect();
+      mesh_connection_ = triangulation.signals.any_change.connect(
+          [this]() { mesh_changed_ = true; });
+      tracked_triangulation_ = &triangulation;
+      mesh_changed_ = true;
+    }
+
+    if (mesh_changed_) {
+      if (!hdf5_meshes_written_.empty())
+        ++mesh_cycle_;
+      hdf5_meshes_written_.clear();
+      mesh_changed_ = false;
+    }
+
+    /*
+     * Precompute the list of all locally owned cells that intersect one
+     * of the level sets. A cell intersects a level set if the level set
+     * function changes sign (or vanishes) on its vertices:
+     */
+
+    /* The preview transfer operator is rebuilt on first use: */
+    preview_transfer_.reset();
+    preview_quantities_.clear();
+
+    levelset_cells_.clear();
+
+    if (!manifolds_.empty()) {
+      /*
+       * Evaluate every level set function only once per vertex (instead
+       * of once per vertex of every adjacent cell). The per-vertex flags
+       * record whether the value is nonnegative (bit 0) or nonpositive
+       * (bit 1) up to a tolerance, and whether it was computed (bit 2):
+       */
+      std::vector<bool> intersected(triangulation.n_active_cells(), false);
+      std::vector<std::uint8_t> vertex_flags(triangulation.n_vertices());
+
+      for (const auto &expression : manifolds_) {
+        FunctionParser<dim> function(expression);
+        std::fill(vertex_flags.begin(), vertex_flags.end(), 0);
+
+        for (const auto &cell : triangulation.active_cell_iterators()) {
+          if (!cell->is_locally_owned() ||
+              intersected[cell->active_cell_index()])
+            continue;
+
+          std::uint8_t flags = 0;
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v) {
+            auto &flag = vertex_flags[cell->vertex_index(v)];
+            if (flag == 0) {
+              const auto value = function.value(cell->vertex(v));
+              constexpr auto eps = std::numeric_limits<Number>::epsilon();
+              flag = 4;
+              if (value >= 0. - 100. * eps)
+                flag |= 1;
+              if (value <= 0. + 100. * eps)
+                flag |= 2;
+            }
+            flags |= flag;
+          }
+
+          if ((flags & 3) == 3)
+            intersected[cell->active_cell_index()] = true;
+        }
+      }
+
+      /* Active cell iterators are traversed in ascending order: */
+      for (const auto &cell : triangulation.active_cell_iterators())
+        if (cell->is_locally_owned() && intersected[cell->active_cell_index()])
+          levelset_cells_.push_back(cell);
+    }
+
+    /*
+     * Parse all regions of interest and precompute the list of locally
+     * owned cells whose bounding box intersects the region. Only ranks
+     * that own at least one such cell are part of the communicator used
+     * for writing out the region:
+     */
+
+    free_region_communicators();
+
+    for (const auto &[name, lower, upper, entries, multiplier] :
+         regions_of_interest_) {
+      const auto parse_point = [&name = name](const std::string &string) {
+        std::istringstream stream(string);
+        Point<dim> point;
+        for (unsigned int d = 0; d < dim; ++d)
+          stream >> point[d];
+        AssertThrow(!stream.fail(),
+                    ExcMessage("Could not parse corner »" + string +
+                               "« of region of interest »" + name + "«"));
+        return point;
+      };
+
+      AssertThrow(multiplier > 0,
+                  ExcMessage("The multiplier of region of interest »" + name +
+                             "« must be positive"));
+
+      RegionOfInterest region;
+      region.name = name;
+      region.box = BoundingBox<dim>({parse_point(lower), parse_point(upper)});
+      region.multiplier = multiplier;
+      region.communicator = MPI_COMM_NULL;
+      region.this_rank = 0;
+      region.n_ranks = 0;
+
+      std::istringstream stream(entries);
+      for (std::string entry; stream >> entry;) {
+        const auto &names = postprocessor_->component_names();
+        AssertThrow(std::find(vtu_output_quantities_.begin(),
+                              vtu_output_quantities_.end(),
+                              entry) != vtu_output_quantities_.end() ||
+                        std::find(names.begin(), names.end(), entry) !=
+                            names.end(),
+                    ExcMessage("Quantity »" + entry + "« of region of "
+                               "interest »" + name + "« is not written out"));
+        region.quantities.push_back(entry);
+      }
+
+      const auto &[region_lower, region_upper] =
+          region.box.get_boundary_points();
+      for (const auto &cell : triangulation.active_cell_iterators()) {
+        if (!cell->is_locally_owned())
+          continue;
+
+        const auto cell_box = cell->bounding_box();
+        const auto &[cell_lower, cell_upper] = cell_box.get_boundary_points();
+        bool intersects = true;
+        for (unsigned int d = 0; d < dim; ++d)
+          intersects = intersects && cell_lower[d] <= region_upper[d] &&
+                       cell_upper[d] >= region_lower[d];
+        if (intersects)
+          region.cells.push_back(cell);
+      }
+
+      MPI_Comm_split(mpi_communicator_,
+                     region.cells.empty() ? MPI_UNDEFINED : 0,
+                     Utilities::MPI::this_mpi_process(mpi_communicator_),
+                     &region.communicator);
+      if (region.communicator != MPI_COMM_NULL) {
+        region.this_rank =
+            Utilities::MPI::this_mpi_process(region.communicator);
+        region.n_ranks = Utilities::MPI::n_mpi_processes(region.communicator);
+      }
+
+      regions_.push_back(std::move(region));
+    }
+
     need_to_prepare_step_ = false;
+    need_primitive_state_ = false;
 
     /* Populate quantities mapping: */
 
@@ -84,12 +337,7 @@ namespace ryujin
         if (pos != std::end(names)) {
           const auto index = std::distance(std::begin(names), pos);
           quantities_mapping_.push_back(
-              std::make_tuple(entry,
-                              [index](scalar_type &result,
-                                      const vector_type &U,
-                                      const precomputed_type &) {
-                                U.extract_component(result, index);
-                              }));
+              std::make_tuple(entry, QuantityType::conserved, index));
           continue;
         }
       }
@@ -101,23 +349,9 @@ namespace ryujin
         const auto pos = std::find(std::begin(names), std::end(names), entry);
         if (pos != std::end(names)) {
           const auto index = std::distance(std::begin(names), pos);
-          quantities_mapping_.push_back(std::make_tuple(
-              entry,
-              [this, index](scalar_type &result,
-                            const vector_type &U,
-                            const precomputed_type &) {
-                /*
-                 * FIXME: We might traverse the same vector multiple times. This
-                 * is inefficient.
-                 */
-                const unsigned int n_owned = offline_data_->n_locally_owned();
-                for (unsigned int i = 0; i < n_owned; ++i) {
-                  const auto view = hyperbolic_module_->hyperbolic_system()
-                                        .template view<dim, Number>();
-                  result.local_element(i) =
-                      view.to_primitive_state(U.get_tensor(i))[index];
-                }
-              }));
+          quantities_mapping_.push_back(
+              std::make_tuple(entry, QuantityType::primitive, index));
+          need_primitive_state_ = true;
           continue;
         }
       }
@@ -129,14 +363,8 @@ namespace ryujin
         const auto pos = std::find(std::begin(names), std::end(names), entry);
         if (pos != std::end(names)) {
           const auto index = std::distance(std::begin(names), pos);
-          quantities_mapping_.push_back(std::make_tuple(
-              entry,
-              [this, index](scalar_type &result,
-                            const vector_type &,
-                            const precomputed_type &) {
-                hyperbolic_module_->precomputed_initial().extract_component(
-                    result, index);
-              }));
+          quantities_mapping_.push_back(
+              std::make_tuple(entry, QuantityType::precomputed_initial, index));
           continue;
         }
       }
@@ -148,13 +376,8 @@ namespace ryujin
         const auto pos = std::find(std::begin(names), std::end(names), entry);
         if (pos != std::end(names)) {
           const auto index = std::distance(std::begin(names), pos);
-          quantities_mapping_.push_back(std::make_tuple(
-              entry,
-              [index](scalar_type &result,
-                      const vector_type &,
-                      const precomputed_type &precomputed_values) {
-                precomputed_values.extract_component(result, index);
-              }));
+          quantities_mapping_.push_back(
+              std::make_tuple(entry, QuantityType::precomputed, index));
           need_to_prepare_step_ = true;
           continue;
         }
@@ -165,13 +388,7 @@ namespace ryujin
 
         if (entry == "alpha") {
           quantities_mapping_.push_back(
-              std::make_tuple(entry,
-                              [this](scalar_type &result,
-                                     const vector_type &,
-                                     const precomputed_type &) {
-                                const auto &alpha = hyperbolic_module_->alpha();
-                                result = alpha;
-                              }));
+              std::make_tuple(entry, QuantityType::alpha, 0u));
           need_to_prepare_step_ = true;
           continue;
         }
@@ -186,6 +403,24 @@ namespace ryujin
   }
 
 
+  template <typename Description, int dim, typename Number>
+  void VTUOutput<Description, dim, Number>::collect_memory_statistics(
+      std::vector<std::pair<std::string, std::size_t>> &statistics) const
+  {
+    std::size_t buffers = 0;
+    for (const auto &it : quantities_)
+      buffers += it.memory_consumption();
+    for (const auto &it : postprocessor_quantities_)
+      buffers += it.memory_consumption();
+    for (const auto &it : additional_quantities_)
+      buffers += std::get<1>(it).memory_consumption();
+    for (const auto &it : preview_quantities_)
+      for (unsigned int l = it.min_level(); l <= it.max_level(); ++l)
+        buffers += it[l].memory_consumption();
+    statistics.push_back({"VTUOutput: output buffers", buffers});
+  }
+
+
   template <typename Description, int dim, typename Number>
   void VTUOutput<Description, dim, Number>::schedule_output(
       const vector_type &U,
@@ -194,27 +429,154 @@ namespace ryujin
       Number t,
       unsigned int cycle,
       bool output_full,
-      bool output_levelsets)
+      bool output_levelsets,
+      bool output_preview,
+      bool output_regions,
+      const std::vector<std::tuple<std::string, scalar_type>>
+          &additional_quantities)
   {
 #ifdef DEBUG_OUTPUT
     std::cout << "VTUOutput<dim, Number>::schedule_output()" << std::endl;
 #endif
     const auto &affine_constraints = offline_data_->affine_constraints();
 
-    /* Copy quantities: */
+    /*
+     * A pending asynchronous write-out still refers to quantities_,
+     * postprocessor_quantities_, and additional_quantities_:
+     */
+    wait();
+
+    /*
+     * Extract all quantities in a single sweep over the locally owned
+     * degrees of freedom: Every state U_i is loaded (and converted to its
+     * primitive state) only once and then scattered into all requested
+     * output vectors.
+     */
 
     Assert(quantities_.size() == quantities_mapping_.size(),
            ExcInternalError());
-    for (unsigned int d = 0; d < quantities_.size(); ++d) {
-      const auto &lambda = std::get<1>(quantities_mapping_[d]);
-      lambda(quantities_[d], U, precomputed_values);
-      affine_constraints.distribute(quantities_[d]);
-      quantities_[d].update_ghost_values();
+
+    {
+      using VA = VectorizedArray<Number>;
+      constexpr auto simd_length = VA::size();
+
+      const auto &precomputed_initial =
+          hyperbolic_module_->precomputed_initial();
+      const auto &alpha = hyperbolic_module_->alpha();
+
+      const unsigned int n_owned = offline_data_->n_locally_owned();
+      const unsigned int n_regular = n_owned / simd_length * simd_length;
+
+      RYUJIN_PARALLEL_REGION_BEGIN
+
+      auto loop = [&](auto sentinel, unsigned int left, unsigned int right) {
+        using T = decltype(sentinel);
+        unsigned int stride_size = get_stride_size<T>;
+
+        const auto view = hyperbolic_module_->hyperbolic_system()
+                              .template view<dim, T>();
+
+        RYUJIN_OMP_FOR
+        for (unsigned int i = left; i < right; i += stride_size) {
+
+          const auto U_i = U.template get_tensor<T>(i);
+
+          decltype(view.to_primitive_state(U_i)) primitive_state;
+          if (need_primitive_state_)
+            primitive_state = view.to_primitive_state(U_i);
+
+          for (unsigned int d = 0; d < quantities_.size(); ++d) {
+            const auto &[entry, type, index] = quantities_mapping_[d];
+
+            T result(0.);
+            switch (type) {
+            case QuantityType::conserved:
+              result = U_i[index];
+              break;
+            case QuantityType::primitive:
+              result = primitive_state[index];
+              break;
+            case QuantityType::precomputed_initial:
+              if constexpr (n_precomputed_initial_values > 0)
+                result = precomputed_initial.template get_tensor<T>(i)[index];
+              break;
+            case QuantityType::precomputed:
+              if constexpr (n_precomputed_values > 0)
+                result = precomputed_values.template get_tensor<T>(i)[index];
+              break;
+            case QuantityType::alpha:
+              result = load_value<T>(alpha, i);
+              break;
+            }
+
+            store_value<T>(quantities_[d], result, i);
+          }
+        }
+      };
+
+      /* Parallel vectorized SIMD loop: */
+      loop(VA(), 0, n_regular);
+      /* Parallel non-vectorized loop: */
+      loop(Number(), n_regular, n_owned);
+
+      RYUJIN_PARALLEL_REGION_END
+    }
+
+    for (auto &it : quantities_) {
+      affine_constraints.distribute(it);
+      it.update_ghost_values();
+    }
+
+    /*
+     * Interpolate all output and postprocessor quantities to the preview
+     * level. This requires MPI communication and thus happens on the
+     * main thread:
+     */
+
+    const auto &dof_handler = offline_data_->dof_handler();
+    const auto n_levels = dof_handler.get_triangulation().n_global_levels();
+    const unsigned int preview_level = std::min(preview_level_, n_levels - 1);
+
+    if (output_preview) {
+      if (!preview_transfer_) {
+        preview_transfer_ =
+            std::make_unique<MGTransferMatrixFree<dim, Number>>();
+        preview_transfer_->build(dof_handler);
+
+        const auto n_vectors =
+            quantities_.size() + postprocessor_->n_quantities();
+        preview_quantities_.resize(n_vectors);
+        for (auto &it : preview_quantities_)
+          it.resize(preview_level, n_levels - 1);
+
+        for (unsigned int l = preview_level; l < n_levels; ++l) {
+          IndexSet relevant_dofs;
+          DoFTools::extract_locally_relevant_level_dofs(
+              dof_handler, l, relevant_dofs);
+          const auto partitioner =
+              std::make_shared<Utilities::MPI::Partitioner>(
+                  dof_handler.locally_owned_mg_dofs(l),
+                  relevant_dofs,
+                  mpi_communicator_);
+          for (auto &it : preview_quantities_)
+            it[l].reinit(partitioner);
+        }
+      }
+
+      unsigned int d = 0;
+      for (const auto &it : quantities_)
+        preview_transfer_->interpolate_to_mg(
+            dof_handler, preview_quantities_[d++], it);
+      for (const auto &it : postprocessor_->quantities())
+        preview_transfer_->interpolate_to_mg(
+            dof_handler, preview_quantities_[d++], it);
+      for (auto &it : preview_quantities_)
+        it[preview_level].update_ghost_values();
     }
 
     /* prepare DataOut: */
 
-    auto data_out = std::make_unique<dealii::DataOut<dim>>();
+    auto data_out = std::make_shared<dealii::DataOut<dim>>();
     data_out->attach_dof_handler(offline_data_->dof_handler());
 
     for (unsigned int d = 0; d < quantities_.size(); ++d) {
@@ -222,10 +584,41 @@ namespace ryujin
       data_out->add_data_vector(quantities_[d], entry);
     }
 
+    /*
+     * The HDF5 writer uses collective MPI IO and thus has to run on the
+     * main thread.
+     */
+    const bool hdf5_output = output_format_ == "hdf5";
+    const bool asynchronous = asynchronous_writeback_ && !hdf5_output;
+
+    /*
+     * The postprocessor overwrites its quantities in the next output
+     * cycle. Take a snapshot in case we write out asynchronously:
+     */
     const auto n_quantities = postprocessor_->n_quantities();
-    for (unsigned int i = 0; i < n_quantities; ++i)
-      data_out->add_data_vector(postprocessor_->quantities()[i],
-                                postprocessor_->component_names()[i]);
+    postprocessor_quantities_.resize(asynchronous ? n_quantities : 0);
+    for (unsigned int i = 0; i < n_quantities; ++i) {
+      const auto &entry = postprocessor_->component_names()[i];
+      if (asynchronous) {
+        postprocessor_quantities_[i] = postprocessor_->quantities()[i];
+        data_out->add_data_vector(postprocessor_quantities_[i], entry);
+      } else {
+        data_out->add_data_vector(postprocessor_->quantities()[i], entry);
+      }
+    }
+
+    /*
+     * Additional quantities are only written to the full output. We
+     * always keep a copy because the caller might hand us temporaries:
+     */
+    additional_quantities_.clear();
+    if (output_full)
+      additional_quantities_ = additional_quantities;
+    for (auto &[entry, quantity] : additional_quantities_) {
+      affine_constraints.distribute(quantity);
+      quantity.update_ghost_values();
+      data_out->add_data_vector(quantity, entry);
+    }
 
     DataOutBase::VtkFlags flags(t,
                                 cycle,
@@ -237,76 +630,266 @@ namespace ryujin
 #endif
     data_out->set_flags(flags);
 
+#if DEAL_II_VERSION_GTE(9, 5, 0)
+    /* Deflate compression of HDF5 datasets: */
+    data_out->set_flags(
+        DataOutBase::Hdf5Flags(DataOutBase::CompressionLevel::best_speed));
+#endif
+
+    /*
+     * Prepare a second DataOut object for the preview that only selects
+     * locally owned cells on the preview level:
+     */
+
+    std::shared_ptr<dealii::DataOut<dim>> preview_data_out;
+    if (output_preview) {
+      preview_data_out = std::make_shared<dealii::DataOut<dim>>();
+      preview_data_out->attach_dof_handler(dof_handler);
+
+      unsigned int d = 0;
+      for (const auto &[entry, type, index] : quantities_mapping_)
+        preview_data_out->add_mg_data_vector(
+            dof_handler, preview_quantities_[d++], entry);
+      for (const auto &entry : postprocessor_->component_names())
+        preview_data_out->add_mg_data_vector(
+            dof_handler, preview_quantities_[d++], entry);
+
+      preview_data_out->set_cell_selection(
+          [preview_level](const auto &cell) {
+            return cell->level() == static_cast<int>(preview_level) &&
+                   cell->is_locally_owned_on_level();
+          });
+      preview_data_out->set_flags(flags);
+    }
+
     const auto &discretization = offline_data_->discretization();
     const auto &mapping = discretization.mapping();
     const auto patch_order = discretization.finite_element().degree - 1;
 
-    /* Perform output: */
-
-    if (output_full) {
-      data_out->build_patches(mapping, patch_order);
+    /*
+     * Specify an output filter that selects only the (precomputed) list
+     * of cells that intersect one of the specified level sets:
+     */
+
+    using cell_iterator = typename Triangulation<dim>::cell_iterator;
+
+    const auto first_cell = [this](const Triangulation<dim> &triangulation) {
+      return levelset_cells_.empty() ? triangulation.end()
+                                     : levelset_cells_.front();
+    };
+
+    const auto next_cell = [this](const Triangulation<dim> &triangulation,
+                                  const cell_iterator &cell) {
+      const auto it = std::upper_bound(
+          levelset_cells_.begin(), levelset_cells_.end(), cell);
+      return it == levelset_cells_.end() ? triangulation.end() : *it;
+    };
+
+    /*
+     * Write out the patches currently stored in data_out. An asynchronous
+     * write-out runs concurrently to MPI communication on the main thread.
+     * We thus must not communicate and write one vtu file per rank and,
+     * on rank 0, a pvtu record referencing all of them.
+     */
+
+    const auto this_rank = Utilities::MPI::this_mpi_process(mpi_communicator_);
+    const auto n_ranks = Utilities::MPI::n_mpi_processes(mpi_communicator_);
+
+    const auto write_patches = [this, cycle, asynchronous](
+                                   dealii::DataOut<dim> &data_out,
+                                   const std::string &base_name,
+                                   const MPI_Comm &communicator,
+                                   const unsigned int this_rank,
+                                   const unsigned int n_ranks) {
+      const auto prefix = base_name + "_" + Utilities::to_string(cycle, 6);
+
+      if (asynchronous) {
+        const auto n_digits = Utilities::needed_digits(n_ranks - 1);
+        const auto filename = [&](const unsigned int rank) {
+          return prefix + "." + Utilities::to_string(rank, n_digits) + ".vtu";
+        };
+
+        std::ofstream output(filename(this_rank));
+        data_out.write_vtu(output);
+
+        if (this_rank == 0) {
+          std::vector<std::string> filenames;
+          for (unsigned int rank = 0; rank < n_ranks; ++rank)
+            filenames.push_back(filename(rank));
+          std::ofstream pvtu_output(prefix + ".pvtu");
+          data_out.write_pvtu_record(pvtu_output, filenames);
+        }
 
-      if (use_mpi_io_) {
+      } else if (use_mpi_io_) {
         /* MPI-based synchronous IO */
-        data_out->write_vtu_in_parallel(
-            name + "_" + Utilities::to_string(cycle, 6) + ".vtu",
-            mpi_communicator_);
+        data_out.write_vtu_in_parallel(prefix + ".vtu", communicator);
+
       } else {
-        data_out->write_vtu_with_pvtu_record(
-            "", name, cycle, mpi_communicator_, 6);
+        data_out.write_vtu_with_pvtu_record(
+            "", base_name, cycle, communicator, 6);
+      }
+    };
+
+    /*
+     * Write out the patches currently stored in data_out into an HDF5
+     * file and append an entry to the XDMF record of @p base_name. The
+     * mesh is only written for the first snapshot after a change of the
+     * triangulation and referenced by all subsequent entries.
+     */
+
+    const auto write_hdf5 = [this, t, cycle](dealii::DataOut<dim> &data_out,
+                                             const std::string &base_name,
+                                             const MPI_Comm &communicator) {
+      DataOutBase::DataOutFilter data_filter(
+          DataOutBase::DataOutFilterFlags(true, true));
+      data_out.write_filtered_data(data_filter);
+
+      const auto mesh_filename =
+          base_name + "-mesh_" + Utilities::to_string(mesh_cycle_, 6) + ".h5";
+      const auto solution_filename =
+          base_name + "_" + Utilities::to_string(cycle, 6) + ".h5";
+
+      const bool write_mesh = hdf5_meshes_written_.count(base_name) == 0;
+      data_out.write_hdf5_parallel(data_filter,
+                                   write_mesh,
+                                   mesh_filename,
+                                   solution_filename,
+                                   communicator);
+      hdf5_meshes_written_.insert(base_name);
+
+      auto &entries = xdmf_entries_[base_name];
+      entries.push_back(data_out.create_xdmf_entry(
+          data_filter, mesh_filename, solution_filename, t, communicator));
+      data_out.write_xdmf_file(entries, base_name + ".xdmf", communicator);
+    };
+
+    /*
+     * Prepare one DataOut object for every region of interest that is
+     * due in this cycle. It only contains the requested subset of
+     * quantities and selects the (precomputed) list of cells
+     * intersecting the region. Ranks that do not own any such cell skip
+     * the region altogether:
+     */
+
+    std::vector<std::tuple<std::shared_ptr<dealii::DataOut<dim>>,
+                           const RegionOfInterest *>>
+        region_data_outs;
+
+    for (const auto &region : regions_) {
+      if (!output_regions || cycle % region.multiplier != 0 ||
+          region.communicator == MPI_COMM_NULL)
+        continue;
+
+      const auto selected = [&region](const std::string &entry) {
+        const auto &list = region.quantities;
+        return list.empty() ||
+               std::find(list.begin(), list.end(), entry) != list.end();
+      };
+
+      auto region_data_out = std::make_shared<dealii::DataOut<dim>>();
+      region_data_out->attach_dof_handler(dof_handler);
+
+      for (unsigned int d = 0; d < quantities_.size(); ++d) {
+        const auto &entry = std::get<0>(quantities_mapping_[d]);
+        if (selected(entry))
+          region_data_out->add_data_vector(quantities_[d], entry);
       }
-    }
-
-    if (output_levelsets && manifolds_.size() != 0) {
-      /*
-       * Specify an output filter that selects only cells for output that are
-       * in the viscinity of a specified set of output planes:
-       */
-
-      std::vector<std::shared_ptr<FunctionParser<dim>>> level_set_functions;
-      for (const auto &expression : manifolds_)
-        level_set_functions.emplace_back(
-            std::make_shared<FunctionParser<dim>>(expression));
-
-      data_out->set_cell_selection([level_set_functions](const auto &cell) {
-        if (!cell->is_active() || cell->is_artificial())
-          return false;
 
-        for (const auto &function : level_set_functions) {
+      for (unsigned int i = 0; i < n_quantities; ++i) {
+        const auto &entry = postprocessor_->component_names()[i];
+        if (selected(entry))
+          region_data_out->add_data_vector(
+              asynchronous ? postprocessor_quantities_[i]
+                           : postprocessor_->quantities()[i],
+              entry);
+      }
 
-          unsigned int above = 0;
-          unsigned int below = 0;
+      const auto &cells = region.cells;
+      region_data_out->set_cell_selection(
+          [&cells](const Triangulation<dim> &) { return cells.front(); },
+          [&cells](const Triangulation<dim> &triangulation,
+                   const cell_iterator &cell) {
+            const auto it =
+                std::upper_bound(cells.begin(), cells.end(), cell);
+            return it == cells.end() ? triangulation.end() : *it;
+          });
+      region_data_out->set_flags(flags);
+
+      region_data_outs.emplace_back(region_data_out, &region);
+    }
 
-          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
-               ++v) {
-            const auto vertex = cell->vertex(v);
-            constexpr auto eps = std::numeric_limits<Number>::epsilon();
-            if (function->value(vertex) >= 0. - 100. * eps)
-              above++;
-            if (function->value(vertex) <= 0. + 100. * eps)
-              below++;
-            if (above > 0 && below > 0)
-              return true;
-          }
-        }
-        return false;
-      });
+    /* Perform output: */
 
-      data_out->build_patches(mapping, patch_order);
+    const bool output_selection = output_levelsets && manifolds_.size() != 0;
+
+    const auto perform_output = [this,
+                                 data_out,
+                                 preview_data_out,
+                                 region_data_outs,
+                                 &mapping,
+                                 patch_order,
+                                 first_cell,
+                                 next_cell,
+                                 write_patches,
+                                 write_hdf5,
+                                 this_rank,
+                                 n_ranks,
+                                 name,
+                                 hdf5_output,
+                                 output_full,
+                                 output_selection,
+                                 output_preview]() mutable {
+      const auto write = [&](dealii::DataOut<dim> &data_out,
+                             const std::string &base_name) {
+        data_out.build_patches(mapping, patch_order);
+        if (hdf5_output)
+          write_hdf5(data_out, base_name, mpi_communicator_);
+        else
+          write_patches(
+              data_out, base_name, mpi_communicator_, this_rank, n_ranks);
+      };
+
+      if (output_full)
+        write(*data_out, name);
+
+      if (output_selection) {
+        data_out->set_cell_selection(first_cell, next_cell);
+        write(*data_out, name + "-levelsets");
+      }
 
-      if (use_mpi_io_) {
-        /* MPI-based synchronous IO */
-        data_out->write_vtu_in_parallel(
-            name + "-levelsets_" + Utilities::to_string(cycle, 6) + ".vtu",
-            mpi_communicator_);
-      } else {
-        data_out->write_vtu_with_pvtu_record(
-            "", name + "-levelsets", cycle, mpi_communicator_, 6);
+      if (output_preview)
+        write(*preview_data_out, name + "-preview");
+
+      for (auto &[region_data_out, region] : region_data_outs) {
+        const auto region_name = name + "-" + region->name;
+        region_data_out->build_patches(mapping, patch_order);
+        if (hdf5_output)
+          write_hdf5(*region_data_out, region_name, region->communicator);
+        else
+          write_patches(*region_data_out,
+                        region_name,
+                        region->communicator,
+                        region->this_rank,
+                        region->n_ranks);
       }
-    }
 
-    /* Explicitly delete pointer to free up memory early: */
+      /* Explicitly delete pointers to free up memory early: */
+      data_out.reset();
+      preview_data_out.reset();
+      region_data_outs.clear();
+    };
+
+    /* Release the local references so that the task owns data_out: */
     data_out.reset();
+    preview_data_out.reset();
+    region_data_outs.clear();
+
+    if (asynchronous) {
+      background_thread_status_ =
+          std::async(std::launch::async, std::move(perform_output));
+    } else {
+      perform_output();
+    }
   }
 
 } /* namespace ryujin */
@@ -0,0 +1,47 @@
+#include <simd_accurate_pow.template.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+int main()
+{
+  std::cout << std::setprecision(16);
+  std::cout << std::scientific;
+
+  using VA = dealii::VectorizedArray<double>;
+
+  auto test = [&](const double a, const double b) {
+    std::cout << "a:   " << a << "\n";
+    std::cout << "b:   " << b << "\n";
+    std::cout << "pow: " << ryujin::accurate_pow_impl(a, b) << "\n"
+              << std::endl;
+  };
+
+  test(1.225, 2.3559);
+  test(2.135, 1. / 3.);
+  test(0., 2.);
+  test(1.0e300, 3.);
+
+  /*
+   * Compare against std::pow() on a sample of typical arguments:
+   */
+
+  double max_error = 0.;
+  for (unsigned int i = 0; i <= 10000; ++i) {
+    const double x = std::exp(-20. + 40. * i / 10000.);
+    for (const double b : {1.4, 1. / 1.4, 0.4 / 1.4, -2.5, 3.}) {
+      const VA result = ryujin::accurate_pow_impl(VA(x), VA(b));
+      const double reference = std::pow(x, b);
+      const double ulp =
+          std::nextafter(reference, 2. * reference + 1.) - reference;
+      for (unsigned int k = 0; k < VA::size(); ++k)
+        max_error =
+            std::max(max_error, std::abs(result[k] - reference) / ulp);
+    }
+  }
+
+  std::cout << "maximal error <= 1 ulp: " << std::boolalpha
+            << (max_error <= 1.) << std::endl;
+}
@@ -0,0 +1,59 @@
+#include <boundary_table.h>
+
+#include <iostream>
+#include <map>
+#include <tuple>
+
+int main()
+{
+  constexpr int dim = 2;
+
+  using boundary_description =
+      std::tuple<dealii::Tensor<1, dim, double> /*normal*/,
+                 double /*normal mass*/,
+                 double /*boundary mass*/,
+                 dealii::types::boundary_id /*id*/,
+                 dealii::Point<dim>> /*position*/;
+
+  std::multimap<unsigned int, boundary_description> boundary_map;
+
+  const auto insert = [&](const unsigned int i,
+                          const double n_x,
+                          const dealii::types::boundary_id id) {
+    dealii::Tensor<1, dim, double> normal;
+    normal[0] = n_x;
+    normal[1] = 1. - n_x;
+    const dealii::Point<dim> position(i, 0.);
+    boundary_map.insert({i, {normal, 0.5 * i, 0.25 * i, id, position}});
+  };
+
+  insert(6, 1., 2);
+  insert(1, 0., 1);
+  insert(3, 1., 0);
+  insert(1, 1., 2);
+
+  ryujin::BoundaryTable<dim, double> boundary_table;
+  boundary_table.reinit(boundary_map, 8);
+
+  std::cout << "size: " << boundary_table.size() << std::endl;
+
+  std::cout << "rows:" << std::endl;
+  for (unsigned int i = 0; i < 10; ++i) {
+    std::cout << i << " " << boundary_table.is_boundary(i);
+    if (i < 8)
+      std::cout << " [" << boundary_table.begin(i) << ", "
+                << boundary_table.end(i) << ")";
+    std::cout << std::endl;
+  }
+
+  std::cout << "entries:" << std::endl;
+  for (unsigned int k = 0; k < boundary_table.size(); ++k) {
+    std::cout << boundary_table.index[k] << " | " << boundary_table.normal[k]
+              << " | " << boundary_table.normal_mass[k] << " "
+              << boundary_table.boundary_mass[k] << " | "
+              << static_cast<unsigned int>(boundary_table.id[k]) << " | "
+              << boundary_table.position[k] << std::endl;
+  }
+
+  return 0;
+}
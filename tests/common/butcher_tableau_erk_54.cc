@@ -0,0 +1,80 @@
+#include <butcher_tableau.h>
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+int main()
+{
+  using Tableau = ryujin::ERK54Tableau;
+  constexpr unsigned int n = Tableau::n_stages;
+  const auto &a = Tableau::a;
+  const auto &b = Tableau::b;
+
+  /* Nodes: */
+  std::array<double, n> c;
+  for (unsigned int i = 0; i < n; ++i) {
+    c[i] = 0.;
+    for (unsigned int j = 0; j < n; ++j)
+      c[i] += a[i][j];
+  }
+
+  std::array<double, n> ac;
+  std::array<double, n> acc;
+  for (unsigned int i = 0; i < n; ++i) {
+    ac[i] = acc[i] = 0.;
+    for (unsigned int j = 0; j < n; ++j) {
+      ac[i] += a[i][j] * c[j];
+      acc[i] += a[i][j] * c[j] * c[j];
+    }
+  }
+
+  std::array<double, n> aac;
+  for (unsigned int i = 0; i < n; ++i) {
+    aac[i] = 0.;
+    for (unsigned int j = 0; j < n; ++j)
+      aac[i] += a[i][j] * ac[j];
+  }
+
+  const auto sum = [&](const auto &f) {
+    double result = 0.;
+    for (unsigned int i = 0; i < n; ++i)
+      result += b[i] * f(i);
+    return result;
+  };
+
+  const auto check = [&](const std::string &name, double value, double ref) {
+    std::cout << name << ": " << std::boolalpha
+              << (std::abs(value - ref) < 1.e-14) << std::endl;
+  };
+
+  for (unsigned int i = 0; i < n; ++i)
+    check("c_" + std::to_string(i + 1) + " = " + std::to_string(i) + " c",
+          c[i],
+          i * Tableau::c);
+
+  /* Order conditions up to order four: */
+  check("sum b_i                 = 1   ", sum([](auto) { return 1.; }), 1.);
+  check("sum b_i c_i             = 1/2 ",
+        sum([&](auto i) { return c[i]; }),
+        1. / 2.);
+  check("sum b_i c_i^2           = 1/3 ",
+        sum([&](auto i) { return c[i] * c[i]; }),
+        1. / 3.);
+  check("sum b_i a_ij c_j        = 1/6 ",
+        sum([&](auto i) { return ac[i]; }),
+        1. / 6.);
+  check("sum b_i c_i^3           = 1/4 ",
+        sum([&](auto i) { return c[i] * c[i] * c[i]; }),
+        1. / 4.);
+  check("sum b_i c_i a_ij c_j    = 1/8 ",
+        sum([&](auto i) { return c[i] * ac[i]; }),
+        1. / 8.);
+  check("sum b_i a_ij c_j^2      = 1/12",
+        sum([&](auto i) { return acc[i]; }),
+        1. / 12.);
+  check("sum b_i a_ij a_jk c_k   = 1/24",
+        sum([&](auto i) { return aac[i]; }),
+        1. / 24.);
+}
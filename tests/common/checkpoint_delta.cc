@@ -0,0 +1,47 @@
+#include <checkpointing.h>
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace ryujin::Checkpointing;
+
+template <typename Number>
+void test(const unsigned int n, const std::size_t block_size = 1 << 20)
+{
+  std::vector<Number> reference(n);
+  std::vector<Number> data(n);
+  for (unsigned int i = 0; i < n; ++i) {
+    reference[i] = Number(1.) + Number(0.1) * i;
+    data[i] = reference[i] * (Number(1.) + Number(1.e-3) * std::sin(i));
+  }
+  data[n / 2] = -data[n / 2];
+
+  const auto delta = encode_delta(data.data(), reference.data(), n, block_size);
+
+  auto result = reference;
+  apply_delta(delta, result.data(), n);
+
+  std::cout << std::setprecision(10);
+  for (const auto it : result)
+    std::cout << it << " ";
+  std::cout << std::endl;
+  std::cout << "identical: "
+            << (std::memcmp(result.data(), data.data(), n * sizeof(Number)) ==
+                0)
+            << std::endl;
+}
+
+int main()
+{
+  test<double>(12);
+  test<float>(7);
+
+  /* Split the delta into several independently compressed blocks: */
+  test<double>(12, 16);
+  test<float>(7, 5);
+
+  return 0;
+}
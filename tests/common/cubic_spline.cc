@@ -0,0 +1,46 @@
+#include <cubic_spline.h>
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+int main()
+{
+  std::cout << std::setprecision(10);
+  std::cout << std::fixed;
+
+  using VA = dealii::VectorizedArray<double>;
+
+  const std::vector<double> xs{0.0, 0.2, 0.4, 0.6, 0.8, 1.0};
+  const std::vector<double> ys{1.0, 0.2, 5.0, 2.0, 1.0, 10.0};
+  const ryujin::CubicSpline spline(xs, ys);
+
+  std::vector<double> x;
+  for (unsigned int i = 0; i <= 10; ++i)
+    x.push_back(0.1 * i);
+
+  /* Scalar evaluation: */
+  for (const auto x_k : x)
+    std::cout << x_k << " " << spline.eval(x_k) << std::endl;
+
+  /* Batch evaluation must agree with the scalar evaluation: */
+  std::vector<double> y;
+  spline.eval(x, y);
+  bool agree = true;
+  for (unsigned int k = 0; k < x.size(); ++k)
+    agree &= std::abs(y[k] - spline.eval(x[k])) < 1.e-14;
+
+  VA x_simd;
+  for (unsigned int k = 0; k < VA::size(); ++k)
+    x_simd[k] = x[k];
+  const auto y_simd = spline.eval(x_simd);
+  for (unsigned int k = 0; k < VA::size(); ++k)
+    agree &= std::abs(y_simd[k] - spline.eval(x[k])) < 1.e-14;
+
+  std::cout << "batch evaluation agrees: " << std::boolalpha << agree
+            << std::endl;
+
+  /* Two support points result in a linear interpolant: */
+  const ryujin::CubicSpline linear({0., 1.}, {1., 3.});
+  std::cout << "linear: " << linear.eval(0.25) << std::endl;
+}
@@ -0,0 +1,21 @@
+#include <initial_state_library.h>
+
+#include <iostream>
+
+int main()
+{
+  for (const std::string expression : {"1.4",
+                                       "t",
+                                       "3.0 * t",
+                                       "sin(t)+x",
+                                       "x*y + tanh(x)",
+                                       "sqrt(x) + theta_t",
+                                       "exp(-t*x)",
+                                       "(t)"}) {
+    std::cout << "\"" << expression
+              << "\": " << ryujin::expression_depends_on_time(expression)
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+#include <discretization.h>
+#include <offline_data.h>
+
+#include <deal.II/base/mpi.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace ryujin;
+using namespace dealii;
+
+/*
+ * Check that every locally internal index that is exported to a
+ * neighboring rank lies in [0, n_export_indices()). Periodic boundary
+ * conditions might regroup strides after the consistent range, see
+ * DoFRenumbering::inconsistent_strides_last().
+ */
+
+template <int dim>
+void test(const std::string &boundary_condition)
+{
+  const MPI_Comm mpi_communicator = MPI_COMM_WORLD;
+
+  Discretization<dim> discretization(mpi_communicator, "/Discretization");
+  OfflineData<dim, NUMBER> offline_data(
+      mpi_communicator, discretization, "/OfflineData");
+
+  {
+    std::stringstream parameters;
+    parameters << "subsection Discretization\n"
+               << "set geometry = rectangular domain\n"
+               << "set mesh refinement = 4\n"
+               << "subsection rectangular domain\n"
+               << "set boundary condition left = " << boundary_condition
+               << "\n"
+               << "set boundary condition right = " << boundary_condition
+               << "\n"
+               << "end\n"
+               << "end\n"
+               << std::endl;
+    ParameterAcceptor::initialize(parameters);
+  }
+
+  discretization.prepare();
+  offline_data.prepare(/*problem_dimension*/ dim + 2);
+
+  const unsigned int n_locally_internal = offline_data.n_locally_internal();
+  const unsigned int n_export_indices = offline_data.n_export_indices();
+  constexpr auto simd_length = VectorizedArray<NUMBER>::size();
+
+  bool success = n_export_indices <= n_locally_internal &&
+                 n_export_indices % simd_length == 0;
+
+  const auto &partitioner = offline_data.scalar_partitioner();
+  for (const auto &[first, last] : partitioner->import_indices())
+    for (unsigned int i = first; i < std::min(last, n_locally_internal); ++i)
+      if (i >= n_export_indices)
+        success = false;
+
+  success = Utilities::MPI::min(success ? 1 : 0, mpi_communicator) == 1;
+
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    std::cout << dim << "D, " << boundary_condition << ": "
+              << (success ? "all export indices below n_export_indices"
+                          : "FAILED")
+              << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  test<2>("dirichlet");
+  test<2>("periodic");
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  dealii::DynamicSparsityPattern spars(14, 14);
+  spars.add(0, 0);
+  spars.add(0, 1);
+  spars.add(0, 13);
+  for (unsigned int i = 1; i < 12; ++i) {
+    spars.add(i, i - 1);
+    spars.add(i, i);
+    spars.add(i, i + 1);
+  }
+  spars.add(12, 12);
+  spars.add(12, 11);
+  spars.add(13, 13);
+  spars.add(13, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+  dealii::IndexSet locally_relevant(14);
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  ryujin::SparsityPatternSIMD<simd_width> my_sparsity(
+      (12 / simd_width) * simd_width, spars, partitioner);
+
+  /*
+   * A skew-symmetric matrix with nonzero diagonal and a single pair of
+   * entries (0, 13) and (13, 0) that is not skew-symmetric:
+   */
+  dealii::SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(spars);
+  std::array<dealii::SparseMatrix<double>, 2> matrices;
+  for (auto &matrix : matrices)
+    matrix.reinit(sparsity_pattern);
+
+  for (unsigned int i = 0; i < 14; ++i)
+    for (auto it = spars.begin(i); it != spars.end(i); ++it) {
+      const unsigned int j = it->column();
+      double value = 1000. + i;
+      if (i != j)
+        value = (j > i ? 1. : -1.) * (100. * std::min(i, j) + std::max(i, j));
+      if (i == 13 && j == 0)
+        value = 7.;
+      matrices[0].set(i, j, value);
+      matrices[1].set(i, j, 2. * value);
+    }
+
+  ryujin::SkewSymmetricSparseMatrixSIMD<double, 2, simd_width> my_sparse(
+      my_sparsity);
+  my_sparse.read_in(matrices);
+
+  std::cout << "Matrix entries row by row" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto c = my_sparse.get_tensor(i, j);
+      std::cout << c[0] << "," << c[1] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "Matrix entries transposed row by row" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto c = my_sparse.get_transposed_tensor(i, j);
+      std::cout << c[0] << "," << c[1] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  std::cout << "Matrix entries by SIMD rows" << std::endl;
+  unsigned int i = 0;
+  for (; i < (12 / simd_width) * simd_width; i += simd_width) {
+    std::array<dealii::Tensor<1, 2, VA>, 3> c;
+    for (unsigned int j = 0; j < 3; ++j)
+      c[j] = my_sparse.template get_tensor<VA>(i, j);
+    for (unsigned int k = 0; k < simd_width; ++k) {
+      for (unsigned int j = 0; j < 3; ++j)
+        std::cout << c[j][0][k] << "," << c[j][1][k] << " ";
+      std::cout << std::endl;
+    }
+  }
+  for (; i < 14; i++) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto c = my_sparse.get_tensor(i, j);
+      std::cout << c[0] << "," << c[1] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  /*
+   * Compute the index map from a matrix with full SIMD storage:
+   */
+  ryujin::SparseMatrixSIMD<double, 2, simd_width> my_full(my_sparsity);
+  my_full.read_in(matrices);
+  my_full.update_ghost_rows();
+
+  ryujin::SkewSymmetricSparseMatrixSIMD<double, 2, simd_width> my_sparse2(
+      my_sparsity);
+  my_sparse2.read_in(my_full);
+
+  bool identical = true;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      identical = identical && (my_sparse.get_tensor(i, j) ==
+                                my_sparse2.get_tensor(i, j)) &&
+                  (my_sparse.get_transposed_tensor(i, j) ==
+                   my_sparse2.get_transposed_tensor(i, j));
+  std::cout << "Read in from full SIMD storage: "
+            << (identical ? "identical" : "different") << std::endl;
+}
@@ -0,0 +1,65 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <iostream>
+#include <vector>
+
+int main()
+{
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  /*
+   * A tridiagonal pattern with an additional coupling between the first
+   * and the last row. The latter is too far away to be stored as a 16
+   * bit difference and thus exercises the escape of the compressed
+   * column index format (COMPRESSED_COLUMN_INDICES):
+   */
+  constexpr unsigned int n = 40000;
+  dealii::DynamicSparsityPattern spars(n, n);
+  spars.add(0, 0);
+  spars.add(0, 1);
+  spars.add(0, n - 1);
+  for (unsigned int i = 1; i < n - 1; ++i) {
+    spars.add(i, i - 1);
+    spars.add(i, i);
+    spars.add(i, i + 1);
+  }
+  spars.add(n - 1, n - 1);
+  spars.add(n - 1, n - 2);
+  spars.add(n - 1, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(n);
+  locally_owned.add_range(0, n);
+  dealii::IndexSet locally_relevant(n);
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  constexpr unsigned int n_internal = n / 2;
+  ryujin::SparsityPatternSIMD<simd_width> my_sparsity(
+      n_internal, spars, partitioner);
+
+  std::vector<unsigned int> buffer(my_sparsity.column_buffer_size());
+
+  unsigned int n_mismatches = 0;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    const unsigned int stride = my_sparsity.stride_of_row(i);
+    const unsigned int *expected = my_sparsity.columns(i);
+    const unsigned int *decoded = my_sparsity.columns(i, buffer.data());
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      if (expected[j * stride] != decoded[j * stride])
+        ++n_mismatches;
+  }
+
+  std::cout << "Decoded columns of first and last row:" << std::endl;
+  for (const unsigned int i : {0u, n - 1}) {
+    const unsigned int stride = my_sparsity.stride_of_row(i);
+    const unsigned int *decoded = my_sparsity.columns(i, buffer.data());
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      std::cout << decoded[j * stride] << " ";
+    std::cout << std::endl;
+  }
+
+  std::cout << "Mismatches: " << n_mismatches << std::endl;
+}
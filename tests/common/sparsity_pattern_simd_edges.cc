@@ -0,0 +1,79 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <iostream>
+#include <set>
+
+int main()
+{
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  dealii::DynamicSparsityPattern spars(14, 14);
+  spars.add(0, 0);
+  spars.add(0, 1);
+  spars.add(0, 13);
+  for (unsigned int i = 1; i < 12; ++i) {
+    spars.add(i, i - 1);
+    spars.add(i, i);
+    spars.add(i, i + 1);
+  }
+  spars.add(12, 12);
+  spars.add(12, 11);
+  spars.add(13, 13);
+  spars.add(13, 0);
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+  dealii::IndexSet locally_relevant(14);
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  /* Use 8 internal dofs, which is divisible by all SIMD widths: */
+  constexpr unsigned int n_internal = 8;
+  ryujin::SparsityPatternSIMD<simd_width> my_sparsity(
+      n_internal, spars, partitioner);
+
+  /*
+   * Collect all edges of the batches. Every upper triangular entry must
+   * show up, lower triangular entries are only used for padding:
+   */
+  std::set<std::pair<unsigned int, unsigned int>> upper;
+  bool lanes_consistent = true;
+
+  for (unsigned int i = 0; i < n_internal; i += simd_width) {
+    const unsigned int *columns = my_sparsity.columns(i);
+    const unsigned int *positions = my_sparsity.edge_positions(i);
+    for (unsigned int b = 0; b < my_sparsity.n_edge_batches(i);
+         ++b, positions += simd_width)
+      for (unsigned int k = 0; k < simd_width; ++k) {
+        const auto position = positions[k];
+        if (position == 0 || position >= my_sparsity.row_length(i))
+          lanes_consistent = false;
+        const auto j = columns[position * simd_width + k];
+        if (j > i + k)
+          upper.insert({i + k, j});
+      }
+  }
+
+  unsigned int n_upper = 0;
+  for (unsigned int i = 0; i < n_internal; ++i) {
+    const unsigned int *js = my_sparsity.columns(i);
+    for (unsigned int col_idx = 1; col_idx < my_sparsity.row_length(i);
+         ++col_idx)
+      if (js[col_idx * simd_width] > i) {
+        ++n_upper;
+        if (upper.count({i, js[col_idx * simd_width]}) == 0)
+          lanes_consistent = false;
+      }
+  }
+
+  std::cout << "Upper triangular edges:" << std::endl;
+  for (const auto &[i, j] : upper)
+    std::cout << i << " " << j << std::endl;
+
+  std::cout << "number of upper triangular entries: " << n_upper << std::endl;
+  std::cout << "consistent: " << (lanes_consistent ? "yes" : "no")
+            << std::endl;
+}
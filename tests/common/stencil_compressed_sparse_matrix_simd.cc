@@ -0,0 +1,99 @@
+#include <sparse_matrix_simd.h>
+#include <sparse_matrix_simd.template.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+int main(int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  using VA = dealii::VectorizedArray<double>;
+  constexpr auto simd_width = VA::size();
+
+  dealii::DynamicSparsityPattern spars(14, 14);
+  for (unsigned int i = 0; i < 14; ++i) {
+    if (i > 0)
+      spars.add(i, i - 1);
+    spars.add(i, i);
+    if (i < 13)
+      spars.add(i, i + 1);
+  }
+  spars.compress();
+
+  dealii::IndexSet locally_owned(14);
+  locally_owned.add_range(0, 14);
+  dealii::IndexSet locally_relevant(14);
+  auto partitioner = std::make_shared<dealii::Utilities::MPI::Partitioner>(
+      locally_owned, locally_relevant, MPI_COMM_SELF);
+
+  ryujin::SparsityPatternSIMD<simd_width> my_sparsity(
+      (12 / simd_width) * simd_width, spars, partitioner);
+
+  /*
+   * The (translation invariant) c_ij matrix of a uniform 1D mesh with
+   * two identical components scaled by 1 and 2:
+   */
+  dealii::SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(spars);
+  std::array<dealii::SparseMatrix<double>, 2> matrices;
+  for (auto &matrix : matrices)
+    matrix.reinit(sparsity_pattern);
+
+  for (unsigned int i = 0; i < 14; ++i)
+    for (auto it = spars.begin(i); it != spars.end(i); ++it) {
+      const unsigned int j = it->column();
+      double value = 0.;
+      if (j != i)
+        value = j > i ? 0.5 : -0.5;
+      else if (i == 0)
+        value = -0.5;
+      else if (i == 13)
+        value = 0.5;
+      matrices[0].set(i, j, value);
+      matrices[1].set(i, j, 2. * value);
+    }
+
+  ryujin::SkewSymmetricSparseMatrixSIMD<double, 2, simd_width> my_sparse(
+      my_sparsity);
+  my_sparse.read_in(matrices);
+
+  ryujin::SkewSymmetricSparseMatrixSIMD<double, 2, simd_width> my_compressed(
+      my_sparsity);
+  my_compressed.set_stencil_compression(true);
+  my_compressed.read_in(matrices);
+
+  std::cout << "Matrix entries row by row" << std::endl;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i) {
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j) {
+      const auto c = my_compressed.get_tensor(i, j);
+      std::cout << c[0] << "," << c[1] << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  bool identical = true;
+  for (unsigned int i = 0; i < my_sparsity.n_rows(); ++i)
+    for (unsigned int j = 0; j < my_sparsity.row_length(i); ++j)
+      identical = identical && (my_sparse.get_tensor(i, j) ==
+                                my_compressed.get_tensor(i, j)) &&
+                  (my_sparse.get_transposed_tensor(i, j) ==
+                   my_compressed.get_transposed_tensor(i, j));
+
+  unsigned int i = 0;
+  for (; i < (12 / simd_width) * simd_width; i += simd_width)
+    for (unsigned int j = 0; j < 3; ++j) {
+      const auto c = my_compressed.template get_tensor<VA>(i, j);
+      for (unsigned int k = 0; k < simd_width; ++k)
+        identical = identical && (c[0][k] == my_sparse.get_tensor(i + k, j)[0]);
+    }
+
+  std::cout << "Compressed and uncompressed entries: "
+            << (identical ? "identical" : "different") << std::endl;
+
+  std::cout << "Stored entries (uncompressed): "
+            << my_sparse.n_stored_entries() << std::endl;
+  std::cout << "Stored entries (compressed): "
+            << my_compressed.n_stored_entries() << std::endl;
+}
@@ -0,0 +1,43 @@
+#include <flux_expression.h>
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ryujin::FluxLibrary;
+
+void test(const std::string &expression)
+{
+  CompiledExpression program;
+  const bool success = program.compile(expression);
+  std::cout << "f(u)={" << expression << "}: ";
+
+  if (!success) {
+    std::cout << "not supported" << std::endl;
+    return;
+  }
+
+  const double u[] = {-1.0, 0.5, 1.4, 3.0};
+  double result[4];
+  program.evaluate(result, u, 4);
+
+  for (const auto value : result)
+    std::cout << value << " ";
+  std::cout << std::endl;
+}
+
+int main()
+{
+  std::cout << std::setprecision(10);
+  std::cout << std::scientific;
+
+  test("0.5*u*u");
+  test("u*u*u/3. - 2.*u");
+  test("2^-1*u + (u - 1)^2");
+  test("abs(u)^2^0.5");
+  test("sin(_pi * u) + max(u, 0.2, 0.1)");
+  test("sign(u - 1) * ln(abs(u) + 1) - min(u, -u)");
+  test("exp(-u*u) + sqrt(abs(u)) + 1.e-1");
+  test("u < 0 ? u : 2*u");
+  test("unknown(u)");
+  test("(1 + u");
+}